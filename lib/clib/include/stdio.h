@@ -23,6 +23,7 @@
 #ifndef _STDIO_H
 #define _STDIO_H
 
+#include <stdarg.h>
 #include <stddef.h>
 
 #define EOF (-1)
@@ -49,6 +50,7 @@ int fputc(int, FILE *);
 int fputs(const char *, FILE *);
 size_t fread(void *, size_t, size_t, FILE *);
 int fseek(FILE *, long, int);
+long ftell(FILE *);
 size_t fwrite(void *, size_t, size_t, FILE *);
 int getchar(void);
 int getc(FILE *);
@@ -56,5 +58,7 @@ int putchar(int);
 int remove(const char *);
 int rename(const char *, const char *);
 int snprintf(char *, size_t, const char *, ...);
+FILE *tmpfile(void);
+int vfprintf(FILE *, const char *, va_list);
 
 #endif
@@ -26,6 +26,7 @@
 #include <stddef.h>
 
 int asprintf(char **, const char *, ...);
+int memcmp(const void *, const void *, size_t);
 void *memcpy(void *, const void *, size_t) __attribute__((may_ignore_return));
 void *memmove(void *, const void *, size_t) __attribute__((may_ignore_return));
 void *memset(void *, int, size_t) __attribute__((may_ignore_return));
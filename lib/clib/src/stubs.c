@@ -105,6 +105,12 @@ int fseek(FILE *f, long offset, int whence)
 	return -1;
 }
 
+long ftell(FILE *f)
+{
+	(void)f;
+	return -1;
+}
+
 size_t fwrite(void *ptr, size_t size, size_t n, FILE *f)
 {
 	(void)ptr;
@@ -158,6 +164,19 @@ int snprintf(char *buf, size_t size, const char *fmt, ...)
 	return -1;
 }
 
+FILE *tmpfile(void)
+{
+	return NULL;
+}
+
+int vfprintf(FILE *f, const char *fmt, va_list ap)
+{
+	(void)f;
+	(void)fmt;
+	(void)ap;
+	return EOF;
+}
+
 void abort(void)
 {
 }
@@ -215,6 +234,14 @@ int asprintf(char **strp, const char *fmt, ...)
 	return -1;
 }
 
+int memcmp(const void *a, const void *b, size_t n)
+{
+	(void)a;
+	(void)b;
+	(void)n;
+	return 0;
+}
+
 void *memcpy(void *dest, const void *src, size_t n)
 {
 	(void)dest;
@@ -0,0 +1,365 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Hash map
+ *
+ * Open-addressing hash map with linear probing, keyed either by strings
+ * or by integers. Entries are removed using backward shift deletion,
+ * so no tombstones are needed. An empty map does not allocate any memory.
+ */
+
+#include <adt/hmap.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Compute hash of a string key.
+ *
+ * @param str String
+ * @return Hash (32-bit FNV-1a)
+ */
+static unsigned long hmap_str_hash(const char *str)
+{
+	unsigned long h;
+
+	h = 2166136261UL;
+	while (*str != '\0') {
+		h ^= (unsigned char)*str;
+		h = (h * 16777619UL) & 0xffffffffUL;
+		++str;
+	}
+
+	return h;
+}
+
+/** Compute hash of an integer key.
+ *
+ * @param val Integer
+ * @return Hash
+ */
+static unsigned long hmap_int_hash(int64_t val)
+{
+	uint64_t v;
+	unsigned long h;
+
+	v = (uint64_t)val;
+	h = (unsigned long)((v ^ (v >> 32)) & 0xffffffffUL);
+	h = (h * 2654435761UL) & 0xffffffffUL;
+	return h ^ (h >> 16);
+}
+
+/** Determine if slot key matches the given key.
+ *
+ * @param hmap Hash map
+ * @param slot Non-empty slot
+ * @param skey String key (for hmk_str)
+ * @param ikey Integer key (for hmk_int)
+ * @param hash Hash of the key
+ * @return @c true iff the slot key matches
+ */
+static bool hmap_slot_match(hmap_t *hmap, hmap_slot_t *slot,
+    const char *skey, int64_t ikey, unsigned long hash)
+{
+	if (slot->hash != hash)
+		return false;
+
+	if (hmap->ktype == hmk_str)
+		return strcmp(slot->skey, skey) == 0;
+	else
+		return slot->ikey == ikey;
+}
+
+/** Find slot for a key.
+ *
+ * @param hmap Hash map with at least one slot
+ * @param skey String key (for hmk_str)
+ * @param ikey Integer key (for hmk_int)
+ * @param hash Hash of the key
+ * @return Index of the slot holding the key or of the empty slot
+ *         where the key would be inserted
+ */
+static size_t hmap_probe(hmap_t *hmap, const char *skey, int64_t ikey,
+    unsigned long hash)
+{
+	size_t i;
+
+	i = (size_t)(hash & (hmap->nslots - 1));
+	while (hmap->slots[i].value != NULL) {
+		if (hmap_slot_match(hmap, &hmap->slots[i], skey, ikey, hash))
+			break;
+		i = (i + 1) & (hmap->nslots - 1);
+	}
+
+	return i;
+}
+
+/** Resize hash map.
+ *
+ * @param hmap Hash map
+ * @param nslots New number of slots (power of two, larger than the
+ *               number of entries)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int hmap_resize(hmap_t *hmap, size_t nslots)
+{
+	hmap_slot_t *oslots;
+	size_t onslots;
+	size_t i;
+	size_t j;
+
+	oslots = hmap->slots;
+	onslots = hmap->nslots;
+
+	hmap->slots = calloc(nslots, sizeof(hmap_slot_t));
+	if (hmap->slots == NULL) {
+		hmap->slots = oslots;
+		return ENOMEM;
+	}
+
+	hmap->nslots = nslots;
+
+	for (i = 0; i < onslots; i++) {
+		if (oslots[i].value == NULL)
+			continue;
+
+		j = (size_t)(oslots[i].hash & (nslots - 1));
+		while (hmap->slots[j].value != NULL)
+			j = (j + 1) & (nslots - 1);
+
+		hmap->slots[j] = oslots[i];
+	}
+
+	free(oslots);
+	return EOK;
+}
+
+/** Insert entry into hash map.
+ *
+ * @param hmap Hash map
+ * @param skey String key (for hmk_str)
+ * @param ikey Integer key (for hmk_int)
+ * @param hash Hash of the key
+ * @param value Value (not @c NULL)
+ * @return EOK on success, EEXIST if the key is already present,
+ *         ENOMEM if out of memory
+ */
+static int hmap_insert(hmap_t *hmap, const char *skey, int64_t ikey,
+    unsigned long hash, void *value)
+{
+	size_t i;
+	size_t nslots;
+	int rc;
+
+	/* Keep load factor at or below 3/4 */
+	if ((hmap->nentries + 1) * 4 > hmap->nslots * 3) {
+		nslots = hmap->nslots != 0 ? hmap->nslots * 2 :
+		    hmap_init_slots;
+		if (nslots <= hmap->nslots)
+			return ENOMEM;
+
+		rc = hmap_resize(hmap, nslots);
+		if (rc != EOK)
+			return rc;
+	}
+
+	i = hmap_probe(hmap, skey, ikey, hash);
+	if (hmap->slots[i].value != NULL)
+		return EEXIST;
+
+	hmap->slots[i].skey = skey;
+	hmap->slots[i].ikey = ikey;
+	hmap->slots[i].hash = hash;
+	hmap->slots[i].value = value;
+	++hmap->nentries;
+	return EOK;
+}
+
+/** Remove entry from hash map.
+ *
+ * Entries following the removed one in the same probe sequence
+ * are shifted back to fill the gap.
+ *
+ * @param hmap Hash map
+ * @param skey String key (for hmk_str)
+ * @param ikey Integer key (for hmk_int)
+ * @param hash Hash of the key
+ */
+static void hmap_remove(hmap_t *hmap, const char *skey, int64_t ikey,
+    unsigned long hash)
+{
+	size_t mask;
+	size_t i;
+	size_t j;
+	size_t k;
+
+	if (hmap->nentries == 0)
+		return;
+
+	i = hmap_probe(hmap, skey, ikey, hash);
+	if (hmap->slots[i].value == NULL)
+		return;
+
+	mask = hmap->nslots - 1;
+	j = i;
+	while (true) {
+		j = (j + 1) & mask;
+		if (hmap->slots[j].value == NULL)
+			break;
+
+		/* Home slot of the entry at j */
+		k = (size_t)(hmap->slots[j].hash & mask);
+
+		/* Skip entry if its home lies cyclically in (i, j] */
+		if (i <= j) {
+			if (i < k && k <= j)
+				continue;
+		} else {
+			if (i < k || k <= j)
+				continue;
+		}
+
+		hmap->slots[i] = hmap->slots[j];
+		i = j;
+	}
+
+	hmap->slots[i].skey = NULL;
+	hmap->slots[i].value = NULL;
+	--hmap->nentries;
+}
+
+/** Initialize hash map.
+ *
+ * @param hmap Hash map
+ * @param ktype Key type
+ */
+void hmap_initialize(hmap_t *hmap, hmap_key_type_t ktype)
+{
+	hmap->ktype = ktype;
+	hmap->slots = NULL;
+	hmap->nslots = 0;
+	hmap->nentries = 0;
+}
+
+/** Finalize hash map.
+ *
+ * Free the slots. Keys and values are not touched. The map is left
+ * empty and can be used again.
+ *
+ * @param hmap Hash map
+ */
+void hmap_fini(hmap_t *hmap)
+{
+	free(hmap->slots);
+	hmap->slots = NULL;
+	hmap->nslots = 0;
+	hmap->nentries = 0;
+}
+
+/** Insert entry with string key.
+ *
+ * The key string is not copied and must remain valid while it
+ * is in the map.
+ *
+ * @param hmap Hash map with string keys
+ * @param key Key
+ * @param value Value (not @c NULL)
+ * @return EOK on success, EEXIST if the key is already present
+ *         (the existing entry is kept), ENOMEM if out of memory
+ */
+int hmap_insert_str(hmap_t *hmap, const char *key, void *value)
+{
+	return hmap_insert(hmap, key, 0, hmap_str_hash(key), value);
+}
+
+/** Insert entry with integer key.
+ *
+ * @param hmap Hash map with integer keys
+ * @param key Key
+ * @param value Value (not @c NULL)
+ * @return EOK on success, EEXIST if the key is already present
+ *         (the existing entry is kept), ENOMEM if out of memory
+ */
+int hmap_insert_int(hmap_t *hmap, int64_t key, void *value)
+{
+	return hmap_insert(hmap, NULL, key, hmap_int_hash(key), value);
+}
+
+/** Find entry by string key.
+ *
+ * @param hmap Hash map with string keys
+ * @param key Key
+ * @return Value or @c NULL if not found
+ */
+void *hmap_find_str(hmap_t *hmap, const char *key)
+{
+	if (hmap->nentries == 0)
+		return NULL;
+
+	return hmap->slots[hmap_probe(hmap, key, 0, hmap_str_hash(key))].value;
+}
+
+/** Find entry by integer key.
+ *
+ * @param hmap Hash map with integer keys
+ * @param key Key
+ * @return Value or @c NULL if not found
+ */
+void *hmap_find_int(hmap_t *hmap, int64_t key)
+{
+	if (hmap->nentries == 0)
+		return NULL;
+
+	return hmap->slots[hmap_probe(hmap, NULL, key,
+	    hmap_int_hash(key))].value;
+}
+
+/** Remove entry by string key.
+ *
+ * @param hmap Hash map with string keys
+ * @param key Key (nothing happens if it is not present)
+ */
+void hmap_remove_str(hmap_t *hmap, const char *key)
+{
+	hmap_remove(hmap, key, 0, hmap_str_hash(key));
+}
+
+/** Remove entry by integer key.
+ *
+ * @param hmap Hash map with integer keys
+ * @param key Key (nothing happens if it is not present)
+ */
+void hmap_remove_int(hmap_t *hmap, int64_t key)
+{
+	hmap_remove(hmap, NULL, key, hmap_int_hash(key));
+}
+
+/** Get number of entries in hash map.
+ *
+ * @param hmap Hash map
+ * @return Number of entries
+ */
+size_t hmap_count(hmap_t *hmap)
+{
+	return hmap->nentries;
+}
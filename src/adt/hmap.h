@@ -0,0 +1,44 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Hash map
+ */
+
+#ifndef ADT_HMAP_H
+#define ADT_HMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <types/adt/hmap.h>
+
+extern void hmap_initialize(hmap_t *, hmap_key_type_t);
+extern void hmap_fini(hmap_t *);
+extern int hmap_insert_str(hmap_t *, const char *, void *);
+extern int hmap_insert_int(hmap_t *, int64_t, void *);
+extern void *hmap_find_str(hmap_t *, const char *);
+extern void *hmap_find_int(hmap_t *, int64_t);
+extern void hmap_remove_str(hmap_t *, const char *);
+extern void hmap_remove_int(hmap_t *, int64_t);
+extern size_t hmap_count(hmap_t *);
+
+#endif
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Memory arena
+ *
+ * Allocates many small blocks (such as tokens and their text) from a few
+ * large chunks. Individual blocks are never freed, all memory is released
+ * at once when the arena is destroyed. It is also possible to mark
+ * the arena and later release all blocks allocated after the mark.
+ */
+
+#include <arena.h>
+#include <assert.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+	/** Data size of the first chunk */
+	arena_chunk_init = 4096
+};
+
+/** Maximum data size of a chunk (unless a bigger block is requested) */
+#define ARENA_CHUNK_MAX 1048576UL
+
+/** Type with the strictest alignment we need to satisfy */
+typedef union {
+	long l;
+	void *p;
+	size_t s;
+} arena_align_t;
+
+/** Create memory arena.
+ *
+ * No memory is allocated for the arena data until the first block
+ * is allocated.
+ *
+ * @param rarena Place to store pointer to new arena
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int arena_create(arena_t **rarena)
+{
+	arena_t *arena;
+
+	arena = calloc(1, sizeof(arena_t));
+	if (arena == NULL)
+		return ENOMEM;
+
+	arena->next_size = arena_chunk_init;
+	*rarena = arena;
+	return EOK;
+}
+
+/** Destroy memory arena.
+ *
+ * Frees all blocks allocated from the arena.
+ *
+ * @param arena Memory arena or @c NULL
+ */
+void arena_destroy(arena_t *arena)
+{
+	arena_chunk_t *chunk;
+	arena_chunk_t *next;
+
+	if (arena == NULL)
+		return;
+
+	chunk = arena->chunk;
+	while (chunk != NULL) {
+		next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+
+	free(arena);
+}
+
+/** Allocate a new chunk.
+ *
+ * @param arena Memory arena
+ * @param size Minimum data size
+ * @return New chunk or @c NULL if out of memory
+ */
+static arena_chunk_t *arena_chunk_new(arena_t *arena, size_t size)
+{
+	arena_chunk_t *chunk;
+	size_t csize;
+
+	csize = arena->next_size;
+	if (csize < size) {
+		/* Dedicated chunk for an oversized block */
+		csize = size;
+	} else if ((unsigned long)arena->next_size * 2 <= ARENA_CHUNK_MAX &&
+	    arena->next_size * 2 > arena->next_size) {
+		arena->next_size *= 2;
+	}
+
+	if (csize > (size_t)-1 - sizeof(arena_chunk_t))
+		return NULL;
+
+	chunk = malloc(sizeof(arena_chunk_t) + csize);
+	if (chunk == NULL)
+		return NULL;
+
+	chunk->size = csize;
+	chunk->used = 0;
+	chunk->data = (char *)(chunk + 1);
+	return chunk;
+}
+
+/** Allocate block from memory arena.
+ *
+ * The block is suitably aligned for any token or AST structure.
+ * It is valid until the arena is destroyed.
+ *
+ * @param arena Memory arena
+ * @param size Size of block in bytes
+ * @return Pointer to block or @c NULL if out of memory
+ */
+void *arena_alloc(arena_t *arena, size_t size)
+{
+	arena_chunk_t *chunk;
+	size_t asize;
+	bool dedicated;
+	void *p;
+
+	/* Round up to alignment */
+	asize = (size + sizeof(arena_align_t) - 1) /
+	    sizeof(arena_align_t) * sizeof(arena_align_t);
+	if (asize < size)
+		return NULL;
+
+	chunk = arena->chunk;
+	if (chunk == NULL || chunk->size - chunk->used < asize) {
+		dedicated = asize > arena->next_size;
+		chunk = arena_chunk_new(arena, asize);
+		if (chunk == NULL)
+			return NULL;
+
+		if (arena->chunk != NULL && dedicated) {
+			/*
+			 * Dedicated chunk. Insert it behind the current
+			 * chunk so that its free space is not lost.
+			 */
+			chunk->next = arena->chunk->next;
+			arena->chunk->next = chunk;
+		} else {
+			chunk->next = arena->chunk;
+			arena->chunk = chunk;
+		}
+	}
+
+	p = chunk->data + chunk->used;
+	chunk->used += asize;
+	return p;
+}
+
+/** Allocate zero-filled block from memory arena.
+ *
+ * @param arena Memory arena
+ * @param size Size of block in bytes
+ * @return Pointer to block or @c NULL if out of memory
+ */
+void *arena_zalloc(arena_t *arena, size_t size)
+{
+	void *p;
+
+	p = arena_alloc(arena, size);
+	if (p == NULL)
+		return NULL;
+
+	memset(p, 0, size);
+	return p;
+}
+
+/** Duplicate string prefix into memory arena.
+ *
+ * @param arena Memory arena
+ * @param str String
+ * @param len Number of characters to copy (@a str must have at least
+ *            that many characters)
+ * @return Null-terminated copy or @c NULL if out of memory
+ */
+char *arena_strndup(arena_t *arena, const char *str, size_t len)
+{
+	char *dstr;
+
+	if (len + 1 == 0)
+		return NULL;
+
+	dstr = arena_alloc(arena, len + 1);
+	if (dstr == NULL)
+		return NULL;
+
+	memcpy(dstr, str, len);
+	dstr[len] = '\0';
+	return dstr;
+}
+
+/** Duplicate string into memory arena.
+ *
+ * @param arena Memory arena
+ * @param str String
+ * @return Copy of @a str or @c NULL if out of memory
+ */
+char *arena_strdup(arena_t *arena, const char *str)
+{
+	return arena_strndup(arena, str, strlen(str));
+}
+
+/** Mark memory arena.
+ *
+ * Record the current allocation state so that blocks allocated after
+ * this point can be released with arena_release().
+ *
+ * @param arena Memory arena
+ * @param mark Place to store the mark
+ */
+void arena_mark(arena_t *arena, arena_mark_t *mark)
+{
+	mark->chunk = arena->chunk;
+	mark->used = arena->chunk != NULL ? arena->chunk->used : 0;
+}
+
+/** Release memory arena to a mark.
+ *
+ * Free all blocks allocated since @a mark was set. Marks must be
+ * released in reverse order of marking (a mark is no longer valid
+ * once the arena has been released to an earlier mark).
+ *
+ * @param arena Memory arena
+ * @param mark Mark previously set by arena_mark()
+ */
+void arena_release(arena_t *arena, arena_mark_t *mark)
+{
+	arena_chunk_t *chunk;
+
+	/* Free chunks allocated after the mark */
+	while (arena->chunk != mark->chunk) {
+		assert(arena->chunk != NULL);
+		chunk = arena->chunk;
+		arena->chunk = chunk->next;
+		free(chunk);
+	}
+
+	/*
+	 * Dedicated chunks inserted behind the marked chunk are kept
+	 * until the arena is destroyed.
+	 */
+	if (arena->chunk != NULL)
+		arena->chunk->used = mark->used;
+}
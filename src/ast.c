@@ -25,6 +25,7 @@
  */
 
 #include <adt/list.h>
+#include <arena.h>
 #include <assert.h>
 #include <ast.h>
 #include <merrno.h>
@@ -59,6 +60,43 @@ static void ast_block_destroy(ast_block_t *);
 static void ast_sqlist_destroy(ast_sqlist_t *);
 static void ast_dlist_destroy(ast_dlist_t *);
 
+/** Arena for allocating new AST nodes or @c NULL to use the heap */
+static arena_t *ast_arena;
+
+/** Set arena for allocating new AST nodes.
+ *
+ * Nodes created while an arena is set (and everything appended
+ * to them) are allocated from the arena. They are never freed
+ * individually, ast_tree_destroy() does nothing for them. Their memory
+ * is reclaimed when the arena is destroyed or released to an earlier
+ * mark.
+ *
+ * @param arena Arena or @c NULL to allocate new nodes from the heap
+ * @return Previously set arena or @c NULL
+ */
+arena_t *ast_set_arena(arena_t *arena)
+{
+	arena_t *oarena;
+
+	oarena = ast_arena;
+	ast_arena = arena;
+	return oarena;
+}
+
+/** Allocate zero-filled AST structure.
+ *
+ * @param arena Arena to allocate from or @c NULL to allocate from the heap
+ * @param size Size in bytes
+ * @return Pointer to new structure or @c NULL if out of memory
+ */
+static void *ast_alloc(arena_t *arena, size_t size)
+{
+	if (arena != NULL)
+		return arena_zalloc(arena, size);
+
+	return calloc(1, size);
+}
+
 /** Create AST module.
  *
  * @param rmodule Place to store pointer to new module
@@ -192,6 +230,9 @@ static int ast_module_print(ast_module_t *module, FILE *f)
 }
 
 /** Destroy AST module.
+ *
+ * If the module has an arena, all its nodes are freed at once
+ * by destroying the arena.
  *
  * @param module Module
  */
@@ -199,13 +240,16 @@ static void ast_module_destroy(ast_module_t *module)
 {
 	ast_node_t *decl;
 
-	decl = ast_module_first(module);
-	while (decl != NULL) {
-		list_remove(&decl->llist);
-		ast_tree_destroy(decl);
+	if (module->arena == NULL) {
 		decl = ast_module_first(module);
+		while (decl != NULL) {
+			list_remove(&decl->llist);
+			ast_tree_destroy(decl);
+			decl = ast_module_first(module);
+		}
 	}
 
+	arena_destroy(module->arena);
 	free(module);
 }
 
@@ -253,7 +297,7 @@ int ast_sclass_create(ast_sclass_type_t sctype,
 {
 	ast_sclass_t *sclass;
 
-	sclass = calloc(1, sizeof(ast_sclass_t));
+	sclass = ast_alloc(ast_arena, sizeof(ast_sclass_t));
 	if (sclass == NULL)
 		return ENOMEM;
 
@@ -261,6 +305,7 @@ int ast_sclass_create(ast_sclass_type_t sctype,
 
 	sclass->node.ext = sclass;
 	sclass->node.ntype = ant_sclass;
+	sclass->node.arena = ast_arena;
 
 	*rsclass = sclass;
 	return EOK;
@@ -351,7 +396,7 @@ int ast_gdecln_create(ast_dspecs_t *dspecs, ast_idlist_t *idlist,
 {
 	ast_gdecln_t *gdecln;
 
-	gdecln = calloc(1, sizeof(ast_gdecln_t));
+	gdecln = ast_alloc(ast_arena, sizeof(ast_gdecln_t));
 	if (gdecln == NULL)
 		return ENOMEM;
 
@@ -362,6 +407,7 @@ int ast_gdecln_create(ast_dspecs_t *dspecs, ast_idlist_t *idlist,
 
 	gdecln->node.ext = gdecln;
 	gdecln->node.ntype = ant_gdecln;
+	gdecln->node.arena = ast_arena;
 
 	*rgdecln = gdecln;
 	return EOK;
@@ -453,7 +499,7 @@ int ast_mdecln_create(ast_mdecln_t **rmdecln)
 {
 	ast_mdecln_t *mdecln;
 
-	mdecln = calloc(1, sizeof(ast_mdecln_t));
+	mdecln = ast_alloc(ast_arena, sizeof(ast_mdecln_t));
 	if (mdecln == NULL)
 		return ENOMEM;
 
@@ -461,6 +507,7 @@ int ast_mdecln_create(ast_mdecln_t **rmdecln)
 
 	mdecln->node.ext = mdecln;
 	mdecln->node.ntype = ant_mdecln;
+	mdecln->node.arena = ast_arena;
 
 	*rmdecln = mdecln;
 	return EOK;
@@ -477,7 +524,7 @@ int ast_mdecln_append(ast_mdecln_t *mdecln, ast_node_t *expr, void *dcomma)
 {
 	ast_mdecln_arg_t *arg;
 
-	arg = calloc(1, sizeof(ast_mdecln_arg_t));
+	arg = ast_alloc(mdecln->node.arena, sizeof(ast_mdecln_arg_t));
 	if (arg == NULL)
 		return ENOMEM;
 
@@ -604,12 +651,13 @@ int ast_gmdecln_create(ast_gmdecln_t **rgmdecln)
 {
 	ast_gmdecln_t *gmdecln;
 
-	gmdecln = calloc(1, sizeof(ast_gmdecln_t));
+	gmdecln = ast_alloc(ast_arena, sizeof(ast_gmdecln_t));
 	if (gmdecln == NULL)
 		return ENOMEM;
 
 	gmdecln->node.ext = gmdecln;
 	gmdecln->node.ntype = ant_gmdecln;
+	gmdecln->node.arena = ast_arena;
 
 	*rgmdecln = gmdecln;
 	return EOK;
@@ -690,12 +738,13 @@ int ast_nulldecln_create(ast_nulldecln_t **rnulldecln)
 {
 	ast_nulldecln_t *anulldecln;
 
-	anulldecln = calloc(1, sizeof(ast_nulldecln_t));
+	anulldecln = ast_alloc(ast_arena, sizeof(ast_nulldecln_t));
 	if (anulldecln == NULL)
 		return ENOMEM;
 
 	anulldecln->node.ext = anulldecln;
 	anulldecln->node.ntype = ant_nulldecln;
+	anulldecln->node.arena = ast_arena;
 
 	*rnulldecln = anulldecln;
 	return EOK;
@@ -756,12 +805,13 @@ int ast_externc_create(ast_externc_t **rexternc)
 {
 	ast_externc_t *externc;
 
-	externc = calloc(1, sizeof(ast_externc_t));
+	externc = ast_alloc(ast_arena, sizeof(ast_externc_t));
 	if (externc == NULL)
 		return ENOMEM;
 
 	externc->node.ext = externc;
 	externc->node.ntype = ant_externc;
+	externc->node.arena = ast_arena;
 	list_initialize(&externc->decls);
 
 	*rexternc = externc;
@@ -928,7 +978,7 @@ int ast_block_create(ast_braces_t braces, ast_block_t **rblock)
 {
 	ast_block_t *block;
 
-	block = calloc(1, sizeof(ast_block_t));
+	block = ast_alloc(ast_arena, sizeof(ast_block_t));
 	if (block == NULL)
 		return ENOMEM;
 
@@ -937,6 +987,7 @@ int ast_block_create(ast_braces_t braces, ast_block_t **rblock)
 
 	block->node.ext = block;
 	block->node.ntype = ant_block;
+	block->node.arena = ast_arena;
 
 	*rblock = block;
 	return EOK;
@@ -1123,12 +1174,13 @@ int ast_tqual_create(ast_qtype_t qtype, ast_tqual_t **rtqual)
 {
 	ast_tqual_t *tqual;
 
-	tqual = calloc(1, sizeof(ast_tqual_t));
+	tqual = ast_alloc(ast_arena, sizeof(ast_tqual_t));
 	if (tqual == NULL)
 		return ENOMEM;
 
 	tqual->node.ext = tqual;
 	tqual->node.ntype = ant_tqual;
+	tqual->node.arena = ast_arena;
 	tqual->qtype = qtype;
 
 	*rtqual = tqual;
@@ -1207,12 +1259,13 @@ int ast_tsbasic_create(ast_btstype_t btstype, ast_tsbasic_t **rtsbasic)
 {
 	ast_tsbasic_t *tsbasic;
 
-	tsbasic = calloc(1, sizeof(ast_tsbasic_t));
+	tsbasic = ast_alloc(ast_arena, sizeof(ast_tsbasic_t));
 	if (tsbasic == NULL)
 		return ENOMEM;
 
 	tsbasic->node.ext = tsbasic;
 	tsbasic->node.ntype = ant_tsbasic;
+	tsbasic->node.arena = ast_arena;
 	tsbasic->btstype = btstype;
 
 	*rtsbasic = tsbasic;
@@ -1275,12 +1328,13 @@ int ast_tsident_create(ast_tsident_t **rtsident)
 {
 	ast_tsident_t *atsident;
 
-	atsident = calloc(1, sizeof(ast_tsident_t));
+	atsident = ast_alloc(ast_arena, sizeof(ast_tsident_t));
 	if (atsident == NULL)
 		return ENOMEM;
 
 	atsident->node.ext = atsident;
 	atsident->node.ntype = ant_tsident;
+	atsident->node.arena = ast_arena;
 
 	*rtsident = atsident;
 	return EOK;
@@ -1342,12 +1396,13 @@ int ast_tsatomic_create(ast_tsatomic_t **rtsatomic)
 {
 	ast_tsatomic_t *tsatomic;
 
-	tsatomic = calloc(1, sizeof(ast_tsatomic_t));
+	tsatomic = ast_alloc(ast_arena, sizeof(ast_tsatomic_t));
 	if (tsatomic == NULL)
 		return ENOMEM;
 
 	tsatomic->node.ext = tsatomic;
 	tsatomic->node.ntype = ant_tsatomic;
+	tsatomic->node.arena = ast_arena;
 
 	*rtsatomic = tsatomic;
 	return EOK;
@@ -1418,7 +1473,7 @@ int ast_tsrecord_create(ast_rtype_t rtype, ast_tsrecord_t **rtsrecord)
 {
 	ast_tsrecord_t *tsrecord;
 
-	tsrecord = calloc(1, sizeof(ast_tsrecord_t));
+	tsrecord = ast_alloc(ast_arena, sizeof(ast_tsrecord_t));
 	if (tsrecord == NULL)
 		return ENOMEM;
 
@@ -1427,6 +1482,7 @@ int ast_tsrecord_create(ast_rtype_t rtype, ast_tsrecord_t **rtsrecord)
 
 	tsrecord->node.ext = tsrecord;
 	tsrecord->node.ntype = ant_tsrecord;
+	tsrecord->node.arena = ast_arena;
 
 	*rtsrecord = tsrecord;
 	return EOK;
@@ -1445,7 +1501,7 @@ int ast_tsrecord_append(ast_tsrecord_t *tsrecord, ast_sqlist_t *sqlist,
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(tsrecord->node.arena, sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1470,7 +1526,7 @@ int ast_tsrecord_append_mdecln(ast_tsrecord_t *tsrecord, ast_mdecln_t *mdecln,
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(tsrecord->node.arena, sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1492,7 +1548,7 @@ int ast_tsrecord_append_null(ast_tsrecord_t *tsrecord, void *dscolon)
 {
 	ast_tsrecord_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsrecord_elem_t));
+	elem = ast_alloc(tsrecord->node.arena, sizeof(ast_tsrecord_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1651,7 +1707,7 @@ int ast_tsenum_create(ast_tsenum_t **rtsenum)
 {
 	ast_tsenum_t *tsenum;
 
-	tsenum = calloc(1, sizeof(ast_tsenum_t));
+	tsenum = ast_alloc(ast_arena, sizeof(ast_tsenum_t));
 	if (tsenum == NULL)
 		return ENOMEM;
 
@@ -1659,6 +1715,7 @@ int ast_tsenum_create(ast_tsenum_t **rtsenum)
 
 	tsenum->node.ext = tsenum;
 	tsenum->node.ntype = ant_tsenum;
+	tsenum->node.arena = ast_arena;
 
 	*rtsenum = tsenum;
 	return EOK;
@@ -1678,7 +1735,7 @@ int ast_tsenum_append(ast_tsenum_t *tsenum, void *dident, void *dequals,
 {
 	ast_tsenum_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_tsenum_elem_t));
+	elem = ast_alloc(tsenum->node.arena, sizeof(ast_tsenum_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -1811,12 +1868,13 @@ int ast_fspec_create(ast_fspec_t **rfspec)
 {
 	ast_fspec_t *fspec;
 
-	fspec = calloc(1, sizeof(ast_fspec_t));
+	fspec = ast_alloc(ast_arena, sizeof(ast_fspec_t));
 	if (fspec == NULL)
 		return ENOMEM;
 
 	fspec->node.ext = fspec;
 	fspec->node.ntype = ant_fspec;
+	fspec->node.arena = ast_arena;
 
 	*rfspec = fspec;
 	return EOK;
@@ -1876,12 +1934,13 @@ int ast_alignspec_create(ast_alignspec_t **ralignspec)
 {
 	ast_alignspec_t *alignspec;
 
-	alignspec = calloc(1, sizeof(ast_alignspec_t));
+	alignspec = ast_alloc(ast_arena, sizeof(ast_alignspec_t));
 	if (alignspec == NULL)
 		return ENOMEM;
 
 	alignspec->node.ext = alignspec;
 	alignspec->node.ntype = ant_alignspec;
+	alignspec->node.arena = ast_arena;
 
 	*ralignspec = alignspec;
 	return EOK;
@@ -1954,12 +2013,13 @@ int ast_regassign_create(ast_regassign_t **rregassign)
 {
 	ast_regassign_t *regassign;
 
-	regassign = calloc(1, sizeof(ast_regassign_t));
+	regassign = ast_alloc(ast_arena, sizeof(ast_regassign_t));
 	if (regassign == NULL)
 		return ENOMEM;
 
 	regassign->node.ext = regassign;
 	regassign->node.ntype = ant_regassign;
+	regassign->node.arena = ast_arena;
 
 	*rregassign = regassign;
 	return EOK;
@@ -2021,7 +2081,7 @@ int ast_aslist_create(ast_aslist_t **raslist)
 {
 	ast_aslist_t *aslist;
 
-	aslist = calloc(1, sizeof(ast_aslist_t));
+	aslist = ast_alloc(ast_arena, sizeof(ast_aslist_t));
 	if (aslist == NULL)
 		return ENOMEM;
 
@@ -2029,6 +2089,7 @@ int ast_aslist_create(ast_aslist_t **raslist)
 
 	aslist->node.ext = aslist;
 	aslist->node.ntype = ant_aslist;
+	aslist->node.arena = ast_arena;
 
 	*raslist = aslist;
 	return EOK;
@@ -2217,7 +2278,7 @@ int ast_aspec_create(ast_aspec_t **raspec)
 {
 	ast_aspec_t *aspec;
 
-	aspec = calloc(1, sizeof(ast_aspec_t));
+	aspec = ast_alloc(ast_arena, sizeof(ast_aspec_t));
 	if (aspec == NULL)
 		return ENOMEM;
 
@@ -2225,6 +2286,7 @@ int ast_aspec_create(ast_aspec_t **raspec)
 
 	aspec->node.ext = aspec;
 	aspec->node.ntype = ant_aspec;
+	aspec->node.arena = ast_arena;
 
 	*raspec = aspec;
 	return EOK;
@@ -2410,10 +2472,11 @@ int ast_aspec_attr_create(ast_aspec_attr_t **rattr)
 {
 	ast_aspec_attr_t *attr;
 
-	attr = calloc(1, sizeof(ast_aspec_attr_t));
+	attr = ast_alloc(ast_arena, sizeof(ast_aspec_attr_t));
 	if (attr == NULL)
 		return ENOMEM;
 
+	attr->arena = ast_arena;
 	list_initialize(&attr->params);
 
 	*rattr = attr;
@@ -2429,7 +2492,8 @@ void ast_aspec_attr_destroy(ast_aspec_attr_t *attr)
 {
 	ast_aspec_param_t *param;
 
-	if (attr == NULL)
+	/* Attributes allocated from an arena are freed with the arena */
+	if (attr == NULL || attr->arena != NULL)
 		return;
 
 	param = ast_aspec_attr_first(attr);
@@ -2456,7 +2520,7 @@ int ast_aspec_attr_append(ast_aspec_attr_t *attr, ast_node_t *expr,
 {
 	ast_aspec_param_t *param;
 
-	param = calloc(1, sizeof(ast_aspec_param_t));
+	param = ast_alloc(attr->arena, sizeof(ast_aspec_param_t));
 	if (param == NULL)
 		return ENOMEM;
 
@@ -2543,7 +2607,7 @@ int ast_malist_create(ast_malist_t **rmalist)
 {
 	ast_malist_t *malist;
 
-	malist = calloc(1, sizeof(ast_malist_t));
+	malist = ast_alloc(ast_arena, sizeof(ast_malist_t));
 	if (malist == NULL)
 		return ENOMEM;
 
@@ -2551,6 +2615,7 @@ int ast_malist_create(ast_malist_t **rmalist)
 
 	malist->node.ext = malist;
 	malist->node.ntype = ant_malist;
+	malist->node.arena = ast_arena;
 
 	*rmalist = malist;
 	return EOK;
@@ -2739,7 +2804,7 @@ int ast_mattr_create(ast_mattr_t **rmattr)
 {
 	ast_mattr_t *mattr;
 
-	mattr = calloc(1, sizeof(ast_mattr_t));
+	mattr = ast_alloc(ast_arena, sizeof(ast_mattr_t));
 	if (mattr == NULL)
 		return ENOMEM;
 
@@ -2747,6 +2812,7 @@ int ast_mattr_create(ast_mattr_t **rmattr)
 
 	mattr->node.ext = mattr;
 	mattr->node.ntype = ant_mattr;
+	mattr->node.arena = ast_arena;
 
 	*rmattr = mattr;
 	return EOK;
@@ -2762,7 +2828,7 @@ int ast_mattr_append(ast_mattr_t *mattr, ast_node_t *expr, void *dcomma)
 {
 	ast_mattr_param_t *param;
 
-	param = calloc(1, sizeof(ast_mattr_param_t));
+	param = ast_alloc(mattr->node.arena, sizeof(ast_mattr_param_t));
 	if (param == NULL)
 		return ENOMEM;
 
@@ -2928,7 +2994,7 @@ int ast_sqlist_create(ast_sqlist_t **rsqlist)
 {
 	ast_sqlist_t *sqlist;
 
-	sqlist = calloc(1, sizeof(ast_sqlist_t));
+	sqlist = ast_alloc(ast_arena, sizeof(ast_sqlist_t));
 	if (sqlist == NULL)
 		return ENOMEM;
 
@@ -2936,6 +3002,7 @@ int ast_sqlist_create(ast_sqlist_t **rsqlist)
 
 	sqlist->node.ext = sqlist;
 	sqlist->node.ntype = ant_sqlist;
+	sqlist->node.arena = ast_arena;
 
 	*rsqlist = sqlist;
 	return EOK;
@@ -3125,7 +3192,7 @@ int ast_tqlist_create(ast_tqlist_t **rtqlist)
 {
 	ast_tqlist_t *tqlist;
 
-	tqlist = calloc(1, sizeof(ast_tqlist_t));
+	tqlist = ast_alloc(ast_arena, sizeof(ast_tqlist_t));
 	if (tqlist == NULL)
 		return ENOMEM;
 
@@ -3133,6 +3200,7 @@ int ast_tqlist_create(ast_tqlist_t **rtqlist)
 
 	tqlist->node.ext = tqlist;
 	tqlist->node.ntype = ant_tqlist;
+	tqlist->node.arena = ast_arena;
 
 	*rtqlist = tqlist;
 	return EOK;
@@ -3302,7 +3370,7 @@ int ast_dspecs_create(ast_dspecs_t **rdspecs)
 {
 	ast_dspecs_t *dspecs;
 
-	dspecs = calloc(1, sizeof(ast_dspecs_t));
+	dspecs = ast_alloc(ast_arena, sizeof(ast_dspecs_t));
 	if (dspecs == NULL)
 		return ENOMEM;
 
@@ -3310,6 +3378,7 @@ int ast_dspecs_create(ast_dspecs_t **rdspecs)
 
 	dspecs->node.ext = dspecs;
 	dspecs->node.ntype = ant_dspecs;
+	dspecs->node.arena = ast_arena;
 
 	*rdspecs = dspecs;
 	return EOK;
@@ -3502,12 +3571,13 @@ int ast_dident_create(ast_dident_t **rdident)
 {
 	ast_dident_t *adident;
 
-	adident = calloc(1, sizeof(ast_dident_t));
+	adident = ast_alloc(ast_arena, sizeof(ast_dident_t));
 	if (adident == NULL)
 		return ENOMEM;
 
 	adident->node.ext = adident;
 	adident->node.ntype = ant_dident;
+	adident->node.arena = ast_arena;
 
 	*rdident = adident;
 	return EOK;
@@ -3569,12 +3639,13 @@ int ast_dnoident_create(ast_dnoident_t **rdnoident)
 {
 	ast_dnoident_t *adnoident;
 
-	adnoident = calloc(1, sizeof(ast_dnoident_t));
+	adnoident = ast_alloc(ast_arena, sizeof(ast_dnoident_t));
 	if (adnoident == NULL)
 		return ENOMEM;
 
 	adnoident->node.ext = adnoident;
 	adnoident->node.ntype = ant_dnoident;
+	adnoident->node.arena = ast_arena;
 
 	*rdnoident = adnoident;
 	return EOK;
@@ -3638,12 +3709,13 @@ int ast_dparen_create(ast_dparen_t **rdparen)
 {
 	ast_dparen_t *adparen;
 
-	adparen = calloc(1, sizeof(ast_dparen_t));
+	adparen = ast_alloc(ast_arena, sizeof(ast_dparen_t));
 	if (adparen == NULL)
 		return ENOMEM;
 
 	adparen->node.ext = adparen;
 	adparen->node.ntype = ant_dparen;
+	adparen->node.arena = ast_arena;
 
 	*rdparen = adparen;
 	return EOK;
@@ -3710,12 +3782,13 @@ int ast_dptr_create(ast_dptr_t **rdptr)
 {
 	ast_dptr_t *adptr;
 
-	adptr = calloc(1, sizeof(ast_dptr_t));
+	adptr = ast_alloc(ast_arena, sizeof(ast_dptr_t));
 	if (adptr == NULL)
 		return ENOMEM;
 
 	adptr->node.ext = adptr;
 	adptr->node.ntype = ant_dptr;
+	adptr->node.arena = ast_arena;
 
 	*rdptr = adptr;
 	return EOK;
@@ -3794,7 +3867,7 @@ int ast_dfun_create(ast_dfun_t **rdfun)
 {
 	ast_dfun_t *dfun;
 
-	dfun = calloc(1, sizeof(ast_dfun_t));
+	dfun = ast_alloc(ast_arena, sizeof(ast_dfun_t));
 	if (dfun == NULL)
 		return ENOMEM;
 
@@ -3802,6 +3875,7 @@ int ast_dfun_create(ast_dfun_t **rdfun)
 
 	dfun->node.ext = dfun;
 	dfun->node.ntype = ant_dfun;
+	dfun->node.arena = ast_arena;
 
 	*rdfun = dfun;
 	return EOK;
@@ -3821,7 +3895,7 @@ int ast_dfun_append(ast_dfun_t *dfun, ast_dspecs_t *dspecs, ast_node_t *decl,
 {
 	ast_dfun_arg_t *arg;
 
-	arg = calloc(1, sizeof(ast_dfun_arg_t));
+	arg = ast_alloc(dfun->node.arena, sizeof(ast_dfun_arg_t));
 	if (arg == NULL)
 		return ENOMEM;
 
@@ -3985,12 +4059,13 @@ int ast_darray_create(ast_darray_t **rdarray)
 {
 	ast_darray_t *darray;
 
-	darray = calloc(1, sizeof(ast_darray_t));
+	darray = ast_alloc(ast_arena, sizeof(ast_darray_t));
 	if (darray == NULL)
 		return ENOMEM;
 
 	darray->node.ext = darray;
 	darray->node.ntype = ant_darray;
+	darray->node.arena = ast_arena;
 
 	*rdarray = darray;
 	return EOK;
@@ -4076,7 +4151,7 @@ int ast_dlist_create(ast_dlist_t **rdlist)
 {
 	ast_dlist_t *dlist;
 
-	dlist = calloc(1, sizeof(ast_dlist_t));
+	dlist = ast_alloc(ast_arena, sizeof(ast_dlist_t));
 	if (dlist == NULL)
 		return ENOMEM;
 
@@ -4084,6 +4159,7 @@ int ast_dlist_create(ast_dlist_t **rdlist)
 
 	dlist->node.ext = dlist;
 	dlist->node.ntype = ant_dlist;
+	dlist->node.arena = ast_arena;
 
 	*rdlist = dlist;
 	return EOK;
@@ -4106,7 +4182,7 @@ int ast_dlist_append(ast_dlist_t *dlist, void *dcomma, ast_node_t *decl,
 {
 	ast_dlist_entry_t *entry;
 
-	entry = calloc(1, sizeof(ast_dlist_entry_t));
+	entry = ast_alloc(dlist->node.arena, sizeof(ast_dlist_entry_t));
 	if (entry == NULL)
 		return ENOMEM;
 
@@ -4314,7 +4390,7 @@ int ast_idlist_create(ast_idlist_t **ridlist)
 {
 	ast_idlist_t *idlist;
 
-	idlist = calloc(1, sizeof(ast_idlist_t));
+	idlist = ast_alloc(ast_arena, sizeof(ast_idlist_t));
 	if (idlist == NULL)
 		return ENOMEM;
 
@@ -4322,6 +4398,7 @@ int ast_idlist_create(ast_idlist_t **ridlist)
 
 	idlist->node.ext = idlist;
 	idlist->node.ntype = ant_idlist;
+	idlist->node.arena = ast_arena;
 
 	*ridlist = idlist;
 	return EOK;
@@ -4345,7 +4422,7 @@ int ast_idlist_append(ast_idlist_t *idlist, void *dcomma, ast_node_t *decl,
 {
 	ast_idlist_entry_t *entry;
 
-	entry = calloc(1, sizeof(ast_idlist_entry_t));
+	entry = ast_alloc(idlist->node.arena, sizeof(ast_idlist_entry_t));
 	if (entry == NULL)
 		return ENOMEM;
 
@@ -4591,12 +4668,13 @@ int ast_typename_create(ast_typename_t **rtypename)
 {
 	ast_typename_t *atypename;
 
-	atypename = calloc(1, sizeof(ast_typename_t));
+	atypename = ast_alloc(ast_arena, sizeof(ast_typename_t));
 	if (atypename == NULL)
 		return ENOMEM;
 
 	atypename->node.ext = atypename;
 	atypename->node.ntype = ant_typename;
+	atypename->node.arena = ast_arena;
 
 	*rtypename = atypename;
 	return EOK;
@@ -4843,12 +4921,13 @@ int ast_eint_create(ast_eint_t **reint)
 {
 	ast_eint_t *eint;
 
-	eint = calloc(1, sizeof(ast_eint_t));
+	eint = ast_alloc(ast_arena, sizeof(ast_eint_t));
 	if (eint == NULL)
 		return ENOMEM;
 
 	eint->node.ext = eint;
 	eint->node.ntype = ant_eint;
+	eint->node.arena = ast_arena;
 
 	*reint = eint;
 	return EOK;
@@ -4911,12 +4990,13 @@ int ast_ebool_create(ast_ebool_t **rebool)
 {
 	ast_ebool_t *ebool;
 
-	ebool = calloc(1, sizeof(ast_ebool_t));
+	ebool = ast_alloc(ast_arena, sizeof(ast_ebool_t));
 	if (ebool == NULL)
 		return ENOMEM;
 
 	ebool->node.ext = ebool;
 	ebool->node.ntype = ant_ebool;
+	ebool->node.arena = ast_arena;
 
 	*rebool = ebool;
 	return EOK;
@@ -4979,12 +5059,13 @@ int ast_echar_create(ast_echar_t **rechar)
 {
 	ast_echar_t *echar;
 
-	echar = calloc(1, sizeof(ast_echar_t));
+	echar = ast_alloc(ast_arena, sizeof(ast_echar_t));
 	if (echar == NULL)
 		return ENOMEM;
 
 	echar->node.ext = echar;
 	echar->node.ntype = ant_echar;
+	echar->node.arena = ast_arena;
 
 	*rechar = echar;
 	return EOK;
@@ -5047,12 +5128,13 @@ int ast_estring_create(ast_estring_t **restring)
 {
 	ast_estring_t *estring;
 
-	estring = calloc(1, sizeof(ast_estring_t));
+	estring = ast_alloc(ast_arena, sizeof(ast_estring_t));
 	if (estring == NULL)
 		return ENOMEM;
 
 	estring->node.ext = estring;
 	estring->node.ntype = ant_estring;
+	estring->node.arena = ast_arena;
 	list_initialize(&estring->lits);
 
 	*restring = estring;
@@ -5069,7 +5151,7 @@ int ast_estring_append(ast_estring_t *estring, void *dlit)
 {
 	ast_estring_lit_t *lit;
 
-	lit = calloc(1, sizeof(ast_estring_lit_t));
+	lit = ast_alloc(estring->node.arena, sizeof(ast_estring_lit_t));
 	if (lit == NULL)
 		return ENOMEM;
 
@@ -5215,12 +5297,13 @@ int ast_eident_create(ast_eident_t **reident)
 {
 	ast_eident_t *eident;
 
-	eident = calloc(1, sizeof(ast_eident_t));
+	eident = ast_alloc(ast_arena, sizeof(ast_eident_t));
 	if (eident == NULL)
 		return ENOMEM;
 
 	eident->node.ext = eident;
 	eident->node.ntype = ant_eident;
+	eident->node.arena = ast_arena;
 
 	*reident = eident;
 	return EOK;
@@ -5282,12 +5365,13 @@ int ast_eparen_create(ast_eparen_t **reparen)
 {
 	ast_eparen_t *eparen;
 
-	eparen = calloc(1, sizeof(ast_eparen_t));
+	eparen = ast_alloc(ast_arena, sizeof(ast_eparen_t));
 	if (eparen == NULL)
 		return ENOMEM;
 
 	eparen->node.ext = eparen;
 	eparen->node.ntype = ant_eparen;
+	eparen->node.arena = ast_arena;
 
 	*reparen = eparen;
 	return EOK;
@@ -5358,12 +5442,13 @@ int ast_econcat_create(ast_econcat_t **reconcat)
 {
 	ast_econcat_t *econcat;
 
-	econcat = calloc(1, sizeof(ast_econcat_t));
+	econcat = ast_alloc(ast_arena, sizeof(ast_econcat_t));
 	if (econcat == NULL)
 		return ENOMEM;
 
 	econcat->node.ext = econcat;
 	econcat->node.ntype = ant_econcat;
+	econcat->node.arena = ast_arena;
 	list_initialize(&econcat->elems);
 
 	*reconcat = econcat;
@@ -5380,7 +5465,7 @@ int ast_econcat_append(ast_econcat_t *econcat, ast_node_t *bexpr)
 {
 	ast_econcat_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_econcat_elem_t));
+	elem = ast_alloc(econcat->node.arena, sizeof(ast_econcat_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
@@ -5527,12 +5612,13 @@ int ast_ebinop_create(ast_ebinop_t **rebinop)
 {
 	ast_ebinop_t *ebinop;
 
-	ebinop = calloc(1, sizeof(ast_ebinop_t));
+	ebinop = ast_alloc(ast_arena, sizeof(ast_ebinop_t));
 	if (ebinop == NULL)
 		return ENOMEM;
 
 	ebinop->node.ext = ebinop;
 	ebinop->node.ntype = ant_ebinop;
+	ebinop->node.arena = ast_arena;
 
 	*rebinop = ebinop;
 	return EOK;
@@ -5611,12 +5697,13 @@ int ast_etcond_create(ast_etcond_t **retcond)
 {
 	ast_etcond_t *etcond;
 
-	etcond = calloc(1, sizeof(ast_etcond_t));
+	etcond = ast_alloc(ast_arena, sizeof(ast_etcond_t));
 	if (etcond == NULL)
 		return ENOMEM;
 
 	etcond->node.ext = etcond;
 	etcond->node.ntype = ant_etcond;
+	etcond->node.arena = ast_arena;
 
 	*retcond = etcond;
 	return EOK;
@@ -5704,12 +5791,13 @@ int ast_ecomma_create(ast_ecomma_t **recomma)
 {
 	ast_ecomma_t *ecomma;
 
-	ecomma = calloc(1, sizeof(ast_ecomma_t));
+	ecomma = ast_alloc(ast_arena, sizeof(ast_ecomma_t));
 	if (ecomma == NULL)
 		return ENOMEM;
 
 	ecomma->node.ext = ecomma;
 	ecomma->node.ntype = ant_ecomma;
+	ecomma->node.arena = ast_arena;
 
 	*recomma = ecomma;
 	return EOK;
@@ -5788,12 +5876,13 @@ int ast_ecall_create(ast_ecall_t **recall)
 {
 	ast_ecall_t *ecall;
 
-	ecall = calloc(1, sizeof(ast_ecall_t));
+	ecall = ast_alloc(ast_arena, sizeof(ast_ecall_t));
 	if (ecall == NULL)
 		return ENOMEM;
 
 	ecall->node.ext = ecall;
 	ecall->node.ntype = ant_ecall;
+	ecall->node.arena = ast_arena;
 	list_initialize(&ecall->args);
 
 	*recall = ecall;
@@ -5811,7 +5900,7 @@ int ast_ecall_append(ast_ecall_t *ecall, void *dcomma, ast_node_t *arg)
 {
 	ast_ecall_arg_t *earg;
 
-	earg = calloc(1, sizeof(ast_ecall_arg_t));
+	earg = ast_alloc(ecall->node.arena, sizeof(ast_ecall_arg_t));
 	if (earg == NULL)
 		return ENOMEM;
 
@@ -5834,7 +5923,7 @@ int ast_ecall_prepend(ast_ecall_t *ecall, void *dcomma, ast_node_t *arg)
 {
 	ast_ecall_arg_t *earg;
 
-	earg = calloc(1, sizeof(ast_ecall_arg_t));
+	earg = ast_alloc(ecall->node.arena, sizeof(ast_ecall_arg_t));
 	if (earg == NULL)
 		return ENOMEM;
 
@@ -5969,12 +6058,13 @@ int ast_eindex_create(ast_eindex_t **reindex)
 {
 	ast_eindex_t *eindex;
 
-	eindex = calloc(1, sizeof(ast_eindex_t));
+	eindex = ast_alloc(ast_arena, sizeof(ast_eindex_t));
 	if (eindex == NULL)
 		return ENOMEM;
 
 	eindex->node.ext = eindex;
 	eindex->node.ntype = ant_eindex;
+	eindex->node.arena = ast_arena;
 
 	*reindex = eindex;
 	return EOK;
@@ -6053,12 +6143,13 @@ int ast_ederef_create(ast_ederef_t **rederef)
 {
 	ast_ederef_t *ederef;
 
-	ederef = calloc(1, sizeof(ast_ederef_t));
+	ederef = ast_alloc(ast_arena, sizeof(ast_ederef_t));
 	if (ederef == NULL)
 		return ENOMEM;
 
 	ederef->node.ext = ederef;
 	ederef->node.ntype = ant_ederef;
+	ederef->node.arena = ast_arena;
 
 	*rederef = ederef;
 	return EOK;
@@ -6129,12 +6220,13 @@ int ast_eaddr_create(ast_eaddr_t **readdr)
 {
 	ast_eaddr_t *eaddr;
 
-	eaddr = calloc(1, sizeof(ast_eaddr_t));
+	eaddr = ast_alloc(ast_arena, sizeof(ast_eaddr_t));
 	if (eaddr == NULL)
 		return ENOMEM;
 
 	eaddr->node.ext = eaddr;
 	eaddr->node.ntype = ant_eaddr;
+	eaddr->node.arena = ast_arena;
 
 	*readdr = eaddr;
 	return EOK;
@@ -6205,12 +6297,13 @@ int ast_ealignof_create(ast_ealignof_t **realignof)
 {
 	ast_ealignof_t *ealignof;
 
-	ealignof = calloc(1, sizeof(ast_ealignof_t));
+	ealignof = ast_alloc(ast_arena, sizeof(ast_ealignof_t));
 	if (ealignof == NULL)
 		return ENOMEM;
 
 	ealignof->node.ext = ealignof;
 	ealignof->node.ntype = ant_ealignof;
+	ealignof->node.arena = ast_arena;
 
 	*realignof = ealignof;
 	return EOK;
@@ -6293,12 +6386,13 @@ int ast_esizeof_create(ast_esizeof_t **resizeof)
 {
 	ast_esizeof_t *esizeof;
 
-	esizeof = calloc(1, sizeof(ast_esizeof_t));
+	esizeof = ast_alloc(ast_arena, sizeof(ast_esizeof_t));
 	if (esizeof == NULL)
 		return ENOMEM;
 
 	esizeof->node.ext = esizeof;
 	esizeof->node.ntype = ant_esizeof;
+	esizeof->node.arena = ast_arena;
 
 	*resizeof = esizeof;
 	return EOK;
@@ -6381,12 +6475,13 @@ int ast_ecast_create(ast_ecast_t **recast)
 {
 	ast_ecast_t *ecast;
 
-	ecast = calloc(1, sizeof(ast_ecast_t));
+	ecast = ast_alloc(ast_arena, sizeof(ast_ecast_t));
 	if (ecast == NULL)
 		return ENOMEM;
 
 	ecast->node.ext = ecast;
 	ecast->node.ntype = ant_ecast;
+	ecast->node.arena = ast_arena;
 
 	*recast = ecast;
 	return EOK;
@@ -6473,12 +6568,13 @@ int ast_ecliteral_create(ast_ecliteral_t **recliteral)
 {
 	ast_ecliteral_t *ecliteral;
 
-	ecliteral = calloc(1, sizeof(ast_ecliteral_t));
+	ecliteral = ast_alloc(ast_arena, sizeof(ast_ecliteral_t));
 	if (ecliteral == NULL)
 		return ENOMEM;
 
 	ecliteral->node.ext = ecliteral;
 	ecliteral->node.ntype = ant_ecliteral;
+	ecliteral->node.arena = ast_arena;
 
 	*recliteral = ecliteral;
 	return EOK;
@@ -6551,12 +6647,13 @@ int ast_emember_create(ast_emember_t **remember)
 {
 	ast_emember_t *emember;
 
-	emember = calloc(1, sizeof(ast_emember_t));
+	emember = ast_alloc(ast_arena, sizeof(ast_emember_t));
 	if (emember == NULL)
 		return ENOMEM;
 
 	emember->node.ext = emember;
 	emember->node.ntype = ant_emember;
+	emember->node.arena = ast_arena;
 
 	*remember = emember;
 	return EOK;
@@ -6627,12 +6724,13 @@ int ast_eindmember_create(ast_eindmember_t **reindmember)
 {
 	ast_eindmember_t *eindmember;
 
-	eindmember = calloc(1, sizeof(ast_eindmember_t));
+	eindmember = ast_alloc(ast_arena, sizeof(ast_eindmember_t));
 	if (eindmember == NULL)
 		return ENOMEM;
 
 	eindmember->node.ext = eindmember;
 	eindmember->node.ntype = ant_eindmember;
+	eindmember->node.arena = ast_arena;
 
 	*reindmember = eindmember;
 	return EOK;
@@ -6703,12 +6801,13 @@ int ast_eusign_create(ast_eusign_t **reusign)
 {
 	ast_eusign_t *eusign;
 
-	eusign = calloc(1, sizeof(ast_eusign_t));
+	eusign = ast_alloc(ast_arena, sizeof(ast_eusign_t));
 	if (eusign == NULL)
 		return ENOMEM;
 
 	eusign->node.ext = eusign;
 	eusign->node.ntype = ant_eusign;
+	eusign->node.arena = ast_arena;
 
 	*reusign = eusign;
 	return EOK;
@@ -6779,12 +6878,13 @@ int ast_elnot_create(ast_elnot_t **relnot)
 {
 	ast_elnot_t *elnot;
 
-	elnot = calloc(1, sizeof(ast_elnot_t));
+	elnot = ast_alloc(ast_arena, sizeof(ast_elnot_t));
 	if (elnot == NULL)
 		return ENOMEM;
 
 	elnot->node.ext = elnot;
 	elnot->node.ntype = ant_elnot;
+	elnot->node.arena = ast_arena;
 
 	*relnot = elnot;
 	return EOK;
@@ -6856,12 +6956,13 @@ int ast_ebnot_create(ast_ebnot_t **rebnot)
 {
 	ast_ebnot_t *ebnot;
 
-	ebnot = calloc(1, sizeof(ast_ebnot_t));
+	ebnot = ast_alloc(ast_arena, sizeof(ast_ebnot_t));
 	if (ebnot == NULL)
 		return ENOMEM;
 
 	ebnot->node.ext = ebnot;
 	ebnot->node.ntype = ant_ebnot;
+	ebnot->node.arena = ast_arena;
 
 	*rebnot = ebnot;
 	return EOK;
@@ -6932,12 +7033,13 @@ int ast_epreadj_create(ast_epreadj_t **repreadj)
 {
 	ast_epreadj_t *epreadj;
 
-	epreadj = calloc(1, sizeof(ast_epreadj_t));
+	epreadj = ast_alloc(ast_arena, sizeof(ast_epreadj_t));
 	if (epreadj == NULL)
 		return ENOMEM;
 
 	epreadj->node.ext = epreadj;
 	epreadj->node.ntype = ant_epreadj;
+	epreadj->node.arena = ast_arena;
 
 	*repreadj = epreadj;
 	return EOK;
@@ -7008,12 +7110,13 @@ int ast_epostadj_create(ast_epostadj_t **repostadj)
 {
 	ast_epostadj_t *epostadj;
 
-	epostadj = calloc(1, sizeof(ast_epostadj_t));
+	epostadj = ast_alloc(ast_arena, sizeof(ast_epostadj_t));
 	if (epostadj == NULL)
 		return ENOMEM;
 
 	epostadj->node.ext = epostadj;
 	epostadj->node.ntype = ant_epostadj;
+	epostadj->node.arena = ast_arena;
 
 	*repostadj = epostadj;
 	return EOK;
@@ -7084,12 +7187,13 @@ int ast_eva_arg_create(ast_eva_arg_t **reva_arg)
 {
 	ast_eva_arg_t *eva_arg;
 
-	eva_arg = calloc(1, sizeof(ast_eva_arg_t));
+	eva_arg = ast_alloc(ast_arena, sizeof(ast_eva_arg_t));
 	if (eva_arg == NULL)
 		return ENOMEM;
 
 	eva_arg->node.ext = eva_arg;
 	eva_arg->node.ntype = ant_eva_arg;
+	eva_arg->node.arena = ast_arena;
 
 	*reva_arg = eva_arg;
 	return EOK;
@@ -7168,7 +7272,7 @@ int ast_cinit_create(ast_cinit_t **rcinit)
 {
 	ast_cinit_t *cinit;
 
-	cinit = calloc(1, sizeof(ast_cinit_t));
+	cinit = ast_alloc(ast_arena, sizeof(ast_cinit_t));
 	if (cinit == NULL)
 		return ENOMEM;
 
@@ -7176,6 +7280,7 @@ int ast_cinit_create(ast_cinit_t **rcinit)
 
 	cinit->node.ext = cinit;
 	cinit->node.ntype = ant_cinit;
+	cinit->node.arena = ast_arena;
 
 	*rcinit = cinit;
 	return EOK;
@@ -7234,10 +7339,11 @@ int ast_cinit_elem_create(ast_cinit_elem_t **relem)
 {
 	ast_cinit_elem_t *elem;
 
-	elem = calloc(1, sizeof(ast_cinit_elem_t));
+	elem = ast_alloc(ast_arena, sizeof(ast_cinit_elem_t));
 	if (elem == NULL)
 		return ENOMEM;
 
+	elem->arena = ast_arena;
 	list_initialize(&elem->accs);
 
 	*relem = elem;
@@ -7252,7 +7358,8 @@ void ast_cinit_elem_destroy(ast_cinit_elem_t *elem)
 {
 	ast_cinit_acc_t *acc;
 
-	if (elem == NULL)
+	/* Elements allocated from an arena are freed with the arena */
+	if (elem == NULL || elem->arena != NULL)
 		return;
 
 	acc = ast_cinit_elem_first(elem);
@@ -7282,7 +7389,7 @@ int ast_cinit_elem_append_index(ast_cinit_elem_t *elem, void *dlbracket,
 {
 	ast_cinit_acc_t *acc;
 
-	acc = calloc(1, sizeof(ast_cinit_acc_t));
+	acc = ast_alloc(elem->arena, sizeof(ast_cinit_acc_t));
 	if (acc == NULL)
 		return ENOMEM;
 
@@ -7309,7 +7416,7 @@ int ast_cinit_elem_append_member(ast_cinit_elem_t *elem, void *dperiod,
 {
 	ast_cinit_acc_t *acc;
 
-	acc = calloc(1, sizeof(ast_cinit_acc_t));
+	acc = ast_alloc(elem->arena, sizeof(ast_cinit_acc_t));
 	if (acc == NULL)
 		return ENOMEM;
 
@@ -7451,7 +7558,7 @@ int ast_asm_create(ast_asm_t **rasm)
 {
 	ast_asm_t *aasm;
 
-	aasm = calloc(1, sizeof(ast_asm_t));
+	aasm = ast_alloc(ast_arena, sizeof(ast_asm_t));
 	if (aasm == NULL)
 		return ENOMEM;
 
@@ -7462,6 +7569,7 @@ int ast_asm_create(ast_asm_t **rasm)
 
 	aasm->node.ext = aasm;
 	aasm->node.ntype = ant_asm;
+	aasm->node.arena = ast_arena;
 
 	*rasm = aasm;
 	return EOK;
@@ -7487,7 +7595,7 @@ int ast_asm_append_out_op(ast_asm_t *aasm, bool have_symname, void *dlbracket,
 {
 	ast_asm_op_t *aop;
 
-	aop = calloc(1, sizeof(ast_asm_op_t));
+	aop = ast_alloc(aasm->node.arena, sizeof(ast_asm_op_t));
 	if (aop == NULL)
 		return ENOMEM;
 
@@ -7529,7 +7637,7 @@ int ast_asm_append_in_op(ast_asm_t *aasm, bool have_symname, void *dlbracket,
 {
 	ast_asm_op_t *aop;
 
-	aop = calloc(1, sizeof(ast_asm_op_t));
+	aop = ast_alloc(aasm->node.arena, sizeof(ast_asm_op_t));
 	if (aop == NULL)
 		return ENOMEM;
 
@@ -7562,7 +7670,7 @@ int ast_asm_append_clobber(ast_asm_t *aasm, void *dclobber, void *dcomma)
 {
 	ast_asm_clobber_t *aclobber;
 
-	aclobber = calloc(1, sizeof(ast_asm_clobber_t));
+	aclobber = ast_alloc(aasm->node.arena, sizeof(ast_asm_clobber_t));
 	if (aclobber == NULL)
 		return ENOMEM;
 
@@ -7585,7 +7693,7 @@ int ast_asm_append_label(ast_asm_t *aasm, void *dlabel, void *dcomma)
 {
 	ast_asm_label_t *alabel;
 
-	alabel = calloc(1, sizeof(ast_asm_label_t));
+	alabel = ast_alloc(aasm->node.arena, sizeof(ast_asm_label_t));
 	if (alabel == NULL)
 		return ENOMEM;
 
@@ -7891,12 +7999,13 @@ int ast_break_create(ast_break_t **rbreak)
 {
 	ast_break_t *abreak;
 
-	abreak = calloc(1, sizeof(ast_break_t));
+	abreak = ast_alloc(ast_arena, sizeof(ast_break_t));
 	if (abreak == NULL)
 		return ENOMEM;
 
 	abreak->node.ext = abreak;
 	abreak->node.ntype = ant_break;
+	abreak->node.arena = ast_arena;
 
 	*rbreak = abreak;
 	return EOK;
@@ -7958,12 +8067,13 @@ int ast_continue_create(ast_continue_t **rcontinue)
 {
 	ast_continue_t *acontinue;
 
-	acontinue = calloc(1, sizeof(ast_continue_t));
+	acontinue = ast_alloc(ast_arena, sizeof(ast_continue_t));
 	if (acontinue == NULL)
 		return ENOMEM;
 
 	acontinue->node.ext = acontinue;
 	acontinue->node.ntype = ant_continue;
+	acontinue->node.arena = ast_arena;
 
 	*rcontinue = acontinue;
 	return EOK;
@@ -8025,12 +8135,13 @@ int ast_goto_create(ast_goto_t **rgoto)
 {
 	ast_goto_t *agoto;
 
-	agoto = calloc(1, sizeof(ast_goto_t));
+	agoto = ast_alloc(ast_arena, sizeof(ast_goto_t));
 	if (agoto == NULL)
 		return ENOMEM;
 
 	agoto->node.ext = agoto;
 	agoto->node.ntype = ant_goto;
+	agoto->node.arena = ast_arena;
 
 	*rgoto = agoto;
 	return EOK;
@@ -8092,12 +8203,13 @@ int ast_return_create(ast_return_t **rreturn)
 {
 	ast_return_t *areturn;
 
-	areturn = calloc(1, sizeof(ast_return_t));
+	areturn = ast_alloc(ast_arena, sizeof(ast_return_t));
 	if (areturn == NULL)
 		return ENOMEM;
 
 	areturn->node.ext = areturn;
 	areturn->node.ntype = ant_return;
+	areturn->node.arena = ast_arena;
 
 	*rreturn = areturn;
 	return EOK;
@@ -8169,12 +8281,13 @@ int ast_if_create(ast_if_t **rif)
 {
 	ast_if_t *aif;
 
-	aif = calloc(1, sizeof(ast_if_t));
+	aif = ast_alloc(ast_arena, sizeof(ast_if_t));
 	if (aif == NULL)
 		return ENOMEM;
 
 	aif->node.ext = aif;
 	aif->node.ntype = ant_if;
+	aif->node.arena = ast_arena;
 	list_initialize(&aif->elseifs);
 
 	*rif = aif;
@@ -8196,7 +8309,7 @@ int ast_if_append(ast_if_t *aif, void *delse, void *dif, void *dlparen,
 {
 	ast_elseif_t *elseif;
 
-	elseif = calloc(1, sizeof(ast_elseif_t));
+	elseif = ast_alloc(aif->node.arena, sizeof(ast_elseif_t));
 	if (elseif == NULL)
 		return ENOMEM;
 
@@ -8336,12 +8449,13 @@ int ast_while_create(ast_while_t **rwhile)
 {
 	ast_while_t *awhile;
 
-	awhile = calloc(1, sizeof(ast_while_t));
+	awhile = ast_alloc(ast_arena, sizeof(ast_while_t));
 	if (awhile == NULL)
 		return ENOMEM;
 
 	awhile->node.ext = awhile;
 	awhile->node.ntype = ant_while;
+	awhile->node.arena = ast_arena;
 
 	*rwhile = awhile;
 	return EOK;
@@ -8414,12 +8528,13 @@ int ast_do_create(ast_do_t **rdo)
 {
 	ast_do_t *ado;
 
-	ado = calloc(1, sizeof(ast_do_t));
+	ado = ast_alloc(ast_arena, sizeof(ast_do_t));
 	if (ado == NULL)
 		return ENOMEM;
 
 	ado->node.ext = ado;
 	ado->node.ntype = ant_do;
+	ado->node.arena = ast_arena;
 
 	*rdo = ado;
 	return EOK;
@@ -8496,12 +8611,13 @@ int ast_for_create(ast_for_t **rfor)
 {
 	ast_for_t *afor;
 
-	afor = calloc(1, sizeof(ast_for_t));
+	afor = ast_alloc(ast_arena, sizeof(ast_for_t));
 	if (afor == NULL)
 		return ENOMEM;
 
 	afor->node.ext = afor;
 	afor->node.ntype = ant_for;
+	afor->node.arena = ast_arena;
 
 	*rfor = afor;
 	return EOK;
@@ -8600,12 +8716,13 @@ int ast_switch_create(ast_switch_t **rswitch)
 {
 	ast_switch_t *aswitch;
 
-	aswitch = calloc(1, sizeof(ast_switch_t));
+	aswitch = ast_alloc(ast_arena, sizeof(ast_switch_t));
 	if (aswitch == NULL)
 		return ENOMEM;
 
 	aswitch->node.ext = aswitch;
 	aswitch->node.ntype = ant_switch;
+	aswitch->node.arena = ast_arena;
 
 	*rswitch = aswitch;
 	return EOK;
@@ -8683,12 +8800,13 @@ int ast_clabel_create(ast_clabel_t **rclabel)
 {
 	ast_clabel_t *clabel;
 
-	clabel = calloc(1, sizeof(ast_clabel_t));
+	clabel = ast_alloc(ast_arena, sizeof(ast_clabel_t));
 	if (clabel == NULL)
 		return ENOMEM;
 
 	clabel->node.ext = clabel;
 	clabel->node.ntype = ant_clabel;
+	clabel->node.arena = ast_arena;
 
 	*rclabel = clabel;
 	return EOK;
@@ -8751,12 +8869,13 @@ int ast_dlabel_create(ast_dlabel_t **rdlabel)
 {
 	ast_dlabel_t *dlabel;
 
-	dlabel = calloc(1, sizeof(ast_dlabel_t));
+	dlabel = ast_alloc(ast_arena, sizeof(ast_dlabel_t));
 	if (dlabel == NULL)
 		return ENOMEM;
 
 	dlabel->node.ext = dlabel;
 	dlabel->node.ntype = ant_dlabel;
+	dlabel->node.arena = ast_arena;
 
 	*rdlabel = dlabel;
 	return EOK;
@@ -8818,12 +8937,13 @@ int ast_glabel_create(ast_glabel_t **rglabel)
 {
 	ast_glabel_t *glabel;
 
-	glabel = calloc(1, sizeof(ast_glabel_t));
+	glabel = ast_alloc(ast_arena, sizeof(ast_glabel_t));
 	if (glabel == NULL)
 		return ENOMEM;
 
 	glabel->node.ext = glabel;
 	glabel->node.ntype = ant_glabel;
+	glabel->node.arena = ast_arena;
 
 	*rglabel = glabel;
 	return EOK;
@@ -8885,12 +9005,13 @@ int ast_stexpr_create(ast_stexpr_t **rstexpr)
 {
 	ast_stexpr_t *astexpr;
 
-	astexpr = calloc(1, sizeof(ast_stexpr_t));
+	astexpr = ast_alloc(ast_arena, sizeof(ast_stexpr_t));
 	if (astexpr == NULL)
 		return ENOMEM;
 
 	astexpr->node.ext = astexpr;
 	astexpr->node.ntype = ant_stexpr;
+	astexpr->node.arena = ast_arena;
 
 	*rstexpr = astexpr;
 	return EOK;
@@ -8957,12 +9078,13 @@ int ast_stdecln_create(ast_stdecln_t **rstdecln)
 {
 	ast_stdecln_t *stdecln;
 
-	stdecln = calloc(1, sizeof(ast_stdecln_t));
+	stdecln = ast_alloc(ast_arena, sizeof(ast_stdecln_t));
 	if (stdecln == NULL)
 		return ENOMEM;
 
 	stdecln->node.ext = stdecln;
 	stdecln->node.ntype = ant_stdecln;
+	stdecln->node.arena = ast_arena;
 
 	*rstdecln = stdecln;
 	return EOK;
@@ -9041,12 +9163,13 @@ int ast_stnull_create(ast_stnull_t **rstnull)
 {
 	ast_stnull_t *astnull;
 
-	astnull = calloc(1, sizeof(ast_stnull_t));
+	astnull = ast_alloc(ast_arena, sizeof(ast_stnull_t));
 	if (astnull == NULL)
 		return ENOMEM;
 
 	astnull->node.ext = astnull;
 	astnull->node.ntype = ant_stnull;
+	astnull->node.arena = ast_arena;
 
 	*rstnull = astnull;
 	return EOK;
@@ -9087,12 +9210,13 @@ int ast_va_copy_create(ast_va_copy_t **rva_copy)
 {
 	ast_va_copy_t *va_copy;
 
-	va_copy = calloc(1, sizeof(ast_va_copy_t));
+	va_copy = ast_alloc(ast_arena, sizeof(ast_va_copy_t));
 	if (va_copy == NULL)
 		return ENOMEM;
 
 	va_copy->node.ext = va_copy;
 	va_copy->node.ntype = ant_va_copy;
+	va_copy->node.arena = ast_arena;
 
 	*rva_copy = va_copy;
 	return EOK;
@@ -9171,12 +9295,13 @@ int ast_va_end_create(ast_va_end_t **rva_end)
 {
 	ast_va_end_t *va_end;
 
-	va_end = calloc(1, sizeof(ast_va_end_t));
+	va_end = ast_alloc(ast_arena, sizeof(ast_va_end_t));
 	if (va_end == NULL)
 		return ENOMEM;
 
 	va_end->node.ext = va_end;
 	va_end->node.ntype = ant_va_end;
+	va_end->node.arena = ast_arena;
 
 	*rva_end = va_end;
 	return EOK;
@@ -9247,12 +9372,13 @@ int ast_va_start_create(ast_va_start_t **rva_start)
 {
 	ast_va_start_t *va_start;
 
-	va_start = calloc(1, sizeof(ast_va_start_t));
+	va_start = ast_alloc(ast_arena, sizeof(ast_va_start_t));
 	if (va_start == NULL)
 		return ENOMEM;
 
 	va_start->node.ext = va_start;
 	va_start->node.ntype = ant_va_start;
+	va_start->node.arena = ast_arena;
 
 	*rva_start = va_start;
 	return EOK;
@@ -9351,12 +9477,13 @@ int ast_lmacro_create(ast_lmacro_t **rlmacro)
 {
 	ast_lmacro_t *lmacro;
 
-	lmacro = calloc(1, sizeof(ast_lmacro_t));
+	lmacro = ast_alloc(ast_arena, sizeof(ast_lmacro_t));
 	if (lmacro == NULL)
 		return ENOMEM;
 
 	lmacro->node.ext = lmacro;
 	lmacro->node.ntype = ant_lmacro;
+	lmacro->node.arena = ast_arena;
 
 	*rlmacro = lmacro;
 	return EOK;
@@ -9606,7 +9733,8 @@ int ast_tree_print(ast_node_t *node, FILE *f)
  */
 void ast_tree_destroy(ast_node_t *node)
 {
-	if (node == NULL)
+	/* Nodes allocated from an arena are freed with the arena */
+	if (node == NULL || node->arena != NULL)
 		return;
 
 	switch (node->ntype) {
@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <types/ast.h>
 
+extern arena_t *ast_set_arena(arena_t *);
 extern int ast_module_create(ast_module_t **);
 extern void ast_module_append(ast_module_t *, ast_node_t *);
 extern ast_node_t *ast_module_first(ast_module_t *);
@@ -0,0 +1,391 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Compilation cache
+ *
+ * The cache maps a key (data describing the tool input, such as
+ * the preprocessed source code and compiler flags) to the result data
+ * (such as a binary object or a list of reported issues). Each entry
+ * consists of two files in the cache directory, named after a hash
+ * of the key: <hash>.key contains the complete key and <hash>.dat
+ * contains the data. On lookup the stored key is compared with
+ * the requested one, thus a hash collision can only result in a cache
+ * miss, never in wrong data being used.
+ *
+ * Entries are written to temporary files first and then renamed,
+ * so that a partially written entry is never visible.
+ */
+
+#include <cache.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_FORK
+#include <unistd.h>
+#endif
+
+/** Create compilation cache.
+ *
+ * @param dir Cache directory (must exist)
+ * @param rcache Place to store pointer to new cache
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int cache_create(const char *dir, cache_t **rcache)
+{
+	cache_t *cache;
+
+	cache = calloc(1, sizeof(cache_t));
+	if (cache == NULL)
+		return ENOMEM;
+
+	cache->dir = strdup(dir);
+	if (cache->dir == NULL) {
+		free(cache);
+		return ENOMEM;
+	}
+
+	*rcache = cache;
+	return EOK;
+}
+
+/** Destroy compilation cache.
+ *
+ * @param cache Compilation cache or @c NULL
+ */
+void cache_destroy(cache_t *cache)
+{
+	if (cache == NULL)
+		return;
+
+	free(cache->dir);
+	free(cache);
+}
+
+/** Create empty cache key.
+ *
+ * @param rkey Place to store pointer to new key
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int cache_key_create(cache_key_t **rkey)
+{
+	cache_key_t *key;
+
+	key = calloc(1, sizeof(cache_key_t));
+	if (key == NULL)
+		return ENOMEM;
+
+	*rkey = key;
+	return EOK;
+}
+
+/** Destroy cache key.
+ *
+ * @param key Cache key or @c NULL
+ */
+void cache_key_destroy(cache_key_t *key)
+{
+	if (key == NULL)
+		return;
+
+	if (key->data != NULL)
+		free(key->data);
+	free(key);
+}
+
+/** Append data to cache key.
+ *
+ * @param key Cache key
+ * @param data Data
+ * @param size Size of data in bytes
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int cache_key_append(cache_key_t *key, const char *data, size_t size)
+{
+	char *ndata;
+	size_t nalloc;
+
+	if (key->size + size > key->alloc) {
+		nalloc = key->alloc != 0 ? key->alloc : 256;
+		while (nalloc < key->size + size)
+			nalloc *= 2;
+
+		ndata = realloc(key->data, nalloc);
+		if (ndata == NULL)
+			return ENOMEM;
+
+		key->data = ndata;
+		key->alloc = nalloc;
+	}
+
+	memcpy(key->data + key->size, data, size);
+	key->size += size;
+	return EOK;
+}
+
+/** Compute name of cache entry.
+ *
+ * The name consists of two 32-bit FNV-1a hashes of the key (with
+ * different offset bases) printed in hexadecimal.
+ *
+ * @param key Cache key
+ * @param name Buffer of at least cache_name_len + 1 characters
+ */
+static void cache_entry_name(cache_key_t *key, char *name)
+{
+	uint32_t h1 = 0x811c9dc5UL;
+	uint32_t h2 = 0x050c5d1fUL;
+	size_t i;
+
+	for (i = 0; i < key->size; i++) {
+		h1 = (h1 ^ (uint8_t)key->data[i]) * 0x01000193UL;
+		h2 = (h2 ^ (uint8_t)key->data[i]) * 0x01000193UL;
+	}
+
+	(void)snprintf(name, cache_name_len + 1, "%08lx%08lx",
+	    (unsigned long)h1 & 0xffffffffUL,
+	    (unsigned long)h2 & 0xffffffffUL);
+}
+
+/** Construct path of cache entry file.
+ *
+ * @param cache Compilation cache
+ * @param key Cache key
+ * @param ext File name extension
+ * @param rpath Place to store pointer to newly allocated path
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int cache_entry_path(cache_t *cache, cache_key_t *key,
+    const char *ext, char **rpath)
+{
+	char name[cache_name_len + 1];
+	int rv;
+
+	cache_entry_name(key, name);
+
+	rv = asprintf(rpath, "%s/%s.%s", cache->dir, name, ext);
+	if (rv < 0)
+		return ENOMEM;
+
+	return EOK;
+}
+
+/** Compare stored key with cache key.
+ *
+ * @param f File containing stored key
+ * @param key Cache key
+ * @return @c true iff the stored key is identical to @a key
+ */
+static bool cache_key_matches(FILE *f, cache_key_t *key)
+{
+	char buf[256];
+	size_t pos;
+	size_t nr;
+
+	pos = 0;
+	do {
+		nr = fread(buf, 1, sizeof(buf), f);
+		if (nr > key->size - pos)
+			return false;
+		if (memcmp(buf, key->data + pos, nr) != 0)
+			return false;
+		pos += nr;
+	} while (nr == sizeof(buf));
+
+	if (ferror(f) != 0)
+		return false;
+
+	return pos == key->size;
+}
+
+/** Look up data in cache.
+ *
+ * @param cache Cache
+ * @param key Cache key
+ * @param rdataf Place to store open data file (caller must close it)
+ * @return EOK on success, ENOENT if not found, ENOMEM if out of memory
+ */
+int cache_lookup(cache_t *cache, cache_key_t *key, FILE **rdataf)
+{
+	char *keypath = NULL;
+	char *datapath = NULL;
+	FILE *keyf = NULL;
+	FILE *dataf;
+	int rc;
+
+	rc = cache_entry_path(cache, key, "key", &keypath);
+	if (rc != EOK)
+		goto error;
+
+	rc = cache_entry_path(cache, key, "dat", &datapath);
+	if (rc != EOK)
+		goto error;
+
+	keyf = fopen(keypath, "rb");
+	if (keyf == NULL) {
+		rc = ENOENT;
+		goto error;
+	}
+
+	if (!cache_key_matches(keyf, key)) {
+		rc = ENOENT;
+		goto error;
+	}
+
+	dataf = fopen(datapath, "rb");
+	if (dataf == NULL) {
+		rc = ENOENT;
+		goto error;
+	}
+
+	(void)fclose(keyf);
+	free(keypath);
+	free(datapath);
+	*rdataf = dataf;
+	return EOK;
+error:
+	if (keyf != NULL)
+		(void)fclose(keyf);
+	if (keypath != NULL)
+		free(keypath);
+	if (datapath != NULL)
+		free(datapath);
+	return rc;
+}
+
+/** Write cache entry file.
+ *
+ * The file is written under a temporary name first and then renamed.
+ *
+ * @param path Path of the file
+ * @param key Key to write or @c NULL
+ * @param write Function writing the data (if @a key is @c NULL)
+ * @param arg Argument to @a write
+ * @return EOK on success or an error code
+ */
+static int cache_write_file(const char *path, cache_key_t *key,
+    cache_write_fn_t write, void *arg)
+{
+	char *tmppath = NULL;
+	FILE *f = NULL;
+	int rc;
+	int rv;
+
+#ifdef HAVE_FORK
+	rv = asprintf(&tmppath, "%s.%ld.tmp", path, (long)getpid());
+#else
+	rv = asprintf(&tmppath, "%s.tmp", path);
+#endif
+	if (rv < 0) {
+		tmppath = NULL;
+		rc = ENOMEM;
+		goto error;
+	}
+
+	f = fopen(tmppath, "wb");
+	if (f == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (key != NULL) {
+		if (fwrite(key->data, 1, key->size, f) != key->size) {
+			rc = EIO;
+			goto error;
+		}
+	} else {
+		rc = write(arg, f);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rv = fclose(f);
+	f = NULL;
+	if (rv < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (rename(tmppath, path) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	free(tmppath);
+	return EOK;
+error:
+	if (f != NULL)
+		(void)fclose(f);
+	if (tmppath != NULL) {
+		(void)remove(tmppath);
+		free(tmppath);
+	}
+	return rc;
+}
+
+/** Store data in cache.
+ *
+ * The data is written before the key so that a lookup never finds
+ * a key without the corresponding data.
+ *
+ * @param cache Cache
+ * @param key Cache key
+ * @param write Function writing the data to a stream
+ * @param arg Argument to @a write
+ * @return EOK on success or an error code
+ */
+int cache_store(cache_t *cache, cache_key_t *key, cache_write_fn_t write,
+    void *arg)
+{
+	char *keypath = NULL;
+	char *datapath = NULL;
+	int rc;
+
+	rc = cache_entry_path(cache, key, "key", &keypath);
+	if (rc != EOK)
+		goto error;
+
+	rc = cache_entry_path(cache, key, "dat", &datapath);
+	if (rc != EOK)
+		goto error;
+
+	rc = cache_write_file(datapath, NULL, write, arg);
+	if (rc != EOK)
+		goto error;
+
+	rc = cache_write_file(keypath, key, NULL, NULL);
+	if (rc != EOK)
+		goto error;
+
+	free(keypath);
+	free(datapath);
+	return EOK;
+error:
+	if (keypath != NULL)
+		free(keypath);
+	if (datapath != NULL)
+		free(datapath);
+	return rc;
+}
@@ -24,44 +24,809 @@
  * C-style checker tool
  */
 
+#include <cache.h>
 #include <checker.h>
+#include <diag.h>
+#include <dirwalk.h>
 #include <file_input.h>
+#include <jobs.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <parser.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <test/arena.h>
 #include <test/ast.h>
 #include <test/checker.h>
+#include <test/kwtab.h>
 #include <test/lexer.h>
+#include <test/libccheck.h>
 #include <test/parser.h>
+#include <test/src_pos.h>
+#include <test/strtab.h>
+#include <test/udiff.h>
+#include <udiff.h>
+
+enum {
+	/** Maximum number of parallel jobs */
+	max_jobs = 64,
+	/** Number of batches of files per parallel job */
+	batches_per_job = 4,
+	/** Size of buffer for building cache key and copying results */
+	ccheck_buf_size = 256,
+	/** Version of result cache key (increment when checks change) */
+	ccheck_cache_version = 3
+};
+
+/** List of files to check */
+typedef struct {
+	/** File names */
+	char **fnames;
+	/** Number of files */
+	size_t nfiles;
+	/** Number of allocated entries in @c fnames */
+	size_t alloc;
+} ccheck_flist_t;
+
+/** Checking options */
+typedef struct {
+	/** Checker flags */
+	checker_flags_t flags;
+	/** Checker configuration */
+	checker_cfg_t cfg;
+	/** Result cache or @c NULL */
+	cache_t *cache;
+	/** Diagnostics sink */
+	diag_t *diag;
+	/** Diagnostic output format */
+	diag_fmt_t dfmt;
+} ccheck_opts_t;
+
+/** Batch of files checked by one parallel job */
+typedef struct {
+	/** File list */
+	ccheck_flist_t *flist;
+	/** Index of first file in the batch */
+	size_t first;
+	/** Number of files in the batch */
+	size_t count;
+	/** Checking options */
+	ccheck_opts_t *opts;
+	/** Job checking the batch */
+	job_t *job;
+} ccheck_batch_t;
+
+/** Result of checking one file, passed from a parallel job */
+typedef struct {
+	/** Return code of check_file() */
+	int rc;
+	/** Number of reported issues */
+	unsigned long nissues;
+} ccheck_result_t;
+
+/** Checker results being stored in result cache */
+typedef struct {
+	/** Number of reported issues */
+	unsigned long nissues;
+	/** File containing the issue report */
+	FILE *outf;
+	/** Diagnostics sink writing to @c outf */
+	diag_t *diag;
+} ccheck_cache_entry_t;
+
+/** Issue collected before fix-it edits are attached to it */
+typedef struct {
+	/** Diagnostic */
+	diag_entry_t entry;
+	/** Copy of check identifier */
+	char *check;
+	/** Copy of message */
+	char *msg;
+} ccheck_issue_t;
+
+/** Issues collected while checking a file */
+typedef struct {
+	/** Issues */
+	ccheck_issue_t *issues;
+	/** Number of issues */
+	size_t nissues;
+	/** Number of allocated entries in @c issues */
+	size_t alloc;
+} ccheck_issues_t;
+
+/** Summary of checking multiple files */
+typedef struct {
+	/** Number of checked files with issues */
+	unsigned long nissue;
+	/** Number of checked files without issues */
+	unsigned long nclean;
+	/** Number of files that could not be checked (e.g. parse errors) */
+	unsigned long nfail;
+} ccheck_summary_t;
 
 static void print_syntax(void)
 {
 	(void)printf("C-style checker\n");
 	(void)printf("syntax:\n"
 	    "\tccheck [options] <file> Check C-style in the specified file\n"
+	    "\tccheck [options] -r <path>... Check C-style in all .c and .h "
+	    "files\n\t  under the specified paths\n"
 	    "\tccheck --test Run internal unit tests\n"
 	    "options:\n"
+	    "\t-j <n> Check up to <n> files in parallel (with -r)\n"
+	    "\t--cache-dir=<dir> Reuse results for unchanged files cached "
+	    "in <dir>\n"
+	    "\t--diag-format=<fmt> Report issues as text (default), "
+	    "jsonl or sarif\n"
 	    "\t--fix Attempt to fix issues instead of just reporting them\n"
+	    "\t--diff Print fixes as a unified diff instead of applying "
+	    "them\n"
 	    "\t--dump-ast Dump internal abstract syntax tree\n"
 	    "\t--dump-toks Dump tokenized source file\n"
 	    "\t-d <check> Disable a particular group of checks\n"
 	    "\t  (attr, decl, estmt, fmt, hdr, invchar, loop, sclass)\n");
 }
 
-static int check_file(const char *fname, checker_flags_t flags,
-    checker_cfg_t *cfg)
+/** Copy contents of a file to another file.
+ *
+ * @param srcf Source file
+ * @param destf Destination file
+ * @return EOK on success, EIO on I/O error
+ */
+static int ccheck_copy_file(FILE *srcf, FILE *destf)
+{
+	char buf[ccheck_buf_size];
+	size_t nread;
+
+	do {
+		nread = fread(buf, 1, sizeof(buf), srcf);
+		if (nread > 0 && fwrite(buf, 1, nread, destf) != nread)
+			return EIO;
+	} while (nread == sizeof(buf));
+
+	if (ferror(srcf) != 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Compute result cache key for a file.
+ *
+ * The key consists of the cache version, module type, diagnostic output
+ * format, checker configuration and the contents of the file. The results
+ * are thus reused only if the file and the configuration are unchanged.
+ *
+ * @param fname File name
+ * @param mtype Module type
+ * @param opts Checking options
+ * @param rkey Place to store pointer to new key
+ * @return EOK on success, ENOENT if file cannot be opened,
+ *         ENOMEM if out of memory, EIO on I/O error
+ */
+static int ccheck_cache_key(const char *fname, checker_mtype_t mtype,
+    ccheck_opts_t *opts, cache_key_t **rkey)
+{
+	cache_key_t *key = NULL;
+	FILE *f = NULL;
+	char buf[ccheck_buf_size];
+	size_t nread;
+	int rc;
+	int rv;
+
+	rc = cache_key_create(&key);
+	if (rc != EOK)
+		goto error;
+
+	rv = snprintf(buf, sizeof(buf), "ccheck %d %d %d\n",
+	    ccheck_cache_version, (int)mtype, (int)opts->dfmt);
+	if (rv < 0 || (size_t)rv >= sizeof(buf)) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = cache_key_append(key, buf, (size_t)rv);
+	if (rc != EOK)
+		goto error;
+
+	/* Each option separately (structure padding is undefined) */
+	rv = snprintf(buf, sizeof(buf), "cfg %d %d %d %d %d %d %d %d %d\n",
+	    (int)opts->cfg.attr, (int)opts->cfg.decl, (int)opts->cfg.estmt,
+	    (int)opts->cfg.fmt, (int)opts->cfg.hdr, (int)opts->cfg.invchar,
+	    (int)opts->cfg.loop, (int)opts->cfg.nblock,
+	    (int)opts->cfg.sclass);
+	if (rv < 0 || (size_t)rv >= sizeof(buf)) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = cache_key_append(key, buf, (size_t)rv);
+	if (rc != EOK)
+		goto error;
+
+	f = fopen(fname, "rb");
+	if (f == NULL) {
+		rc = ENOENT;
+		goto error;
+	}
+
+	do {
+		nread = fread(buf, 1, sizeof(buf), f);
+		rc = cache_key_append(key, buf, nread);
+		if (rc != EOK)
+			goto error;
+	} while (nread == sizeof(buf));
+
+	if (ferror(f) != 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	(void)fclose(f);
+	*rkey = key;
+	return EOK;
+error:
+	if (f != NULL)
+		(void)fclose(f);
+	cache_key_destroy(key);
+	return rc;
+}
+
+/** Replay checker results from result cache.
+ *
+ * @param dataf Cache entry file
+ * @param rnissues Place to store number of reported issues
+ * @return EOK on success, EIO if the entry cannot be read
+ */
+static int ccheck_cache_replay(FILE *dataf, unsigned long *rnissues)
+{
+	unsigned long nissues;
+	int rc;
+
+	if (fread(&nissues, sizeof(nissues), 1, dataf) != 1)
+		return EIO;
+
+	rc = ccheck_copy_file(dataf, stdout);
+	if (rc != EOK)
+		return rc;
+
+	*rnissues = nissues;
+	return EOK;
+}
+
+/** Write checker results to result cache entry.
+ *
+ * @param arg Cache entry (ccheck_cache_entry_t *)
+ * @param f Cache entry file
+ * @return EOK on success or an error code
+ */
+static int ccheck_cache_write(void *arg, FILE *f)
+{
+	ccheck_cache_entry_t *entry = (ccheck_cache_entry_t *)arg;
+
+	if (fwrite(&entry->nissues, sizeof(entry->nissues), 1, f) != 1)
+		return EIO;
+
+	if (fseek(entry->outf, 0, SEEK_SET) < 0)
+		return EIO;
+
+	return ccheck_copy_file(entry->outf, f);
+}
+
+/** Read contents of a file into memory.
+ *
+ * @param f File
+ * @param rbuf Place to store pointer to newly allocated buffer
+ * @param rsize Place to store size of data
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ */
+static int ccheck_read_file(FILE *f, char **rbuf, size_t *rsize)
+{
+	char *buf = NULL;
+	char *nbuf;
+	size_t bsize = 0;
+	size_t size = 0;
+	size_t nread;
+
+	do {
+		if (size == bsize) {
+			bsize = bsize > 0 ? 2 * bsize : ccheck_buf_size;
+			nbuf = realloc(buf, bsize);
+			if (nbuf == NULL) {
+				free(buf);
+				return ENOMEM;
+			}
+
+			buf = nbuf;
+		}
+
+		nread = fread(buf + size, 1, bsize - size, f);
+		size += nread;
+	} while (nread > 0);
+
+	if (ferror(f) != 0) {
+		free(buf);
+		return EIO;
+	}
+
+	*rbuf = buf;
+	*rsize = size;
+	return EOK;
+}
+
+/** Replace contents of a file.
+ *
+ * The new contents are written to a temporary file first, which then
+ * replaces the original file. Thus the file is either left untouched
+ * or completely rewritten, even if ccheck is interrupted.
+ *
+ * @param fname File name
+ * @param buf New contents
+ * @param size Size of new contents
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ */
+static int ccheck_replace_file(const char *fname, const char *buf,
+    size_t size)
+{
+	char *tmpname = NULL;
+	FILE *f = NULL;
+	int rc;
+	int rv;
+
+	rv = asprintf(&tmpname, "%s.tmp", fname);
+	if (rv < 0) {
+		tmpname = NULL;
+		rc = ENOMEM;
+		goto error;
+	}
+
+	f = fopen(tmpname, "wt");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s' for writing.\n",
+		    tmpname);
+		rc = EIO;
+		goto error;
+	}
+
+	if (fwrite(buf, 1, size, f) != size) {
+		(void)fprintf(stderr, "Error writing '%s'.\n", tmpname);
+		rc = EIO;
+		goto error;
+	}
+
+	rv = fclose(f);
+	f = NULL;
+	if (rv < 0) {
+		(void)fprintf(stderr, "Error writing '%s'.\n", tmpname);
+		rc = EIO;
+		goto error;
+	}
+
+	if (rename(tmpname, fname) < 0) {
+		(void)fprintf(stderr, "Error renaming '%s' to '%s'.\n",
+		    tmpname, fname);
+		rc = EIO;
+		goto error;
+	}
+
+	free(tmpname);
+	return EOK;
+error:
+	if (f != NULL)
+		(void)fclose(f);
+	if (tmpname != NULL) {
+		(void)remove(tmpname);
+		free(tmpname);
+	}
+	return rc;
+}
+
+/** Apply fixes made by checker to a file.
+ *
+ * The fixed source code is compared with the original file. If they
+ * differ, the file is replaced with the fixed version or, with
+ * @c cf_diff, the differences are printed to standard output as
+ * a unified diff. A file that would not change is never written to,
+ * so that its modification time is preserved.
+ *
+ * @param fname File name
+ * @param checker Checker that fixed the file
+ * @param flags Checker flags
+ * @return EOK on success or an error code
+ */
+static int ccheck_apply_fixes(const char *fname, checker_t *checker,
+    checker_flags_t flags)
+{
+	FILE *f = NULL;
+	char *obuf = NULL;
+	size_t osize;
+	char *nbuf = NULL;
+	size_t nsize;
+	int rc;
+
+	f = fopen(fname, "rt");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+		rc = ENOENT;
+		goto error;
+	}
+
+	rc = ccheck_read_file(f, &obuf, &osize);
+	if (rc != EOK) {
+		(void)fprintf(stderr, "Error reading '%s'.\n", fname);
+		goto error;
+	}
+
+	(void)fclose(f);
+
+	/* Render the fixed source code */
+	f = tmpfile();
+	if (f == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	rc = checker_print(checker, f);
+	if (rc != EOK)
+		goto error;
+
+	if (fseek(f, 0, SEEK_SET) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	rc = ccheck_read_file(f, &nbuf, &nsize);
+	if (rc != EOK)
+		goto error;
+
+	(void)fclose(f);
+	f = NULL;
+
+	if (nsize == osize && memcmp(nbuf, obuf, osize) == 0) {
+		/* Edits cancelled out, nothing to do */
+		free(obuf);
+		free(nbuf);
+		return EOK;
+	}
+
+	if ((flags & cf_diff) != cf_none)
+		rc = udiff_print(fname, obuf, osize, fname, nbuf, nsize,
+		    stdout);
+	else
+		rc = ccheck_replace_file(fname, nbuf, nsize);
+	if (rc != EOK)
+		goto error;
+
+	free(obuf);
+	free(nbuf);
+	return EOK;
+error:
+	if (f != NULL)
+		(void)fclose(f);
+	free(obuf);
+	free(nbuf);
+	return rc;
+}
+
+/** Collect reported issue.
+ *
+ * @param arg Collected issues (ccheck_issues_t *)
+ * @param entry Diagnostic
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int ccheck_issue_collect(void *arg, diag_entry_t *entry)
+{
+	ccheck_issues_t *issues = (ccheck_issues_t *)arg;
+	ccheck_issue_t *nissues;
+	ccheck_issue_t *issue;
+	size_t nalloc;
+
+	if (issues->nissues == issues->alloc) {
+		nalloc = issues->alloc > 0 ? 2 * issues->alloc : 16;
+		nissues = realloc(issues->issues,
+		    nalloc * sizeof(ccheck_issue_t));
+		if (nissues == NULL)
+			return ENOMEM;
+
+		issues->issues = nissues;
+		issues->alloc = nalloc;
+	}
+
+	issue = &issues->issues[issues->nissues];
+	issue->check = strdup(entry->check);
+	issue->msg = strdup(entry->msg);
+	if (issue->check == NULL || issue->msg == NULL) {
+		free(issue->check);
+		free(issue->msg);
+		return ENOMEM;
+	}
+
+	issue->entry = *entry;
+	issue->entry.check = issue->check;
+	issue->entry.msg = issue->msg;
+	issue->entry.fixes = NULL;
+	issue->entry.nfixes = 0;
+	++issues->nissues;
+	return EOK;
+}
+
+/** Free collected issues.
+ *
+ * @param issues Collected issues
+ */
+static void ccheck_issues_fini(ccheck_issues_t *issues)
+{
+	size_t i;
+
+	for (i = 0; i < issues->nissues; i++) {
+		free(issues->issues[i].check);
+		free(issues->issues[i].msg);
+		free(issues->issues[i].entry.fixes);
+	}
+
+	free(issues->issues);
+	issues->issues = NULL;
+	issues->nissues = 0;
+	issues->alloc = 0;
+}
+
+/** Discard reported issue.
+ *
+ * @param arg Not used
+ * @param entry Not used
+ * @return EOK
+ */
+static int ccheck_issue_discard(void *arg, diag_entry_t *entry)
+{
+	(void)arg;
+	(void)entry;
+	return EOK;
+}
+
+/** Compute line edits that fix a file.
+ *
+ * The file is checked once more with fixing enabled and the fixed source
+ * code is compared with the original file.
+ *
+ * @param fname File name
+ * @param mtype Module type
+ * @param opts Checking options
+ * @param robuf Place to store original file contents
+ * @param rnbuf Place to store fixed file contents
+ * @param redits Place to store array of edits
+ * @param rnedits Place to store number of edits
+ * @return EOK on success or an error code
+ */
+static int ccheck_fix_edits(const char *fname, checker_mtype_t mtype,
+    ccheck_opts_t *opts, char **robuf, char **rnbuf, udiff_edit_t **redits,
+    size_t *rnedits)
+{
+	FILE *f = NULL;
+	file_input_t *finput = NULL;
+	checker_t *checker = NULL;
+	diag_t *diag = NULL;
+	char *obuf = NULL;
+	size_t osize;
+	char *nbuf = NULL;
+	size_t nsize;
+	int rc;
+
+	f = fopen(fname, "rt");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+		rc = ENOENT;
+		goto error;
+	}
+
+	rc = ccheck_read_file(f, &obuf, &osize);
+	if (rc != EOK) {
+		(void)fprintf(stderr, "Error reading '%s'.\n", fname);
+		goto error;
+	}
+
+	if (fseek(f, 0, SEEK_SET) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	rc = file_input_create(f, fname, &finput);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_create(&lexer_file_input, finput, mtype, &opts->cfg,
+	    &checker);
+	if (rc != EOK)
+		goto error;
+
+	/* The issues have already been reported by the first pass */
+	rc = diag_create_cb(ccheck_issue_discard, NULL, &diag);
+	if (rc != EOK)
+		goto error;
+
+	checker_set_diag(checker, diag);
+
+	rc = checker_run(checker, true);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_print_str(checker, &nbuf, &nsize);
+	if (rc != EOK)
+		goto error;
+
+	rc = udiff_edits(obuf, osize, nbuf, nsize, redits, rnedits);
+	if (rc != EOK)
+		goto error;
+
+	checker_destroy(checker);
+	diag_destroy(diag);
+	file_input_destroy(finput);
+	(void)fclose(f);
+	*robuf = obuf;
+	*rnbuf = nbuf;
+	return EOK;
+error:
+	if (checker != NULL)
+		checker_destroy(checker);
+	diag_destroy(diag);
+	file_input_destroy(finput);
+	if (f != NULL)
+		(void)fclose(f);
+	free(obuf);
+	free(nbuf);
+	return rc;
+}
+
+/** Find fixable issue an edit belongs to.
+ *
+ * This is the first fixable issue whose source range overlaps
+ * the replaced lines (or the lines around an insertion). If there
+ * is no such issue, the fixable issue nearest to the edit is used.
+ *
+ * @param issues Collected issues
+ * @param edit Edit
+ * @return Issue or @c NULL if there are no fixable issues
+ */
+static ccheck_issue_t *ccheck_fix_issue(ccheck_issues_t *issues,
+    udiff_edit_t *edit)
+{
+	ccheck_issue_t *issue;
+	ccheck_issue_t *best = NULL;
+	unsigned long first;
+	unsigned long last;
+	unsigned long dist;
+	unsigned long bdist = 0;
+	size_t i;
+
+	/* Lines affected by the edit (starting from 1) */
+	if (edit->alines > 0) {
+		first = edit->aline + 1;
+		last = edit->aline + edit->alines;
+	} else {
+		first = edit->aline > 0 ? edit->aline : 1;
+		last = edit->aline + 1;
+	}
+
+	for (i = 0; i < issues->nissues; i++) {
+		issue = &issues->issues[i];
+		if (!issue->entry.fixable)
+			continue;
+
+		if ((unsigned long)issue->entry.epos.line < first)
+			dist = first - issue->entry.epos.line;
+		else if ((unsigned long)issue->entry.bpos.line > last)
+			dist = issue->entry.bpos.line - last;
+		else
+			return issue;
+
+		if (best == NULL || dist < bdist) {
+			best = issue;
+			bdist = dist;
+		}
+	}
+
+	return best;
+}
+
+/** Attach fix-it edits to collected issues.
+ *
+ * Each edit is attached to exactly one fixable issue. Edits of adjacent
+ * lines are merged into one edit, which then belongs to the first
+ * of the issues it fixes.
+ *
+ * @param fname File name
+ * @param mtype Module type
+ * @param opts Checking options
+ * @param issues Collected issues
+ * @param rnbuf Place to store fixed file contents, which the fix-it
+ *              edits refer to
+ * @return EOK on success or an error code
+ */
+static int ccheck_attach_fixes(const char *fname, checker_mtype_t mtype,
+    ccheck_opts_t *opts, ccheck_issues_t *issues, char **rnbuf)
+{
+	char *obuf = NULL;
+	char *nbuf = NULL;
+	udiff_edit_t *edits = NULL;
+	size_t nedits;
+	ccheck_issue_t *issue;
+	diag_fix_t *fix;
+	size_t i;
+	int rc;
+
+	rc = ccheck_fix_edits(fname, mtype, opts, &obuf, &nbuf, &edits,
+	    &nedits);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < nedits; i++) {
+		issue = ccheck_fix_issue(issues, &edits[i]);
+		if (issue == NULL)
+			continue;
+
+		if (issue->entry.fixes == NULL) {
+			issue->entry.fixes = calloc(nedits,
+			    sizeof(diag_fix_t));
+			if (issue->entry.fixes == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+		}
+
+		fix = &issue->entry.fixes[issue->entry.nfixes++];
+		fix->line = (unsigned long)edits[i].aline + 1;
+		fix->nlines = (unsigned long)edits[i].alines;
+		fix->text = nbuf + edits[i].boff;
+		fix->size = edits[i].bsize;
+	}
+
+	free(obuf);
+	free(edits);
+	*rnbuf = nbuf;
+	return EOK;
+error:
+	free(obuf);
+	free(nbuf);
+	free(edits);
+	return rc;
+}
+
+/** Check a file.
+ *
+ * If result cache is enabled and the file has already been checked
+ * with the same configuration, the reported issues are taken from
+ * the cache instead, without lexing and parsing the file.
+ *
+ * @param fname File name
+ * @param opts Checking options
+ * @param rnissues Place to store number of reported issues
+ * @return EOK on success (even if issues were reported) or an error code
+ */
+static int check_file(const char *fname, ccheck_opts_t *opts,
+    unsigned long *rnissues)
 {
 	int rc;
 	int rv;
 	checker_t *checker = NULL;
 	checker_mtype_t mtype;
-	char *bkname;
 	const char *ext;
 	file_input_t *finput = NULL;
 	FILE *f = NULL;
+	cache_key_t *key = NULL;
+	ccheck_cache_entry_t entry;
+	FILE *dataf;
+	diag_t *sink;
+	diag_t *cdiag = NULL;
+	ccheck_issues_t issues;
+	char *fbuf = NULL;
+	bool have_fixable;
+	size_t i;
+
+	entry.outf = NULL;
+	entry.diag = NULL;
+	issues.issues = NULL;
+	issues.nissues = 0;
+	issues.alloc = 0;
 
 	ext = strrchr(fname, '.');
 	if (ext == NULL) {
@@ -80,6 +845,31 @@ static int check_file(const char *fname, checker_flags_t flags,
 		goto error;
 	}
 
+	/* Results are only cached when just reporting issues */
+	if (opts->cache != NULL && opts->flags == cf_none) {
+		rc = ccheck_cache_key(fname, mtype, opts, &key);
+		if (rc == ENOENT) {
+			(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+			goto error;
+		} else if (rc != EOK) {
+			goto error;
+		}
+
+		rc = cache_lookup(opts->cache, key, &dataf);
+		if (rc == EOK) {
+			rc = ccheck_cache_replay(dataf, rnissues);
+			(void)fclose(dataf);
+			if (rc == EOK) {
+				/* Cache hit */
+				cache_key_destroy(key);
+				return EOK;
+			}
+		}
+
+		if (rc == ENOMEM)
+			goto error;
+	}
+
 	f = fopen(fname, "rt");
 	if (f == NULL) {
 		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
@@ -93,11 +883,41 @@ static int check_file(const char *fname, checker_flags_t flags,
 		goto error;
 	}
 
-	rc = checker_create(&lexer_file_input, finput, mtype, cfg, &checker);
+	rc = checker_create(&lexer_file_input, finput, mtype, &opts->cfg,
+	    &checker);
 	if (rc != EOK)
 		goto error;
 
-	if ((flags & cf_dump_ast) != cf_none) {
+	sink = opts->diag;
+
+	/* Capture reported issues so that they can be stored in cache */
+	if (key != NULL) {
+		entry.outf = tmpfile();
+		if (entry.outf != NULL) {
+			rc = diag_create(opts->dfmt, "ccheck", entry.outf,
+			    &entry.diag);
+			if (rc != EOK)
+				goto error;
+
+			sink = entry.diag;
+		}
+	}
+
+	/*
+	 * Structured output includes fix-it edits. Collect the issues first
+	 * so that the edits can be attached to them before they are reported.
+	 */
+	if (opts->dfmt != dfmt_text && (opts->flags & cf_fix) == cf_none) {
+		rc = diag_create_cb(ccheck_issue_collect, &issues, &cdiag);
+		if (rc != EOK)
+			goto error;
+
+		checker_set_diag(checker, cdiag);
+	} else {
+		checker_set_diag(checker, sink);
+	}
+
+	if ((opts->flags & cf_dump_ast) != cf_none) {
 		rc = checker_dump_ast(checker, stdout);
 		if (rc != EOK)
 			goto error;
@@ -109,7 +929,7 @@ static int check_file(const char *fname, checker_flags_t flags,
 		}
 	}
 
-	if ((flags & cf_dump_toks) != cf_none) {
+	if ((opts->flags & cf_dump_toks) != cf_none) {
 		rc = checker_dump_toks(checker, stdout);
 		if (rc != EOK)
 			goto error;
@@ -121,50 +941,73 @@ static int check_file(const char *fname, checker_flags_t flags,
 		}
 	}
 
-	rc = checker_run(checker, (flags & cf_fix) != cf_none);
+	rc = checker_run(checker, (opts->flags & cf_fix) != cf_none);
 	if (rc != EOK)
 		goto error;
 
 	(void)fclose(f);
 	f = NULL;
 
-	if ((flags & cf_fix) != cf_none) {
-		if (asprintf(&bkname, "%s.orig", fname) < 0) {
-			rc = ENOMEM;
-			goto error;
+	if (cdiag != NULL) {
+		have_fixable = false;
+		for (i = 0; i < issues.nissues; i++) {
+			if (issues.issues[i].entry.fixable)
+				have_fixable = true;
 		}
 
-		if (rename(fname, bkname) < 0) {
-			(void)fprintf(stderr, "Error renaming '%s' to '%s'.\n",
-			    fname, bkname);
-			rc = EIO;
-			goto error;
+		if (have_fixable) {
+			rc = ccheck_attach_fixes(fname, mtype, opts, &issues,
+			    &fbuf);
+			if (rc != EOK)
+				goto error;
 		}
 
-		f = fopen(fname, "wt");
-		if (f == NULL) {
-			(void)fprintf(stderr, "Cannot open '%s' for writing.\n",
-			    fname);
-			rc = EIO;
-			goto error;
+		for (i = 0; i < issues.nissues; i++) {
+			rc = diag_report(sink, &issues.issues[i].entry);
+			if (rc != EOK)
+				goto error;
 		}
 
-		rc = checker_print(checker, f);
+		ccheck_issues_fini(&issues);
+		diag_destroy(cdiag);
+		cdiag = NULL;
+		free(fbuf);
+		fbuf = NULL;
+	}
+
+	if ((opts->flags & cf_fix) != cf_none &&
+	    checker_get_nedits(checker) > 0) {
+		rc = ccheck_apply_fixes(fname, checker, opts->flags);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (entry.outf != NULL) {
+		rc = diag_finish(entry.diag);
 		if (rc != EOK)
 			goto error;
 
-		if (fclose(f) < 0) {
-			f = NULL;
-			(void)fprintf(stderr, "Error writing '%s'.\n", fname);
+		if (fseek(entry.outf, 0, SEEK_SET) < 0) {
 			rc = EIO;
 			goto error;
 		}
 
-		f = NULL;
+		rc = ccheck_copy_file(entry.outf, stdout);
+		if (rc != EOK)
+			goto error;
+
+		/* Failing to store results is not an error */
+		entry.nissues = checker_get_nissues(checker);
+		(void)cache_store(opts->cache, key, ccheck_cache_write,
+		    &entry);
+		diag_destroy(entry.diag);
+		(void)fclose(entry.outf);
 	}
 
+	*rnissues = checker_get_nissues(checker);
 	checker_destroy(checker);
 	file_input_destroy(finput);
+	cache_key_destroy(key);
 
 	return EOK;
 error:
@@ -173,9 +1016,311 @@ error:
 	file_input_destroy(finput);
 	if (f != NULL)
 		(void)fclose(f);
+	diag_destroy(entry.diag);
+	if (entry.outf != NULL)
+		(void)fclose(entry.outf);
+	ccheck_issues_fini(&issues);
+	diag_destroy(cdiag);
+	free(fbuf);
+	cache_key_destroy(key);
 	return rc;
 }
 
+/** Add file to list of files to check if it is a C source or header.
+ *
+ * @param arg File list (ccheck_flist_t *)
+ * @param path File path
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int ccheck_flist_add(void *arg, const char *path)
+{
+	ccheck_flist_t *flist = (ccheck_flist_t *)arg;
+	const char *ext;
+	char **nfnames;
+	size_t nalloc;
+
+	ext = strrchr(path, '.');
+	if (ext == NULL || (strcmp(ext, ".c") != 0 && strcmp(ext, ".h") != 0))
+		return EOK;
+
+	if (flist->nfiles >= flist->alloc) {
+		nalloc = flist->alloc > 0 ? 2 * flist->alloc : 64;
+		nfnames = realloc(flist->fnames, nalloc * sizeof(char *));
+		if (nfnames == NULL)
+			return ENOMEM;
+
+		flist->fnames = nfnames;
+		flist->alloc = nalloc;
+	}
+
+	flist->fnames[flist->nfiles] = strdup(path);
+	if (flist->fnames[flist->nfiles] == NULL)
+		return ENOMEM;
+
+	++flist->nfiles;
+	return EOK;
+}
+
+/** Free file list.
+ *
+ * @param flist File list
+ */
+static void ccheck_flist_fini(ccheck_flist_t *flist)
+{
+	size_t i;
+
+	for (i = 0; i < flist->nfiles; i++)
+		free(flist->fnames[i]);
+	free(flist->fnames);
+}
+
+/** Add result of checking one file to summary.
+ *
+ * @param summary Summary
+ * @param rc Return code of check_file()
+ * @param nissues Number of reported issues
+ */
+static void ccheck_summary_add(ccheck_summary_t *summary, int rc,
+    unsigned long nissues)
+{
+	if (rc != EOK)
+		++summary->nfail;
+	else if (nissues > 0)
+		++summary->nissue;
+	else
+		++summary->nclean;
+}
+
+/** Check batch of files as a parallel job.
+ *
+ * This is executed in a separate process. For each file, the result
+ * (ccheck_result_t) is written to @a dataf.
+ *
+ * @param arg Batch (ccheck_batch_t *)
+ * @param dataf File for passing results to the parent
+ * @return EOK on success, EIO on I/O error
+ */
+static int check_batch_job(void *arg, FILE *dataf)
+{
+	ccheck_batch_t *batch = (ccheck_batch_t *)arg;
+	ccheck_result_t res;
+	size_t i;
+
+	for (i = batch->first; i < batch->first + batch->count; i++) {
+		res.nissues = 0;
+		res.rc = check_file(batch->flist->fnames[i], batch->opts,
+		    &res.nissues);
+
+		/* Keep output of the file together with its error messages */
+		(void)fflush(stdout);
+
+		if (fwrite(&res, sizeof(res), 1, dataf) != 1)
+			return EIO;
+	}
+
+	return EOK;
+}
+
+/** Check files sequentially.
+ *
+ * @param flist Files to check
+ * @param opts Checking options
+ * @param summary Summary to update
+ */
+static void check_files(ccheck_flist_t *flist, ccheck_opts_t *opts,
+    ccheck_summary_t *summary)
+{
+	unsigned long nissues;
+	size_t i;
+	int rc;
+
+	for (i = 0; i < flist->nfiles; i++) {
+		nissues = 0;
+		rc = check_file(flist->fnames[i], opts, &nissues);
+		(void)fflush(stdout);
+		ccheck_summary_add(summary, rc, nissues);
+	}
+}
+
+/** Check files in parallel.
+ *
+ * The list is split into contiguous batches, each checked by a separate
+ * job, with up to @a njobs jobs running simultaneously. Once all jobs
+ * have finished, their output is replayed in list order, so that
+ * the output is the same as if the files were checked sequentially.
+ *
+ * @param flist Files to check
+ * @param opts Checking options
+ * @param njobs Maximum number of jobs running simultaneously
+ * @param summary Summary to update
+ * @return EOK on success or an error code
+ */
+static int check_files_parallel(ccheck_flist_t *flist, ccheck_opts_t *opts,
+    unsigned njobs, ccheck_summary_t *summary)
+{
+	jobs_t *jobs = NULL;
+	ccheck_batch_t *batches = NULL;
+	size_t nbatches;
+	size_t first;
+	size_t i;
+	size_t j;
+	ccheck_result_t res;
+	FILE *dataf;
+	int rc;
+
+	nbatches = (size_t)njobs * batches_per_job;
+	if (nbatches > flist->nfiles)
+		nbatches = flist->nfiles;
+
+	batches = calloc(nbatches, sizeof(ccheck_batch_t));
+	if (batches == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = jobs_create(njobs, &jobs);
+	if (rc != EOK)
+		goto error;
+
+	jobs_set_merge_out(jobs, true);
+
+	first = 0;
+	for (i = 0; i < nbatches; i++) {
+		batches[i].flist = flist;
+		batches[i].first = first;
+		batches[i].count = (flist->nfiles - first) / (nbatches - i);
+		batches[i].opts = opts;
+		first += batches[i].count;
+
+		rc = jobs_add(jobs, check_batch_job, &batches[i],
+		    &batches[i].job);
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Error creating check job.\n");
+			goto error;
+		}
+	}
+
+	rc = jobs_run(jobs);
+	if (rc != EOK) {
+		(void)fprintf(stderr, "Error running check jobs.\n");
+		goto error;
+	}
+
+	for (i = 0; i < nbatches; i++) {
+		rc = job_replay(batches[i].job);
+		if (rc != EOK)
+			goto error;
+
+		/* Files without a result could not be checked */
+		dataf = job_get_data(batches[i].job);
+		for (j = 0; j < batches[i].count; j++) {
+			if (fread(&res, sizeof(res), 1, dataf) != 1) {
+				res.rc = EIO;
+				res.nissues = 0;
+			}
+
+			ccheck_summary_add(summary, res.rc, res.nissues);
+		}
+	}
+
+	jobs_destroy(jobs);
+	free(batches);
+	return EOK;
+error:
+	jobs_destroy(jobs);
+	free(batches);
+	return rc;
+}
+
+/** Check all C source and header files under the specified paths.
+ *
+ * Directories are walked recursively. A summary is printed at the end.
+ *
+ * @param paths Paths to files or directories
+ * @param npaths Number of paths
+ * @param opts Checking options
+ * @param njobs Maximum number of files checked in parallel
+ * @param rpassed Place to store @c true iff no issues were found
+ * @return EOK on success (even if issues were found) or an error code
+ */
+static int check_tree(char **paths, int npaths, ccheck_opts_t *opts,
+    unsigned njobs, bool *rpassed)
+{
+	ccheck_flist_t flist;
+	ccheck_summary_t summary;
+	FILE *sumf;
+	int i;
+	int rc;
+
+	/* Keep structured diagnostic output free of the summary */
+	sumf = opts->dfmt == dfmt_text ? stdout : stderr;
+
+	memset(&flist, 0, sizeof(flist));
+	memset(&summary, 0, sizeof(summary));
+
+	for (i = 0; i < npaths; i++) {
+		rc = dirwalk(paths[i], ccheck_flist_add, &flist);
+		if (rc == ENOENT) {
+			(void)fprintf(stderr, "Cannot open '%s'.\n", paths[i]);
+			goto error;
+		} else if (rc != EOK) {
+			(void)fprintf(stderr, "Error reading '%s'.\n",
+			    paths[i]);
+			goto error;
+		}
+	}
+
+	if (njobs > 1 && flist.nfiles > 1) {
+		rc = check_files_parallel(&flist, opts, njobs, &summary);
+		if (rc != EOK)
+			goto error;
+	} else {
+		check_files(&flist, opts, &summary);
+	}
+
+	if (summary.nissue == 0 && summary.nfail == 0) {
+		(void)fprintf(sumf, "Ccheck passed.\n");
+		*rpassed = true;
+	} else {
+		(void)fprintf(sumf, "Ccheck failed.\n");
+		(void)fprintf(sumf, "Checked files with issues: %lu\n",
+		    summary.nissue);
+		(void)fprintf(sumf, "Checked files without issues: %lu\n",
+		    summary.nclean);
+		(void)fprintf(sumf, "Files with parse errors: %lu\n",
+		    summary.nfail);
+		*rpassed = false;
+	}
+
+	ccheck_flist_fini(&flist);
+	return EOK;
+error:
+	ccheck_flist_fini(&flist);
+	return rc;
+}
+
+/** Parse number of parallel jobs.
+ *
+ * @param str String containing number of jobs
+ * @param rnjobs Place to store number of jobs
+ * @return EOK on success, EINVAL if @a str is not a valid number of jobs
+ */
+static int parse_jobs(const char *str, unsigned *rnjobs)
+{
+	unsigned long njobs;
+	char *endptr;
+
+	njobs = strtoul(str, &endptr, 10);
+	if (*str == '\0' || *endptr != '\0' || njobs < 1 ||
+	    njobs > max_jobs) {
+		(void)fprintf(stderr, "Invalid number of jobs '%s'.\n", str);
+		return EINVAL;
+	}
+
+	*rnjobs = (unsigned)njobs;
+	return EOK;
+}
+
 /** Disable a check group in configuration based on check name.
  *
  * @param cfg Configuration to alter
@@ -215,10 +1360,19 @@ int main(int argc, char *argv[])
 {
 	int rc;
 	int i;
-	checker_flags_t flags = cf_none;
-	checker_cfg_t cfg;
+	ccheck_opts_t opts;
+	unsigned long nissues;
+	bool recursive = false;
+	bool passed = true;
+	unsigned njobs = 0;
+	const char *cachedir = NULL;
+	const char *dfname;
 
-	checker_cfg_init(&cfg);
+	opts.flags = cf_none;
+	checker_cfg_init(&opts.cfg);
+	opts.cache = NULL;
+	opts.diag = NULL;
+	opts.dfmt = dfmt_text;
 
 	(void)argc;
 	(void)argv;
@@ -249,18 +1403,85 @@ int main(int argc, char *argv[])
 		(void)printf("test_checker -> %d\n", rc);
 		if (rc != EOK)
 			return 1;
+
+		rc = test_src_pos();
+		(void)printf("test_src_pos -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
+
+		rc = test_arena();
+		(void)printf("test_arena -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
+
+		rc = test_strtab();
+		(void)printf("test_strtab -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
+
+		rc = test_kwtab();
+		(void)printf("test_kwtab -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
+
+		rc = test_udiff();
+		(void)printf("test_udiff -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
+
+		rc = test_libccheck();
+		(void)printf("test_libccheck -> %d\n", rc);
+		if (rc != EOK)
+			return 1;
 	} else {
 		i = 1;
 		while (argc > i && argv[i][0] == '-') {
 			if (strcmp(argv[i], "--fix") == 0) {
 				++i;
-				flags |= cf_fix;
+				opts.flags |= cf_fix;
+			} else if (strcmp(argv[i], "--diff") == 0) {
+				++i;
+				opts.flags |= cf_fix | cf_diff;
 			} else if (strcmp(argv[i], "--dump-ast") == 0) {
 				++i;
-				flags |= cf_dump_ast;
+				opts.flags |= cf_dump_ast;
 			} else if (strcmp(argv[i], "--dump-toks") == 0) {
 				++i;
-				flags |= cf_dump_toks;
+				opts.flags |= cf_dump_toks;
+			} else if (strcmp(argv[i], "-r") == 0) {
+				++i;
+				recursive = true;
+			} else if (strcmp(argv[i], "-j") == 0) {
+				if (argc <= i + 1) {
+					(void)fprintf(stderr,
+					    "Option '-j' needs an argument.\n");
+					return 1;
+				}
+
+				rc = parse_jobs(argv[i + 1], &njobs);
+				if (rc != EOK)
+					return 1;
+				i += 2;
+			} else if (strncmp(argv[i], "-j", strlen("-j")) == 0) {
+				rc = parse_jobs(argv[i] + strlen("-j"), &njobs);
+				if (rc != EOK)
+					return 1;
+				++i;
+			} else if (strncmp(argv[i], "--cache-dir=",
+			    strlen("--cache-dir=")) == 0) {
+				cachedir = argv[i] + strlen("--cache-dir=");
+				++i;
+			} else if (strncmp(argv[i], "--diag-format=",
+			    strlen("--diag-format=")) == 0) {
+				dfname = argv[i] + strlen("--diag-format=");
+				rc = diag_fmt_parse(dfname, &opts.dfmt);
+				if (rc != EOK) {
+					(void)fprintf(stderr, "Invalid "
+					    "diagnostic format '%s'.\n",
+					    dfname);
+					return 1;
+				}
+				++i;
 			} else if (strcmp(argv[i], "-") == 0) {
 				++i;
 				break;
@@ -272,7 +1493,7 @@ int main(int argc, char *argv[])
 					return 1;
 				}
 
-				rc = check_disable(&cfg, argv[i]);
+				rc = check_disable(&opts.cfg, argv[i]);
 				if (rc != EOK)
 					return 1;
 				++i;
@@ -287,10 +1508,59 @@ int main(int argc, char *argv[])
 			return 1;
 		}
 
-		rc = check_file(argv[i], flags, &cfg);
+		/*
+		 * A SARIF log is a single JSON document that cannot be
+		 * assembled from independently produced pieces. Check files
+		 * one by one and do not cache results in that case.
+		 */
+		if (opts.dfmt == dfmt_sarif) {
+			njobs = 1;
+			cachedir = NULL;
+		}
+
+		/* With --diff standard output is reserved for the diff */
+		rc = diag_create(opts.dfmt, "ccheck",
+		    (opts.flags & cf_diff) != cf_none ? stderr : stdout,
+		    &opts.diag);
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Out of memory.\n");
+			return 1;
+		}
+
+		if (cachedir != NULL) {
+			rc = cache_create(cachedir, &opts.cache);
+			if (rc != EOK) {
+				(void)fprintf(stderr, "Out of memory.\n");
+				diag_destroy(opts.diag);
+				return 1;
+			}
+		}
+
+		if (!recursive) {
+			rc = check_file(argv[i], &opts, &nissues);
+		} else {
+			if (njobs == 0) {
+				/* Use all processors by default */
+				njobs = jobs_ncpus();
+				if (njobs > max_jobs)
+					njobs = max_jobs;
+			}
+
+			if (njobs > 1 && !jobs_supported())
+				njobs = 1;
+
+			rc = check_tree(&argv[i], argc - i, &opts, njobs,
+			    &passed);
+		}
+
+		if (diag_finish(opts.diag) != EOK && rc == EOK)
+			rc = EIO;
+
+		cache_destroy(opts.cache);
+		diag_destroy(opts.diag);
 	}
 
-	if (rc != EOK)
+	if (rc != EOK || !passed)
 		return 1;
 
 	return 0;
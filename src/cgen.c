@@ -35,6 +35,7 @@
 #include <comp.h>
 #include <cgen.h>
 #include <cgtype.h>
+#include <diag.h>
 #include <inttypes.h>
 #include <ir.h>
 #include <labels.h>
@@ -42,7 +43,9 @@
 #include <merrno.h>
 #include <parser.h>
 #include <scope.h>
+#include <stdarg.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <symbols.h>
@@ -179,6 +182,114 @@ static parser_cb_t cgen_parser_cb = {
 	.ident_is_type = cgen_ident_is_type
 };
 
+/** Begin rendering a diagnostic message.
+ *
+ * The message text is then written to @c cgen->msgf and the message
+ * is reported by calling cgen_msg_end().
+ *
+ * @param cgen Code generator
+ * @param tok Token the message refers to
+ * @param sev Severity
+ */
+static void cgen_msg_begin(cgen_t *cgen, lexer_tok_t *tok, diag_sev_t sev)
+{
+	cgen->msgtok = tok;
+	cgen->msgsev = sev;
+	(void)fseek(cgen->msgf, 0, SEEK_SET);
+}
+
+/** Finish rendering a diagnostic message and report it.
+ *
+ * The rendered message is submitted to the diagnostics sink as a single
+ * entry. Without a diagnostics sink it is printed to standard error.
+ *
+ * @param cgen Code generator
+ */
+static void cgen_msg_end(cgen_t *cgen)
+{
+	diag_entry_t entry;
+	char *msg;
+	long size;
+
+	size = ftell(cgen->msgf);
+	if (size < 0)
+		size = 0;
+
+	msg = malloc((size_t)size + 1);
+	if (msg == NULL)
+		return;
+
+	(void)fseek(cgen->msgf, 0, SEEK_SET);
+	size = (long)fread(msg, 1, (size_t)size, cgen->msgf);
+	msg[(size_t)size] = '\0';
+
+	if (cgen->diag == NULL) {
+		(void)lexer_dprint_tok(cgen->msgtok, stderr);
+		(void)fprintf(stderr, ": %s%s\n", cgen->msgsev == dsev_warning ?
+		    "Warning: " : "", msg);
+		free(msg);
+		return;
+	}
+
+	memset(&entry, 0, sizeof(entry));
+	entry.sev = cgen->msgsev;
+	entry.check = "cgen";
+	entry.tok = cgen->msgtok;
+	entry.bpos = cgen->msgtok->bpos;
+	entry.epos = cgen->msgtok->epos;
+	entry.msg = msg;
+
+	(void)diag_report(cgen->diag, &entry);
+	free(msg);
+}
+
+/** Report a diagnostic message.
+ *
+ * @param cgen Code generator
+ * @param tok Token the message refers to
+ * @param sev Severity
+ * @param fmt Format string
+ * @param ap Arguments
+ */
+static void cgen_vmsg(cgen_t *cgen, lexer_tok_t *tok, diag_sev_t sev,
+    const char *fmt, va_list ap)
+{
+	cgen_msg_begin(cgen, tok, sev);
+	(void)vfprintf(cgen->msgf, fmt, ap);
+	cgen_msg_end(cgen);
+}
+
+/** Report a warning.
+ *
+ * @param cgen Code generator
+ * @param tok Token the warning refers to
+ * @param fmt Format string
+ */
+static void cgen_warning(cgen_t *cgen, lexer_tok_t *tok, const char *fmt,
+    ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	cgen_vmsg(cgen, tok, dsev_warning, fmt, ap);
+	va_end(ap);
+}
+
+/** Report an error.
+ *
+ * @param cgen Code generator
+ * @param tok Token the error refers to
+ * @param fmt Format string
+ */
+static void cgen_error(cgen_t *cgen, lexer_tok_t *tok, const char *fmt, ...)
+{
+	va_list ap;
+
+	va_start(ap, fmt);
+	cgen_vmsg(cgen, tok, dsev_error, fmt, ap);
+	va_end(ap);
+}
+
 /** Parser callback to process global declaration.
  *
  * @param arg Argument (cgen_t *)
@@ -1207,33 +1318,26 @@ static int cgen_intlit_val(cgen_t *cgen, comp_tok_t *tlit, int64_t *rval,
 
 	if (!lunsigned && (uint64_t)val > 0x7ffffffful && elmtype != cgelm_longlong &&
 	    elmtype != cgelm_ulonglong) {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Constant should be "
-		    "long long.\n");
+		cgen_warning(cgen, &tlit->tok, "Constant should be long long.");
 		++cgen->warnings;
 	} else if ((uint64_t)val > 0xfffffffful && elmtype != cgelm_longlong &&
 	    elmtype != cgelm_ulonglong) {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Constant should be "
-		    "long long.\n");
+		cgen_warning(cgen, &tlit->tok, "Constant should be long long.");
 		++cgen->warnings;
 	} else if (!lunsigned && (uint64_t)val > 0x7fff && elmtype != cgelm_long &&
 	    elmtype != cgelm_ulong && elmtype != cgelm_longlong &&
 	    elmtype != cgelm_ulonglong) {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Constant should be long.\n");
+		cgen_warning(cgen, &tlit->tok, "Constant should be long.");
 		++cgen->warnings;
 	} else if ((uint64_t)val > 0xffffu && elmtype != cgelm_long &&
 	    elmtype != cgelm_ulong && elmtype != cgelm_longlong &&
 	    elmtype != cgelm_ulonglong) {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Constant should be long.\n");
+		cgen_warning(cgen, &tlit->tok, "Constant should be long.");
 		++cgen->warnings;
 	}
 
 	if (toolarge) {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Constant is too large.\n");
+		cgen_warning(cgen, &tlit->tok, "Constant is too large.");
 		++cgen->warnings;
 	}
 
@@ -1317,9 +1421,8 @@ static int cgen_escseq(cgen_t *cgen, comp_tok_t *tlit, const char **cp,
 			++i;
 		}
 		if (val > max) {
-			(void)lexer_dprint_tok(&tlit->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Octal escape "
-			    "sequence out of range.\n");
+			cgen_warning(cgen, &tlit->tok, "Octal escape sequence "
+			    "out of range.");
 			++cgen->warnings;
 		}
 		c = (uint32_t)val;
@@ -1329,9 +1432,8 @@ static int cgen_escseq(cgen_t *cgen, comp_tok_t *tlit, const char **cp,
 
 		/* Hexadecimal escape sequence */
 		if (!is_hexdigit(*text)) {
-			(void)lexer_dprint_tok(&tlit->tok, stderr);
-			(void)fprintf(stderr, ": Invalid hexadecimal "
-			    "sequence.\n");
+			cgen_error(cgen, &tlit->tok, "Invalid hexadecimal "
+			    "sequence.");
 			cgen->error = true; // TODO
 			return EINVAL;
 		}
@@ -1342,16 +1444,14 @@ static int cgen_escseq(cgen_t *cgen, comp_tok_t *tlit, const char **cp,
 		}
 		c = (uint32_t)val;
 		if (val > max) {
-			(void)lexer_dprint_tok(&tlit->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Hexadecimal escape "
-			    "sequence out of range.\n");
+			cgen_warning(cgen, &tlit->tok, "Hexadecimal escape "
+			    "sequence out of range.");
 			++cgen->warnings;
 		}
 		break;
 	default:
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unknown escape sequence "
-		    "'\\%c'.\n", *text);
+		cgen_warning(cgen, &tlit->tok, "Unknown escape sequence "
+		    "'\\%c'.", *text);
 		++cgen->warnings;
 		c = *text++;
 		break;
@@ -1408,9 +1508,8 @@ static int cgen_charlit_val(cgen_t *cgen, comp_tok_t *tlit, int64_t *rval,
 	}
 
 	if (*text != '\'') {
-		(void)lexer_dprint_tok(&tlit->tok, stderr);
-		(void)fprintf(stderr, ": Multiple characters in character "
-		    "constant.\n");
+		cgen_error(cgen, &tlit->tok, "Multiple characters in character "
+		    "constant.");
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -1431,37 +1530,48 @@ static int cgen_charlit_val(cgen_t *cgen, comp_tok_t *tlit, int64_t *rval,
 	return EOK;
 }
 
-/** Create local variable operand with specific number.
+/** Create variable operand from variable reference.
  *
- * @param var Variable number
+ * @param vref Variable reference
  * @param roper Place to store pointer to new variable operand
  * @return EOK on success, ENOMEM if out of memory
  */
-static int cgen_create_lvar_num_oper(unsigned var, ir_oper_var_t **roper)
+static int cgen_vref_oper(cgen_vref_t *vref, ir_oper_var_t **roper)
 {
-	int rc;
-	int rv;
-	ir_oper_var_t *oper = NULL;
-	char *svar = NULL;
-
-	rv = asprintf(&svar, "%%%u", var);
-	if (rv < 0) {
-		rc = ENOMEM;
-		goto error;
-	}
+	if (vref->varname == NULL)
+		return ir_oper_temp_create(vref->tempno, roper);
 
-	rc = ir_oper_var_create(svar, &oper);
-	if (rc != EOK)
-		goto error;
+	return ir_oper_var_create(vref->varname, roper);
+}
 
-	free(svar);
+/** Get variable reference from variable operand.
+ *
+ * @a vref will only remain valid as long as @a oper exists.
+ *
+ * @param oper Variable operand
+ * @param vref Place to store variable reference
+ */
+static void cgen_vref_from_oper(ir_oper_var_t *oper, cgen_vref_t *vref)
+{
+	vref->varname = oper->varname;
+	vref->tempno = oper->tempno;
+}
 
-	*roper = oper;
-	return EOK;
-error:
-	if (svar != NULL)
-		free(svar);
-	return rc;
+/** Get variable reference from IR variable identifier.
+ *
+ * @a vref will only remain valid as long as @a ident exists.
+ *
+ * @param ident IR variable identifier
+ * @param vref Place to store variable reference
+ */
+static void cgen_vref_from_ident(const char *ident, cgen_vref_t *vref)
+{
+	if (ir_temp_parse(ident, &vref->tempno) == EOK) {
+		vref->varname = NULL;
+	} else {
+		vref->varname = ident;
+		vref->tempno = 0;
+	}
 }
 
 /** Create new numbered local variable operand.
@@ -1476,7 +1586,7 @@ static int cgen_create_new_lvar_oper(cgen_proc_t *cgproc,
 	unsigned var;
 
 	var = cgproc->next_var++;
-	return cgen_create_lvar_num_oper(var, roper);
+	return ir_oper_temp_create(var, roper);
 }
 
 /** Create new local label.
@@ -1723,7 +1833,7 @@ static int cgen_eres_clone(cgen_eres_t *res, cgen_eres_t *dres)
 	if (rc != EOK)
 		return rc;
 
-	dres->varname = res->varname;
+	dres->vref = res->vref;
 	dres->valtype = res->valtype;
 	dres->bitwidth = res->bitwidth;
 	dres->bitpos = res->bitpos;
@@ -1961,9 +2071,8 @@ static int cgen_szexpr_type(cgen_t *cgen, ast_node_t *expr,
 	if (eres.bitwidth > 0) {
 		atok = ast_tree_first_tok(expr);
 		ctok = (comp_tok_t *)atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Sizeof operator applied to "
-		    "bitfield.\n");
+		cgen_error(cgen, &ctok->tok, "Sizeof operator applied to "
+		    "bitfield.");
 		cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -1991,7 +2100,7 @@ error:
 /** Create code generator.
  *
  * @param rcgen Place to store pointer to new code generator
- * @return EOK on success, ENOMEM if out of memory
+ * @return EOK on success, ENOMEM if out of memory, EIO if I/O error
  */
 int cgen_create(cgen_t **rcgen)
 {
@@ -2023,6 +2132,16 @@ int cgen_create(cgen_t **rcgen)
 		return ENOMEM;
 	}
 
+	/* Diagnostic messages are rendered into this file */
+	cgen->msgf = tmpfile();
+	if (cgen->msgf == NULL) {
+		cgen_enums_destroy(cgen->enums);
+		cgen_records_destroy(cgen->records);
+		scope_destroy(cgen->scope);
+		free(cgen);
+		return EIO;
+	}
+
 	cgen->cur_scope = cgen->scope;
 	cgen->error = false;
 	cgen->warnings = 0;
@@ -2102,9 +2221,8 @@ static void cgen_check_scope_unused(cgen_proc_t *cgproc, scope_t *scope)
 	member = scope_first(scope);
 	while (member != NULL) {
 		if (!member->used) {
-			(void)lexer_dprint_tok(member->tident, stderr);
-			(void)fprintf(stderr, ": Warning: '%s' is defined, "
-			    "but not used.\n", member->tident->text);
+			cgen_warning(cgproc->cgen, member->tident, "'%s' is "
+			    "defined, but not used.", member->tident->text);
 			++cgproc->cgen->warnings;
 		}
 		member = scope_next(member);
@@ -2124,16 +2242,14 @@ static int cgen_check_labels(cgen_proc_t *cgproc, labels_t *labels)
 	label = labels_first(labels);
 	while (label != NULL) {
 		if (!label->used) {
-			(void)lexer_dprint_tok(label->tident, stderr);
-			(void)fprintf(stderr, ": Warning: Label '%s' is "
-			    "defined, but not used.\n", label->tident->text);
+			cgen_warning(cgproc->cgen, label->tident, "Label '%s' "
+			    "is defined, but not used.", label->tident->text);
 			++cgproc->cgen->warnings;
 		}
 
 		if (!label->defined) {
-			(void)lexer_dprint_tok(label->tident, stderr);
-			(void)fprintf(stderr, ": Undefined label '%s'.\n",
-			    label->tident->text);
+			cgen_error(cgproc->cgen, label->tident, "Undefined "
+			    "label '%s'.", label->tident->text);
 			cgproc->cgen->error = true; // TODO
 			return EINVAL;
 		}
@@ -2216,9 +2332,8 @@ static void cgen_tqual_check_order(cgen_t *cgen, ast_tqual_t *a, ast_tqual_t *b)
 	if (oa > ob) {
 		catok = (comp_tok_t *) a->tqual.data;
 		cbtok = (comp_tok_t *) b->tqual.data;
-		(void)lexer_dprint_tok(&cbtok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: '%s' should come before "
-		    "'%s'.\n", cbtok->tok.text, catok->tok.text);
+		cgen_warning(cgen, &cbtok->tok, "'%s' should come before '%s'.",
+		    cbtok->tok.text, catok->tok.text);
 		++cgen->warnings;
 	}
 }
@@ -2289,9 +2404,8 @@ static void cgen_tspec_check_order(cgen_t *cgen, ast_node_t *a, ast_node_t *b)
 		catok = (comp_tok_t *) atok->data;
 		btok = ast_tree_first_tok(b);
 		cbtok = (comp_tok_t *) btok->data;
-		(void)lexer_dprint_tok(&cbtok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: '%s' should come before "
-		    "'%s'.\n", cbtok->tok.text, catok->tok.text);
+		cgen_warning(cgen, &cbtok->tok, "'%s' should come before '%s'.",
+		    cbtok->tok.text, catok->tok.text);
 		++cgen->warnings;
 	}
 }
@@ -2326,9 +2440,8 @@ static void cgen_dspec_check_order(cgen_t *cgen, ast_node_t *a, ast_node_t *b)
 			catok = (comp_tok_t *) atok->data;
 			btok = ast_tree_first_tok(b);
 			cbtok = (comp_tok_t *) btok->data;
-			(void)lexer_dprint_tok(&cbtok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: '%s' should come "
-			    "before '%s'.\n", cbtok->tok.text, catok->tok.text);
+			cgen_warning(cgen, &cbtok->tok, "'%s' should come "
+			    "before '%s'.", cbtok->tok.text, catok->tok.text);
 			++cgen->warnings;
 		}
 
@@ -2369,8 +2482,7 @@ static void cgen_error_multiple_tspecs(cgen_t *cgen, ast_node_t *prev,
 	tok1 = (comp_tok_t *) atok1->data;
 	tok2 = (comp_tok_t *) atok2->data;
 
-	(void)lexer_dprint_tok(&tok2->tok, stderr);
-	(void)fprintf(stderr, ": Multiple type specifiers ('%s', '%s').\n",
+	cgen_error(cgen, &tok2->tok, "Multiple type specifiers ('%s', '%s').",
 	    tok1->tok.text, tok2->tok.text);
 
 	cgen->error = true; // TODO
@@ -2387,8 +2499,7 @@ static void cgen_error_multiple_short(cgen_t *cgen, ast_tsbasic_t *tsshort)
 
 	tok = (comp_tok_t *) tsshort->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": More than one short specifier.\n");
+	cgen_error(cgen, &tok->tok, "More than one short specifier.");
 
 	cgen->error = true; // TODO
 }
@@ -2404,8 +2515,7 @@ static void cgen_error_many_long(cgen_t *cgen, ast_tsbasic_t *tslong)
 
 	tok = (comp_tok_t *) tslong->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": More than two long specifiers.\n");
+	cgen_error(cgen, &tok->tok, "More than two long specifiers.");
 
 	cgen->error = true; // TODO
 }
@@ -2421,8 +2531,7 @@ static void cgen_error_short_long(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both short and long specifier.\n");
+	cgen_error(cgen, &tok->tok, "Both short and long specifier.");
 
 	cgen->error = true; // TODO
 }
@@ -2438,8 +2547,7 @@ static void cgen_error_short_xxx(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both short and %s specifier.\n",
+	cgen_error(cgen, &tok->tok, "Both short and %s specifier.",
 	    tok->tok.text);
 
 	cgen->error = true; // TODO
@@ -2456,8 +2564,8 @@ static void cgen_error_long_xxx(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both long and %s specifier.\n", tok->tok.text);
+	cgen_error(cgen, &tok->tok, "Both long and %s specifier.",
+	    tok->tok.text);
 
 	cgen->error = true; // TODO
 }
@@ -2473,8 +2581,7 @@ static void cgen_error_signed_xxx(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both signed and %s specifier.\n",
+	cgen_error(cgen, &tok->tok, "Both signed and %s specifier.",
 	    tok->tok.text);
 
 	cgen->error = true; // TODO
@@ -2491,8 +2598,7 @@ static void cgen_error_unsigned_xxx(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both unsigned and %s specifier.\n",
+	cgen_error(cgen, &tok->tok, "Both unsigned and %s specifier.",
 	    tok->tok.text);
 
 	cgen->error = true; // TODO
@@ -2509,8 +2615,7 @@ static void cgen_error_multiple_signed(cgen_t *cgen, ast_tsbasic_t *tssigned)
 
 	tok = (comp_tok_t *) tssigned->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": More than one signed specifier.\n");
+	cgen_error(cgen, &tok->tok, "More than one signed specifier.");
 
 	cgen->error = true; // TODO
 }
@@ -2527,8 +2632,7 @@ static void cgen_error_multiple_unsigned(cgen_t *cgen,
 
 	tok = (comp_tok_t *) tsunsigned->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": More than one unsigned specifier.\n");
+	cgen_error(cgen, &tok->tok, "More than one unsigned specifier.");
 
 	cgen->error = true; // TODO
 }
@@ -2544,8 +2648,7 @@ static void cgen_error_signed_unsigned(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Both signed and unsigned specifier.\n");
+	cgen_error(cgen, &tok->tok, "Both signed and unsigned specifier.");
 
 	cgen->error = true; // TODO
 }
@@ -2557,8 +2660,7 @@ static void cgen_error_signed_unsigned(cgen_t *cgen, ast_tsbasic_t *tspec)
  */
 static void cgen_error_invalid_inline(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Invalid use of 'inline'.\n");
+	cgen_error(cgen, &tok->tok, "Invalid use of 'inline'.");
 
 	cgen->error = true; // TODO
 }
@@ -2574,8 +2676,7 @@ static void cgen_error_use_void_value(cgen_t *cgen, ast_tok_t *atok)
 
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Invalid use of void value.\n");
+	cgen_error(cgen, &tok->tok, "Invalid use of void value.");
 
 	cgen->error = true; // TODO
 }
@@ -2593,12 +2694,13 @@ static void cgen_error_cmp_invalid(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Comparison of invalid types ");
-	(void)cgtype_print(ltype, stderr);
-	(void)fprintf(stderr, " and ");
-	(void)cgtype_print(rtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_error);
+	(void)fprintf(cgen->msgf, "Comparison of invalid types ");
+	(void)cgtype_print(ltype, cgen->msgf);
+	(void)fprintf(cgen->msgf, " and ");
+	(void)cgtype_print(rtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 
 	cgen->error = true; // TODO
 }
@@ -2613,8 +2715,8 @@ static void cgen_error_cmp_ptr_nc(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Pointers being compared are not constant.\n");
+	cgen_error(cgen, &tok->tok, "Pointers being compared are not "
+	    "constant.");
 
 	cgen->error = true; // TODO
 }
@@ -2630,8 +2732,7 @@ static void cgen_error_need_scalar(cgen_t *cgen, ast_tok_t *atok)
 
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Need scalar type.\n");
+	cgen_error(cgen, &tok->tok, "Need scalar type.");
 
 	cgen->error = true; // TODO
 }
@@ -2647,8 +2748,7 @@ static void cgen_error_assign_array(cgen_t *cgen, ast_tok_t *atok)
 
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Assignment to an array.\n");
+	cgen_error(cgen, &tok->tok, "Assignment to an array.");
 
 	cgen->error = true; // TODO
 }
@@ -2660,8 +2760,7 @@ static void cgen_error_assign_array(cgen_t *cgen, ast_tok_t *atok)
  */
 static void cgen_error_cast_array(cgen_t *cgen, comp_tok_t *ctok)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Casting to an array type.\n");
+	cgen_error(cgen, &ctok->tok, "Casting to an array type.");
 
 	cgen->error = true; // TODO
 }
@@ -2677,8 +2776,7 @@ static void cgen_error_fun_ret_array(cgen_t *cgen, ast_tok_t *atok)
 
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Function returning an array.\n");
+	cgen_error(cgen, &tok->tok, "Function returning an array.");
 
 	cgen->error = true; // TODO
 }
@@ -2694,8 +2792,7 @@ static void cgen_error_expr_not_constant(cgen_t *cgen, ast_tok_t *atok)
 
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Expression is not constant.\n");
+	cgen_error(cgen, &tok->tok, "Expression is not constant.");
 
 	cgen->error = true; // TODO
 }
@@ -2707,8 +2804,7 @@ static void cgen_error_expr_not_constant(cgen_t *cgen, ast_tok_t *atok)
  */
 static void cgen_error_inv_restrict(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Invalid use of 'restrict'.\n");
+	cgen_error(cgen, &tok->tok, "Invalid use of 'restrict'.");
 
 	cgen->error = true; // TODO
 }
@@ -2720,8 +2816,7 @@ static void cgen_error_inv_restrict(cgen_t *cgen, comp_tok_t *tok)
  */
 static void cgen_error_lvalue_required(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr); // XXX Print range
-	(void)fprintf(stderr, ": Lvalue required.\n");
+	cgen_error(cgen, &tok->tok, "Lvalue required."); // XXX Print range
 	cgen->error = true;
 }
 
@@ -2737,8 +2832,7 @@ static void cgen_warn_tspec_not_impl(cgen_t *cgen, ast_node_t *tspec)
 
 	atok = ast_tree_first_tok(tspec);
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Unimplemented type specifier.\n");
+	cgen_warning(cgen, &tok->tok, "Unimplemented type specifier.");
 	++cgen->warnings;
 }
 
@@ -2751,9 +2845,8 @@ static void cgen_warn_tspec_not_impl(cgen_t *cgen, ast_node_t *tspec)
 static void cgen_warn_type_already_has_qual(cgen_t *cgen, const char *tqname,
     comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Type '%s' already has '%s' "
-	    "qualifier.\n", tok->tok.text, tqname);
+	cgen_warning(cgen, &tok->tok, "Type '%s' already has '%s' qualifier.",
+	    tok->tok.text, tqname);
 	++cgen->warnings;
 }
 
@@ -2767,8 +2860,7 @@ static void cgen_warn_dupl_type_qual(cgen_t *cgen, ast_tqual_t *tqual)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) tqual->tqual.data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Duplicate '%s' type qualifier.\n",
+	cgen_warning(cgen, &tok->tok, "Duplicate '%s' type qualifier.",
 	    tok->tok.text);
 	++cgen->warnings;
 }
@@ -2780,8 +2872,7 @@ static void cgen_warn_dupl_type_qual(cgen_t *cgen, ast_tqual_t *tqual)
  */
 static void cgen_warn_multiple_inline(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": multiple 'inline' specifiers.\n");
+	cgen_error(cgen, &tok->tok, "multiple 'inline' specifiers.");
 
 	++cgen->warnings;
 }
@@ -2797,9 +2888,7 @@ static void cgen_warn_unknown_attr(cgen_t *cgen, ast_aspec_attr_t *attr)
 
 	tok = (comp_tok_t *) attr->tname.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Unknown attribute '%s'.\n",
-	    tok->tok.text);
+	cgen_warning(cgen, &tok->tok, "Unknown attribute '%s'.", tok->tok.text);
 	++cgen->warnings;
 }
 
@@ -2814,8 +2903,7 @@ static void cgen_warn_duplicate_attr(cgen_t *cgen, ast_aspec_attr_t *attr)
 
 	tok = (comp_tok_t *) attr->tname.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Duplicate attribute '%s'.\n",
+	cgen_warning(cgen, &tok->tok, "Duplicate attribute '%s'.",
 	    tok->tok.text);
 	++cgen->warnings;
 }
@@ -2831,9 +2919,8 @@ static void cgen_warn_int_superfluous(cgen_t *cgen, ast_tsbasic_t *tspec)
 
 	tok = (comp_tok_t *) tspec->tbasic.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": superfluous 'int' used with "
-	    "short/long/signed/unsigned.\n");
+	cgen_error(cgen, &tok->tok, "superfluous 'int' used with "
+	    "short/long/signed/unsigned.");
 
 	++cgen->warnings;
 }
@@ -2851,8 +2938,7 @@ static void cgen_warn_int_signed_by_def(cgen_t *cgen, ast_node_t *ds)
 	atok = ast_tree_first_tok(ds);
 	tok = (comp_tok_t *)atok->data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": 'int' is signed by default.\n");
+	cgen_error(cgen, &tok->tok, "'int' is signed by default.");
 
 	++cgen->warnings;
 }
@@ -2867,9 +2953,7 @@ static void cgen_warn_useless_type(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Useless type in empty "
-	    "declaration.\n");
+	cgen_warning(cgen, &tok->tok, "Useless type in empty declaration.");
 	++cgen->warnings;
 }
 
@@ -2883,9 +2967,8 @@ static void cgen_warn_arith_enum(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Suspicious arithmetic operation "
-	    "involving enums.\n");
+	cgen_warning(cgen, &tok->tok, "Suspicious arithmetic operation "
+	    "involving enums.");
 	++cgen->warnings;
 }
 
@@ -2902,13 +2985,13 @@ static void cgen_warn_sub_enum_inc(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Subtracting incompatible "
-	    "enum types ");
-	(void)cgtype_print(lres->cgtype, stderr);
-	(void)fprintf(stderr, " and ");
-	(void)cgtype_print(rres->cgtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Subtracting incompatible enum types ");
+	(void)cgtype_print(lres->cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, " and ");
+	(void)cgtype_print(rres->cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -2924,11 +3007,12 @@ static void cgen_warn_init_enum_inc(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Initializing enum member from "
-	    "incompatible type ");
-	(void)cgtype_print(eres->cgtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Initializing enum member from incompatible "
+	    "type ");
+	(void)cgtype_print(eres->cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -2943,9 +3027,8 @@ static void cgen_warn_init_enum_range(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Enum initializer is out of range "
-	    "of int.\n");
+	cgen_warning(cgen, &tok->tok, "Enum initializer is out of range of "
+	    "int.");
 	++cgen->warnings;
 }
 
@@ -2959,9 +3042,8 @@ static void cgen_warn_logic_enum(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Suspicious logic operation "
-	    "involving enums.\n");
+	cgen_warning(cgen, &tok->tok, "Suspicious logic operation involving "
+	    "enums.");
 	++cgen->warnings;
 }
 
@@ -2975,9 +3057,7 @@ static void cgen_warn_cmp_enum_inc(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Comparison of different enum "
-	    "types.\n'");
+	cgen_warning(cgen, &tok->tok, "Comparison of different enum types.");
 	++cgen->warnings;
 }
 
@@ -2991,9 +3071,7 @@ static void cgen_warn_cmp_enum_mix(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Comparison of enum and non-enum "
-	    "type.\n'");
+	cgen_warning(cgen, &tok->tok, "Comparison of enum and non-enum type.");
 	++cgen->warnings;
 }
 
@@ -3007,9 +3085,8 @@ static void cgen_warn_bitop_enum_inc(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Bitwise operation on different "
-	    "enum types.\n'");
+	cgen_warning(cgen, &tok->tok, "Bitwise operation on different enum "
+	    "types.");
 	++cgen->warnings;
 }
 
@@ -3023,9 +3100,8 @@ static void cgen_warn_bitop_enum_mix(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Bitwise operation on enum and "
-	    "non-enum type.\n'");
+	cgen_warning(cgen, &tok->tok, "Bitwise operation on enum and non-enum "
+	    "type.");
 	++cgen->warnings;
 }
 
@@ -3039,8 +3115,7 @@ static void cgen_warn_bitfield_width_enum(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Bitfield width is an enum.\n'");
+	cgen_warning(cgen, &tok->tok, "Bitfield width is an enum.");
 	++cgen->warnings;
 }
 
@@ -3054,9 +3129,8 @@ static void cgen_warn_arith_truth(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Suspicious arithmetic operation "
-	    "involving truth values.\n");
+	cgen_warning(cgen, &tok->tok, "Suspicious arithmetic operation "
+	    "involving truth values.");
 	++cgen->warnings;
 }
 
@@ -3070,9 +3144,8 @@ static void cgen_warn_cmp_truth_mix(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Comparison of truth value and "
-	    "non-truth type.\n'");
+	cgen_warning(cgen, &tok->tok, "Comparison of truth value and non-truth "
+	    "type.");
 	++cgen->warnings;
 }
 
@@ -3086,9 +3159,8 @@ static void cgen_warn_bitop_signed(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Bitwise operation on "
-	    "signed integer(s).\n");
+	cgen_warning(cgen, &tok->tok, "Bitwise operation on signed "
+	    "integer(s).");
 	++cgen->warnings;
 }
 
@@ -3102,9 +3174,8 @@ static void cgen_warn_bitop_negative(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Bitwise operation on "
-	    "negative number(s).\n");
+	cgen_warning(cgen, &tok->tok, "Bitwise operation on negative "
+	    "number(s).");
 	++cgen->warnings;
 }
 
@@ -3118,9 +3189,8 @@ static void cgen_warn_cmp_sign_mix(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Unsigned comparison of mixed-sign "
-	    "integers.\n");
+	cgen_warning(cgen, &tok->tok, "Unsigned comparison of mixed-sign "
+	    "integers.");
 	++cgen->warnings;
 }
 
@@ -3134,9 +3204,8 @@ static void cgen_warn_div_sign_mix(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Unsigned division of mixed-sign "
-	    "integers.\n");
+	cgen_warning(cgen, &tok->tok, "Unsigned division of mixed-sign "
+	    "integers.");
 	++cgen->warnings;
 }
 
@@ -3150,9 +3219,8 @@ static void cgen_warn_cmp_neg_unsigned(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Negative number converted to "
-	    "unsigned before comparison.\n");
+	cgen_warning(cgen, &tok->tok, "Negative number converted to unsigned "
+	    "before comparison.");
 	++cgen->warnings;
 }
 
@@ -3166,8 +3234,7 @@ static void cgen_warn_integer_overflow(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Integer arithmetic overflow.\n");
+	cgen_warning(cgen, &tok->tok, "Integer arithmetic overflow.");
 	++cgen->warnings;
 }
 
@@ -3178,8 +3245,7 @@ static void cgen_warn_integer_overflow(cgen_t *cgen, ast_tok_t *atok)
  */
 static void cgen_warn_value_dnf_bitfield(cgen_t *cgen, comp_tok_t *ctok)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Value does not fit in bit field.\n");
+	cgen_warning(cgen, &ctok->tok, "Value does not fit in bit field.");
 	++cgen->warnings;
 }
 
@@ -3193,9 +3259,7 @@ static void cgen_warn_shift_exceed_bits(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Shift amount exceeds operand "
-	    "width.\n");
+	cgen_warning(cgen, &tok->tok, "Shift amount exceeds operand width.");
 	++cgen->warnings;
 }
 
@@ -3209,8 +3273,7 @@ static void cgen_warn_div_by_zero(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Division by zero.\n");
+	cgen_warning(cgen, &tok->tok, "Division by zero.");
 	++cgen->warnings;
 }
 
@@ -3224,8 +3287,7 @@ static void cgen_warn_shift_negative(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Shift is negative.\n");
+	cgen_warning(cgen, &tok->tok, "Shift is negative.");
 	++cgen->warnings;
 }
 
@@ -3236,9 +3298,7 @@ static void cgen_warn_shift_negative(cgen_t *cgen, ast_tok_t *atok)
  */
 static void cgen_warn_sign_changed(cgen_t *cgen, comp_tok_t *ctok)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Number sign changed in "
-	    "conversion.\n");
+	cgen_warning(cgen, &ctok->tok, "Number sign changed in conversion.");
 	++cgen->warnings;
 }
 
@@ -3252,12 +3312,13 @@ static void cgen_warn_sign_changed(cgen_t *cgen, comp_tok_t *ctok)
 static void cgen_warn_sign_convert(cgen_t *cgen, comp_tok_t *ctok,
     cgen_eres_t *lres, cgen_eres_t *rres)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Conversion from ");
-	(void)cgtype_print(lres->cgtype, stderr);
-	(void)fprintf(stderr, " to ");
-	(void)cgtype_print(rres->cgtype, stderr);
-	(void)fprintf(stderr, " changes signedness.\n");
+	cgen_msg_begin(cgen, &ctok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Conversion from ");
+	(void)cgtype_print(lres->cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, " to ");
+	(void)cgtype_print(rres->cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, " changes signedness.");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -3268,8 +3329,7 @@ static void cgen_warn_sign_convert(cgen_t *cgen, comp_tok_t *ctok,
  */
 static void cgen_warn_number_changed(cgen_t *cgen, comp_tok_t *ctok)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Number changed in conversion.\n");
+	cgen_warning(cgen, &ctok->tok, "Number changed in conversion.");
 	++cgen->warnings;
 }
 
@@ -3285,10 +3345,11 @@ static void cgen_warn_case_value_range(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Case value is out of range of ");
-	(void)cgtype_print(cgtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Case value is out of range of ");
+	(void)cgtype_print(cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -3302,8 +3363,7 @@ static void cgen_warn_case_value_not_bool(cgen_t *cgen, ast_tok_t *atok)
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Case value is not boolean.\n");
+	cgen_warning(cgen, &tok->tok, "Case value is not boolean.");
 	++cgen->warnings;
 }
 
@@ -3319,10 +3379,11 @@ static void cgen_warn_case_value_not_in_enum(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Case value is not in ");
-	(void)cgtype_print(cgtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Case value is not in ");
+	(void)cgtype_print(cgtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -3339,13 +3400,13 @@ static void cgen_warn_cmp_incom_ptr(cgen_t *cgen, ast_tok_t *atok,
 	comp_tok_t *tok;
 
 	tok = (comp_tok_t *) atok->data;
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Comparison of incompatible "
-	    "pointer types ");
-	(void)cgtype_print(ltype, stderr);
-	(void)fprintf(stderr, " and ");
-	(void)cgtype_print(rtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+	(void)fprintf(cgen->msgf, "Comparison of incompatible pointer types ");
+	(void)cgtype_print(ltype, cgen->msgf);
+	(void)fprintf(cgen->msgf, " and ");
+	(void)cgtype_print(rtype, cgen->msgf);
+	(void)fprintf(cgen->msgf, ".");
+	cgen_msg_end(cgen);
 	++cgen->warnings;
 }
 
@@ -3356,8 +3417,7 @@ static void cgen_warn_cmp_incom_ptr(cgen_t *cgen, ast_tok_t *atok,
  */
 static void cgen_warn_truth_as_int(cgen_t *cgen, comp_tok_t *ctok)
 {
-	(void)lexer_dprint_tok(&ctok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Truth value used as an integer.\n");
+	cgen_warning(cgen, &ctok->tok, "Truth value used as an integer.");
 	++cgen->warnings;
 }
 
@@ -3368,8 +3428,7 @@ static void cgen_warn_truth_as_int(cgen_t *cgen, comp_tok_t *ctok)
  */
 static void cgen_warn_array_index_negative(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Array index is negative.\n");
+	cgen_warning(cgen, &tok->tok, "Array index is negative.");
 	++cgen->warnings;
 }
 
@@ -3380,8 +3439,7 @@ static void cgen_warn_array_index_negative(cgen_t *cgen, comp_tok_t *tok)
  */
 static void cgen_warn_array_index_oob(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Array index is out of bounds.\n");
+	cgen_warning(cgen, &tok->tok, "Array index is out of bounds.");
 	++cgen->warnings;
 }
 
@@ -3392,8 +3450,7 @@ static void cgen_warn_array_index_oob(cgen_t *cgen, comp_tok_t *tok)
  */
 static void cgen_warn_init_field_overwritten(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Initializer field overwritten.\n");
+	cgen_warning(cgen, &tok->tok, "Initializer field overwritten.");
 	++cgen->warnings;
 }
 
@@ -3404,8 +3461,7 @@ static void cgen_warn_init_field_overwritten(cgen_t *cgen, comp_tok_t *tok)
  */
 static void cgen_warn_pass_su_by_value(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Pasing struct/union by value.\n");
+	cgen_warning(cgen, &tok->tok, "Pasing struct/union by value.");
 	++cgen->warnings;
 }
 
@@ -3416,8 +3472,7 @@ static void cgen_warn_pass_su_by_value(cgen_t *cgen, comp_tok_t *tok)
  */
 static void cgen_warn_return_su_by_value(cgen_t *cgen, comp_tok_t *tok)
 {
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Returning struct/union by value.\n");
+	cgen_warning(cgen, &tok->tok, "Returning struct/union by value.");
 	++cgen->warnings;
 }
 
@@ -3477,8 +3532,7 @@ static int cgen_tident(cgen_t *cgen, ast_tok_t *itok, cgtype_qual_t qual,
 	/* Check if the type is defined */
 	member = scope_lookup(cgen->cur_scope, ident->tok.text);
 	if (member == NULL) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Undefined type name '%s'.\n",
+		cgen_error(cgen, &ident->tok, "Undefined type name '%s'.",
 		    ident->tok.text);
 		cgen->error = true; // TODO
 		return EINVAL;
@@ -3486,8 +3540,7 @@ static int cgen_tident(cgen_t *cgen, ast_tok_t *itok, cgtype_qual_t qual,
 
 	/* Is it actually a type definition? */
 	if (member->mtype != sm_tdef) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Identifer '%s' is not a type.\n",
+		cgen_error(cgen, &ident->tok, "Identifer '%s' is not a type.",
 		    ident->tok.text);
 		cgen->error = true; // TODO
 		return EINVAL;
@@ -3580,8 +3633,8 @@ static int cgen_tsrecord_update_su_type(cgen_rec_t *cgrec, cgtype_t *cgtype,
 	cgtype_int_rank_t new_rank;
 
 	if (!cgen_type_is_integral(cgrec->cgen, cgtype)) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Bitfield has incorrect type.\n");
+		cgen_error(cgrec->cgen, &ident->tok, "Bitfield has incorrect "
+		    "type.");
 		cgrec->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -3700,9 +3753,8 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 			}
 
 			if (bwres.cvint < 0) {
-				(void)lexer_dprint_tok(&ident->tok, stderr);
-				(void)fprintf(stderr, ": Bitfield '%s' width "
-				    "is negative.\n", ident->tok.text);
+				cgen_error(cgen, &ident->tok, "Bitfield '%s' "
+				    "width is negative.", ident->tok.text);
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -3728,9 +3780,8 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 		if (bitwidth > 0) {
 			su_bits = 8 * cgen_type_sizeof(cgen, cgrec->su_cgtype);
 			if (bitwidth > su_bits) {
-				(void)lexer_dprint_tok(&ident->tok, stderr);
-				(void)fprintf(stderr, ": Bitfield '%s' is "
-				    "wider than its type.\n", ident->tok.text);
+				cgen_error(cgen, &ident->tok, "Bitfield '%s' "
+				    "is wider than its type.", ident->tok.text);
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -3739,10 +3790,9 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 				cgenum = (cgtype_enum_t *)dtype->ext;
 				enum_max = cgen_enum_max_val(cgenum->cgenum);
 				if (1 << (uint8_t)bitwidth <= enum_max) {
-					(void)lexer_dprint_tok(&ident->tok, stderr);
-					(void)fprintf(stderr, ": Warning: "
+					cgen_warning(cgen, &ident->tok,
 					    "Bitfield '%s' is narrower than "
-					    "the values of its type.\n",
+					    "the values of its type.",
 					    ident->tok.text);
 					++cgen->warnings;
 				}
@@ -3767,9 +3817,8 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 		rc = cgen_record_append(record, ident->tok.text,
 		    (uint8_t)bitwidth, cgrec->bf_pos, dtype, irident);
 		if (rc == EEXIST) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Duplicate record member "
-			    "'%s'.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Duplicate record member "
+			    "'%s'.", ident->tok.text);
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -3787,9 +3836,8 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 
 		/* Check for function type */
 		if (dtype->ntype == cgn_func) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Record member is a "
-			    "function.\n");
+			cgen_error(cgen, &ident->tok, "Record member is a "
+			    "function.");
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -3797,9 +3845,8 @@ static int cgen_tsrecord_elem(cgen_rec_t *cgrec, ast_tsrecord_elem_t *elem,
 
 		/* Check type for completeness */
 		if (cgen_type_is_incomplete(cgen, dtype)) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Record member has incomplete "
-			    "type.\n");
+			cgen_error(cgen, &ident->tok, "Record member has "
+			    "incomplete type.");
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -3848,9 +3895,8 @@ static int cgen_tsrecord_attr_packed(cgen_t *cgen, ast_aspec_attr_t *attr)
 	if (attr->have_params) {
 		tok = (comp_tok_t *) attr->tlparen.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Attribute 'packed' should not have "
-		    "any arguments.\n");
+		cgen_error(cgen, &tok->tok, "Attribute 'packed' should not "
+		    "have any arguments.");
 		cgen->error = true; // XXX
 		return EINVAL;
 	}
@@ -3956,9 +4002,8 @@ static int cgen_tsrecord(cgen_t *cgen, ast_tsrecord_t *tsrecord,
 	if (tsrecord->aslist1 != NULL) {
 		tok = ast_tree_first_tok(&tsrecord->aslist1->node);
 		ctok = (comp_tok_t *)tok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented attribute specifier "
-		    "in this context.[1]\n");
+		cgen_error(cgen, &ctok->tok, "Unimplemented attribute "
+		    "specifier in this context.[1]");
 		cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -3974,34 +4019,30 @@ static int cgen_tsrecord(cgen_t *cgen, ast_tsrecord_t *tsrecord,
 	}
 
 	if (tsrecord->have_def && cgen->cur_scope->parent != NULL) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of '%s %s' in a "
-		    "non-global scope.\n", rtype, ident);
+		cgen_warning(cgen, &ident_tok->tok, "Definition of '%s %s' in "
+		    "a non-global scope.", rtype, ident);
 		++cgen->warnings;
 
 		member = scope_lookup_tag(cgen->cur_scope->parent,
 		    ident);
 		if (member != NULL) {
-			(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Definition of "
-			    "'%s %s' shadows a wider-scope struct, union "
-			    "or enum definition.\n", rtype, ident);
+			cgen_warning(cgen, &ident_tok->tok, "Definition of '%s "
+			    "%s' shadows a wider-scope struct, union or enum "
+			    "definition.", rtype, ident);
 			++cgen->warnings;
 		}
 	}
 
 	if (tsrecord->have_def && tsrecord->have_ident && cgen->tsrec_cnt > 0) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of '%s %s' inside "
-		    "another struct/union definition.\n", rtype, ident);
+		cgen_warning(cgen, &ident_tok->tok, "Definition of '%s %s' "
+		    "inside another struct/union definition.", rtype, ident);
 		++cgen->warnings;
 	}
 
 	if (tsrecord->have_def && cgen->arglist_cnt > 0) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of '%s %s' inside "
-		    "parameter list will not be visible outside of function "
-		    "declaration/definition.\n", rtype, ident);
+		cgen_warning(cgen, &ident_tok->tok, "Definition of '%s %s' "
+		    "inside parameter list will not be visible outside of "
+		    "function declaration/definition.", rtype, ident);
 		++cgen->warnings;
 	}
 
@@ -4011,9 +4052,8 @@ static int cgen_tsrecord(cgen_t *cgen, ast_tsrecord_t *tsrecord,
 	/* If already exists, but as a different kind of tag */
 	if (member != NULL && (member->mtype != sm_record ||
 	    member->m.record.srtype != srtype)) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Redefinition of '%s' as a different "
-		    "kind of tag.\n", member->tident->text);
+		cgen_error(cgen, &ident_tok->tok, "Redefinition of '%s' as a "
+		    "different kind of tag.", member->tident->text);
 		cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -4031,9 +4071,8 @@ static int cgen_tsrecord(cgen_t *cgen, ast_tsrecord_t *tsrecord,
 		flags |= cgrd_prevdef;
 
 		if (tsrecord->have_def) {
-			(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-			(void)fprintf(stderr, ": Redefinition of '%s'.\n",
-			    member->tident->text);
+			cgen_error(cgen, &ident_tok->tok, "Redefinition of "
+			    "'%s'.", member->tident->text);
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -4133,9 +4172,8 @@ static int cgen_tsrecord(cgen_t *cgen, ast_tsrecord_t *tsrecord,
 	/* Catch nested redefinitions */
 	if (tsrecord->have_def) {
 		if (tsrecord->have_def && record->defining) {
-			(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-			(void)fprintf(stderr, ": Nested redefinition of "
-			    "'%s'.\n", record->cident);
+			cgen_error(cgen, &ident_tok->tok, "Nested redefinition "
+			    "of '%s'.", record->cident);
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -4272,8 +4310,7 @@ static int cgen_tsenum_elem(cgen_dspec_t *cgds, ast_tsenum_elem_t *elem,
 
 	rc = cgen_enum_append(cgenum, ident->tok.text, value, &eelem);
 	if (rc == EEXIST) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Duplicate enum member '%s'.\n",
+		cgen_error(cgen, &ident->tok, "Duplicate enum member '%s'.",
 		    ident->tok.text);
 		cgen->error = true; // TODO
 		rc = EINVAL;
@@ -4287,9 +4324,8 @@ static int cgen_tsenum_elem(cgen_dspec_t *cgds, ast_tsenum_elem_t *elem,
 		member = scope_lookup(cgen->cur_scope->parent,
 		    ident->tok.text);
 		if (member != NULL) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Declaration of '%s' "
-			    "shadows a wider-scope declaration.\n",
+			cgen_warning(cgen, &ident->tok, "Declaration of '%s' "
+			    "shadows a wider-scope declaration.",
 			    ident->tok.text);
 			++cgen->warnings;
 		}
@@ -4314,9 +4350,8 @@ static int cgen_tsenum_elem(cgen_dspec_t *cgds, ast_tsenum_elem_t *elem,
 	    etype, &member);
 	if (rc != EOK) {
 		if (rc == EEXIST) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Duplicate identifier '%s'.\n",
-			    ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Duplicate identifier "
+			    "'%s'.", ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -4372,34 +4407,30 @@ static int cgen_tsenum(cgen_dspec_t *cgds, ast_tsenum_t *tsenum,
 	}
 
 	if (tsenum->have_def && cgen->cur_scope->parent != NULL) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of 'enum %s' in a "
-		    "non-global scope.\n", ident);
+		cgen_warning(cgen, &ident_tok->tok, "Definition of 'enum %s' "
+		    "in a non-global scope.", ident);
 		++cgen->warnings;
 
 		member = scope_lookup_tag(cgen->cur_scope->parent,
 		    ident);
 		if (member != NULL) {
-			(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Definition of "
-			    "'enum %s' shadows a wider-scope struct, union "
-			    "or enum definition.\n", ident);
+			cgen_warning(cgen, &ident_tok->tok, "Definition of "
+			    "'enum %s' shadows a wider-scope struct, union or "
+			    "enum definition.", ident);
 			++cgen->warnings;
 		}
 	}
 
 	if (tsenum->have_def && cgen->tsrec_cnt > 0) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of 'enum %s' "
-		    "inside struct or union definition.\n", ident);
+		cgen_warning(cgen, &ident_tok->tok, "Definition of 'enum %s' "
+		    "inside struct or union definition.", ident);
 		++cgen->warnings;
 	}
 
 	if (tsenum->have_def && cgen->arglist_cnt > 0) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Definition of 'enum %s' "
+		cgen_warning(cgen, &ident_tok->tok, "Definition of 'enum %s' "
 		    "inside parameter list will not be visible outside of "
-		    "function declaration/definition.\n", ident);
+		    "function declaration/definition.", ident);
 		++cgen->warnings;
 	}
 
@@ -4408,9 +4439,8 @@ static int cgen_tsenum(cgen_dspec_t *cgds, ast_tsenum_t *tsenum,
 
 	/* If already exists, but as a different kind of tag */
 	if (member != NULL && member->mtype != sm_enum) {
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Redefinition of '%s' as a different "
-		    "kind of tag.\n", member->tident->text);
+		cgen_error(cgen, &ident_tok->tok, "Redefinition of '%s' as a "
+		    "different kind of tag.", member->tident->text);
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -4426,9 +4456,8 @@ static int cgen_tsenum(cgen_dspec_t *cgds, ast_tsenum_t *tsenum,
 		flags |= cgrd_prevdef;
 
 		if (tsenum->have_def) {
-			(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-			(void)fprintf(stderr, ": Redefinition of '%s'.\n",
-			    member->tident->text);
+			cgen_error(cgen, &ident_tok->tok, "Redefinition of "
+			    "'%s'.", member->tident->text);
 			cgen->error = true; // TODO
 			return EINVAL;
 		}
@@ -4470,8 +4499,7 @@ static int cgen_tsenum(cgen_dspec_t *cgds, ast_tsenum_t *tsenum,
 	elem = ast_tsenum_first(tsenum);
 	if (tsenum->have_def && elem == NULL) {
 		/* No elements */
-		(void)lexer_dprint_tok(&ident_tok->tok, stderr);
-		(void)fprintf(stderr, ": Enum '%s' is empty.\n", ident);
+		cgen_error(cgen, &ident_tok->tok, "Enum '%s' is empty.", ident);
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -4685,9 +4713,8 @@ static int cgen_dspec(cgen_dspec_t *cgds, ast_node_t *dspec)
 	default:
 		atok = ast_tree_first_tok(dspec);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unimplemented declaration "
-		    "specifier.\n");
+		cgen_warning(cgds->cgen, &tok->tok, "Unimplemented declaration "
+		    "specifier.");
 		++cgds->cgen->warnings;
 		break;
 	}
@@ -4852,9 +4879,8 @@ static int cgen_dspec_finish(cgen_dspec_t *cgds, cgen_dspec_res_t *dsres)
 			stype = NULL;
 			atok = ast_tree_first_tok(cgds->tspec);
 			tok = (comp_tok_t *) atok->data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Unimplemented type "
-			    "specifier.\n");
+			cgen_error(cgen, &tok->tok, "Unimplemented type "
+			    "specifier.");
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -5044,9 +5070,8 @@ static int cgen_decl_ident(cgen_t *cgen, cgtype_t *stype, ast_dident_t *dident,
 	if (aslist != NULL) {
 		tok = ast_tree_first_tok(&aslist->node);
 		ctok = (comp_tok_t *)tok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented attribute specifier "
-		    "in this context.[3]\n");
+		cgen_error(cgen, &ctok->tok, "Unimplemented attribute "
+		    "specifier in this context.[3]");
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -5075,9 +5100,8 @@ static int cgen_decl_fun_attr_usr(cgen_t *cgen, ast_aspec_attr_t *attr,
 	if (attr->have_params) {
 		tok = (comp_tok_t *) attr->tlparen.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Attribute 'usr' should not have any "
-		    "arguments.\n");
+		cgen_error(cgen, &tok->tok, "Attribute 'usr' should not have "
+		    "any arguments.");
 		cgen->error = true; // XXX
 		return EINVAL;
 	}
@@ -5085,9 +5109,8 @@ static int cgen_decl_fun_attr_usr(cgen_t *cgen, ast_aspec_attr_t *attr,
 	if (have_args) {
 		tok = (comp_tok_t *) attr->tname.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": User service routine cannot "
-		    "have any arguments.\n");
+		cgen_error(cgen, &tok->tok, "User service routine cannot have "
+		    "any arguments.");
 		cgen->error = true; // XXX
 		return EINVAL;
 	}
@@ -5110,9 +5133,8 @@ static int cgen_decl_fun_attr_may_ign_return(cgen_t *cgen,
 	if (attr->have_params) {
 		tok = (comp_tok_t *) attr->tlparen.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Attribute 'may_ignore_return' "
-		    "should not have any arguments.\n");
+		cgen_error(cgen, &tok->tok, "Attribute 'may_ignore_return' "
+		    "should not have any arguments.");
 		cgen->error = true; // XXX
 		return EINVAL;
 	}
@@ -5255,9 +5277,8 @@ static int cgen_decl_fun(cgen_t *cgen, cgtype_t *btype, ast_dfun_t *dfun,
 		if (dsres.sctype != asc_none) {
 			atok = ast_tree_first_tok(&arg->dspecs->node);
 			tok = (comp_tok_t *) atok->data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Unimplemented storage class "
-			    "specifier.\n");
+			cgen_error(cgen, &tok->tok, "Unimplemented storage "
+			    "class specifier.");
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			--cgen->arglist_cnt;
@@ -5288,10 +5309,9 @@ static int cgen_decl_fun(cgen_t *cgen, cgtype_t *btype, ast_dfun_t *dfun,
 			    dsres.stype, "dummy");
 			if (rc != EOK) {
 				if (rc == EEXIST) {
-					(void)lexer_dprint_tok(&ident->tok, stderr);
-					(void)fprintf(stderr, ": Duplicate "
-					    "argument identifier '%s'.\n",
-					    ident->tok.text);
+					cgen_error(cgen, &ident->tok,
+					    "Duplicate argument identifier "
+					    "'%s'.", ident->tok.text);
 					cgen->error = true; // XXX
 					rc = EINVAL;
 					goto error;
@@ -5310,9 +5330,8 @@ static int cgen_decl_fun(cgen_t *cgen, cgtype_t *btype, ast_dfun_t *dfun,
 				if ((ast_dfun_next(arg) != NULL || arg != ast_dfun_first(dfun))) {
 					atok = ast_tree_first_tok(&arg->dspecs->node);
 					tok = (comp_tok_t *) atok->data;
-					(void)lexer_dprint_tok(&tok->tok, stderr);
-					(void)fprintf(stderr, ": 'void' must "
-					    "be the only parameter.\n");
+					cgen_error(cgen, &tok->tok, "'void' "
+					    "must be the only parameter.");
 					cgen->error = true; // XXX
 					rc = EINVAL;
 					--cgen->arglist_cnt;
@@ -5328,9 +5347,8 @@ static int cgen_decl_fun(cgen_t *cgen, cgtype_t *btype, ast_dfun_t *dfun,
 		if (arg->aslist != NULL) {
 			atok = ast_tree_first_tok(&arg->aslist->node);
 			tok = (comp_tok_t *) atok->data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Attribute specifier "
-			    "(unimplemented).\n");
+			cgen_error(cgen, &tok->tok, "Attribute specifier "
+			    "(unimplemented).");
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			--cgen->arglist_cnt;
@@ -5359,9 +5377,8 @@ static int cgen_decl_fun(cgen_t *cgen, cgtype_t *btype, ast_dfun_t *dfun,
 	if (arg_with_ident && arg_without_ident) {
 		atok = ast_decl_get_ident(dfun->bdecl);
 		tok = (comp_tok_t *)atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Mixing arguments with and without an "
-		    "identifier.\n");
+		cgen_error(cgen, &tok->tok, "Mixing arguments with and without "
+		    "an identifier.");
 		++cgen->warnings;
 	}
 
@@ -5521,8 +5538,8 @@ static int cgen_decl_array(cgen_t *cgen, cgtype_t *btype, ast_darray_t *darray,
 
 	if (cgen_type_is_incomplete(cgen, btype)) {
 		ctok = (comp_tok_t *)darray->tlbracket.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Array element has incomplete type.\n");
+		cgen_error(cgen, &ctok->tok, "Array element has incomplete "
+		    "type.");
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -6058,8 +6075,7 @@ static int cgen_eint(cgen_expr_t *cgexpr, ast_eint_t *eint,
 	lit = (comp_tok_t *) eint->tlit.data;
 	rc = cgen_intlit_val(cgexpr->cgen, lit, &val, &elmtype);
 	if (rc != EOK) {
-		(void)lexer_dprint_tok(&lit->tok, stderr);
-		(void)fprintf(stderr, ": Invalid integer literal.\n");
+		cgen_error(cgexpr->cgen, &lit->tok, "Invalid integer literal.");
 		cgexpr->cgen->error = true; // TODO
 		return rc;
 	}
@@ -6262,10 +6278,9 @@ static int cgen_eident_gsym(cgen_expr_t *cgexpr, ast_eident_t *eident,
 		/* Symbol with static storage duration? */
 		if ((symbol->flags & sf_static) != sf_none) {
 			tok = (comp_tok_t *)eident->tident.data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Containing Inline function "
-			    "'%s' has external inkage, '%s' is static.\n",
-			    fsymbol->ident->tok.text,
+			cgen_error(cgexpr->cgen, &tok->tok, "Containing Inline "
+			    "function '%s' has external inkage, '%s' is "
+			    "static.", fsymbol->ident->tok.text,
 			    symbol->ident->tok.text);
 			cgexpr->cgen->error = true; // TODO
 			return EINVAL;
@@ -6314,7 +6329,7 @@ static int cgen_eident_arg(cgen_expr_t *cgexpr, ast_eident_t *eident,
 	}
 
 	cgen_eres_init(&tres);
-	tres.varname = vident;
+	cgen_vref_from_ident(vident, &tres.vref);
 	tres.valtype = cgen_rvalue;
 	tres.cgtype = cgtype;
 	tres.sigbits = cgen_type_sigbits(cgexpr->cgen, cgtype);
@@ -6439,7 +6454,7 @@ static int cgen_eident_eelem(cgen_expr_t *cgexpr, ast_eident_t *eident,
 	ir_instr_t *instr = NULL;
 	ir_oper_var_t *dest = NULL;
 	ir_oper_imm_t *imm = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	uint8_t bits;
 	int rc;
 
@@ -6465,7 +6480,7 @@ static int cgen_eident_eelem(cgen_expr_t *cgexpr, ast_eident_t *eident,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -6473,7 +6488,7 @@ static int cgen_eident_eelem(cgen_expr_t *cgexpr, ast_eident_t *eident,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->cvknown = true;
@@ -6513,9 +6528,8 @@ static int cgen_eident(cgen_expr_t *cgexpr, ast_eident_t *eident,
 	/* Check if the identifier is declared */
 	member = scope_lookup(cgexpr->cgen->cur_scope, ident->tok.text);
 	if (member == NULL) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Undeclared identifier '%s'.\n",
-		    ident->tok.text);
+		cgen_error(cgexpr->cgen, &ident->tok, "Undeclared identifier "
+		    "'%s'.", ident->tok.text);
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -6551,9 +6565,8 @@ static int cgen_eident(cgen_expr_t *cgexpr, ast_eident_t *eident,
 		    cgtype, lblock, eres);
 		break;
 	case sm_tdef:
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Expected variable name. '%s' "
-		    "is a type.\n", ident->tok.text);
+		cgen_error(cgexpr->cgen, &ident->tok, "Expected variable name. "
+		    "'%s' is a type.", ident->tok.text);
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -6618,7 +6631,7 @@ static int cgen_const_int(cgen_proc_t *cgproc, cgtype_elmtype_t elmtype,
 	ir_oper_var_t *dest = NULL;
 	ir_oper_imm_t *imm = NULL;
 	cgtype_basic_t *btype = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	rc = ir_instr_create(&instr);
@@ -6643,7 +6656,7 @@ static int cgen_const_int(cgen_proc_t *cgproc, cgtype_elmtype_t elmtype,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -6651,7 +6664,7 @@ static int cgen_const_int(cgen_proc_t *cgproc, cgtype_elmtype_t elmtype,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 	eres->cvknown = true;
@@ -6687,7 +6700,7 @@ static int cgen_const_bool(cgen_proc_t *cgproc, bool bval, ir_lblock_t *lblock,
 	ir_oper_var_t *dest = NULL;
 	ir_oper_imm_t *imm = NULL;
 	cgtype_basic_t *btype = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	rc = ir_instr_create(&instr);
@@ -6712,7 +6725,7 @@ static int cgen_const_bool(cgen_proc_t *cgproc, bool bval, ir_lblock_t *lblock,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -6720,7 +6733,7 @@ static int cgen_const_bool(cgen_proc_t *cgproc, bool bval, ir_lblock_t *lblock,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 	eres->cvknown = true;
@@ -6772,7 +6785,7 @@ static int cgen_gsym_ptr(cgen_proc_t *cgproc, symbol_t *symbol,
 	ir_instr_t *instr = NULL;
 	ir_oper_var_t *dest = NULL;
 	ir_oper_var_t *var = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	rc = ir_instr_create(&instr);
@@ -6793,7 +6806,7 @@ static int cgen_gsym_ptr(cgen_proc_t *cgproc, symbol_t *symbol,
 	instr->op1 = &var->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	var = NULL;
 
@@ -6801,7 +6814,7 @@ static int cgen_gsym_ptr(cgen_proc_t *cgproc, symbol_t *symbol,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_lvalue;
 	eres->cgtype = NULL;
 	eres->cvknown = true;
@@ -6847,7 +6860,7 @@ static int cgen_add_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	bool is_signed;
 	unsigned bits;
 	bool overflow;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&res1);
@@ -6896,11 +6909,11 @@ static int cgen_add_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res1.varname, &larg);
+	rc = cgen_vref_oper(&res1.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res2.varname, &rarg);
+	rc = cgen_vref_oper(&res2.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -6910,7 +6923,7 @@ static int cgen_add_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -6919,7 +6932,7 @@ static int cgen_add_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->sigbits = cgen_bits_max(res1.sigbits, res2.sigbits);
@@ -7014,7 +7027,7 @@ static int cgen_add_ptra_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	cgtype_t *etype;
 	bool idx_signed;
 	bool int_idx_type;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lval);
@@ -7050,9 +7063,8 @@ static int cgen_add_ptra_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 
 		/* Check type for completeness */
 		if (cgen_type_is_incomplete(cgexpr->cgen, ptrt->tgtype)) {
-			(void)lexer_dprint_tok(&optok->tok, stderr);
-			(void)fprintf(stderr, ": Indexing pointer to "
-			    "incomplete type.\n");
+			cgen_error(cgexpr->cgen, &optok->tok, "Indexing "
+			    "pointer to incomplete type.");
 			cgexpr->cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -7150,11 +7162,11 @@ static int cgen_add_ptra_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lval.varname, &larg);
+	rc = cgen_vref_oper(&lval.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(cres.varname, &rarg);
+	rc = cgen_vref_oper(&cres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -7165,7 +7177,7 @@ static int cgen_add_ptra_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	instr->op2 = &rarg->oper;
 	instr->opt = elemte;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -7175,7 +7187,7 @@ static int cgen_add_ptra_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -7254,12 +7266,13 @@ static int cgen_add(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 
 	/* Pointer/array + pointer/array */
 	if (l_ptra && r_ptra) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Cannot add ");
-		(void)cgtype_print(lres->cgtype, stderr);
-		(void)fprintf(stderr, " and ");
-		(void)cgtype_print(rres->cgtype, stderr);
-		(void)fprintf(stderr, ".\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Cannot add ");
+		(void)cgtype_print(lres->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " and ");
+		(void)cgtype_print(rres->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, ".");
+		cgen_msg_end(cgexpr->cgen);
 
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
@@ -7272,9 +7285,8 @@ static int cgen_add(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	/* Integer/enum + pointer/array */
 	if ((l_int || l_enum) && r_ptra) {
 		/* Produce a style warning and switch the operands */
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Pointer should be the left "
-		    "operand while indexing.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Pointer should be the "
+		    "left operand while indexing.");
 		++cgexpr->cgen->warnings;
 		return cgen_add_ptra_int(cgexpr, ctok, rres, lres, lblock, eres);
 	}
@@ -7283,9 +7295,8 @@ static int cgen_add(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (l_int && r_enum) {
 		/* Produce a style warning if enum is strict */
 		if (cgtype_is_strict_enum(rres->cgtype)) {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Enum should be "
-			    "the left operand while adjusting.\n");
+			cgen_warning(cgexpr->cgen, &ctok->tok, "Enum should be "
+			    "the left operand while adjusting.");
 			++cgexpr->cgen->warnings;
 		}
 		/* Switch the operands */
@@ -7305,9 +7316,8 @@ static int cgen_add(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	/* Integer + pointer/array */
 	if (l_int && r_ptra) {
 		/* Produce a style warning and switch the operands */
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Pointer should be the left "
-		    "operand while indexing.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Pointer should be the "
+		    "left operand while indexing.");
 		++cgexpr->cgen->warnings;
 		return cgen_add_ptra_int(cgexpr, ctok, rres, lres, lblock, eres);
 	}
@@ -7347,7 +7357,7 @@ static int cgen_sub_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	bool is_signed;
 	unsigned bits;
 	bool overflow;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&res1);
@@ -7396,11 +7406,11 @@ static int cgen_sub_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res1.varname, &larg);
+	rc = cgen_vref_oper(&res1.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res2.varname, &rarg);
+	rc = cgen_vref_oper(&res2.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -7410,7 +7420,7 @@ static int cgen_sub_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -7419,7 +7429,7 @@ static int cgen_sub_int(cgen_expr_t *cgexpr, ast_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -7549,14 +7559,14 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	ir_oper_var_t *carg = NULL;
 	ir_oper_var_t *larg = NULL;
 	ir_oper_var_t *rarg = NULL;
-	char *tmpname;
+	cgen_vref_t tmpvr;
 	cgen_eres_t lval;
 	cgen_eres_t cres;
 	cgtype_t *idxtype = NULL;
 	cgtype_t *cgtype = NULL;
 	ir_texpr_t *elemte = NULL;
 	cgtype_pointer_t *ptrt;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lval);
@@ -7590,9 +7600,8 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 
 	/* Check type for completeness */
 	if (cgen_type_is_incomplete(cgexpr->cgen, ptrt->tgtype)) {
-		(void)lexer_dprint_tok(&optok->tok, stderr);
-		(void)fprintf(stderr, ": Indexing pointer "
-		    "to incomplete type.\n");
+		cgen_error(cgexpr->cgen, &optok->tok, "Indexing pointer to "
+		    "incomplete type.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -7613,9 +7622,9 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	tmpname = tmp->varname;
+	cgen_vref_from_oper(tmp, &tmpvr);
 
-	rc = ir_oper_var_create(cres.varname, &carg);
+	rc = cgen_vref_oper(&cres.vref, &carg);
 	if (rc != EOK)
 		goto error;
 
@@ -7644,11 +7653,11 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lval.varname, &larg);
+	rc = cgen_vref_oper(&lval.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(tmpname, &rarg);
+	rc = cgen_vref_oper(&tmpvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -7659,7 +7668,7 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	instr->op2 = &rarg->oper;
 	instr->opt = elemte;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -7669,7 +7678,7 @@ static int cgen_sub_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -7771,7 +7780,7 @@ static int cgen_eres_rvptr(cgen_expr_t *cgexpr, cgen_eres_t *bres,
 		elemte = NULL;
 	}
 
-	eres->varname = bval.varname;
+	eres->vref = bval.vref;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->cvknown = bres->cvknown;
@@ -7813,7 +7822,7 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	cgtype_pointer_t *tptr2;
 	cgtype_t *ptdtype = NULL;
 	ir_texpr_t *elemte = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lval);
@@ -7838,13 +7847,14 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	tptr2 = (cgtype_pointer_t *)rval.cgtype->ext;
 
 	if (!cgtype_ptr_compatible(tptr1, tptr2)) {
-		(void)lexer_dprint_tok(&optok->tok, stderr);
-		(void)fprintf(stderr, ": Subtracting pointers of incompatible "
-		    "type (");
-		(void)cgtype_print(lval.cgtype, stderr);
-		(void)fprintf(stderr, " and ");
-		(void)cgtype_print(rval.cgtype, stderr);
-		(void)fprintf(stderr, ").\n");
+		cgen_msg_begin(cgexpr->cgen, &optok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Subtracting pointers of "
+		    "incompatible type (");
+		(void)cgtype_print(lval.cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " and ");
+		(void)cgtype_print(rval.cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, ").");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -7853,9 +7863,8 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	/* Check type for completeness */
 	if (cgen_type_is_incomplete(cgexpr->cgen, tptr1->tgtype) ||
 	    cgen_type_is_incomplete(cgexpr->cgen, tptr2->tgtype)) {
-		(void)lexer_dprint_tok(&optok->tok, stderr);
-		(void)fprintf(stderr, ": Subtracting pointers of incomplete "
-		    "type.\n");
+		cgen_error(cgexpr->cgen, &optok->tok, "Subtracting pointers of "
+		    "incomplete type.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -7874,11 +7883,11 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lval.varname, &larg);
+	rc = cgen_vref_oper(&lval.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rval.varname, &rarg);
+	rc = cgen_vref_oper(&rval.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -7889,7 +7898,7 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	instr->op2 = &rarg->oper;
 	instr->opt = elemte;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -7899,7 +7908,7 @@ static int cgen_sub_ptra(cgen_expr_t *cgexpr, comp_tok_t *optok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = ptdtype;
 	if (lval.cvknown && rval.cvknown && lval.cvsymbol == rval.cvsymbol) {
@@ -7991,12 +8000,13 @@ static int cgen_sub(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 
 	/* Integer - pointer/array */
 	if (l_int && r_ptra) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Invalid subtraction of ");
-		(void)cgtype_print(lres->cgtype, stderr);
-		(void)fprintf(stderr, " and ");
-		(void)cgtype_print(rres->cgtype, stderr);
-		(void)fprintf(stderr, ".\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Invalid subtraction of ");
+		(void)cgtype_print(lres->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " and ");
+		(void)cgtype_print(rres->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, ".");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -8032,7 +8042,7 @@ static int cgen_mul(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	bool is_signed;
 	unsigned bits;
 	bool overflow;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8066,11 +8076,11 @@ static int cgen_mul(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8080,7 +8090,7 @@ static int cgen_mul(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8089,7 +8099,7 @@ static int cgen_mul(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8141,7 +8151,7 @@ static int cgen_div(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	bool divbyzero;
 	uint64_t divisor;
 	uint8_t sigbits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8175,11 +8185,11 @@ static int cgen_div(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8189,7 +8199,7 @@ static int cgen_div(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8198,7 +8208,7 @@ static int cgen_div(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		return rc;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8266,7 +8276,7 @@ static int cgen_mod(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	bool is_signed;
 	unsigned bits;
 	bool divbyzero;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8300,11 +8310,11 @@ static int cgen_mod(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8314,7 +8324,7 @@ static int cgen_mod(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8323,7 +8333,7 @@ static int cgen_mod(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		return rc;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8375,7 +8385,7 @@ static int cgen_shl(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	bool is_signed1;
 	bool is_signed2;
 	unsigned bits1;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8420,11 +8430,11 @@ static int cgen_shl(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8434,7 +8444,7 @@ static int cgen_shl(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8443,7 +8453,7 @@ static int cgen_shl(cgen_expr_t *cgexpr, ast_tok_t *optok, cgen_eres_t *lres,
 	if (rc != EOK)
 		return rc;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8500,7 +8510,7 @@ static int cgen_shr(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	bool is_signed1;
 	bool is_signed2;
 	uint8_t shbits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	optok = &ebinop->top;
@@ -8547,11 +8557,11 @@ static int cgen_shr(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8561,7 +8571,7 @@ static int cgen_shr(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8570,7 +8580,7 @@ static int cgen_shr(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->nonneg = lres->nonneg;
@@ -8628,7 +8638,7 @@ static int cgen_band(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	ir_oper_var_t *rarg = NULL;
 	cgtype_t *cgtype = NULL;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8660,11 +8670,11 @@ static int cgen_band(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8674,7 +8684,7 @@ static int cgen_band(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8683,7 +8693,7 @@ static int cgen_band(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8728,7 +8738,7 @@ static int cgen_bxor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	ir_oper_var_t *rarg = NULL;
 	cgtype_t *cgtype = NULL;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8760,11 +8770,11 @@ static int cgen_bxor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8774,7 +8784,7 @@ static int cgen_bxor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8783,7 +8793,7 @@ static int cgen_bxor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -8828,7 +8838,7 @@ static int cgen_bor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	ir_oper_var_t *rarg = NULL;
 	cgtype_t *cgtype = NULL;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Check the type */
@@ -8860,11 +8870,11 @@ static int cgen_bor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -8874,7 +8884,7 @@ static int cgen_bor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -8883,7 +8893,7 @@ static int cgen_bor(cgen_expr_t *cgexpr, cgen_eres_t *lres, cgen_eres_t *rres,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 
@@ -9314,7 +9324,7 @@ static int cgen_lt_int(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *ares,
 	cgen_uac_flags_t flags;
 	unsigned bits;
 	bool is_signed;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -9361,11 +9371,11 @@ static int cgen_lt_int(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -9375,7 +9385,7 @@ static int cgen_lt_int(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *ares,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -9387,7 +9397,7 @@ static int cgen_lt_int(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *ares,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -9442,7 +9452,7 @@ static int cgen_lt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *lres,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -9470,11 +9480,11 @@ static int cgen_lt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -9484,7 +9494,7 @@ static int cgen_lt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *lres,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -9493,7 +9503,7 @@ static int cgen_lt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok, cgen_eres_t *lres,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -9609,7 +9619,7 @@ static int cgen_lteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_uac_flags_t flags;
 	unsigned bits;
 	bool is_signed;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -9656,11 +9666,11 @@ static int cgen_lteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -9670,7 +9680,7 @@ static int cgen_lteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -9682,7 +9692,7 @@ static int cgen_lteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -9737,7 +9747,7 @@ static int cgen_lteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -9765,11 +9775,11 @@ static int cgen_lteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -9779,7 +9789,7 @@ static int cgen_lteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -9788,7 +9798,7 @@ static int cgen_lteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -9904,7 +9914,7 @@ static int cgen_gt_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_uac_flags_t flags;
 	unsigned bits;
 	bool is_signed;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -9951,11 +9961,11 @@ static int cgen_gt_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -9965,7 +9975,7 @@ static int cgen_gt_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -9977,7 +9987,7 @@ static int cgen_gt_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10032,7 +10042,7 @@ static int cgen_gt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -10060,11 +10070,11 @@ static int cgen_gt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10074,7 +10084,7 @@ static int cgen_gt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10083,7 +10093,7 @@ static int cgen_gt_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10199,7 +10209,7 @@ static int cgen_gteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_uac_flags_t flags;
 	unsigned bits;
 	bool is_signed;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -10246,11 +10256,11 @@ static int cgen_gteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10260,7 +10270,7 @@ static int cgen_gteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10272,7 +10282,7 @@ static int cgen_gteq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10327,7 +10337,7 @@ static int cgen_gteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -10355,11 +10365,11 @@ static int cgen_gteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10369,7 +10379,7 @@ static int cgen_gteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10378,7 +10388,7 @@ static int cgen_gteq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10493,7 +10503,7 @@ static int cgen_eq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgen_uac_flags_t flags;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -10537,11 +10547,11 @@ static int cgen_eq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10551,7 +10561,7 @@ static int cgen_eq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10563,7 +10573,7 @@ static int cgen_eq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 	eres->nonneg = true;
@@ -10613,7 +10623,7 @@ static int cgen_eq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -10641,11 +10651,11 @@ static int cgen_eq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10655,7 +10665,7 @@ static int cgen_eq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10664,7 +10674,7 @@ static int cgen_eq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10779,7 +10789,7 @@ static int cgen_neq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgen_uac_flags_t flags;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -10823,11 +10833,11 @@ static int cgen_neq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres.varname, &larg);
+	rc = cgen_vref_oper(&lres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &rarg);
+	rc = cgen_vref_oper(&rres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10837,7 +10847,7 @@ static int cgen_neq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10849,7 +10859,7 @@ static int cgen_neq_int(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgen_eres_fini(&lres);
 	cgen_eres_fini(&rres);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -10899,7 +10909,7 @@ static int cgen_neq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	cgtype_basic_t *btype = NULL;
 	cgtype_pointer_t *tptr1;
 	cgtype_pointer_t *tptr2;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Warn for incompatible pointer types */
@@ -10927,11 +10937,11 @@ static int cgen_neq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lres->varname, &larg);
+	rc = cgen_vref_oper(&lres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres->varname, &rarg);
+	rc = cgen_vref_oper(&rres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -10941,7 +10951,7 @@ static int cgen_neq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -10950,7 +10960,7 @@ static int cgen_neq_ptr(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -11338,8 +11348,8 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	unsigned lblno;
 	char *flabel = NULL;
 	char *elabel = NULL;
-	const char *destvn;
-	const char *dest2vn;
+	cgen_vref_t destvr;
+	cgen_vref_t dest2vr;
 	cgtype_basic_t *btype = NULL;
 	cgen_eres_t lres;
 	cgen_eres_t rres;
@@ -11408,7 +11418,7 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -11416,7 +11426,7 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -11462,7 +11472,7 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	 * by writing/reading the result through a local variable
 	 * (which is not constrained by SSA).
 	 */
-	rc = ir_oper_var_create(destvn, &dest2);
+	rc = cgen_vref_oper(&destvr, &dest2);
 	if (rc != EOK)
 		goto error;
 
@@ -11476,7 +11486,7 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	dest2vn = dest2->varname;
+	cgen_vref_from_oper(dest2, &dest2vr);
 	dest2 = NULL;
 	imm = NULL;
 
@@ -11484,7 +11494,7 @@ static int cgen_land(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = dest2vn;
+	eres->vref = dest2vr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -11557,8 +11567,8 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	unsigned lblno;
 	char *tlabel = NULL;
 	char *elabel = NULL;
-	const char *destvn;
-	const char *dest2vn;
+	cgen_vref_t destvr;
+	cgen_vref_t dest2vr;
 	cgtype_basic_t *btype = NULL;
 	cgen_eres_t lres;
 	cgen_eres_t rres;
@@ -11627,7 +11637,7 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -11635,7 +11645,7 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->nonneg = true;
 
@@ -11681,7 +11691,7 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	 * by writing/reading the result through a local variable
 	 * (which is not constrained by SSA).
 	 */
-	rc = ir_oper_var_create(destvn, &dest2);
+	rc = cgen_vref_oper(&destvr, &dest2);
 	if (rc != EOK)
 		goto error;
 
@@ -11695,7 +11705,7 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	dest2vn = dest2->varname;
+	cgen_vref_from_oper(dest2, &dest2vr);
 	dest2 = NULL;
 	imm = NULL;
 
@@ -11703,7 +11713,7 @@ static int cgen_lor(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = dest2vn;
+	eres->vref = dest2vr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -11772,7 +11782,7 @@ static int cgen_lvaraddr(cgen_proc_t *cgproc, const char *vident,
 	ir_instr_t *instr = NULL;
 	ir_oper_var_t *dest = NULL;
 	ir_oper_var_t *var = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	rc = ir_instr_create(&instr);
@@ -11793,7 +11803,7 @@ static int cgen_lvaraddr(cgen_proc_t *cgproc, const char *vident,
 	instr->op1 = &var->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	var = NULL;
 
@@ -11801,7 +11811,7 @@ static int cgen_lvaraddr(cgen_proc_t *cgproc, const char *vident,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_lvalue;
 	eres->cgtype = NULL;
 
@@ -11843,11 +11853,11 @@ static int cgen_store_record(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &larg);
+	rc = cgen_vref_oper(&ares->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(vres->varname, &rarg);
+	rc = cgen_vref_oper(&vres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -11902,14 +11912,14 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	ir_oper_var_t *lshift = NULL;
 	ir_oper_var_t *shlval = NULL;
 	ir_oper_var_t *combval = NULL;
-	const char *suvalvn;
-	const char *maskvn;
-	const char *sumaskedvn;
-	const char *filtvn;
-	const char *valfiltvn;
-	const char *lshiftvn;
-	const char *shlvalvn;
-	const char *combvalvn;
+	cgen_vref_t suvalvr;
+	cgen_vref_t maskvr;
+	cgen_vref_t sumaskedvr;
+	cgen_vref_t filtvr;
+	cgen_vref_t valfiltvr;
+	cgen_vref_t lshiftvr;
+	cgen_vref_t shlvalvr;
+	cgen_vref_t combvalvr;
 	unsigned bits;
 
 	uint64_t bfmask;
@@ -11946,7 +11956,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &var);
+	rc = cgen_vref_oper(&ares->vref, &var);
 	if (rc != EOK)
 		goto error;
 
@@ -11956,7 +11966,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &var->oper;
 	instr->op2 = NULL;
 
-	suvalvn = suval->varname;
+	cgen_vref_from_oper(suval, &suvalvr);
 	suval = NULL;
 	var = NULL;
 
@@ -11986,7 +11996,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	maskvn = mask->varname;
+	cgen_vref_from_oper(mask, &maskvr);
 	mask = NULL;
 	imm = NULL;
 
@@ -12006,11 +12016,11 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(suvalvn, &larg);
+	rc = cgen_vref_oper(&suvalvr, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(maskvn, &rarg);
+	rc = cgen_vref_oper(&maskvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12020,7 +12030,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	sumaskedvn = sumasked->varname;
+	cgen_vref_from_oper(sumasked, &sumaskedvr);
 	sumasked = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -12051,7 +12061,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	filtvn = filt->varname;
+	cgen_vref_from_oper(filt, &filtvr);
 	filt = NULL;
 	imm = NULL;
 
@@ -12071,11 +12081,11 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(vres->varname, &larg);
+	rc = cgen_vref_oper(&vres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(filtvn, &rarg);
+	rc = cgen_vref_oper(&filtvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12087,7 +12097,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 
 	larg = NULL;
 	rarg = NULL;
-	valfiltvn = valfilt->varname;
+	cgen_vref_from_oper(valfilt, &valfiltvr);
 	valfilt = NULL;
 
 	rc = ir_lblock_append(lblock, NULL, instr);
@@ -12116,7 +12126,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	lshiftvn = lshift->varname;
+	cgen_vref_from_oper(lshift, &lshiftvr);
 	lshift = NULL;
 	imm = NULL;
 
@@ -12134,11 +12144,11 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(valfiltvn, &larg);
+	rc = cgen_vref_oper(&valfiltvr, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lshiftvn, &rarg);
+	rc = cgen_vref_oper(&lshiftvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12148,7 +12158,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	shlvalvn = shlval->varname;
+	cgen_vref_from_oper(shlval, &shlvalvr);
 	shlval = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -12160,8 +12170,8 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	instr = NULL;
 
 	/* Add value to storage unit. */
-	(void)sumaskedvn;
-	(void)shlvalvn;
+	(void)sumaskedvr;
+	(void)shlvalvr;
 
 	rc = ir_instr_create(&instr);
 	if (rc != EOK)
@@ -12171,11 +12181,11 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(sumaskedvn, &larg);
+	rc = cgen_vref_oper(&sumaskedvr, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(shlvalvn, &rarg);
+	rc = cgen_vref_oper(&shlvalvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12187,7 +12197,7 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 
 	larg = NULL;
 	rarg = NULL;
-	combvalvn = combval->varname;
+	cgen_vref_from_oper(combval, &combvalvr);
 	combval = NULL;
 
 	rc = ir_lblock_append(lblock, NULL, instr);
@@ -12202,11 +12212,11 @@ static int cgen_store_bitfield(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &larg);
+	rc = cgen_vref_oper(&ares->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(combvalvn, &rarg);
+	rc = cgen_vref_oper(&combvalvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12252,8 +12262,8 @@ static int cgen_store(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	int rc;
 
 	if ((ares->cgtype->qual & cgqual_const) != cgqual_none) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Setting readonly variable.\n");
+		cgen_error(cgproc->cgen, &ctok->tok, "Setting readonly "
+		    "variable.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -12292,11 +12302,11 @@ static int cgen_store(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &larg);
+	rc = cgen_vref_oper(&ares->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(vres->varname, &rarg);
+	rc = cgen_vref_oper(&vres->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -12346,7 +12356,7 @@ static int cgen_address(cgen_eres_t *bres, cgen_eres_t *eres)
 	cgtype = &ptrtype->cgtype;
 
 	/* Return address as rvalue */
-	eres->varname = bres->varname;
+	eres->vref = bres->vref;
 	eres->valtype = cgen_rvalue;
 	eres->cvknown = bres->cvknown;
 	eres->cvint = bres->cvint;
@@ -12421,7 +12431,7 @@ static int cgen_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_fini(&rres);
 	cgen_eres_fini(&cres);
 
-	eres->varname = cres.varname;
+	eres->vref = cres.vref;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12450,7 +12460,7 @@ static int cgen_plus_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_t rres;
 	cgen_eres_t ores;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&laddr);
@@ -12489,9 +12499,9 @@ static int cgen_plus_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12528,7 +12538,7 @@ static int cgen_minus_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_t rres;
 	cgen_eres_t ores;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&laddr);
@@ -12567,9 +12577,9 @@ static int cgen_minus_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12607,7 +12617,7 @@ static int cgen_times_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_t ores;
 	cgtype_t *cgtype;
 	cgen_uac_flags_t flags;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -12648,9 +12658,9 @@ static int cgen_times_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12688,7 +12698,7 @@ static int cgen_divide_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_t ores;
 	cgtype_t *cgtype;
 	cgen_uac_flags_t flags;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -12727,9 +12737,9 @@ static int cgen_divide_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12767,7 +12777,7 @@ static int cgen_modulo_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgen_eres_t ores;
 	cgtype_t *cgtype;
 	cgen_uac_flags_t flags;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -12806,9 +12816,9 @@ static int cgen_modulo_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12849,7 +12859,7 @@ static int cgen_shl_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	bool conv1;
 	bool conv2;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -12910,9 +12920,9 @@ static int cgen_shl_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -12956,7 +12966,7 @@ static int cgen_shr_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	bool conv1;
 	bool conv2;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&lres);
@@ -13017,9 +13027,9 @@ static int cgen_shr_assign(cgen_expr_t *cgexpr, ast_ebinop_t *ebinop,
 	cgtype = ores.cgtype;
 	ores.cgtype = NULL;
 
-	resvn = ores.varname;
+	resvr = ores.vref;
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -13548,13 +13558,14 @@ static int cgen_etcond_rtype(cgen_expr_t *cgexpr, comp_tok_t *tok,
 		}
 	}
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Invalid argument types to conditional "
-	    "operator (");
-	(void)cgtype_print(atype, stderr);
-	(void)fprintf(stderr, ", ");
-	(void)cgtype_print(btype, stderr);
-	(void)fprintf(stderr, ").\n");
+	cgen_msg_begin(cgexpr->cgen, &tok->tok, dsev_error);
+	(void)fprintf(cgexpr->cgen->msgf, "Invalid argument types to "
+	    "conditional operator (");
+	(void)cgtype_print(atype, cgexpr->cgen->msgf);
+	(void)fprintf(cgexpr->cgen->msgf, ", ");
+	(void)cgtype_print(btype, cgexpr->cgen->msgf);
+	(void)fprintf(cgexpr->cgen->msgf, ").");
+	cgen_msg_end(cgexpr->cgen);
 	cgexpr->cgen->error = true; // TODO
 	return EINVAL;
 	(void)rrtype;
@@ -13643,9 +13654,8 @@ static int cgen_etcond(cgen_expr_t *cgexpr, ast_etcond_t *etcond,
 	isvoid = cgtype_is_void(rtype);
 	if (isvoid) {
 		ctok = (comp_tok_t *)etcond->tqmark.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Conditional with void "
-		    "operands can be rewritten as an if-else statement.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Conditional with void "
+		    "operands can be rewritten as an if-else statement.");
 		++cgexpr->cgen->warnings;
 	}
 
@@ -13709,11 +13719,11 @@ static int cgen_etcond(cgen_expr_t *cgexpr, ast_etcond_t *etcond,
 		 * by writing/reading the result through a local variable
 		 * (which is not constrained by SSA).
 		 */
-		rc = ir_oper_var_create(tcres.varname, &dest);
+		rc = cgen_vref_oper(&tcres.vref, &dest);
 		if (rc != EOK)
 			goto error;
 
-		rc = ir_oper_var_create(fcres.varname, &larg);
+		rc = cgen_vref_oper(&fcres.vref, &larg);
 		if (rc != EOK)
 			goto error;
 
@@ -13730,7 +13740,7 @@ static int cgen_etcond(cgen_expr_t *cgexpr, ast_etcond_t *etcond,
 		if (rc != EOK)
 			goto error;
 
-		eres->varname = tcres.varname;
+		eres->vref = tcres.vref;
 		eres->valtype = cgen_rvalue;
 		eres->cgtype = rtype;
 		eres->sigbits = cgen_bits_max(tres.sigbits, fres.sigbits);
@@ -13740,7 +13750,6 @@ static int cgen_etcond(cgen_expr_t *cgexpr, ast_etcond_t *etcond,
 		dest = NULL;
 		larg = NULL;
 	} else {
-		eres->varname = NULL;
 		eres->valtype = cgen_rvalue;
 		eres->cgtype = rtype;
 		eres->valused = true;
@@ -13822,11 +13831,9 @@ static void cgen_check_passed_array_dim(cgen_t *cgen, comp_tok_t *tok,
 	aarray = (cgtype_array_t *)atype->ext;
 
 	if (aarray->asize < farray->asize) {
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Array passed to function "
-		    "is too small (expected dimension %" PRId64
-		    ", actual dimension %" PRId64 ").\n", farray->asize,
-		    aarray->asize);
+		cgen_warning(cgen, &tok->tok, "Array passed to function is too "
+		    "small (expected dimension %" PRId64 ", actual dimension "
+		    "%" PRId64 ").", farray->asize, aarray->asize);
 		++cgen->warnings;
 	}
 }
@@ -13987,7 +13994,7 @@ static int cgen_ecall_rrec_pass_addr(cgen_expr_t *cgexpr, cgtype_t *rtype,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares.varname, &arg);
+	rc = cgen_vref_oper(&ares.vref, &arg);
 	if (rc != EOK)
 		goto error;
 
@@ -14080,9 +14087,8 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 			cident = fres.cvsymbol->ident->tok.text;
 
 		tok = (comp_tok_t *)ecall->tlparen.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Called object '%s' is not "
-		    "a function.\n", cident);
+		cgen_error(cgexpr->cgen, &tok->tok, "Called object '%s' is not "
+		    "a function.", cident);
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14139,9 +14145,8 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 			atok = ast_tree_first_tok(earg->arg);
 			tok = (comp_tok_t *) atok->data;
 
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Too many arguments "
-			    "to function '%s'.\n", cident);
+			cgen_error(cgexpr->cgen, &tok->tok, "Too many "
+			    "arguments to function '%s'.", cident);
 			cgexpr->cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -14208,7 +14213,7 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 				goto error;
 		}
 
-		rc = ir_oper_var_create(cres.varname, &arg);
+		rc = cgen_vref_oper(&cres.vref, &arg);
 		if (rc != EOK)
 			goto error;
 
@@ -14235,9 +14240,8 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 		/* Still some left */
 		tok = (comp_tok_t *) ecall->trparen.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Too few arguments to function '%s'.\n",
-		    cident);
+		cgen_error(cgexpr->cgen, &tok->tok, "Too few arguments to "
+		    "function '%s'.", cident);
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14273,7 +14277,7 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 			goto error;
 
 		/* Function address operand */
-		rc = ir_oper_var_create(frres.varname, &fun);
+		rc = cgen_vref_oper(&frres.vref, &fun);
 		if (rc != EOK)
 			goto error;
 
@@ -14293,7 +14297,8 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 
 	free(pident);
 
-	eres->varname = dest != NULL ? dest->varname : NULL;
+	if (dest != NULL)
+		cgen_vref_from_oper(dest, &eres->vref);
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = rtype;
 	eres->valused = cgtype_is_void(ftype->rtype) ||
@@ -14304,7 +14309,7 @@ static int cgen_ecall(cgen_expr_t *cgexpr, ast_ecall_t *ecall,
 	 * the temporary local variable which we previously created.
 	 */
 	if (!cgtype_is_void(rtype) && ret_record) {
-		eres->varname = rvaraddr->varname;
+		cgen_vref_from_oper(rvaraddr, &eres->vref);
 	}
 
 	eres->sigbits = cgen_type_sigbits(cgexpr->cgen, ftype->rtype);
@@ -14395,17 +14400,16 @@ static int cgen_eindex(cgen_expr_t *cgexpr, ast_eindex_t *eindex,
 	ctok = (comp_tok_t *) eindex->tlbracket.data;
 
 	if (!b_ptra && !i_ptra) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Subscripted object is "
-		    "neither pointer nor array.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Subscripted object is "
+		    "neither pointer nor array.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
 	}
 
 	if ((b_ptra && !i_inte) || (i_ptra && !b_inte)) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Subscript index is not an integer.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Subscript index is not "
+		    "an integer.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14425,7 +14429,7 @@ static int cgen_eindex(cgen_expr_t *cgexpr, ast_eindex_t *eindex,
 		goto error;
 
 	/* Return address as lvalue */
-	eres->varname = sres.varname;
+	eres->vref = sres.vref;
 	eres->valtype = cgen_lvalue;
 	eres->cgtype = cgtype;
 	eres->sigbits = cgen_type_sigbits(cgexpr->cgen, cgtype);
@@ -14471,11 +14475,12 @@ static int cgen_ederef(cgen_expr_t *cgexpr, ast_ederef_t *ederef,
 		/* Still some left */
 		tok = (comp_tok_t *) ederef->tasterisk.data;
 
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Dereference operator needs "
+		cgen_msg_begin(cgexpr->cgen, &tok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Dereference operator needs "
 		    "a pointer, got '");
-		(void)cgtype_print(bres.cgtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		(void)cgtype_print(bres.cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14483,9 +14488,8 @@ static int cgen_ederef(cgen_expr_t *cgexpr, ast_ederef_t *ederef,
 
 	if (cgen_type_is_fptr(cgexpr->cgen, bres.cgtype)) {
 		tok = (comp_tok_t *)ederef->tasterisk.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Explicitly dereferencing "
-		    "function pointer is not necessary.\n");
+		cgen_warning(cgexpr->cgen, &tok->tok, "Explicitly "
+		    "dereferencing function pointer is not necessary.");
 		++cgexpr->cgen->warnings;
 	}
 
@@ -14498,7 +14502,7 @@ static int cgen_ederef(cgen_expr_t *cgexpr, ast_ederef_t *ederef,
 	cgen_eres_fini(&bres);
 
 	/* Return address as lvalue */
-	eres->varname = bres.varname;
+	eres->vref = bres.vref;
 	eres->valtype = cgen_lvalue;
 	eres->cgtype = cgtype;
 	eres->sigbits = cgen_type_sigbits(cgexpr->cgen, cgtype);
@@ -14533,16 +14537,15 @@ static int cgen_eaddr(cgen_expr_t *cgexpr, ast_eaddr_t *eaddr,
 
 	if (bres.cgtype->ntype == cgn_func) {
 		ctok = (comp_tok_t *)eaddr->tamper.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Explicitly taking "
-		    "the address of a function is not necessary.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Explicitly taking the "
+		    "address of a function is not necessary.");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (bres.bitwidth > 0) {
 		ctok = (comp_tok_t *)eaddr->tamper.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Cannot take address of bitfield.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Cannot take address of "
+		    "bitfield.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14578,9 +14581,8 @@ static int cgen_ealignof_cgtype(cgen_expr_t *cgexpr, cgtype_t *etype,
 	int rc;
 
 	if (etype->ntype == cgn_func) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Alignof operator applied "
-		    "to a function.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Alignof operator applied "
+		    "to a function.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14625,18 +14627,16 @@ static int cgen_ealignof_typename(cgen_expr_t *cgexpr, ast_ealignof_t *ealignof,
 	ctok = (comp_tok_t *) atok->data;
 
 	if ((dsres.rdflags & cgrd_def) != cgrd_none) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Struct/union/enum definition "
-		    "inside alignof().\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Struct/union/enum "
+		    "definition inside alignof().");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (dsres.sctype != asc_none) {
 		atok = ast_tree_first_tok(&ealignof->atypename->node);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented storage class "
-		    "specifier.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented storage "
+		    "class specifier.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -14780,9 +14780,8 @@ static int cgen_esizeof_cgtype(cgen_expr_t *cgexpr, cgtype_t *etype,
 	int rc;
 
 	if (etype->ntype == cgn_func) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Sizeof operator applied "
-		    "to a function.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Sizeof operator applied "
+		    "to a function.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -14827,18 +14826,16 @@ static int cgen_esizeof_typename(cgen_expr_t *cgexpr, ast_esizeof_t *esizeof,
 	ctok = (comp_tok_t *) atok->data;
 
 	if ((dsres.rdflags & cgrd_def) != cgrd_none) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Struct/union/enum "
-		    "definition inside sizeof().\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Struct/union/enum "
+		    "definition inside sizeof().");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (dsres.sctype != asc_none) {
 		atok = ast_tree_first_tok(&esizeof->atypename->node);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented storage class "
-		    "specifier.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented storage "
+		    "class specifier.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15228,9 +15225,8 @@ static int cgen_ecast(cgen_expr_t *cgexpr, ast_ecast_t *ecast,
 				    lblock, eres);
 				break;
 			default:
-				(void)lexer_dprint_tok(&ident->tok, stderr);
-				(void)fprintf(stderr, ": Type identifier "
-				    "expected.\n");
+				cgen_error(cgexpr->cgen, &ident->tok, "Type "
+				    "identifier expected.");
 
 				cgexpr->cgen->error = true; // TODO
 				rc = EINVAL;
@@ -15253,18 +15249,16 @@ static int cgen_ecast(cgen_expr_t *cgexpr, ast_ecast_t *ecast,
 	if ((dsres.rdflags & cgrd_def) != cgrd_none) {
 		atok = ast_tree_first_tok(&ecast->dspecs->node);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Struct/union/enum "
-		    "definition inside a cast.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Struct/union/enum "
+		    "definition inside a cast.");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (dsres.sctype != asc_none) {
 		atok = ast_tree_first_tok(&ecast->dspecs->node);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented storage class "
-		    "specifier.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented storage "
+		    "class specifier.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15323,7 +15317,7 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	ir_oper_var_t *rarg = NULL;
 	unsigned mbroff;
 	ir_texpr_t *recte = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&bres);
@@ -15336,8 +15330,8 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	btype = bres.cgtype;
 	if (btype->ntype != cgn_record) {
 		ctok = (comp_tok_t *)emember->tperiod.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": '.' requires a struct or union.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "'.' requires a struct or "
+		    "union.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15351,10 +15345,12 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	elem = cgen_record_elem_find(record, mtok->tok.text, NULL);
 	if (elem == NULL) {
 		ctok = (comp_tok_t *)emember->tperiod.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Record type ");
-		(void)cgtype_print(btype, stderr);
-		(void)fprintf(stderr, " has no member named '%s'.\n", mtok->tok.text);
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Record type ");
+		(void)cgtype_print(btype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " has no member named '%s'.",
+		    mtok->tok.text);
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15373,7 +15369,7 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(bres.varname, &larg);
+	rc = cgen_vref_oper(&bres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
@@ -15388,7 +15384,7 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	instr->op2 = &rarg->oper;
 	instr->opt = recte;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -15402,7 +15398,7 @@ static int cgen_emember(cgen_expr_t *cgexpr, ast_emember_t *emember,
 	if (rc != EOK)
 		return rc;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_lvalue;
 	eres->bitwidth = elem->width;
 	eres->bitpos = elem->bitpos;
@@ -15464,7 +15460,7 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	unsigned mbroff;
 	char *irident = NULL;
 	ir_texpr_t *recte = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 	int rv;
 
@@ -15478,9 +15474,8 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	btype = bres.cgtype;
 	if (btype->ntype != cgn_pointer) {
 		ctok = (comp_tok_t *)eindmember->tarrow.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": '->' requires a pointer to a "
-		    "struct or union.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "'->' requires a pointer "
+		    "to a struct or union.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15490,9 +15485,8 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 
 	if (ptype->tgtype->ntype != cgn_record) {
 		ctok = (comp_tok_t *)eindmember->tarrow.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": '->' requires a pointer to a "
-		    "struct or union.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "'->' requires a pointer "
+		    "to a struct or union.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15506,10 +15500,12 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	elem = cgen_record_elem_find(record, mtok->tok.text, NULL);
 	if (elem == NULL) {
 		ctok = (comp_tok_t *)eindmember->tarrow.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Record type ");
-		(void)cgtype_print(ptype->tgtype, stderr);
-		(void)fprintf(stderr, " has no member named '%s'.\n", mtok->tok.text);
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Record type ");
+		(void)cgtype_print(ptype->tgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " has no member named '%s'.",
+		    mtok->tok.text);
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -15534,7 +15530,7 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(bres.varname, &larg);
+	rc = cgen_vref_oper(&bres.vref, &larg);
 	if (rc != EOK)
 		goto error;
 
@@ -15549,7 +15545,7 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	instr->op2 = &rarg->oper;
 	instr->opt = recte;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -15563,7 +15559,7 @@ static int cgen_eindmember(cgen_expr_t *cgexpr, ast_eindmember_t *eindmember,
 	if (rc != EOK)
 		return rc;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_lvalue;
 	eres->bitwidth = elem->width;
 	eres->cgtype = mtype;
@@ -15623,7 +15619,7 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 	bool is_signed;
 	unsigned bits;
 	bool overflow;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&bres);
@@ -15643,8 +15639,8 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 	ctok = (comp_tok_t *) eusign->tsign.data;
 
 	if (bires.cgtype->ntype != cgn_basic) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented variable type.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented variable "
+		    "type.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -15653,8 +15649,8 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 	tbasic = (cgtype_basic_t *)bires.cgtype->ext;
 	bits = cgen_basic_type_bits(cgexpr->cgen, tbasic);
 	if (bits == 0) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented variable type.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented variable "
+		    "type.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -15681,7 +15677,7 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 		if (rc != EOK)
 			goto error;
 
-		rc = ir_oper_var_create(bires.varname, &barg);
+		rc = cgen_vref_oper(&bires.vref, &barg);
 		if (rc != EOK)
 			goto error;
 
@@ -15691,7 +15687,7 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 		instr->op1 = &barg->oper;
 		instr->op2 = NULL;
 
-		destvn = dest->varname;
+		cgen_vref_from_oper(dest, &destvr);
 		dest = NULL;
 		barg = NULL;
 
@@ -15701,7 +15697,7 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 
 		instr = NULL;
 
-		eres->varname = destvn;
+		eres->vref = destvr;
 		eres->valtype = cgen_rvalue;
 		/* Salvage the type from bires */
 		eres->cgtype = bires.cgtype;
@@ -15717,7 +15713,7 @@ static int cgen_eusign(cgen_expr_t *cgexpr, ast_eusign_t *eusign,
 		}
 	} else {
 		/* Unary plus */
-		sres.varname = bires.varname;
+		sres.vref = bires.vref;
 		sres.valtype = cgen_rvalue;
 		/* Salvage the type from bires */
 		sres.cgtype = bires.cgtype;
@@ -15770,7 +15766,7 @@ static int cgen_elnot(cgen_expr_t *cgexpr, ast_elnot_t *elnot,
 	unsigned lblno;
 	char *flabel = NULL;
 	char *elabel = NULL;
-	const char *destvn;
+	cgen_vref_t destvr;
 	cgtype_basic_t *btype = NULL;
 	cgen_eres_t bres;
 	int rc;
@@ -15824,7 +15820,7 @@ static int cgen_elnot(cgen_expr_t *cgexpr, ast_elnot_t *elnot,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	imm = NULL;
 
@@ -15876,7 +15872,7 @@ static int cgen_elnot(cgen_expr_t *cgexpr, ast_elnot_t *elnot,
 	 * by writing/reading the result through a local variable
 	 * (which is not constrained by SSA).
 	 */
-	rc = ir_oper_var_create(destvn, &dest);
+	rc = cgen_vref_oper(&destvr, &dest);
 	if (rc != EOK)
 		goto error;
 
@@ -15904,7 +15900,7 @@ static int cgen_elnot(cgen_expr_t *cgexpr, ast_elnot_t *elnot,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = &btype->cgtype;
 
@@ -15965,7 +15961,7 @@ static int cgen_ebnot(cgen_expr_t *cgexpr, ast_ebnot_t *ebnot,
 	unsigned bits;
 	cgtype_t *cgtype;
 	cgtype_basic_t *tbasic;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&bres);
@@ -16020,7 +16016,7 @@ static int cgen_ebnot(cgen_expr_t *cgexpr, ast_ebnot_t *ebnot,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(bires.varname, &barg);
+	rc = cgen_vref_oper(&bires.vref, &barg);
 	if (rc != EOK)
 		goto error;
 
@@ -16030,7 +16026,7 @@ static int cgen_ebnot(cgen_expr_t *cgexpr, ast_ebnot_t *ebnot,
 	instr->op1 = &barg->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	barg = NULL;
 
@@ -16044,7 +16040,7 @@ static int cgen_ebnot(cgen_expr_t *cgexpr, ast_ebnot_t *ebnot,
 	cgen_eres_fini(&bres);
 	cgen_eres_fini(&bires);
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->sigbits = cgen_logic_bits;
@@ -16086,7 +16082,7 @@ static int cgen_epreadj(cgen_expr_t *cgexpr, ast_epreadj_t *epreadj,
 	cgen_eres_t adj;
 	cgen_eres_t ares;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&baddr);
@@ -16133,15 +16129,14 @@ static int cgen_epreadj(cgen_expr_t *cgexpr, ast_epreadj_t *epreadj,
 	cgtype = ares.cgtype;
 	ares.cgtype = NULL;
 
-	resvn = ares.varname;
-	ares.varname = NULL;
+	resvr = ares.vref;
 
 	cgen_eres_fini(&baddr);
 	cgen_eres_fini(&bval);
 	cgen_eres_fini(&adj);
 	cgen_eres_fini(&ares);
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -16173,7 +16168,7 @@ static int cgen_epostadj(cgen_expr_t *cgexpr, ast_epostadj_t *epostadj,
 	cgen_eres_t adj;
 	cgen_eres_t ares;
 	cgtype_t *cgtype;
-	const char *resvn;
+	cgen_vref_t resvr;
 	int rc;
 
 	cgen_eres_init(&baddr);
@@ -16221,15 +16216,14 @@ static int cgen_epostadj(cgen_expr_t *cgexpr, ast_epostadj_t *epostadj,
 	cgtype = bval.cgtype;
 	bval.cgtype = NULL;
 
-	resvn = bval.varname;
-	bval.varname = NULL;
+	resvr = bval.vref;
 
 	cgen_eres_fini(&baddr);
 	cgen_eres_fini(&bval);
 	cgen_eres_fini(&adj);
 	cgen_eres_fini(&ares);
 
-	eres->varname = resvn;
+	eres->vref = resvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = true;
@@ -16273,10 +16267,12 @@ static int cgen_check_va_list(cgen_proc_t *cgproc, cgtype_t *cgtype,
 			return EOK;
 	}
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": expected expression of type __va_list, got ");
-	(void)cgtype_print(cgtype, stderr);
-	(void)fprintf(stderr, ".\n");
+	cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_error);
+	(void)fprintf(cgproc->cgen->msgf, "expected expression of type "
+	    "__va_list, got ");
+	(void)cgtype_print(cgtype, cgproc->cgen->msgf);
+	(void)fprintf(cgproc->cgen->msgf, ".");
+	cgen_msg_end(cgproc->cgen);
 	cgproc->cgen->error = true; // TODO
 	return EINVAL;
 }
@@ -16302,7 +16298,7 @@ static int cgen_eva_arg(cgen_expr_t *cgexpr, ast_eva_arg_t *eva_arg,
 	comp_tok_t *ctok;
 	cgen_dspec_res_t dsres;
 	cgsize_t sz;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&apres);
@@ -16328,17 +16324,16 @@ static int cgen_eva_arg(cgen_expr_t *cgexpr, ast_eva_arg_t *eva_arg,
 	ctok = (comp_tok_t *) atok->data;
 
 	if ((dsres.rdflags & cgrd_def) != cgrd_none) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Struct/union/enum definition "
-		    "inside __va_arg().\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Struct/union/enum "
+		    "definition inside __va_arg().");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (dsres.sctype != asc_none) {
 		atok = ast_tree_first_tok(&eva_arg->atypename->node);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented storage class specifier.\n");
+		cgen_error(cgexpr->cgen, &ctok->tok, "Unimplemented storage "
+		    "class specifier.");
 		cgexpr->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -16369,7 +16364,7 @@ static int cgen_eva_arg(cgen_expr_t *cgexpr, ast_eva_arg_t *eva_arg,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(apres.varname, &var);
+	rc = cgen_vref_oper(&apres.vref, &var);
 	if (rc != EOK)
 		goto error;
 
@@ -16383,7 +16378,7 @@ static int cgen_eva_arg(cgen_expr_t *cgexpr, ast_eva_arg_t *eva_arg,
 	instr->op1 = &var->oper;
 	instr->op2 = &imm->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	var = NULL;
 	imm = NULL;
@@ -16392,7 +16387,7 @@ static int cgen_eva_arg(cgen_expr_t *cgexpr, ast_eva_arg_t *eva_arg,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_lvalue;
 	eres->cgtype = NULL;
 	eres->cvknown = false;
@@ -16466,9 +16461,8 @@ static int cgen_expr(cgen_expr_t *cgexpr, ast_node_t *expr,
 	case ant_econcat:
 		atok = ast_tree_first_tok(expr);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": This expression type is not "
-		    "implemented.\n");
+		cgen_error(cgexpr->cgen, &tok->tok, "This expression type is "
+		    "not implemented.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		break;
@@ -16515,9 +16509,8 @@ static int cgen_expr(cgen_expr_t *cgexpr, ast_node_t *expr,
 	case ant_ecliteral:
 		atok = ast_tree_first_tok(expr);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": This expression type is not "
-		    "implemented.\n");
+		cgen_error(cgexpr->cgen, &tok->tok, "This expression type is "
+		    "not implemented.");
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
 		break;
@@ -16648,11 +16641,11 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	ir_oper_imm_t *imm = NULL;
 	ir_oper_var_t *larg = NULL;
 	ir_oper_var_t *rarg = NULL;
-	const char *suvalvn;
-	const char *lshiftvn;
-	const char *rshiftvn;
-	const char *shlvalvn;
-	const char *shrvalvn;
+	cgen_vref_t suvalvr;
+	cgen_vref_t lshiftvr;
+	cgen_vref_t rshiftvr;
+	cgen_vref_t shlvalvr;
+	cgen_vref_t shrvalvr;
 	bool is_signed;
 
 	cgtype_t *cgtype;
@@ -16672,7 +16665,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res->varname, &var);
+	rc = cgen_vref_oper(&res->vref, &var);
 	if (rc != EOK)
 		goto error;
 
@@ -16682,7 +16675,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &var->oper;
 	instr->op2 = NULL;
 
-	suvalvn = suval->varname;
+	cgen_vref_from_oper(suval, &suvalvr);
 	suval = NULL;
 	var = NULL;
 
@@ -16712,7 +16705,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	lshiftvn = lshift->varname;
+	cgen_vref_from_oper(lshift, &lshiftvr);
 	imm = NULL;
 	lshift = NULL;
 
@@ -16730,11 +16723,11 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(suvalvn, &larg);
+	rc = cgen_vref_oper(&suvalvr, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(lshiftvn, &rarg);
+	rc = cgen_vref_oper(&lshiftvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -16744,7 +16737,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	shlvalvn = shlval->varname;
+	cgen_vref_from_oper(shlval, &shlvalvr);
 	shlval = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -16775,7 +16768,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &imm->oper;
 	instr->op2 = NULL;
 
-	rshiftvn = rshift->varname;
+	cgen_vref_from_oper(rshift, &rshiftvr);
 	imm = NULL;
 	rshift = NULL;
 
@@ -16793,11 +16786,11 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(shlvalvn, &larg);
+	rc = cgen_vref_oper(&shlvalvr, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rshiftvn, &rarg);
+	rc = cgen_vref_oper(&rshiftvr, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -16808,7 +16801,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	shrvalvn = shrval->varname;
+	cgen_vref_from_oper(shrval, &shrvalvr);
 	shrval = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -16823,7 +16816,7 @@ static int cgen_load_bitfield(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = shrvalvn;
+	eres->vref = shrvalvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = res->valused;
@@ -16872,7 +16865,7 @@ static int cgen_load(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	ir_oper_var_t *var = NULL;
 	cgtype_t *cgtype;
 	unsigned bits;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	/* Reading variables is not allowed in constant expressions */
@@ -16918,7 +16911,7 @@ static int cgen_load(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(res->varname, &var);
+	rc = cgen_vref_oper(&res->vref, &var);
 	if (rc != EOK)
 		goto error;
 
@@ -16928,7 +16921,7 @@ static int cgen_load(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	instr->op1 = &var->oper;
 	instr->op2 = NULL;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	var = NULL;
 
@@ -16940,7 +16933,7 @@ static int cgen_load(cgen_expr_t *cgexpr, cgen_eres_t *res,
 	if (rc != EOK)
 		goto error;
 
-	eres->varname = destvn;
+	eres->vref = destvr;
 	eres->valtype = cgen_rvalue;
 	eres->cgtype = cgtype;
 	eres->valused = res->valused;
@@ -17034,7 +17027,7 @@ static int cgen_eres_rvalue(cgen_expr_t *cgexpr, cgen_eres_t *res,
 		if (rc != EOK)
 			goto error;
 
-		eres->varname = res->varname;
+		eres->vref = res->vref;
 		eres->valtype = cgen_rvalue;
 		eres->cgtype = cgtype;
 		eres->valused = res->valused;
@@ -17197,7 +17190,7 @@ static int cgen_enum2int(cgen_t *cgen, cgen_eres_t *res,
 	if (rc != EOK)
 		return rc;
 
-	rres->varname = res->varname;
+	rres->vref = res->vref;
 	rres->valtype = res->valtype;
 	rres->cvknown = res->cvknown;
 	rres->cvint = res->cvint;
@@ -17231,7 +17224,7 @@ static int cgen_bool2char(cgen_t *cgen, cgen_eres_t *res, bool to_signed,
 	if (rc != EOK)
 		return rc;
 
-	rres->varname = res->varname;
+	rres->vref = res->vref;
 	rres->valtype = res->valtype;
 	rres->cvknown = res->cvknown;
 	rres->cvint = res->cvint;
@@ -17283,7 +17276,7 @@ static int cgen_int2enum(cgen_expr_t *cgexpr, cgen_eres_t *ares,
 		return EOK;
 	}
 
-	eres->varname = ares->varname;
+	eres->vref = ares->vref;
 	eres->valtype = ares->valtype;
 	eres->cvknown = ares->cvknown;
 	eres->cvint = ares->cvint;
@@ -17725,7 +17718,6 @@ static int cgen_type_convert_to_void(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		return rc;
 
-	cres->varname = NULL;
 	cres->valtype = cgen_rvalue;
 	cres->cgtype = cgtype;
 	cres->valused = true;
@@ -17764,7 +17756,7 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	bool dest_signed;
 	bool src_neg;
 	bool dest_neg;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	assert(ares->cgtype->ntype == cgn_basic);
@@ -17786,7 +17778,7 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	/* Source and destination are of the same size ? */
 	if (destw == srcw) {
 		/* No conversion needed */
-		cres->varname = ares->varname;
+		cres->vref = ares->vref;
 		cres->valtype = ares->valtype;
 		cres->cgtype = cgtype;
 		cres->valused = true;
@@ -17836,9 +17828,8 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 		if (expl != cgen_explicit && !ares->cvknown &&
 		    destw < rres.unprombits && destw < rres.sigbits) {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Conversion may loose "
-			    "significant digits.\n");
+			cgen_warning(cgexpr->cgen, &ctok->tok, "Conversion may "
+			    "loose significant digits.");
 			++cgexpr->cgen->warnings;
 		}
 	} else {
@@ -17859,7 +17850,7 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(rres.varname, &sarg);
+	rc = cgen_vref_oper(&rres.vref, &sarg);
 	if (rc != EOK)
 		goto error;
 
@@ -17873,7 +17864,7 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	instr->op1 = &sarg->oper;
 	instr->op2 = &imm->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	sarg = NULL;
 	imm = NULL;
@@ -17882,7 +17873,7 @@ static int cgen_type_convert_integer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = destvn;
+	cres->vref = destvr;
 	cres->valtype = cgen_rvalue;
 	cres->cgtype = cgtype;
 	cres->valused = true;
@@ -17952,22 +17943,25 @@ static int cgen_type_convert_pointer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	    expl != cgen_explicit &&
 	    !cgtype_is_void(ptrtype1->tgtype) &&
 	    !cgtype_is_void(ptrtype2->tgtype)) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Converting from ");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, " to incompatible pointer type ");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, ".\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Converting from ");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " to incompatible pointer "
+		    "type ");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, ".");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	} else if (cgtype_ptr_compatible(ptrtype1, ptrtype2) &&
 	    !cgtype_ptr_preserves_tqual(ptrtype1, ptrtype2) &&
 	    expl != cgen_explicit) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Converting from ");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, " to ");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, " discards type qualifiers.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Converting from ");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " to ");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " discards type qualifiers.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -17975,7 +17969,7 @@ static int cgen_type_convert_pointer(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = ares->varname;
+	cres->vref = ares->vref;
 	cres->valtype = ares->valtype;
 	cres->cgtype = cgtype;
 	cres->valused = ares->valused;
@@ -18017,12 +18011,14 @@ static int cgen_type_convert_record(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	rtype2 = (cgtype_record_t *)dtype->ext;
 
 	if (rtype1->record != rtype2->record) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Converting from '");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, "' to incompatible struct/union type '");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Converting from '");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' to incompatible "
+		    "struct/union type '");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 	}
 
@@ -18030,7 +18026,7 @@ static int cgen_type_convert_record(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = ares->varname;
+	cres->vref = ares->vref;
 	cres->valtype = ares->valtype;
 	cres->cgtype = cgtype;
 	cres->valused = ares->valused;
@@ -18074,12 +18070,13 @@ static int cgen_type_convert_enum(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	etype2 = (cgtype_enum_t *)dtype->ext;
 
 	if (etype1->cgenum != etype2->cgenum && expl != cgen_explicit) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from '");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, "' to different enum type '");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Implicit conversion from '");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' to different enum type '");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -18087,7 +18084,7 @@ static int cgen_type_convert_enum(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = ares->varname;
+	cres->vref = ares->vref;
 	cres->valtype = ares->valtype;
 	cres->cgtype = cgtype;
 	cres->valused = ares->valused;
@@ -18133,12 +18130,13 @@ static int cgen_type_convert_from_enum(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 	/* Conversion is implicit and enum is strict */
 	if (expl != cgen_explicit && converted) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from '");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, "' to '");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Implicit conversion from '");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' to '");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -18188,16 +18186,17 @@ static int cgen_type_convert_to_enum(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 		goto error;
 
 	if (expl != cgen_explicit) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from '");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, "' to '");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Implicit conversion from '");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' to '");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
-	cres->varname = ires.varname;
+	cres->vref = ires.vref;
 	cres->valtype = ires.valtype;
 	cres->cvknown = ares->cvknown;
 	cres->cvint = ares->cvint;
@@ -18264,11 +18263,12 @@ static int cgen_type_convert_from_bool(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 	if (expl == cgen_implicit && !cgen_type_is_logic(cgexpr->cgen, dtype)) {
 		/* Generate warning. */
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from '_Bool' "
-		    "to '");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Implicit conversion from "
+		    "'_Bool' to '");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "'.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -18304,7 +18304,7 @@ static int cgen_type_convert_logic_to_bool(cgen_expr_t *cgexpr,
 	ir_oper_var_t *dest = NULL;
 	ir_oper_var_t *sarg = NULL;
 	ir_oper_imm_t *imm = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	rc = ir_instr_create(&instr);
@@ -18315,7 +18315,7 @@ static int cgen_type_convert_logic_to_bool(cgen_expr_t *cgexpr,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &sarg);
+	rc = cgen_vref_oper(&ares->vref, &sarg);
 	if (rc != EOK)
 		goto error;
 
@@ -18329,7 +18329,7 @@ static int cgen_type_convert_logic_to_bool(cgen_expr_t *cgexpr,
 	instr->op1 = &sarg->oper;
 	instr->op2 = &imm->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	sarg = NULL;
 	imm = NULL;
@@ -18345,7 +18345,7 @@ static int cgen_type_convert_logic_to_bool(cgen_expr_t *cgexpr,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = destvn;
+	cres->vref = destvr;
 	cres->valtype = ares->valtype;
 	cres->cvknown = ares->cvknown;
 	cres->cvint = ares->cvint;
@@ -18392,10 +18392,11 @@ static int cgen_type_convert_int_to_bool(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 	if (expl == cgen_implicit) {
 		/* Generate warning. */
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from '");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, "' to '_Bool'.\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "Implicit conversion from '");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' to '_Bool'.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -18453,22 +18454,19 @@ static int cgen_type_convert_int_ptr(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 	if (expl != cgen_explicit) {
 		if (ares->cvknown && ares->cvint == 0) {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Zero used as a null "
-			    "pointer constant.\n");
+			cgen_warning(cgexpr->cgen, &ctok->tok, "Zero used as a "
+			    "null pointer constant.");
 			++cgexpr->cgen->warnings;
 		} else {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Implicit conversion from "
-			    "integer to pointer.\n");
+			cgen_warning(cgexpr->cgen, &ctok->tok, "Implicit "
+			    "conversion from integer to pointer.");
 			++cgexpr->cgen->warnings;
 		}
 	}
 
 	if (bits != cgen_pointer_bits) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Converting to pointer from "
-		    "integer of different size.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Converting to pointer "
+		    "from integer of different size.");
 		++cgexpr->cgen->warnings;
 
 		rc = cgtype_basic_create(cgelm_uint, &tbasic);
@@ -18483,7 +18481,7 @@ static int cgen_type_convert_int_ptr(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 		cgtype_destroy(&tbasic->cgtype);
 		tbasic = NULL;
 
-		cres->varname = icres.varname;
+		cres->vref = icres.vref;
 		cres->valtype = icres.valtype;
 		cres->cgtype = cgtype;
 		cres->valused = icres.valused;
@@ -18495,7 +18493,7 @@ static int cgen_type_convert_int_ptr(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 		cgen_eres_fini(&icres);
 	} else {
-		cres->varname = ares->varname;
+		cres->vref = ares->vref;
 		cres->valtype = ares->valtype;
 		cres->cgtype = cgtype;
 		cres->valused = ares->valused;
@@ -18548,16 +18546,14 @@ static int cgen_type_convert_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	    (cgtype_basic_t *)dtype->ext);
 
 	if (expl != cgen_explicit) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Implicit conversion from "
-		    "pointer to integer.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Implicit conversion "
+		    "from pointer to integer.");
 		++cgexpr->cgen->warnings;
 	}
 
 	if (bits != cgen_pointer_bits) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Converting from pointer "
-		    "to integer of different size.\n");
+		cgen_warning(cgexpr->cgen, &ctok->tok, "Converting from "
+		    "pointer to integer of different size.");
 		++cgexpr->cgen->warnings;
 
 		rc = cgtype_basic_create(cgelm_uint, &tbasic);
@@ -18565,7 +18561,7 @@ static int cgen_type_convert_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 			goto error;
 
 		/* Pointer converted to unsigned int. */
-		icres.varname = ares->varname;
+		icres.vref = ares->vref;
 		icres.valtype = ares->valtype;
 		icres.cgtype = &tbasic->cgtype;
 		icres.valused = ares->valused;
@@ -18588,7 +18584,7 @@ static int cgen_type_convert_ptr_int(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 		if (rc != EOK)
 			goto error;
 
-		cres->varname = ares->varname;
+		cres->vref = ares->vref;
 		cres->valtype = ares->valtype;
 		cres->cgtype = cgtype;
 		cres->valused = ares->valused;
@@ -18715,11 +18711,12 @@ static int cgen_type_convert_rval(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 
 	if (dtype->ntype != cgn_basic ||
 	    ((cgtype_basic_t *)(dtype->ext))->elmtype != cgelm_int) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Converting to type ");
-		(void)cgtype_print(dtype, stderr);
-		(void)fprintf(stderr, " which is different from int "
-		    "(not implemented).\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Converting to type ");
+		(void)cgtype_print(dtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " which is different from "
+		    "int (not implemented).");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -18727,11 +18724,12 @@ static int cgen_type_convert_rval(cgen_expr_t *cgexpr, comp_tok_t *ctok,
 	if (ares->cgtype->ntype != cgn_basic ||
 	    (((cgtype_basic_t *)(ares->cgtype->ext))->elmtype != cgelm_int &&
 	    ((cgtype_basic_t *)(ares->cgtype->ext))->elmtype != cgelm_logic)) {
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Converting from type ");
-		(void)cgtype_print(ares->cgtype, stderr);
-		(void)fprintf(stderr, " which is different from int "
-		    "(not implemented).\n");
+		cgen_msg_begin(cgexpr->cgen, &ctok->tok, dsev_error);
+		(void)fprintf(cgexpr->cgen->msgf, "Converting from type ");
+		(void)cgtype_print(ares->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, " which is different from "
+		    "int (not implemented).");
+		cgen_msg_end(cgexpr->cgen);
 		cgexpr->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -19085,7 +19083,7 @@ static int cgen_int_notzero(cgen_expr_t *cgexpr, cgen_eres_t *ares,
 	ir_oper_var_t *dest = NULL;
 	ir_oper_var_t *larg = NULL;
 	ir_oper_var_t *rarg = NULL;
-	char *destvn;
+	cgen_vref_t destvr;
 	int rc;
 
 	cgen_eres_init(&ires);
@@ -19108,11 +19106,11 @@ static int cgen_int_notzero(cgen_expr_t *cgexpr, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &larg);
+	rc = cgen_vref_oper(&ares->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ires.varname, &rarg);
+	rc = cgen_vref_oper(&ires.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -19122,7 +19120,7 @@ static int cgen_int_notzero(cgen_expr_t *cgexpr, cgen_eres_t *ares,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -19131,7 +19129,7 @@ static int cgen_int_notzero(cgen_expr_t *cgexpr, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	cres->varname = destvn;
+	cres->vref = destvr;
 	cres->valtype = cgen_rvalue;
 	cres->cgtype = &dbtype->cgtype;
 
@@ -19280,9 +19278,8 @@ static int cgen_truth_eres_cjmp(cgen_expr_t *cgexpr, ast_tok_t *atok,
 		 * (float, double).
 		 */
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, " : Unimplemented variable type "
-		    "[truth_eres_cjmp].\n");
+		cgen_error(cgexpr->cgen, &tok->tok, "Unimplemented variable "
+		    "type [truth_eres_cjmp].");
 
 		cgexpr->cgen->error = true; // TODO
 		rc = EINVAL;
@@ -19293,10 +19290,11 @@ static int cgen_truth_eres_cjmp(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	    (((cgtype_basic_t *)cres->cgtype->ext)->elmtype != cgelm_logic &&
 	    ((cgtype_basic_t *)cres->cgtype->ext)->elmtype != cgelm_bool)) {
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: '");
-		(void)cgtype_print(cres->cgtype, stderr);
-		(void)fprintf(stderr, "' used as a truth value.\n");
+		cgen_msg_begin(cgexpr->cgen, &tok->tok, dsev_warning);
+		(void)fprintf(cgexpr->cgen->msgf, "'");
+		(void)cgtype_print(cres->cgtype, cgexpr->cgen->msgf);
+		(void)fprintf(cgexpr->cgen->msgf, "' used as a truth value.");
+		cgen_msg_end(cgexpr->cgen);
 		++cgexpr->cgen->warnings;
 	}
 
@@ -19306,7 +19304,7 @@ static int cgen_truth_eres_cjmp(cgen_expr_t *cgexpr, ast_tok_t *atok,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(cres->varname, &carg);
+	rc = cgen_vref_oper(&cres->vref, &carg);
 	if (rc != EOK)
 		goto error;
 
@@ -19398,9 +19396,8 @@ static int cgen_break(cgen_proc_t *cgproc, ast_break_t *abreak,
 
 	if (cgproc->cur_loop_switch == NULL) {
 		tok = (comp_tok_t *) abreak->tbreak.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Break without enclosing switch "
-		    "or loop statement.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Break without enclosing "
+		    "switch or loop statement.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -19451,9 +19448,8 @@ static int cgen_continue(cgen_proc_t *cgproc, ast_continue_t *acontinue,
 
 	if (cgproc->cur_loop == NULL) {
 		tok = (comp_tok_t *) acontinue->tcontinue.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Continue without enclosing loop "
-		    "statement.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Continue without "
+		    "enclosing loop statement.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -19566,11 +19562,11 @@ static int cgen_return_record(cgen_proc_t *cgproc, cgen_eres_t *ares,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create("%0", &larg);
+	rc = ir_oper_temp_create(0, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(ares->varname, &rarg);
+	rc = cgen_vref_oper(&ares->vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -19625,18 +19621,16 @@ static int cgen_return(cgen_proc_t *cgproc, ast_return_t *areturn,
 	if (areturn->arg != NULL && cgtype_is_void(cgproc->rtype)) {
 		atok = ast_tree_first_tok(areturn->arg);
 		ctok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Return with a value in "
-		    "function returning void.\n");
+		cgen_warning(cgproc->cgen, &ctok->tok, "Return with a value in "
+		    "function returning void.");
 		++cgproc->cgen->warnings;
 	}
 
 	/* Verify that function return type is void if do not have argument */
 	if (areturn->arg == NULL && !cgtype_is_void(cgproc->rtype)) {
 		ctok = (comp_tok_t *) areturn->treturn.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Return without a value in "
-		    "function returning non-void.\n");
+		cgen_warning(cgproc->cgen, &ctok->tok, "Return without a value "
+		    "in function returning non-void.");
 		++cgproc->cgen->warnings;
 	}
 
@@ -19692,7 +19686,7 @@ static int cgen_return(cgen_proc_t *cgproc, ast_return_t *areturn,
 			goto error;
 
 		if (bits > 0) {
-			rc = ir_oper_var_create(cres.varname, &arg);
+			rc = cgen_vref_oper(&cres.vref, &arg);
 			if (rc != EOK)
 				goto error;
 
@@ -20397,9 +20391,8 @@ static int cgen_switch(cgen_proc_t *cgproc, ast_switch_t *aswitch,
 	    eres.cgtype->ntype != cgn_enum) {
 		atok = ast_tree_first_tok(aswitch->sexpr);
 		tok = (comp_tok_t *)atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Switch expression does not "
-		    "have integer type.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Switch expression does "
+		    "not have integer type.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -20520,10 +20513,9 @@ static int cgen_switch(cgen_proc_t *cgproc, ast_switch_t *aswitch,
 			    &value);
 			if (rc != EOK) {
 				tok = (comp_tok_t *)aswitch->tswitch.data;
-				(void)lexer_dprint_tok(&tok->tok, stderr);
-				(void)fprintf(stderr, ": Warning: Enumeration "
-				    "value '%s' not handled in switch.\n",
-				    elem->ident);
+				cgen_warning(cgproc->cgen, &tok->tok,
+				    "Enumeration value '%s' not handled in "
+				    "switch.", elem->ident);
 				++cgproc->cgen->warnings;
 			}
 
@@ -20578,22 +20570,26 @@ static void cgen_clabel_check_integer(cgen_proc_t *cgproc, cgtype_t *stype,
 	case cgn_basic:
 		tbasic = (cgtype_basic_t *)ctype->ext;
 		if (tbasic->elmtype == cgelm_logic) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression "
-			    "has truth value, switch expression type is ");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, ".\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression has "
+			    "truth value, switch expression type is ");
+			(void)cgtype_print(stype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ".");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		}
 		break;
 	case cgn_enum:
 		if (cgtype_is_strict_enum(ctype)) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression is ");
-			(void)cgtype_print(ctype, stderr);
-			(void)fprintf(stderr, ", switch expression type is ");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, ".\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression "
+			    "is ");
+			(void)cgtype_print(ctype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ", switch expression "
+			    "type is ");
+			(void)cgtype_print(stype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ".");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		}
 		break;
@@ -20623,18 +20619,23 @@ static void cgen_clabel_check_logic(cgen_proc_t *cgproc, cgtype_t *ctype,
 		tbasic = (cgtype_basic_t *)ctype->ext;
 		if (tbasic->elmtype != cgelm_logic &&
 		    tbasic->elmtype != cgelm_bool) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression is ");
-			(void)cgtype_print(ctype, stderr);
-			(void)fprintf(stderr, ", switch expression has truth value.\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression "
+			    "is ");
+			(void)cgtype_print(ctype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ", switch expression "
+			    "has truth value.");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		}
 		break;
 	case cgn_enum:
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Case expression is ");
-		(void)cgtype_print(ctype, stderr);
-		(void)fprintf(stderr, ", switch expression has truth value.\n");
+		cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+		(void)fprintf(cgproc->cgen->msgf, "Case expression is ");
+		(void)cgtype_print(ctype, cgproc->cgen->msgf);
+		(void)fprintf(cgproc->cgen->msgf, ", switch expression has "
+		    "truth value.");
+		cgen_msg_end(cgproc->cgen);
 		++cgproc->cgen->warnings;
 		break;
 	default:
@@ -20664,19 +20665,23 @@ static void cgen_clabel_check_enum(cgen_proc_t *cgproc, cgtype_t *stype,
 	case cgn_basic:
 		tbasic = (cgtype_basic_t *)ctype->ext;
 		if (tbasic->elmtype == cgelm_logic) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression "
-			    "has truth value, switch expression type is ");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, ".\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression has "
+			    "truth value, switch expression type is ");
+			(void)cgtype_print(stype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ".");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		} else {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression is ");
-			(void)cgtype_print(ctype, stderr);
-			(void)fprintf(stderr, ", switch expression type is ");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, ".\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression "
+			    "is ");
+			(void)cgtype_print(ctype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ", switch expression "
+			    "type is ");
+			(void)cgtype_print(stype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ".");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		}
 		break;
@@ -20684,12 +20689,15 @@ static void cgen_clabel_check_enum(cgen_proc_t *cgproc, cgtype_t *stype,
 		senum = (cgtype_enum_t *)stype->ext;
 		cenum = (cgtype_enum_t *)ctype->ext;
 		if (senum->cgenum != cenum->cgenum) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Case expression is ");
-			(void)cgtype_print(ctype, stderr);
-			(void)fprintf(stderr, ", switch expression type is ");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, ".\n");
+			cgen_msg_begin(cgproc->cgen, &tok->tok, dsev_warning);
+			(void)fprintf(cgproc->cgen->msgf, "Case expression "
+			    "is ");
+			(void)cgtype_print(ctype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ", switch expression "
+			    "type is ");
+			(void)cgtype_print(stype, cgproc->cgen->msgf);
+			(void)fprintf(cgproc->cgen->msgf, ".");
+			cgen_msg_end(cgproc->cgen);
 			++cgproc->cgen->warnings;
 		}
 		break;
@@ -20725,7 +20733,7 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 	bool csigned;
 	unsigned lblno;
 	cgtype_elmtype_t elmtype;
-	char *destvn;
+	cgen_vref_t destvr;
 	bool converted;
 	cgen_switch_value_t *value;
 	int rc;
@@ -20737,9 +20745,8 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 	/* If there is no enclosing switch statement */
 	if (cgproc->cur_switch == NULL) {
 		tok = (comp_tok_t *) aclabel->tcase.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Case label without enclosing switch "
-		    "statement.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Case label without "
+		    "enclosing switch statement.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -20886,8 +20893,7 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 		/* Found existing value */
 		atok = ast_tree_first_tok(aclabel->cexpr);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Duplicate case value.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Duplicate case value.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -20914,11 +20920,11 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(cgproc->cur_switch->sres->varname, &larg);
+	rc = cgen_vref_oper(&cgproc->cur_switch->sres->vref, &larg);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(cres.varname, &rarg);
+	rc = cgen_vref_oper(&cres.vref, &rarg);
 	if (rc != EOK)
 		goto error;
 
@@ -20928,7 +20934,7 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 	instr->op1 = &larg->oper;
 	instr->op2 = &rarg->oper;
 
-	destvn = dest->varname;
+	cgen_vref_from_oper(dest, &destvr);
 	dest = NULL;
 	larg = NULL;
 	rarg = NULL;
@@ -20945,7 +20951,7 @@ static int cgen_clabel(cgen_proc_t *cgproc, ast_clabel_t *aclabel,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(destvn, &carg);
+	rc = cgen_vref_oper(&destvr, &carg);
 	if (rc != EOK)
 		goto error;
 
@@ -21021,9 +21027,8 @@ static int cgen_dlabel(cgen_proc_t *cgproc, ast_dlabel_t *adlabel,
 	/* If there is no enclosing switch statement */
 	if (cgproc->cur_switch == NULL) {
 		tok = (comp_tok_t *) adlabel->tdefault.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Default label without enclosing "
-		    "switch statement.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Default label without "
+		    "enclosing switch statement.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -21031,9 +21036,8 @@ static int cgen_dlabel(cgen_proc_t *cgproc, ast_dlabel_t *adlabel,
 
 	if (cgproc->cur_switch->dlabel != NULL) {
 		tok = (comp_tok_t *) adlabel->tdefault.data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Multiple default labels in "
-		    "switch statement.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Multiple default labels "
+		    "in switch statement.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -21080,8 +21084,7 @@ static int cgen_glabel(cgen_proc_t *cgproc, ast_glabel_t *aglabel,
 
 	rc = labels_define_label(cgproc->labels, &tok->tok);
 	if (rc == EEXIST) {
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Duplicate label '%s'.\n",
+		cgen_error(cgproc->cgen, &tok->tok, "Duplicate label '%s'.",
 		    tok->tok.text);
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
@@ -21194,8 +21197,8 @@ static int cgen_lvar(cgen_proc_t *cgproc, ast_sclass_type_t sctype,
 	int rc;
 
 	if (cgen_type_is_incomplete(cgproc->cgen, dtype)) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Variable has incomplete type.\n");
+		cgen_error(cgproc->cgen, &ident->tok, "Variable has incomplete "
+		    "type.");
 		cgproc->cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -21205,9 +21208,8 @@ static int cgen_lvar(cgen_proc_t *cgproc, ast_sclass_type_t sctype,
 	cgen_eres_init(&lres);
 
 	if (sctype != asc_none) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unimplemented storage class "
-		    "specifier.\n");
+		cgen_warning(cgproc->cgen, &ident->tok, "Unimplemented storage "
+		    "class specifier.");
 		++cgproc->cgen->warnings;
 		rc = EINVAL;
 		goto error;
@@ -21225,9 +21227,8 @@ static int cgen_lvar(cgen_proc_t *cgproc, ast_sclass_type_t sctype,
 	    dtype, false, vident);
 	if (rc != EOK) {
 		if (rc == EEXIST) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Duplicate identifier '%s'.\n",
-			    ident->tok.text);
+			cgen_error(cgproc->cgen, &ident->tok, "Duplicate "
+			    "identifier '%s'.", ident->tok.text);
 			cgproc->cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -21326,9 +21327,8 @@ static int cgen_stdecln_lvars(cgen_proc_t *cgproc, ast_stdecln_t *stdecln,
 	if (dsres->sctype != asc_none) {
 		atok = ast_tree_first_tok(&stdecln->dspecs->node);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Unimplemented storage class "
-		    "specifier.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Unimplemented storage "
+		    "class specifier.");
 		cgproc->cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -21351,9 +21351,8 @@ static int cgen_stdecln_lvars(cgen_proc_t *cgproc, ast_stdecln_t *stdecln,
 		/* Register assignment */
 		if (identry->regassign != NULL) {
 			tok = (comp_tok_t *) identry->regassign->tasm.data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Variable register assignment "
-			    "(unimplemented).\n");
+			cgen_error(cgproc->cgen, &tok->tok, "Variable register "
+			    "assignment (unimplemented).");
 			cgproc->cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -21363,9 +21362,8 @@ static int cgen_stdecln_lvars(cgen_proc_t *cgproc, ast_stdecln_t *stdecln,
 		if (identry->aslist != NULL) {
 			atok = ast_tree_first_tok(&stdecln->dspecs->node);
 			tok = (comp_tok_t *) atok->data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Attribute specifier "
-			    "(unimplemented).\n");
+			cgen_error(cgproc->cgen, &tok->tok, "Attribute "
+			    "specifier (unimplemented).");
 			cgproc->cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -21378,9 +21376,8 @@ static int cgen_stdecln_lvars(cgen_proc_t *cgproc, ast_stdecln_t *stdecln,
 		member = scope_lookup(cgproc->cgen->cur_scope->parent,
 		    ident->tok.text);
 		if (member != NULL) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Declaration of '%s' "
-			    "shadows a wider-scope declaration.\n",
+			cgen_warning(cgproc->cgen, &ident->tok, "Declaration "
+			    "of '%s' shadows a wider-scope declaration.",
 			    ident->tok.text);
 			++cgproc->cgen->warnings;
 		}
@@ -21540,11 +21537,11 @@ static int cgen_va_copy(cgen_proc_t *cgproc, ast_va_copy_t *stva_copy,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(dres.varname, &var1);
+	rc = cgen_vref_oper(&dres.vref, &var1);
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(sres.varname, &var2);
+	rc = cgen_vref_oper(&sres.vref, &var2);
 	if (rc != EOK)
 		goto error;
 
@@ -21607,7 +21604,7 @@ static int cgen_va_end(cgen_proc_t *cgproc, ast_va_end_t *va_end,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(apres.varname, &var);
+	rc = cgen_vref_oper(&apres.vref, &var);
 	if (rc != EOK)
 		goto error;
 
@@ -21657,9 +21654,8 @@ static int cgen_va_start(cgen_proc_t *cgproc, ast_va_start_t *stva_start,
 	if (cgproc->irproc->variadic != true) {
 		atok = &stva_start->tva_start;
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Use of __va_start in a function that "
-		    "does not take variable arguments.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Use of __va_start in a "
+		    "function that does not take variable arguments.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -21680,9 +21676,8 @@ static int cgen_va_start(cgen_proc_t *cgproc, ast_va_start_t *stva_start,
 	if (stva_start->lexpr->ntype != ant_eident) {
 		atok = ast_tree_first_tok(stva_start->lexpr);
 		tok = (comp_tok_t *)atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Expected identifier of last fixed "
-		    "parameter.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Expected identifier of "
+		    "last fixed parameter.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -21693,9 +21688,8 @@ static int cgen_va_start(cgen_proc_t *cgproc, ast_va_start_t *stva_start,
 
 	if (cgproc->last_arg == NULL ||
 	    strcmp(cgproc->last_arg, tok->tok.text) != 0) {
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Expected identifier of last fixed "
-		    "parameter.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "Expected identifier of "
+		    "last fixed parameter.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -21705,7 +21699,7 @@ static int cgen_va_start(cgen_proc_t *cgproc, ast_va_start_t *stva_start,
 	if (rc != EOK)
 		goto error;
 
-	rc = ir_oper_var_create(apres.varname, &var1);
+	rc = cgen_vref_oper(&apres.vref, &var1);
 	if (rc != EOK)
 		goto error;
 
@@ -21748,9 +21742,8 @@ static int cgen_stmt(cgen_proc_t *cgproc, ast_node_t *stmt,
 	case ant_asm:
 		atok = ast_tree_first_tok(stmt);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": This statement type is not "
-		    "implemented.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "This statement type is "
+		    "not implemented.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		break;
@@ -21804,9 +21797,8 @@ static int cgen_stmt(cgen_proc_t *cgproc, ast_node_t *stmt,
 	case ant_lmacro:
 		atok = ast_tree_first_tok(stmt);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": This statement type is not "
-		    "implemented.\n");
+		cgen_error(cgproc->cgen, &tok->tok, "This statement type is "
+		    "not implemented.");
 		cgproc->cgen->error = true; // TODO
 		rc = EINVAL;
 		break;
@@ -21895,8 +21887,7 @@ static int cgen_gn_block(cgen_proc_t *cgproc, ast_block_t *block,
 
 	tok = (comp_tok_t *) block->topen.data;
 
-	(void)lexer_dprint_tok(&tok->tok, stderr);
-	(void)fprintf(stderr, ": Warning: Gratuitous nested block.\n");
+	cgen_warning(cgproc->cgen, &tok->tok, "Gratuitous nested block.");
 	++cgproc->cgen->warnings;
 
 	return cgen_block(cgproc, block, lblock);
@@ -22157,9 +22148,8 @@ static int cgen_fun_args(cgen_t *cgen, comp_tok_t *ident, cgtype_t *ftype,
 		 * size, as long as the element type is complete.
 		 */
 		if (!cgen_type_is_complete_or_array(cgen, stype)) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Argument %u has incomplete "
-			    "type.\n", argidx);
+			cgen_error(cgen, &ident->tok, "Argument %u has "
+			    "incomplete type.", argidx);
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -22325,7 +22315,7 @@ static int cgen_fun_lvalue_args(cgen_proc_t *cgproc, comp_tok_t *ident,
 		aptype = NULL;
 
 		/* Argument value */
-		vres.varname = arg_ident;
+		cgen_vref_from_ident(arg_ident, &vres.vref);
 		vres.valtype = cgen_rvalue;
 		vres.cgtype = ptype;
 		ptype = NULL;
@@ -22551,9 +22541,8 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 	} else if (dsres->sctype != asc_none) {
 		atok = ast_tree_first_tok(&gdecln->dspecs->node);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unimplemented storage class "
-		    "specifier.\n");
+		cgen_warning(cgen, &tok->tok, "Unimplemented storage class "
+		    "specifier.");
 		++cgen->warnings;
 	}
 
@@ -22579,9 +22568,8 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 	} else {
 		if (symbol->stype != st_fun) {
 			/* Already declared as a different type of symbol */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": '%s' already declared as a "
-			    "different type of symbol.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "'%s' already declared "
+			    "as a different type of symbol.", ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -22589,8 +22577,7 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 
 		if ((symbol->flags & sf_defined) != sf_none) {
 			/* Already defined */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Redefinition of '%s'.\n",
+			cgen_error(cgen, &ident->tok, "Redefinition of '%s'.",
 			    ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
@@ -22601,18 +22588,16 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 		old_static = (symbol->flags & sf_static) != sf_none;
 		if (vstatic && !old_static) {
 			/* Static previously declared as non-static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Static '%s' was previously "
-			    "declared as non-static.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Static '%s' was "
+			    "previously declared as non-static.",
+			    ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
 		} else if (!vstatic && old_static) {
 			/* Non-static previously declared as static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: non-static '%s' was "
-			    "previously declared as static.\n",
-			    ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "non-static '%s' was "
+			    "previously declared as static.", ident->tok.text);
 			++cgen->warnings;
 		}
 
@@ -22623,16 +22608,14 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 		old_inline = (symbol->flags & sf_inline) != sf_none;
 		if (dsres->is_inline && !old_inline) {
 			/* Inline previously declared as non-inline */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Inline '%s' was previously "
-			    "declared as non-inline.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Inline '%s' was "
+			    "previously declared as non-inline.",
+			    ident->tok.text);
 			++cgen->warnings;
 		} else if (!dsres->is_inline && old_inline) {
 			/* Non-inline previously declared as inline */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: non-inline '%s' was "
-			    "previously declared as inline.\n",
-			    ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "non-inline '%s' was "
+			    "previously declared as inline.", ident->tok.text);
 			++cgen->warnings;
 
 			/*
@@ -22646,9 +22629,8 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 	if (vextern && !dsres->is_inline) {
 		atok = ast_tree_first_tok(&gdecln->dspecs->node);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Function definition "
-		    "should not use 'extern'.\n");
+		cgen_warning(cgen, &tok->tok, "Function definition should not "
+		    "use 'extern'.");
 		++cgen->warnings;
 	}
 
@@ -22672,13 +22654,14 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 	} else {
 		rc = cgtype_compose(symbol->cgtype, dtype, &ctype);
 		if (rc == EINVAL) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Conflicting type '");
-			(void)cgtype_print(dtype, stderr);
-			(void)fprintf(stderr, "' for '%s', previously "
+			cgen_msg_begin(cgen, &ident->tok, dsev_error);
+			(void)fprintf(cgen->msgf, "Conflicting type '");
+			(void)cgtype_print(dtype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "' for '%s', previously "
 			    "declared as '", ident->tok.text);
-			(void)cgtype_print(symbol->cgtype, stderr);
-			(void)fprintf(stderr, "'.\n");
+			(void)cgtype_print(symbol->cgtype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "'.");
+			cgen_msg_end(cgen);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -22761,8 +22744,7 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 	if (dfun == NULL) {
 		atok = ast_tree_first_tok(idle->decl);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Function declarator required.\n");
+		cgen_error(cgen, &tok->tok, "Function declarator required.");
 		cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -22779,9 +22761,8 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 			atok = ast_tree_first_tok(&arg->dspecs->node);
 
 			tok = (comp_tok_t *) atok->data;
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Argument identifier "
-			    "missing.\n");
+			cgen_error(cgen, &tok->tok, "Argument identifier "
+			    "missing.");
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -22790,18 +22771,16 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 		tok = (comp_tok_t *) dident->data;
 
 		if (arg->aslist != NULL) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Atribute specifier "
-			    "not implemented.\n");
+			cgen_warning(cgen, &tok->tok, "Atribute specifier not "
+			    "implemented.");
 			++cgen->warnings;
 		}
 
 		/* Check for shadowing a global-scope identifier */
 		member = scope_lookup(cgen->scope, tok->tok.text);
 		if (member != NULL) {
-			(void)lexer_dprint_tok(&tok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Declaration of '%s' "
-			    "shadows a wider-scope declaration.\n",
+			cgen_warning(cgen, &tok->tok, "Declaration of '%s' "
+			    "shadows a wider-scope declaration.",
 			    tok->tok.text);
 			++cgen->warnings;
 		}
@@ -22858,10 +22837,11 @@ static int cgen_fundef(cgen_t *cgen, ast_gdecln_t *gdecln,
 
 	/* Check return type for completeness */
 	if (cgen_type_is_incomplete(cgen, dtfunc->rtype)) {
-		(void)lexer_dprint_tok(&ident->tok, stderr);
-		(void)fprintf(stderr, ": Function returns incomplete type '");
-		(void)cgtype_print(dtfunc->rtype, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgen, &ident->tok, dsev_error);
+		(void)fprintf(cgen->msgf, "Function returns incomplete type '");
+		(void)cgtype_print(dtfunc->rtype, cgen->msgf);
+		(void)fprintf(cgen->msgf, "'.");
+		cgen_msg_end(cgen);
 		cgen->error = true; // TODO
 		rc = EINVAL;
 		goto error;
@@ -22997,19 +22977,16 @@ static int cgen_typedef(cgen_t *cgen, ast_tok_t *dtok, ast_idlist_t *idlist,
 
 		/* Non-global scope? */
 		if (cgen->cur_scope->parent != NULL) {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Type definition in a "
-			    "non-global scope.\n");
+			cgen_warning(cgen, &ctok->tok, "Type definition in a "
+			    "non-global scope.");
 			++cgen->warnings;
 
 			/* Check for shadowing a wider-scope identifier */
 			member = scope_lookup(cgen->cur_scope->parent,
 			    ctok->tok.text);
 			if (member != NULL) {
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr, ": Warning: Declaration "
-				    "of '%s' shadows a wider-scope "
-				    "declaration.\n",
+				cgen_warning(cgen, &ctok->tok, "Declaration of "
+				    "'%s' shadows a wider-scope declaration.",
 				    ctok->tok.text);
 				++cgen->warnings;
 			}
@@ -23019,9 +22996,8 @@ static int cgen_typedef(cgen_t *cgen, ast_tok_t *dtok, ast_idlist_t *idlist,
 		rc = scope_insert_tdef(cgen->cur_scope, &ctok->tok, dtype);
 		if (rc != EOK) {
 			if (rc == EEXIST) {
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr, ": Duplicate identifier "
-				    "'%s'.\n", ctok->tok.text);
+				cgen_error(cgen, &ctok->tok, "Duplicate "
+				    "identifier '%s'.", ctok->tok.text);
 				cgen->error = true; // XXX
 				rc = EINVAL;
 				goto error;
@@ -23039,8 +23015,7 @@ static int cgen_typedef(cgen_t *cgen, ast_tok_t *dtok, ast_idlist_t *idlist,
 	if (idle != NULL) {
 		/* This means we have a dnoident followed by comma */
 		ctok = (comp_tok_t *)idle->tcomma.data;
-		(void)lexer_dprint_tok(&ctok->tok, stderr);
-		(void)fprintf(stderr, ": Declarator expected before ','.\n");
+		cgen_error(cgen, &ctok->tok, "Declarator expected before ','.");
 		cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -23094,9 +23069,8 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 	} else if (dsres->sctype != asc_none) {
 		atok = ast_tree_first_tok(&gdecln->dspecs->node);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unimplemented storage class "
-		    "specifier.\n");
+		cgen_warning(cgen, &tok->tok, "Unimplemented storage class "
+		    "specifier.");
 		++cgen->warnings;
 	}
 
@@ -23147,9 +23121,8 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 	} else {
 		if (symbol->stype != st_fun) {
 			/* Already declared as a different type of symbol */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": '%s' already declared as a "
-			    "different type of symbol.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "'%s' already declared "
+			    "as a different type of symbol.", ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -23158,13 +23131,14 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 		/* Create composite type */
 		rc = cgtype_compose(symbol->cgtype, ftype, &ctype);
 		if (rc == EINVAL) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Conflicting type '");
-			(void)cgtype_print(ftype, stderr);
-			(void)fprintf(stderr, "' for '%s', previously "
+			cgen_msg_begin(cgen, &ident->tok, dsev_error);
+			(void)fprintf(cgen->msgf, "Conflicting type '");
+			(void)cgtype_print(ftype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "' for '%s', previously "
 			    "declared as '", ident->tok.text);
-			(void)cgtype_print(symbol->cgtype, stderr);
-			(void)fprintf(stderr, "'.\n");
+			(void)cgtype_print(symbol->cgtype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "'.");
+			cgen_msg_end(cgen);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -23176,14 +23150,12 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 		symbol->cgtype = ctype;
 
 		if ((symbol->flags & sf_defined) != sf_none) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Declaration of '%s' "
-			    "follows definition.\n", ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "Declaration of '%s' "
+			    "follows definition.", ident->tok.text);
 			++cgen->warnings;
 		} else {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Multiple "
-			    "declarations of '%s'.\n", ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "Multiple declarations "
+			    "of '%s'.", ident->tok.text);
 			++cgen->warnings;
 		}
 
@@ -23191,18 +23163,16 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 		old_static = (symbol->flags & sf_static) != sf_none;
 		if (vstatic && !old_static) {
 			/* Non-static previously declared as static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Static '%s' was previously "
-			    "declared as non-static.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Static '%s' was "
+			    "previously declared as non-static.",
+			    ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
 		} else if (!vstatic && old_static) {
 			/* Non-static previously declared as static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: non-static '%s' was "
-			    "previously declared as static.\n",
-			    ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "non-static '%s' was "
+			    "previously declared as static.", ident->tok.text);
 			++cgen->warnings;
 		}
 
@@ -23210,17 +23180,14 @@ static int cgen_fundecl(cgen_t *cgen, cgtype_t *ftype, cgen_dspec_res_t *dsres,
 		old_extern = (symbol->flags & sf_extern) != sf_none;
 		if (vextern && !old_extern) {
 			/* Non-extern previously declared as extern */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Extern '%s' was "
-			    "previously declared as non-extern.\n",
+			cgen_warning(cgen, &ident->tok, "Extern '%s' was "
+			    "previously declared as non-extern.",
 			    ident->tok.text);
 			++cgen->warnings;
 		} else if (!vextern && old_extern) {
 			/* Non-extern previously declared as extern */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: non-extern '%s' was "
-			    "previously declared as extern.\n",
-			    ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "non-extern '%s' was "
+			    "previously declared as extern.", ident->tok.text);
 			++cgen->warnings;
 		}
 	}
@@ -23417,13 +23384,13 @@ static void cgen_check_index_type(cgen_t *cgen, comp_tok_t *tok,
 	 * but not the same.
 	 */
 	if (actual_enum != expected_enum) {
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Array designator is of "
-		    "type '");
-		(void)cgtype_print(actual, stderr);
-		(void)fprintf(stderr, "', but array index should be '");
-		(void)cgtype_print(expected, stderr);
-		(void)fprintf(stderr, "'.\n");
+		cgen_msg_begin(cgen, &tok->tok, dsev_warning);
+		(void)fprintf(cgen->msgf, "Array designator is of type '");
+		(void)cgtype_print(actual, cgen->msgf);
+		(void)fprintf(cgen->msgf, "', but array index should be '");
+		(void)cgtype_print(expected, cgen->msgf);
+		(void)fprintf(cgen->msgf, "'.");
+		cgen_msg_end(cgen);
 		++cgen->warnings;
 	}
 }
@@ -23474,9 +23441,8 @@ static int cgen_init_lookup(cgen_t *cgen, cgen_init_t *parent, cgtype_t *cgtype,
 					rc = EDOM;
 					goto error;
 				}
-				(void)lexer_dprint_tok(&tassign->tok, stderr);
-				(void)fprintf(stderr, ": Array index in "
-				    "non-array initializer.\n");
+				cgen_error(cgen, &tassign->tok, "Array index "
+				    "in non-array initializer.");
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -23504,9 +23470,8 @@ static int cgen_init_lookup(cgen_t *cgen, cgen_init_t *parent, cgtype_t *cgtype,
 			cgen_eres_init(&eres);
 			if (dsg < 0 || (tarray->have_size &&
 			    dsg >= (int64_t)tarray->asize)) {
-				(void)lexer_dprint_tok(&tassign->tok, stderr);
-				(void)fprintf(stderr, ": Array index exceeds "
-				    "array bounds.\n");
+				cgen_error(cgen, &tassign->tok, "Array index "
+				    "exceeds array bounds.");
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -23527,9 +23492,8 @@ static int cgen_init_lookup(cgen_t *cgen, cgen_init_t *parent, cgtype_t *cgtype,
 					rc = EDOM;
 					goto error;
 				}
-				(void)lexer_dprint_tok(&tassign->tok, stderr);
-				(void)fprintf(stderr, ": Member access in "
-				    "non-record initializer.\n");
+				cgen_error(cgen, &tassign->tok, "Member access "
+				    "in non-record initializer.");
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -23544,11 +23508,12 @@ static int cgen_init_lookup(cgen_t *cgen, cgen_init_t *parent, cgtype_t *cgtype,
 					rc = EDOM;
 					goto error;
 				}
-				(void)lexer_dprint_tok(&tassign->tok, stderr);
-				(void)fprintf(stderr, ": Record type ");
-				(void)cgtype_print(cgtype, stderr);
-				(void)fprintf(stderr, " has no member named "
-				    "'%s'.\n", ctok->tok.text);
+				cgen_msg_begin(cgen, &tassign->tok, dsev_error);
+				(void)fprintf(cgen->msgf, "Record type ");
+				(void)cgtype_print(cgtype, cgen->msgf);
+				(void)fprintf(cgen->msgf, " has no member "
+				    "named '%s'.", ctok->tok.text);
+				cgen_msg_end(cgen);
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -24146,9 +24111,8 @@ static int cgen_init_dentries_scalar(cgen_t *cgen, cgtype_t *stype,
 			cinit = (ast_cinit_t *)init->ext;
 
 			ctok = (comp_tok_t *)cinit->tlbrace.data;
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Excess braces around "
-			    "scalar initializer.\n");
+			cgen_warning(cgen, &ctok->tok, "Excess braces around "
+			    "scalar initializer.");
 			++cgen->warnings;
 
 			elem = ast_cinit_first(cinit);
@@ -24162,9 +24126,8 @@ static int cgen_init_dentries_scalar(cgen_t *cgen, cgtype_t *stype,
 			if (elem != NULL) {
 				atok = ast_tree_first_tok(elem->init);
 				ctok = (comp_tok_t *)atok->data;
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr,
-				    ": Excess initializer.\n'");
+				cgen_error(cgen, &ctok->tok, "Excess "
+				    "initializer.");
 				cgen->error = true; // XXX
 				return EINVAL;
 			}
@@ -24207,8 +24170,8 @@ static int cgen_init_dentries_scalar(cgen_t *cgen, cgtype_t *stype,
 		}
 
 		if (initsym != NULL) {
-			(void)lexer_dprint_tok(&itok->tok, stderr);
-			(void)fprintf(stderr, ": Expression is not constant.\n");
+			cgen_error(cgen, &itok->tok, "Expression is not "
+			    "constant.");
 
 			cgen->error = true; // TODO
 			rc = EINVAL;
@@ -24452,9 +24415,8 @@ static int cgen_init_dentries_cinit(cgen_t *cgen, cgtype_t *stype,
 			if (melem != NULL) {
 				atok = ast_tree_first_tok(melem->init);
 				ctok = (comp_tok_t *)atok->data;
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr,
-				    ": Excess initializer.\n'");
+				cgen_error(cgen, &ctok->tok, "Excess "
+				    "initializer.");
 				cgen->error = true; // XXX
 				return EINVAL;
 			}
@@ -24463,9 +24425,8 @@ static int cgen_init_dentries_cinit(cgen_t *cgen, cgtype_t *stype,
 			if (*elem != NULL) {
 				atok = ast_tree_first_tok((*elem)->init);
 				ctok = (comp_tok_t *)atok->data;
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr, ": Warning: "
-				    "Initialization is not fully bracketed.\n");
+				cgen_warning(cgen, &ctok->tok, "Initialization "
+				    "is not fully bracketed.");
 				++cgen->warnings;
 			}
 
@@ -24576,19 +24537,21 @@ static int cgen_init_dentries_string(cgen_t *cgen, cgtype_t *stype,
 		rrank = wide ? cgir_int : cgir_char;
 
 		if (cgtype_int_rank(tarray->etype) != rrank) {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Cannot initialize array of ");
-			(void)cgtype_print(tarray->etype, stderr);
-			(void)fprintf(stderr, " from %s.\n", wide ?
-			    "wide string" : "string");
+			cgen_msg_begin(cgen, &ctok->tok, dsev_error);
+			(void)fprintf(cgen->msgf, "Cannot initialize array "
+			    "of ");
+			(void)cgtype_print(tarray->etype, cgen->msgf);
+			(void)fprintf(cgen->msgf, " from %s.",
+			    wide ? "wide string" : "string");
+			cgen_msg_end(cgen);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
 		}
 
 		if (*text != '"') {
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": String constant expected.\n");
+			cgen_error(cgen, &ctok->tok, "String constant "
+			    "expected.");
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -24598,9 +24561,8 @@ static int cgen_init_dentries_string(cgen_t *cgen, cgtype_t *stype,
 
 		while (*text != '"') {
 			if (*text == '\0') {
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr, ": Unexpected end of "
-				    "string literal.\n'");
+				cgen_error(cgen, &ctok->tok, "Unexpected end "
+				    "of string literal.");
 				cgen->error = true; // XXX
 				rc = EINVAL;
 				goto error;
@@ -24617,9 +24579,8 @@ static int cgen_init_dentries_string(cgen_t *cgen, cgtype_t *stype,
 			}
 
 			if (tarray->have_size && idx >= tarray->asize) {
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr, ": Excess initializer "
-				    "characters in string.\n");
+				cgen_error(cgen, &ctok->tok, "Excess "
+				    "initializer characters in string.");
 				cgen->error = true; // XXX
 				rc = EINVAL;
 				goto error;
@@ -24732,9 +24693,8 @@ static int cgen_init_dentries(cgen_t *cgen, cgtype_t *stype, comp_tok_t *itok,
 			if (celem != NULL) {
 				atok = ast_tree_first_tok(celem->init);
 				ctok = (comp_tok_t *)atok->data;
-				(void)lexer_dprint_tok(&ctok->tok, stderr);
-				(void)fprintf(stderr,
-				    ": Excess initializer.\n'");
+				cgen_error(cgen, &ctok->tok, "Excess "
+				    "initializer.");
 				cgen->error = true; // XXX
 				return EINVAL;
 			}
@@ -24746,8 +24706,7 @@ static int cgen_init_dentries(cgen_t *cgen, cgtype_t *stype, comp_tok_t *itok,
 		} else {
 			atok = ast_tree_first_tok(init);
 			ctok = (comp_tok_t *)atok->data;
-			(void)lexer_dprint_tok(&ctok->tok, stderr);
-			(void)fprintf(stderr, ": Invalid initializer.\n'");
+			cgen_error(cgen, &ctok->tok, "Invalid initializer.");
 			cgen->error = true; // XXX
 			return EINVAL;
 		}
@@ -24812,9 +24771,8 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 	} else if (sctype != asc_none) {
 		atok = ast_tree_first_tok(&gdecln->dspecs->node);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": Warning: Unimplemented storage class "
-		    "specifier.\n");
+		cgen_warning(cgen, &tok->tok, "Unimplemented storage class "
+		    "specifier.");
 		++cgen->warnings;
 	}
 
@@ -24847,9 +24805,8 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 	} else {
 		if (symbol->stype != st_var) {
 			/* Already declared as a different type of symbol */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": '%s' already declared as a "
-			    "different type of symbol.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "'%s' already declared "
+			    "as a different type of symbol.", ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -24857,13 +24814,14 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 
 		rc = cgtype_compose(symbol->cgtype, stype, &ctype);
 		if (rc == EINVAL) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Conflicting type '");
-			(void)cgtype_print(stype, stderr);
-			(void)fprintf(stderr, "' for '%s', previously "
+			cgen_msg_begin(cgen, &ident->tok, dsev_error);
+			(void)fprintf(cgen->msgf, "Conflicting type '");
+			(void)cgtype_print(stype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "' for '%s', previously "
 			    "declared as '", ident->tok.text);
-			(void)cgtype_print(symbol->cgtype, stderr);
-			(void)fprintf(stderr, "'.\n");
+			(void)cgtype_print(symbol->cgtype, cgen->msgf);
+			(void)fprintf(cgen->msgf, "'.");
+			cgen_msg_end(cgen);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
@@ -24874,8 +24832,7 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 		if ((symbol->flags & sf_defined) != sf_none &&
 		    entry->init != NULL) {
 			/* Already defined */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Redefinition of '%s'.\n",
+			cgen_error(cgen, &ident->tok, "Redefinition of '%s'.",
 			    ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
@@ -24885,14 +24842,12 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 		old_extern = (symbol->flags & sf_extern) != sf_none;
 
 		if ((symbol->flags & sf_defined) != sf_none) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Declaration of '%s' "
-			    "follows definition.\n", ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "Declaration of '%s' "
+			    "follows definition.", ident->tok.text);
 			++cgen->warnings;
 		} else if (entry->init == NULL && !old_extern) {
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Multiple "
-			    "declarations of '%s'.\n", ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "Multiple declarations "
+			    "of '%s'.", ident->tok.text);
 			++cgen->warnings;
 		} else {
 			/* Symbol should be member of module scope */
@@ -24906,10 +24861,9 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 			 * that an extern declaration is in a header file.
 			 */
 			if (!member->used && !old_extern) {
-				(void)lexer_dprint_tok(&ident->tok, stderr);
-				(void)fprintf(stderr, ": Warning: "
-				    "Variable '%s' not used since forward "
-				    "declaration.\n", ident->tok.text);
+				cgen_warning(cgen, &ident->tok, "Variable '%s' "
+				    "not used since forward declaration.",
+				    ident->tok.text);
 				++cgen->warnings;
 			}
 		}
@@ -24918,18 +24872,16 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 		old_static = (symbol->flags & sf_static) != sf_none;
 		if (vstatic && !old_static) {
 			/* Non-static previously declared as static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Static '%s' was previously "
-			    "declared as non-static.\n", ident->tok.text);
+			cgen_error(cgen, &ident->tok, "Static '%s' was "
+			    "previously declared as non-static.",
+			    ident->tok.text);
 			cgen->error = true; // XXX
 			rc = EINVAL;
 			goto error;
 		} else if (!vstatic && old_static) {
 			/* Non-static previously declared as static */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: non-static '%s' was "
-			    "previously declared as static.\n",
-			    ident->tok.text);
+			cgen_warning(cgen, &ident->tok, "non-static '%s' was "
+			    "previously declared as static.", ident->tok.text);
 			++cgen->warnings;
 		}
 
@@ -24939,9 +24891,8 @@ static int cgen_vardef(cgen_t *cgen, cgtype_t *stype, ast_sclass_type_t sctype,
 		 */
 		if (vextern && !old_extern) {
 			/* Non-extern previously declared as extern */
-			(void)lexer_dprint_tok(&ident->tok, stderr);
-			(void)fprintf(stderr, ": Warning: Extern '%s' was "
-			    "previously declared as non-extern.\n",
+			cgen_warning(cgen, &ident->tok, "Extern '%s' was "
+			    "previously declared as non-extern.",
 			    ident->tok.text);
 			++cgen->warnings;
 		} else if (!vextern && old_extern) {
@@ -25087,9 +25038,8 @@ static int cgen_gdecln(cgen_t *cgen, ast_gdecln_t *gdecln)
 				if (entry->have_init) {
 					tok = (comp_tok_t *)
 					    entry->tassign.data;
-					(void)lexer_dprint_tok(&tok->tok, stderr);
-					(void)fprintf(stderr, ": Unexpected "
-					    "initializer.\n");
+					cgen_error(cgen, &tok->tok,
+					    "Unexpected initializer.");
 					cgen->error = true; // XXX
 					rc = EINVAL;
 					goto error;
@@ -25103,18 +25053,28 @@ static int cgen_gdecln(cgen_t *cgen, ast_gdecln_t *gdecln)
 					if ((dsres.rdflags & cgrd_prevdef) != cgrd_none) {
 						atok = ast_tree_first_tok(&gdecln->dspecs->node);
 						tok = (comp_tok_t *) atok->data;
-						(void)lexer_dprint_tok(&tok->tok, stderr);
-						(void)fprintf(stderr, ": Warning: Declaration of '");
-						(void)cgtype_print(dsres.stype, stderr);
-						(void)fprintf(stderr, "' follows definition.\n");
+						cgen_msg_begin(cgen, &tok->tok,
+						    dsev_warning);
+						(void)fprintf(cgen->msgf,
+						    "Declaration of '");
+						(void)cgtype_print(dsres.stype,
+						    cgen->msgf);
+						(void)fprintf(cgen->msgf, "' "
+						    "follows definition.");
+						cgen_msg_end(cgen);
 						++cgen->warnings;
 					} else if ((dsres.rdflags & cgrd_prevdecl) != cgrd_none) {
 						atok = ast_tree_first_tok(&gdecln->dspecs->node);
 						tok = (comp_tok_t *) atok->data;
-						(void)lexer_dprint_tok(&tok->tok, stderr);
-						(void)fprintf(stderr, ": Warning: Multiple declarations of '");
-						(void)cgtype_print(dsres.stype, stderr);
-						(void)fprintf(stderr, "'.\n");
+						cgen_msg_begin(cgen, &tok->tok,
+						    dsev_warning);
+						(void)fprintf(cgen->msgf,
+						    "Multiple declarations of "
+						    "'");
+						(void)cgtype_print(dsres.stype,
+						    cgen->msgf);
+						(void)fprintf(cgen->msgf, "'.");
+						cgen_msg_end(cgen);
 						++cgen->warnings;
 					}
 					if (dtype->ntype == cgn_record) {
@@ -25169,9 +25129,8 @@ static int cgen_global_decln(cgen_t *cgen, ast_node_t *decln)
 	case ant_externc:
 		atok = ast_tree_first_tok(decln);
 		tok = (comp_tok_t *) atok->data;
-		(void)lexer_dprint_tok(&tok->tok, stderr);
-		(void)fprintf(stderr, ": This declaration type is not "
-		    "implemented.\n");
+		cgen_error(cgen, &tok->tok, "This declaration type is not "
+		    "implemented.");
 		rc = EINVAL;
 		break;
 	default:
@@ -25202,9 +25161,9 @@ static int cgen_module_symdecl_fun(cgen_t *cgen, symbol_t *symbol)
 	if ((symbol->flags & sf_inline) != sf_none &&
 	    (symbol->flags & sf_static) == sf_none) {
 		/* Static previously declared as non-static */
-		(void)lexer_dprint_tok(&symbol->ident->tok, stderr);
-		(void)fprintf(stderr, ": Inline function '%s' has external "
-		    "linkage, but is not defined.\n", symbol->ident->tok.text);
+		cgen_error(cgen, &symbol->ident->tok, "Inline function '%s' "
+		    "has external linkage, but is not defined.",
+		    symbol->ident->tok.text);
 		cgen->error = true; // XXX
 		rc = EINVAL;
 		goto error;
@@ -25264,8 +25223,8 @@ static int cgen_module_symdecl_var(cgen_t *cgen, symbol_t *symbol)
 	unsigned i;
 
 	if (cgen_type_is_incomplete(cgen, cgtype)) {
-		(void)lexer_dprint_tok(&symbol->ident->tok, stderr);
-		(void)fprintf(stderr, ": Variable has incomplete type.\n");
+		cgen_error(cgen, &symbol->ident->tok, "Variable has incomplete "
+		    "type.");
 		cgen->error = true; // TODO
 		return EINVAL;
 	}
@@ -25314,9 +25273,8 @@ static int cgen_module_symdecl_var(cgen_t *cgen, symbol_t *symbol)
 			    (cgtype_basic_t *)cgtype->ext);
 
 			if (bits == 0) {
-				(void)lexer_dprint_tok(&symbol->ident->tok, stderr);
-				(void)fprintf(stderr,
-				    ": Unimplemented variable type.XXX\n");
+				cgen_error(cgen, &symbol->ident->tok,
+				    "Unimplemented variable type.XXX");
 				cgen->error = true; // TODO
 				rc = EINVAL;
 				goto error;
@@ -25350,9 +25308,8 @@ static int cgen_module_symdecl_var(cgen_t *cgen, symbol_t *symbol)
 			if (rc != EOK)
 				goto error;
 		} else {
-			(void)lexer_dprint_tok(&symbol->ident->tok, stderr);
-			(void)fprintf(stderr,
-			    ": Unimplemented variable type.\n");
+			cgen_error(cgen, &symbol->ident->tok, "Unimplemented "
+			    "variable type.");
 			cgen->error = true; // TODO
 			rc = EINVAL;
 			goto error;
@@ -25407,6 +25364,35 @@ error:
 	return rc;
 }
 
+/** Generate IR definitions of records that are already defined.
+ *
+ * Records can be defined before processing the module starts
+ * if they have been loaded from a precompiled header.
+ *
+ * @param cgen Code generator
+ * @return EOK on success or an error code
+ */
+static int cgen_module_records(cgen_t *cgen)
+{
+	cgen_record_t *record;
+	int rc;
+
+	record = cgen_records_first(cgen->records);
+	while (record != NULL) {
+		if (record->irrecord != NULL) {
+			rc = cgen_record(cgen, record);
+			if (rc != EOK)
+				return rc;
+
+			ir_module_append(cgen->irmod, &record->irrecord->decln);
+		}
+
+		record = cgen_records_next(record);
+	}
+
+	return EOK;
+}
+
 /** Generate code for module.
  *
  * @param cgen Code generator
@@ -25441,6 +25427,10 @@ int cgen_module(cgen_t *cgen, parser_input_ops_t *inops, void *inarg,
 
 	cgen->irmod = irmod;
 
+	rc = cgen_module_records(cgen);
+	if (rc != EOK)
+		goto error;
+
 	rc = parser_process_module(parser, &amod);
 	if (rc != EOK)
 		goto error;
@@ -25478,6 +25468,7 @@ void cgen_destroy(cgen_t *cgen)
 	cgen_enums_destroy(cgen->enums);
 	scope_destroy(cgen->scope);
 	cgen_records_destroy(cgen->records);
+	(void)fclose(cgen->msgf);
 	free(cgen);
 }
 
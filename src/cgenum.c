@@ -24,6 +24,7 @@
  * Code generator enum definitions
  */
 
+#include <adt/hmap.h>
 #include <cgenum.h>
 #include <cgtype.h>
 #include <merrno.h>
@@ -47,6 +48,7 @@ int cgen_enums_create(cgen_enums_t **renums)
 		return ENOMEM;
 
 	list_initialize(&enums->enums);
+	hmap_initialize(&enums->byname, hmk_str);
 	*renums = enums;
 	return EOK;
 }
@@ -62,6 +64,9 @@ void cgen_enums_destroy(cgen_enums_t *enums)
 	if (enums == NULL)
 		return;
 
+	/* No need to maintain the index while destroying everything */
+	hmap_fini(&enums->byname);
+
 	cgenum = cgen_enums_first(enums);
 	while (cgenum != NULL) {
 		cgen_enum_destroy(cgenum);
@@ -96,7 +101,16 @@ int cgen_enum_create(cgen_enums_t *enums, const char *cident,
 			goto error;
 	}
 
+	if (cgenum->cident != NULL) {
+		/* If the identifier is already present, keep the first enum */
+		if (hmap_insert_str(&enums->byname, cgenum->cident,
+		    cgenum) == ENOMEM)
+			goto error;
+	}
+
 	list_initialize(&cgenum->elems);
+	hmap_initialize(&cgenum->elem_byname, hmk_str);
+	hmap_initialize(&cgenum->elem_byval, hmk_int);
 
 	cgenum->enums = enums;
 	list_append(&cgenum->lenums, &cgenum->enums->enums);
@@ -117,18 +131,38 @@ error:
  */
 cgen_enum_t *cgen_enums_find(cgen_enums_t *enums, const char *ident)
 {
-	cgen_enum_t *cgenum;
+	return (cgen_enum_t *)hmap_find_str(&enums->byname, ident);
+}
 
-	cgenum = cgen_enums_first(enums);
-	while (cgenum != NULL) {
-		if (cgenum->cident != NULL &&
-		    strcmp(cgenum->cident, ident) == 0)
-			return cgenum;
+/** Remove enum definition from the index of its enums list.
+ *
+ * If another enum with the same identifier exists, it takes
+ * the place of the removed one.
+ *
+ * @param cgenum Enum definition
+ */
+static void cgen_enum_unindex(cgen_enum_t *cgenum)
+{
+	cgen_enums_t *enums = cgenum->enums;
+	cgen_enum_t *e;
 
-		cgenum = cgen_enums_next(cgenum);
-	}
+	if (cgenum->cident == NULL ||
+	    (cgen_enum_t *)hmap_find_str(&enums->byname,
+	    cgenum->cident) != cgenum)
+		return;
+
+	hmap_remove_str(&enums->byname, cgenum->cident);
 
-	return NULL;
+	e = cgen_enums_next(cgenum);
+	while (e != NULL) {
+		if (e->cident != NULL &&
+		    strcmp(e->cident, cgenum->cident) == 0) {
+			(void)hmap_insert_str(&enums->byname, e->cident, e);
+			break;
+		}
+
+		e = cgen_enums_next(e);
+	}
 }
 
 /** Destroy enum definition.
@@ -139,8 +173,12 @@ void cgen_enum_destroy(cgen_enum_t *cgenum)
 {
 	cgen_enum_elem_t *elem;
 
+	cgen_enum_unindex(cgenum);
 	list_remove(&cgenum->lenums);
 
+	hmap_fini(&cgenum->elem_byname);
+	hmap_fini(&cgenum->elem_byval);
+
 	elem = cgen_enum_first(cgenum);
 	while (elem != NULL) {
 		cgen_enum_elem_destroy(elem);
@@ -199,6 +237,7 @@ int cgen_enum_append(cgen_enum_t *cgenum, const char *ident, int64_t value,
     cgen_enum_elem_t **relem)
 {
 	cgen_enum_elem_t *elem;
+	int rc;
 
 	elem = cgen_enum_elem_find(cgenum, ident);
 	if (elem != NULL)
@@ -217,10 +256,25 @@ int cgen_enum_append(cgen_enum_t *cgenum, const char *ident, int64_t value,
 
 	elem->value = value;
 
+	rc = hmap_insert_str(&cgenum->elem_byname, elem->ident, elem);
+	if (rc != EOK)
+		goto error;
+
+	/* If another element has the same value, it stays first */
+	rc = hmap_insert_int(&cgenum->elem_byval, value, elem);
+	if (rc == ENOMEM) {
+		hmap_remove_str(&cgenum->elem_byname, elem->ident);
+		goto error;
+	}
+
 	list_append(&elem->lelems, &cgenum->elems);
 	if (relem != NULL)
 		*relem = elem;
 	return EOK;
+error:
+	free(elem->ident);
+	free(elem);
+	return ENOMEM;
 }
 
 /** Look up enum element by identifier.
@@ -232,17 +286,7 @@ int cgen_enum_append(cgen_enum_t *cgenum, const char *ident, int64_t value,
 cgen_enum_elem_t *cgen_enum_elem_find(cgen_enum_t *cgenum,
     const char *ident)
 {
-	cgen_enum_elem_t *elem;
-
-	elem = cgen_enum_first(cgenum);
-	while (elem != NULL) {
-		if (strcmp(elem->ident, ident) == 0)
-			return elem;
-
-		elem = cgen_enum_next(elem);
-	}
-
-	return NULL;
+	return (cgen_enum_elem_t *)hmap_find_str(&cgenum->elem_byname, ident);
 }
 
 /** Look up enum element by value.
@@ -253,17 +297,7 @@ cgen_enum_elem_t *cgen_enum_elem_find(cgen_enum_t *cgenum,
  */
 cgen_enum_elem_t *cgen_enum_val_find(cgen_enum_t *cgenum, int64_t val)
 {
-	cgen_enum_elem_t *elem;
-
-	elem = cgen_enum_first(cgenum);
-	while (elem != NULL) {
-		if (elem->value == val)
-			return elem;
-
-		elem = cgen_enum_next(elem);
-	}
-
-	return NULL;
+	return (cgen_enum_elem_t *)hmap_find_int(&cgenum->elem_byval, val);
 }
 
 /** Get the maximum value of any enum element.
@@ -24,6 +24,7 @@
  * Code generator record definitions
  */
 
+#include <adt/hmap.h>
 #include <cgrec.h>
 #include <cgtype.h>
 #include <ir.h>
@@ -49,6 +50,7 @@ int cgen_records_create(cgen_records_t **rrecords)
 		return ENOMEM;
 
 	list_initialize(&records->records);
+	hmap_initialize(&records->byname, hmk_str);
 	*rrecords = records;
 	return EOK;
 }
@@ -64,6 +66,9 @@ void cgen_records_destroy(cgen_records_t *records)
 	if (records == NULL)
 		return;
 
+	/* No need to maintain the index while destroying everything */
+	hmap_fini(&records->byname);
+
 	record = cgen_records_first(records);
 	while (record != NULL) {
 		cgen_record_destroy(record);
@@ -109,6 +114,13 @@ int cgen_record_create(cgen_records_t *records, cgen_rec_type_t rtype,
 
 	record->irrecord = irrec;
 
+	if (record->cident != NULL) {
+		/* If identifier is already present, keep the first record */
+		if (hmap_insert_str(&records->byname, record->cident,
+		    record) == ENOMEM)
+			goto error;
+	}
+
 	list_initialize(&record->elems);
 	list_initialize(&record->stors);
 
@@ -133,18 +145,38 @@ error:
  */
 cgen_record_t *cgen_records_find(cgen_records_t *records, const char *ident)
 {
-	cgen_record_t *record;
+	return (cgen_record_t *)hmap_find_str(&records->byname, ident);
+}
 
-	record = cgen_records_first(records);
-	while (record != NULL) {
-		if (record->cident != NULL &&
-		    strcmp(record->cident, ident) == 0)
-			return record;
+/** Remove record definition from the index of its records list.
+ *
+ * If another record with the same identifier exists, it takes
+ * the place of the removed one.
+ *
+ * @param record Record definition
+ */
+static void cgen_record_unindex(cgen_record_t *record)
+{
+	cgen_records_t *records = record->records;
+	cgen_record_t *r;
 
-		record = cgen_records_next(record);
-	}
+	if (record->cident == NULL ||
+	    (cgen_record_t *)hmap_find_str(&records->byname,
+	    record->cident) != record)
+		return;
 
-	return NULL;
+	hmap_remove_str(&records->byname, record->cident);
+
+	r = cgen_records_next(record);
+	while (r != NULL) {
+		if (r->cident != NULL &&
+		    strcmp(r->cident, record->cident) == 0) {
+			(void)hmap_insert_str(&records->byname, r->cident, r);
+			break;
+		}
+
+		r = cgen_records_next(r);
+	}
 }
 
 /** Destroy record definition.
@@ -156,6 +188,7 @@ void cgen_record_destroy(cgen_record_t *record)
 	cgen_rec_elem_t *elem;
 	cgen_rec_stor_t *stor;
 
+	cgen_record_unindex(record);
 	list_remove(&record->lrecords);
 
 	elem = cgen_record_first_elem(record);
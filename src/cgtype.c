@@ -1111,6 +1111,7 @@ int cgtype_compose(cgtype_t *a, cgtype_t *b, cgtype_t **rcomp)
 		return EINVAL;
 	}
 
+	(*rcomp)->qual = a->qual;
 	return EOK;
 }
 
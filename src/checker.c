@@ -25,15 +25,20 @@
  */
 
 #include <adt/list.h>
+#include <arena.h>
 #include <assert.h>
 #include <ast.h>
 #include <checker.h>
+#include <diag.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <parser.h>
+#include <src_pos.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strtab.h>
 
 static void checker_parser_read_tok(void *, void *, unsigned, bool,
     lexer_tok_t *);
@@ -74,7 +79,9 @@ enum {
 	/** Number of spaces used to indent a continuation line */
 	cont_indent_spaces = 4,
 	/** Number of spaces used to indent a secondary continuation line */
-	seccont_indent_spaces = 6
+	seccont_indent_spaces = 6,
+	/** Size of buffer for composing an issue description */
+	checker_msg_size = 128
 };
 
 /** Create checker module.
@@ -88,16 +95,29 @@ static int checker_module_create(checker_t *checker,
     checker_module_t **rmodule)
 {
 	checker_module_t *module = NULL;
+	int rc;
 
 	module = calloc(1, sizeof(checker_module_t));
 	if (module == NULL)
 		return ENOMEM;
 
+	rc = arena_create(&module->arena);
+	if (rc != EOK)
+		goto error;
+
+	rc = strtab_create(module->arena, &module->strtab);
+	if (rc != EOK)
+		goto error;
+
 	list_initialize(&module->toks);
 	module->checker = checker;
 
 	*rmodule = module;
 	return EOK;
+error:
+	arena_destroy(module->arena);
+	free(module);
+	return rc;
 }
 
 /** Destroy checker module.
@@ -117,21 +137,28 @@ static void checker_module_destroy(checker_module_t *module)
 		tok = checker_module_first_tok(module);
 	}
 
+	strtab_destroy(module->strtab);
+	arena_destroy(module->arena);
 	free(module);
 }
 
 /** Create a checker token.
  *
+ * The token is allocated from the module arena. The lexer has already
+ * stored the token text in the module arena or string table.
+ *
+ * @param module Checker module
  * @param tok Lexer token
  * @param rctok Place to store pointer to new checker token
  *
  * @return EOK on success, ENOMEM if out of memory
  */
-static int checker_tok_new(lexer_tok_t *tok, checker_tok_t **rctok)
+static int checker_tok_new(checker_module_t *module, lexer_tok_t *tok,
+    checker_tok_t **rctok)
 {
 	checker_tok_t *ctok;
 
-	ctok = calloc(1, sizeof(checker_tok_t));
+	ctok = arena_zalloc(module->arena, sizeof(checker_tok_t));
 	if (ctok == NULL)
 		return ENOMEM;
 
@@ -152,7 +179,7 @@ static int checker_module_append(checker_module_t *module, lexer_tok_t *tok)
 	checker_tok_t *ctok;
 	int rc;
 
-	rc = checker_tok_new(tok, &ctok);
+	rc = checker_tok_new(module, tok, &ctok);
 	if (rc != EOK) {
 		assert(rc == ENOMEM);
 		return rc;
@@ -161,9 +188,106 @@ static int checker_module_append(checker_module_t *module, lexer_tok_t *tok)
 	ctok->mod = module;
 	list_append(&ctok->ltoks, &module->toks);
 
+	/* Compute line metadata */
+	if (module->lhead == NULL)
+		module->lhead = ctok;
+
+	ctok->lhead = module->lhead;
+	ctok->lprevnl = module->lastnl;
+	ctok->lfirst = !module->lhead->lnonws;
+
+	if (!lexer_is_wspace(ctok->tok.ttype) && ctok->tok.ttype != ltt_eof)
+		module->lhead->lnonws = true;
+
+	if (ctok->tok.ttype == ltt_newline) {
+		module->lastnl = ctok;
+		module->lhead = NULL;
+	}
+
 	return EOK;
 }
 
+/** Report an issue within a source range.
+ *
+ * @param tok Token where the issue is
+ * @param bpos Beginning of the range
+ * @param epos End of the range (inclusive)
+ * @param check Check identifier (name of check group)
+ * @param fixable @c true if the issue can be fixed using --fix
+ * @param msg Issue description
+ * @return EOK on success, EIO on I/O error
+ */
+static int checker_issue_range(checker_tok_t *tok, src_pos_t *bpos,
+    src_pos_t *epos, const char *check, bool fixable, const char *msg)
+{
+	diag_entry_t entry;
+
+	entry.sev = dsev_warning;
+	entry.check = check;
+	entry.tok = &tok->tok;
+	entry.bpos = *bpos;
+	entry.epos = *epos;
+	entry.fixable = fixable;
+	entry.fixes = NULL;
+	entry.nfixes = 0;
+	entry.msg = msg;
+
+	++tok->mod->checker->nissues;
+	return diag_report(tok->mod->checker->diag, &entry);
+}
+
+/** Report an issue.
+ *
+ * @param tok Token where the issue is
+ * @param check Check identifier (name of check group)
+ * @param fixable @c true if the issue can be fixed using --fix
+ * @param msg Issue description
+ * @return EOK on success, EIO on I/O error
+ */
+static int checker_issue(checker_tok_t *tok, const char *check,
+    bool fixable, const char *msg)
+{
+	return checker_issue_range(tok, &tok->tok.bpos, &tok->tok.epos, check,
+	    fixable, msg);
+}
+
+/** Report an issue at a character inside a token.
+ *
+ * @param tok Token where the issue is
+ * @param offs Offset of the character within the token text
+ * @param check Check identifier (name of check group)
+ * @param fixable @c true if the issue can be fixed using --fix
+ * @param msg Issue description
+ * @return EOK on success, EIO on I/O error
+ */
+static int checker_issue_chr(checker_tok_t *tok, size_t offs,
+    const char *check, bool fixable, const char *msg)
+{
+	src_pos_t pos;
+	size_t i;
+
+	pos = tok->tok.bpos;
+	for (i = 0; i < offs; i++)
+		src_pos_fwd_char(&pos, tok->tok.text[i]);
+
+	return checker_issue_range(tok, &pos, &pos, check, fixable, msg);
+}
+
+/** Compose message about an invalid character.
+ *
+ * @param invchar Invalid character
+ * @param where Description of where the character is (may be empty)
+ * @param msg Buffer of checker_msg_size characters for the message
+ */
+static void checker_invchar_msg(char invchar, const char *where, char *msg)
+{
+	char cbuf[lexer_dchar_size];
+
+	lexer_sprint_char(invchar, cbuf);
+	(void)snprintf(msg, checker_msg_size, "Invalid character '%s'%s.",
+	    cbuf, where);
+}
+
 /** Create checker.
  *
  * @param input_ops Input ops
@@ -193,16 +317,25 @@ int checker_create(lexer_input_ops_t *input_ops, void *input_arg,
 		goto error;
 	}
 
+	rc = diag_create(dfmt_text, "ccheck", stdout, &checker->tdiag);
+	if (rc != EOK)
+		goto error;
+
 	checker->lexer = lexer;
 	checker->mtype = mtype;
 	checker->cfg = cfg;
+	checker->diag = checker->tdiag;
+	checker->atbof = true;
+	checker->ateof = true;
 	*rchecker = checker;
 	return EOK;
 error:
 	if (lexer != NULL)
 		lexer_destroy(lexer);
-	if (checker != NULL)
+	if (checker != NULL) {
+		diag_destroy(checker->tdiag);
 		free(checker);
+	}
 	return rc;
 }
 
@@ -214,6 +347,7 @@ void checker_destroy(checker_t *checker)
 {
 	checker_module_destroy(checker->mod);
 	lexer_destroy(checker->lexer);
+	diag_destroy(checker->tdiag);
 	free(checker);
 }
 
@@ -236,6 +370,9 @@ static int checker_module_lex(checker_t *checker, checker_module_t **rmodule)
 		goto error;
 	}
 
+	/* Lexer stores token text directly in the module */
+	lexer_set_arena(checker->lexer, module->arena, module->strtab);
+
 	done = false;
 	while (!done) {
 		rc = lexer_get_tok(checker->lexer, &tok);
@@ -243,15 +380,14 @@ static int checker_module_lex(checker_t *checker, checker_module_t **rmodule)
 			return rc;
 
 		rc = checker_module_append(module, &tok);
-		if (rc != EOK) {
-			lexer_free_tok(&tok);
+		if (rc != EOK)
 			return rc;
-		}
 
 		if (tok.ttype == ltt_eof)
 			done = true;
 	}
 
+	module->lvalid = true;
 	*rmodule = module;
 	return EOK;
 error:
@@ -302,6 +438,7 @@ static checker_tok_t *checker_next_tok(checker_tok_t *tok)
 	if (tok == NULL)
 		return NULL;
 
+	++tok->mod->nsteps;
 	link = list_next(&tok->ltoks, &tok->mod->toks);
 	if (link == NULL)
 		return NULL;
@@ -321,6 +458,7 @@ static checker_tok_t *checker_prev_tok(checker_tok_t *tok)
 	if (tok == NULL)
 		return NULL;
 
+	++tok->mod->nsteps;
 	link = list_prev(&tok->ltoks, &tok->mod->toks);
 	if (link == NULL)
 		return NULL;
@@ -350,6 +488,9 @@ static bool checker_is_tok_lbegin(checker_tok_t *tok)
 {
 	checker_tok_t *p;
 
+	if (tok->mod->lvalid)
+		return tok->lfirst;
+
 	p = checker_prev_tok(tok);
 	while (p != NULL && lexer_is_wspace(p->tok.ttype) &&
 	    p->tok.ttype != ltt_newline) {
@@ -371,6 +512,9 @@ static checker_tok_t *checker_prev_newline(checker_tok_t *tok)
 {
 	checker_tok_t *p;
 
+	if (tok->mod->lvalid)
+		return tok->lprevnl;
+
 	p = checker_prev_tok(tok);
 	while (p != NULL) {
 		if (p->tok.ttype == ltt_newline)
@@ -393,28 +537,25 @@ static int checker_prepend_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 {
 	checker_tok_t *ctok;
 	lexer_tok_t t;
-	char *dtext;
 	int rc;
 
-	dtext = strdup(text);
-	if (dtext == NULL)
-		return ENOMEM;
-
 	t.ttype = ltt;
-	t.text = dtext;
-	t.text_size = strlen(dtext);
+	t.text = arena_strdup(tok->mod->arena, text);
+	if (t.text == NULL)
+		return ENOMEM;
+	t.text_size = strlen(text);
 	t.udata = NULL;
 
-	rc = checker_tok_new(&t, &ctok);
-	if (rc != EOK) {
-		free(dtext);
-		return ENOMEM;
-	}
+	rc = checker_tok_new(tok->mod, &t, &ctok);
+	if (rc != EOK)
+		return rc;
 
 	ctok->mod = tok->mod;
 	ctok->pindlvl = tok->pindlvl;
 	ctok->pseccont = tok->pseccont;
 	list_insert_before(&ctok->ltoks, &tok->ltoks);
+	tok->mod->lvalid = false;
+	++tok->mod->checker->nedits;
 
 	return EOK;
 }
@@ -430,28 +571,25 @@ static int checker_append_tok(checker_tok_t *tok, lexer_toktype_t ltt,
 {
 	checker_tok_t *ctok;
 	lexer_tok_t t;
-	char *dtext;
 	int rc;
 
-	dtext = strdup(text);
-	if (dtext == NULL)
-		return ENOMEM;
-
 	t.ttype = ltt;
-	t.text = dtext;
-	t.text_size = strlen(dtext);
+	t.text = arena_strdup(tok->mod->arena, text);
+	if (t.text == NULL)
+		return ENOMEM;
+	t.text_size = strlen(text);
 	t.udata = NULL;
 
-	rc = checker_tok_new(&t, &ctok);
-	if (rc != EOK) {
-		free(dtext);
-		return ENOMEM;
-	}
+	rc = checker_tok_new(tok->mod, &t, &ctok);
+	if (rc != EOK)
+		return rc;
 
 	ctok->mod = tok->mod;
 	ctok->pindlvl = tok->pindlvl;
 	ctok->pseccont = tok->pseccont;
 	list_insert_after(&ctok->ltoks, &tok->ltoks);
+	tok->mod->lvalid = false;
+	++tok->mod->checker->nedits;
 
 	return EOK;
 }
@@ -465,12 +603,14 @@ static int checker_set_tok_text(checker_tok_t *tok, const char *text)
 {
 	char *dtext;
 
-	dtext = strdup(text);
+	dtext = arena_strdup(tok->mod->arena, text);
 	if (dtext == NULL)
 		return ENOMEM;
 
-	free(tok->tok.text);
+	/* Old text is reclaimed when the module arena is destroyed */
 	tok->tok.text = dtext;
+	tok->tok.text_size = strlen(dtext);
+	++tok->mod->checker->nedits;
 	return EOK;
 }
 
@@ -488,14 +628,16 @@ static int checker_tok_strip_char1(checker_tok_t *tok)
 }
 
 /** Remove a token from the source code.
+ *
+ * The token memory is reclaimed when the module arena is destroyed.
  *
  * @param tok Token to remove
  */
 static void checker_remove_token(checker_tok_t *tok)
 {
 	list_remove(&tok->ltoks);
-	lexer_free_tok(&tok->tok);
-	free(tok);
+	tok->mod->lvalid = false;
+	++tok->mod->checker->nedits;
 }
 
 /** Remove whitespace before token.
@@ -559,6 +701,9 @@ static void checker_remove_ws_after(checker_tok_t *tok)
  */
 static bool checker_line_is_blank(checker_tok_t *tok)
 {
+	if (tok->mod->lvalid && tok->lhead == tok)
+		return !tok->lnonws;
+
 	while (tok->tok.ttype != ltt_eof &&
 	    tok->tok.ttype != ltt_newline) {
 		if (!lexer_is_wspace(tok->tok.ttype))
@@ -645,7 +790,6 @@ static int checker_check_lbegin(checker_scope_t *scope, checker_tok_t *tok,
 {
 	int rc;
 	size_t i;
-	int rv;
 
 	checker_check_any(scope, tok);
 	if (!scope->secindent) {
@@ -671,12 +815,9 @@ static int checker_check_lbegin(checker_scope_t *scope, checker_tok_t *tok,
 					return rc;
 			}
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -701,7 +842,6 @@ static int checker_check_nows_before(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -713,12 +853,9 @@ static int checker_check_nows_before(checker_scope_t *scope,
 		if (scope->fix) {
 			checker_remove_ws_before(tok);
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -740,7 +877,6 @@ static int checker_check_nows_after(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -752,12 +888,9 @@ static int checker_check_nows_after(checker_scope_t *scope,
 		if (scope->fix) {
 			checker_remove_ws_after(tok);
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -779,7 +912,6 @@ static int checker_check_nsbrk_before(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -793,12 +925,9 @@ static int checker_check_nsbrk_before(checker_scope_t *scope,
 		if (scope->fix) {
 			checker_remove_ws_before(tok);
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -847,7 +976,6 @@ static int checker_check_nsbrk_after(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -860,12 +988,9 @@ static int checker_check_nsbrk_after(checker_scope_t *scope,
 		if (scope->fix) {
 			checker_remove_ws_after(tok);
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -882,7 +1007,6 @@ static int checker_check_brkspace_before(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -896,12 +1020,9 @@ static int checker_check_brkspace_before(checker_scope_t *scope,
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -940,7 +1061,6 @@ static int checker_check_brkspace_after(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -954,12 +1074,9 @@ static int checker_check_brkspace_after(checker_scope_t *scope,
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -981,7 +1098,6 @@ static int checker_check_nbspace_before(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -998,12 +1114,9 @@ static int checker_check_nbspace_before(checker_scope_t *scope,
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&p->tok, stdout);
+			rc = checker_issue(p, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -1025,7 +1138,6 @@ static int checker_check_binop_not_lbegin(checker_scope_t *scope,
 {
 	checker_tok_t *p;
 	int rc;
-	int rv;
 
 	checker_check_any(scope, tok);
 
@@ -1040,18 +1152,17 @@ static int checker_check_binop_not_lbegin(checker_scope_t *scope,
 			/* Move operator before the preceding line break */
 			list_remove(&tok->ltoks);
 			list_insert_before(&tok->ltoks, &p->ltoks);
+			tok->mod->lvalid = false;
+			++tok->mod->checker->nedits;
 
 			/* Prepend a single space */
 			rc = checker_prepend_tok(tok, ltt_space, " ");
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": %s\n", msg);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -1147,6 +1258,8 @@ static int checker_module_parse(checker_module_t *mod)
 	if (rc != EOK)
 		return rc;
 
+	parser->silent = mod->checker->silent;
+
 	rc = parser_process_module(parser, &amod);
 	if (rc != EOK)
 		goto error;
@@ -1748,7 +1861,6 @@ static int checker_check_do(checker_scope_t *scope, ast_do_t *ado)
 	checker_tok_t *trparen;
 	checker_tok_t *tscolon;
 	int rc;
-	int rv;
 
 	tdo = (checker_tok_t *)ado->tdo.data;
 	twhile = (checker_tok_t *)ado->twhile.data;
@@ -1767,12 +1879,10 @@ static int checker_check_do(checker_scope_t *scope, ast_do_t *ado)
 
 	if (ado->body->braces != ast_braces &&
 	    checker_scfg(scope)->loop) {
-		rc = lexer_dprint_tok(&tdo->tok, stdout);
+		rc = checker_issue(tdo, "loop", false,
+		    "Body of 'do' loop should always have braces.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Body of 'do' loop should always have braces.\n");
-		if (rv < 0)
-			return EIO;
 	}
 
 	if (ado->body->braces == ast_braces) {
@@ -1831,7 +1941,6 @@ static int checker_check_for(checker_scope_t *scope, ast_for_t *afor)
 	checker_tok_t *tscolon2;
 	checker_tok_t *trparen;
 	int rc;
-	int rv;
 
 	tfor = (checker_tok_t *)afor->tfor.data;
 	tlparen = (checker_tok_t *)afor->tlparen.data;
@@ -1918,13 +2027,11 @@ static int checker_check_for(checker_scope_t *scope, ast_for_t *afor)
 		checker_check_any(scope, trparen);
 
 		if (checker_scfg(scope)->loop) {
-			rc = lexer_dprint_tok(&trparen->tok, stdout);
+			rc = checker_issue(trparen, "loop", false,
+			    "For loop with empty next expression. "
+			    "Use while instead.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": For loop with empty next expression. "
-			    "Use while instead.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -2194,7 +2301,6 @@ static int checker_check_stnull(checker_scope_t *scope, ast_stnull_t *stnull,
     checker_ns_allow_t nsallow)
 {
 	int rc;
-	int rv;
 	checker_tok_t *tscolon;
 
 	tscolon = (checker_tok_t *)stnull->tscolon.data;
@@ -2204,12 +2310,10 @@ static int checker_check_stnull(checker_scope_t *scope, ast_stnull_t *stnull,
 		return rc;
 
 	if (nsallow != cns_allow && checker_scfg(scope)->estmt) {
-		rc = lexer_dprint_tok(&tscolon->tok, stdout);
+		rc = checker_issue(tscolon, "estmt", false,
+		    "Unexpected null statement.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Unexpected null statement.\n");
-		if (rv < 0)
-			return EIO;
 	}
 
 	return EOK;
@@ -2428,20 +2532,15 @@ static int checker_check_stblock(checker_scope_t *scope, ast_block_t *block)
 	checker_tok_t *trbrace;
 	ast_node_t *stmt;
 	int rc;
-	int rv;
 
 	assert(block->braces == ast_braces);
 	tlbrace = (checker_tok_t *)block->topen.data;
 
 	if (checker_scfg(scope)->nblock) {
-		rc = lexer_dprint_tok(&tlbrace->tok, stdout);
+		rc = checker_issue(tlbrace, "nblock", false,
+		    "Gratuitous nested block.");
 		if (rc != EOK)
-			return rc;
-		rv = printf(": Gratuitous nested block.\n");
-		if (rv < 0) {
-			rc = EIO;
 			goto error;
-		}
 	}
 
 	rc = checker_check_lbegin(scope, tlbrace,
@@ -2627,7 +2726,6 @@ static int checker_check_dfun(checker_scope_t *scope, ast_dfun_t *dfun)
 	checker_tok_t *tellipsis;
 	checker_tok_t *trparen;
 	int rc;
-	int rv;
 
 	rc = checker_check_decl(scope, dfun->bdecl);
 	if (rc != EOK)
@@ -2647,14 +2745,12 @@ static int checker_check_dfun(checker_scope_t *scope, ast_dfun_t *dfun)
 			 * we could detect function pointer declaration
 			 * missing both parentheses and '*'.
 			 */
-			rc = lexer_dprint_tok(&tlparen->tok, stdout);
+			rc = checker_issue(tlparen, "decl", false,
+			    "Superfluous parentheses around "
+			    "function identifier or function pointer "
+			    "declaration is missing '*'.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Superfluous parentheses around "
-			    "function identifier or function pointer "
-			    "declaration is missing '*'.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -2808,7 +2904,6 @@ static int checker_check_dlist(checker_scope_t *scope, ast_dlist_t *dlist)
 	ast_tok_t *aattr;
 	checker_tok_t *tattr;
 	int rc;
-	int rv;
 
 	entry = ast_dlist_first(dlist);
 	while (entry != NULL) {
@@ -2849,13 +2944,11 @@ static int checker_check_dlist(checker_scope_t *scope, ast_dlist_t *dlist)
 			if (checker_scfg(scope)->attr) {
 				aattr = ast_tree_first_tok(&entry->aslist->node);
 				tattr = (checker_tok_t *) aattr->data;
-				rc = lexer_dprint_tok(&tattr->tok, stdout);
+				rc = checker_issue(tattr, "attr", false,
+				    "Attribute ignored "
+				    "in this position.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Attribute ignored "
-				    "in this position.\n");
-				if (rv < 0)
-					return EIO;
 			}
 		}
 
@@ -3536,7 +3629,6 @@ static int checker_check_tsrecord(checker_scope_t *scope,
 	checker_tok_t *tdecl;
 	bool nullelem;
 	int rc;
-	int rv;
 
 	escope = checker_scope_nested(scope);
 	if (escope == NULL)
@@ -3615,15 +3707,11 @@ static int checker_check_tsrecord(checker_scope_t *scope,
 				goto error;
 
 			if (checker_scfg(escope)->estmt) {
-				rc = lexer_dprint_tok(&tscolon->tok, stdout);
+				rc = checker_issue(tscolon, "estmt", false,
+				    "Empty struct or union member "
+				    "declaration.");
 				if (rc != EOK)
-					return rc;
-				rv = printf(": Empty struct or union "
-				    "member declaration.\n");
-				if (rv < 0) {
-					rc = EIO;
 					goto error;
-				}
 			}
 		}
 
@@ -4043,7 +4131,7 @@ static int checker_check_estring_lit(checker_scope_t *scope,
 	size_t invpos;
 	char invchar;
 	int rc;
-	int rv;
+	char msg[checker_msg_size];
 
 	tlit = (checker_tok_t *) lit->tlit.data;
 	checker_check_any(scope, tlit);
@@ -4053,20 +4141,12 @@ static int checker_check_estring_lit(checker_scope_t *scope,
 		while (!lexer_tok_valid_chars(&tlit->tok, invpos, &invpos)) {
 			invchar = tlit->tok.text[invpos];
 			if (checker_scfg(scope)->invchar) {
-				rc = lexer_dprint_tok_chr(&tlit->tok, invpos,
-				    stdout);
-				if (rc != EOK)
-					return rc;
-
-				rv = printf(": Invalid character '");
-				if (rv < 0)
-					return EIO;
-				rc = lexer_dprint_char(invchar, stdout);
+				checker_invchar_msg(invchar,
+				    " inside string literal", msg);
+				rc = checker_issue_chr(tlit, invpos, "invchar",
+				    false, msg);
 				if (rc != EOK)
 					return rc;
-				rv = printf("' inside string literal.\n");
-				if (rv < 0)
-					return EIO;
 			}
 			++invpos;
 		}
@@ -4126,7 +4206,7 @@ static int checker_check_echar(checker_scope_t *scope, ast_echar_t *echar)
 	size_t invpos;
 	char invchar;
 	int rc;
-	int rv;
+	char msg[checker_msg_size];
 
 	tlit = (checker_tok_t *) echar->tlit.data;
 	checker_check_any(scope, tlit);
@@ -4135,18 +4215,12 @@ static int checker_check_echar(checker_scope_t *scope, ast_echar_t *echar)
 	while (!lexer_tok_valid_chars(&tlit->tok, invpos, &invpos)) {
 		invchar = tlit->tok.text[invpos];
 		if (checker_scfg(scope)->invchar) {
-			rc = lexer_dprint_tok_chr(&tlit->tok, invpos, stdout);
-			if (rc != EOK)
-				return rc;
-			rv = printf(": Invalid character '");
-			if (rv < 0)
-				return EIO;
-			rc = lexer_dprint_char(invchar, stdout);
+			checker_invchar_msg(invchar,
+			    " inside character literal", msg);
+			rc = checker_issue_chr(tlit, invpos, "invchar", false,
+			    msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf("' inside character literal.\n");
-			if (rv < 0)
-				return EIO;
 		}
 		++invpos;
 	}
@@ -4560,7 +4634,7 @@ static int checker_check_ealignof(checker_scope_t *scope,
 	ast_tok_t *aexpr;
 	checker_tok_t *texpr;
 	int rc;
-	int rv;
+	char msg[checker_msg_size];
 
 	talignof = (checker_tok_t *) ealignof->talignof.data;
 	tlparen = (checker_tok_t *) ealignof->tlparen.data;
@@ -4586,13 +4660,11 @@ static int checker_check_ealignof(checker_scope_t *scope,
 		if (ealignof->bexpr->ntype != ant_eparen) {
 			aexpr = ast_tree_first_tok(ealignof->bexpr);
 			texpr = (checker_tok_t *)aexpr->data;
-			rc = lexer_dprint_tok(&texpr->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Argument to '%s' "
+			    "should be parenthesized.", talignof->tok.text);
+			rc = checker_issue(texpr, "fmt", false, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Argument to '%s' should be "
-			    "parenthesized.\n", talignof->tok.text);
-			if (rv < 0)
-				return EIO;
 
 			rc = checker_check_brkspace_before(scope, texpr,
 			    "Expected space before expression.");
@@ -4649,7 +4721,6 @@ static int checker_check_esizeof(checker_scope_t *scope, ast_esizeof_t *esizeof)
 	ast_tok_t *aexpr;
 	checker_tok_t *texpr;
 	int rc;
-	int rv;
 
 	tsizeof = (checker_tok_t *) esizeof->tsizeof.data;
 	tlparen = (checker_tok_t *) esizeof->tlparen.data;
@@ -4668,13 +4739,11 @@ static int checker_check_esizeof(checker_scope_t *scope, ast_esizeof_t *esizeof)
 		if (esizeof->bexpr->ntype != ant_eparen) {
 			aexpr = ast_tree_first_tok(esizeof->bexpr);
 			texpr = (checker_tok_t *)aexpr->data;
-			rc = lexer_dprint_tok(&texpr->tok, stdout);
+			rc = checker_issue(texpr, "fmt", false,
+			    "Argument to 'sizeof' should be "
+			    "parenthesized.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Argument to 'sizeof' should be "
-			    "parenthesized.\n");
-			if (rv < 0)
-				return EIO;
 
 			rc = checker_check_brkspace_before(scope, texpr,
 			    "Expected space before expression.");
@@ -5349,20 +5418,17 @@ static int checker_check_fundef_sclass(checker_scope_t *scope,
 	ast_tok_t *atok;
 	checker_tok_t *tok;
 	int rc;
-	int rv;
 
 	sclass = ast_dspecs_get_sclass(dspecs);
 	if (sclass != NULL) {
 		if (sclass->sctype == asc_extern &&
 		    checker_scfg(scope)->sclass) {
 			tsclass = (checker_tok_t *) sclass->tsclass.data;
-			rc = lexer_dprint_tok(&tsclass->tok, stdout);
+			rc = checker_issue(tsclass, "sclass", false,
+			    "Improper use of storage class "
+			    "'extern' with function definition.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Improper use of storage class "
-			    "'extern' with function definition.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -5371,13 +5437,11 @@ static int checker_check_fundef_sclass(checker_scope_t *scope,
 		    checker_scfg(scope)->hdr) {
 			atok = ast_tree_first_tok(&dspecs->node);
 			tok = (checker_tok_t *) atok->data;
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "hdr", false,
+			    "Non-static function defined in a "
+			    "header.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Non-static function defined in a "
-			    "header.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -5403,7 +5467,6 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 	bool vardecl;
 	bool fundecl;
 	int rc;
-	int rv;
 
 	vardecl = fundecl = false;
 	entry = ast_idlist_first(idlist);
@@ -5413,26 +5476,22 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 			if (fundecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				rc = lexer_dprint_tok(&tok->tok, stdout);
+				rc = checker_issue(tok, "decl", false,
+				    "Multiple function "
+				    "declarators.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Multiple function "
-				    "declarators.\n");
-				if (rv < 0)
-					return EIO;
 				break;
 			}
 
 			if (vardecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				rc = lexer_dprint_tok(&tok->tok, stdout);
+				rc = checker_issue(tok, "decl", false,
+				    "Mixing function and variable "
+				    "declarators.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Mixing function and variable "
-				    "declarators.\n");
-				if (rv < 0)
-					return EIO;
 				break;
 			}
 
@@ -5442,13 +5501,11 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 			if (fundecl && checker_scfg(scope)->decl) {
 				atok = ast_decl_get_ident(entry->decl);
 				tok = (checker_tok_t *) atok->data;
-				rc = lexer_dprint_tok(&tok->tok, stdout);
+				rc = checker_issue(tok, "decl", false,
+				    "Mixing function and variable "
+				    "declarators.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Mixing function and variable "
-				    "declarators.\n");
-				if (rv < 0)
-					return EIO;
 				break;
 			}
 
@@ -5460,14 +5517,11 @@ static int checker_check_gdecln_idlist_sclass(checker_scope_t *scope,
 				    checker_scfg(scope)->sclass) {
 					atok = ast_decl_get_ident(entry->decl);
 					tok = (checker_tok_t *) atok->data;
-					rc = lexer_dprint_tok(&tok->tok,
-					    stdout);
+					rc = checker_issue(tok, "sclass",
+					    false, "Non-static variable "
+					    "defined in a header.");
 					if (rc != EOK)
 						return rc;
-					rv = printf(": Non-static variable "
-					    "defined in a header.\n");
-					if (rv < 0)
-						return EIO;
 				}
 			}
 
@@ -5744,7 +5798,6 @@ static int checker_check_nulldecln(checker_scope_t *scope,
     ast_nulldecln_t *nulldecln)
 {
 	int rc;
-	int rv;
 	checker_tok_t *tscolon;
 
 	tscolon = (checker_tok_t *) nulldecln->tscolon.data;
@@ -5754,12 +5807,10 @@ static int checker_check_nulldecln(checker_scope_t *scope,
 		goto error;
 
 	if (checker_scfg(scope)->estmt) {
-		rc = lexer_dprint_tok(&tscolon->tok, stdout);
+		rc = checker_issue(tscolon, "estmt", false,
+		    "Empty declaration.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Empty declaration.\n");
-		if (rv < 0)
-			goto error;
 	}
 
 	return EOK;
@@ -5778,7 +5829,6 @@ static int checker_check_externc(checker_scope_t *scope,
     ast_externc_t *externc)
 {
 	int rc;
-	int rv;
 	ast_node_t *decl;
 	checker_tok_t *textern;
 	checker_tok_t *tlang;
@@ -5792,12 +5842,10 @@ static int checker_check_externc(checker_scope_t *scope,
 
 	if (strcmp(tlang->tok.text, "\"C\"") != 0 &&
 	    checker_scfg(scope)->hdr) {
-		rc = lexer_dprint_tok(&tlang->tok, stdout);
+		rc = checker_issue(tlang, "hdr", false,
+		    "Linked language is not 'C'.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Linked language is not 'C'.\n");
-		if (rv < 0)
-			return EIO;
 	}
 
 	rc = checker_check_lbegin(scope, textern,
@@ -5915,7 +5963,7 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 	unsigned i;
 	unsigned req_spaces;
 	int rc;
-	int rv;
+	char msg[checker_msg_size];
 
 	need_fix = false;
 
@@ -5937,13 +5985,11 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 
 	if (tok->tok.ttype == ltt_dctopen) {
 		/* Trailing doc comment at the beginning of line */
-		rc = lexer_dprint_tok(&tok->tok, stdout);
+		rc = checker_issue(tok, "fmt", false,
+		    "Unexpected trailing comment at the beginning "
+		    "of a line.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Unexpected trailing comment at the beginning "
-		    "of a line.\n");
-		if (rv < 0)
-			return EIO;
 	}
 
 	/*
@@ -5957,13 +6003,11 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		if (fix) {
 			need_fix = true;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "Mixing tabs and spaces in "
+			    "indentation.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Mixing tabs and spaces in "
-			    "indentation.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -5991,14 +6035,12 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		if (fix) {
 			need_fix = true;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Non-continuation "
+			    "line should not have any spaces for indentation "
+			    "(found %u)", spaces);
+			rc = checker_issue(tok, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Non-continuation line should not "
-			    "have any spaces for indentation (found %u)\n",
-			    spaces);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6006,13 +6048,11 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		if (fix) {
 			need_fix = true;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Line is indented by "
+			    "%u spaces (should be %u)", spaces, req_spaces);
+			rc = checker_issue(tok, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Line is indented by %u spaces "
-			    "(should be %u)\n", spaces, req_spaces);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6020,14 +6060,12 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		if (fix) {
 			need_fix = true;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Wrong indentation: "
+			    "found %u tabs, should be %u tabs", tabs,
+			    tok->indlvl);
+			rc = checker_issue(tok, "fmt", true, msg);
 			if (rc != EOK)
 				return rc;
-
-			rv = printf(": Wrong indentation: found %u tabs, "
-			    "should be %u tabs\n", tabs, tok->indlvl);
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6035,12 +6073,10 @@ static int checker_check_line_indent(unsigned tabs, unsigned spaces,
 		if (fix) {
 			need_fix = true;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "Mixing tabs and spaces.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Mixing tabs and spaces.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6086,7 +6122,7 @@ static int checker_module_alltoks(checker_module_t *mod, bool fix)
 	size_t invpos;
 	char invchar;
 	int rc;
-	int rv;
+	char msg[checker_msg_size];
 
 	tok = checker_module_first_tok(mod);
 	while (tok->tok.ttype != ltt_eof) {
@@ -6099,13 +6135,11 @@ static int checker_module_alltoks(checker_module_t *mod, bool fix)
 				checker_line_remove_ws_before(bs);
 				checker_remove_token(bs);
 			} else {
-				rc = lexer_dprint_tok(&tok->tok, stdout);
+				rc = checker_issue(tok, "invchar", true,
+				    "Backslash outside of "
+				    "preprocessor directive.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Backslash outside of "
-				    "preprocessor directive.\n");
-				if (rv < 0)
-					return EIO;
 			}
 		}
 
@@ -6116,19 +6150,12 @@ static int checker_module_alltoks(checker_module_t *mod, bool fix)
 			while (!lexer_tok_valid_chars(&tok->tok, invpos,
 			    &invpos)) {
 				invchar = tok->tok.text[invpos];
-				rc = lexer_dprint_tok_chr(&tok->tok, invpos,
-				    stdout);
-				if (rc != EOK)
-					return rc;
-				rv = printf(": Invalid character '");
-				if (rv < 0)
-					return EIO;
-				rc = lexer_dprint_char(invchar, stdout);
+				checker_invchar_msg(invchar, " inside comment",
+				    msg);
+				rc = checker_issue_chr(tok, invpos, "invchar",
+				    false, msg);
 				if (rc != EOK)
 					return rc;
-				rv = printf("' inside comment.\n");
-				if (rv < 0)
-					return EIO;
 				++invpos;
 			}
 		}
@@ -6136,48 +6163,35 @@ static int checker_module_alltoks(checker_module_t *mod, bool fix)
 		if (tok->tok.ttype == ltt_invchar &&
 		    mod->checker->cfg->invchar) {
 			invchar = tok->tok.text[0];
-			rc = lexer_dprint_tok(&tok->tok, stdout);
-			if (rc != EOK)
-				return rc;
-			rv = printf(": Invalid character '");
-			if (rv < 0)
-				return EIO;
-			rc = lexer_dprint_char(invchar, stdout);
+			checker_invchar_msg(invchar, "", msg);
+			rc = checker_issue(tok, "invchar", false, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf("'.\n");
-			if (rv < 0)
-				return EIO;
 		}
 
 		if (!tok->checked && !parser_ttype_ignore(tok->tok.ttype)) {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "internal", false,
+			    "Token not checked");
 			if (rc != EOK)
 				return rc;
-			rv = printf(" Token not checked\n");
-			if (rv < 0)
-				return EIO;
 		}
 
 		if (tok->indlvl != tok->pindlvl && !parser_ttype_ignore(tok->tok.ttype)) {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Indentation "
+			    "mismatch: parser %u, checker %u.", tok->pindlvl,
+			    tok->indlvl);
+			rc = checker_issue(tok, "internal", false, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Indentation mismatch: parser %u, "
-			    "checker %u.\n", tok->pindlvl, tok->indlvl);
-			if (rv < 0)
-				return EIO;
 		}
 
 		if (tok->seccont != tok->pseccont && !parser_ttype_ignore(tok->tok.ttype)) {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Secondary "
+			    "indentation mismatch: parser %u, checker %u.",
+			    tok->pseccont, tok->seccont);
+			rc = checker_issue(tok, "internal", false, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Secondary indentation mismatch: "
-			    "parser %u, checker %u.\n",
-			    tok->pseccont, tok->seccont);
-			if (rv < 0)
-				return EIO;
 		}
 
 		tok = checker_next_tok(tok);
@@ -6196,7 +6210,6 @@ static int checker_module_alltoks(checker_module_t *mod, bool fix)
 static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 {
 	int rc;
-	int rv;
 
 	if (tok->tok.ttype != ltt_ctext || tok->tok.text[0] != '*') {
 		if (fix) {
@@ -6208,13 +6221,11 @@ static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "'*' expected at beginning "
+			    "of block comment line.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": '*' expected at beginning "
-			    "of block comment line.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	} else if (tok->tok.ttype == ltt_ctext && tok->tok.text[1] != '\0') {
 		if (fix) {
@@ -6230,12 +6241,10 @@ static int checker_block_comment_line(checker_tok_t *tok, bool fix)
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "Space expected after '*'.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Space expected after '*'.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6258,7 +6267,6 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 	unsigned lbreaks;
 	bool first;
 	int rc;
-	int rv;
 
 	tok = tbegin;
 	lbreaks = 0;
@@ -6269,12 +6277,10 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 	}
 
 	if (tok->tok.ttype == ltt_eof) {
-		rc = lexer_dprint_tok(&tbegin->tok, stdout);
+		rc = checker_issue(tbegin, "fmt", false,
+		    "Unterminated comment.");
 		if (rc != EOK)
 			return rc;
-		rv = printf(": Unterminated comment.\n");
-		if (rv < 0)
-			return EIO;
 		*tnext = tok;
 		return EOK;
 	}
@@ -6293,20 +6299,12 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 				if (rc != EOK)
 					return rc;
 			} else {
-				rc = lexer_dprint_tok(&tbegin->tok, stdout);
+				rc = checker_issue(tbegin, "fmt", true,
+				    tbegin->tok.ttype == ltt_dctopen ?
+				    "Space expected after '<'." :
+				    "Space expected after '*'.");
 				if (rc != EOK)
 					return rc;
-				if (tbegin->tok.ttype == ltt_dctopen) {
-					rv = printf(": Space expected "
-					    "after '<'.\n");
-					if (rv < 0)
-						return EIO;
-				} else {
-					rv = printf(": Space expected "
-					    "after '*'.\n");
-					if (rv < 0)
-						return EIO;
-				}
 			}
 		}
 
@@ -6317,12 +6315,10 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 				if (rc != EOK)
 					return rc;
 			} else {
-				rc = lexer_dprint_tok(&tclose->tok, stdout);
+				rc = checker_issue(tclose, "fmt", true,
+				    "Space expected before '*'.");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Space expected before '*'.\n");
-				if (rv < 0)
-					return EIO;
 			}
 		}
 		return EOK;
@@ -6355,13 +6351,11 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tbegin->tok, stdout);
+			rc = checker_issue(tbegin, "fmt", true,
+			    "Comment text should begin on a new "
+			    "line.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Comment text should begin on a new "
-			    "line.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6421,13 +6415,11 @@ static int checker_module_comment(checker_tok_t *tbegin, bool fix,
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tclose->tok, stdout);
+			rc = checker_issue(tclose, "fmt", true,
+			    "Block comment closing '*/' should be on "
+			    "a new line.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Block comment closing '*/' should be on "
-			    "a new line.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6480,7 +6472,6 @@ static int checker_module_lines(checker_module_t *mod, bool fix)
 	bool nonws;
 	bool trailws;
 	int rc;
-	int rv;
 
 	tok = checker_module_first_tok(mod);
 	while (tok->tok.ttype != ltt_eof) {
@@ -6530,26 +6521,23 @@ static int checker_module_lines(checker_module_t *mod, bool fix)
 			if (fix) {
 				checker_line_remove_ws_before(tok);
 			} else {
-				rc = lexer_dprint_tok(&tok->tok, stdout);
+				rc = checker_issue(tok, "fmt", true,
+				    "Whitespace at end of line");
 				if (rc != EOK)
 					return rc;
-				rv = printf(": Whitespace at end of line\n");
-				if (rv < 0)
-					return EIO;
 			}
 		}
 
 #if 0
 		/* Check for overlong lines */
 		if (tok->tok.bpos.col > 1 + line_length_limit) {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			(void)snprintf(msg, sizeof(msg), "Line too long (%zu "
+			    "characters above %u character limit)",
+			    tok->tok.bpos.col - line_length_limit - 1,
+			    line_length_limit);
+			rc = checker_issue(tok, "fmt", false, msg);
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Line too long (%zu characters above %u "
-			    "character limit)\n", tok->tok.bpos.col -
-			    line_length_limit - 1, line_length_limit);
-			if (rv < 0)
-				return EIO;
 		}
 #endif
 
@@ -6575,7 +6563,6 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 {
 	checker_tok_t *tok;
 	int rc;
-	int rv;
 
 	if (bof) {
 		if (fix) {
@@ -6586,13 +6573,11 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 			}
 		} else {
 			tok = checker_module_first_tok(mod);
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "Unexpected empty line at beginning of "
+			    "file.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Unexpected empty line at beginning of "
-			    "file.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	} else if (empty_lc > 1) {
 		if (fix) {
@@ -6610,13 +6595,11 @@ static int checker_check_empty_line_block(checker_module_t *mod, bool bof,
 			while (checker_line_is_blank(tok))
 				tok = checker_remove_line(tok);
 		} else {
-			rc = lexer_dprint_tok(&etok->tok, stdout);
+			rc = checker_issue(etok, "fmt", true,
+			    "Unexpected multiple consecutive "
+			    "empty lines.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Unexpected multiple consecutive "
-			    "empty lines.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6639,10 +6622,9 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 	bool bof;
 	unsigned empty_lc;
 	int rc;
-	int rv;
 
 	/* Beginning of file? */
-	bof = true;
+	bof = mod->checker->atbof;
 	/* Number of consecutive empty lines */
 	empty_lc = 0;
 	etok = NULL;
@@ -6687,6 +6669,10 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 			tok = checker_next_tok(tok);
 	}
 
+	/* A fragment in the middle of a file does not end with end of file */
+	if (!mod->checker->ateof)
+		return EOK;
+
 	ptok = checker_prev_tok(tok);
 	if (ptok != NULL && ptok->tok.ttype != ltt_newline) {
 		if (fix) {
@@ -6694,12 +6680,10 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 			if (rc != EOK)
 				return rc;
 		} else {
-			rc = lexer_dprint_tok(&tok->tok, stdout);
+			rc = checker_issue(tok, "fmt", true,
+			    "Expected newline at end of file.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Expected newline at end of file.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6707,13 +6691,11 @@ static int checker_module_vspacing(checker_module_t *mod, bool fix)
 		if (fix) {
 			checker_remove_ws_before(ptok);
 		} else {
-			rc = lexer_dprint_tok(&ptok->tok, stdout);
+			rc = checker_issue(ptok, "fmt", true,
+			    "Unexpected empty lines at end "
+			    "of file.");
 			if (rc != EOK)
 				return rc;
-			rv = printf(": Unexpected empty lines at end "
-			    "of file.\n");
-			if (rv < 0)
-				return EIO;
 		}
 	}
 
@@ -6764,6 +6746,144 @@ static int checker_build_ast(checker_t *checker)
 	return EOK;
 }
 
+/** Get number of issues reported by checker.
+ *
+ * Issues that were fixed (instead of reported) are not counted.
+ *
+ * @param checker Checker
+ * @return Number of reported issues
+ */
+unsigned long checker_get_nissues(checker_t *checker)
+{
+	return checker->nissues;
+}
+
+/** Get number of edits made to the source code by checker.
+ *
+ * Every token inserted, removed, moved or changed while fixing issues
+ * counts as one edit. If there were no edits, the source code is
+ * unchanged and need not be written back.
+ *
+ * @param checker Checker
+ * @return Number of edits
+ */
+unsigned long checker_get_nedits(checker_t *checker)
+{
+	return checker->nedits;
+}
+
+/** Get number of steps made by checker traversing the token list.
+ *
+ * This is a measure of the work done by the checker, used to verify
+ * that checking time grows linearly with the size of the source code.
+ *
+ * @param checker Checker
+ * @return Number of steps
+ */
+unsigned long checker_get_nsteps(checker_t *checker)
+{
+	if (checker->mod == NULL)
+		return 0;
+
+	return checker->mod->nsteps;
+}
+
+/** Set diagnostics sink to which checker reports issues.
+ *
+ * By default issues are reported to standard output in text format.
+ *
+ * @param checker Checker
+ * @param diag Diagnostics sink
+ */
+void checker_set_diag(checker_t *checker, diag_t *diag)
+{
+	checker->diag = diag;
+}
+
+/** Mark source code as a fragment of a larger file.
+ *
+ * The fragment must start at the beginning of a line and (unless
+ * it extends to the end of file) end with a newline. Issues concerning
+ * the beginning or end of file are only reported if the fragment
+ * actually starts at the beginning or extends to the end of the file.
+ *
+ * @param checker Checker
+ * @param atbof @c true iff the fragment starts at the beginning of file
+ * @param ateof @c true iff the fragment extends to the end of file
+ */
+void checker_set_fragment(checker_t *checker, bool atbof, bool ateof)
+{
+	checker->atbof = atbof;
+	checker->ateof = ateof;
+}
+
+/** Set whether parser error messages should be printed.
+ *
+ * @param checker Checker
+ * @param silent @c true to suppress printing parser error messages
+ */
+void checker_set_silent(checker_t *checker, bool silent)
+{
+	checker->silent = silent;
+}
+
+/** Get lines where top-level declarations end.
+ *
+ * For each top-level declaration return the number of the last line
+ * that contains a token of the declaration, or a token (such as
+ * a comment) that follows it on the same line. Declarations whose
+ * end cannot be determined are skipped. The source code must have been
+ * parsed successfully, e.g. by checker_run().
+ *
+ * @param checker Checker
+ * @param rlines Place to store pointer to array of line numbers
+ *        (to be freed by the caller)
+ * @param rnlines Place to store number of entries in @a rlines
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int checker_get_decl_lines(checker_t *checker, uint32_t **rlines,
+    size_t *rnlines)
+{
+	ast_node_t *decl;
+	ast_tok_t *atok;
+	checker_tok_t *tok;
+	uint32_t *lines;
+	size_t nlines;
+	size_t n;
+
+	n = 0;
+	decl = ast_module_first(checker->mod->ast);
+	while (decl != NULL) {
+		++n;
+		decl = ast_module_next(decl);
+	}
+
+	lines = calloc(n + 1, sizeof(uint32_t));
+	if (lines == NULL)
+		return ENOMEM;
+
+	nlines = 0;
+	decl = ast_module_first(checker->mod->ast);
+	while (decl != NULL) {
+		atok = ast_tree_last_tok(decl);
+		if (atok != NULL && atok->data != NULL) {
+			/* Find the end of the line */
+			tok = (checker_tok_t *)atok->data;
+			while (tok->tok.ttype != ltt_newline &&
+			    tok->tok.ttype != ltt_eof)
+				tok = checker_next_tok(tok);
+
+			lines[nlines++] = tok->tok.bpos.line;
+		}
+
+		decl = ast_module_next(decl);
+	}
+
+	*rlines = lines;
+	*rnlines = nlines;
+	return EOK;
+}
+
 /** Run checker.
  *
  * @param checker Checker
@@ -6834,6 +6954,47 @@ int checker_print(checker_t *checker, FILE *f)
 	return EOK;
 }
 
+/** Print source code to a newly allocated string.
+ *
+ * @param checker Checker
+ * @param rstr Place to store pointer to null-terminated string
+ *        (to be freed by the caller)
+ * @param rsize Place to store length of the string
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int checker_print_str(checker_t *checker, char **rstr, size_t *rsize)
+{
+	checker_tok_t *tok;
+	char *str;
+	size_t size;
+	size_t len;
+
+	size = 0;
+	tok = checker_module_first_tok(checker->mod);
+	while (tok->tok.ttype != ltt_eof) {
+		size += strlen(tok->tok.text);
+		tok = checker_next_tok(tok);
+	}
+
+	str = malloc(size + 1);
+	if (str == NULL)
+		return ENOMEM;
+
+	size = 0;
+	tok = checker_module_first_tok(checker->mod);
+	while (tok->tok.ttype != ltt_eof) {
+		len = strlen(tok->tok.text);
+		memcpy(str + size, tok->tok.text, len);
+		size += len;
+		tok = checker_next_tok(tok);
+	}
+
+	str[size] = '\0';
+	*rstr = str;
+	*rsize = size;
+	return EOK;
+}
+
 /** Dump AST.
  *
  * @param checker Checker
@@ -28,8 +28,11 @@
 #define CHECKER_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <types/checker.h>
+#include <types/diag.h>
 #include <types/lexer.h>
 
 extern int checker_create(lexer_input_ops_t *, void *, checker_mtype_t,
@@ -39,6 +42,14 @@ extern int checker_dump_ast(checker_t *, FILE *);
 extern int checker_dump_toks(checker_t *, FILE *);
 extern void checker_destroy(checker_t *);
 extern int checker_run(checker_t *, bool);
+extern unsigned long checker_get_nissues(checker_t *);
+extern unsigned long checker_get_nedits(checker_t *);
+extern unsigned long checker_get_nsteps(checker_t *);
+extern void checker_set_diag(checker_t *, diag_t *);
+extern void checker_set_fragment(checker_t *, bool, bool);
+extern void checker_set_silent(checker_t *, bool);
+extern int checker_get_decl_lines(checker_t *, uint32_t **, size_t *);
+extern int checker_print_str(checker_t *, char **, size_t *);
 extern void checker_cfg_init(checker_cfg_t *);
 
 #endif
@@ -25,27 +25,36 @@
  */
 
 #include <adt/list.h>
+#include <arena.h>
 #include <assert.h>
 #include <ast.h>
+#include <cache.h>
 #include <cgen.h>
 #include <comp.h>
 #include <ir.h>
+#include <irbin.h>
 #include <irlexer.h>
 #include <irparser.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <object/linker.h>
+#include <object/lscript.h>
 #include <object/object.h>
+#include <object/section.h>
 #include <parser.h>
 #include <pathname.h>
+#include <pch.h>
 #include <preproc.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strtab.h>
 #include <symbols.h>
 #include <tape/maker.h>
 #include <tape/tape.h>
 #include <tape/tzx.h>
+#include <types/object/file.h>
 #include <z80/emit.h>
 #include <z80/iclexer.h>
 #include <z80/icparser.h>
@@ -60,6 +69,8 @@ static void *comp_parser_tok_data(void *, void *);
 static comp_tok_t *comp_module_first_tok(comp_module_t *);
 static comp_tok_t *comp_next_tok(comp_tok_t *);
 static void comp_remove_token(comp_tok_t *);
+static int comp_module_create_from_object(comp_t *, obj_object_t *,
+    const char *, comp_module_t **);
 
 static parser_input_ops_t comp_parser_input = {
 	.read_tok = comp_parser_read_tok,
@@ -85,7 +96,13 @@ static z80ic_parser_input_ops_t comp_z80ic_parser_input = {
 
 enum {
 	org_default = 0x8000u,
-	comp_buf_size = 32
+	comp_buf_size = 32,
+	/** Size of buffer for computing compiler identity */
+	comp_ident_buf_size = 256,
+	/** Compiler version for compilation cache key (increment on every
+	 * change to code generation or object file format)
+	 */
+	comp_cache_version = 2
 };
 
 /** Return compiler module type as string.
@@ -102,6 +119,8 @@ static const char *comp_mtype_str(comp_mtype_t mtype)
 		return ".h";
 	case cmt_ir:
 		return ".ir";
+	case cmt_irb:
+		return ".irb";
 	case cmt_ic:
 		return ".asm";
 	case cmt_obj:
@@ -111,6 +130,70 @@ static const char *comp_mtype_str(comp_mtype_t mtype)
 	return "unknown";
 }
 
+/** Create preprocessor for C source file.
+ *
+ * @param comp Compiler
+ * @param fname File name
+ * @param input_ops Input ops
+ * @param input_arg Argument to input_ops
+ * @param rpreproc Place to store pointer to new preprocessor
+ *
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int comp_preproc_create(comp_t *comp, const char *fname,
+    lexer_input_ops_t *input_ops, void *input_arg, preproc_t **rpreproc)
+{
+	preproc_t *preproc = NULL;
+	char *incldir = NULL;
+	comp_incldir_t *cidir;
+	link_t *link;
+	int rc;
+
+	rc = preproc_create(fname, input_ops, input_arg, &preproc);
+	if (rc != EOK) {
+		assert(rc == ENOMEM);
+		goto error;
+	}
+
+	if (comp->base_dir != NULL) {
+		incldir = pathname_compose(comp->base_dir,
+		    "lib/clib/include");
+		if (incldir == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		rc = preproc_set_incldir(preproc, incldir);
+		if (rc != EOK)
+			goto error;
+
+		free(incldir);
+		incldir = NULL;
+	}
+
+	link = list_first(&comp->incldirs);
+	while (link != NULL) {
+		cidir = list_get_instance(link, comp_incldir_t, lincldirs);
+		rc = preproc_add_incldir(preproc, cidir->dir);
+		if (rc != EOK)
+			goto error;
+
+		link = list_next(link, &comp->incldirs);
+	}
+
+	if (comp->pch != NULL)
+		preproc_set_pch(preproc, comp->pch);
+
+	*rpreproc = preproc;
+	return EOK;
+error:
+	if (incldir != NULL)
+		free(incldir);
+	if (preproc != NULL)
+		preproc_destroy(preproc);
+	return rc;
+}
+
 /** Create compiler module.
  *
  * @param comp Compiler
@@ -132,7 +215,8 @@ int comp_module_create(comp_t *comp, lexer_input_ops_t *input_ops,
 	ir_lexer_t *ir_lexer = NULL;
 	z80ic_lexer_t *ic_lexer = NULL;
 	symbols_t *symbols = NULL;
-	char *incldir = NULL;
+	arena_t *arena = NULL;
+	strtab_t *strtab = NULL;
 	int rc;
 
 	module = calloc(1, sizeof(comp_module_t));
@@ -145,29 +229,20 @@ int comp_module_create(comp_t *comp, lexer_input_ops_t *input_ops,
 	if (rc != EOK)
 		goto error;
 
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		goto error;
+
+	rc = strtab_create(arena, &strtab);
+	if (rc != EOK)
+		goto error;
+
 	if (mtype == cmt_csrc || mtype == cmt_chdr)  {
 		/* Preprocessor */
-		rc = preproc_create(fname, input_ops, input_arg, &preproc);
-		if (rc != EOK) {
-			assert(rc == ENOMEM);
+		rc = comp_preproc_create(comp, fname, input_ops, input_arg,
+		    &preproc);
+		if (rc != EOK)
 			goto error;
-		}
-
-		if (comp->base_dir != NULL) {
-			incldir = pathname_compose(comp->base_dir,
-			    "lib/clib/include");
-			if (incldir == NULL) {
-				rc = ENOMEM;
-				goto error;
-			}
-
-			rc = preproc_set_incldir(preproc, incldir);
-			if (rc != EOK)
-				goto error;
-		}
-
-		free(incldir);
-		incldir = NULL;
 
 		/* C language lexer */
 		rc = lexer_create(&lexer_preproc_input,
@@ -176,6 +251,9 @@ int comp_module_create(comp_t *comp, lexer_input_ops_t *input_ops,
 			assert(rc == ENOMEM);
 			goto error;
 		}
+
+		/* Lexer stores token text directly in the module */
+		lexer_set_arena(lexer, arena, strtab);
 	} else if (mtype == cmt_ic) {
 		/* IC language lexer */
 		rc = z80ic_lexer_create(input_ops, input_arg, &ic_lexer);
@@ -207,6 +285,8 @@ int comp_module_create(comp_t *comp, lexer_input_ops_t *input_ops,
 	module->ic_lexer = ic_lexer;
 	module->mtype = mtype;
 	module->symbols = symbols;
+	module->arena = arena;
+	module->strtab = strtab;
 
 	list_initialize(&module->toks);
 
@@ -214,8 +294,8 @@ int comp_module_create(comp_t *comp, lexer_input_ops_t *input_ops,
 	return EOK;
 error:
 	symbols_destroy(symbols);
-	if (incldir != NULL)
-		free(incldir);
+	strtab_destroy(strtab);
+	arena_destroy(arena);
 	if (lexer != NULL)
 		lexer_destroy(lexer);
 	if (preproc != NULL)
@@ -236,53 +316,137 @@ error:
 int comp_module_create_from_obj(comp_t *comp, const char *fname,
     comp_module_t **rmodule)
 {
-	comp_module_t *module = NULL;
-	FILE *objf = NULL;
+	FILE *objf;
 	int rc;
 
-	module = calloc(1, sizeof(comp_module_t));
-	if (module == NULL) {
-		rc = ENOMEM;
-		goto error;
+	objf = fopen(fname, "rb");
+	if (objf == NULL) {
+		(void)fprintf(stderr, "Error opening '%s'.\n",
+		    fname);
+		return EIO;
 	}
 
-	module->fname = strdup(fname);
-	if (module->fname == NULL) {
-		rc = ENOMEM;
-		goto error;
+	rc = comp_module_create_from_objf(comp, objf, fname, rmodule);
+	(void)fclose(objf);
+	return rc;
+}
+
+/** Create compiler module from open object file.
+ *
+ * @param comp Compiler
+ * @param objf Object file
+ * @param fname File name (used as module name)
+ * @param rmodule Place to store new compiler module.
+ *
+ * @return EOK on success, ENOMEM if out of memory, EIO if object file
+ *         is not valid
+ */
+int comp_module_create_from_objf(comp_t *comp, FILE *objf, const char *fname,
+    comp_module_t **rmodule)
+{
+	obj_object_t *object;
+	int rc;
+
+	rc = obj_object_load_obj(objf, fname, &object);
+	if (rc != EOK)
+		return rc;
+
+	rc = comp_module_create_from_object(comp, object, fname, rmodule);
+	if (rc != EOK) {
+		obj_object_destroy(object);
+		return rc;
 	}
 
-	objf = fopen(fname, "rb");
-	if (objf == NULL) {
+	return EOK;
+}
+
+/** Create compiler module from binary IR file.
+ *
+ * @param comp Compiler
+ * @param fname File name
+ * @param rmodule Place to store new compiler module.
+ *
+ * @return EOK on success, ENOMEM if out of memory, EIO if file
+ *         cannot be read, EINVAL if file is not valid binary IR
+ */
+int comp_module_create_from_irb(comp_t *comp, const char *fname,
+    comp_module_t **rmodule)
+{
+	comp_module_t *module;
+	ir_module_t *ir;
+	FILE *irbf;
+	int rc;
+
+	irbf = fopen(fname, "rb");
+	if (irbf == NULL) {
 		(void)fprintf(stderr, "Error opening '%s'.\n",
 		    fname);
-		rc = EIO;
-		goto error;
+		return EIO;
 	}
 
-	rc = obj_object_load_obj(objf, fname, &module->object);
+	rc = irbin_load(irbf, fname, &ir);
+	(void)fclose(irbf);
 	if (rc != EOK)
-		goto error;
+		return rc;
 
-	(void)fclose(objf);
-	objf = NULL;
+	module = calloc(1, sizeof(comp_module_t));
+	if (module == NULL) {
+		ir_module_destroy(ir);
+		return ENOMEM;
+	}
 
+	module->fname = strdup(fname);
+	if (module->fname == NULL) {
+		ir_module_destroy(ir);
+		free(module);
+		return ENOMEM;
+	}
+
+	module->ir = ir;
 	module->comp = comp;
 	list_append(&module->lmods, &comp->mods);
 
-	module->mtype = cmt_obj;
+	module->mtype = cmt_irb;
 	list_initialize(&module->toks);
 
 	*rmodule = module;
 	return EOK;
-error:
-	if (objf != NULL)
-		(void)fclose(objf);
-	if (module != NULL && module->fname != NULL)
-		free(module->fname);
-	if (module != NULL)
+}
+
+/** Create compiler module from binary object.
+ *
+ * @param comp Compiler
+ * @param object Binary object (ownership is transferred to the module
+ *               on success)
+ * @param fname File name
+ * @param rmodule Place to store new compiler module.
+ *
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int comp_module_create_from_object(comp_t *comp, obj_object_t *object,
+    const char *fname, comp_module_t **rmodule)
+{
+	comp_module_t *module;
+
+	module = calloc(1, sizeof(comp_module_t));
+	if (module == NULL)
+		return ENOMEM;
+
+	module->fname = strdup(fname);
+	if (module->fname == NULL) {
 		free(module);
-	return rc;
+		return ENOMEM;
+	}
+
+	module->object = object;
+	module->comp = comp;
+	list_append(&module->lmods, &comp->mods);
+
+	module->mtype = cmt_obj;
+	list_initialize(&module->toks);
+
+	*rmodule = module;
+	return EOK;
 }
 
 /** Destroy compiler module.
@@ -312,8 +476,11 @@ void comp_module_destroy(comp_module_t *module)
 	z80ic_module_destroy(module->ic);
 	z80ic_lexer_destroy(module->ic_lexer);
 	obj_object_destroy(module->object);
+	cache_key_destroy(module->cache_key);
 	ir_lexer_destroy(module->ir_lexer);
 	lexer_destroy(module->lexer);
+	strtab_destroy(module->strtab);
+	arena_destroy(module->arena);
 
 	list_remove(&module->lmods);
 	free(module->fname);
@@ -354,16 +521,21 @@ comp_module_t *comp_module_next(comp_module_t *cur)
 
 /** Create a compiler token.
  *
+ * The token is allocated from the module arena. The lexer has already
+ * stored the token text in the module arena or string table.
+ *
+ * @param module Compiler module
  * @param tok Lexer token
  * @param rctok Place to store pointer to new compiler token
  *
  * @return EOK on success, ENOMEM if out of memory
  */
-static int comp_tok_new(lexer_tok_t *tok, comp_tok_t **rctok)
+static int comp_tok_new(comp_module_t *module, lexer_tok_t *tok,
+    comp_tok_t **rctok)
 {
 	comp_tok_t *ctok;
 
-	ctok = calloc(1, sizeof(comp_tok_t));
+	ctok = arena_zalloc(module->arena, sizeof(comp_tok_t));
 	if (ctok == NULL)
 		return ENOMEM;
 
@@ -384,7 +556,7 @@ static int comp_module_append(comp_module_t *module, lexer_tok_t *tok)
 	comp_tok_t *ctok;
 	int rc;
 
-	rc = comp_tok_new(tok, &ctok);
+	rc = comp_tok_new(module, tok, &ctok);
 	if (rc != EOK) {
 		assert(rc == ENOMEM);
 		return rc;
@@ -397,14 +569,14 @@ static int comp_module_append(comp_module_t *module, lexer_tok_t *tok)
 }
 
 /** Remove a token from the source code.
+ *
+ * The token memory is reclaimed when the module arena is destroyed.
  *
  * @param tok Token to remove
  */
 static void comp_remove_token(comp_tok_t *tok)
 {
 	list_remove(&tok->ltoks);
-	lexer_free_tok(&tok->tok);
-	free(tok);
 }
 
 /** Create compiler.
@@ -435,6 +607,7 @@ int comp_create(const char *base_dir, comp_t **rcomp)
 	}
 
 	list_initialize(&comp->mods);
+	list_initialize(&comp->incldirs);
 	*rcomp = comp;
 	return EOK;
 error:
@@ -458,7 +631,12 @@ void comp_destroy(comp_t *comp)
 	}
 
 	obj_object_destroy(comp->linked_object);
+	obj_lscript_destroy(comp->lscript);
+	obj_object_destroy(comp->stdlib);
+	cache_destroy(comp->cache);
 	tape_destroy(comp->tape);
+	pch_destroy(comp->pch);
+	comp_clear_incldirs(comp);
 	if (comp->base_dir != NULL)
 		free(comp->base_dir);
 	free(comp);
@@ -485,10 +663,8 @@ static int comp_module_lex(comp_module_t *module)
 			return EIO;
 
 		rc = comp_module_append(module, &tok);
-		if (rc != EOK) {
-			lexer_free_tok(&tok);
+		if (rc != EOK)
 			return rc;
-		}
 
 		if (tok.ttype == ltt_eof)
 			done = true;
@@ -617,6 +793,60 @@ static int comp_module_build_toks(comp_module_t *module)
 	return EOK;
 }
 
+/** Run code generator on module.
+ *
+ * If the module's preprocessor used a precompiled header, the code
+ * generator state is first loaded from the precompiled header.
+ *
+ * @param module Compiler module (that has been lexed)
+ * @param rcgen Place to store pointer to code generator
+ * @return EOK on success or an error code
+ */
+static int comp_module_cgen(comp_module_t *module, cgen_t **rcgen)
+{
+	int rc;
+	comp_parser_input_t pinput;
+	cgen_t *cgen = NULL;
+
+	rc = cgen_create(&cgen);
+	if (rc != EOK)
+		goto error;
+
+	/* Different arithmetic types not implemented yet */
+	cgen->arith_width = 16;
+
+	/* Configure code generator. */
+	cgen->flags = module->comp->cgflags;
+	cgen->diag = module->comp->diag;
+
+	if (module->preproc != NULL && preproc_pch_used(module->preproc)) {
+		rc = pch_load_cgen(module->comp->pch, module, cgen);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = cgen_module(cgen, &comp_parser_input, &pinput,
+	    comp_module_first_tok(module), module->symbols,
+	    &module->ir);
+	if (rc != EOK)
+		goto error;
+
+	/* Check for non-fatal code generator errors */
+	if (cgen->error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	module->ast = cgen->astmod;
+	module->warnings = cgen->warnings;
+
+	*rcgen = cgen;
+	return EOK;
+error:
+	cgen_destroy(cgen);
+	return rc;
+}
+
 /** Run all compiler steps needed to get IR.
  *
  * If some parts are already built, they are skipped.
@@ -627,14 +857,12 @@ static int comp_module_build_toks(comp_module_t *module)
 int comp_module_make_ir(comp_module_t *module)
 {
 	int rc;
-	parser_t *parser = NULL;
-	comp_parser_input_t pinput;
 	cgen_t *cgen = NULL;
 
 	if (module->mtype == cmt_ir && module->ir == NULL) {
 		rc = comp_ir_module_parse(module);
 		if (rc != EOK)
-			goto error;
+			return rc;
 	}
 
 	if (module->ir == NULL) {
@@ -642,87 +870,139 @@ int comp_module_make_ir(comp_module_t *module)
 		if (rc != EOK)
 			return rc;
 
-		rc = cgen_create(&cgen);
-		if (rc != EOK)
-			goto error;
-
-		/* Different arithmetic types not implemented yet */
-		cgen->arith_width = 16;
-
-		/* Configure code generator. */
-		cgen->flags = module->comp->cgflags;
-
-		rc = cgen_module(cgen, &comp_parser_input, &pinput,
-		    comp_module_first_tok(module), module->symbols,
-		    &module->ir);
+		rc = comp_module_cgen(module, &cgen);
 		if (rc != EOK)
-			goto error;
-
-		/* Check for non-fatal code generator errors */
-		if (cgen->error) {
-			rc = EINVAL;
-			goto error;
-		}
-
-		module->ast = cgen->astmod;
+			return rc;
 
 		cgen_destroy(cgen);
-		parser_destroy(parser);
-		cgen = NULL;
 	}
 
 	return EOK;
-error:
-	cgen_destroy(cgen);
-	return rc;
 }
 
-/** Run all compiler steps needed to get VRIC.
+/** Generate precompiled header from module.
  *
- * If some parts are already built, they are skipped.
+ * The module must be a C header that has not been processed yet.
+ * It may only contain declarations.
  *
  * @param module Compiler module
+ * @param f Output file
  * @return EOK on success or an error code
  */
-int comp_module_make_vric(comp_module_t *module)
+int comp_module_make_pch(comp_module_t *module, FILE *f)
 {
+	pch_t *pch = NULL;
+	cgen_t *cgen = NULL;
 	int rc;
-	z80_isel_t *isel = NULL;
 
-	rc = comp_module_make_ir(module);
+	assert(module->preproc != NULL);
+	assert(!module->lexed);
+
+	rc = preproc_pch_prepare(module->preproc);
 	if (rc != EOK)
 		goto error;
 
-	if (module->vric == NULL) {
-		rc = z80_isel_create(&isel);
-		if (rc != EOK)
-			goto error;
+	rc = comp_module_build_toks(module);
+	if (rc != EOK)
+		goto error;
 
-		rc = z80_isel_module(isel, module->ir, &module->vric);
-		if (rc != EOK)
-			goto error;
+	rc = comp_module_cgen(module, &cgen);
+	if (rc != EOK)
+		goto error;
 
-		z80_isel_destroy(isel);
-		isel = NULL;
-	}
+	rc = pch_create(module->fname, module->comp->cgflags, &pch);
+	if (rc != EOK)
+		goto error;
+
+	rc = preproc_pch_save(module->preproc, pch);
+	if (rc != EOK)
+		goto error;
+
+	rc = pch_save_cgen(pch, cgen, module->symbols, module->ir);
+	if (rc != EOK)
+		goto error;
+
+	rc = pch_save(pch, f);
+	if (rc != EOK)
+		goto error;
 
+	pch_destroy(pch);
+	cgen_destroy(cgen);
 	return EOK;
 error:
-	z80_isel_destroy(isel);
+	pch_destroy(pch);
+	cgen_destroy(cgen);
 	return rc;
 }
 
-/** Run all compiler steps needed to get IC.
+/** Save module IR in binary format.
  *
  * @param module Compiler module
+ * @param f Output file
  * @return EOK on success or an error code
  */
-int comp_module_make_ic(comp_module_t *module)
+int comp_module_save_irb(comp_module_t *module, FILE *f)
 {
 	int rc;
-	z80_ralloc_t *ralloc = NULL;
 
-	if (module->mtype == cmt_ic && module->ic == NULL) {
+	rc = comp_module_make_ir(module);
+	if (rc != EOK)
+		return rc;
+
+	assert(module->ir != NULL);
+	rc = irbin_save(module->ir, f);
+	if (rc == EIO)
+		(void)fprintf(stderr, "Error writing binary IR.\n");
+
+	return rc;
+}
+
+/** Run all compiler steps needed to get VRIC.
+ *
+ * If some parts are already built, they are skipped.
+ *
+ * @param module Compiler module
+ * @return EOK on success or an error code
+ */
+int comp_module_make_vric(comp_module_t *module)
+{
+	int rc;
+	z80_isel_t *isel = NULL;
+
+	rc = comp_module_make_ir(module);
+	if (rc != EOK)
+		goto error;
+
+	if (module->vric == NULL) {
+		rc = z80_isel_create(&isel);
+		if (rc != EOK)
+			goto error;
+
+		rc = z80_isel_module(isel, module->ir, &module->vric);
+		if (rc != EOK)
+			goto error;
+
+		z80_isel_destroy(isel);
+		isel = NULL;
+	}
+
+	return EOK;
+error:
+	z80_isel_destroy(isel);
+	return rc;
+}
+
+/** Run all compiler steps needed to get IC.
+ *
+ * @param module Compiler module
+ * @return EOK on success or an error code
+ */
+int comp_module_make_ic(comp_module_t *module)
+{
+	int rc;
+	z80_ralloc_t *ralloc = NULL;
+
+	if (module->mtype == cmt_ic && module->ic == NULL) {
 		rc = comp_z80ic_module_parse(module);
 		if (rc != EOK)
 			goto error;
@@ -777,6 +1057,17 @@ error:
 	return rc;
 }
 
+/** Write module object to cache entry.
+ *
+ * @param arg Binary object (obj_object_t *)
+ * @param f Cache entry file
+ * @return EOK on success or an error code
+ */
+static int comp_cache_write_obj(void *arg, FILE *f)
+{
+	return obj_object_save_obj((obj_object_t *)arg, f);
+}
+
 /** Emit binary instructions (but do not link).
  *
  * @param module Compiler module
@@ -809,6 +1100,16 @@ int comp_module_emit(comp_module_t *module, FILE *outf)
 
 		z80_emit_destroy(emit);
 		emit = NULL;
+
+		/*
+		 * Store object in cache. Modules producing warnings are not
+		 * cached so that the warnings are shown every time
+		 * (preprocessor diagnostics prevent setting the cache key).
+		 */
+		if (module->cache_key != NULL && module->warnings == 0)
+			(void)cache_store(module->comp->cache,
+			    module->cache_key, comp_cache_write_obj,
+			    module->object);
 	}
 
 	if (outf != NULL) {
@@ -823,6 +1124,75 @@ error:
 	return rc;
 }
 
+/** Get standard library file name.
+ *
+ * @param comp Compiler
+ * @param rfname Place to store pointer to newly allocated file name
+ * @return EOK on success, ENOENT if standard library location is not
+ *         known, ENOMEM if out of memory
+ */
+int comp_get_stdlib_fname(comp_t *comp, char **rfname)
+{
+	char *libname;
+
+	if (comp->base_dir == NULL) {
+		(void)fprintf(stderr, "Cannot determine standard library "
+		    "path.\n");
+		return ENOENT;
+	}
+
+	libname = pathname_compose(comp->base_dir,
+	    "lib/clib/src/stubs.z80.pp.obj");
+	if (libname == NULL)
+		return ENOMEM;
+
+	*rfname = libname;
+	return EOK;
+}
+
+/** Preload standard library.
+ *
+ * The standard library object is loaded now and used for linking later,
+ * instead of loading it from file at link time. A previously preloaded
+ * standard library object is discarded (even if loading fails).
+ *
+ * @param comp Compiler
+ * @return EOK on success or an error code
+ */
+int comp_preload_stdlib(comp_t *comp)
+{
+	obj_object_t *object;
+	char *libname = NULL;
+	FILE *f;
+	int rc;
+
+	obj_object_destroy(comp->stdlib);
+	comp->stdlib = NULL;
+
+	rc = comp_get_stdlib_fname(comp, &libname);
+	if (rc != EOK)
+		return rc;
+
+	f = fopen(libname, "rb");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot load '%s'.\n", libname);
+		free(libname);
+		return EIO;
+	}
+
+	rc = obj_object_load_obj(f, libname, &object);
+	(void)fclose(f);
+	if (rc != EOK) {
+		(void)fprintf(stderr, "Cannot load '%s'.\n", libname);
+		free(libname);
+		return rc;
+	}
+
+	comp->stdlib = object;
+	free(libname);
+	return EOK;
+}
+
 /** Add standard library to compilation (if desired).
  *
  * @param comp Compiler
@@ -838,31 +1208,362 @@ static int comp_add_stdlib(comp_t *comp, comp_flags_t flags)
 	if ((flags & compf_no_stdlib) != compf_none)
 		return EOK;
 
-	if (comp->base_dir == NULL) {
-		(void)fprintf(stderr, "Cannot determine standard library "
-		    "path.\n");
-		rc = ENOENT;
+	rc = comp_get_stdlib_fname(comp, &libname);
+	if (rc != EOK)
 		goto error;
+
+	if (comp->stdlib != NULL) {
+		/* Use preloaded standard library */
+		rc = comp_module_create_from_object(comp, comp->stdlib,
+		    libname, &lmodule);
+		if (rc != EOK)
+			goto error;
+
+		comp->stdlib = NULL;
+	} else {
+		rc = comp_module_create_from_obj(comp, libname, &lmodule);
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Cannot load '%s'.\n", libname);
+			goto error;
+		}
 	}
 
-	libname = pathname_compose(comp->base_dir,
-	    "lib/clib/src/stubs.z80.pp.obj");
-	if (libname == NULL) {
-		rc = ENOMEM;
+	free(libname);
+	return EOK;
+error:
+	if (libname != NULL)
+		free(libname);
+	return rc;
+}
+
+/** Load linker script.
+ *
+ * @param comp Compiler
+ * @param fname Linker script file name
+ * @return EOK on success or an error code
+ */
+int comp_load_lscript(comp_t *comp, const char *fname)
+{
+	obj_lscript_t *lscript;
+	FILE *f;
+	int rc;
+
+	f = fopen(fname, "rt");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+		return ENOENT;
+	}
+
+	rc = obj_lscript_load(f, fname, &lscript);
+	(void)fclose(f);
+	if (rc != EOK)
+		return rc;
+
+	obj_lscript_destroy(comp->lscript);
+	comp->lscript = lscript;
+	return EOK;
+}
+
+/** Set compilation cache directory.
+ *
+ * @param comp Compiler
+ * @param dir Cache directory
+ * @return EOK on success or an error code
+ */
+int comp_set_cache_dir(comp_t *comp, const char *dir)
+{
+	cache_t *cache;
+	int rc;
+
+	rc = cache_create(dir, &cache);
+	if (rc != EOK)
+		return rc;
+
+	cache_destroy(comp->cache);
+	comp->cache = cache;
+	return EOK;
+}
+
+/** Add include directory.
+ *
+ * Include directories are searched in the order in which they were
+ * added, before the standard library include directory.
+ *
+ * @param comp Compiler
+ * @param dir Include directory
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int comp_add_incldir(comp_t *comp, const char *dir)
+{
+	comp_incldir_t *cidir;
+
+	cidir = calloc(1, sizeof(comp_incldir_t));
+	if (cidir == NULL)
+		return ENOMEM;
+
+	cidir->dir = strdup(dir);
+	if (cidir->dir == NULL) {
+		free(cidir);
+		return ENOMEM;
+	}
+
+	list_append(&cidir->lincldirs, &comp->incldirs);
+	return EOK;
+}
+
+/** Remove all include directories.
+ *
+ * @param comp Compiler
+ */
+void comp_clear_incldirs(comp_t *comp)
+{
+	comp_incldir_t *cidir;
+	link_t *link;
+
+	link = list_first(&comp->incldirs);
+	while (link != NULL) {
+		cidir = list_get_instance(link, comp_incldir_t, lincldirs);
+		list_remove(&cidir->lincldirs);
+		free(cidir->dir);
+		free(cidir);
+		link = list_first(&comp->incldirs);
+	}
+}
+
+/** Set compiler identity.
+ *
+ * The compiler identity is a hash of the compiler executable. It is
+ * part of the compilation cache key, so that objects produced by
+ * a different build of the compiler are not reused. The compilation
+ * cache is not used until the compiler identity is set.
+ *
+ * @param comp Compiler
+ * @param exename File name of compiler executable
+ * @return EOK on success, ENOENT if file cannot be opened, EIO if
+ *         file cannot be read
+ */
+int comp_set_ident(comp_t *comp, const char *exename)
+{
+	FILE *f;
+	char buf[comp_ident_buf_size];
+	uint32_t h = 0x811c9dc5UL;
+	size_t nread;
+	size_t i;
+
+	f = fopen(exename, "rb");
+	if (f == NULL)
+		return ENOENT;
+
+	do {
+		nread = fread(buf, 1, sizeof(buf), f);
+		for (i = 0; i < nread; i++)
+			h = (h ^ (uint8_t)buf[i]) * 0x01000193UL;
+	} while (nread == sizeof(buf));
+
+	if (ferror(f) != 0) {
+		(void)fclose(f);
+		return EIO;
+	}
+
+	(void)fclose(f);
+	comp->ident = h & 0xffffffffUL;
+	comp->have_ident = true;
+	return EOK;
+}
+
+/** Set precompiled header to use.
+ *
+ * The precompiled header is validated against the compiler's code
+ * generator flags, which must therefore be set before. If the same
+ * precompiled header is already loaded and has not changed, it is kept.
+ *
+ * @param comp Compiler
+ * @param fname Precompiled header file name or @c NULL to stop
+ *              using precompiled header
+ * @return EOK on success, EINVAL if precompiled header is not valid
+ *         or an error code
+ */
+int comp_set_pch(comp_t *comp, const char *fname)
+{
+	pch_t *pch = NULL;
+	int rc;
+
+	/* Keep precompiled header loaded if it has not changed */
+	if (fname != NULL && comp->pch != NULL &&
+	    pch_is_current(comp->pch, fname, comp->cgflags))
+		return EOK;
+
+	if (fname != NULL) {
+		rc = pch_load(fname, comp->cgflags, &pch);
+		if (rc != EOK)
+			return rc;
+	}
+
+	pch_destroy(comp->pch);
+	comp->pch = pch;
+	return EOK;
+}
+
+/** Preload precompiled header.
+ *
+ * The precompiled header is loaded with the code generator flags
+ * it was compiled with. comp_set_pch() keeps it for compilations that
+ * use the same header with the same code generator flags (such as
+ * requests processed by the compile server). A previously loaded
+ * precompiled header is discarded (even if loading fails).
+ *
+ * @param comp Compiler
+ * @param fname Precompiled header file name
+ * @return EOK on success, EINVAL if precompiled header is not valid
+ *         or an error code
+ */
+int comp_preload_pch(comp_t *comp, const char *fname)
+{
+	pch_t *pch;
+	int rc;
+
+	pch_destroy(comp->pch);
+	comp->pch = NULL;
+
+	rc = pch_load_any(fname, &pch);
+	if (rc != EOK)
+		return rc;
+
+	comp->pch = pch;
+	return EOK;
+}
+
+/** Look up compiled module in compilation cache.
+ *
+ * The cache key consists of the code generator flags and the
+ * preprocessed source code, which is obtained by running a separate
+ * preprocessor on @a input_ops / @a input_arg (which must provide
+ * the same source as the module input). On a cache hit, the module's
+ * binary object is loaded from the cache and all further compilation
+ * steps are skipped. On a miss, the key is remembered so that the object
+ * can be stored in the cache once it is emitted. The separate
+ * preprocessor does not print diagnostics. If it reports any, the cache
+ * is not used for the module.
+ *
+ * Nothing is done if the compilation cache is not enabled, compiler
+ * identity is not known or the module is not a C source file.
+ *
+ * @param module Compiler module
+ * @param input_ops Input ops
+ * @param input_arg Argument to input_ops
+ * @return EOK on success (whether or not the module was found)
+ *         or an error code
+ */
+int comp_module_cache_lookup(comp_module_t *module,
+    lexer_input_ops_t *input_ops, void *input_arg)
+{
+	comp_t *comp = module->comp;
+	preproc_t *preproc = NULL;
+	cache_key_t *key = NULL;
+	FILE *objf = NULL;
+	char buf[comp_buf_size];
+	src_pos_t bpos;
+	size_t nread;
+	int rc;
+	int rv;
+
+	if (comp->cache == NULL || !comp->have_ident)
+		return EOK;
+
+	if (module->mtype != cmt_csrc && module->mtype != cmt_chdr)
+		return EOK;
+
+	rc = cache_key_create(&key);
+	if (rc != EOK)
+		goto error;
+
+	rv = snprintf(buf, sizeof(buf), "syc %d %d.%d %08lx %u\n",
+	    comp_cache_version, obj_file_major, obj_file_minor,
+	    (unsigned long)comp->ident, (unsigned)comp->cgflags);
+	if (rv < 0 || (size_t)rv >= sizeof(buf)) {
+		rc = EINVAL;
 		goto error;
 	}
 
-	rc = comp_module_create_from_obj(comp, libname, &lmodule);
-	if (rc != EOK) {
-		(void)fprintf(stderr, "Cannot load '%s'.\n", libname);
+	rc = cache_key_append(key, buf, (size_t)rv);
+	if (rc != EOK)
 		goto error;
+
+	/* Precompiled header contents are not part of preprocessed source */
+	if (comp->pch != NULL) {
+		rv = snprintf(buf, sizeof(buf), "pch %lx\n",
+		    (unsigned long)pch_hash(comp->pch));
+		if (rv < 0 || (size_t)rv >= sizeof(buf)) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		rc = cache_key_append(key, buf, (size_t)rv);
+		if (rc != EOK)
+			goto error;
 	}
 
-	free(libname);
+	rc = comp_preproc_create(comp, module->fname, input_ops, input_arg,
+	    &preproc);
+	if (rc != EOK)
+		goto error;
+
+	/* Diagnostics will be printed by the compilation proper */
+	preproc_set_quiet(preproc, true);
+
+	while (true) {
+		rc = lexer_preproc_input.read((void *)preproc, buf,
+		    sizeof(buf), &nread, &bpos);
+		if (rc != EOK)
+			break;
+
+		/* End of file? */
+		if (nread == 0)
+			break;
+
+		rc = cache_key_append(key, buf, nread);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (rc == ENOMEM)
+		goto error;
+
+	/*
+	 * Modules producing preprocessor diagnostics are neither looked up
+	 * nor stored, so that the diagnostics are shown every time.
+	 */
+	if (rc != EOK || preproc_ndiags(preproc) != 0) {
+		preproc_destroy(preproc);
+		cache_key_destroy(key);
+		return EOK;
+	}
+
+	preproc_destroy(preproc);
+	preproc = NULL;
+
+	rc = cache_lookup(comp->cache, key, &objf);
+	if (rc == EOK) {
+		rc = obj_object_load_obj(objf, module->fname, &module->object);
+		(void)fclose(objf);
+		if (rc == EOK) {
+			/* Cache hit */
+			cache_key_destroy(key);
+			return EOK;
+		}
+	}
+
+	if (rc == ENOMEM)
+		goto error;
+
+	/* Cache miss */
+	cache_key_destroy(module->cache_key);
+	module->cache_key = key;
 	return EOK;
 error:
-	if (libname != NULL)
-		free(libname);
+	if (preproc != NULL)
+		preproc_destroy(preproc);
+	cache_key_destroy(key);
 	return rc;
 }
 
@@ -893,7 +1594,12 @@ int comp_link(comp_t *comp, comp_flags_t flags, FILE *outf)
 	/* Add objects from all modules as sources. */
 	module = comp_module_first(comp);
 	while (module != NULL) {
-		rc = obj_linker_add_src(linker, module->object);
+		if (module->banked) {
+			rc = obj_linker_add_banked_src(linker, module->object,
+			    module->bank);
+		} else {
+			rc = obj_linker_add_src(linker, module->object);
+		}
 		if (rc != EOK) {
 			(void)fprintf(stderr, "Error adding link source.\n");
 			goto error;
@@ -906,6 +1612,8 @@ int comp_link(comp_t *comp, comp_flags_t flags, FILE *outf)
 	if (rc != EOK)
 		goto error;
 
+	obj_linker_set_script(linker, comp->lscript);
+
 	rc = obj_linker_link(linker, &comp->linked_object);
 	if (rc != EOK)
 		goto error;
@@ -926,6 +1634,51 @@ error:
 	return rc;
 }
 
+/** Place module in a memory bank.
+ *
+ * @param module Compiler module
+ * @param bank Memory bank number
+ * @return EOK on success, EINVAL if @a bank is not a valid bank number
+ */
+int comp_module_set_bank(comp_module_t *module, unsigned bank)
+{
+	if (bank >= obj_bank_count)
+		return EINVAL;
+
+	module->banked = true;
+	module->bank = bank;
+	return EOK;
+}
+
+/** Determine if linked executable uses a memory bank.
+ *
+ * @param comp Compiler
+ * @param bank Memory bank number
+ * @return @c true iff some code or data is placed in bank @a bank
+ */
+bool comp_has_bank(comp_t *comp, unsigned bank)
+{
+	if (comp->linked_object == NULL)
+		return false;
+
+	return obj_object_has_bank(comp->linked_object, bank);
+}
+
+/** Save contents of a memory bank of linked executable.
+ *
+ * @param comp Compiler
+ * @param bank Memory bank number
+ * @param outf Output file (for writing bank contents)
+ * @return EOK on success or an error code
+ */
+int comp_save_bank(comp_t *comp, unsigned bank, FILE *outf)
+{
+	if (comp->linked_object == NULL)
+		return EINVAL;
+
+	return obj_object_save_bank_bin(comp->linked_object, bank, outf);
+}
+
 /** Save map of linked executable into a z80asm compatible map file.
  *
  * @param comp Compiler
@@ -988,6 +1741,7 @@ int comp_module_dump_preproc(comp_module_t *module, FILE *f)
 	case cmt_chdr:
 		break;
 	case cmt_ir:
+	case cmt_irb:
 	case cmt_ic:
 	case cmt_obj:
 		(void)fprintf(stderr, "Error: Cannot dump preprocessed source "
@@ -1032,6 +1786,7 @@ int comp_module_dump_ast(comp_module_t *module, FILE *f)
 	case cmt_chdr:
 		break;
 	case cmt_ir:
+	case cmt_irb:
 	case cmt_ic:
 	case cmt_obj:
 		(void)fprintf(stderr, "Error: Cannot dump AST for '%s' file.\n",
@@ -1062,6 +1817,7 @@ int comp_module_dump_toks(comp_module_t *module, FILE *f)
 	case cmt_chdr:
 		break;
 	case cmt_ir:
+	case cmt_irb:
 	case cmt_ic:
 	case cmt_obj:
 		(void)fprintf(stderr, "Error: Cannot dump tokens for "
@@ -1106,6 +1862,7 @@ int comp_module_dump_ir(comp_module_t *module, FILE *f)
 	case cmt_csrc:
 	case cmt_chdr:
 	case cmt_ir:
+	case cmt_irb:
 		break;
 	case cmt_ic:
 	case cmt_obj:
@@ -1137,6 +1894,7 @@ int comp_module_dump_vric(comp_module_t *module, FILE *f)
 	case cmt_csrc:
 	case cmt_chdr:
 	case cmt_ir:
+	case cmt_irb:
 		break;
 	case cmt_ic:
 	case cmt_obj:
@@ -27,6 +27,7 @@
 #ifndef COMP_H
 #define COMP_H
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <types/comp.h>
 #include <types/lexer.h>
@@ -36,6 +37,10 @@ extern int comp_module_create(comp_t *, lexer_input_ops_t *, void *,
     comp_mtype_t, const char *, comp_module_t **);
 extern int comp_module_create_from_obj(comp_t *, const char *,
     comp_module_t **);
+extern int comp_module_create_from_objf(comp_t *, FILE *, const char *,
+    comp_module_t **);
+extern int comp_module_create_from_irb(comp_t *, const char *,
+    comp_module_t **);
 extern void comp_module_destroy(comp_module_t *);
 extern comp_module_t *comp_module_first(comp_t *);
 extern comp_module_t *comp_module_next(comp_module_t *);
@@ -43,6 +48,8 @@ extern int comp_module_make_ast(comp_module_t *);
 extern int comp_module_make_ir(comp_module_t *);
 extern int comp_module_make_vric(comp_module_t *);
 extern int comp_module_make_ic(comp_module_t *);
+extern int comp_module_make_pch(comp_module_t *, FILE *);
+extern int comp_module_save_irb(comp_module_t *, FILE *);
 extern int comp_make_tape(comp_t *, const char *);
 extern int comp_module_dump_preproc(comp_module_t *, FILE *);
 extern int comp_module_dump_ast(comp_module_t *, FILE *);
@@ -54,7 +61,21 @@ extern int comp_module_dump_obj(comp_module_t *, FILE *);
 extern void comp_destroy(comp_t *);
 extern int comp_module_compile(comp_module_t *, FILE *);
 extern int comp_module_emit(comp_module_t *, FILE *);
+extern int comp_module_set_bank(comp_module_t *, unsigned);
+extern int comp_load_lscript(comp_t *, const char *);
+extern int comp_get_stdlib_fname(comp_t *, char **);
+extern int comp_preload_stdlib(comp_t *);
+extern int comp_set_cache_dir(comp_t *, const char *);
+extern int comp_add_incldir(comp_t *, const char *);
+extern void comp_clear_incldirs(comp_t *);
+extern int comp_set_ident(comp_t *, const char *);
+extern int comp_set_pch(comp_t *, const char *);
+extern int comp_preload_pch(comp_t *, const char *);
+extern int comp_module_cache_lookup(comp_module_t *, lexer_input_ops_t *,
+    void *);
 extern int comp_link(comp_t *, comp_flags_t, FILE *);
+extern bool comp_has_bank(comp_t *, unsigned);
+extern int comp_save_bank(comp_t *, unsigned, FILE *);
 extern int comp_save_map(comp_t *, FILE *);
 extern int comp_save_tape(comp_t *, const char *);
 
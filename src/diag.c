@@ -0,0 +1,521 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Diagnostics sink
+ *
+ * Diagnostics are reported as structured entries (severity, check
+ * identifier, source range, message) and written in one of several
+ * formats: human-readable text (the traditional output format),
+ * JSON Lines (one JSON object per line) or a SARIF 2.1.0 log.
+ *
+ * Text and JSON Lines output consists of independent lines and can thus
+ * be concatenated. A SARIF log is a single JSON document, which is
+ * completed by diag_finish().
+ *
+ * Alternatively diagnostics can be passed to a callback function, which
+ * is useful when the checker is embedded in another program.
+ */
+
+#include <diag.h>
+#include <lexer.h>
+#include <merrno.h>
+#include <src_pos.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+	/** Size of buffer for an escaped character */
+	diag_esc_size = 8
+};
+
+/** Create diagnostics sink.
+ *
+ * @param fmt Output format
+ * @param tool Name of the tool producing the diagnostics
+ * @param f Output stream
+ * @param rdiag Place to store pointer to new diagnostics sink
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int diag_create(diag_fmt_t fmt, const char *tool, FILE *f, diag_t **rdiag)
+{
+	diag_t *diag;
+
+	diag = calloc(1, sizeof(diag_t));
+	if (diag == NULL)
+		return ENOMEM;
+
+	diag->tool = strdup(tool);
+	if (diag->tool == NULL) {
+		free(diag);
+		return ENOMEM;
+	}
+
+	diag->fmt = fmt;
+	diag->f = f;
+	*rdiag = diag;
+	return EOK;
+}
+
+/** Create diagnostics sink passing diagnostics to a callback function.
+ *
+ * @param cb Callback function
+ * @param arg Argument to the callback function
+ * @param rdiag Place to store pointer to new diagnostics sink
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int diag_create_cb(diag_report_cb_t cb, void *arg, diag_t **rdiag)
+{
+	diag_t *diag;
+	int rc;
+
+	rc = diag_create(dfmt_cb, "", NULL, &diag);
+	if (rc != EOK)
+		return rc;
+
+	diag->cb = cb;
+	diag->cb_arg = arg;
+	*rdiag = diag;
+	return EOK;
+}
+
+/** Destroy diagnostics sink.
+ *
+ * @param diag Diagnostics sink or @c NULL
+ */
+void diag_destroy(diag_t *diag)
+{
+	if (diag == NULL)
+		return;
+
+	free(diag->tool);
+	free(diag);
+}
+
+/** Set whether warnings are prefixed with 'Warning: ' in text format.
+ *
+ * @param diag Diagnostics sink
+ * @param sev_prefix @c true to prefix warnings with 'Warning: '
+ */
+void diag_set_sev_prefix(diag_t *diag, bool sev_prefix)
+{
+	diag->sev_prefix = sev_prefix;
+}
+
+/** Write buffer as a JSON string literal.
+ *
+ * @param diag Diagnostics sink
+ * @param str Buffer
+ * @param size Size of buffer in bytes
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_write_jbuf(diag_t *diag, const char *str, size_t size)
+{
+	const char *cp;
+	const char *run;
+	char esc[diag_esc_size];
+
+	if (fputc('"', diag->f) == EOF)
+		return EIO;
+
+	cp = str;
+	run = str;
+	while (cp < str + size) {
+		if (*cp == '"' || *cp == '\\' || (unsigned char)*cp < 0x20) {
+			/* Write characters that need no escaping at once */
+			if (cp > run && fwrite(run, 1, (size_t)(cp - run),
+			    diag->f) != (size_t)(cp - run))
+				return EIO;
+
+			if (*cp == '"' || *cp == '\\') {
+				esc[0] = '\\';
+				esc[1] = *cp;
+				esc[2] = '\0';
+			} else {
+				(void)snprintf(esc, sizeof(esc), "\\u%04x",
+				    (unsigned)(unsigned char)*cp);
+			}
+
+			if (fputs(esc, diag->f) < 0)
+				return EIO;
+
+			run = cp + 1;
+		}
+
+		++cp;
+	}
+
+	if (cp > run && fwrite(run, 1, (size_t)(cp - run), diag->f) !=
+	    (size_t)(cp - run))
+		return EIO;
+
+	if (fputc('"', diag->f) == EOF)
+		return EIO;
+
+	return EOK;
+}
+
+/** Write string as a JSON string literal.
+ *
+ * @param diag Diagnostics sink
+ * @param str String
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_write_jstr(diag_t *diag, const char *str)
+{
+	return diag_write_jbuf(diag, str, strlen(str));
+}
+
+/** Return string representation of severity.
+ *
+ * @param sev Severity
+ * @return Severity name (as used in SARIF)
+ */
+static const char *diag_sev_str(diag_sev_t sev)
+{
+	switch (sev) {
+	case dsev_warning:
+		return "warning";
+	case dsev_error:
+		return "error";
+	}
+
+	return NULL;
+}
+
+/** Report diagnostic in text format.
+ *
+ * @param diag Diagnostics sink
+ * @param entry Diagnostic
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_report_text(diag_t *diag, diag_entry_t *entry)
+{
+	int rc;
+
+	rc = lexer_dprint_tok_range(entry->tok, &entry->bpos, &entry->epos,
+	    diag->f);
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(diag->f, ": %s%s\n", diag->sev_prefix &&
+	    entry->sev == dsev_warning ? "Warning: " : "", entry->msg) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Report diagnostic in JSON Lines format.
+ *
+ * @param diag Diagnostics sink
+ * @param entry Diagnostic
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_report_jsonl(diag_t *diag, diag_entry_t *entry)
+{
+	size_t i;
+	int rc;
+
+	if (fputs("{\"file\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, src_pos_fname(&entry->bpos));
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(diag->f, ",\"line\":%lu,\"column\":%lu,"
+	    "\"end_line\":%lu,\"end_column\":%lu,\"severity\":\"%s\","
+	    "\"check\":", (unsigned long)entry->bpos.line,
+	    (unsigned long)entry->bpos.col, (unsigned long)entry->epos.line,
+	    (unsigned long)entry->epos.col, diag_sev_str(entry->sev)) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, entry->check);
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(diag->f, ",\"fixable\":%s,",
+	    entry->fixable ? "true" : "false") < 0)
+		return EIO;
+
+	if (entry->nfixes > 0) {
+		if (fputs("\"fixes\":[", diag->f) < 0)
+			return EIO;
+
+		for (i = 0; i < entry->nfixes; i++) {
+			if (fprintf(diag->f, "%s{\"line\":%lu,\"nlines\":%lu,"
+			    "\"text\":", i > 0 ? "," : "",
+			    entry->fixes[i].line, entry->fixes[i].nlines) < 0)
+				return EIO;
+
+			rc = diag_write_jbuf(diag, entry->fixes[i].text,
+			    entry->fixes[i].size);
+			if (rc != EOK)
+				return rc;
+
+			if (fputc('}', diag->f) == EOF)
+				return EIO;
+		}
+
+		if (fputs("],", diag->f) < 0)
+			return EIO;
+	}
+
+	if (fputs("\"message\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, entry->msg);
+	if (rc != EOK)
+		return rc;
+
+	if (fputs("}\n", diag->f) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Write SARIF log header, if it has not been written yet.
+ *
+ * @param diag Diagnostics sink
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_sarif_start(diag_t *diag)
+{
+	int rc;
+
+	if (diag->started)
+		return EOK;
+
+	if (fputs("{\"version\":\"2.1.0\",\"$schema\":"
+	    "\"https://json.schemastore.org/sarif-2.1.0.json\","
+	    "\"runs\":[{\"tool\":{\"driver\":{\"name\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, diag->tool);
+	if (rc != EOK)
+		return rc;
+
+	if (fputs("}},\"results\":[\n", diag->f) < 0)
+		return EIO;
+
+	diag->started = true;
+	return EOK;
+}
+
+/** Write SARIF fixes of a result.
+ *
+ * Each fix-it edit is written as a replacement of whole lines, i.e.
+ * a deleted region starting at column 1 of the first replaced line and
+ * ending at column 1 of the line following the last replaced line.
+ *
+ * @param diag Diagnostics sink
+ * @param entry Diagnostic
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_sarif_fixes(diag_t *diag, diag_entry_t *entry)
+{
+	size_t i;
+	int rc;
+
+	if (fputs("\"fixes\":[{\"artifactChanges\":[{\"artifactLocation\":"
+	    "{\"uri\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, src_pos_fname(&entry->bpos));
+	if (rc != EOK)
+		return rc;
+
+	if (fputs("},\"replacements\":[", diag->f) < 0)
+		return EIO;
+
+	for (i = 0; i < entry->nfixes; i++) {
+		if (fprintf(diag->f, "%s{\"deletedRegion\":{\"startLine\":%lu,"
+		    "\"startColumn\":1,\"endLine\":%lu,\"endColumn\":1},"
+		    "\"insertedContent\":{\"text\":", i > 0 ? "," : "",
+		    entry->fixes[i].line,
+		    entry->fixes[i].line + entry->fixes[i].nlines) < 0)
+			return EIO;
+
+		rc = diag_write_jbuf(diag, entry->fixes[i].text,
+		    entry->fixes[i].size);
+		if (rc != EOK)
+			return rc;
+
+		if (fputs("}}", diag->f) < 0)
+			return EIO;
+	}
+
+	if (fputs("]}]}],", diag->f) < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Report diagnostic as a SARIF result.
+ *
+ * SARIF end columns are exclusive, while our source ranges are
+ * inclusive.
+ *
+ * @param diag Diagnostics sink
+ * @param entry Diagnostic
+ * @return EOK on success, EIO on I/O error
+ */
+static int diag_report_sarif(diag_t *diag, diag_entry_t *entry)
+{
+	int rc;
+
+	rc = diag_sarif_start(diag);
+	if (rc != EOK)
+		return rc;
+
+	if (diag->nentries > 0 && fputs(",\n", diag->f) < 0)
+		return EIO;
+
+	if (fputs("{\"ruleId\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, entry->check);
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(diag->f, ",\"level\":\"%s\",\"message\":{\"text\":",
+	    diag_sev_str(entry->sev)) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, entry->msg);
+	if (rc != EOK)
+		return rc;
+
+	if (fputs("},\"locations\":[{\"physicalLocation\":"
+	    "{\"artifactLocation\":{\"uri\":", diag->f) < 0)
+		return EIO;
+
+	rc = diag_write_jstr(diag, src_pos_fname(&entry->bpos));
+	if (rc != EOK)
+		return rc;
+
+	if (fprintf(diag->f, "},\"region\":{\"startLine\":%lu,"
+	    "\"startColumn\":%lu,\"endLine\":%lu,\"endColumn\":%lu}}}],",
+	    (unsigned long)entry->bpos.line, (unsigned long)entry->bpos.col,
+	    (unsigned long)entry->epos.line,
+	    (unsigned long)entry->epos.col + 1) < 0)
+		return EIO;
+
+	if (entry->nfixes > 0) {
+		rc = diag_sarif_fixes(diag, entry);
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (fprintf(diag->f, "\"properties\":{\"fixable\":%s}}",
+	    entry->fixable ? "true" : "false") < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Report diagnostic.
+ *
+ * @param diag Diagnostics sink
+ * @param entry Diagnostic
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_report(diag_t *diag, diag_entry_t *entry)
+{
+	int rc;
+
+	switch (diag->fmt) {
+	case dfmt_text:
+		rc = diag_report_text(diag, entry);
+		break;
+	case dfmt_jsonl:
+		rc = diag_report_jsonl(diag, entry);
+		break;
+	case dfmt_sarif:
+		rc = diag_report_sarif(diag, entry);
+		break;
+	case dfmt_cb:
+		rc = diag->cb(diag->cb_arg, entry);
+		break;
+	default:
+		rc = EINVAL;
+		break;
+	}
+
+	if (rc != EOK)
+		return rc;
+
+	++diag->nentries;
+	return EOK;
+}
+
+/** Finish writing diagnostics.
+ *
+ * This completes the SARIF log (which is written even if no diagnostics
+ * were reported) and flushes the output stream.
+ *
+ * @param diag Diagnostics sink
+ * @return EOK on success, EIO on I/O error
+ */
+int diag_finish(diag_t *diag)
+{
+	int rc;
+
+	if (diag->fmt == dfmt_sarif) {
+		rc = diag_sarif_start(diag);
+		if (rc != EOK)
+			return rc;
+
+		if (fputs("\n]}]}\n", diag->f) < 0)
+			return EIO;
+	}
+
+	if (diag->f == NULL)
+		return EOK;
+
+	if (fflush(diag->f) == EOF)
+		return EIO;
+
+	return EOK;
+}
+
+/** Parse diagnostic output format name.
+ *
+ * @param str Format name ("text", "jsonl" or "sarif")
+ * @param rfmt Place to store format
+ * @return EOK on success, EINVAL if @a str is not a valid format name
+ */
+int diag_fmt_parse(const char *str, diag_fmt_t *rfmt)
+{
+	if (strcmp(str, "text") == 0)
+		*rfmt = dfmt_text;
+	else if (strcmp(str, "jsonl") == 0)
+		*rfmt = dfmt_jsonl;
+	else if (strcmp(str, "sarif") == 0)
+		*rfmt = dfmt_sarif;
+	else
+		return EINVAL;
+
+	return EOK;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Directory walker
+ *
+ * Walks a directory tree, calling a function for every regular file.
+ * Entries of each directory are visited in sorted order, so that
+ * the order does not depend on the file system. Symbolic links are
+ * not followed.
+ *
+ * Reading directories is only available when the host provides
+ * opendir() and lstat() (HAVE_DIRENT is defined). Otherwise every path
+ * is taken to be a regular file.
+ */
+
+#include <dirwalk.h>
+#include <merrno.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_DIRENT
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#ifdef HAVE_DIRENT
+
+/** Compare two directory entry names for sorting.
+ *
+ * @param a Pointer to first name
+ * @param b Pointer to second name
+ * @return Less than, equal to or greater than zero if @a a sorts before,
+ *         same as or after @a b
+ */
+static int dirwalk_name_cmp(const void *a, const void *b)
+{
+	return strcmp(*(const char **)a, *(const char **)b);
+}
+
+/** Read names of directory entries.
+ *
+ * @param path Directory path
+ * @param rnames Place to store pointer to array of names
+ * @param rcount Place to store number of names
+ * @return EOK on success, EIO if the directory cannot be read,
+ *         ENOMEM if out of memory
+ */
+static int dirwalk_read_dir(const char *path, char ***rnames,
+    size_t *rcount)
+{
+	DIR *dir;
+	struct dirent *de;
+	char **names = NULL;
+	char **nnames;
+	size_t count = 0;
+	size_t alloc = 0;
+	size_t i;
+	int rc;
+
+	dir = opendir(path);
+	if (dir == NULL)
+		return EIO;
+
+	while ((de = readdir(dir)) != NULL) {
+		if (strcmp(de->d_name, ".") == 0 ||
+		    strcmp(de->d_name, "..") == 0)
+			continue;
+
+		if (count >= alloc) {
+			alloc = alloc > 0 ? 2 * alloc : 16;
+			nnames = realloc(names, alloc * sizeof(char *));
+			if (nnames == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+
+			names = nnames;
+		}
+
+		names[count] = strdup(de->d_name);
+		if (names[count] == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		++count;
+	}
+
+	(void)closedir(dir);
+	qsort(names, count, sizeof(char *), dirwalk_name_cmp);
+	*rnames = names;
+	*rcount = count;
+	return EOK;
+error:
+	for (i = 0; i < count; i++)
+		free(names[i]);
+	free(names);
+	(void)closedir(dir);
+	return rc;
+}
+
+/** Walk directory.
+ *
+ * @param path Directory path
+ * @param fn Function to call for every regular file
+ * @param arg Argument to @a fn
+ * @return EOK on success, EIO if a directory cannot be read, ENOMEM if
+ *         out of memory or error code returned by @a fn
+ */
+static int dirwalk_dir(const char *path, dirwalk_fn_t fn, void *arg)
+{
+	char **names;
+	size_t count;
+	size_t i;
+	size_t plen;
+	char *epath = NULL;
+	int rc;
+
+	rc = dirwalk_read_dir(path, &names, &count);
+	if (rc != EOK)
+		return rc;
+
+	plen = strlen(path);
+	if (plen > 0 && path[plen - 1] == '/')
+		--plen;
+
+	for (i = 0; i < count; i++) {
+		epath = malloc(plen + 1 + strlen(names[i]) + 1);
+		if (epath == NULL) {
+			rc = ENOMEM;
+			goto out;
+		}
+
+		memcpy(epath, path, plen);
+		epath[plen] = '/';
+		strcpy(epath + plen + 1, names[i]);
+
+		rc = dirwalk(epath, fn, arg);
+		free(epath);
+		if (rc != EOK)
+			goto out;
+	}
+
+	rc = EOK;
+out:
+	for (i = 0; i < count; i++)
+		free(names[i]);
+	free(names);
+	return rc;
+}
+
+/** Walk directory tree.
+ *
+ * If @a path is a regular file, @a fn is called for it. If it is
+ * a directory, it is walked recursively. Other files (including
+ * symbolic links) are skipped.
+ *
+ * @param path Path to file or directory
+ * @param fn Function to call for every regular file
+ * @param arg Argument to @a fn
+ * @return EOK on success, ENOENT if @a path does not exist, EIO if
+ *         a directory cannot be read, ENOMEM if out of memory or error
+ *         code returned by @a fn
+ */
+int dirwalk(const char *path, dirwalk_fn_t fn, void *arg)
+{
+	struct stat st;
+
+	if (lstat(path, &st) < 0)
+		return ENOENT;
+
+	if (S_ISDIR(st.st_mode))
+		return dirwalk_dir(path, fn, arg);
+
+	if (S_ISREG(st.st_mode))
+		return fn(arg, path);
+
+	return EOK;
+}
+
+#else
+
+/** Walk directory tree.
+ *
+ * Directories cannot be read, @a path is taken to be a regular file.
+ *
+ * @param path Path to file
+ * @param fn Function to call for the file
+ * @param arg Argument to @a fn
+ * @return EOK on success or error code returned by @a fn
+ */
+int dirwalk(const char *path, dirwalk_fn_t fn, void *arg)
+{
+	return fn(arg, path);
+}
+
+#endif
@@ -27,13 +27,21 @@
 #include <file_input.h>
 #include <merrno.h>
 #include <src_pos.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 static int file_lexer_read(void *, char *, size_t, size_t *, src_pos_t *);
+static int file_lexer_whole(void *, const char **, size_t *, src_pos_t *);
+
+enum {
+	/** Initial size of buffer for whole file contents */
+	file_input_whole_init = 4096
+};
 
 lexer_input_ops_t lexer_file_input = {
-	.read = file_lexer_read
+	.read = file_lexer_read,
+	.whole = file_lexer_whole
 };
 
 /** Lexer input from file(s).
@@ -66,6 +74,68 @@ static int file_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 	return EOK;
 }
 
+/** Lexer input from file as a single buffer.
+ *
+ * Reads the rest of the file into memory. The buffer is owned by
+ * the file input and remains valid until it is destroyed.
+ *
+ * @param arg Argument (file_input_t *)
+ * @param rbuf Place to store pointer to null-terminated buffer
+ * @param rsize Place to store number of characters in buffer
+ * @param rbpos Place to store position of the beginning of the buffer
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ *         or if the contents were already read
+ */
+static int file_lexer_whole(void *arg, const char **rbuf, size_t *rsize,
+    src_pos_t *rbpos)
+{
+	file_input_t *finput = (file_input_t *)arg;
+	char *data = NULL;
+	char *ndata;
+	size_t alloc;
+	size_t size;
+	size_t nr;
+
+	if (finput->data != NULL)
+		return EIO;
+
+	alloc = file_input_whole_init;
+	size = 0;
+	data = malloc(alloc);
+	if (data == NULL)
+		return ENOMEM;
+
+	while (true) {
+		/* Leave room for the terminating null character */
+		nr = fread(data + size, 1, alloc - size - 1, finput->f);
+		size += nr;
+		if (ferror(finput->f) != 0) {
+			free(data);
+			return EIO;
+		}
+
+		if (size < alloc - 1)
+			break;
+
+		ndata = realloc(data, 2 * alloc);
+		if (ndata == NULL) {
+			free(data);
+			return ENOMEM;
+		}
+
+		data = ndata;
+		alloc *= 2;
+	}
+
+	data[size] = '\0';
+	finput->data = data;
+
+	*rbuf = data;
+	*rsize = size;
+	*rbpos = finput->cpos;
+	return EOK;
+}
+
 /** Create file input.
  *
  * @param f File stream
@@ -76,6 +146,7 @@ static int file_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 int file_input_create(FILE *f, const char *fname, file_input_t **rfinput)
 {
 	file_input_t *finput = NULL;
+	int rc;
 
 	finput = calloc(1, sizeof(file_input_t));
 	if (finput == NULL)
@@ -83,7 +154,11 @@ int file_input_create(FILE *f, const char *fname, file_input_t **rfinput)
 
 	finput->f = f;
 
-	src_pos_set(&finput->cpos, fname, 1, 1);
+	rc = src_pos_set(&finput->cpos, fname, 1, 1);
+	if (rc != EOK) {
+		free(finput);
+		return rc;
+	}
 
 	*rfinput = finput;
 	return EOK;
@@ -98,5 +173,7 @@ void file_input_destroy(file_input_t *finput)
 	if (finput == NULL)
 		return;
 
+	if (finput->data != NULL)
+		free(finput->data);
 	free(finput);
 }
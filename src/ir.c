@@ -2042,7 +2042,7 @@ int ir_oper_list_create(ir_oper_list_t **rlist)
 
 /** Create IR variable operand.
  *
- * @param value Value
+ * @param varname Variable name
  * @param rvar Place to store pointer to new IR variable operand
  * @return EOK on success, ENOMEM if out of memory
  */
@@ -2069,6 +2069,83 @@ int ir_oper_var_create(const char *varname, ir_oper_var_t **rvar)
 	return EOK;
 }
 
+/** Create IR variable operand referring to a numbered temporary.
+ *
+ * @param tempno Temporary number
+ * @param rvar Place to store pointer to new IR variable operand
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int ir_oper_temp_create(unsigned tempno, ir_oper_var_t **rvar)
+{
+	ir_oper_var_t *var;
+
+	var = calloc(1, sizeof(ir_oper_var_t));
+	if (var == NULL)
+		return ENOMEM;
+
+	var->oper.optype = iro_var;
+	var->oper.ext = (void *) var;
+	var->varname = NULL;
+	var->tempno = tempno;
+
+	*rvar = var;
+	return EOK;
+}
+
+/** Get name of variable referenced by IR variable operand.
+ *
+ * The name of a numbered temporary is formatted into @a buf.
+ *
+ * @param var IR variable operand
+ * @param buf Buffer of ir_temp_name_size characters
+ * @return Variable name
+ */
+const char *ir_oper_var_name(ir_oper_var_t *var, char *buf)
+{
+	if (var->varname != NULL)
+		return var->varname;
+
+	(void)snprintf(buf, ir_temp_name_size, "%%%u", var->tempno);
+	return buf;
+}
+
+/** Parse name of numbered temporary.
+ *
+ * @param ident Variable identifier
+ * @param rtempno Place to store temporary number
+ * @return EOK on success, EINVAL if @a ident is not the name of
+ *         a numbered temporary (in canonical form)
+ */
+int ir_temp_parse(const char *ident, unsigned *rtempno)
+{
+	const char *cp;
+	unsigned tempno;
+
+	if (ident[0] != '%' || ident[1] < '0' || ident[1] > '9')
+		return EINVAL;
+
+	/* No leading zeroes, so that printing gives the same name */
+	if (ident[1] == '0' && ident[2] != '\0')
+		return EINVAL;
+
+	tempno = 0;
+	cp = ident + 1;
+	while (*cp != '\0') {
+		if (*cp < '0' || *cp > '9')
+			return EINVAL;
+
+		/* Overflow */
+		if (tempno > (~0U - 9) / 10)
+			return EINVAL;
+
+		tempno = tempno * 10 + (unsigned)(*cp - '0');
+		++cp;
+	}
+
+	*rtempno = tempno;
+	return EOK;
+}
+
 /** Print IR immediate operand.
  *
  * @param imm IR immediate operand
@@ -2138,9 +2215,10 @@ static int ir_oper_list_print(ir_oper_list_t *list, FILE *f)
  */
 static int ir_oper_var_print(ir_oper_var_t *var, FILE *f)
 {
+	char buf[ir_temp_name_size];
 	int rv;
 
-	rv = fputs(var->varname, f);
+	rv = fputs(ir_oper_var_name(var, buf), f);
 	if (rv < 0)
 		return EIO;
 
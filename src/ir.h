@@ -118,6 +118,9 @@ extern void ir_instr_destroy(ir_instr_t *);
 extern int ir_oper_imm_create(int64_t, ir_oper_imm_t **);
 extern int ir_oper_list_create(ir_oper_list_t **);
 extern int ir_oper_var_create(const char *, ir_oper_var_t **);
+extern int ir_oper_temp_create(unsigned, ir_oper_var_t **);
+extern const char *ir_oper_var_name(ir_oper_var_t *, char *);
+extern int ir_temp_parse(const char *, unsigned *);
 extern int ir_oper_print(ir_oper_t *, FILE *);
 extern void ir_oper_destroy(ir_oper_t *);
 extern void ir_oper_list_append(ir_oper_list_t *, ir_oper_t *);
@@ -0,0 +1,1594 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Binary IR format
+ *
+ * A compact binary encoding of an IR module which can be saved and
+ * loaded again without lexing and parsing textual IR.
+ *
+ * The file starts with a signature and version (32-bit little-endian
+ * integers), followed by the string table and the declarations.
+ * All other integers are stored as variable-length integers with seven
+ * bits per byte (least significant group first, the top bit of each byte
+ * indicates that more bytes follow). Signed integers are zigzag-encoded
+ * first, so that values of small magnitude stay short.
+ *
+ * The string table is a count followed by the strings, each stored as
+ * its length followed by the characters and a null terminator.
+ * Identifiers are stored as one plus their index in the string table
+ * (zero stands for no string), so each distinct string is only stored
+ * once.
+ */
+
+#include <adt/hmap.h>
+#include <adt/list.h>
+#include <assert.h>
+#include <ir.h>
+#include <irbin.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+	/** Initial size of writer buffer */
+	irbin_wr_init_size = 256,
+	/** Size of buffer for reading files */
+	irbin_buf_size = 64,
+	/** Maximum number of bytes in a variable-length integer */
+	irbin_uv_max_bytes = 10,
+	/** Maximum nesting depth of type expressions and list operands */
+	irbin_max_depth = 64
+};
+
+/** Operand kinds */
+enum {
+	/** No operand */
+	irbin_op_none,
+	/** Immediate operand */
+	irbin_op_imm,
+	/** List operand */
+	irbin_op_list,
+	/** Named variable operand */
+	irbin_op_var,
+	/** Numbered temporary operand */
+	irbin_op_temp
+};
+
+/** Append bytes to binary IR writer.
+ *
+ * If we run out of memory, the error is remembered in the writer.
+ *
+ * @param wr Writer
+ * @param data Data
+ * @param size Size of data in bytes
+ */
+static void irbin_wr_bytes(irbin_wr_t *wr, const void *data, size_t size)
+{
+	uint8_t *ndata;
+	size_t nalloc;
+
+	if (wr->error || size == 0)
+		return;
+
+	if (wr->alloc - wr->size < size) {
+		nalloc = wr->alloc > 0 ? 2 * wr->alloc : irbin_wr_init_size;
+		while (nalloc - wr->size < size)
+			nalloc *= 2;
+
+		ndata = realloc(wr->data, nalloc);
+		if (ndata == NULL) {
+			wr->error = true;
+			return;
+		}
+
+		wr->data = ndata;
+		wr->alloc = nalloc;
+	}
+
+	memcpy(wr->data + wr->size, data, size);
+	wr->size += size;
+}
+
+/** Write 32-bit unsigned integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+static void irbin_wr_u32(irbin_wr_t *wr, uint32_t v)
+{
+	uint8_t b[4];
+
+	b[0] = (uint8_t)(v & 0xff);
+	b[1] = (uint8_t)((v >> 8) & 0xff);
+	b[2] = (uint8_t)((v >> 16) & 0xff);
+	b[3] = (uint8_t)((v >> 24) & 0xff);
+	irbin_wr_bytes(wr, b, 4);
+}
+
+/** Write unsigned variable-length integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+static void irbin_wr_uv(irbin_wr_t *wr, uint64_t v)
+{
+	uint8_t b[irbin_uv_max_bytes];
+	size_t n;
+
+	n = 0;
+	do {
+		b[n] = (uint8_t)(v & 0x7f);
+		v >>= 7;
+		if (v != 0)
+			b[n] |= 0x80;
+		++n;
+	} while (v != 0);
+
+	irbin_wr_bytes(wr, b, n);
+}
+
+/** Write signed variable-length integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+static void irbin_wr_sv(irbin_wr_t *wr, int64_t v)
+{
+	/* Zigzag encoding: 0, -1, 1, -2, 2, ... -> 0, 1, 2, 3, 4, ... */
+	if (v < 0)
+		irbin_wr_uv(wr, ((uint64_t)(-(v + 1)) << 1) | 1);
+	else
+		irbin_wr_uv(wr, (uint64_t)v << 1);
+}
+
+/** Read bytes from binary IR reader.
+ *
+ * @param rd Reader
+ * @param size Number of bytes
+ * @return Pointer to the bytes or @c NULL if there is not enough data
+ *         (the error is remembered in the reader)
+ */
+static const uint8_t *irbin_rd_bytes(irbin_rd_t *rd, size_t size)
+{
+	const uint8_t *p;
+
+	if (rd->error || rd->size - rd->pos < size) {
+		rd->error = true;
+		return NULL;
+	}
+
+	p = rd->data + rd->pos;
+	rd->pos += size;
+	return p;
+}
+
+/** Read 32-bit unsigned integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+static uint32_t irbin_rd_u32(irbin_rd_t *rd)
+{
+	const uint8_t *p;
+
+	p = irbin_rd_bytes(rd, 4);
+	if (p == NULL)
+		return 0;
+
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	    ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** Read unsigned variable-length integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+static uint64_t irbin_rd_uv(irbin_rd_t *rd)
+{
+	const uint8_t *p;
+	uint64_t v;
+	unsigned shift;
+	unsigned i;
+
+	v = 0;
+	shift = 0;
+	for (i = 0; i < irbin_uv_max_bytes; i++) {
+		p = irbin_rd_bytes(rd, 1);
+		if (p == NULL)
+			return 0;
+
+		/* The last byte can only hold the topmost bit */
+		if (i == irbin_uv_max_bytes - 1 && (p[0] & 0xfe) != 0)
+			break;
+
+		v |= (uint64_t)(p[0] & 0x7f) << shift;
+		if ((p[0] & 0x80) == 0)
+			return v;
+
+		shift += 7;
+	}
+
+	rd->error = true;
+	return 0;
+}
+
+/** Read signed variable-length integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+static int64_t irbin_rd_sv(irbin_rd_t *rd)
+{
+	uint64_t u;
+
+	u = irbin_rd_uv(rd);
+	if ((u & 1) != 0)
+		return -(int64_t)(u >> 1) - 1;
+
+	return (int64_t)(u >> 1);
+}
+
+/** Read variable-length integer that must fit into unsigned.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+static unsigned irbin_rd_uns(irbin_rd_t *rd)
+{
+	uint64_t v;
+
+	v = irbin_rd_uv(rd);
+	if ((uint64_t)(unsigned)v != v) {
+		rd->error = true;
+		return 0;
+	}
+
+	return (unsigned)v;
+}
+
+/** Read number of items that follow.
+ *
+ * Every item occupies at least one byte, so the count cannot be larger
+ * than the number of remaining bytes.
+ *
+ * @param rd Reader
+ * @return Number of items (zero on error)
+ */
+static size_t irbin_rd_count(irbin_rd_t *rd)
+{
+	uint64_t n;
+
+	n = irbin_rd_uv(rd);
+	if (rd->error || n > (uint64_t)(rd->size - rd->pos)) {
+		rd->error = true;
+		return 0;
+	}
+
+	return (size_t)n;
+}
+
+/** Read flag (zero or one).
+ *
+ * @param rd Reader
+ * @return Flag value (@c false on error)
+ */
+static bool irbin_rd_flag(irbin_rd_t *rd)
+{
+	uint64_t v;
+
+	v = irbin_rd_uv(rd);
+	if (v > 1) {
+		rd->error = true;
+		return false;
+	}
+
+	return v != 0;
+}
+
+/** Write optional string.
+ *
+ * The string is added to the string table if it is not there yet.
+ *
+ * @param save Binary IR saving
+ * @param str String or @c NULL
+ */
+static void irbin_save_optstr(irbin_save_t *save, const char *str)
+{
+	irbin_str_t *entry;
+	int rc;
+
+	if (str == NULL) {
+		irbin_wr_uv(&save->wr, 0);
+		return;
+	}
+
+	entry = (irbin_str_t *)hmap_find_str(&save->bystr, str);
+	if (entry == NULL) {
+		entry = calloc(1, sizeof(irbin_str_t));
+		if (entry == NULL) {
+			save->wr.error = true;
+			return;
+		}
+
+		entry->str = str;
+		entry->idx = save->nstrs;
+
+		rc = hmap_insert_str(&save->bystr, entry->str, entry);
+		if (rc != EOK) {
+			free(entry);
+			save->wr.error = true;
+			return;
+		}
+
+		list_append(&entry->lstrs, &save->strs);
+		++save->nstrs;
+	}
+
+	irbin_wr_uv(&save->wr, (uint64_t)entry->idx + 1);
+}
+
+/** Write string.
+ *
+ * @param save Binary IR saving
+ * @param str String
+ */
+static void irbin_save_str(irbin_save_t *save, const char *str)
+{
+	assert(str != NULL);
+	irbin_save_optstr(save, str);
+}
+
+/** Write type expression.
+ *
+ * @param save Binary IR saving
+ * @param texpr Type expression
+ */
+static void irbin_save_texpr(irbin_save_t *save, ir_texpr_t *texpr)
+{
+	irbin_wr_uv(&save->wr, (uint64_t)texpr->tetype);
+
+	switch (texpr->tetype) {
+	case irt_int:
+		irbin_wr_uv(&save->wr, texpr->t.tint.width);
+		break;
+	case irt_ptr:
+		irbin_wr_uv(&save->wr, texpr->t.tptr.width);
+		break;
+	case irt_array:
+		irbin_wr_uv(&save->wr, texpr->t.tarray.asize);
+		irbin_save_texpr(save, texpr->t.tarray.etexpr);
+		break;
+	case irt_ident:
+		irbin_save_str(save, texpr->t.tident.ident);
+		break;
+	case irt_va_list:
+		break;
+	}
+}
+
+/** Write optional type expression.
+ *
+ * @param save Binary IR saving
+ * @param texpr Type expression or @c NULL
+ */
+static void irbin_save_opttexpr(irbin_save_t *save, ir_texpr_t *texpr)
+{
+	irbin_wr_uv(&save->wr, texpr != NULL ? 1 : 0);
+	if (texpr != NULL)
+		irbin_save_texpr(save, texpr);
+}
+
+/** Write optional operand.
+ *
+ * @param save Binary IR saving
+ * @param oper Operand or @c NULL
+ */
+static void irbin_save_oper(irbin_save_t *save, ir_oper_t *oper)
+{
+	ir_oper_imm_t *imm;
+	ir_oper_list_t *list;
+	ir_oper_var_t *var;
+	ir_oper_t *elem;
+
+	if (oper == NULL) {
+		irbin_wr_uv(&save->wr, irbin_op_none);
+		return;
+	}
+
+	switch (oper->optype) {
+	case iro_imm:
+		imm = (ir_oper_imm_t *)oper->ext;
+		irbin_wr_uv(&save->wr, irbin_op_imm);
+		irbin_wr_sv(&save->wr, imm->value);
+		break;
+	case iro_list:
+		list = (ir_oper_list_t *)oper->ext;
+		irbin_wr_uv(&save->wr, irbin_op_list);
+		irbin_wr_uv(&save->wr, list_count(&list->list));
+
+		elem = ir_oper_list_first(list);
+		while (elem != NULL) {
+			irbin_save_oper(save, elem);
+			elem = ir_oper_list_next(elem);
+		}
+		break;
+	case iro_var:
+		var = (ir_oper_var_t *)oper->ext;
+		if (var->varname != NULL) {
+			irbin_wr_uv(&save->wr, irbin_op_var);
+			irbin_save_str(save, var->varname);
+		} else {
+			irbin_wr_uv(&save->wr, irbin_op_temp);
+			irbin_wr_uv(&save->wr, var->tempno);
+		}
+		break;
+	}
+}
+
+/** Write instruction.
+ *
+ * @param save Binary IR saving
+ * @param instr Instruction
+ */
+static void irbin_save_instr(irbin_save_t *save, ir_instr_t *instr)
+{
+	irbin_wr_uv(&save->wr, (uint64_t)instr->itype);
+	irbin_wr_uv(&save->wr, instr->width);
+	irbin_save_oper(save, instr->dest);
+	irbin_save_oper(save, instr->op1);
+	irbin_save_oper(save, instr->op2);
+	irbin_save_opttexpr(save, instr->opt);
+}
+
+/** Write labeled block.
+ *
+ * @param save Binary IR saving
+ * @param lblock Labeled block
+ */
+static void irbin_save_lblock(irbin_save_t *save, ir_lblock_t *lblock)
+{
+	ir_lblock_entry_t *entry;
+
+	irbin_wr_uv(&save->wr, list_count(&lblock->entries));
+
+	entry = ir_lblock_first(lblock);
+	while (entry != NULL) {
+		irbin_save_optstr(save, entry->label);
+		irbin_wr_uv(&save->wr, entry->instr != NULL ? 1 : 0);
+		if (entry->instr != NULL)
+			irbin_save_instr(save, entry->instr);
+
+		entry = ir_lblock_next(entry);
+	}
+}
+
+/** Write data block.
+ *
+ * @param save Binary IR saving
+ * @param dblock Data block
+ */
+static void irbin_save_dblock(irbin_save_t *save, ir_dblock_t *dblock)
+{
+	ir_dblock_entry_t *entry;
+	ir_dentry_t *dentry;
+
+	irbin_wr_uv(&save->wr, list_count(&dblock->entries));
+
+	entry = ir_dblock_first(dblock);
+	while (entry != NULL) {
+		dentry = entry->dentry;
+		irbin_wr_uv(&save->wr, (uint64_t)dentry->dtype);
+		irbin_wr_uv(&save->wr, dentry->width);
+		irbin_save_optstr(save, dentry->symbol);
+		irbin_wr_sv(&save->wr, dentry->value);
+
+		entry = ir_dblock_next(entry);
+	}
+}
+
+/** Write variable declaration.
+ *
+ * @param save Binary IR saving
+ * @param var Variable
+ */
+static void irbin_save_var(irbin_save_t *save, ir_var_t *var)
+{
+	irbin_save_str(save, var->ident);
+	irbin_save_texpr(save, var->vtype);
+	irbin_wr_uv(&save->wr, (uint64_t)var->linkage);
+	irbin_wr_uv(&save->wr, var->dblock != NULL ? 1 : 0);
+	if (var->dblock != NULL)
+		irbin_save_dblock(save, var->dblock);
+}
+
+/** Write procedure declaration.
+ *
+ * @param save Binary IR saving
+ * @param proc Procedure
+ */
+static void irbin_save_proc(irbin_save_t *save, ir_proc_t *proc)
+{
+	ir_proc_arg_t *arg;
+	ir_proc_attr_t *attr;
+	ir_lvar_t *lvar;
+
+	irbin_save_str(save, proc->ident);
+	irbin_wr_uv(&save->wr, (uint64_t)proc->linkage);
+
+	/* The labeled block comes first as it is needed to create the proc. */
+	irbin_wr_uv(&save->wr, proc->lblock != NULL ? 1 : 0);
+	if (proc->lblock != NULL)
+		irbin_save_lblock(save, proc->lblock);
+
+	irbin_wr_uv(&save->wr, proc->variadic ? 1 : 0);
+	irbin_save_opttexpr(save, proc->rtype);
+
+	irbin_wr_uv(&save->wr, list_count(&proc->args));
+	arg = ir_proc_first_arg(proc);
+	while (arg != NULL) {
+		irbin_save_str(save, arg->ident);
+		irbin_save_texpr(save, arg->atype);
+		arg = ir_proc_next_arg(arg);
+	}
+
+	irbin_wr_uv(&save->wr, list_count(&proc->attrs));
+	attr = ir_proc_first_attr(proc);
+	while (attr != NULL) {
+		irbin_save_str(save, attr->ident);
+		attr = ir_proc_next_attr(attr);
+	}
+
+	irbin_wr_uv(&save->wr, list_count(&proc->lvars));
+	lvar = ir_proc_first_lvar(proc);
+	while (lvar != NULL) {
+		irbin_save_str(save, lvar->ident);
+		irbin_save_texpr(save, lvar->vtype);
+		lvar = ir_proc_next_lvar(lvar);
+	}
+}
+
+/** Write record type declaration.
+ *
+ * @param save Binary IR saving
+ * @param record Record type
+ */
+static void irbin_save_record(irbin_save_t *save, ir_record_t *record)
+{
+	ir_record_elem_t *elem;
+
+	irbin_save_str(save, record->ident);
+	irbin_wr_uv(&save->wr, (uint64_t)record->rtype);
+
+	irbin_wr_uv(&save->wr, list_count(&record->elems));
+	elem = ir_record_first(record);
+	while (elem != NULL) {
+		irbin_save_str(save, elem->ident);
+		irbin_save_texpr(save, elem->etype);
+		elem = ir_record_next(elem);
+	}
+}
+
+/** Write module declarations.
+ *
+ * @param save Binary IR saving
+ * @param module IR module
+ */
+static void irbin_save_module(irbin_save_t *save, ir_module_t *module)
+{
+	ir_decln_t *decln;
+
+	irbin_wr_uv(&save->wr, list_count(&module->declns));
+
+	decln = ir_module_first(module);
+	while (decln != NULL) {
+		irbin_wr_uv(&save->wr, (uint64_t)decln->dtype);
+
+		switch (decln->dtype) {
+		case ird_var:
+			irbin_save_var(save, (ir_var_t *)decln->ext);
+			break;
+		case ird_proc:
+			irbin_save_proc(save, (ir_proc_t *)decln->ext);
+			break;
+		case ird_record:
+			irbin_save_record(save, (ir_record_t *)decln->ext);
+			break;
+		}
+
+		decln = ir_module_next(decln);
+	}
+}
+
+/** Save IR module in binary format to a memory buffer.
+ *
+ * @param module IR module
+ * @param rdata Place to store pointer to newly allocated data
+ * @param rsize Place to store size of data in bytes
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int irbin_save_buf(ir_module_t *module, uint8_t **rdata, size_t *rsize)
+{
+	irbin_save_t save;
+	irbin_wr_t wr;
+	irbin_str_t *entry;
+	link_t *link;
+	size_t len;
+	int rc;
+
+	memset(&save, 0, sizeof(save));
+	memset(&wr, 0, sizeof(wr));
+	list_initialize(&save.strs);
+	hmap_initialize(&save.bystr, hmk_str);
+
+	/* Module contents, collecting the string table */
+	irbin_save_module(&save, module);
+
+	irbin_wr_u32(&wr, irbin_file_sign);
+	irbin_wr_u32(&wr, irbin_file_major);
+	irbin_wr_u32(&wr, irbin_file_minor);
+
+	irbin_wr_uv(&wr, save.nstrs);
+	link = list_first(&save.strs);
+	while (link != NULL) {
+		entry = list_get_instance(link, irbin_str_t, lstrs);
+		len = strlen(entry->str);
+		irbin_wr_uv(&wr, len);
+		irbin_wr_bytes(&wr, entry->str, len + 1);
+		link = list_next(link, &save.strs);
+	}
+
+	irbin_wr_bytes(&wr, save.wr.data, save.wr.size);
+
+	if (wr.error || save.wr.error) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	*rdata = wr.data;
+	*rsize = wr.size;
+	wr.data = NULL;
+	rc = EOK;
+error:
+	hmap_fini(&save.bystr);
+	while ((link = list_first(&save.strs)) != NULL) {
+		entry = list_get_instance(link, irbin_str_t, lstrs);
+		list_remove(&entry->lstrs);
+		free(entry);
+	}
+
+	if (save.wr.data != NULL)
+		free(save.wr.data);
+	if (wr.data != NULL)
+		free(wr.data);
+	return rc;
+}
+
+/** Save IR module in binary format.
+ *
+ * @param module IR module
+ * @param f Output file
+ * @return EOK on success, ENOMEM if out of memory, EIO on I/O error
+ */
+int irbin_save(ir_module_t *module, FILE *f)
+{
+	uint8_t *data;
+	size_t size;
+	size_t nw;
+	int rc;
+
+	rc = irbin_save_buf(module, &data, &size);
+	if (rc != EOK)
+		return rc;
+
+	nw = fwrite(data, 1, size, f);
+	free(data);
+
+	if (nw != size)
+		return EIO;
+
+	return EOK;
+}
+
+/** Read optional string.
+ *
+ * @param load Binary IR loading
+ * @param rstr Place to store pointer to string or @c NULL
+ * @return EOK on success, EINVAL if data is malformed
+ */
+static int irbin_load_optstr(irbin_load_t *load, const char **rstr)
+{
+	uint64_t idx;
+
+	idx = irbin_rd_uv(&load->rd);
+	if (load->rd.error || idx > (uint64_t)load->nstrs)
+		return EINVAL;
+
+	*rstr = idx > 0 ? load->strs[(size_t)(idx - 1)] : NULL;
+	return EOK;
+}
+
+/** Read string.
+ *
+ * @param load Binary IR loading
+ * @param rstr Place to store pointer to string
+ * @return EOK on success, EINVAL if data is malformed
+ */
+static int irbin_load_str(irbin_load_t *load, const char **rstr)
+{
+	int rc;
+
+	rc = irbin_load_optstr(load, rstr);
+	if (rc != EOK)
+		return rc;
+
+	if (*rstr == NULL)
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Read type expression.
+ *
+ * @param load Binary IR loading
+ * @param rtexpr Place to store pointer to new type expression
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_texpr(irbin_load_t *load, ir_texpr_t **rtexpr)
+{
+	ir_texpr_t *etexpr = NULL;
+	const char *ident;
+	ir_tetype_t tetype;
+	uint64_t v;
+	uint64_t asize;
+	unsigned width;
+	int rc;
+
+	v = irbin_rd_uv(&load->rd);
+	if (load->rd.error || v > (uint64_t)irt_va_list)
+		return EINVAL;
+
+	tetype = (ir_tetype_t)v;
+	switch (tetype) {
+	case irt_int:
+	case irt_ptr:
+		width = irbin_rd_uns(&load->rd);
+		if (load->rd.error)
+			return EINVAL;
+
+		if (tetype == irt_int)
+			return ir_texpr_int_create(width, rtexpr);
+		return ir_texpr_ptr_create(width, rtexpr);
+	case irt_array:
+		asize = irbin_rd_uv(&load->rd);
+		if (load->rd.error || load->depth >= irbin_max_depth)
+			return EINVAL;
+
+		++load->depth;
+		rc = irbin_load_texpr(load, &etexpr);
+		--load->depth;
+		if (rc != EOK)
+			return rc;
+
+		rc = ir_texpr_array_create(asize, etexpr, rtexpr);
+		if (rc != EOK)
+			ir_texpr_destroy(etexpr);
+		return rc;
+	case irt_ident:
+		rc = irbin_load_str(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		return ir_texpr_ident_create(ident, rtexpr);
+	case irt_va_list:
+		return ir_texpr_va_list_create(rtexpr);
+	}
+
+	return EINVAL;
+}
+
+/** Read optional type expression.
+ *
+ * @param load Binary IR loading
+ * @param rtexpr Place to store pointer to new type expression or @c NULL
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_opttexpr(irbin_load_t *load, ir_texpr_t **rtexpr)
+{
+	bool present;
+
+	present = irbin_rd_flag(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	if (!present) {
+		*rtexpr = NULL;
+		return EOK;
+	}
+
+	return irbin_load_texpr(load, rtexpr);
+}
+
+/** Read list operand elements.
+ *
+ * @param load Binary IR loading
+ * @param list List operand to which the elements should be appended
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_oper_list(irbin_load_t *load, ir_oper_list_t *list);
+
+/** Read optional operand.
+ *
+ * @param load Binary IR loading
+ * @param roper Place to store pointer to new operand or @c NULL
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_oper(irbin_load_t *load, ir_oper_t **roper)
+{
+	ir_oper_imm_t *imm;
+	ir_oper_list_t *list;
+	ir_oper_var_t *var;
+	const char *varname;
+	uint64_t kind;
+	int64_t value;
+	unsigned tempno;
+	int rc;
+
+	kind = irbin_rd_uv(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	switch (kind) {
+	case irbin_op_none:
+		*roper = NULL;
+		return EOK;
+	case irbin_op_imm:
+		value = irbin_rd_sv(&load->rd);
+		if (load->rd.error)
+			return EINVAL;
+
+		rc = ir_oper_imm_create(value, &imm);
+		if (rc != EOK)
+			return rc;
+
+		*roper = &imm->oper;
+		return EOK;
+	case irbin_op_list:
+		if (load->depth >= irbin_max_depth)
+			return EINVAL;
+
+		rc = ir_oper_list_create(&list);
+		if (rc != EOK)
+			return rc;
+
+		++load->depth;
+		rc = irbin_load_oper_list(load, list);
+		--load->depth;
+		if (rc != EOK) {
+			ir_oper_destroy(&list->oper);
+			return rc;
+		}
+
+		*roper = &list->oper;
+		return EOK;
+	case irbin_op_var:
+		rc = irbin_load_str(load, &varname);
+		if (rc != EOK)
+			return rc;
+
+		rc = ir_oper_var_create(varname, &var);
+		if (rc != EOK)
+			return rc;
+
+		*roper = &var->oper;
+		return EOK;
+	case irbin_op_temp:
+		tempno = irbin_rd_uns(&load->rd);
+		if (load->rd.error)
+			return EINVAL;
+
+		rc = ir_oper_temp_create(tempno, &var);
+		if (rc != EOK)
+			return rc;
+
+		*roper = &var->oper;
+		return EOK;
+	}
+
+	return EINVAL;
+}
+
+/** Read list operand elements.
+ *
+ * @param load Binary IR loading
+ * @param list List operand to which the elements should be appended
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_oper_list(irbin_load_t *load, ir_oper_list_t *list)
+{
+	ir_oper_t *elem;
+	size_t n;
+	size_t i;
+	int rc;
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_oper(load, &elem);
+		if (rc != EOK)
+			return rc;
+
+		/* List elements cannot be missing */
+		if (elem == NULL)
+			return EINVAL;
+
+		ir_oper_list_append(list, elem);
+	}
+
+	return EOK;
+}
+
+/** Read instruction.
+ *
+ * @param load Binary IR loading
+ * @param rinstr Place to store pointer to new instruction
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_instr(irbin_load_t *load, ir_instr_t **rinstr)
+{
+	ir_instr_t *instr = NULL;
+	uint64_t itype;
+	int rc;
+
+	itype = irbin_rd_uv(&load->rd);
+	if (load->rd.error || itype > (uint64_t)iri_zrext)
+		return EINVAL;
+
+	rc = ir_instr_create(&instr);
+	if (rc != EOK)
+		return rc;
+
+	instr->itype = (ir_instr_type_t)itype;
+	instr->width = irbin_rd_uns(&load->rd);
+	if (load->rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = irbin_load_oper(load, &instr->dest);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_oper(load, &instr->op1);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_oper(load, &instr->op2);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_opttexpr(load, &instr->opt);
+	if (rc != EOK)
+		goto error;
+
+	*rinstr = instr;
+	return EOK;
+error:
+	ir_instr_destroy(instr);
+	return rc;
+}
+
+/** Read labeled block.
+ *
+ * @param load Binary IR loading
+ * @param rlblock Place to store pointer to new labeled block
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_lblock(irbin_load_t *load, ir_lblock_t **rlblock)
+{
+	ir_lblock_t *lblock = NULL;
+	ir_instr_t *instr = NULL;
+	const char *label;
+	bool has_instr;
+	size_t n;
+	size_t i;
+	int rc;
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	rc = ir_lblock_create(&lblock);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_optstr(load, &label);
+		if (rc != EOK)
+			goto error;
+
+		has_instr = irbin_rd_flag(&load->rd);
+		if (load->rd.error) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		if (has_instr) {
+			rc = irbin_load_instr(load, &instr);
+			if (rc != EOK)
+				goto error;
+		}
+
+		rc = ir_lblock_append(lblock, label, instr);
+		if (rc != EOK)
+			goto error;
+
+		instr = NULL;
+	}
+
+	*rlblock = lblock;
+	return EOK;
+error:
+	ir_instr_destroy(instr);
+	ir_lblock_destroy(lblock);
+	return rc;
+}
+
+/** Read data block.
+ *
+ * @param load Binary IR loading
+ * @param rdblock Place to store pointer to new data block
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_dblock(irbin_load_t *load, ir_dblock_t **rdblock)
+{
+	ir_dblock_t *dblock = NULL;
+	ir_dentry_t *dentry = NULL;
+	const char *symbol;
+	ir_dentry_type_t dtype;
+	uint64_t v;
+	unsigned width;
+	int64_t value;
+	size_t n;
+	size_t i;
+	int rc;
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	rc = ir_dblock_create(&dblock);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < n; i++) {
+		v = irbin_rd_uv(&load->rd);
+		width = irbin_rd_uns(&load->rd);
+		if (load->rd.error || v > (uint64_t)ird_ptr) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		dtype = (ir_dentry_type_t)v;
+
+		rc = irbin_load_optstr(load, &symbol);
+		if (rc != EOK)
+			goto error;
+
+		value = irbin_rd_sv(&load->rd);
+		if (load->rd.error) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		if (dtype == ird_int && symbol == NULL) {
+			rc = ir_dentry_create_int(width, value, &dentry);
+		} else if (dtype == ird_ptr && symbol != NULL) {
+			rc = ir_dentry_create_ptr(width, symbol, value,
+			    &dentry);
+		} else {
+			rc = EINVAL;
+		}
+		if (rc != EOK)
+			goto error;
+
+		rc = ir_dblock_append(dblock, dentry);
+		if (rc != EOK)
+			goto error;
+
+		dentry = NULL;
+	}
+
+	*rdblock = dblock;
+	return EOK;
+error:
+	ir_dentry_destroy(dentry);
+	ir_dblock_destroy(dblock);
+	return rc;
+}
+
+/** Read linkage.
+ *
+ * @param load Binary IR loading
+ * @param rlinkage Place to store linkage
+ * @return EOK on success, EINVAL if data is malformed
+ */
+static int irbin_load_linkage(irbin_load_t *load, ir_linkage_t *rlinkage)
+{
+	uint64_t linkage;
+
+	linkage = irbin_rd_uv(&load->rd);
+	if (load->rd.error || linkage > (uint64_t)irl_callsign)
+		return EINVAL;
+
+	*rlinkage = (ir_linkage_t)linkage;
+	return EOK;
+}
+
+/** Read variable declaration.
+ *
+ * @param load Binary IR loading
+ * @param rdecln Place to store pointer to new declaration
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_var(irbin_load_t *load, ir_decln_t **rdecln)
+{
+	ir_var_t *var;
+	ir_texpr_t *vtype = NULL;
+	ir_dblock_t *dblock = NULL;
+	ir_linkage_t linkage;
+	const char *ident;
+	bool has_dblock;
+	int rc;
+
+	rc = irbin_load_str(load, &ident);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_texpr(load, &vtype);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_linkage(load, &linkage);
+	if (rc != EOK)
+		goto error;
+
+	has_dblock = irbin_rd_flag(&load->rd);
+	if (load->rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (has_dblock) {
+		rc = irbin_load_dblock(load, &dblock);
+		if (rc != EOK)
+			goto error;
+	} else if (linkage != irl_extern) {
+		/* Only extern variables can be without data */
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = ir_var_create(ident, vtype, linkage, dblock, &var);
+	if (rc != EOK)
+		goto error;
+
+	*rdecln = &var->decln;
+	return EOK;
+error:
+	ir_texpr_destroy(vtype);
+	ir_dblock_destroy(dblock);
+	return rc;
+}
+
+/** Read procedure arguments, attributes and local variables.
+ *
+ * @param load Binary IR loading
+ * @param proc Procedure
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_proc_parts(irbin_load_t *load, ir_proc_t *proc)
+{
+	ir_proc_arg_t *arg;
+	ir_proc_attr_t *attr;
+	ir_lvar_t *lvar;
+	ir_texpr_t *texpr;
+	const char *ident;
+	size_t n;
+	size_t i;
+	int rc;
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_str(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		rc = irbin_load_texpr(load, &texpr);
+		if (rc != EOK)
+			return rc;
+
+		rc = ir_proc_arg_create(ident, texpr, &arg);
+		if (rc != EOK) {
+			ir_texpr_destroy(texpr);
+			return rc;
+		}
+
+		ir_proc_append_arg(proc, arg);
+	}
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_str(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		rc = ir_proc_attr_create(ident, &attr);
+		if (rc != EOK)
+			return rc;
+
+		ir_proc_append_attr(proc, attr);
+	}
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_str(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		rc = irbin_load_texpr(load, &texpr);
+		if (rc != EOK)
+			return rc;
+
+		rc = ir_lvar_create(ident, texpr, &lvar);
+		if (rc != EOK) {
+			ir_texpr_destroy(texpr);
+			return rc;
+		}
+
+		ir_proc_append_lvar(proc, lvar);
+	}
+
+	return EOK;
+}
+
+/** Read procedure declaration.
+ *
+ * @param load Binary IR loading
+ * @param rdecln Place to store pointer to new declaration
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_proc(irbin_load_t *load, ir_decln_t **rdecln)
+{
+	ir_proc_t *proc = NULL;
+	ir_lblock_t *lblock = NULL;
+	ir_linkage_t linkage;
+	const char *ident;
+	bool has_lblock;
+	int rc;
+
+	rc = irbin_load_str(load, &ident);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_linkage(load, &linkage);
+	if (rc != EOK)
+		goto error;
+
+	has_lblock = irbin_rd_flag(&load->rd);
+	if (load->rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (has_lblock) {
+		rc = irbin_load_lblock(load, &lblock);
+		if (rc != EOK)
+			goto error;
+	} else if (linkage != irl_extern && linkage != irl_callsign) {
+		/* Only procedure declarations can be without body */
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = ir_proc_create(ident, linkage, lblock, &proc);
+	if (rc != EOK)
+		goto error;
+
+	lblock = NULL;
+
+	proc->variadic = irbin_rd_flag(&load->rd);
+	if (load->rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = irbin_load_opttexpr(load, &proc->rtype);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_proc_parts(load, proc);
+	if (rc != EOK)
+		goto error;
+
+	*rdecln = &proc->decln;
+	return EOK;
+error:
+	ir_lblock_destroy(lblock);
+	ir_proc_destroy(proc);
+	return rc;
+}
+
+/** Read record type declaration.
+ *
+ * @param load Binary IR loading
+ * @param rdecln Place to store pointer to new declaration
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_record(irbin_load_t *load, ir_decln_t **rdecln)
+{
+	ir_record_t *record = NULL;
+	ir_texpr_t *etype;
+	const char *ident;
+	uint64_t rtype;
+	size_t n;
+	size_t i;
+	int rc;
+
+	rc = irbin_load_str(load, &ident);
+	if (rc != EOK)
+		return rc;
+
+	rtype = irbin_rd_uv(&load->rd);
+	if (load->rd.error || rtype > (uint64_t)irrt_union)
+		return EINVAL;
+
+	rc = ir_record_create(ident, (ir_record_type_t)rtype, &record);
+	if (rc != EOK)
+		return rc;
+
+	n = irbin_rd_count(&load->rd);
+	if (load->rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	for (i = 0; i < n; i++) {
+		rc = irbin_load_str(load, &ident);
+		if (rc != EOK)
+			goto error;
+
+		rc = irbin_load_texpr(load, &etype);
+		if (rc != EOK)
+			goto error;
+
+		/* The element type is copied */
+		rc = ir_record_append(record, ident, etype, NULL);
+		ir_texpr_destroy(etype);
+		if (rc != EOK)
+			goto error;
+	}
+
+	*rdecln = &record->decln;
+	return EOK;
+error:
+	ir_record_destroy(record);
+	return rc;
+}
+
+/** Read string table.
+ *
+ * @param load Binary IR loading
+ * @return EOK on success, EINVAL if data is malformed, ENOMEM if out
+ *         of memory
+ */
+static int irbin_load_strtab(irbin_load_t *load)
+{
+	const uint8_t *p;
+	uint64_t len;
+	size_t i;
+
+	load->nstrs = irbin_rd_count(&load->rd);
+	if (load->rd.error)
+		return EINVAL;
+
+	if (load->nstrs == 0)
+		return EOK;
+
+	load->strs = calloc(load->nstrs, sizeof(const char *));
+	if (load->strs == NULL)
+		return ENOMEM;
+
+	for (i = 0; i < load->nstrs; i++) {
+		len = irbin_rd_uv(&load->rd);
+		if (load->rd.error ||
+		    len >= (uint64_t)(load->rd.size - load->rd.pos))
+			return EINVAL;
+
+		p = irbin_rd_bytes(&load->rd, (size_t)len + 1);
+		if (p == NULL || p[(size_t)len] != '\0')
+			return EINVAL;
+
+		load->strs[i] = (const char *)p;
+	}
+
+	return EOK;
+}
+
+/** Load IR module in binary format from a memory buffer.
+ *
+ * @param data Data
+ * @param size Size of data in bytes
+ * @param rmodule Place to store pointer to new IR module
+ * @return EOK on success, EINVAL if data is not valid binary IR,
+ *         ENOMEM if out of memory
+ */
+int irbin_load_buf(const uint8_t *data, size_t size, ir_module_t **rmodule)
+{
+	irbin_load_t load;
+	ir_module_t *module = NULL;
+	ir_decln_t *decln;
+	uint64_t dtype;
+	size_t n;
+	size_t i;
+	int rc;
+
+	memset(&load, 0, sizeof(load));
+	load.rd.data = data;
+	load.rd.size = size;
+
+	if (irbin_rd_u32(&load.rd) != irbin_file_sign ||
+	    irbin_rd_u32(&load.rd) != irbin_file_major) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Minor version */
+	(void)irbin_rd_u32(&load.rd);
+
+	rc = irbin_load_strtab(&load);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_module_create(&module);
+	if (rc != EOK)
+		goto error;
+
+	n = irbin_rd_count(&load.rd);
+	if (load.rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	for (i = 0; i < n; i++) {
+		dtype = irbin_rd_uv(&load.rd);
+		if (load.rd.error || dtype > (uint64_t)ird_record) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		switch ((ir_decln_type_t)dtype) {
+		case ird_var:
+			rc = irbin_load_var(&load, &decln);
+			break;
+		case ird_proc:
+			rc = irbin_load_proc(&load, &decln);
+			break;
+		case ird_record:
+			rc = irbin_load_record(&load, &decln);
+			break;
+		}
+
+		if (rc != EOK)
+			goto error;
+
+		ir_module_append(module, decln);
+	}
+
+	/* There must be no trailing data */
+	if (load.rd.pos != load.rd.size) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (load.strs != NULL)
+		free(load.strs);
+	*rmodule = module;
+	return EOK;
+error:
+	if (load.strs != NULL)
+		free(load.strs);
+	ir_module_destroy(module);
+	return rc;
+}
+
+/** Load IR module in binary format.
+ *
+ * @param f Input file
+ * @param fname File name (for error messages)
+ * @param rmodule Place to store pointer to new IR module
+ * @return EOK on success, EINVAL if file is not valid binary IR,
+ *         EIO on I/O error, ENOMEM if out of memory
+ */
+int irbin_load(FILE *f, const char *fname, ir_module_t **rmodule)
+{
+	irbin_wr_t data;
+	uint8_t buf[irbin_buf_size];
+	size_t nread;
+	int rc;
+
+	memset(&data, 0, sizeof(data));
+
+	do {
+		nread = fread(buf, 1, sizeof(buf), f);
+		irbin_wr_bytes(&data, buf, nread);
+	} while (nread == sizeof(buf));
+
+	if (ferror(f) != 0) {
+		(void)fprintf(stderr, "Error reading '%s'.\n", fname);
+		rc = EIO;
+		goto error;
+	}
+
+	if (data.error) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = irbin_load_buf(data.data, data.size, rmodule);
+	if (rc == EINVAL) {
+		(void)fprintf(stderr, "'%s' is not a valid binary IR file.\n",
+		    fname);
+	}
+
+error:
+	if (data.data != NULL)
+		free(data.data);
+	return rc;
+}
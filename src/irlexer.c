@@ -29,6 +29,7 @@
 #include <assert.h>
 #include <inttypes.h>
 #include <irlexer.h>
+#include <kwtab.h>
 #include <merrno.h>
 #include <src_pos.h>
 #include <stdbool.h>
@@ -36,6 +37,74 @@
 #include <stdlib.h>
 #include <string.h>
 
+/** Keywords */
+static const ir_lexer_kw_t ir_lexer_kw_entries[] = {
+	{ "add", itt_add },
+	{ "and", itt_and },
+	{ "attr", itt_attr },
+	{ "begin", itt_begin },
+	{ "bnot", itt_bnot },
+	{ "call", itt_call },
+	{ "calli", itt_calli },
+	{ "copy", itt_copy },
+	{ "end", itt_end },
+	{ "eq", itt_eq },
+	{ "extern", itt_extern },
+	{ "global", itt_global },
+	{ "gt", itt_gt },
+	{ "gteq", itt_gteq },
+	{ "gteu", itt_gteu },
+	{ "gtu", itt_gtu },
+	{ "imm", itt_imm },
+	{ "int", itt_int },
+	{ "jmp", itt_jmp },
+	{ "jnz", itt_jnz },
+	{ "jz", itt_jz },
+	{ "lt", itt_lt },
+	{ "lteq", itt_lteq },
+	{ "lteu", itt_lteu },
+	{ "ltu", itt_ltu },
+	{ "lvar", itt_lvar },
+	{ "lvarptr", itt_lvarptr },
+	{ "mul", itt_mul },
+	{ "neg", itt_neg },
+	{ "neq", itt_neq },
+	{ "nil", itt_nil },
+	{ "nop", itt_nop },
+	{ "or", itt_or },
+	{ "proc", itt_proc },
+	{ "ptr", itt_ptr },
+	{ "ptridx", itt_ptridx },
+	{ "read", itt_read },
+	{ "reccopy", itt_reccopy },
+	{ "record", itt_record },
+	{ "ret", itt_ret },
+	{ "retv", itt_retv },
+	{ "sdiv", itt_sdiv },
+	{ "sgnext", itt_sgnext },
+	{ "shl", itt_shl },
+	{ "shra", itt_shra },
+	{ "shrl", itt_shrl },
+	{ "smod", itt_smod },
+	{ "sub", itt_sub },
+	{ "trunc", itt_trunc },
+	{ "udiv", itt_udiv },
+	{ "umod", itt_umod },
+	{ "union", itt_union },
+	{ "var", itt_var },
+	{ "varptr", itt_varptr },
+	{ "write", itt_write },
+	{ "xor", itt_xor },
+	{ "zrext", itt_zrext }
+};
+
+/** Keyword table */
+static kwtab_t ir_lexer_kwtab = {
+	.entries = ir_lexer_kw_entries,
+	.nentries = sizeof(ir_lexer_kw_entries) / sizeof(ir_lexer_kw_t),
+	.esize = sizeof(ir_lexer_kw_t)
+};
+
 /** Create lexer.
  *
  * @param ops Input ops
@@ -580,6 +649,38 @@ static int ir_lexer_error(ir_lexer_t *lexer, ir_lexer_tok_t *tok)
 	return EOK;
 }
 
+/** Lex word.
+ *
+ * Words that are not keywords are invalid.
+ *
+ * @param lexer Lexer
+ * @param tok Output token
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int ir_lexer_word(ir_lexer_t *lexer, ir_lexer_tok_t *tok)
+{
+	const char *p;
+	size_t maxlen;
+	size_t len;
+	const ir_lexer_kw_t *kw;
+
+	maxlen = kwtab_maxlen(&ir_lexer_kwtab);
+	assert(maxlen < ir_lexer_buf_low_watermark);
+
+	/* Determine word length (only up to longest keyword length + 1) */
+	p = ir_lexer_chars(lexer);
+	len = 1;
+	while (len <= maxlen && is_idcnt(p[len]))
+		++len;
+
+	kw = kwtab_lookup(&ir_lexer_kwtab, p, len);
+	if (kw != NULL)
+		return ir_lexer_keyword(lexer, kw->ttype, len, tok);
+
+	return ir_lexer_invalid(lexer, tok);
+}
+
 /** Lex next token in.
  *
  * @param lexer Lexer
@@ -634,256 +735,13 @@ int ir_lexer_get_tok(ir_lexer_t *lexer, ir_lexer_tok_t *tok)
 		return ir_lexer_onechar(lexer, itt_scolon, tok);
 	case '@':
 		return ir_lexer_ident(lexer, tok);
-	case 'a':
-		if (p[1] == 'd' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_add, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_and, 3, tok);
-		}
-		if (p[1] == 't' && p[2] == 't' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_attr, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'b':
-		if (p[1] == 'e' && p[2] == 'g' && p[3] == 'i' &&
-		    p[4] == 'n' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_begin, 5, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'o' && p[3] == 't' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_bnot, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'c':
-		if (p[1] == 'a' && p[2] == 'l' && p[3] == 'l' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_call, 4, tok);
-		}
-		if (p[1] == 'a' && p[2] == 'l' && p[3] == 'l' &&
-		    p[4] == 'i' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_calli, 5, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'p' && p[3] == 'y' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_copy, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'e':
-		if (p[1] == 'n' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_end, 3, tok);
-		}
-		if (p[1] == 'q' && !is_idcnt(p[2])) {
-			return ir_lexer_keyword(lexer, itt_eq, 2, tok);
-		}
-		if (p[1] == 'x' && p[2] == 't' && p[3] == 'e' &&
-		    p[4] == 'r' && p[5] == 'n' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_extern, 6, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'g':
-		if (p[1] == 'l' && p[2] == 'o' && p[3] == 'b' &&
-		    p[4] == 'a' && p[5] == 'l' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_global, 6, tok);
-		}
-		if (p[1] == 't' && !is_idcnt(p[2])) {
-			return ir_lexer_keyword(lexer, itt_gt, 2, tok);
-		}
-		if (p[1] == 't' && p[2] == 'u' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_gtu, 3, tok);
-		}
-		if (p[1] == 't' && p[2] == 'e' && p[3] == 'q' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_gteq, 4, tok);
-		}
-		if (p[1] == 't' && p[2] == 'e' && p[3] == 'u' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_gteu, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'i':
-		if (p[1] == 'm' && p[2] == 'm' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_imm, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 't' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_int, 3, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'j':
-		if (p[1] == 'm' && p[2] == 'p' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_jmp, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'z' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_jnz, 3, tok);
-		}
-		if (p[1] == 'z' && !is_idcnt(p[2])) {
-			return ir_lexer_keyword(lexer, itt_jz, 2, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'l':
-		if (p[1] == 't' && !is_idcnt(p[2])) {
-			return ir_lexer_keyword(lexer, itt_lt, 2, tok);
-		}
-		if (p[1] == 't' && p[2] == 'u' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_ltu, 3, tok);
-		}
-		if (p[1] == 't' && p[2] == 'e' && p[3] == 'q' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_lteq, 4, tok);
-		}
-		if (p[1] == 't' && p[2] == 'e' && p[3] == 'u' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_lteu, 4, tok);
-		}
-		if (p[1] == 'v' && p[2] == 'a' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_lvar, 4, tok);
-		}
-		if (p[1] == 'v' && p[2] == 'a' && p[3] == 'r' &&
-		    p[4] == 'p' && p[5] == 't' && p[6] == 'r' &&
-		    !is_idcnt(p[7])) {
-			return ir_lexer_keyword(lexer, itt_lvarptr, 7, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'm':
-		if (p[1] == 'u' && p[2] == 'l' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_mul, 3, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'n':
-		if (p[1] == 'e' && p[2] == 'g' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_neg, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'q' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_neq, 3, tok);
-		}
-		if (p[1] == 'i' && p[2] == 'l' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_nil, 3, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'p' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_nop, 3, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'o':
-		if (p[1] == 'r' && !is_idcnt(p[2])) {
-			return ir_lexer_keyword(lexer, itt_or, 2, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'p':
-		if (p[1] == 'r' && p[2] == 'o' && p[3] == 'c' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_proc, 4, tok);
-		}
-		if (p[1] == 't' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_ptr, 3, tok);
-		}
-		if (p[1] == 't' && p[2] == 'r' && p[3] == 'i' &&
-		    p[4] == 'd' && p[5] == 'x' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_ptridx, 6, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'r':
-		if (p[1] == 'e' && p[2] == 'a' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_read, 4, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'c' && p[3] == 'c' &&
-		    p[4] == 'o' && p[5] == 'p' && p[6] == 'y' &&
-		    !is_idcnt(p[7])) {
-			return ir_lexer_keyword(lexer, itt_reccopy, 7, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'c' && p[3] == 'o' &&
-		    p[4] == 'r' && p[5] == 'd' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_record, 6, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_ret, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && p[3] == 'v' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_retv, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 's':
-		if (p[1] == 'd' && p[2] == 'i' && p[3] == 'v' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_sdiv, 4, tok);
-		}
-		if (p[1] == 'g' && p[2] == 'n' && p[3] == 'e' &&
-		    p[4] == 'x' && p[5] == 't' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_sgnext, 6, tok);
-		}
-		if (p[1] == 'h' && p[2] == 'l' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_shl, 3, tok);
-		}
-		if (p[1] == 'h' && p[2] == 'r' && p[3] == 'a' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_shra, 4, tok);
-		}
-		if (p[1] == 'h' && p[2] == 'r' && p[3] == 'l' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_shrl, 4, tok);
-		}
-		if (p[1] == 'm' && p[2] == 'o' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_smod, 4, tok);
-		}
-		if (p[1] == 'u' && p[2] == 'b' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_sub, 3, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 't':
-		if (p[1] == 'r' && p[2] == 'u' && p[3] == 'n' &&
-		    p[4] == 'c' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_trunc, 5, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'u':
-		if (p[1] == 'd' && p[2] == 'i' && p[3] == 'v' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_udiv, 4, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'i' && p[3] == 'o' &&
-		    p[4] == 'n' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_union, 5, tok);
-		}
-		if (p[1] == 'm' && p[2] == 'o' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return ir_lexer_keyword(lexer, itt_umod, 4, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'v':
-		if (p[1] == 'a' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_var, 3, tok);
-		}
-		if (p[1] == 'a' && p[2] == 'r' && p[3] == 'p' &&
-		    p[4] == 't' && p[5] == 'r' && !is_idcnt(p[6])) {
-			return ir_lexer_keyword(lexer, itt_varptr, 6, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'w':
-		if (p[1] == 'r' && p[2] == 'i' && p[3] == 't' &&
-		    p[4] == 'e' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_write, 5, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'x':
-		if (p[1] == 'o' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return ir_lexer_keyword(lexer, itt_xor, 3, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
-	case 'z':
-		if (p[1] == 'r' && p[2] == 'e' && p[3] == 'x' &&
-		    p[4] == 't' && !is_idcnt(p[5])) {
-			return ir_lexer_keyword(lexer, itt_zrext, 5, tok);
-		}
-		return ir_lexer_invalid(lexer, tok);
 	case '{':
 		return ir_lexer_onechar(lexer, itt_lbrace, tok);
 	case '}':
 		return ir_lexer_onechar(lexer, itt_rbrace, tok);
 	default:
+		if (is_alpha(p[0]))
+			return ir_lexer_word(lexer, tok);
 		if (is_num(p[0]))
 			return ir_lexer_number(lexer, tok);
 		if (!is_print(p[0]))
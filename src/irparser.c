@@ -186,12 +186,16 @@ static int ir_parser_process_oper_var(ir_parser_t *parser, ir_oper_var_t **rvar)
 {
 	ir_lexer_tok_t itok;
 	ir_oper_var_t *var = NULL;
+	unsigned tempno;
 	int rc;
 
 	ir_parser_read_next_tok(parser, &itok);
 	assert(itok.ttype == itt_ident);
 
-	rc = ir_oper_var_create(itok.text, &var);
+	if (ir_temp_parse(itok.text, &tempno) == EOK)
+		rc = ir_oper_temp_create(tempno, &var);
+	else
+		rc = ir_oper_var_create(itok.text, &var);
 	if (rc != EOK)
 		return rc;
 
@@ -0,0 +1,576 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Parallel jobs
+ *
+ * Each job is executed in a separate process so that it has its own
+ * address space (and thus its own heap and its own copy of any global
+ * state). Standard output and standard error output of each job are
+ * captured in temporary files so that the caller can replay them
+ * in a deterministic order once the job is finished.
+ *
+ * Process creation is only available when the host provides fork()
+ * (HAVE_FORK is defined). Otherwise jobs_supported() returns @c false
+ * and the caller is expected to fall back to doing the work
+ * sequentially.
+ */
+
+#include <adt/list.h>
+#include <jobs.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef HAVE_FORK
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/** Determine if parallel jobs are supported.
+ *
+ * @return @c true iff jobs can be executed
+ */
+bool jobs_supported(void)
+{
+#ifdef HAVE_FORK
+	return true;
+#else
+	return false;
+#endif
+}
+
+/** Create job set.
+ *
+ * @param maxjobs Maximum number of jobs running simultaneously
+ * @param rjobs Place to store pointer to new job set
+ * @return EOK on success, EINVAL if @a maxjobs is zero, ENOMEM if out
+ *         of memory
+ */
+int jobs_create(unsigned maxjobs, jobs_t **rjobs)
+{
+	jobs_t *jobs;
+
+	if (maxjobs == 0)
+		return EINVAL;
+
+	jobs = calloc(1, sizeof(jobs_t));
+	if (jobs == NULL)
+		return ENOMEM;
+
+	list_initialize(&jobs->jobs);
+	jobs->maxjobs = maxjobs;
+	*rjobs = jobs;
+	return EOK;
+}
+
+/** Set whether job output should be merged.
+ *
+ * If merged, standard error output of a job is captured together with
+ * its standard output, preserving their relative order.
+ *
+ * @param jobs Job set
+ * @param merge @c true to merge standard error output into standard
+ *              output
+ */
+void jobs_set_merge_out(jobs_t *jobs, bool merge)
+{
+	jobs->merge_out = merge;
+}
+
+/** Get number of available processors.
+ *
+ * @return Number of online processors (at least 1)
+ */
+unsigned jobs_ncpus(void)
+{
+#ifdef HAVE_FORK
+	long n;
+
+	n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n < 1)
+		return 1;
+
+	return (unsigned)n;
+#else
+	return 1;
+#endif
+}
+
+/** Destroy job.
+ *
+ * @param job Job
+ */
+static void job_destroy(job_t *job)
+{
+	list_remove(&job->ljobs);
+	if (job->outf != NULL)
+		(void)fclose(job->outf);
+	if (job->errf != NULL)
+		(void)fclose(job->errf);
+	if (job->dataf != NULL)
+		(void)fclose(job->dataf);
+	free(job);
+}
+
+/** Destroy job set.
+ *
+ * All jobs must have finished (i.e. jobs_run() must have returned)
+ * before the job set is destroyed.
+ *
+ * @param jobs Job set or @c NULL
+ */
+void jobs_destroy(jobs_t *jobs)
+{
+	job_t *job;
+
+	if (jobs == NULL)
+		return;
+
+	job = jobs_first(jobs);
+	while (job != NULL) {
+		job_destroy(job);
+		job = jobs_first(jobs);
+	}
+
+	free(jobs);
+}
+
+#ifdef HAVE_FORK
+
+/** Add job to job set.
+ *
+ * @param jobs Job set
+ * @param fn Job function
+ * @param arg Argument to job function
+ * @param rjob Place to store pointer to new job or @c NULL if not
+ *             interested
+ * @return EOK on success, ENOMEM if out of memory, EIO if temporary
+ *         files cannot be created
+ */
+int jobs_add(jobs_t *jobs, job_fn_t fn, void *arg, job_t **rjob)
+{
+	job_t *job;
+
+	job = calloc(1, sizeof(job_t));
+	if (job == NULL)
+		return ENOMEM;
+
+	job->jobs = jobs;
+	job->fn = fn;
+	job->arg = arg;
+	list_append(&job->ljobs, &jobs->jobs);
+
+	job->outf = tmpfile();
+	job->errf = tmpfile();
+	job->dataf = tmpfile();
+	if (job->outf == NULL || job->errf == NULL || job->dataf == NULL) {
+		job_destroy(job);
+		return EIO;
+	}
+
+	if (rjob != NULL)
+		*rjob = job;
+	return EOK;
+}
+
+/** Start job.
+ *
+ * The job function is executed in a child process, with standard
+ * output and standard error output redirected to the job's temporary
+ * files (or both to the same file if output is merged). The function's
+ * return code becomes the exit status of the child process.
+ *
+ * @param job Job
+ * @return EOK on success, EIO if process cannot be created
+ */
+static int job_start(job_t *job)
+{
+	FILE *errf;
+	pid_t pid;
+	int rc;
+
+	/* Do not let the child flush our buffered output a second time */
+	(void)fflush(stdout);
+	(void)fflush(stderr);
+
+	pid = fork();
+	if (pid < 0)
+		return EIO;
+
+	if (pid == 0) {
+		/* Child process */
+		errf = job->jobs->merge_out ? job->outf : job->errf;
+		if (dup2(fileno(job->outf), STDOUT_FILENO) < 0 ||
+		    dup2(fileno(errf), STDERR_FILENO) < 0)
+			_exit(EIO);
+
+		rc = job->fn(job->arg, job->dataf);
+
+		(void)fflush(stdout);
+		(void)fflush(stderr);
+		if (fflush(job->dataf) < 0 && rc == EOK)
+			rc = EIO;
+		_exit(rc);
+	}
+
+	job->pid = pid;
+	job->started = true;
+	++job->jobs->running;
+	return EOK;
+}
+
+/** Wait for any running job to finish.
+ *
+ * @param jobs Job set
+ * @return EOK on success, EIO if waiting failed
+ */
+static int jobs_wait_one(jobs_t *jobs)
+{
+	job_t *job;
+	pid_t pid;
+	int status;
+
+	do {
+		pid = waitpid(-1, &status, 0);
+		if (pid < 0)
+			return EIO;
+
+		job = jobs_first(jobs);
+		while (job != NULL) {
+			if (job->started && !job->done && job->pid == pid)
+				break;
+			job = jobs_next(job);
+		}
+	} while (job == NULL);
+
+	if (WIFEXITED(status))
+		job->rc = WEXITSTATUS(status);
+	else
+		job->rc = EIO;
+
+	job->done = true;
+	--jobs->running;
+	return EOK;
+}
+
+/** Run all jobs.
+ *
+ * Jobs are started in the order in which they were added, with at most
+ * @c jobs->maxjobs of them running at the same time. Returns once all
+ * started jobs have finished. If a job cannot be started, no further
+ * jobs are started.
+ *
+ * @param jobs Job set
+ * @return EOK on success (this does not mean that the jobs themselves
+ *         succeeded, see job_get_rc()) or an error code
+ */
+int jobs_run(jobs_t *jobs)
+{
+	job_t *job;
+	int rc = EOK;
+	int rc2;
+
+	job = jobs_first(jobs);
+	while (job != NULL) {
+		if (jobs->running >= jobs->maxjobs) {
+			rc = jobs_wait_one(jobs);
+			if (rc != EOK)
+				break;
+		}
+
+		rc = job_start(job);
+		if (rc != EOK)
+			break;
+
+		job = jobs_next(job);
+	}
+
+	while (jobs->running > 0) {
+		rc2 = jobs_wait_one(jobs);
+		if (rc2 != EOK)
+			return rc2;
+	}
+
+	return rc;
+}
+
+/** Start detached job.
+ *
+ * The job function is executed in a child process, whose output is not
+ * captured and which is not waited for. Use jobs_reap() to collect
+ * detached jobs once they have finished.
+ *
+ * @param fn Job function (called with @c NULL data file)
+ * @param arg Argument to job function
+ * @return EOK on success, EIO if process cannot be created
+ */
+int jobs_spawn(job_fn_t fn, void *arg)
+{
+	pid_t pid;
+	int rc;
+
+	/* Do not let the child flush our buffered output a second time */
+	(void)fflush(stdout);
+	(void)fflush(stderr);
+
+	pid = fork();
+	if (pid < 0)
+		return EIO;
+
+	if (pid == 0) {
+		/* Child process */
+		rc = fn(arg, NULL);
+
+		(void)fflush(stdout);
+		(void)fflush(stderr);
+		_exit(rc);
+	}
+
+	return EOK;
+}
+
+/** Collect detached jobs that have finished.
+ *
+ * Does not wait for jobs that are still running.
+ */
+void jobs_reap(void)
+{
+	pid_t pid;
+	int status;
+
+	do {
+		pid = waitpid(-1, &status, WNOHANG);
+	} while (pid > 0);
+}
+
+/** Copy contents of temporary file to output stream.
+ *
+ * @param f Temporary file
+ * @param outf Output stream
+ * @return EOK on success, EIO on I/O error
+ */
+static int job_copy_out(FILE *f, FILE *outf)
+{
+	char buf[256];
+	size_t nr;
+
+	if (fseek(f, 0, SEEK_SET) < 0)
+		return EIO;
+
+	do {
+		nr = fread(buf, 1, sizeof(buf), f);
+		if (nr > 0 && fwrite(buf, 1, nr, outf) != nr)
+			return EIO;
+	} while (nr == sizeof(buf));
+
+	if (ferror(f))
+		return EIO;
+
+	return EOK;
+}
+
+/** Replay output of finished job.
+ *
+ * Captured standard output of the job is written to standard output,
+ * followed by captured standard error output written to standard
+ * error output.
+ *
+ * @param job Job
+ * @return EOK on success, EIO on I/O error
+ */
+int job_replay(job_t *job)
+{
+	int rc;
+
+	rc = job_copy_out(job->outf, stdout);
+	if (rc != EOK)
+		return rc;
+
+	(void)fflush(stdout);
+
+	rc = job_copy_out(job->errf, stderr);
+	if (rc != EOK)
+		return rc;
+
+	(void)fflush(stderr);
+	return EOK;
+}
+
+#else
+
+/** Add job to job set.
+ *
+ * @param jobs Job set
+ * @param fn Job function
+ * @param arg Argument to job function
+ * @param rjob Place to store pointer to new job or @c NULL if not
+ *             interested
+ * @return ENOTSUP (jobs are not supported)
+ */
+int jobs_add(jobs_t *jobs, job_fn_t fn, void *arg, job_t **rjob)
+{
+	(void)jobs;
+	(void)fn;
+	(void)arg;
+	(void)rjob;
+	return ENOTSUP;
+}
+
+/** Run all jobs.
+ *
+ * @param jobs Job set
+ * @return ENOTSUP (jobs are not supported)
+ */
+int jobs_run(jobs_t *jobs)
+{
+	(void)jobs;
+	return ENOTSUP;
+}
+
+/** Start detached job.
+ *
+ * @param fn Job function
+ * @param arg Argument to job function
+ * @return ENOTSUP (jobs are not supported)
+ */
+int jobs_spawn(job_fn_t fn, void *arg)
+{
+	(void)fn;
+	(void)arg;
+	return ENOTSUP;
+}
+
+/** Collect detached jobs that have finished.
+ */
+void jobs_reap(void)
+{
+}
+
+/** Replay output of finished job.
+ *
+ * @param job Job
+ * @return ENOTSUP (jobs are not supported)
+ */
+int job_replay(job_t *job)
+{
+	(void)job;
+	return ENOTSUP;
+}
+
+#endif
+
+/** Get first job in job set.
+ *
+ * @param jobs Job set
+ * @return First job or @c NULL if there are none
+ */
+job_t *jobs_first(jobs_t *jobs)
+{
+	link_t *link;
+
+	link = list_first(&jobs->jobs);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, job_t, ljobs);
+}
+
+/** Get next job in job set.
+ *
+ * @param cur Current job
+ * @return Next job or @c NULL if @a cur is the last one
+ */
+job_t *jobs_next(job_t *cur)
+{
+	link_t *link;
+
+	link = list_next(&cur->ljobs, &cur->jobs->jobs);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, job_t, ljobs);
+}
+
+/** Determine if job has finished.
+ *
+ * A job does not finish if it was never started, e.g. because
+ * jobs_run() failed before reaching it.
+ *
+ * @param job Job
+ * @return @c true iff the job has been run and has finished
+ */
+bool job_is_done(job_t *job)
+{
+	return job->done;
+}
+
+/** Get return code of finished job.
+ *
+ * @param job Job
+ * @return Return code of job function, EIO if the job did not
+ *         terminate normally or was not started at all
+ */
+int job_get_rc(job_t *job)
+{
+	if (!job->done)
+		return EIO;
+
+	return job->rc;
+}
+
+/** Get captured standard output of finished job.
+ *
+ * @param job Job
+ * @return File containing standard output of the job, positioned
+ *         at the beginning
+ */
+FILE *job_get_out(job_t *job)
+{
+	(void)fseek(job->outf, 0, SEEK_SET);
+	return job->outf;
+}
+
+/** Get captured standard error output of finished job.
+ *
+ * @param job Job
+ * @return File containing standard error output of the job, positioned
+ *         at the beginning
+ */
+FILE *job_get_err(job_t *job)
+{
+	(void)fseek(job->errf, 0, SEEK_SET);
+	return job->errf;
+}
+
+/** Get data passed from finished job.
+ *
+ * @param job Job
+ * @return File containing data written by the job function, positioned
+ *         at the beginning
+ */
+FILE *job_get_data(job_t *job)
+{
+	(void)fseek(job->dataf, 0, SEEK_SET);
+	return job->dataf;
+}
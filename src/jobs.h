@@ -0,0 +1,52 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Parallel jobs
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <types/jobs.h>
+
+extern bool jobs_supported(void);
+extern int jobs_create(unsigned, jobs_t **);
+extern void jobs_destroy(jobs_t *);
+extern void jobs_set_merge_out(jobs_t *, bool);
+extern unsigned jobs_ncpus(void);
+extern int jobs_add(jobs_t *, job_fn_t, void *, job_t **);
+extern int jobs_run(jobs_t *);
+extern int jobs_spawn(job_fn_t, void *);
+extern void jobs_reap(void);
+extern job_t *jobs_first(jobs_t *);
+extern job_t *jobs_next(job_t *);
+extern bool job_is_done(job_t *);
+extern int job_get_rc(job_t *);
+extern FILE *job_get_out(job_t *);
+extern FILE *job_get_err(job_t *);
+extern FILE *job_get_data(job_t *);
+extern int job_replay(job_t *);
+
+#endif
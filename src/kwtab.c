@@ -0,0 +1,284 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Keyword table
+ *
+ * Maps keywords (reserved words, mnemonics, register names) to token
+ * types using a perfect hash, so that each lookup needs a single probe.
+ * Keys are first hashed into buckets, then each bucket is assigned
+ * a displacement (seed of the second hash) such that all keys end up
+ * in distinct slots.
+ */
+
+#include <kwtab.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+enum {
+	/** Highest displacement to try */
+	kwtab_max_disp = 16383
+};
+
+/** Get keyword of a table entry.
+ *
+ * @param kwtab Keyword table
+ * @param i Entry index
+ * @return Keyword
+ */
+static const char *kwtab_kw(kwtab_t *kwtab, size_t i)
+{
+	return *(const char *const *)((const char *)kwtab->entries +
+	    i * kwtab->esize);
+}
+
+/** Compute seeded hash of a string.
+ *
+ * @param str String
+ * @param len Length of string
+ * @param seed Seed
+ * @return Hash value (32 bits)
+ */
+static unsigned long kwtab_hash(const char *str, size_t len,
+    unsigned long seed)
+{
+	unsigned long h;
+	size_t i;
+
+	/* FNV-1a with seeded offset basis */
+	h = (2166136261UL ^ (seed * 2654435761UL)) & 0xffffffffUL;
+	for (i = 0; i < len; i++) {
+		h ^= (unsigned char)str[i];
+		h = (h * 16777619UL) & 0xffffffffUL;
+	}
+
+	/* Fold the high bits in since only the low bits are used */
+	h ^= h >> 16;
+	return h;
+}
+
+/** Compute first-level bucket of a string.
+ *
+ * @param kwtab Keyword table
+ * @param str String
+ * @param len Length of string
+ * @return Bucket index
+ */
+static size_t kwtab_bucket(kwtab_t *kwtab, const char *str, size_t len)
+{
+	return kwtab_hash(str, len, 0) & (kwtab->nbuckets - 1);
+}
+
+/** Compute slot of a string given its bucket displacement.
+ *
+ * @param kwtab Keyword table
+ * @param str String
+ * @param len Length of string
+ * @param disp Displacement
+ * @return Slot index
+ */
+static size_t kwtab_slot(kwtab_t *kwtab, const char *str, size_t len,
+    unsigned disp)
+{
+	return kwtab_hash(str, len, (unsigned long)disp + 1) &
+	    (kwtab->nslots - 1);
+}
+
+/** Try to place all keys of a bucket using a displacement.
+ *
+ * @param kwtab Keyword table
+ * @param keys Entry indices of the keys in the bucket
+ * @param nkeys Number of keys
+ * @param disp Displacement to try
+ * @return @c true iff all keys were placed (otherwise nothing is placed)
+ */
+static bool kwtab_place(kwtab_t *kwtab, size_t *keys, size_t nkeys,
+    unsigned disp)
+{
+	const char *kw;
+	size_t s;
+	size_t i;
+	size_t j;
+
+	for (i = 0; i < nkeys; i++) {
+		kw = kwtab_kw(kwtab, keys[i]);
+		s = kwtab_slot(kwtab, kw, strlen(kw), disp);
+		if (kwtab->slot[s] != 0) {
+			/* Collision, undo */
+			for (j = 0; j < i; j++) {
+				kw = kwtab_kw(kwtab, keys[j]);
+				s = kwtab_slot(kwtab, kw, strlen(kw), disp);
+				kwtab->slot[s] = 0;
+			}
+
+			return false;
+		}
+
+		kwtab->slot[s] = keys[i] + 1;
+	}
+
+	return true;
+}
+
+/** Compute perfect hash for keyword table.
+ *
+ * If no perfect hash can be found, the table falls back to linear
+ * search.
+ *
+ * @param kwtab Keyword table
+ */
+static void kwtab_init(kwtab_t *kwtab)
+{
+	size_t keys[kwtab_max_slots];
+	size_t nkeys;
+	size_t maxkeys;
+	size_t bsize;
+	size_t b;
+	size_t i;
+	size_t len;
+	unsigned disp;
+	const char *kw;
+
+	kwtab->ready = true;
+	kwtab->perfect = false;
+	kwtab->maxlen = 0;
+
+	for (i = 0; i < kwtab->nentries; i++) {
+		len = strlen(kwtab_kw(kwtab, i));
+		if (len > kwtab->maxlen)
+			kwtab->maxlen = len;
+	}
+
+	if (kwtab->nentries == 0 || kwtab->nentries > kwtab_max_slots / 2)
+		return;
+
+	/* Load factor at most 1/2, two keys per bucket on average */
+	kwtab->nslots = 2;
+	while (kwtab->nslots < 2 * kwtab->nentries)
+		kwtab->nslots *= 2;
+	kwtab->nbuckets = 1;
+	while (kwtab->nbuckets < kwtab->nentries / 2 &&
+	    kwtab->nbuckets < kwtab_max_buckets)
+		kwtab->nbuckets *= 2;
+
+	for (i = 0; i < kwtab->nslots; i++)
+		kwtab->slot[i] = 0;
+
+	/* Find maximum bucket size */
+	maxkeys = 0;
+	for (b = 0; b < kwtab->nbuckets; b++) {
+		nkeys = 0;
+		for (i = 0; i < kwtab->nentries; i++) {
+			kw = kwtab_kw(kwtab, i);
+			if (kwtab_bucket(kwtab, kw, strlen(kw)) == b)
+				++nkeys;
+		}
+
+		if (nkeys > maxkeys)
+			maxkeys = nkeys;
+	}
+
+	/* Place biggest buckets first */
+	for (bsize = maxkeys; bsize > 0; bsize--) {
+		for (b = 0; b < kwtab->nbuckets; b++) {
+			nkeys = 0;
+			for (i = 0; i < kwtab->nentries; i++) {
+				kw = kwtab_kw(kwtab, i);
+				if (kwtab_bucket(kwtab, kw, strlen(kw)) == b)
+					keys[nkeys++] = i;
+			}
+
+			if (nkeys != bsize)
+				continue;
+
+			disp = 0;
+			while (!kwtab_place(kwtab, keys, nkeys, disp)) {
+				if (disp == kwtab_max_disp)
+					return;
+				++disp;
+			}
+
+			kwtab->disp[b] = disp;
+		}
+	}
+
+	kwtab->perfect = true;
+}
+
+/** Look up keyword.
+ *
+ * @param kwtab Keyword table
+ * @param str String (need not be null-terminated)
+ * @param len Length of string
+ * @return Pointer to matching entry or @c NULL if @a str is not a keyword
+ */
+const void *kwtab_lookup(kwtab_t *kwtab, const char *str, size_t len)
+{
+	const char *kw;
+	size_t s;
+	size_t i;
+
+	if (!kwtab->ready)
+		kwtab_init(kwtab);
+
+	if (len > kwtab->maxlen)
+		return NULL;
+
+	if (kwtab->perfect) {
+		s = kwtab_slot(kwtab, str, len,
+		    kwtab->disp[kwtab_bucket(kwtab, str, len)]);
+		if (kwtab->slot[s] == 0)
+			return NULL;
+
+		i = kwtab->slot[s] - 1;
+		kw = kwtab_kw(kwtab, i);
+		if (strncmp(kw, str, len) != 0 || kw[len] != '\0')
+			return NULL;
+
+		return (const char *)kwtab->entries + i * kwtab->esize;
+	}
+
+	for (i = 0; i < kwtab->nentries; i++) {
+		kw = kwtab_kw(kwtab, i);
+		if (strncmp(kw, str, len) == 0 && kw[len] == '\0')
+			break;
+	}
+
+	if (i >= kwtab->nentries)
+		return NULL;
+
+	return (const char *)kwtab->entries + i * kwtab->esize;
+}
+
+/** Get length of the longest keyword.
+ *
+ * @param kwtab Keyword table
+ * @return Length of the longest keyword
+ */
+size_t kwtab_maxlen(kwtab_t *kwtab)
+{
+	if (!kwtab->ready)
+		kwtab_init(kwtab);
+
+	return kwtab->maxlen;
+}
@@ -27,10 +27,10 @@
  * code for a procedure.
  */
 
+#include <adt/hmap.h>
 #include <labels.h>
 #include <merrno.h>
 #include <stdlib.h>
-#include <string.h>
 
 /** Create new labels structure.
  *
@@ -46,6 +46,7 @@ int labels_create(labels_t **rlabels)
 		return ENOMEM;
 
 	list_initialize(&labels->labels);
+	hmap_initialize(&labels->byname, hmk_str);
 	*rlabels = labels;
 	return EOK;
 }
@@ -69,6 +70,7 @@ void labels_destroy(labels_t *labels)
 		label = labels_first(labels);
 	}
 
+	hmap_fini(&labels->byname);
 	free(labels);
 }
 
@@ -82,6 +84,7 @@ void labels_destroy(labels_t *labels)
 int labels_define_label(labels_t *labels, lexer_tok_t *tident)
 {
 	label_t *label;
+	int rc;
 
 	label = labels_lookup(labels, tident->text);
 	if (label != NULL && label->defined) {
@@ -99,6 +102,12 @@ int labels_define_label(labels_t *labels, lexer_tok_t *tident)
 	if (label == NULL)
 		return ENOMEM;
 
+	rc = hmap_insert_str(&labels->byname, tident->text, label);
+	if (rc != EOK) {
+		free(label);
+		return ENOMEM;
+	}
+
 	label->tident = tident;
 	label->labels = labels;
 	label->defined = true;
@@ -115,6 +124,7 @@ int labels_define_label(labels_t *labels, lexer_tok_t *tident)
 int labels_use_label(labels_t *labels, lexer_tok_t *tident)
 {
 	label_t *label;
+	int rc;
 
 	label = labels_lookup(labels, tident->text);
 	if (label != NULL) {
@@ -127,6 +137,12 @@ int labels_use_label(labels_t *labels, lexer_tok_t *tident)
 	if (label == NULL)
 		return ENOMEM;
 
+	rc = hmap_insert_str(&labels->byname, tident->text, label);
+	if (rc != EOK) {
+		free(label);
+		return ENOMEM;
+	}
+
 	label->tident = tident;
 	label->labels = labels;
 	label->used = true;
@@ -174,15 +190,5 @@ label_t *labels_next(label_t *cur)
  */
 label_t *labels_lookup(labels_t *labels, const char *ident)
 {
-	label_t *label;
-
-	label = labels_first(labels);
-	while (label != NULL) {
-		if (strcmp(label->tident->text, ident) == 0)
-			return label;
-
-		label = labels_next(label);
-	}
-
-	return NULL;
+	return (label_t *)hmap_find_str(&labels->byname, ident);
 }
@@ -26,8 +26,10 @@
  * Lexical analyzer for the C language.
  */
 
+#include <arena.h>
 #include <assert.h>
 #include <charcls.h>
+#include <kwtab.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <src_pos.h>
@@ -35,6 +37,68 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strtab.h>
+
+/** Keywords */
+static const lexer_kw_t lexer_kw_entries[] = {
+	{ "_Alignas", ltt_alignas },
+	{ "_Alignof", ltt_alignof },
+	{ "_Atomic", ltt_atomic },
+	{ "_Bool", ltt_bool },
+	{ "_False", ltt_false },
+	{ "_True", ltt_true },
+	{ "__attribute__", ltt_attribute },
+	{ "__int128", ltt_int128 },
+	{ "__restrict__", ltt_restrict_alt },
+	{ "__va_arg", ltt_va_arg },
+	{ "__va_copy", ltt_va_copy },
+	{ "__va_end", ltt_va_end },
+	{ "__va_list", ltt_va_list },
+	{ "__va_start", ltt_va_start },
+	{ "alignof", ltt_alignof },
+	{ "asm", ltt_asm },
+	{ "auto", ltt_auto },
+	{ "break", ltt_break },
+	{ "case", ltt_case },
+	{ "char", ltt_char },
+	{ "const", ltt_const },
+	{ "continue", ltt_continue },
+	{ "default", ltt_default },
+	{ "do", ltt_do },
+	{ "double", ltt_double },
+	{ "else", ltt_else },
+	{ "enum", ltt_enum },
+	{ "extern", ltt_extern },
+	{ "float", ltt_float },
+	{ "for", ltt_for },
+	{ "goto", ltt_goto },
+	{ "if", ltt_if },
+	{ "inline", ltt_inline },
+	{ "int", ltt_int },
+	{ "long", ltt_long },
+	{ "register", ltt_register },
+	{ "restrict", ltt_restrict },
+	{ "return", ltt_return },
+	{ "short", ltt_short },
+	{ "signed", ltt_signed },
+	{ "sizeof", ltt_sizeof },
+	{ "static", ltt_static },
+	{ "struct", ltt_struct },
+	{ "switch", ltt_switch },
+	{ "typedef", ltt_typedef },
+	{ "union", ltt_union },
+	{ "unsigned", ltt_unsigned },
+	{ "void", ltt_void },
+	{ "volatile", ltt_volatile },
+	{ "while", ltt_while }
+};
+
+/** Keyword table */
+static kwtab_t lexer_kwtab = {
+	.entries = lexer_kw_entries,
+	.nentries = sizeof(lexer_kw_entries) / sizeof(lexer_kw_t),
+	.esize = sizeof(lexer_kw_t)
+};
 
 /** Create lexer.
  *
@@ -67,9 +131,28 @@ void lexer_destroy(lexer_t *lexer)
 	if (lexer == NULL)
 		return;
 
+	if (lexer->tbuf != NULL)
+		free(lexer->tbuf);
 	free(lexer);
 }
 
+/** Set arena for token text.
+ *
+ * Token text is then written directly to @a arena, identifier and
+ * keyword text is interned in @a strtab. Tokens produced this way must
+ * not be freed using lexer_free_tok(), their text is valid until
+ * the arena is destroyed.
+ *
+ * @param lexer Lexer
+ * @param arena Arena or @c NULL to allocate token text from the heap
+ * @param strtab String table or @c NULL
+ */
+void lexer_set_arena(lexer_t *lexer, arena_t *arena, strtab_t *strtab)
+{
+	lexer->arena = arena;
+	lexer->strtab = strtab;
+}
+
 /** Get valid pointer to characters in input buffer.
  *
  * Returns a pointer into the input buffer, ensuring it contains
@@ -78,13 +161,29 @@ void lexer_destroy(lexer_t *lexer)
  * @param lexer Lexer
  * @return Pointer to characters in input buffer.
  */
-static char *lexer_chars(lexer_t *lexer)
+static const char *lexer_chars(lexer_t *lexer)
 {
 	int rc;
 	size_t nread;
 	size_t i;
 	src_pos_t rpos;
 
+	if (!lexer->whole_checked) {
+		lexer->whole_checked = true;
+		if (lexer->input_ops->whole != NULL) {
+			rc = lexer->input_ops->whole(lexer->input_arg,
+			    &lexer->wbuf, &lexer->wsize, &lexer->wcpos);
+			if (rc == EOK) {
+				lexer->whole = true;
+				lexer->in_eof = true;
+				lexer->pos = lexer->wcpos;
+			}
+		}
+	}
+
+	if (lexer->whole)
+		return lexer->wbuf + lexer->wpos;
+
 	while (!lexer->in_eof && lexer->buf_used - lexer->buf_pos <
 	    lexer_buf_low_watermark) {
 		/* Move data to beginning of buffer */
@@ -134,12 +233,15 @@ static char *lexer_chars(lexer_t *lexer)
  */
 static bool lexer_is_eof(lexer_t *lexer)
 {
-	char *lc;
+	const char *lc;
 
 	/* Make sure buffer is filled, if possible */
 	lc = lexer_chars(lexer);
 	(void) lc;
 
+	if (lexer->whole)
+		return lexer->wpos == lexer->wsize;
+
 	return lexer->buf_pos == lexer->buf_used;
 }
 
@@ -160,6 +262,11 @@ static bool lexer_is_error(lexer_t *lexer)
  */
 static void lexer_get_pos(lexer_t *lexer, src_pos_t *pos)
 {
+	if (lexer->whole) {
+		*pos = lexer->wcpos;
+		return;
+	}
+
 	if (lexer->buf_pos < lexer->buf_used) {
 		*pos = lexer->posbuf[lexer->buf_pos];
 	} else if (lexer->buf_used > 0) {
@@ -172,30 +279,59 @@ static void lexer_get_pos(lexer_t *lexer, src_pos_t *pos)
  *
  * Advance read position by a certain amount of characters. Since all
  * input characters must be part of a token, the characters are added
- * to token @a tok.
+ * to the text of the token being lexed.
  *
  * @param lexer Lexer
  * @param nchars Number of characters to advance
- * @param tok Token to which the characters should
  *
  * @return EOK on success or non-zero error code
  */
-static int lexer_advance(lexer_t *lexer, size_t nchars, lexer_tok_t *tok)
+static int lexer_advance(lexer_t *lexer, size_t nchars)
 {
-	char *p;
-	char *ntext;
+	const char *p;
+	char *ntbuf;
+	size_t nsize;
 
-	while (nchars > 0) {
-		ntext = realloc(tok->text, tok->text_size + 2);
-		if (ntext == NULL)
+	p = lexer_chars(lexer);
+	if (lexer->whole) {
+		assert(lexer->wpos + nchars <= lexer->wsize);
+
+		/* Token text is contiguous in the input buffer */
+		if (!lexer->ttext) {
+			lexer->wtext = p;
+			lexer->ttext = true;
+		}
+
+		lexer->tsize += nchars;
+
+		while (nchars > 0) {
+			lexer->pos = lexer->wcpos;
+			src_pos_fwd_char(&lexer->wcpos, lexer->wbuf[lexer->wpos]);
+			++lexer->wpos;
+			--nchars;
+		}
+
+		return EOK;
+	}
+
+	if (lexer->tsize + nchars > lexer->tbuf_size) {
+		nsize = lexer->tbuf_size > 0 ? lexer->tbuf_size : 64;
+		while (lexer->tsize + nchars > nsize)
+			nsize *= 2;
+
+		ntbuf = realloc(lexer->tbuf, nsize);
+		if (ntbuf == NULL)
 			return ENOMEM;
 
-		tok->text = ntext;
+		lexer->tbuf = ntbuf;
+		lexer->tbuf_size = nsize;
+	}
 
+	lexer->ttext = true;
+
+	while (nchars > 0) {
 		p = lexer_chars(lexer);
-		tok->text[tok->text_size] = p[0];
-		tok->text[tok->text_size + 1] = '\0';
-		tok->text_size++;
+		lexer->tbuf[lexer->tsize++] = p[0];
 
 		if (lexer->buf_pos < lexer->buf_used)
 			lexer->pos = lexer->posbuf[lexer->buf_pos];
@@ -222,7 +358,7 @@ static int lexer_whitespace(lexer_t *lexer, lexer_toktype_t ltt,
 	lexer_get_pos(lexer, &tok->bpos);
 	lexer_get_pos(lexer, &tok->epos);
 	tok->ttype = ltt;
-	return lexer_advance(lexer, 1, tok);
+	return lexer_advance(lexer, 1);
 }
 
 /** Lex comment open.
@@ -237,14 +373,14 @@ static int lexer_copen(lexer_t *lexer, lexer_tok_t *tok)
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
 	}
 
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -264,24 +400,24 @@ static int lexer_copen(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_dcopen(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
 	}
 
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
 	}
 
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -292,7 +428,7 @@ static int lexer_dcopen(lexer_t *lexer, lexer_tok_t *tok)
 		/* Trailing documentation comment */
 		lexer_get_pos(lexer, &tok->epos);
 
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -321,7 +457,7 @@ static int lexer_cclose(lexer_t *lexer, lexer_tok_t *tok)
 	lexer_get_pos(lexer, &tok->bpos);
 
 	/* Skip trailing '*' */
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -329,7 +465,7 @@ static int lexer_cclose(lexer_t *lexer, lexer_tok_t *tok)
 
 	/* Final '/' */
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -349,7 +485,7 @@ static int lexer_cclose(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
@@ -359,7 +495,7 @@ static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
 	    (p[0] != '*' || p[1] != '/')) {
 		lexer_get_pos(lexer, &tok->epos);
 
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -381,11 +517,11 @@ static int lexer_ctext(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -393,7 +529,7 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 
 	p = lexer_chars(lexer);
 	while (p[0] != '\0' && (p[1] != '\n' || p[0] == '\\')) {
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -406,7 +542,7 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
 
 	if (p[0] != '\0') {
 		/* Skip trailing newline */
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -426,7 +562,7 @@ static int lexer_dscomment(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
@@ -440,7 +576,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 	while (p[0] != '\0' && (p[1] != '\n' || p[0] == '\\')) {
 		if (p[0] == '/' && p[1] == '*') {
 			/* Comment inside prerocessor line */
-			rc = lexer_advance(lexer, 2, tok);
+			rc = lexer_advance(lexer, 2);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -448,7 +584,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 
 			p = lexer_chars(lexer);
 			while (p[0] != '\0' && (p[0] != '*' || p[1] != '/')) {
-				rc = lexer_advance(lexer, 1, tok);
+				rc = lexer_advance(lexer, 1);
 				if (rc != EOK) {
 					lexer_free_tok(tok);
 					return rc;
@@ -459,7 +595,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 		}
 
 		if (p[0] != '\0') {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -471,7 +607,7 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 
 	if (p[0] != '\0') {
 		lexer_get_pos(lexer, &tok->epos);
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -493,18 +629,10 @@ static int lexer_preproc(lexer_t *lexer, lexer_tok_t *tok)
 static int lexer_onechar(lexer_t *lexer, lexer_toktype_t ttype,
     lexer_tok_t *tok)
 {
-	char *p;
-
 	lexer_get_pos(lexer, &tok->bpos);
 	lexer_get_pos(lexer, &tok->epos);
-	tok->text = malloc(2);
-	p = lexer_chars(lexer);
-	if (tok->text == NULL)
-		return ENOMEM;
-	tok->text[0] = p[0];
-	tok->text[1] = '\0';
 	tok->ttype = ttype;
-	return lexer_advance(lexer, 1, tok);
+	return lexer_advance(lexer, 1);
 }
 
 /** Lex keyword.
@@ -519,23 +647,15 @@ static int lexer_onechar(lexer_t *lexer, lexer_toktype_t ttype,
 static int lexer_keyword(lexer_t *lexer, lexer_toktype_t ttype,
     size_t nchars, lexer_tok_t *tok)
 {
-	char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
 
-	tok->text = malloc(nchars + 1);
-	p = lexer_chars(lexer);
-	if (tok->text == NULL)
-		return ENOMEM;
-	memcpy(tok->text, p, nchars);
-	tok->text[nchars] = '\0';
-
-	rc = lexer_advance(lexer, nchars - 1, tok);
+	rc = lexer_advance(lexer, nchars - 1);
 	if (rc != EOK)
 		return rc;
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -554,13 +674,13 @@ static int lexer_keyword(lexer_t *lexer, lexer_toktype_t ttype,
  */
 static int lexer_ident(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 
 	lexer_get_pos(lexer, &tok->bpos);
 	p = lexer_chars(lexer);
 	while (is_idcnt(p[1])) {
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -570,7 +690,7 @@ static int lexer_ident(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -589,7 +709,7 @@ static int lexer_ident(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	int rc;
 	bool floating;
 	int base;
@@ -608,7 +728,7 @@ static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 		exp_marker = 'p';
 		exp_cmarker = 'P';
 
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -616,7 +736,7 @@ static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 
 		p = lexer_chars(lexer);
 		while (is_hexdigit(p[1])) {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -631,7 +751,7 @@ static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 
 		/* Octal or decimal constant */
 		while (is_digit(p[1], base)) {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -649,7 +769,7 @@ static int lexer_number(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -662,7 +782,7 @@ dec_point:
 		floating = true;
 
 		while (is_digit(p[1], base)) {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -672,7 +792,7 @@ dec_point:
 		}
 
 		lexer_get_pos(lexer, &tok->epos);
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -686,7 +806,7 @@ dec_point:
 
 		/* Exponent sign */
 		if (p[1] == '+' || p[1] == '-') {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -697,7 +817,7 @@ dec_point:
 
 		/* Exponent digits */
 		while (is_num(p[1])) {
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -708,7 +828,7 @@ dec_point:
 
 		/* Last exponent digit */
 		lexer_get_pos(lexer, &tok->epos);
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -720,7 +840,7 @@ dec_point:
 	if (floating) {
 		if (p[0] == 'f' || p[0] == 'F' || p[0] == 'l' || p[0] == 'L') {
 			lexer_get_pos(lexer, &tok->epos);
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -731,7 +851,7 @@ dec_point:
 		while (p[0] == 'u' || p[0] == 'U' || p[0] == 'l' ||
 		    p[0] == 'L') {
 			lexer_get_pos(lexer, &tok->epos);
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -755,7 +875,7 @@ dec_point:
 static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 {
 	lexer_toktype_t ltt;
-	char *p;
+	const char *p;
 	char delim;
 	int rc;
 
@@ -764,13 +884,13 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 	p = lexer_chars(lexer);
 
 	if (p[0] == 'u' && p[1] == '8') {
-		rc = lexer_advance(lexer, 2, tok);
+		rc = lexer_advance(lexer, 2);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
 		}
 	} else if (p[0] == 'L' || p[0] == 'u' || p[0] == 'U') {
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -793,7 +913,7 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	while (true) {
-		rc = lexer_advance(lexer, 1, tok);
+		rc = lexer_advance(lexer, 1);
 		if (rc != EOK) {
 			lexer_free_tok(tok);
 			return rc;
@@ -810,7 +930,7 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 
 		if (p[0] == '\\') {
 			/* Skip the next character */
-			rc = lexer_advance(lexer, 1, tok);
+			rc = lexer_advance(lexer, 1);
 			if (rc != EOK) {
 				lexer_free_tok(tok);
 				return rc;
@@ -825,7 +945,7 @@ static int lexer_charstr(lexer_t *lexer, lexer_tok_t *tok)
 	}
 
 	lexer_get_pos(lexer, &tok->epos);
-	rc = lexer_advance(lexer, 1, tok);
+	rc = lexer_advance(lexer, 1);
 	if (rc != EOK) {
 		lexer_free_tok(tok);
 		return rc;
@@ -848,7 +968,7 @@ static int lexer_nonprint(lexer_t *lexer, lexer_tok_t *tok)
 	lexer_get_pos(lexer, &tok->epos);
 
 	tok->ttype = ltt_invchar;
-	return lexer_advance(lexer, 1, tok);
+	return lexer_advance(lexer, 1);
 }
 
 /** Lex invalid character.
@@ -864,7 +984,7 @@ static int lexer_invalid(lexer_t *lexer, lexer_tok_t *tok)
 	lexer_get_pos(lexer, &tok->epos);
 
 	tok->ttype = ltt_invalid;
-	return lexer_advance(lexer, 1, tok);
+	return lexer_advance(lexer, 1);
 }
 
 /** Lex End of File.
@@ -897,6 +1017,36 @@ static int lexer_error(lexer_t *lexer, lexer_tok_t *tok)
 	return EOK;
 }
 
+/** Lex identifier or reserved word.
+ *
+ * @param lexer Lexer
+ * @param tok Output token
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int lexer_word(lexer_t *lexer, lexer_tok_t *tok)
+{
+	const char *p;
+	size_t maxlen;
+	size_t len;
+	const lexer_kw_t *kw;
+
+	maxlen = kwtab_maxlen(&lexer_kwtab);
+	assert(maxlen < lexer_buf_low_watermark);
+
+	/* Determine word length (only up to longest keyword length + 1) */
+	p = lexer_chars(lexer);
+	len = 1;
+	while (len <= maxlen && is_idcnt(p[len]))
+		++len;
+
+	kw = kwtab_lookup(&lexer_kwtab, p, len);
+	if (kw != NULL)
+		return lexer_keyword(lexer, kw->ttype, len, tok);
+
+	return lexer_ident(lexer, tok);
+}
+
 /** Lex next token in normal state.
  *
  * @param lexer Lexer
@@ -906,7 +1056,7 @@ static int lexer_error(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_get_tok_normal(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 
 	memset(tok, 0, sizeof(lexer_tok_t));
 
@@ -1052,259 +1202,15 @@ static int lexer_get_tok_normal(lexer_t *lexer, lexer_tok_t *tok)
 		return lexer_invalid(lexer, tok);
 	case ']':
 		return lexer_onechar(lexer, ltt_rbracket, tok);
-	case '_':
-		if (p[1] == '_' && p[2] == 'v' && p[3] == 'a' &&
-		    p[4] == '_' && p[5] == 'a' && p[6] == 'r' &&
-		    p[7] == 'g' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_va_arg, 8, tok);
-		}
-		if (p[1] == '_' && p[2] == 'v' && p[3] == 'a' &&
-		    p[4] == '_' && p[5] == 'c' && p[6] == 'o' &&
-		    p[7] == 'p' && p[8] == 'y' && !is_idcnt(p[9])) {
-			return lexer_keyword(lexer, ltt_va_copy, 9, tok);
-		}
-		if (p[1] == '_' && p[2] == 'v' && p[3] == 'a' &&
-		    p[4] == '_' && p[5] == 'e' && p[6] == 'n' &&
-		    p[7] == 'd' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_va_end, 8, tok);
-		}
-		if (p[1] == '_' && p[2] == 'v' && p[3] == 'a' &&
-		    p[4] == '_' && p[5] == 'l' && p[6] == 'i' &&
-		    p[7] == 's' && p[8] == 't' && !is_idcnt(p[9])) {
-			return lexer_keyword(lexer, ltt_va_list, 9, tok);
-		}
-		if (p[1] == '_' && p[2] == 'v' && p[3] == 'a' &&
-		    p[4] == '_' && p[5] == 's' && p[6] == 't' &&
-		    p[7] == 'a' && p[8] == 'r' && p[9] == 't' &&
-		    !is_idcnt(p[10])) {
-			return lexer_keyword(lexer, ltt_va_start, 10, tok);
-		}
-		if (p[1] == '_' && p[2] == 'a' && p[3] == 't' &&
-		    p[4] == 't' && p[5] == 'r' && p[6] == 'i' &&
-		    p[7] == 'b' && p[8] == 'u' && p[9] == 't' &&
-		    p[10] == 'e' && p[11] == '_' && p[12] == '_' &&
-		    !is_idcnt(p[13])) {
-			return lexer_keyword(lexer, ltt_attribute, 13, tok);
-		}
-		if (p[1] == '_' && p[2] == 'i' && p[3] == 'n' &&
-		    p[4] == 't' && p[5] == '1' && p[6] == '2' &&
-		    p[7] == '8' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_int128, 8, tok);
-		}
-		if (p[1] == '_' && p[2] == 'r' && p[3] == 'e' &&
-		    p[4] == 's' && p[5] == 't' && p[6] == 'r' &&
-		    p[7] == 'i' && p[8] == 'c' && p[9] == 't' &&
-		    p[10] == '_' && p[11] == '_' && !is_idcnt(p[12])) {
-			return lexer_keyword(lexer, ltt_restrict_alt, 12, tok);
-		}
-		if (p[1] == 'A' && p[2] == 't' && p[3] == 'o' &&
-		    p[4] == 'm' && p[5] == 'i' && p[6] == 'c' &&
-		    !is_idcnt(p[7])) {
-			return lexer_keyword(lexer, ltt_atomic, 7, tok);
-		}
-		if (p[1] == 'A' && p[2] == 'l' && p[3] == 'i' &&
-		    p[4] == 'g' && p[5] == 'n' && p[6] == 'a' &&
-		    p[7] == 's' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_alignas, 8, tok);
-		}
-		if (p[1] == 'A' && p[2] == 'l' && p[3] == 'i' &&
-		    p[4] == 'g' && p[5] == 'n' && p[6] == 'o' &&
-		    p[7] == 'f' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_alignof, 8, tok);
-		}
-		if (p[1] == 'B' && p[2] == 'o' && p[3] == 'o' &&
-		    p[4] == 'l' && !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_bool, 5, tok);
-		}
-		if (p[1] == 'F' && p[2] == 'a' && p[3] == 'l' &&
-		    p[4] == 's' && p[5] == 'e' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_false, 6, tok);
-		}
-		if (p[1] == 'T' && p[2] == 'r' && p[3] == 'u' &&
-		    p[4] == 'e' && !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_true, 5, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'a':
-		if (p[1] == 's' && p[2] == 'm' && !is_idcnt(p[3])) {
-			return lexer_keyword(lexer, ltt_asm, 3, tok);
-		}
-		if (p[1] == 'u' && p[2] == 't' && p[3] == 'o' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_auto, 4, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'i' && p[3] == 'g' &&
-		    p[4] == 'n' && p[5] == 'o' && p[6] == 'f' &&
-		    !is_idcnt(p[7])) {
-			return lexer_keyword(lexer, ltt_alignof, 7, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'b':
-		if (p[1] == 'r' && p[2] == 'e' && p[3] == 'a' &&
-		    p[4] == 'k' && !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_break, 5, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'c':
-		if (p[1] == 'a' && p[2] == 's' && p[3] == 'e' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_case, 4, tok);
-		}
-		if (p[1] == 'h' && p[2] == 'a' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_char, 4, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'n' && p[3] == 's' &&
-		    p[4] == 't' && !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_const, 5, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'n' && p[3] == 't' &&
-		    p[4] == 'i' && p[5] == 'n' && p[6] == 'u' &&
-		    p[7] == 'e' && !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_continue, 8, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'd':
-		if (p[1] == 'e' && p[2] == 'f' && p[3] == 'a' &&
-		    p[4] == 'u' && p[5] == 'l' && p[6] == 't' &&
-		    !is_idcnt(p[7])) {
-			return lexer_keyword(lexer, ltt_default, 7, tok);
-		}
-		if (p[1] == 'o' && !is_idcnt(p[2])) {
-			return lexer_keyword(lexer, ltt_do, 2, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'u' && p[3] == 'b' && p[4] == 'l' &&
-		    p[5] == 'e' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_double, 6, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'e':
-		if (p[1] == 'l' && p[2] == 's' && p[3] == 'e' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_else, 4, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'u' && p[3] == 'm' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_enum, 4, tok);
-		}
-		if (p[1] == 'x' && p[2] == 't' && p[3] == 'e' && p[4] == 'r' &&
-		    p[5] == 'n' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_extern, 6, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'f':
-		if (p[1] == 'l' && p[2] == 'o' && p[3] == 'a' && p[4] == 't' &&
-		    !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_float, 5, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return lexer_keyword(lexer, ltt_for, 3, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'g':
-		if (p[1] == 'o' && p[2] == 't' && p[3] == 'o' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_goto, 4, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'i':
-		if (p[1] == 'f' && !is_idcnt(p[2]))
-			return lexer_keyword(lexer, ltt_if, 2, tok);
-		if (p[1] == 'n' && p[2] == 'l' && p[3] == 'i' && p[4] == 'n' &&
-		    p[5] == 'e' && !is_idcnt(p[6]))
-			return lexer_keyword(lexer, ltt_inline, 6, tok);
-		if (p[1] == 'n' && p[2] == 't' && !is_idcnt(p[3]))
-			return lexer_keyword(lexer, ltt_int, 3, tok);
-		return lexer_ident(lexer, tok);
-	case 'l':
-		if (p[1] == 'o' && p[2] == 'n' && p[3] == 'g' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_long, 4, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'r':
-		if (p[1] == 'e' && p[2] == 'g' && p[3] == 'i' && p[4] == 's' &&
-		    p[5] == 't' && p[6] == 'e' && p[7] == 'r' &&
-		    !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_register, 8, tok);
-		}
-		if (p[1] == 'e' && p[2] == 's' && p[3] == 't' && p[4] == 'r' &&
-		    p[5] == 'i' && p[6] == 'c' && p[7] == 't' &&
-		    !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_restrict, 8, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && p[3] == 'u' &&
-		    p[4] == 'r' && p[5] == 'n' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_return, 6, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 's':
-		if (p[1] == 'h' && p[2] == 'o' && p[3] == 'r' && p[4] == 't' &&
-		    !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_short, 5, tok);
-		}
-		if (p[1] == 'i' && p[2] == 'g' && p[3] == 'n' && p[4] == 'e' &&
-		    p[5] == 'd' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_signed, 6, tok);
-		}
-		if (p[1] == 'i' && p[2] == 'z' && p[3] == 'e' && p[4] == 'o' &&
-		    p[5] == 'f' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_sizeof, 6, tok);
-		}
-		if (p[1] == 't' && p[2] == 'a' && p[3] == 't' && p[4] == 'i' &&
-		    p[5] == 'c' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_static, 6, tok);
-		}
-		if (p[1] == 't' && p[2] == 'r' && p[3] == 'u' && p[4] == 'c' &&
-		    p[5] == 't' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_struct, 6, tok);
-		}
-		if (p[1] == 'w' && p[2] == 'i' && p[3] == 't' && p[4] == 'c' &&
-		    p[5] == 'h' && !is_idcnt(p[6])) {
-			return lexer_keyword(lexer, ltt_switch, 6, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 't':
-		if (p[1] == 'y' && p[2] == 'p' && p[3] == 'e' && p[4] == 'd' &&
-		    p[5] == 'e' && p[6] == 'f' && !is_idcnt(p[7])) {
-			return lexer_keyword(lexer, ltt_typedef, 7, tok);
-		}
-		return lexer_ident(lexer, tok);
 	case 'u':
 		if (p[1] == '\'' || p[1] == '"')
 			return lexer_charstr(lexer, tok);
 		if (p[1] == '8' && p[2] == '"')
 			return lexer_charstr(lexer, tok);
-		if (p[1] == 'n' && p[2] == 'i' && p[3] == 'o' && p[4] == 'n' &&
-		    !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_union, 5, tok);
-		}
-		if (p[1] == 'n' && p[2] == 's' && p[3] == 'i' && p[4] == 'g' &&
-		    p[5] == 'n' && p[6] == 'e' && p[7] == 'd' &&
-		    !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_unsigned, 8, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'v':
-		if (p[1] == 'o' && p[2] == 'i' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return lexer_keyword(lexer, ltt_void, 4, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'l' && p[3] == 'a' && p[4] == 't' &&
-		    p[5] == 'i' && p[6] == 'l' && p[7] == 'e' &&
-		    !is_idcnt(p[8])) {
-			return lexer_keyword(lexer, ltt_volatile, 8, tok);
-		}
-		return lexer_ident(lexer, tok);
-	case 'w':
-		if (p[1] == 'h' && p[2] == 'i' && p[3] == 'l' && p[4] == 'e' &&
-		    !is_idcnt(p[5])) {
-			return lexer_keyword(lexer, ltt_while, 5, tok);
-		}
-		return lexer_ident(lexer, tok);
+		return lexer_word(lexer, tok);
 	default:
 		if (is_idbegin(p[0]))
-			return lexer_ident(lexer, tok);
+			return lexer_word(lexer, tok);
 		if (is_num(p[0]))
 			return lexer_number(lexer, tok);
 		if (!is_print(p[0]))
@@ -1324,7 +1230,7 @@ static int lexer_get_tok_normal(lexer_t *lexer, lexer_tok_t *tok)
  */
 static int lexer_get_tok_comment(lexer_t *lexer, lexer_tok_t *tok)
 {
-	char *p;
+	const char *p;
 	memset(tok, 0, sizeof(lexer_tok_t));
 
 	p = lexer_chars(lexer);
@@ -1376,6 +1282,52 @@ bool lexer_tok_valid_chars(lexer_tok_t *tok, size_t offs, size_t *invpos)
 	return true;
 }
 
+/** Store text of the token that has just been lexed.
+ *
+ * The text is interned in the string table (identifiers and keywords),
+ * copied to the arena or, if the lexer has no arena, to the heap.
+ *
+ * @param lexer Lexer
+ * @param tok Token
+ * @return EOK on success or ENOMEM if out of memory
+ */
+static int lexer_tok_text(lexer_t *lexer, lexer_tok_t *tok)
+{
+	const char *text;
+	int rc;
+
+	if (!lexer->ttext) {
+		/* Token without text (such as end of file) */
+		tok->text = NULL;
+		tok->text_size = 0;
+		return EOK;
+	}
+
+	text = lexer->whole ? lexer->wtext : lexer->tbuf;
+
+	if (lexer->strtab != NULL && (tok->ttype == ltt_ident ||
+	    lexer_is_resword(tok->ttype))) {
+		rc = strtab_intern(lexer->strtab, text, lexer->tsize,
+		    &tok->text);
+		if (rc != EOK)
+			return rc;
+	} else if (lexer->arena != NULL) {
+		tok->text = arena_strndup(lexer->arena, text, lexer->tsize);
+		if (tok->text == NULL)
+			return ENOMEM;
+	} else {
+		tok->text = malloc(lexer->tsize + 1);
+		if (tok->text == NULL)
+			return ENOMEM;
+
+		memcpy(tok->text, text, lexer->tsize);
+		tok->text[lexer->tsize] = '\0';
+	}
+
+	tok->text_size = lexer->tsize;
+	return EOK;
+}
+
 /** Lex next token.
  *
  * @param lexer Lexer
@@ -1396,6 +1348,9 @@ int lexer_get_tok(lexer_t *lexer, lexer_tok_t *tok)
 	rc = EINVAL;
 #endif
 
+	lexer->ttext = false;
+	lexer->tsize = 0;
+
 	switch (lexer->state) {
 	case ls_normal:
 		rc = lexer_get_tok_normal(lexer, tok);
@@ -1408,7 +1363,7 @@ int lexer_get_tok(lexer_t *lexer, lexer_tok_t *tok)
 	if (rc != EOK)
 		return rc;
 
-	return EOK;
+	return lexer_tok_text(lexer, tok);
 }
 
 /** Free token.
@@ -1683,6 +1638,23 @@ int lexer_print_ttype(lexer_toktype_t ttype, FILE *f)
 	return EOK;
 }
 
+/** Format character into a string, escaping special characters.
+ *
+ * The character is formatted in the same way as by lexer_dprint_char().
+ *
+ * @param c Character to format
+ * @param buf Buffer of at least lexer_dchar_size characters
+ */
+void lexer_sprint_char(char c, char *buf)
+{
+	if (!is_print(c)) {
+		(void)snprintf(buf, lexer_dchar_size, "#%02x", c);
+	} else {
+		buf[0] = c;
+		buf[1] = '\0';
+	}
+}
+
 /** Print character, escaping special characters.
  *
  * @param c Character to print
@@ -1691,21 +1663,11 @@ int lexer_print_ttype(lexer_toktype_t ttype, FILE *f)
  */
 int lexer_dprint_char(char c, FILE *f)
 {
-	int rc;
+	char buf[lexer_dchar_size];
 
-	if (!is_print(c)) {
-		rc = fprintf(f, "#%02x", c);
-		if (rc < 0)
-			return EIO;
-	} else if (c == '#') {
-		rc = fputc('#', f);
-		if (rc == EOF)
-			return EIO;
-	} else {
-		rc = fputc(c, f);
-		if (rc == EOF)
-			return EIO;
-	}
+	lexer_sprint_char(c, buf);
+	if (fputs(buf, f) < 0)
+		return EIO;
 
 	return EOK;
 }
@@ -29,12 +29,16 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <types/arena.h>
 #include <types/lexer.h>
+#include <types/strtab.h>
 
 extern int lexer_create(lexer_input_ops_t *, void *, lexer_t **);
 extern void lexer_destroy(lexer_t *);
+extern void lexer_set_arena(lexer_t *, arena_t *, strtab_t *);
 extern int lexer_get_tok(lexer_t *, lexer_tok_t *);
 extern void lexer_free_tok(lexer_tok_t *);
+extern void lexer_sprint_char(char, char *);
 extern int lexer_dprint_char(char, FILE *);
 extern int lexer_dprint_tok(lexer_tok_t *, FILE *);
 extern int lexer_dprint_tok_range(lexer_tok_t *, src_pos_t *, src_pos_t *,
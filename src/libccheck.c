@@ -0,0 +1,833 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * C style checker library
+ *
+ * Checks source code held in memory (e.g. in an editor buffer) and
+ * returns the issues found as structured diagnostics and fixes.
+ *
+ * The document is divided into chunks, each containing one top-level
+ * declaration. When the document is edited, only the chunks touched by
+ * the edit are checked again. A chunk is extended to the following
+ * chunk(s) if it no longer ends with a declaration after the edit.
+ * If the changed part cannot be parsed on its own, the whole document
+ * is checked.
+ */
+
+#include <adt/list.h>
+#include <checker.h>
+#include <diag.h>
+#include <libccheck.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <str_input.h>
+#include <udiff.h>
+
+/** Result of checking a range of lines */
+typedef struct {
+	/** Document */
+	libccheck_doc_t *doc;
+	/** Diagnostics in order of position */
+	list_t diags; /* of libccheck_diag_t */
+	/** Lines where top-level declarations end */
+	uint32_t *dlines;
+	/** Number of entries in @c dlines */
+	size_t ndlines;
+} libccheck_result_t;
+
+/** Destroy diagnostic.
+ *
+ * @param diag Diagnostic
+ */
+static void libccheck_diag_destroy(libccheck_diag_t *diag)
+{
+	list_remove(&diag->ldiags);
+	free(diag->check);
+	free(diag->msg);
+	free(diag);
+}
+
+/** Destroy all diagnostics in a list.
+ *
+ * @param diags List of diagnostics
+ */
+static void libccheck_diags_clear(list_t *diags)
+{
+	link_t *link;
+
+	link = list_first(diags);
+	while (link != NULL) {
+		libccheck_diag_destroy(list_get_instance(link,
+		    libccheck_diag_t, ldiags));
+		link = list_first(diags);
+	}
+}
+
+/** Determine if source position lies before another one.
+ *
+ * @param a First position
+ * @param b Second position
+ * @return @c true iff @a a lies before @a b
+ */
+static bool libccheck_pos_before(src_pos_t *a, src_pos_t *b)
+{
+	return a->line < b->line || (a->line == b->line && a->col < b->col);
+}
+
+/** Insert diagnostic into a list sorted by position.
+ *
+ * Diagnostics at the same position are kept in order of insertion.
+ * The checker reports issues mostly in order of position, so we
+ * search from the end of the list.
+ *
+ * @param diags List of diagnostics
+ * @param diag Diagnostic to insert
+ */
+static void libccheck_diags_insert(list_t *diags, libccheck_diag_t *diag)
+{
+	link_t *link;
+	libccheck_diag_t *prev;
+
+	link = list_last(diags);
+	while (link != NULL) {
+		prev = list_get_instance(link, libccheck_diag_t, ldiags);
+		if (!libccheck_pos_before(&diag->bpos, &prev->bpos))
+			break;
+		link = list_prev(link, diags);
+	}
+
+	if (link != NULL)
+		list_insert_after(&diag->ldiags, link);
+	else
+		list_prepend(&diag->ldiags, diags);
+}
+
+/** Checker diagnostic callback.
+ *
+ * @param arg Result (libccheck_result_t *)
+ * @param entry Diagnostic reported by checker
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int libccheck_report(void *arg, diag_entry_t *entry)
+{
+	libccheck_result_t *res = (libccheck_result_t *)arg;
+	libccheck_diag_t *diag;
+
+	diag = calloc(1, sizeof(libccheck_diag_t));
+	if (diag == NULL)
+		return ENOMEM;
+
+	diag->check = strdup(entry->check);
+	if (diag->check == NULL)
+		goto error;
+
+	diag->msg = strdup(entry->msg);
+	if (diag->msg == NULL)
+		goto error;
+
+	diag->doc = res->doc;
+	diag->sev = entry->sev;
+	diag->fixable = entry->fixable;
+	diag->bpos = entry->bpos;
+	diag->epos = entry->epos;
+	link_initialize(&diag->ldiags);
+	libccheck_diags_insert(&res->diags, diag);
+	return EOK;
+error:
+	free(diag->check);
+	free(diag);
+	return ENOMEM;
+}
+
+/** Get offset of the beginning of a line.
+ *
+ * @param text Text
+ * @param size Size of text in bytes
+ * @param line Line number (starting from 1)
+ * @return Offset of the beginning of @a line or @a size if the text
+ *         has fewer lines
+ */
+static size_t libccheck_line_off(const char *text, size_t size,
+    uint32_t line)
+{
+	uint32_t l;
+	size_t i;
+
+	l = 1;
+	for (i = 0; i < size && l < line; i++) {
+		if (text[i] == '\n')
+			++l;
+	}
+
+	return i;
+}
+
+/** Count newline characters.
+ *
+ * @param text Text
+ * @param size Size of text in bytes
+ * @return Number of newline characters in @a text
+ */
+static uint32_t libccheck_count_nl(const char *text, size_t size)
+{
+	uint32_t n;
+	size_t i;
+
+	n = 0;
+	for (i = 0; i < size; i++) {
+		if (text[i] == '\n')
+			++n;
+	}
+
+	return n;
+}
+
+/** Free result of checking a range of lines.
+ *
+ * @param res Result
+ */
+static void libccheck_result_fini(libccheck_result_t *res)
+{
+	libccheck_diags_clear(&res->diags);
+	free(res->dlines);
+	res->dlines = NULL;
+}
+
+/** Create checker for a part of the document.
+ *
+ * @param doc Document
+ * @param line Number of the first line of the part
+ * @param boff Offset of the beginning of the part (the beginning of
+ *        line @a line)
+ * @param eoff Offset of the end of the part
+ * @param sinput String input to initialize
+ * @param rbuf Place to store pointer to copy of the part (to be freed
+ *        by the caller after destroying the checker)
+ * @param rchecker Place to store pointer to new checker
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int libccheck_checker_create(libccheck_doc_t *doc, uint32_t line,
+    size_t boff, size_t eoff, str_input_t *sinput, char **rbuf,
+    checker_t **rchecker)
+{
+	char *buf;
+	int rc;
+
+	buf = malloc(eoff - boff + 1);
+	if (buf == NULL)
+		return ENOMEM;
+
+	memcpy(buf, doc->text + boff, eoff - boff);
+	buf[eoff - boff] = '\0';
+
+	rc = str_input_init(sinput, buf);
+	if (rc != EOK) {
+		free(buf);
+		return rc;
+	}
+
+	sinput->cpos.line = line;
+
+	rc = checker_create(&lexer_str_input, sinput, doc->mtype, &doc->cfg,
+	    rchecker);
+	if (rc != EOK) {
+		free(buf);
+		return rc;
+	}
+
+	checker_set_fragment(*rchecker, boff == 0, eoff == doc->size);
+	checker_set_silent(*rchecker, true);
+	*rbuf = buf;
+	return EOK;
+}
+
+/** Check a range of lines of the document.
+ *
+ * @param doc Document
+ * @param line Number of the first line of the range
+ * @param boff Offset of the beginning of the range (the beginning of
+ *        line @a line)
+ * @param eoff Offset of the end of the range (beginning of a line or
+ *        the end of the document)
+ * @param res Place to store result
+ * @return EOK on success, EINVAL if the range cannot be parsed,
+ *         ENOMEM if out of memory
+ */
+static int libccheck_check_range(libccheck_doc_t *doc, uint32_t line,
+    size_t boff, size_t eoff, libccheck_result_t *res)
+{
+	checker_t *checker = NULL;
+	diag_t *diag = NULL;
+	str_input_t sinput;
+	char *buf = NULL;
+	int rc;
+
+	res->doc = doc;
+	list_initialize(&res->diags);
+	res->dlines = NULL;
+	res->ndlines = 0;
+
+	rc = libccheck_checker_create(doc, line, boff, eoff, &sinput, &buf,
+	    &checker);
+	if (rc != EOK)
+		goto error;
+
+	rc = diag_create_cb(libccheck_report, res, &diag);
+	if (rc != EOK)
+		goto error;
+
+	checker_set_diag(checker, diag);
+
+	rc = checker_run(checker, false);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_get_decl_lines(checker, &res->dlines, &res->ndlines);
+	if (rc != EOK)
+		goto error;
+
+	checker_destroy(checker);
+	diag_destroy(diag);
+	free(buf);
+	return EOK;
+error:
+	libccheck_result_fini(res);
+	if (checker != NULL)
+		checker_destroy(checker);
+	diag_destroy(diag);
+	free(buf);
+	return rc;
+}
+
+/** Compute chunk ends from result of checking a range of lines.
+ *
+ * @param res Result
+ * @param lend Last line of the range
+ * @param rcend Place to store pointer to array of chunk ends
+ * @param rnchunks Place to store number of chunks
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int libccheck_result_chunks(libccheck_result_t *res, uint32_t lend,
+    uint32_t **rcend, size_t *rnchunks)
+{
+	uint32_t *cend;
+	size_t nchunks;
+	size_t i;
+
+	cend = calloc(res->ndlines + 1, sizeof(uint32_t));
+	if (cend == NULL)
+		return ENOMEM;
+
+	nchunks = 0;
+	for (i = 0; i < res->ndlines; i++) {
+		/* Several declarations can end on the same line */
+		if (res->dlines[i] >= lend || (nchunks > 0 &&
+		    res->dlines[i] <= cend[nchunks - 1]))
+			continue;
+
+		cend[nchunks++] = res->dlines[i];
+	}
+
+	cend[nchunks++] = lend;
+	*rcend = cend;
+	*rnchunks = nchunks;
+	return EOK;
+}
+
+/** Determine if result of checking a range ends with a declaration.
+ *
+ * @param res Result
+ * @param lend Last line of the range
+ * @return @c true iff the last line of the range ends a declaration
+ */
+static bool libccheck_result_ends_decl(libccheck_result_t *res,
+    uint32_t lend)
+{
+	size_t i;
+
+	for (i = 0; i < res->ndlines; i++) {
+		if (res->dlines[i] >= lend)
+			return true;
+	}
+
+	return false;
+}
+
+/** Forget chunks and diagnostics of a document.
+ *
+ * @param doc Document
+ */
+static void libccheck_doc_invalidate(libccheck_doc_t *doc)
+{
+	libccheck_diags_clear(&doc->diags);
+	free(doc->cend);
+	doc->cend = NULL;
+	doc->nchunks = 0;
+	doc->valid = false;
+}
+
+/** Move diagnostics from result to document.
+ *
+ * The diagnostics are inserted before @a next.
+ *
+ * @param doc Document
+ * @param res Result
+ * @param next Diagnostic before which to insert or @c NULL to append
+ */
+static void libccheck_doc_take_diags(libccheck_doc_t *doc,
+    libccheck_result_t *res, libccheck_diag_t *next)
+{
+	link_t *link;
+
+	link = list_first(&res->diags);
+	while (link != NULL) {
+		list_remove(link);
+		if (next != NULL)
+			list_insert_before(link, &next->ldiags);
+		else
+			list_append(link, &doc->diags);
+		link = list_first(&res->diags);
+	}
+}
+
+/** Check the entire document.
+ *
+ * @param doc Document
+ * @return EOK on success, EINVAL if the document cannot be parsed,
+ *         ENOMEM if out of memory
+ */
+static int libccheck_doc_check(libccheck_doc_t *doc)
+{
+	libccheck_result_t res;
+	uint32_t lend;
+	uint32_t *cend;
+	size_t nchunks;
+	int rc;
+
+	libccheck_doc_invalidate(doc);
+
+	lend = libccheck_count_nl(doc->text, doc->size) + 1;
+	doc->nclines = lend;
+
+	rc = libccheck_check_range(doc, 1, 0, doc->size, &res);
+	if (rc != EOK)
+		return rc;
+
+	rc = libccheck_result_chunks(&res, lend, &cend, &nchunks);
+	if (rc != EOK) {
+		libccheck_result_fini(&res);
+		return rc;
+	}
+
+	libccheck_doc_take_diags(doc, &res, NULL);
+	libccheck_result_fini(&res);
+	doc->cend = cend;
+	doc->nchunks = nchunks;
+	doc->valid = true;
+	return EOK;
+}
+
+/** Create document.
+ *
+ * @param mtype Module type
+ * @param cfg Checker configuration (copied)
+ * @param rdoc Place to store pointer to new document
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int libccheck_doc_create(checker_mtype_t mtype, checker_cfg_t *cfg,
+    libccheck_doc_t **rdoc)
+{
+	libccheck_doc_t *doc;
+
+	doc = calloc(1, sizeof(libccheck_doc_t));
+	if (doc == NULL)
+		return ENOMEM;
+
+	doc->text = calloc(1, 1);
+	if (doc->text == NULL) {
+		free(doc);
+		return ENOMEM;
+	}
+
+	doc->mtype = mtype;
+	doc->cfg = *cfg;
+	list_initialize(&doc->diags);
+	*rdoc = doc;
+	return EOK;
+}
+
+/** Destroy document.
+ *
+ * @param doc Document or @c NULL
+ */
+void libccheck_doc_destroy(libccheck_doc_t *doc)
+{
+	if (doc == NULL)
+		return;
+
+	libccheck_doc_invalidate(doc);
+	free(doc->text);
+	free(doc);
+}
+
+/** Set document text and check the entire document.
+ *
+ * The text should not contain null characters (the text is only
+ * checked up to the first null character).
+ *
+ * @param doc Document
+ * @param text Text
+ * @param size Size of text in bytes
+ * @return EOK on success, EINVAL if the document cannot be parsed
+ *         (there are then no diagnostics), ENOMEM if out of memory
+ */
+int libccheck_doc_set_text(libccheck_doc_t *doc, const char *text,
+    size_t size)
+{
+	char *ntext;
+
+	ntext = malloc(size + 1);
+	if (ntext == NULL)
+		return ENOMEM;
+
+	memcpy(ntext, text, size);
+	ntext[size] = '\0';
+
+	free(doc->text);
+	doc->text = ntext;
+	doc->size = size;
+
+	return libccheck_doc_check(doc);
+}
+
+/** Replace chunks and diagnostics after an edit.
+ *
+ * @param doc Document
+ * @param c0 First chunk replaced
+ * @param c1 Last chunk replaced
+ * @param delta Change in number of lines
+ * @param res Result of checking the replaced chunks
+ * @param line First line of the replaced chunks
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int libccheck_doc_splice(libccheck_doc_t *doc, size_t c0, size_t c1,
+    int32_t delta, libccheck_result_t *res, uint32_t line)
+{
+	uint32_t *ncend;
+	size_t nnchunks;
+	uint32_t *cend;
+	size_t nchunks;
+	uint32_t lend;
+	link_t *link;
+	libccheck_diag_t *diag;
+	libccheck_diag_t *next;
+	size_t i;
+	int rc;
+
+	lend = (uint32_t)((int32_t)doc->cend[c1] + delta);
+	rc = libccheck_result_chunks(res, lend, &ncend, &nnchunks);
+	if (rc != EOK)
+		return rc;
+
+	nchunks = c0 + nnchunks + (doc->nchunks - c1 - 1);
+	cend = calloc(nchunks, sizeof(uint32_t));
+	if (cend == NULL) {
+		free(ncend);
+		return ENOMEM;
+	}
+
+	for (i = 0; i < c0; i++)
+		cend[i] = doc->cend[i];
+	for (i = 0; i < nnchunks; i++)
+		cend[c0 + i] = ncend[i];
+	for (i = c1 + 1; i < doc->nchunks; i++)
+		cend[i - c1 - 1 + c0 + nnchunks] =
+		    (uint32_t)((int32_t)doc->cend[i] + delta);
+
+	/* Remove old diagnostics of the replaced chunks, shift the rest */
+	next = NULL;
+	link = list_first(&doc->diags);
+	while (link != NULL) {
+		diag = list_get_instance(link, libccheck_diag_t, ldiags);
+		link = list_next(link, &doc->diags);
+
+		if (diag->bpos.line < line)
+			continue;
+
+		if (diag->bpos.line <= doc->cend[c1]) {
+			libccheck_diag_destroy(diag);
+			continue;
+		}
+
+		if (next == NULL)
+			next = diag;
+
+		diag->bpos.line = (uint32_t)((int32_t)diag->bpos.line + delta);
+		diag->epos.line = (uint32_t)((int32_t)diag->epos.line + delta);
+	}
+
+	libccheck_doc_take_diags(doc, res, next);
+
+	free(ncend);
+	free(doc->cend);
+	doc->cend = cend;
+	doc->nchunks = nchunks;
+	return EOK;
+}
+
+/** Edit document text and check the changed part.
+ *
+ * Replaces bytes from @a boff up to (not including) @a eoff with
+ * @a text. Only the top-level declarations touched by the edit are
+ * checked again, unless the changed part cannot be parsed on its own.
+ *
+ * @param doc Document
+ * @param boff Offset of the beginning of the replaced range
+ * @param eoff Offset of the end of the replaced range
+ * @param text Replacement text
+ * @param size Size of replacement text in bytes
+ * @return EOK on success, EINVAL if the range is not valid or the
+ *         document cannot be parsed (there are then no diagnostics),
+ *         ENOMEM if out of memory
+ */
+int libccheck_doc_edit(libccheck_doc_t *doc, size_t boff, size_t eoff,
+    const char *text, size_t size)
+{
+	libccheck_result_t res;
+	char *ntext;
+	size_t nsize;
+	uint32_t bline, eline;
+	uint32_t line;
+	uint32_t lend;
+	int32_t delta;
+	size_t c0, c1;
+	size_t sboff, seoff;
+	int rc;
+
+	if (boff > eoff || eoff > doc->size)
+		return EINVAL;
+
+	nsize = doc->size - (eoff - boff) + size;
+	ntext = malloc(nsize + 1);
+	if (ntext == NULL)
+		return ENOMEM;
+
+	memcpy(ntext, doc->text, boff);
+	memcpy(ntext + boff, text, size);
+	memcpy(ntext + boff + size, doc->text + eoff, doc->size - eoff);
+	ntext[nsize] = '\0';
+
+	/* Lines touched by the edit (in the old text) */
+	bline = libccheck_count_nl(doc->text, boff) + 1;
+	eline = bline + libccheck_count_nl(doc->text + boff, eoff - boff);
+	delta = (int32_t)libccheck_count_nl(text, size) -
+	    (int32_t)(eline - bline);
+
+	free(doc->text);
+	doc->text = ntext;
+	doc->size = nsize;
+
+	if (!doc->valid)
+		return libccheck_doc_check(doc);
+
+	/* Chunks touched by the edit */
+	c0 = 0;
+	while (doc->cend[c0] < bline)
+		++c0;
+	c1 = c0;
+	while (doc->cend[c1] < eline)
+		++c1;
+
+	line = c0 > 0 ? doc->cend[c0 - 1] + 1 : 1;
+	sboff = libccheck_line_off(doc->text, doc->size, line);
+
+	while (true) {
+		lend = (uint32_t)((int32_t)doc->cend[c1] + delta);
+		if (c1 + 1 < doc->nchunks) {
+			seoff = libccheck_line_off(doc->text, doc->size,
+			    lend + 1);
+		} else {
+			seoff = doc->size;
+		}
+
+		doc->nclines = lend + 1 - line;
+		rc = libccheck_check_range(doc, line, sboff, seoff, &res);
+		if (rc == ENOMEM)
+			return rc;
+
+		/* Cannot be parsed on its own, check the entire document */
+		if (rc != EOK)
+			return libccheck_doc_check(doc);
+
+		/*
+		 * If the range no longer ends with a declaration, what
+		 * follows may belong to the next declaration.
+		 */
+		if (seoff == doc->size || libccheck_result_ends_decl(&res,
+		    lend))
+			break;
+
+		libccheck_result_fini(&res);
+		++c1;
+	}
+
+	rc = libccheck_doc_splice(doc, c0, c1, delta, &res, line);
+	libccheck_result_fini(&res);
+	return rc;
+}
+
+/** Get first diagnostic of a document.
+ *
+ * Diagnostics are ordered by position.
+ *
+ * @param doc Document
+ * @return First diagnostic or @c NULL if there are none
+ */
+libccheck_diag_t *libccheck_diag_first(libccheck_doc_t *doc)
+{
+	link_t *link;
+
+	link = list_first(&doc->diags);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, libccheck_diag_t, ldiags);
+}
+
+/** Get next diagnostic of a document.
+ *
+ * @param diag Current diagnostic
+ * @return Next diagnostic or @c NULL if @a diag is the last one
+ */
+libccheck_diag_t *libccheck_diag_next(libccheck_diag_t *diag)
+{
+	link_t *link;
+
+	link = list_next(&diag->ldiags, &diag->doc->diags);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, libccheck_diag_t, ldiags);
+}
+
+/** Get fixes for the issues in the document.
+ *
+ * Fixes are computed by fixing the entire document and comparing
+ * the result with the original text line by line.
+ *
+ * @param doc Document
+ * @param rfixes Place to store pointer to array of fixes in order
+ *        of position (to be freed using libccheck_fixes_destroy())
+ * @param rnfixes Place to store number of fixes
+ * @return EOK on success, EINVAL if the document cannot be parsed,
+ *         ENOMEM if out of memory
+ */
+int libccheck_doc_fixes(libccheck_doc_t *doc, libccheck_fix_t **rfixes,
+    size_t *rnfixes)
+{
+	checker_t *checker = NULL;
+	str_input_t sinput;
+	char *buf = NULL;
+	char *ftext = NULL;
+	size_t fsize;
+	udiff_edit_t *edits = NULL;
+	size_t nedits;
+	libccheck_fix_t *fixes = NULL;
+	size_t i;
+	int rc;
+
+	rc = libccheck_checker_create(doc, 1, 0, doc->size, &sinput, &buf,
+	    &checker);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_run(checker, true);
+	if (rc != EOK)
+		goto error;
+
+	rc = checker_print_str(checker, &ftext, &fsize);
+	if (rc != EOK)
+		goto error;
+
+	rc = udiff_edits(doc->text, doc->size, ftext, fsize, &edits,
+	    &nedits);
+	if (rc != EOK)
+		goto error;
+
+	fixes = calloc(nedits + 1, sizeof(libccheck_fix_t));
+	if (fixes == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	for (i = 0; i < nedits; i++) {
+		fixes[i].line = (uint32_t)edits[i].aline + 1;
+		fixes[i].nlines = (uint32_t)edits[i].alines;
+		fixes[i].size = edits[i].bsize;
+		fixes[i].text = malloc(edits[i].bsize + 1);
+		if (fixes[i].text == NULL) {
+			libccheck_fixes_destroy(fixes, i);
+			fixes = NULL;
+			rc = ENOMEM;
+			goto error;
+		}
+
+		memcpy(fixes[i].text, ftext + edits[i].boff, edits[i].bsize);
+		fixes[i].text[edits[i].bsize] = '\0';
+	}
+
+	checker_destroy(checker);
+	free(buf);
+	free(ftext);
+	free(edits);
+	*rfixes = fixes;
+	*rnfixes = nedits;
+	return EOK;
+error:
+	if (checker != NULL)
+		checker_destroy(checker);
+	free(buf);
+	free(ftext);
+	free(edits);
+	return rc;
+}
+
+/** Destroy array of fixes.
+ *
+ * @param fixes Array of fixes or @c NULL
+ * @param nfixes Number of fixes
+ */
+void libccheck_fixes_destroy(libccheck_fix_t *fixes, size_t nfixes)
+{
+	size_t i;
+
+	if (fixes == NULL)
+		return;
+
+	for (i = 0; i < nfixes; i++)
+		free(fixes[i].text);
+	free(fixes);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * C style checker library
+ */
+
+#ifndef LIBCCHECK_H
+#define LIBCCHECK_H
+
+#include <stddef.h>
+#include <types/checker.h>
+#include <types/libccheck.h>
+
+extern int libccheck_doc_create(checker_mtype_t, checker_cfg_t *,
+    libccheck_doc_t **);
+extern void libccheck_doc_destroy(libccheck_doc_t *);
+extern int libccheck_doc_set_text(libccheck_doc_t *, const char *, size_t);
+extern int libccheck_doc_edit(libccheck_doc_t *, size_t, size_t,
+    const char *, size_t);
+extern libccheck_diag_t *libccheck_diag_first(libccheck_doc_t *);
+extern libccheck_diag_t *libccheck_diag_next(libccheck_diag_t *);
+extern int libccheck_doc_fixes(libccheck_doc_t *, libccheck_fix_t **,
+    size_t *);
+extern void libccheck_fixes_destroy(libccheck_fix_t *, size_t);
+
+#endif
@@ -0,0 +1,596 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Bank switching trampolines
+ *
+ * Code placed in a memory bank can only be executed while that bank
+ * is paged in at the memory window starting at obj_bank_base.
+ * When a call crosses a bank boundary, the linker redirects it to
+ * a stub, located in common memory, which saves A and HL, loads the
+ * target address and bank and jumps to a common switching routine.
+ *
+ * The switching routine moves the caller's return address (together
+ * with the previous paging state) from the stack to a separate bank
+ * call stack, pages in the target bank and calls the target. Since
+ * exactly one return address is removed and one is pushed, the stack
+ * layout seen by the callee (including stack arguments) is the same
+ * as with a direct call. On return the previous bank is restored
+ * and the original return address is pushed back.
+ *
+ * Registers A, BC, DE and HL are preserved on the way in (arguments)
+ * and on the way out (return value). Flags are not preserved.
+ * Interrupts are enabled after switching banks.
+ */
+
+#include <adt/list.h>
+#include <merrno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <object/banksw.h>
+#include <object/section.h>
+#include <object/symbol.h>
+
+static int obj_banksw_gen(obj_banksw_t *);
+
+/** Page in bank (after paging value has been stored to BANKM) */
+static const uint8_t obj_banksw_page_out[] = {
+	0xed, 0x79, /* out (c), a */
+	0xfb /* ei */
+};
+
+/** Switching routine entry: save BC, DE, keep return address in DE */
+static const uint8_t obj_banksw_enter1[] = {
+	0xe1, /* pop hl */
+	0xd5, /* push de */
+	0xc5, /* push bc */
+	0x47, /* ld b, a */
+	0xeb /* ex de, hl */
+};
+
+/** Switching routine entry: push return address to bank call stack */
+static const uint8_t obj_banksw_enter2[] = {
+	0x73, /* ld (hl), e */
+	0x23, /* inc hl */
+	0x72, /* ld (hl), d */
+	0x23 /* inc hl */
+};
+
+/** Switching routine entry: push paging value to bank call stack */
+static const uint8_t obj_banksw_enter3[] = {
+	0x77, /* ld (hl), a */
+	0x23 /* inc hl */
+};
+
+/** Switching routine entry: compute paging value of target bank */
+static const uint8_t obj_banksw_enter4[] = {
+	0xe6, 0xf8, /* and 0xf8 */
+	0xb0 /* or b */
+};
+
+/** Switching routine entry: restore BC, DE */
+static const uint8_t obj_banksw_enter5[] = {
+	0xc1, /* pop bc */
+	0xd1 /* pop de */
+};
+
+/** Switching routine exit: save BC, DE */
+static const uint8_t obj_banksw_leave1[] = {
+	0xd5, /* push de */
+	0xc5 /* push bc */
+};
+
+/** Switching routine exit: pop paging value from bank call stack */
+static const uint8_t obj_banksw_leave2[] = {
+	0x2b, /* dec hl */
+	0x7e /* ld a, (hl) */
+};
+
+/** Switching routine exit: pop return address from bank call stack */
+static const uint8_t obj_banksw_leave3[] = {
+	0x2b, /* dec hl */
+	0x56, /* ld d, (hl) */
+	0x2b, /* dec hl */
+	0x5e /* ld e, (hl) */
+};
+
+/** Switching routine exit: restore BC, DE, push return address */
+static const uint8_t obj_banksw_leave4[] = {
+	0xeb, /* ex de, hl */
+	0xc1, /* pop bc */
+	0xd1, /* pop de */
+	0xe5 /* push hl */
+};
+
+/** Create bank switching trampolines.
+ *
+ * @param object Object where the trampolines should be placed
+ * @param rbanksw Place to store pointer to new bank switching trampolines
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_banksw_create(obj_object_t *object, obj_banksw_t **rbanksw)
+{
+	obj_banksw_t *banksw;
+	obj_symbol_t *symbol;
+	int rc;
+
+	banksw = calloc(1, sizeof(obj_banksw_t));
+	if (banksw == NULL)
+		return ENOMEM;
+
+	banksw->object = object;
+	list_initialize(&banksw->stubs);
+
+	/* Use tag so that the section is merged with the rest of common */
+	rc = obj_section_create(object, "common@banksw", "banksw",
+	    &banksw->section);
+	if (rc != EOK)
+		goto error;
+
+	rc = obj_symbol_create(object, "__banksw_call", banksw->section,
+	    objb_local, objk_code, 0, 0, &symbol);
+	if (rc != EOK)
+		goto error;
+
+	banksw->call_sym = symbol;
+
+	rc = obj_banksw_gen(banksw);
+	if (rc != EOK)
+		goto error;
+
+	*rbanksw = banksw;
+	return EOK;
+error:
+	free(banksw);
+	return rc;
+}
+
+/** Destroy bank switching trampolines.
+ *
+ * The trampoline section and symbols are owned by the object
+ * and are not destroyed.
+ *
+ * @param banksw Bank switching trampolines or @c NULL
+ */
+void obj_banksw_destroy(obj_banksw_t *banksw)
+{
+	obj_banksw_stub_t *stub;
+
+	if (banksw == NULL)
+		return;
+
+	stub = obj_banksw_first(banksw);
+	while (stub != NULL) {
+		list_remove(&stub->lstubs);
+		free(stub);
+		stub = obj_banksw_first(banksw);
+	}
+
+	free(banksw);
+}
+
+/** Get trampoline stub for calling a banked symbol.
+ *
+ * If a stub for the symbol does not exist yet, it is created.
+ *
+ * @param banksw Bank switching trampolines
+ * @param target Target symbol
+ * @param bank Bank containing the target symbol
+ * @param rstub Place to store pointer to stub
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_banksw_get_stub(obj_banksw_t *banksw, obj_symbol_t *target,
+    unsigned bank, obj_banksw_stub_t **rstub)
+{
+	obj_banksw_stub_t *stub;
+	char *name = NULL;
+	int rc;
+	int rv;
+
+	stub = obj_banksw_first(banksw);
+	while (stub != NULL) {
+		if (stub->target == target) {
+			*rstub = stub;
+			return EOK;
+		}
+
+		stub = obj_banksw_next(stub);
+	}
+
+	stub = calloc(1, sizeof(obj_banksw_stub_t));
+	if (stub == NULL)
+		return ENOMEM;
+
+	rv = asprintf(&name, "__banksw_%u", banksw->nstubs);
+	if (rv < 0) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = obj_symbol_create(banksw->object, name, banksw->section,
+	    objb_global, objk_code, 0, obj_banksw_stub_size, &stub->symbol);
+	if (rc != EOK)
+		goto error;
+
+	free(name);
+
+	stub->banksw = banksw;
+	stub->target = target;
+	stub->bank = bank;
+	list_append(&stub->lstubs, &banksw->stubs);
+	++banksw->nstubs;
+
+	/* Regenerate to update section size and stub symbol offsets. */
+	rc = obj_banksw_gen(banksw);
+	if (rc != EOK)
+		return rc;
+
+	*rstub = stub;
+	return EOK;
+error:
+	if (name != NULL)
+		free(name);
+	free(stub);
+	return rc;
+}
+
+/** Finish bank switching trampolines.
+ *
+ * This must be called once addresses have been assigned to all sections,
+ * to fill in the final addresses.
+ *
+ * @param banksw Bank switching trampolines
+ * @return EOK on success or an error code
+ */
+int obj_banksw_finish(obj_banksw_t *banksw)
+{
+	return obj_banksw_gen(banksw);
+}
+
+/** Get first trampoline stub.
+ *
+ * @param banksw Bank switching trampolines
+ * @return First stub or @c NULL if there are none
+ */
+obj_banksw_stub_t *obj_banksw_first(obj_banksw_t *banksw)
+{
+	link_t *link;
+
+	link = list_first(&banksw->stubs);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_banksw_stub_t, lstubs);
+}
+
+/** Get next trampoline stub.
+ *
+ * @param cur Current stub
+ * @return Next stub or @c NULL if @a cur is the last one
+ */
+obj_banksw_stub_t *obj_banksw_next(obj_banksw_stub_t *cur)
+{
+	link_t *link;
+
+	link = list_next(&cur->lstubs, &cur->banksw->stubs);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_banksw_stub_t, lstubs);
+}
+
+/** Append instruction with 16-bit operand.
+ *
+ * @param section Section
+ * @param opc Opcode
+ * @param nn 16-bit operand
+ * @return EOK on success or an error code
+ */
+static int obj_banksw_op_nn(obj_section_t *section, uint8_t opc, uint16_t nn)
+{
+	int rc;
+
+	rc = obj_section_append_u8(section, opc);
+	if (rc != EOK)
+		return rc;
+
+	return obj_section_append_u16le(section, nn);
+}
+
+/** Append a sequence of single-byte instructions.
+ *
+ * @param section Section
+ * @param ops Instruction bytes
+ * @param nops Number of bytes
+ * @return EOK on success or an error code
+ */
+static int obj_banksw_ops(obj_section_t *section, const uint8_t *ops,
+    size_t nops)
+{
+	size_t i;
+	int rc;
+
+	for (i = 0; i < nops; i++) {
+		rc = obj_section_append_u8(section, ops[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Append instructions switching to bank whose paging value is in A.
+ *
+ * Clobbers BC. Value of A is preserved.
+ *
+ * @param section Section
+ * @return EOK on success or an error code
+ */
+static int obj_banksw_gen_page(obj_section_t *section)
+{
+	int rc;
+
+	/* ld bc, obj_banksw_port */
+	rc = obj_banksw_op_nn(section, 0x01, obj_banksw_port);
+	if (rc != EOK)
+		return rc;
+
+	/* di */
+	rc = obj_section_append_u8(section, 0xf3);
+	if (rc != EOK)
+		return rc;
+
+	/* ld (obj_banksw_bankm), a */
+	rc = obj_banksw_op_nn(section, 0x32, obj_banksw_bankm);
+	if (rc != EOK)
+		return rc;
+
+	return obj_banksw_ops(section, obj_banksw_page_out,
+	    sizeof(obj_banksw_page_out));
+}
+
+/** Generate contents of the trampoline section.
+ *
+ * Layout: saved A (1 byte), saved HL (2 bytes), bank call stack pointer
+ * (2 bytes), bank call stack, switching routine, stubs.
+ *
+ * @param banksw Bank switching trampolines
+ * @return EOK on success or an error code
+ */
+static int obj_banksw_gen(obj_banksw_t *banksw)
+{
+	obj_section_t *section = banksw->section;
+	obj_banksw_stub_t *stub;
+	uint16_t base;
+	uint16_t sav_a;
+	uint16_t sav_hl;
+	uint16_t bsp;
+	uint16_t bstack;
+	uint16_t routine;
+	uint16_t call_op;
+	uint16_t target;
+	unsigned i;
+	int rc;
+
+	/* Start from scratch */
+	section->len = 0;
+
+	base = (uint16_t)section->base_addr;
+	sav_a = base;
+	sav_hl = base + 1;
+	bsp = base + 3;
+	bstack = base + 5;
+
+	/* Saved A */
+	rc = obj_section_append_u8(section, 0);
+	if (rc != EOK)
+		return rc;
+
+	/* Saved HL */
+	rc = obj_section_append_u16le(section, 0);
+	if (rc != EOK)
+		return rc;
+
+	/* Bank call stack pointer */
+	rc = obj_section_append_u16le(section, bstack);
+	if (rc != EOK)
+		return rc;
+
+	/* Bank call stack (return address + paging value) */
+	for (i = 0; i < 3 * obj_banksw_depth; i++) {
+		rc = obj_section_append_u8(section, 0);
+		if (rc != EOK)
+			return rc;
+	}
+
+	/*
+	 * Switching routine. On entry A = target bank, target address
+	 * has been stored into the operand of the call instruction below.
+	 */
+	routine = base + (uint16_t)section->len;
+	banksw->call_sym->offset = section->len;
+
+	rc = obj_banksw_ops(section, obj_banksw_enter1,
+	    sizeof(obj_banksw_enter1));
+	if (rc != EOK)
+		return rc;
+
+	/* ld hl, (bsp) */
+	rc = obj_banksw_op_nn(section, 0x2a, bsp);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_enter2,
+	    sizeof(obj_banksw_enter2));
+	if (rc != EOK)
+		return rc;
+
+	/* ld a, (obj_banksw_bankm) */
+	rc = obj_banksw_op_nn(section, 0x3a, obj_banksw_bankm);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_enter3,
+	    sizeof(obj_banksw_enter3));
+	if (rc != EOK)
+		return rc;
+
+	/* ld (bsp), hl */
+	rc = obj_banksw_op_nn(section, 0x22, bsp);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_enter4,
+	    sizeof(obj_banksw_enter4));
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_gen_page(section);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_enter5,
+	    sizeof(obj_banksw_enter5));
+	if (rc != EOK)
+		return rc;
+
+	/* ld hl, (sav_hl) */
+	rc = obj_banksw_op_nn(section, 0x2a, sav_hl);
+	if (rc != EOK)
+		return rc;
+
+	/* ld a, (sav_a) */
+	rc = obj_banksw_op_nn(section, 0x3a, sav_a);
+	if (rc != EOK)
+		return rc;
+
+	/* call <target> (operand is filled in by the stub) */
+	call_op = base + (uint16_t)section->len + 1;
+	rc = obj_banksw_op_nn(section, 0xcd, 0);
+	if (rc != EOK)
+		return rc;
+
+	/* ld (sav_hl), hl */
+	rc = obj_banksw_op_nn(section, 0x22, sav_hl);
+	if (rc != EOK)
+		return rc;
+
+	/* ld (sav_a), a */
+	rc = obj_banksw_op_nn(section, 0x32, sav_a);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_leave1,
+	    sizeof(obj_banksw_leave1));
+	if (rc != EOK)
+		return rc;
+
+	/* ld hl, (bsp) */
+	rc = obj_banksw_op_nn(section, 0x2a, bsp);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_leave2,
+	    sizeof(obj_banksw_leave2));
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_gen_page(section);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_leave3,
+	    sizeof(obj_banksw_leave3));
+	if (rc != EOK)
+		return rc;
+
+	/* ld (bsp), hl */
+	rc = obj_banksw_op_nn(section, 0x22, bsp);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_banksw_ops(section, obj_banksw_leave4,
+	    sizeof(obj_banksw_leave4));
+	if (rc != EOK)
+		return rc;
+
+	/* ld hl, (sav_hl) */
+	rc = obj_banksw_op_nn(section, 0x2a, sav_hl);
+	if (rc != EOK)
+		return rc;
+
+	/* ld a, (sav_a) */
+	rc = obj_banksw_op_nn(section, 0x3a, sav_a);
+	if (rc != EOK)
+		return rc;
+
+	/* ret */
+	rc = obj_section_append_u8(section, 0xc9);
+	if (rc != EOK)
+		return rc;
+
+	/* Stubs */
+	stub = obj_banksw_first(banksw);
+	while (stub != NULL) {
+		stub->symbol->offset = section->len;
+		target = (uint16_t)(stub->target->section->base_addr +
+		    stub->target->offset);
+
+		/* ld (sav_a), a */
+		rc = obj_banksw_op_nn(section, 0x32, sav_a);
+		if (rc != EOK)
+			return rc;
+
+		/* ld (sav_hl), hl */
+		rc = obj_banksw_op_nn(section, 0x22, sav_hl);
+		if (rc != EOK)
+			return rc;
+
+		/* ld hl, <target> */
+		rc = obj_banksw_op_nn(section, 0x21, target);
+		if (rc != EOK)
+			return rc;
+
+		/* ld (call_op), hl */
+		rc = obj_banksw_op_nn(section, 0x22, call_op);
+		if (rc != EOK)
+			return rc;
+
+		/* ld a, <bank> */
+		rc = obj_section_append_u8(section, 0x3e);
+		if (rc != EOK)
+			return rc;
+
+		rc = obj_section_append_u8(section, (uint8_t)stub->bank);
+		if (rc != EOK)
+			return rc;
+
+		/* jp <routine> */
+		rc = obj_banksw_op_nn(section, 0xc3, routine);
+		if (rc != EOK)
+			return rc;
+
+		stub = obj_banksw_next(stub);
+	}
+
+	return EOK;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Bank switching trampolines
+ */
+
+#ifndef OBJECT_BANKSW_H
+#define OBJECT_BANKSW_H
+
+#include <types/object/banksw.h>
+#include <types/object/object.h>
+#include <types/object/symbol.h>
+
+extern int obj_banksw_create(obj_object_t *, obj_banksw_t **);
+extern void obj_banksw_destroy(obj_banksw_t *);
+extern int obj_banksw_get_stub(obj_banksw_t *, obj_symbol_t *, unsigned,
+    obj_banksw_stub_t **);
+extern int obj_banksw_finish(obj_banksw_t *);
+extern obj_banksw_stub_t *obj_banksw_first(obj_banksw_t *);
+extern obj_banksw_stub_t *obj_banksw_next(obj_banksw_stub_t *);
+
+#endif
@@ -28,7 +28,9 @@
 #include <merrno.h>
 #include <stdlib.h>
 #include <string.h>
+#include <object/banksw.h>
 #include <object/linker.h>
+#include <object/lscript.h>
 #include <object/object.h>
 #include <object/reloc.h>
 #include <object/section.h>
@@ -97,6 +99,38 @@ int obj_linker_add_src(obj_linker_t *linker, obj_object_t *src)
 	return EOK;
 }
 
+/** Add source object to linker, to be placed in a memory bank.
+ *
+ * Code and data of the source object will be placed in memory bank
+ * @a bank, which is paged in at address obj_bank_base. Calls to
+ * functions in the bank from outside the bank are routed through
+ * bank switching trampolines.
+ *
+ * @param linker Linker
+ * @param src Source object
+ * @param bank Memory bank number
+ * @return EOK on success or an error code
+ */
+int obj_linker_add_banked_src(obj_linker_t *linker, obj_object_t *src,
+    unsigned bank)
+{
+	obj_linker_src_t *source;
+
+	if (bank >= obj_bank_count)
+		return EINVAL;
+
+	source = calloc(1, sizeof(obj_linker_src_t));
+	if (source == NULL)
+		return ENOMEM;
+
+	source->linker = linker;
+	source->object = src;
+	source->banked = true;
+	source->bank = bank;
+	list_append(&source->lsources, &linker->sources);
+	return EOK;
+}
+
 /** Destroy linker source.
  *
  * @param src Linker source
@@ -118,6 +152,16 @@ int obj_linker_set_origin(obj_linker_t *linker, uint32_t origin)
 	return EOK;
 }
 
+/** Set linker script.
+ *
+ * @param linker Linker
+ * @param lscript Linker script (owned by caller) or @c NULL
+ */
+void obj_linker_set_script(obj_linker_t *linker, obj_lscript_t *lscript)
+{
+	linker->lscript = lscript;
+}
+
 /** Check for duplicate symbols.
  *
  * @param linker Linker
@@ -157,6 +201,336 @@ static int obj_linker_dup_symbol_check(obj_linker_t *linker,
 	return EOK;
 }
 
+/** Place sections copied from a source into a memory bank.
+ *
+ * @param first First section copied from the source or @c NULL
+ * @param bank Memory bank number
+ * @return EOK on success or an error code
+ */
+static int obj_linker_set_bank(obj_section_t *first, unsigned bank)
+{
+	obj_section_t *section;
+	int rc;
+
+	section = first;
+	while (section != NULL) {
+		rc = obj_section_set_bank(section, bank);
+		if (rc != EOK)
+			return rc;
+
+		section = obj_section_next(section);
+	}
+
+	return EOK;
+}
+
+/** Route cross-bank references through bank switching trampolines.
+ *
+ * References to a code symbol located in a memory bank from outside
+ * of that bank (either direct calls or function pointers) are redirected
+ * to a trampoline stub. Calling the stub pages in the bank and calls
+ * the function. Banked data is only accessible from its own bank,
+ * so any other cross-bank reference (to data, to a symbol of unknown
+ * kind or with a non-zero addend) is reported as an error.
+ *
+ * @param linker Linker
+ * @param dest Destination object
+ * @param banksw Bank switching trampolines
+ * @return EOK on success or an error code
+ */
+static int obj_linker_banked_refs(obj_linker_t *linker, obj_object_t *dest,
+    obj_banksw_t *banksw)
+{
+	obj_reloc_t *reloc;
+	obj_symbol_t *symbol;
+	obj_banksw_stub_t *stub;
+	unsigned sbank;
+	unsigned tbank;
+	bool sbanked;
+	int rc;
+
+	(void)linker;
+
+	reloc = obj_reloc_first(dest);
+	while (reloc != NULL) {
+		symbol = obj_symbol_find(dest, reloc->sym_name,
+		    reloc->section->modname);
+		if (symbol == NULL ||
+		    !obj_section_get_bank(symbol->section, &tbank)) {
+			/* Unresolved or target not banked */
+			reloc = obj_reloc_next(reloc);
+			continue;
+		}
+
+		sbanked = obj_section_get_bank(reloc->section, &sbank);
+		if (sbanked && sbank == tbank) {
+			/* Reference within the same bank */
+			reloc = obj_reloc_next(reloc);
+			continue;
+		}
+
+		if (symbol->kind != objk_code || reloc->rtype != objr_sa16 ||
+		    reloc->addend != 0) {
+			(void)fprintf(stderr, "%s: Link error: Symbol '%s' "
+			    "in bank %u is not accessible from %s.\n",
+			    reloc->section->modname, reloc->sym_name, tbank,
+			    sbanked ? "another bank" : "common memory");
+			return EINVAL;
+		}
+
+		rc = obj_banksw_get_stub(banksw, symbol, tbank, &stub);
+		if (rc != EOK)
+			return rc;
+
+		rc = obj_reloc_redirect(reloc, stub->symbol->name);
+		if (rc != EOK)
+			return rc;
+
+		reloc = obj_reloc_next(reloc);
+	}
+
+	return EOK;
+}
+
+/** Get index of memory region in linker script.
+ *
+ * @param region Memory region
+ * @return Index of region (starting from zero)
+ */
+static unsigned obj_linker_region_idx(obj_lscript_region_t *region)
+{
+	obj_lscript_region_t *r;
+	unsigned idx;
+
+	idx = 0;
+	r = obj_lscript_region_first(region->lscript);
+	while (r != region) {
+		r = obj_lscript_region_next(r);
+		++idx;
+	}
+
+	return idx;
+}
+
+/** Place section according to linker script rule.
+ *
+ * The section is moved to the destination region, aligned as requested
+ * and the region's next free address is advanced.
+ *
+ * @param rule Linker script rule
+ * @param section Section
+ * @param rnext Array of next free addresses in each region
+ * @return EOK on success or an error code
+ */
+static int obj_linker_place_section(obj_lscript_rule_t *rule,
+    obj_section_t *section, uint32_t *rnext)
+{
+	obj_lscript_region_t *region = rule->region;
+	uint32_t *next;
+	uint32_t address;
+	int rc;
+
+	next = &rnext[obj_linker_region_idx(region)];
+
+	address = (*next + rule->align - 1) & ~(rule->align - 1);
+	if (address + section->len > region->end + 1) {
+		(void)fprintf(stderr, "%s: Link error: Region '%s' "
+		    "overflow.\n", section->modname, region->name);
+		return EINVAL;
+	}
+
+	rc = obj_section_set_basename(section, region->name);
+	if (rc != EOK)
+		return rc;
+
+	section->base_addr = address;
+	*next = address + section->len;
+	return EOK;
+}
+
+/** Check that sections in common memory do not overlap.
+ *
+ * @param dest Destination object
+ * @return EOK on success, EINVAL if some sections overlap
+ */
+static int obj_linker_overlap_check(obj_object_t *dest)
+{
+	obj_section_t *s1;
+	obj_section_t *s2;
+	unsigned bank;
+
+	s1 = obj_section_first(dest);
+	while (s1 != NULL) {
+		if (obj_section_get_bank(s1, &bank) || s1->len == 0) {
+			s1 = obj_section_next(s1);
+			continue;
+		}
+
+		s2 = obj_section_next(s1);
+		while (s2 != NULL) {
+			if (!obj_section_get_bank(s2, &bank) &&
+			    s2->len != 0 &&
+			    s1->base_addr < s2->base_addr + s2->len &&
+			    s2->base_addr < s1->base_addr + s1->len) {
+				(void)fprintf(stderr, "Link error: Section "
+				    "%s (%s) overlaps with section %s (%s).\n",
+				    s1->name, s1->modname, s2->name,
+				    s2->modname);
+				return EINVAL;
+			}
+
+			s2 = obj_section_next(s2);
+		}
+
+		s1 = obj_section_next(s1);
+	}
+
+	return EOK;
+}
+
+/** Assign addresses to sections.
+ *
+ * Sections in each memory bank are placed consecutively starting
+ * at obj_bank_base. Sections matched by a linker script rule are
+ * placed consecutively in the rule's memory region. All other
+ * sections are placed consecutively starting at the origin address.
+ * If there are any banked sections, no memory region may extend into
+ * the paged memory window.
+ *
+ * @param linker Linker
+ * @param dest Destination object
+ * @param banked @c true iff there are any banked sections
+ * @return EOK on success or an error code
+ */
+static int obj_linker_assign_addrs(obj_linker_t *linker, obj_object_t *dest,
+    bool banked)
+{
+	obj_section_t *section;
+	obj_lscript_rule_t *rule;
+	obj_lscript_region_t *region;
+	uint32_t *rnext = NULL;
+	uint32_t address;
+	uint32_t bank_len[obj_bank_count];
+	unsigned bank;
+	unsigned nregions;
+	int rc;
+
+	for (bank = 0; bank < obj_bank_count; bank++)
+		bank_len[bank] = 0;
+
+	if (linker->lscript != NULL) {
+		nregions = 0;
+		region = obj_lscript_region_first(linker->lscript);
+		while (region != NULL) {
+			/* Paged memory is reserved for memory banks */
+			if (banked && region->end >= obj_bank_base) {
+				(void)fprintf(stderr, "Link error: Memory region "
+				    "'%s' overlaps with paged memory.\n",
+				    region->name);
+				return EINVAL;
+			}
+
+			++nregions;
+			region = obj_lscript_region_next(region);
+		}
+
+		rnext = calloc(nregions + 1, sizeof(uint32_t));
+		if (rnext == NULL)
+			return ENOMEM;
+
+		nregions = 0;
+		region = obj_lscript_region_first(linker->lscript);
+		while (region != NULL) {
+			rnext[nregions++] = region->start;
+			region = obj_lscript_region_next(region);
+		}
+	}
+
+	address = linker->org;
+	section = obj_section_first(dest);
+	while (section != NULL) {
+		rule = NULL;
+		if (linker->lscript != NULL)
+			rule = obj_lscript_match(linker->lscript, section);
+
+		if (obj_section_get_bank(section, &bank)) {
+			section->base_addr = obj_bank_base + bank_len[bank];
+			bank_len[bank] += section->len;
+			if (bank_len[bank] > obj_bank_size) {
+				(void)fprintf(stderr, "Link error: Bank %u "
+				    "overflow.\n", bank);
+				rc = EINVAL;
+				goto error;
+			}
+		} else if (rule != NULL) {
+			rc = obj_linker_place_section(rule, section, rnext);
+			if (rc != EOK)
+				goto error;
+		} else {
+			section->base_addr = address;
+			address += section->len;
+		}
+
+		section = obj_section_next(section);
+	}
+
+	if (banked && address > obj_bank_base &&
+	    (linker->flags & lf_no_range_error) == lf_none) {
+		(void)fprintf(stderr, "Link error: Common memory overlaps "
+		    "with paged memory.\n");
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (linker->lscript != NULL) {
+		rc = obj_linker_overlap_check(dest);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (rnext != NULL)
+		free(rnext);
+	return EOK;
+error:
+	if (rnext != NULL)
+		free(rnext);
+	return rc;
+}
+
+/** Get byte used to fill gaps in a section.
+ *
+ * @param linker Linker
+ * @param section Section
+ * @return Fill byte of the memory region containing the section
+ */
+static uint8_t obj_linker_fill_byte(obj_linker_t *linker,
+    obj_section_t *section)
+{
+	obj_lscript_region_t *region;
+	const char *tag;
+	size_t nlen;
+
+	if (linker->lscript == NULL)
+		return 0;
+
+	tag = strchr(section->name, '@');
+	if (tag != NULL)
+		nlen = (size_t)(tag - section->name);
+	else
+		nlen = strlen(section->name);
+
+	region = obj_lscript_region_first(linker->lscript);
+	while (region != NULL) {
+		if (strncmp(region->name, section->name, nlen) == 0 &&
+		    region->name[nlen] == '\0')
+			return region->fill;
+
+		region = obj_lscript_region_next(region);
+	}
+
+	return 0;
+}
+
 /** Perform linking.
  *
  * @param linker Linker
@@ -170,10 +544,13 @@ int obj_linker_link(obj_linker_t *linker, obj_object_t **rdest)
 	obj_section_t *section;
 	obj_section_t *src_sec;
 	obj_section_t *src_nsec;
+	obj_section_t *last;
 	obj_reloc_t *reloc;
 	obj_reloc_t *next;
-	uint32_t address;
+	obj_banksw_t *banksw = NULL;
+	bool banked = false;
 	unsigned modidx;
+	uint8_t fill;
 	int rc;
 
 	rc = obj_object_create(&dest);
@@ -184,10 +561,22 @@ int obj_linker_link(obj_linker_t *linker, obj_object_t **rdest)
 	src = obj_linker_src_first(linker);
 	modidx = 1;
 	while (src != NULL) {
+		last = obj_section_last(dest);
+
 		rc = obj_object_copy(src->object, modidx++, dest);
 		if (rc != EOK)
 			goto error;
 
+		if (src->banked) {
+			section = last != NULL ? obj_section_next(last) :
+			    obj_section_first(dest);
+			rc = obj_linker_set_bank(section, src->bank);
+			if (rc != EOK)
+				goto error;
+
+			banked = true;
+		}
+
 		src = obj_linker_src_next(src);
 	}
 
@@ -196,14 +585,27 @@ int obj_linker_link(obj_linker_t *linker, obj_object_t **rdest)
 	if (rc != EOK)
 		goto error;
 
+	if (banked) {
+		/* Create trampolines for cross-bank calls. */
+		rc = obj_banksw_create(dest, &banksw);
+		if (rc != EOK)
+			goto error;
+
+		rc = obj_linker_banked_refs(linker, dest, banksw);
+		if (rc != EOK)
+			goto error;
+	}
+
 	/* Assign addresses to sections. */
-	address = linker->org;
-	section = obj_section_first(dest);
-	while (section != NULL) {
-		section->base_addr = address;
-		address += section->len;
+	rc = obj_linker_assign_addrs(linker, dest, banked);
+	if (rc != EOK)
+		goto error;
 
-		section = obj_section_next(section);
+	if (banksw != NULL) {
+		/* Fill in final addresses. */
+		rc = obj_banksw_finish(banksw);
+		if (rc != EOK)
+			goto error;
 	}
 
 	/* Process relocations. */
@@ -227,6 +629,15 @@ int obj_linker_link(obj_linker_t *linker, obj_object_t **rdest)
 			src_nsec = obj_section_next(src_sec);
 
 			if (obj_section_basename_cmp(section, src_sec) == 0) {
+				/* Fill alignment gap */
+				fill = obj_linker_fill_byte(linker, section);
+				while (section->base_addr + section->len <
+				    src_sec->base_addr) {
+					rc = obj_section_append_u8(section, fill);
+					if (rc != EOK)
+						goto error;
+				}
+
 				rc = obj_section_merge(section, src_sec);
 				if (rc != EOK)
 					goto error;
@@ -242,9 +653,11 @@ int obj_linker_link(obj_linker_t *linker, obj_object_t **rdest)
 		section = obj_section_next(section);
 	}
 
+	obj_banksw_destroy(banksw);
 	*rdest = dest;
 	return EOK;
 error:
+	obj_banksw_destroy(banksw);
 	obj_object_destroy(dest);
 	return rc;
 }
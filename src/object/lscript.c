@@ -0,0 +1,638 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Linker script
+ *
+ * A linker script defines memory regions and rules assigning sections
+ * to these regions. Each line contains one statement, '#' starts
+ * a comment that extends to the end of the line.
+ *
+ *   region <name> <start> <end> [fill <byte>]
+ *   place <section-pattern> [from <module-pattern>] in <region>
+ *       [align <n>]
+ *
+ * Patterns can contain the wildcards '*' (any sequence of characters)
+ * and '?' (any single character). The section pattern is matched
+ * against the section name, the module pattern against the module
+ * (file) name. The first matching rule applies. Sections not matched
+ * by any rule are placed in common memory starting at the origin
+ * address.
+ */
+
+#include <adt/list.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <object/lscript.h>
+
+static void obj_lscript_region_destroy(obj_lscript_region_t *);
+static void obj_lscript_rule_destroy(obj_lscript_rule_t *);
+
+/** Create empty linker script.
+ *
+ * @param rlscript Place to store pointer to new linker script
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_lscript_create(obj_lscript_t **rlscript)
+{
+	obj_lscript_t *lscript;
+
+	lscript = calloc(1, sizeof(obj_lscript_t));
+	if (lscript == NULL)
+		return ENOMEM;
+
+	list_initialize(&lscript->regions);
+	list_initialize(&lscript->rules);
+	*rlscript = lscript;
+	return EOK;
+}
+
+/** Destroy linker script.
+ *
+ * @param lscript Linker script or @c NULL
+ */
+void obj_lscript_destroy(obj_lscript_t *lscript)
+{
+	obj_lscript_rule_t *rule;
+	obj_lscript_region_t *region;
+
+	if (lscript == NULL)
+		return;
+
+	rule = obj_lscript_rule_first(lscript);
+	while (rule != NULL) {
+		obj_lscript_rule_destroy(rule);
+		rule = obj_lscript_rule_first(lscript);
+	}
+
+	region = obj_lscript_region_first(lscript);
+	while (region != NULL) {
+		obj_lscript_region_destroy(region);
+		region = obj_lscript_region_first(lscript);
+	}
+
+	free(lscript);
+}
+
+/** Add memory region to linker script.
+ *
+ * @param lscript Linker script
+ * @param name Region name
+ * @param start Start address
+ * @param end End address (inclusive)
+ * @param fill Byte used to fill alignment gaps
+ * @param rregion Place to store pointer to new region or @c NULL
+ * @return EOK on success, EEXIST if region with the same name exists,
+ *         ENOMEM if out of memory
+ */
+int obj_lscript_add_region(obj_lscript_t *lscript, const char *name,
+    uint32_t start, uint32_t end, uint8_t fill,
+    obj_lscript_region_t **rregion)
+{
+	obj_lscript_region_t *region;
+
+	if (obj_lscript_region_find(lscript, name) != NULL)
+		return EEXIST;
+
+	region = calloc(1, sizeof(obj_lscript_region_t));
+	if (region == NULL)
+		return ENOMEM;
+
+	region->name = strdup(name);
+	if (region->name == NULL) {
+		free(region);
+		return ENOMEM;
+	}
+
+	region->lscript = lscript;
+	region->start = start;
+	region->end = end;
+	region->fill = fill;
+	list_append(&region->lregions, &lscript->regions);
+
+	if (rregion != NULL)
+		*rregion = region;
+	return EOK;
+}
+
+/** Destroy memory region.
+ *
+ * @param region Memory region
+ */
+static void obj_lscript_region_destroy(obj_lscript_region_t *region)
+{
+	list_remove(&region->lregions);
+	free(region->name);
+	free(region);
+}
+
+/** Add placement rule to linker script.
+ *
+ * @param lscript Linker script
+ * @param spattern Section name pattern
+ * @param mpattern Module name pattern
+ * @param region Destination region
+ * @param align Alignment (power of two)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_lscript_add_rule(obj_lscript_t *lscript, const char *spattern,
+    const char *mpattern, obj_lscript_region_t *region, uint32_t align)
+{
+	obj_lscript_rule_t *rule;
+
+	rule = calloc(1, sizeof(obj_lscript_rule_t));
+	if (rule == NULL)
+		return ENOMEM;
+
+	rule->spattern = strdup(spattern);
+	if (rule->spattern == NULL)
+		goto error;
+
+	rule->mpattern = strdup(mpattern);
+	if (rule->mpattern == NULL)
+		goto error;
+
+	rule->lscript = lscript;
+	rule->region = region;
+	rule->align = align;
+	list_append(&rule->lrules, &lscript->rules);
+	return EOK;
+error:
+	if (rule->spattern != NULL)
+		free(rule->spattern);
+	free(rule);
+	return ENOMEM;
+}
+
+/** Destroy placement rule.
+ *
+ * @param rule Placement rule
+ */
+static void obj_lscript_rule_destroy(obj_lscript_rule_t *rule)
+{
+	list_remove(&rule->lrules);
+	free(rule->spattern);
+	free(rule->mpattern);
+	free(rule);
+}
+
+/** Match string against wildcard pattern.
+ *
+ * @param pattern Pattern
+ * @param str String
+ * @param len Length of @a str
+ * @return @c true iff @a str matches @a pattern
+ */
+static bool obj_lscript_glob(const char *pattern, const char *str,
+    size_t len)
+{
+	while (*pattern != '\0') {
+		if (*pattern == '*') {
+			/* Try all possible lengths of the matched sequence */
+			while (true) {
+				if (obj_lscript_glob(pattern + 1, str, len))
+					return true;
+				if (len == 0)
+					return false;
+				++str;
+				--len;
+			}
+		}
+
+		if (len == 0)
+			return false;
+		if (*pattern != '?' && *pattern != *str)
+			return false;
+
+		++pattern;
+		++str;
+		--len;
+	}
+
+	return len == 0;
+}
+
+/** Find placement rule matching a section.
+ *
+ * The section pattern is matched against the section name without
+ * the module index tag.
+ *
+ * @param lscript Linker script
+ * @param section Section
+ * @return First matching rule or @c NULL if there is none
+ */
+obj_lscript_rule_t *obj_lscript_match(obj_lscript_t *lscript,
+    obj_section_t *section)
+{
+	obj_lscript_rule_t *rule;
+	const char *tag;
+	size_t nlen;
+
+	tag = strchr(section->name, '@');
+	if (tag != NULL)
+		nlen = (size_t)(tag - section->name);
+	else
+		nlen = strlen(section->name);
+
+	rule = obj_lscript_rule_first(lscript);
+	while (rule != NULL) {
+		if (obj_lscript_glob(rule->spattern, section->name, nlen) &&
+		    obj_lscript_glob(rule->mpattern, section->modname,
+		    strlen(section->modname)))
+			return rule;
+
+		rule = obj_lscript_rule_next(rule);
+	}
+
+	return NULL;
+}
+
+/** Print linker script error location.
+ *
+ * @param parser Linker script parser
+ */
+static void obj_lscript_print_loc(obj_lscript_parser_t *parser)
+{
+	(void)fprintf(stderr, "%s:%u: Error: ", parser->fname, parser->line);
+}
+
+/** Read next line from linker script and split it into words.
+ *
+ * @param parser Linker script parser
+ * @return EOK on success, ENOENT at end of file, EINVAL if line
+ *         is too long or has too many words
+ */
+static int obj_lscript_read_line(obj_lscript_parser_t *parser)
+{
+	size_t len;
+	char *p;
+	int c;
+
+	c = fgetc(parser->f);
+	if (c == EOF)
+		return ENOENT;
+
+	++parser->line;
+
+	len = 0;
+	while (c != EOF && c != '\n') {
+		if (len + 1 >= obj_lscript_line_max) {
+			obj_lscript_print_loc(parser);
+			(void)fprintf(stderr, "Line is too long.\n");
+			return EINVAL;
+		}
+
+		parser->buf[len++] = (char)c;
+		c = fgetc(parser->f);
+	}
+
+	parser->buf[len] = '\0';
+
+	/* Strip comment */
+	p = strchr(parser->buf, '#');
+	if (p != NULL)
+		*p = '\0';
+
+	/* Split into words */
+	parser->nwords = 0;
+	p = parser->buf;
+	while (true) {
+		while (*p == ' ' || *p == '\t' || *p == '\r')
+			*p++ = '\0';
+		if (*p == '\0')
+			break;
+
+		if (parser->nwords >= obj_lscript_words_max) {
+			obj_lscript_print_loc(parser);
+			(void)fprintf(stderr, "Too many words.\n");
+			return EINVAL;
+		}
+
+		parser->words[parser->nwords++] = p;
+		while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r')
+			++p;
+	}
+
+	return EOK;
+}
+
+/** Parse number from linker script.
+ *
+ * @param parser Linker script parser
+ * @param str String containing the number
+ * @param max Maximum allowed value
+ * @param rval Place to store value
+ * @return EOK on success, EINVAL if number is not valid
+ */
+static int obj_lscript_parse_num(obj_lscript_parser_t *parser,
+    const char *str, uint32_t max, uint32_t *rval)
+{
+	unsigned long val;
+	char *endptr;
+
+	val = strtoul(str, &endptr, 0);
+	if (*str < '0' || *str > '9' || *endptr != '\0' || val > max) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Invalid number '%s'.\n", str);
+		return EINVAL;
+	}
+
+	*rval = (uint32_t)val;
+	return EOK;
+}
+
+/** Parse region statement.
+ *
+ * @param parser Linker script parser
+ * @param lscript Linker script
+ * @return EOK on success or an error code
+ */
+static int obj_lscript_parse_region(obj_lscript_parser_t *parser,
+    obj_lscript_t *lscript)
+{
+	uint32_t start;
+	uint32_t end;
+	uint32_t fill = 0;
+	int rc;
+
+	if (parser->nwords != 4 && (parser->nwords != 6 ||
+	    strcmp(parser->words[4], "fill") != 0)) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Expected 'region <name> <start> <end> "
+		    "[fill <byte>]'.\n");
+		return EINVAL;
+	}
+
+	if (strcmp(parser->words[1], "common") == 0 ||
+	    strncmp(parser->words[1], "bank", 4) == 0 ||
+	    strchr(parser->words[1], '@') != NULL) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Reserved region name '%s'.\n",
+		    parser->words[1]);
+		return EINVAL;
+	}
+
+	rc = obj_lscript_parse_num(parser, parser->words[2], 0xffffL, &start);
+	if (rc != EOK)
+		return rc;
+
+	rc = obj_lscript_parse_num(parser, parser->words[3], 0xffffL, &end);
+	if (rc != EOK)
+		return rc;
+
+	if (end < start) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Region end is below region start.\n");
+		return EINVAL;
+	}
+
+	if (parser->nwords == 6) {
+		rc = obj_lscript_parse_num(parser, parser->words[5], 0xff,
+		    &fill);
+		if (rc != EOK)
+			return rc;
+	}
+
+	rc = obj_lscript_add_region(lscript, parser->words[1], start, end,
+	    (uint8_t)fill, NULL);
+	if (rc == EEXIST) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Duplicate region '%s'.\n",
+		    parser->words[1]);
+		return EINVAL;
+	}
+
+	return rc;
+}
+
+/** Parse place statement.
+ *
+ * @param parser Linker script parser
+ * @param lscript Linker script
+ * @return EOK on success or an error code
+ */
+static int obj_lscript_parse_place(obj_lscript_parser_t *parser,
+    obj_lscript_t *lscript)
+{
+	obj_lscript_region_t *region;
+	const char *mpattern = "*";
+	uint32_t align = 1;
+	unsigned i;
+	int rc;
+
+	i = 2;
+	if (i + 1 < parser->nwords && strcmp(parser->words[i], "from") == 0) {
+		mpattern = parser->words[i + 1];
+		i += 2;
+	}
+
+	if (i + 1 >= parser->nwords || strcmp(parser->words[i], "in") != 0)
+		goto syntax;
+
+	region = obj_lscript_region_find(lscript, parser->words[i + 1]);
+	if (region == NULL) {
+		obj_lscript_print_loc(parser);
+		(void)fprintf(stderr, "Undefined region '%s'.\n",
+		    parser->words[i + 1]);
+		return EINVAL;
+	}
+
+	i += 2;
+	if (i + 1 < parser->nwords && strcmp(parser->words[i], "align") == 0) {
+		rc = obj_lscript_parse_num(parser, parser->words[i + 1],
+		    0x8000L, &align);
+		if (rc != EOK)
+			return rc;
+
+		if (align == 0 || (align & (align - 1)) != 0) {
+			obj_lscript_print_loc(parser);
+			(void)fprintf(stderr, "Alignment must be a power "
+			    "of two.\n");
+			return EINVAL;
+		}
+
+		i += 2;
+	}
+
+	if (i != parser->nwords)
+		goto syntax;
+
+	return obj_lscript_add_rule(lscript, parser->words[1], mpattern,
+	    region, align);
+syntax:
+	obj_lscript_print_loc(parser);
+	(void)fprintf(stderr, "Expected 'place <section-pattern> "
+	    "[from <module-pattern>] in <region> [align <n>]'.\n");
+	return EINVAL;
+}
+
+/** Load linker script from file.
+ *
+ * @param f Input file
+ * @param fname File name (for error messages)
+ * @param rlscript Place to store pointer to new linker script
+ * @return EOK on success or an error code
+ */
+int obj_lscript_load(FILE *f, const char *fname, obj_lscript_t **rlscript)
+{
+	obj_lscript_t *lscript = NULL;
+	obj_lscript_parser_t *parser;
+	int rc;
+
+	parser = calloc(1, sizeof(obj_lscript_parser_t));
+	if (parser == NULL)
+		return ENOMEM;
+
+	parser->f = f;
+	parser->fname = fname;
+
+	rc = obj_lscript_create(&lscript);
+	if (rc != EOK)
+		goto error;
+
+	while (true) {
+		rc = obj_lscript_read_line(parser);
+		if (rc == ENOENT)
+			break;
+		if (rc != EOK)
+			goto error;
+
+		if (parser->nwords == 0)
+			continue;
+
+		if (strcmp(parser->words[0], "region") == 0) {
+			rc = obj_lscript_parse_region(parser, lscript);
+		} else if (strcmp(parser->words[0], "place") == 0) {
+			rc = obj_lscript_parse_place(parser, lscript);
+		} else {
+			obj_lscript_print_loc(parser);
+			(void)fprintf(stderr, "Unknown statement '%s'.\n",
+			    parser->words[0]);
+			rc = EINVAL;
+		}
+
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (ferror(f) != 0) {
+		(void)fprintf(stderr, "%s: Error reading file.\n", fname);
+		rc = EIO;
+		goto error;
+	}
+
+	free(parser);
+	*rlscript = lscript;
+	return EOK;
+error:
+	obj_lscript_destroy(lscript);
+	free(parser);
+	return rc;
+}
+
+/** Get first memory region in linker script.
+ *
+ * @param lscript Linker script
+ * @return First region or @c NULL if there are none.
+ */
+obj_lscript_region_t *obj_lscript_region_first(obj_lscript_t *lscript)
+{
+	link_t *link;
+
+	link = list_first(&lscript->regions);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_lscript_region_t, lregions);
+}
+
+/** Get next memory region in linker script.
+ *
+ * @param cur Current region
+ * @return Next region or @c NULL if @a cur is the last region.
+ */
+obj_lscript_region_t *obj_lscript_region_next(obj_lscript_region_t *cur)
+{
+	link_t *link;
+
+	link = list_next(&cur->lregions, &cur->lscript->regions);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_lscript_region_t, lregions);
+}
+
+/** Find memory region by name.
+ *
+ * @param lscript Linker script
+ * @param name Region name
+ * @return Region or @c NULL if not found.
+ */
+obj_lscript_region_t *obj_lscript_region_find(obj_lscript_t *lscript,
+    const char *name)
+{
+	obj_lscript_region_t *region;
+
+	region = obj_lscript_region_first(lscript);
+	while (region != NULL) {
+		if (strcmp(region->name, name) == 0)
+			return region;
+
+		region = obj_lscript_region_next(region);
+	}
+
+	return NULL;
+}
+
+/** Get first placement rule in linker script.
+ *
+ * @param lscript Linker script
+ * @return First rule or @c NULL if there are none.
+ */
+obj_lscript_rule_t *obj_lscript_rule_first(obj_lscript_t *lscript)
+{
+	link_t *link;
+
+	link = list_first(&lscript->rules);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_lscript_rule_t, lrules);
+}
+
+/** Get next placement rule in linker script.
+ *
+ * @param cur Current rule
+ * @return Next rule or @c NULL if @a cur is the last rule.
+ */
+obj_lscript_rule_t *obj_lscript_rule_next(obj_lscript_rule_t *cur)
+{
+	link_t *link;
+
+	link = list_next(&cur->lrules, &cur->lscript->rules);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_lscript_rule_t, lrules);
+}
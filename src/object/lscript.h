@@ -0,0 +1,51 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Linker script
+ */
+
+#ifndef OBJECT_LSCRIPT_H
+#define OBJECT_LSCRIPT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <types/object/lscript.h>
+#include <types/object/section.h>
+
+extern int obj_lscript_create(obj_lscript_t **);
+extern void obj_lscript_destroy(obj_lscript_t *);
+extern int obj_lscript_load(FILE *, const char *, obj_lscript_t **);
+extern int obj_lscript_add_region(obj_lscript_t *, const char *, uint32_t,
+    uint32_t, uint8_t, obj_lscript_region_t **);
+extern int obj_lscript_add_rule(obj_lscript_t *, const char *, const char *,
+    obj_lscript_region_t *, uint32_t);
+extern obj_lscript_region_t *obj_lscript_region_first(obj_lscript_t *);
+extern obj_lscript_region_t *obj_lscript_region_next(obj_lscript_region_t *);
+extern obj_lscript_region_t *obj_lscript_region_find(obj_lscript_t *,
+    const char *);
+extern obj_lscript_rule_t *obj_lscript_rule_first(obj_lscript_t *);
+extern obj_lscript_rule_t *obj_lscript_rule_next(obj_lscript_rule_t *);
+extern obj_lscript_rule_t *obj_lscript_match(obj_lscript_t *,
+    obj_section_t *);
+
+#endif
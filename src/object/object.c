@@ -267,6 +267,13 @@ int obj_object_sort_symbols(obj_object_t *object)
 }
 
 /** Save object contents into a raw binary file.
+ *
+ * Only sections located in common (unpaged) memory are saved.
+ * Use obj_object_save_bank_bin() to save contents of memory banks.
+ *
+ * The file contains a memory image starting at the lowest address
+ * of any saved section (see obj_object_get_bin_base()). Gaps between
+ * sections are filled with zeroes.
  *
  * @param object Object
  * @param outf Output file
@@ -275,14 +282,118 @@ int obj_object_sort_symbols(obj_object_t *object)
 int obj_object_save_bin(obj_object_t *object, FILE *outf)
 {
 	obj_section_t *section;
+	obj_section_t *nsec;
+	uint32_t addr;
+	unsigned bank;
 	int rc;
 
-	section = obj_section_first(object);
-	while (section != NULL) {
-		rc = obj_section_save_bin(section, outf);
+	addr = obj_object_get_bin_base(object);
+
+	while (true) {
+		/* Find section with lowest address not yet saved */
+		nsec = NULL;
+		section = obj_section_first(object);
+		while (section != NULL) {
+			if (!obj_section_get_bank(section, &bank) &&
+			    section->len > 0 && section->base_addr >= addr &&
+			    (nsec == NULL ||
+			    section->base_addr < nsec->base_addr))
+				nsec = section;
+
+			section = obj_section_next(section);
+		}
+
+		if (nsec == NULL)
+			break;
+
+		while (addr < nsec->base_addr) {
+			if (fputc(0, outf) == EOF)
+				return EIO;
+			++addr;
+		}
+
+		rc = obj_section_save_bin(nsec, outf);
 		if (rc != EOK)
 			return rc;
 
+		addr = nsec->base_addr + nsec->len;
+	}
+
+	return EOK;
+}
+
+/** Get address where the raw binary image of object starts.
+ *
+ * @param object Object
+ * @return Lowest address of any non-empty section in common memory
+ *         or 0 if there are none
+ */
+uint32_t obj_object_get_bin_base(obj_object_t *object)
+{
+	obj_section_t *section;
+	uint32_t base = 0;
+	bool have_base = false;
+	unsigned bank;
+
+	section = obj_section_first(object);
+	while (section != NULL) {
+		if (!obj_section_get_bank(section, &bank) &&
+		    section->len > 0 &&
+		    (!have_base || section->base_addr < base)) {
+			base = section->base_addr;
+			have_base = true;
+		}
+
+		section = obj_section_next(section);
+	}
+
+	return base;
+}
+
+/** Determine if object has any sections placed in a memory bank.
+ *
+ * @param object Object
+ * @param bank Bank number
+ * @return @c true iff some section is placed in bank @a bank
+ */
+bool obj_object_has_bank(obj_object_t *object, unsigned bank)
+{
+	obj_section_t *section;
+	unsigned sbank;
+
+	section = obj_section_first(object);
+	while (section != NULL) {
+		if (obj_section_get_bank(section, &sbank) && sbank == bank)
+			return true;
+
+		section = obj_section_next(section);
+	}
+
+	return false;
+}
+
+/** Save contents of a memory bank into a raw binary file.
+ *
+ * @param object Object
+ * @param bank Bank number
+ * @param outf Output file
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_object_save_bank_bin(obj_object_t *object, unsigned bank,
+    FILE *outf)
+{
+	obj_section_t *section;
+	unsigned sbank;
+	int rc;
+
+	section = obj_section_first(object);
+	while (section != NULL) {
+		if (obj_section_get_bank(section, &sbank) && sbank == bank) {
+			rc = obj_section_save_bin(section, outf);
+			if (rc != EOK)
+				return rc;
+		}
+
 		section = obj_section_next(section);
 	}
 
@@ -290,6 +401,9 @@ int obj_object_save_bin(obj_object_t *object, FILE *outf)
 }
 
 /** Save object contents into a z80asm compatible map file file.
+ *
+ * Symbols in common memory are listed first, followed by symbols
+ * in each memory bank, in order of increasing bank number.
  *
  * @param object Object
  * @param outf Output file
@@ -298,17 +412,37 @@ int obj_object_save_bin(obj_object_t *object, FILE *outf)
 int obj_object_save_map(obj_object_t *object, FILE *outf)
 {
 	obj_symbol_t *symbol;
+	unsigned bank;
+	unsigned sbank;
 	int rc;
 
+	/* Symbols in common memory */
 	symbol = obj_symbol_first(object);
 	while (symbol != NULL) {
-		rc = obj_symbol_save_map(symbol, outf);
-		if (rc != EOK)
-			return rc;
+		if (!obj_section_get_bank(symbol->section, &sbank)) {
+			rc = obj_symbol_save_map(symbol, outf);
+			if (rc != EOK)
+				return rc;
+		}
 
 		symbol = obj_symbol_next(symbol);
 	}
 
+	/* Symbols in each bank */
+	for (bank = 0; bank < obj_bank_count; bank++) {
+		symbol = obj_symbol_first(object);
+		while (symbol != NULL) {
+			if (obj_section_get_bank(symbol->section, &sbank) &&
+			    sbank == bank) {
+				rc = obj_symbol_save_map(symbol, outf);
+				if (rc != EOK)
+					return rc;
+			}
+
+			symbol = obj_symbol_next(symbol);
+		}
+	}
+
 	return EOK;
 }
 
@@ -349,8 +483,9 @@ int obj_object_load_obj(FILE *inf, const char *modname, obj_object_t **robject)
 		goto error;
 	}
 
+	/* Version 1.0 lacks symbol kinds, which are then read as unknown */
 	if (uint16_t_le2host(hdr.major) != obj_file_major ||
-	    uint16_t_le2host(hdr.minor) != obj_file_minor) {
+	    uint16_t_le2host(hdr.minor) > obj_file_minor) {
 		(void)fprintf(stderr, "Invalid object file version %" PRIu16
 		    ".%" PRIu16 ".\n", uint16_t_le2host(hdr.major),
 		    uint16_t_le2host(hdr.minor));
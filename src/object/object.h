@@ -27,6 +27,7 @@
 #ifndef OBJECT_OBJECT_H
 #define OBJECT_OBJECT_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <types/object/object.h>
@@ -36,6 +37,9 @@ extern void obj_object_destroy(obj_object_t *);
 extern int obj_object_dump(obj_object_t *, FILE *);
 extern int obj_object_load_obj(FILE *, const char *, obj_object_t **);
 extern int obj_object_save_bin(obj_object_t *, FILE *);
+extern uint32_t obj_object_get_bin_base(obj_object_t *);
+extern bool obj_object_has_bank(obj_object_t *, unsigned);
+extern int obj_object_save_bank_bin(obj_object_t *, unsigned, FILE *);
 extern int obj_object_save_map(obj_object_t *, FILE *);
 extern int obj_object_save_obj(obj_object_t *, FILE *);
 extern int obj_object_copy(obj_object_t *, unsigned, obj_object_t *);
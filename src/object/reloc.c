@@ -298,6 +298,25 @@ int obj_reloc_copy(obj_reloc_t *reloc, unsigned modidx, obj_object_t *dest)
 	    reloc->sym_name, reloc->addend);
 }
 
+/** Redirect relocation to a different symbol.
+ *
+ * @param reloc Relocation
+ * @param sym_name New referenced symbol name
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_reloc_redirect(obj_reloc_t *reloc, const char *sym_name)
+{
+	char *dname;
+
+	dname = strdup(sym_name);
+	if (dname == NULL)
+		return ENOMEM;
+
+	free(reloc->sym_name);
+	reloc->sym_name = dname;
+	return EOK;
+}
+
 /** Get first relocation in object.
  *
  * @param object Object
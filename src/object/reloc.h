@@ -40,6 +40,7 @@ extern int obj_reloc_dump(obj_reloc_t *, FILE *);
 extern int obj_reloc_load_obj(obj_object_t *, FILE *);
 extern int obj_reloc_save_obj(obj_reloc_t *, FILE *);
 extern int obj_reloc_copy(obj_reloc_t *, unsigned, obj_object_t *);
+extern int obj_reloc_redirect(obj_reloc_t *, const char *);
 extern obj_reloc_t *obj_reloc_first(obj_object_t *);
 extern obj_reloc_t *obj_reloc_next(obj_reloc_t *);
 extern obj_reloc_t *obj_reloc_find(obj_object_t *, obj_section_t *,
@@ -477,6 +477,91 @@ int obj_section_remove_tag(obj_section_t *section)
 	return EOK;
 }
 
+/** Determine whether section is placed in a memory bank.
+ *
+ * Sections named 'bank<n>' (optionally with a module index tag) are
+ * placed in memory bank <n>. All other sections are placed in
+ * the common (unpaged) memory.
+ *
+ * @param section Section
+ * @param rbank Place to store bank number
+ * @return @c true if section is banked, @c false otherwise
+ */
+bool obj_section_get_bank(obj_section_t *section, unsigned *rbank)
+{
+	const char *p;
+	unsigned bank;
+
+	if (strncmp(section->name, "bank", 4) != 0)
+		return false;
+
+	p = section->name + 4;
+	if (*p < '0' || *p > '9')
+		return false;
+
+	bank = 0;
+	while (*p >= '0' && *p <= '9') {
+		bank = bank * 10 + (unsigned)(*p - '0');
+		if (bank >= obj_bank_count)
+			return false;
+		++p;
+	}
+
+	if (*p != '\0' && *p != '@')
+		return false;
+
+	*rbank = bank;
+	return true;
+}
+
+/** Change section base name.
+ *
+ * The section is renamed to @a basename, keeping the module index tag,
+ * if any.
+ *
+ * @param section Section
+ * @param basename New base name
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int obj_section_set_basename(obj_section_t *section, const char *basename)
+{
+	char *dname = NULL;
+	const char *tag;
+	int rv;
+
+	tag = strchr(section->name, '@');
+	if (tag == NULL)
+		tag = "";
+
+	rv = asprintf(&dname, "%s%s", basename, tag);
+	if (rv < 0)
+		return ENOMEM;
+
+	free(section->name);
+	section->name = dname;
+	return EOK;
+}
+
+/** Move section to a memory bank.
+ *
+ * The section is renamed to 'bank<n>', keeping the module index tag,
+ * if any.
+ *
+ * @param section Section
+ * @param bank Bank number
+ * @return EOK on success or an error code
+ */
+int obj_section_set_bank(obj_section_t *section, unsigned bank)
+{
+	char bname[sizeof("bank") + 3];
+
+	if (bank >= obj_bank_count)
+		return EINVAL;
+
+	(void)snprintf(bname, sizeof(bname), "bank%u", bank);
+	return obj_section_set_basename(section, bname);
+}
+
 /** Get first section in object.
  *
  * @param object Object
@@ -509,6 +594,22 @@ obj_section_t *obj_section_next(obj_section_t *cur)
 	return list_get_instance(link, obj_section_t, lsections);
 }
 
+/** Get last section in object.
+ *
+ * @param object Object
+ * @return Last section or @c NULL if there are none.
+ */
+obj_section_t *obj_section_last(obj_object_t *object)
+{
+	link_t *link;
+
+	link = list_last(&object->sections);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, obj_section_t, lsections);
+}
+
 /** Find section in object by index.
  *
  * @param object Object
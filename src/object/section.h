@@ -27,6 +27,7 @@
 #ifndef OBJECT_SECTION_H
 #define OBJECT_SECTION_H
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <types/object/object.h>
@@ -46,8 +47,12 @@ extern int obj_section_remove_tag(obj_section_t *);
 extern int obj_section_basename_cmp(obj_section_t *, obj_section_t *);
 extern int obj_section_tagged_name(obj_section_t *, unsigned, char **);
 extern uint32_t obj_section_get_idx(obj_section_t *);
+extern bool obj_section_get_bank(obj_section_t *, unsigned *);
+extern int obj_section_set_basename(obj_section_t *, const char *);
+extern int obj_section_set_bank(obj_section_t *, unsigned);
 extern obj_section_t *obj_section_first(obj_object_t *);
 extern obj_section_t *obj_section_next(obj_section_t *);
+extern obj_section_t *obj_section_last(obj_object_t *);
 extern obj_section_t *obj_section_by_idx(obj_object_t *, uint32_t);
 extern obj_section_t *obj_section_by_name(obj_object_t *, const char *);
 extern int obj_section_append_u8(obj_section_t *, uint8_t);
@@ -41,14 +41,16 @@
  * @param name Symbol name
  * @param section Section containing symbol
  * @param binding Symbol binding
+ * @param kind Symbol kind
  * @param offset Symbol start offset within section
  * @param size Symbol size
  * @param rsymbol Place to store pointer to new binary object symbol
  * @return EOK on success, ENOMEM if out of memory
  */
 int obj_symbol_create(obj_object_t *object, const char *name,
-    obj_section_t *section, obj_symbol_binding_t binding, uint32_t offset,
-    uint32_t size, obj_symbol_t **rsymbol)
+    obj_section_t *section, obj_symbol_binding_t binding,
+    obj_symbol_kind_t kind, uint32_t offset, uint32_t size,
+    obj_symbol_t **rsymbol)
 {
 	obj_symbol_t *symbol;
 
@@ -65,6 +67,7 @@ int obj_symbol_create(obj_object_t *object, const char *name,
 
 	symbol->section = section;
 	symbol->binding = binding;
+	symbol->kind = kind;
 	symbol->offset = offset;
 	symbol->size = size;
 
@@ -111,6 +114,30 @@ static const char *obj_symbol_binding_str(obj_symbol_binding_t binding)
 	return sbinding;
 }
 
+/** Return symbol kind as string.
+ *
+ * @param kind Symbol kind
+ * @return Symbol kind as string
+ */
+static const char *obj_symbol_kind_str(obj_symbol_kind_t kind)
+{
+	const char *skind;
+
+	switch (kind) {
+	case objk_code:
+		skind = "code";
+		break;
+	case objk_data:
+		skind = "data";
+		break;
+	default:
+		skind = "unknown";
+		break;
+	}
+
+	return skind;
+}
+
 /** Dump binary object symbol.
  *
  * @param symbol Symbol
@@ -121,13 +148,15 @@ int obj_symbol_dump(obj_symbol_t *symbol, FILE *outf)
 {
 	int rc;
 	const char *sbinding;
+	const char *skind;
 
 	sbinding = obj_symbol_binding_str(symbol->binding);
+	skind = obj_symbol_kind_str(symbol->kind);
 
 	rc = fprintf(outf, "  Symbol: %s section:%s offset:0x%x "
-	    "length:%u binding:%s\n",
+	    "length:%u binding:%s kind:%s\n",
 	    symbol->name, symbol->section->name, symbol->offset,
-	    symbol->size, sbinding);
+	    symbol->size, sbinding, skind);
 	if (rc < 0)
 		return EIO;
 
@@ -145,17 +174,27 @@ int obj_symbol_save_map(obj_symbol_t *symbol, FILE *outf)
 	int rc;
 	const char *sbinding;
 	uint32_t sym_addr;
+	unsigned bank;
 
 	sbinding = obj_symbol_binding_str(symbol->binding);
 	sym_addr = symbol->section->base_addr + symbol->offset;
 
 	rc = fprintf(outf, "%s = $%04" PRIx32 " ;  Symbol: %s section:%s "
-	    "offset:0x%x length:%u binding:%s\n", symbol->name, sym_addr,
+	    "offset:0x%x length:%u binding:%s", symbol->name, sym_addr,
 	    symbol->name, symbol->section->name, symbol->offset,
 	    symbol->size, sbinding);
 	if (rc < 0)
 		return EIO;
 
+	if (obj_section_get_bank(symbol->section, &bank)) {
+		rc = fprintf(outf, " bank:%u", bank);
+		if (rc < 0)
+			return EIO;
+	}
+
+	if (fputc('\n', outf) < 0)
+		return EIO;
+
 	return EOK;
 }
 
@@ -173,6 +212,7 @@ int obj_symbol_load_obj(obj_object_t *object, FILE *inf, obj_symbol_t **rsymbol)
 	uint32_t nsize;
 	uint32_t section_idx;
 	obj_symbol_binding_t binding;
+	obj_symbol_kind_t kind;
 	uint32_t offset;
 	uint32_t size;
 	obj_section_t *section;
@@ -190,6 +230,7 @@ int obj_symbol_load_obj(obj_object_t *object, FILE *inf, obj_symbol_t **rsymbol)
 	nsize = uint32_t_le2host(sym.name_len);
 	section_idx = uint32_t_le2host(sym.section_idx);
 	binding = (obj_symbol_binding_t)sym.binding;
+	kind = (obj_symbol_kind_t)sym.kind;
 	offset = uint32_t_le2host(sym.offset);
 	size = uint32_t_le2host(sym.size);
 
@@ -214,8 +255,8 @@ int obj_symbol_load_obj(obj_object_t *object, FILE *inf, obj_symbol_t **rsymbol)
 		return EIO;
 	}
 
-	rc = obj_symbol_create(object, name, section, binding, offset, size,
-	    rsymbol);
+	rc = obj_symbol_create(object, name, section, binding, kind, offset,
+	    size, rsymbol);
 	if (rc != EOK)
 		goto error;
 
@@ -260,6 +301,7 @@ int obj_symbol_save_obj(obj_symbol_t *symbol, FILE *outf)
 	sym.section_idx =
 	    host2uint32_t_le(obj_section_get_idx(symbol->section));
 	sym.binding = (uint8_t)symbol->binding;
+	sym.kind = (uint8_t)symbol->kind;
 	memset(&sym.pad0, 0, sizeof(sym.pad0));
 	sym.offset = host2uint32_t_le(symbol->offset);
 	sym.size = host2uint32_t_le(symbol->size);
@@ -316,7 +358,7 @@ int obj_symbol_copy(obj_symbol_t *symbol, unsigned modidx, obj_object_t *dest)
 	free(sname);
 
 	return obj_symbol_create(dest, symbol->name, dsection, symbol->binding,
-	    symbol->offset, symbol->size, &dsymbol);
+	    symbol->kind, symbol->offset, symbol->size, &dsymbol);
 }
 
 /** Get first symbol in object.
@@ -33,7 +33,8 @@
 #include <types/object/symbol.h>
 
 extern int obj_symbol_create(obj_object_t *, const char *, obj_section_t *,
-    obj_symbol_binding_t, uint32_t, uint32_t, obj_symbol_t **);
+    obj_symbol_binding_t, obj_symbol_kind_t, uint32_t, uint32_t,
+    obj_symbol_t **);
 extern void obj_symbol_destroy(obj_symbol_t *);
 extern int obj_symbol_dump(obj_symbol_t *, FILE *);
 extern int obj_symbol_load_obj(obj_object_t *, FILE *, obj_symbol_t **);
@@ -24,11 +24,14 @@
  * Parser
  */
 
+#include <adt/hmap.h>
+#include <arena.h>
 #include <assert.h>
 #include <ast.h>
 #include <parser.h>
 #include <lexer.h>
 #include <merrno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -112,6 +115,8 @@ static int parser_create_silent_sub(parser_t *parent, parser_t **rparser)
 	(*rparser)->cb = parent->cb;
 	(*rparser)->cb_arg = parent->cb_arg;
 	(*rparser)->silent = true;
+	(*rparser)->memo = parent->memo;
+	(*rparser)->arena = parent->arena;
 	return EOK;
 }
 
@@ -136,6 +141,8 @@ static int parser_create_indent_sub(parser_t *parent, parser_t **rparser)
 	(*rparser)->cb = parent->cb;
 	(*rparser)->cb_arg = parent->cb_arg;
 	(*rparser)->silent = parent->silent;
+	(*rparser)->memo = parent->memo;
+	(*rparser)->arena = parent->arena;
 	return EOK;
 }
 
@@ -160,6 +167,8 @@ static int parser_create_secindent_sub(parser_t *parent, parser_t **rparser)
 	(*rparser)->cb = parent->cb;
 	(*rparser)->cb_arg = parent->cb_arg;
 	(*rparser)->silent = parent->silent;
+	(*rparser)->memo = parent->memo;
+	(*rparser)->arena = parent->arena;
 	return EOK;
 }
 
@@ -185,6 +194,9 @@ static int parser_create_invindent_sub(parser_t *parent, parser_t **rparser)
 
 	(*rparser)->cb = parent->cb;
 	(*rparser)->cb_arg = parent->cb_arg;
+	(*rparser)->silent = parent->silent;
+	(*rparser)->memo = parent->memo;
+	(*rparser)->arena = parent->arena;
 	return EOK;
 }
 
@@ -198,6 +210,140 @@ static void parser_follow_up(parser_t *sub, parser_t *parent)
 	parent->tok = sub->tok;
 }
 
+/** Make sure parser has a memo.
+ *
+ * If the parser does not have a memo yet, create one. It is then
+ * shared with all sub-parsers created from now on and the caller
+ * must destroy it using parser_memo_leave() when done.
+ *
+ * @param parser Parser
+ * @param rowner Place to store @c true iff the memo was created
+ *               (and caller is its owner)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int parser_memo_enter(parser_t *parser, bool *rowner)
+{
+	parser_memo_t *memo;
+	parser_memo_prod_t prod;
+
+	if (parser->memo != NULL) {
+		*rowner = false;
+		return EOK;
+	}
+
+	memo = calloc(1, sizeof(parser_memo_t));
+	if (memo == NULL)
+		return ENOMEM;
+
+	for (prod = pmp_ecast; prod < pmp_limit; prod++)
+		hmap_initialize(&memo->entries[prod], hmk_int);
+
+	parser->memo = memo;
+	*rowner = true;
+	return EOK;
+}
+
+/** Destroy parser memo if we are its owner.
+ *
+ * @param parser Parser
+ * @param owner @c true iff caller is owner of the memo (as returned
+ *              by parser_memo_enter())
+ */
+static void parser_memo_leave(parser_t *parser, bool owner)
+{
+	parser_memo_prod_t prod;
+
+	if (!owner)
+		return;
+
+	for (prod = pmp_ecast; prod < pmp_limit; prod++)
+		hmap_fini(&parser->memo->entries[prod]);
+	arena_destroy(parser->memo->arena);
+	free(parser->memo);
+	parser->memo = NULL;
+}
+
+/** Look up memoized outcome of parsing a production at the next token.
+ *
+ * @param parser Parser
+ * @param prod Production
+ * @return Error code if the production is known to fail,
+ *         EOK if it might succeed
+ */
+static int parser_memo_lookup(parser_t *parser, parser_memo_prod_t prod)
+{
+	parser_memo_entry_t *entry;
+
+	if (parser->memo == NULL)
+		return EOK;
+
+	entry = (parser_memo_entry_t *)hmap_find_int(
+	    &parser->memo->entries[prod], (int64_t)(size_t)parser->tok);
+	if (entry == NULL)
+		return EOK;
+
+	return entry->rc;
+}
+
+/** Record that parsing a production failed.
+ *
+ * The memo is just an optimization, if we run out of memory,
+ * the failure is simply not recorded.
+ *
+ * @param parser Parser
+ * @param prod Production
+ * @param tok Token where parsing the production started
+ * @param rc Error code
+ */
+static void parser_memo_record(parser_t *parser, parser_memo_prod_t prod,
+    void *tok, int rc)
+{
+	parser_memo_entry_t *entry;
+	int rv;
+
+	if (parser->memo == NULL || rc == ENOMEM)
+		return;
+
+	if (parser->memo->arena == NULL) {
+		rv = arena_create(&parser->memo->arena);
+		if (rv != EOK)
+			return;
+	}
+
+	entry = arena_alloc(parser->memo->arena, sizeof(parser_memo_entry_t));
+	if (entry == NULL)
+		return;
+
+	entry->rc = rc;
+	(void)hmap_insert_int(&parser->memo->entries[prod],
+	    (int64_t)(size_t)tok, entry);
+}
+
+/** Mark AST arena before parsing speculatively.
+ *
+ * @param parser Parser
+ * @param mark Place to store arena mark
+ */
+static void parser_spec_mark(parser_t *parser, arena_mark_t *mark)
+{
+	if (parser->arena != NULL)
+		arena_mark(parser->arena, mark);
+}
+
+/** Release AST nodes created by a failed speculative parse.
+ *
+ * The nodes must no longer be referenced (they have already been
+ * passed to ast_tree_destroy(), which does nothing for arena nodes).
+ *
+ * @param parser Parser
+ * @param mark Arena mark set by parser_spec_mark() before parsing
+ */
+static void parser_spec_rollback(parser_t *parser, arena_mark_t *mark)
+{
+	if (parser->arena != NULL)
+		arena_release(parser->arena, mark);
+}
+
 /** Destroy parser.
  *
  * @param parser Parser
@@ -892,57 +1038,99 @@ error:
 	return rc;
 }
 
-/** Parse expression beginning with left parenthesis.
+/** Speculatively parse a production.
+ *
+ * Try parsing production @a prod using a silent sub-parser. If it
+ * succeeds, @a parser follows up after it. If parsing fails, the failure
+ * is recorded in the memo (if there is one). If the memo says that
+ * the production fails at this token, we fail without parsing it again.
  *
  * @param parser Parser
- * @param rexpr Place to store pointer to new arithmetic expression
+ * @param prod Production
+ * @param rexpr Place to store pointer to new expression
  *
  * @return EOK on success or non-zero error code
  */
-static int parser_process_eparen(parser_t *parser, ast_node_t **rexpr)
+static int parser_try(parser_t *parser, parser_memo_prod_t prod,
+    ast_node_t **rexpr)
 {
-	parser_t *sparser = NULL;
+	parser_t *sparser;
+	arena_mark_t mark;
+	void *tok;
 	int rc;
 
+	rc = parser_memo_lookup(parser, prod);
+	if (rc != EOK)
+		return rc;
+
+	tok = parser->tok;
+
 	rc = parser_create_silent_sub(parser, &sparser);
 	if (rc != EOK)
-		goto error;
+		return rc;
+
+	parser_spec_mark(parser, &mark);
+
+	switch (prod) {
+	case pmp_ecast:
+		rc = parser_process_ecast(sparser, rexpr);
+		break;
+	case pmp_ecliteral:
+		rc = parser_process_ecliteral(sparser, rexpr);
+		break;
+	case pmp_eparexpr:
+		rc = parser_process_eparexpr(sparser, rexpr);
+		break;
+	case pmp_econcat:
+		rc = parser_process_econcat(sparser, rexpr);
+		break;
+	default:
+		assert(false);
+		rc = EINVAL;
+		break;
+	}
 
-	/* Try parsing as a type cast */
-	rc = parser_process_ecast(sparser, rexpr);
 	if (rc == EOK) {
-		/* It worked */
-		parser->tok = sparser->tok;
-		parser_destroy(sparser);
-		return EOK;
+		parser_follow_up(sparser, parser);
+	} else {
+		parser_spec_rollback(parser, &mark);
+		parser_memo_record(parser, prod, tok, rc);
 	}
 
 	parser_destroy(sparser);
+	return rc;
+}
 
-	rc = parser_create_silent_sub(parser, &sparser);
+/** Parse expression beginning with left parenthesis.
+ *
+ * @param parser Parser
+ * @param rexpr Place to store pointer to new arithmetic expression
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int parser_process_eparen(parser_t *parser, ast_node_t **rexpr)
+{
+	bool memo_owner;
+	int rc;
+
+	rc = parser_memo_enter(parser, &memo_owner);
 	if (rc != EOK)
-		goto error;
+		return rc;
 
-	/* Try parsing as a compound literal */
-	rc = parser_process_ecliteral(sparser, rexpr);
-	if (rc == EOK) {
-		/* It worked */
-		parser->tok = sparser->tok;
-		parser_destroy(sparser);
-		return EOK;
-	}
+	/* Try parsing as a type cast */
+	rc = parser_try(parser, pmp_ecast, rexpr);
+	if (rc == EOK)
+		goto out;
 
-	parser_destroy(sparser);
+	/* Try parsing as a compound literal */
+	rc = parser_try(parser, pmp_ecliteral, rexpr);
+	if (rc == EOK)
+		goto out;
 
 	/* Try parsing the as an expression in parentheses */
-
 	rc = parser_process_eparexpr(parser, rexpr);
-	if (rc != EOK) {
-		goto error;
-	}
-
-	return EOK;
-error:
+out:
+	parser_memo_leave(parser, memo_owner);
 	return rc;
 }
 
@@ -1064,12 +1252,16 @@ static int parser_process_ecall(parser_t *parser, ast_node_t *ea,
 	ast_ecall_t *ecall = NULL;
 	ast_node_t *arg = NULL;
 	ast_typename_t *atypename;
-	parser_t *sparser;
+	bool memo_owner;
 	void *dop;
 	void *drparen;
 	void *dcomma;
 	int rc;
 
+	rc = parser_memo_enter(parser, &memo_owner);
+	if (rc != EOK)
+		return rc;
+
 	rc = parser_match(parser, ltt_lparen, &dop);
 	if (rc != EOK)
 		goto error;
@@ -1085,16 +1277,8 @@ static int parser_process_ecall(parser_t *parser, ast_node_t *ea,
 
 	/* We can only fail this test upon entry */
 	while (ltt != ltt_rparen) {
-		rc = parser_create_silent_sub(parser, &sparser);
-		if (rc != EOK)
-			goto error;
-
-		rc = parser_process_econcat(sparser, &arg);
-		if (rc == EOK) {
-			parser->tok = sparser->tok;
-			parser_destroy(sparser);
-		} else {
-			parser_destroy(sparser);
+		rc = parser_try(parser, pmp_econcat, &arg);
+		if (rc != EOK) {
 			rc = parser_process_typename(parser, &atypename);
 			if (rc != EOK)
 				goto error;
@@ -1122,12 +1306,14 @@ static int parser_process_ecall(parser_t *parser, ast_node_t *ea,
 
 	ecall->fexpr = ea;
 	*recall = ecall;
+	parser_memo_leave(parser, memo_owner);
 	return EOK;
 error:
 	if (ecall != NULL)
 		ast_tree_destroy(&ecall->node);
 	if (arg != NULL)
 		ast_tree_destroy(arg);
+	parser_memo_leave(parser, memo_owner);
 	return rc;
 }
 
@@ -1270,12 +1456,16 @@ static int parser_process_ealignof(parser_t *parser, ast_node_t **rexpr)
 	ast_ealignof_t *ealignof = NULL;
 	ast_node_t *bexpr = NULL;
 	ast_typename_t *atypename = NULL;
-	parser_t *sparser;
+	bool memo_owner;
 	void *dalignof;
 	void *dlparen;
 	void *drparen;
 	int rc;
 
+	rc = parser_memo_enter(parser, &memo_owner);
+	if (rc != EOK)
+		return rc;
+
 	rc = ast_ealignof_create(&ealignof);
 	if (rc != EOK)
 		goto error;
@@ -1288,18 +1478,11 @@ static int parser_process_ealignof(parser_t *parser, ast_node_t **rexpr)
 
 	ltt = parser_next_ttype(parser);
 	if (ltt == ltt_lparen) {
-		rc = parser_create_silent_sub(parser, &sparser);
-		if (rc != EOK)
-			goto error;
-
-		rc = parser_process_eparexpr(sparser, &bexpr);
+		rc = parser_try(parser, pmp_eparexpr, &bexpr);
 		if (rc == EOK) {
-			parser->tok = sparser->tok;
-			parser_destroy(sparser);
 			ealignof->bexpr = bexpr;
 		} else {
 			parser_skip(parser, &dlparen);
-			parser_destroy(sparser);
 
 			rc = parser_process_typename(parser, &atypename);
 			if (rc != EOK)
@@ -1323,6 +1506,7 @@ static int parser_process_ealignof(parser_t *parser, ast_node_t **rexpr)
 	}
 
 	*rexpr = &ealignof->node;
+	parser_memo_leave(parser, memo_owner);
 	return EOK;
 error:
 	if (bexpr != NULL)
@@ -1331,6 +1515,7 @@ error:
 		ast_tree_destroy(&atypename->node);
 	if (ealignof != NULL)
 		ast_tree_destroy(&ealignof->node);
+	parser_memo_leave(parser, memo_owner);
 	return rc;
 }
 
@@ -1347,12 +1532,16 @@ static int parser_process_esizeof(parser_t *parser, ast_node_t **rexpr)
 	ast_esizeof_t *esizeof = NULL;
 	ast_node_t *bexpr = NULL;
 	ast_typename_t *atypename = NULL;
-	parser_t *sparser;
+	bool memo_owner;
 	void *dsizeof;
 	void *dlparen;
 	void *drparen;
 	int rc;
 
+	rc = parser_memo_enter(parser, &memo_owner);
+	if (rc != EOK)
+		return rc;
+
 	rc = ast_esizeof_create(&esizeof);
 	if (rc != EOK)
 		goto error;
@@ -1365,18 +1554,11 @@ static int parser_process_esizeof(parser_t *parser, ast_node_t **rexpr)
 
 	ltt = parser_next_ttype(parser);
 	if (ltt == ltt_lparen) {
-		rc = parser_create_silent_sub(parser, &sparser);
-		if (rc != EOK)
-			goto error;
-
-		rc = parser_process_eparexpr(sparser, &bexpr);
+		rc = parser_try(parser, pmp_eparexpr, &bexpr);
 		if (rc == EOK) {
-			parser->tok = sparser->tok;
-			parser_destroy(sparser);
 			esizeof->bexpr = bexpr;
 		} else {
 			parser_skip(parser, &dlparen);
-			parser_destroy(sparser);
 
 			rc = parser_process_typename(parser, &atypename);
 			if (rc != EOK)
@@ -1400,6 +1582,7 @@ static int parser_process_esizeof(parser_t *parser, ast_node_t **rexpr)
 	}
 
 	*rexpr = &esizeof->node;
+	parser_memo_leave(parser, memo_owner);
 	return EOK;
 error:
 	if (bexpr != NULL)
@@ -1408,6 +1591,7 @@ error:
 		ast_tree_destroy(&atypename->node);
 	if (esizeof != NULL)
 		ast_tree_destroy(&esizeof->node);
+	parser_memo_leave(parser, memo_owner);
 	return rc;
 }
 
@@ -2127,6 +2311,7 @@ static int parser_process_econcat(parser_t *parser, ast_node_t **rexpr)
 	ast_node_t *ea = NULL;
 	ast_node_t *eb = NULL;
 	parser_t *sparser = NULL;
+	arena_mark_t mark;
 	int rc;
 
 	rc = parser_process_eassign(parser, &ea);
@@ -2138,9 +2323,12 @@ static int parser_process_econcat(parser_t *parser, ast_node_t **rexpr)
 		if (rc != EOK)
 			goto error;
 
+		parser_spec_mark(parser, &mark);
 		rc = parser_process_eassign(sparser, &eb);
-		if (rc != EOK)
+		if (rc != EOK) {
+			parser_spec_rollback(parser, &mark);
 			break;
+		}
 
 		/* Success */
 		parser->tok = sparser->tok;
@@ -3456,6 +3644,7 @@ static int parser_process_for(parser_t *parser, ast_node_t **rfor)
 	ast_node_t *lnext = NULL;
 	void *drparen;
 	ast_block_t *body = NULL;
+	arena_mark_t mark;
 	int rc;
 
 	rc = parser_match(parser, ltt_for, &dfor);
@@ -3473,6 +3662,7 @@ static int parser_process_for(parser_t *parser, ast_node_t **rfor)
 	ltt = parser_next_ttype(sparser);
 
 	/* Try parsing as a declaration */
+	parser_spec_mark(parser, &mark);
 	rc = parser_process_dspecs(sparser, 0, NULL, &dspecs);
 	if (rc == EOK)
 		rc = parser_process_idlist(sparser, ast_abs_disallow, &idlist);
@@ -3488,6 +3678,7 @@ static int parser_process_for(parser_t *parser, ast_node_t **rfor)
 		dspecs = NULL;
 		ast_tree_destroy(&idlist->node);
 		dspecs = NULL;
+		parser_spec_rollback(parser, &mark);
 
 		parser_destroy(sparser);
 		sparser = NULL;
@@ -4208,6 +4399,7 @@ int parser_process_stmt(parser_t *parser, ast_node_t **rstmt)
 {
 	lexer_toktype_t ltt, ltt2;
 	parser_t *sparser;
+	arena_mark_t mark;
 	int rc;
 
 	ltt = parser_next_ttype(parser);
@@ -4263,6 +4455,7 @@ int parser_process_stmt(parser_t *parser, ast_node_t **rstmt)
 		return rc;
 
 	/* Try parsing the statement as a declaration */
+	parser_spec_mark(parser, &mark);
 	rc = parser_process_stdecln(sparser, rstmt);
 	if (rc == EOK) {
 		/* It worked */
@@ -4271,6 +4464,7 @@ int parser_process_stmt(parser_t *parser, ast_node_t **rstmt)
 	} else {
 		/* Didn't work. Try parsing as an expression instead */
 		parser_destroy(sparser);
+		parser_spec_rollback(parser, &mark);
 		rc = parser_process_stexpr(parser, rstmt);
 		if (rc != EOK)
 			return rc;
@@ -5961,6 +6155,7 @@ static int parser_process_alignspec(parser_t *parser,
 	void *dlparen;
 	void *drparen;
 	parser_t *sparser = NULL;
+	arena_mark_t mark;
 	int rc;
 
 	ltt = parser_next_ttype(parser);
@@ -5978,9 +6173,11 @@ static int parser_process_alignspec(parser_t *parser,
 		goto error;
 
 	/* Try parsing as constant expression */
+	parser_spec_mark(parser, &mark);
 	rc = parser_process_expr(sparser, &aparam);
 	if (rc != EOK) {
 		parser_destroy(sparser);
+		parser_spec_rollback(parser, &mark);
 
 		/* Then it must be a type name */
 		rc = parser_process_typename(parser, &atypename);
@@ -6088,10 +6285,12 @@ static int parser_process_aspec_attr(parser_t *parser, ast_aspec_attr_t **rattr)
 	/* XXX Attribute name can also be a reserved word */
 	ltt = parser_next_ttype(parser);
 	if (ltt != ltt_ident && !lexer_is_resword(ltt)) {
-		(void)fprintf(stderr, "Error: ");
-		(void)parser_dprint_next_tok(parser, stderr);
-		(void)fprintf(stderr, " unexpected, expected identifier or "
-		    "reserved word.\n");
+		if (!parser->silent) {
+			(void)fprintf(stderr, "Error: ");
+			(void)parser_dprint_next_tok(parser, stderr);
+			(void)fprintf(stderr, " unexpected, expected "
+			    "identifier or reserved word.\n");
+		}
 
 		rc = EINVAL;
 		goto error;
@@ -6892,6 +7091,9 @@ error:
 }
 
 /** Parse module.
+ *
+ * All nodes of the module are allocated from an arena owned by
+ * the module, so that the whole tree can be freed at once.
  *
  * @param parser Parser
  * @param rmodule Place to store pointer to new module
@@ -6903,12 +7105,24 @@ int parser_process_module(parser_t *parser, ast_module_t **rmodule)
 	lexer_toktype_t ltt;
 	ast_module_t *module;
 	ast_node_t *node;
+	arena_t *arena;
+	arena_t *oarena;
 	int rc;
 
 	rc = ast_module_create(&module);
 	if (rc != EOK)
 		return rc;
 
+	rc = arena_create(&arena);
+	if (rc != EOK) {
+		ast_tree_destroy(&module->node);
+		return rc;
+	}
+
+	module->arena = arena;
+	parser->arena = arena;
+	oarena = ast_set_arena(arena);
+
 	ltt = parser_next_ttype(parser);
 	while (ltt != ltt_eof) {
 		rc = parser_handle_global_decln(parser, &node);
@@ -6919,9 +7133,13 @@ int parser_process_module(parser_t *parser, ast_module_t **rmodule)
 		ltt = parser_next_ttype(parser);
 	}
 
+	(void)ast_set_arena(oarena);
+	parser->arena = NULL;
 	*rmodule = module;
 	return EOK;
 error:
+	(void)ast_set_arena(oarena);
+	parser->arena = NULL;
 	ast_tree_destroy(&module->node);
 	return rc;
 }
@@ -125,6 +125,56 @@ char *pathname_compose(const char *base, const char *sub)
 	return pathname;
 }
 
+/** Normalize path name.
+ *
+ * Removes empty and '.' components so that different spellings of the
+ * same path (e.g. 'a/./b' and 'a//b') compare equal. '..' components
+ * are kept, since they cannot be resolved without accessing the file
+ * system.
+ *
+ * @param pathname Path name
+ * @return Newly allocated string or @c NULL.
+ */
+char *pathname_normalize(const char *pathname)
+{
+	char *npath;
+	const char *sp;
+	char *dp;
+	size_t len;
+
+	npath = malloc(strlen(pathname) + 2);
+	if (npath == NULL)
+		return NULL;
+
+	sp = pathname;
+	dp = npath;
+	if (*sp == '/')
+		*dp++ = '/';
+
+	while (*sp != '\0') {
+		/* Find end of component */
+		len = 0;
+		while (sp[len] != '\0' && sp[len] != '/')
+			++len;
+
+		if (len > 0 && (len != 1 || sp[0] != '.')) {
+			if (dp != npath && dp[-1] != '/')
+				*dp++ = '/';
+			memcpy(dp, sp, len);
+			dp += len;
+		}
+
+		sp += len;
+		if (*sp == '/')
+			++sp;
+	}
+
+	if (dp == npath)
+		*dp++ = '.';
+	*dp = '\0';
+	return npath;
+}
+
 /** Determine directory from which the executable was run.
  *
  * @param cmd Command used to run executable.
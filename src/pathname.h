@@ -34,6 +34,7 @@ extern bool pathname_is_absolute(const char *);
 extern bool pathname_is_basic(const char *);
 extern bool pathname_exists(const char *);
 extern char *pathname_compose(const char *, const char *);
+extern char *pathname_normalize(const char *);
 extern char *pathname_get_execdir(const char *, const char *);
 
 #endif
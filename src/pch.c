@@ -0,0 +1,2119 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Precompiled headers
+ *
+ * A precompiled header captures the state of the preprocessor (macros
+ * and the header cache) and of the code generator (records, enums,
+ * typedefs and declared symbols) after processing a header file.
+ * If a source file starts by including the same header, this state is
+ * restored instead of processing the header again.
+ *
+ * The file also lists all files the header was built from, together with
+ * their sizes, modification times and content hashes. A precompiled header
+ * is only used if none of these files has changed.
+ *
+ * All integers are stored in little-endian byte order. Strings are
+ * stored as length followed by the characters and a null terminator.
+ */
+
+#include <adt/list.h>
+#include <arena.h>
+#include <assert.h>
+#include <cgenum.h>
+#include <cgrec.h>
+#include <cgtype.h>
+#include <ir.h>
+#include <lexer.h>
+#include <merrno.h>
+#include <pathname.h>
+#include <pch.h>
+#include <scope.h>
+#include <src_pos.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strtab.h>
+#include <symbols.h>
+#ifdef HAVE_SYS_STAT
+#include <sys/stat.h>
+#endif
+
+enum {
+	/** Initial size of writer buffer */
+	pch_wr_init_size = 256,
+	/** Size of buffer for reading files */
+	pch_buf_size = 64,
+	/** Maximum number of bits in a bit field storage unit */
+	pch_max_bits = 64
+};
+
+/** Record element item types */
+enum {
+	/** Element with its own storage unit */
+	pch_rei_plain,
+	/** Bit field element */
+	pch_rei_bitfield,
+	/** Storage unit for the preceding bit field elements */
+	pch_rei_stor
+};
+
+/** Update FNV-1a hash with data.
+ *
+ * @param hash Hash value to update
+ * @param data Data
+ * @param size Size of data in bytes
+ */
+static void pch_hash_update(uint32_t *hash, const uint8_t *data, size_t size)
+{
+	uint32_t h;
+	size_t i;
+
+	h = *hash;
+	for (i = 0; i < size; i++) {
+		h ^= data[i];
+		h *= 16777619UL;
+	}
+
+	*hash = h;
+}
+
+/** Append bytes to precompiled header writer.
+ *
+ * If we run out of memory, the error is remembered in the writer.
+ *
+ * @param wr Writer
+ * @param data Data
+ * @param size Size of data in bytes
+ */
+static void pch_wr_bytes(pch_wr_t *wr, const void *data, size_t size)
+{
+	uint8_t *ndata;
+	size_t nalloc;
+
+	if (wr->error || size == 0)
+		return;
+
+	if (wr->alloc - wr->size < size) {
+		nalloc = wr->alloc > 0 ? 2 * wr->alloc : pch_wr_init_size;
+		while (nalloc - wr->size < size)
+			nalloc *= 2;
+
+		ndata = realloc(wr->data, nalloc);
+		if (ndata == NULL) {
+			wr->error = true;
+			return;
+		}
+
+		wr->data = ndata;
+		wr->alloc = nalloc;
+	}
+
+	memcpy(wr->data + wr->size, data, size);
+	wr->size += size;
+}
+
+/** Write 8-bit unsigned integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+void pch_wr_u8(pch_wr_t *wr, uint8_t v)
+{
+	pch_wr_bytes(wr, &v, 1);
+}
+
+/** Write 32-bit unsigned integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+void pch_wr_u32(pch_wr_t *wr, uint32_t v)
+{
+	uint8_t b[4];
+
+	b[0] = (uint8_t)(v & 0xff);
+	b[1] = (uint8_t)((v >> 8) & 0xff);
+	b[2] = (uint8_t)((v >> 16) & 0xff);
+	b[3] = (uint8_t)((v >> 24) & 0xff);
+	pch_wr_bytes(wr, b, 4);
+}
+
+/** Write 64-bit unsigned integer.
+ *
+ * @param wr Writer
+ * @param v Value
+ */
+void pch_wr_u64(pch_wr_t *wr, uint64_t v)
+{
+	pch_wr_u32(wr, (uint32_t)(v & 0xffffffffUL));
+	pch_wr_u32(wr, (uint32_t)(v >> 32));
+}
+
+/** Write string.
+ *
+ * @param wr Writer
+ * @param str String
+ */
+void pch_wr_str(pch_wr_t *wr, const char *str)
+{
+	size_t len;
+
+	len = strlen(str);
+	pch_wr_u32(wr, (uint32_t)len);
+	pch_wr_bytes(wr, str, len + 1);
+}
+
+/** Write optional string.
+ *
+ * @param wr Writer
+ * @param str String or @c NULL
+ */
+void pch_wr_optstr(pch_wr_t *wr, const char *str)
+{
+	if (str == NULL) {
+		pch_wr_u8(wr, 0);
+		return;
+	}
+
+	pch_wr_u8(wr, 1);
+	pch_wr_str(wr, str);
+}
+
+/** Write source position.
+ *
+ * @param wr Writer
+ * @param pos Source position
+ */
+void pch_wr_pos(pch_wr_t *wr, src_pos_t *pos)
+{
+	pch_wr_str(wr, src_pos_fname(pos));
+	pch_wr_u32(wr, pos->line);
+	pch_wr_u32(wr, pos->col);
+}
+
+/** Read bytes from precompiled header reader.
+ *
+ * @param rd Reader
+ * @param size Number of bytes
+ * @return Pointer to the bytes or @c NULL if there is not enough data
+ *         (the error is remembered in the reader)
+ */
+static uint8_t *pch_rd_bytes(pch_rd_t *rd, size_t size)
+{
+	uint8_t *p;
+
+	if (rd->error || rd->size - rd->pos < size) {
+		rd->error = true;
+		return NULL;
+	}
+
+	p = rd->data + rd->pos;
+	rd->pos += size;
+	return p;
+}
+
+/** Read 8-bit unsigned integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+uint8_t pch_rd_u8(pch_rd_t *rd)
+{
+	uint8_t *p;
+
+	p = pch_rd_bytes(rd, 1);
+	if (p == NULL)
+		return 0;
+
+	return p[0];
+}
+
+/** Read 32-bit unsigned integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+uint32_t pch_rd_u32(pch_rd_t *rd)
+{
+	uint8_t *p;
+
+	p = pch_rd_bytes(rd, 4);
+	if (p == NULL)
+		return 0;
+
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	    ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** Read 64-bit unsigned integer.
+ *
+ * @param rd Reader
+ * @return Value (zero on error)
+ */
+uint64_t pch_rd_u64(pch_rd_t *rd)
+{
+	uint64_t lo;
+	uint64_t hi;
+
+	lo = pch_rd_u32(rd);
+	hi = pch_rd_u32(rd);
+	return lo | (hi << 32);
+}
+
+/** Read string and return pointer to it in the data being read.
+ *
+ * @param rd Reader
+ * @return String (empty string on error)
+ */
+static char *pch_rd_strp(pch_rd_t *rd)
+{
+	uint8_t *p;
+	uint32_t len;
+
+	len = pch_rd_u32(rd);
+	if (rd->error)
+		return "";
+
+	if ((uint32_t)(rd->size - rd->pos) <= len) {
+		rd->error = true;
+		return "";
+	}
+
+	p = pch_rd_bytes(rd, (size_t)len + 1);
+	if (p == NULL || p[(size_t)len] != '\0') {
+		rd->error = true;
+		return "";
+	}
+
+	return (char *)p;
+}
+
+/** Read string.
+ *
+ * The string is not copied, it is valid as long as the data being read.
+ *
+ * @param rd Reader
+ * @return String (empty string on error)
+ */
+const char *pch_rd_str(pch_rd_t *rd)
+{
+	return pch_rd_strp(rd);
+}
+
+/** Read optional string.
+ *
+ * @param rd Reader
+ * @return String or @c NULL
+ */
+const char *pch_rd_optstr(pch_rd_t *rd)
+{
+	if (pch_rd_u8(rd) == 0)
+		return NULL;
+
+	return pch_rd_strp(rd);
+}
+
+/** Read source position.
+ *
+ * @param rd Reader
+ * @param pos Place to store source position
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int pch_rd_pos(pch_rd_t *rd, src_pos_t *pos)
+{
+	const char *fname;
+	uint32_t line;
+	uint32_t col;
+
+	fname = pch_rd_str(rd);
+	line = pch_rd_u32(rd);
+	col = pch_rd_u32(rd);
+	return src_pos_set(pos, fname, (size_t)line, (size_t)col);
+}
+
+/** Get size and content hash of a file.
+ *
+ * @param path Path name
+ * @param rexists Place to store @c true iff the file exists
+ * @param rsize Place to store file size
+ * @param rhash Place to store hash of file contents
+ * @return EOK on success (whether or not the file exists), EIO on
+ *         read error
+ */
+static int pch_file_info(const char *path, bool *rexists, uint32_t *rsize,
+    uint32_t *rhash)
+{
+	FILE *f;
+	uint8_t buf[pch_buf_size];
+	uint32_t size;
+	uint32_t hash;
+	size_t nread;
+
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		*rexists = false;
+		*rsize = 0;
+		*rhash = 0;
+		return EOK;
+	}
+
+	size = 0;
+	hash = 2166136261UL;
+	do {
+		nread = fread(buf, 1, sizeof(buf), f);
+		pch_hash_update(&hash, buf, nread);
+		size += (uint32_t)nread;
+	} while (nread == sizeof(buf));
+
+	if (ferror(f) != 0) {
+		(void)fclose(f);
+		return EIO;
+	}
+
+	(void)fclose(f);
+	*rexists = true;
+	*rsize = size;
+	*rhash = hash;
+	return EOK;
+}
+
+/** Get modification time and size of a file.
+ *
+ * @param path Path name
+ * @param rmtime Place to store modification time
+ * @param rsize Place to store file size
+ * @return @c true on success, @c false if not known
+ */
+static bool pch_file_stat(const char *path, uint64_t *rmtime, uint32_t *rsize)
+{
+#ifdef HAVE_SYS_STAT
+	struct stat st;
+
+	if (stat(path, &st) != 0)
+		return false;
+
+	*rmtime = (uint64_t)st.st_mtime;
+	*rsize = (uint32_t)st.st_size;
+	return true;
+#else
+	(void)path;
+	(void)rmtime;
+	(void)rsize;
+	return false;
+#endif
+}
+
+/** Determine if a dependency of a precompiled header is unchanged.
+ *
+ * If modification time and size match, the file is assumed unchanged.
+ * Otherwise the file contents are hashed and compared.
+ *
+ * @param dep Dependency as recorded in the precompiled header
+ * @return @c true iff the file is unchanged
+ */
+static bool pch_dep_valid(pch_dep_t *dep)
+{
+	uint64_t mtime;
+	uint32_t size;
+	uint32_t hash;
+	bool exists;
+	int rc;
+
+	if (dep->exists && dep->mtime != 0 &&
+	    pch_file_stat(dep->path, &mtime, &size) &&
+	    mtime == dep->mtime && size == dep->size)
+		return true;
+
+	rc = pch_file_info(dep->path, &exists, &size, &hash);
+	if (rc != EOK)
+		return false;
+
+	if (exists != dep->exists)
+		return false;
+
+	return !exists || (size == dep->size && hash == dep->hash);
+}
+
+/** Create precompiled header (for saving).
+ *
+ * @param hdr_path Header path name
+ * @param cgflags Code generator flags the header is compiled with
+ * @param rpch Place to store pointer to new precompiled header
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int pch_create(const char *hdr_path, cgen_flags_t cgflags, pch_t **rpch)
+{
+	pch_t *pch;
+
+	pch = calloc(1, sizeof(pch_t));
+	if (pch == NULL)
+		return ENOMEM;
+
+	pch->hdr_path = pathname_normalize(hdr_path);
+	if (pch->hdr_path == NULL) {
+		free(pch);
+		return ENOMEM;
+	}
+
+	pch->cgflags = cgflags;
+	list_initialize(&pch->deps);
+	*rpch = pch;
+	return EOK;
+}
+
+/** Read precompiled header dependency and check it.
+ *
+ * @param rd Reader
+ * @param rvalid Place to store @c true iff the dependency is unchanged
+ * @param rpath Place to store path name of the dependency
+ */
+static void pch_load_dep(pch_rd_t *rd, bool *rvalid, const char **rpath)
+{
+	pch_dep_t dep;
+	const char *path;
+
+	path = pch_rd_str(rd);
+	dep.exists = pch_rd_u8(rd) != 0;
+	dep.size = pch_rd_u32(rd);
+	dep.hash = pch_rd_u32(rd);
+	dep.mtime = pch_rd_u64(rd);
+	if (rd->error) {
+		*rvalid = false;
+		*rpath = path;
+		return;
+	}
+
+	/* Only used for the duration of the check */
+	dep.path = (char *)path;
+	*rvalid = pch_dep_valid(&dep);
+	*rpath = path;
+}
+
+/** Load precompiled header from file with or without checking flags.
+ *
+ * @param fname File name
+ * @param anyflags @c true to accept any code generator flags
+ * @param cgflags Code generator flags (if @a anyflags is @c false)
+ * @param rpch Place to store pointer to loaded precompiled header
+ * @return EOK on success, ENOENT if file cannot be opened, EIO on read
+ *         error, EINVAL if header is not valid, ENOMEM if out of memory
+ */
+static int pch_load_file(const char *fname, bool anyflags,
+    cgen_flags_t cgflags, pch_t **rpch)
+{
+	pch_t *pch = NULL;
+	FILE *f = NULL;
+	pch_wr_t data;
+	pch_rd_t rd;
+	uint8_t buf[pch_buf_size];
+	const char *path;
+	uint32_t ndeps;
+	uint32_t size;
+	uint32_t i;
+	size_t nread;
+	bool valid;
+	int rc;
+
+	memset(&data, 0, sizeof(data));
+
+	f = fopen(fname, "rb");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+		rc = ENOENT;
+		goto error;
+	}
+
+	do {
+		nread = fread(buf, 1, sizeof(buf), f);
+		pch_wr_bytes(&data, buf, nread);
+	} while (nread == sizeof(buf));
+
+	if (ferror(f) != 0) {
+		(void)fprintf(stderr, "Error reading '%s'.\n", fname);
+		rc = EIO;
+		goto error;
+	}
+
+	(void)fclose(f);
+	f = NULL;
+
+	if (data.error) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	pch = calloc(1, sizeof(pch_t));
+	if (pch == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	list_initialize(&pch->deps);
+	pch->data = data.data;
+	pch->size = data.size;
+	data.data = NULL;
+
+	pch->hash = 2166136261UL;
+	pch_hash_update(&pch->hash, pch->data, pch->size);
+
+	/* Remember the file so that pch_is_current() can check it */
+	pch->file.path = strdup(fname);
+	if (pch->file.path == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	pch->file.exists = true;
+	pch->file.size = (uint32_t)pch->size;
+	pch->file.hash = pch->hash;
+	if (!pch_file_stat(fname, &pch->file.mtime, &size) ||
+	    size != pch->file.size)
+		pch->file.mtime = 0;
+
+	rd.data = pch->data;
+	rd.size = pch->size;
+	rd.pos = 0;
+	rd.error = false;
+
+	if (pch_rd_u32(&rd) != pch_file_sign ||
+	    pch_rd_u32(&rd) != pch_file_major) {
+		(void)fprintf(stderr, "'%s' is not a valid precompiled "
+		    "header.\n", fname);
+		rc = EINVAL;
+		goto error;
+	}
+
+	(void)pch_rd_u32(&rd);
+
+	pch->cgflags = (cgen_flags_t)pch_rd_u32(&rd);
+	if (!anyflags && pch->cgflags != cgflags) {
+		(void)fprintf(stderr, "Precompiled header '%s' was compiled "
+		    "with different code generator flags.\n", fname);
+		rc = EINVAL;
+		goto error;
+	}
+
+	pch->hdr_path = strdup(pch_rd_str(&rd));
+	if (pch->hdr_path == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	pch->deps_off = rd.pos;
+	ndeps = pch_rd_u32(&rd);
+	for (i = 0; i < ndeps && !rd.error; i++) {
+		pch_load_dep(&rd, &valid, &path);
+		if (!rd.error && !valid) {
+			(void)fprintf(stderr, "Precompiled header '%s' is "
+			    "out of date ('%s' has changed).\n", fname, path);
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	pch->pp_size = (size_t)pch_rd_u32(&rd);
+	pch->pp_off = rd.pos;
+	(void)pch_rd_bytes(&rd, pch->pp_size);
+
+	pch->cg_size = (size_t)pch_rd_u32(&rd);
+	pch->cg_off = rd.pos;
+	(void)pch_rd_bytes(&rd, pch->cg_size);
+
+	if (rd.error) {
+		(void)fprintf(stderr, "'%s' is not a valid precompiled "
+		    "header.\n", fname);
+		rc = EINVAL;
+		goto error;
+	}
+
+	*rpch = pch;
+	return EOK;
+error:
+	if (f != NULL)
+		(void)fclose(f);
+	if (data.data != NULL)
+		free(data.data);
+	pch_destroy(pch);
+	return rc;
+}
+
+/** Load precompiled header from file.
+ *
+ * The header is validated. If it is not valid (such as when it was
+ * compiled with different flags or any of the files it was built
+ * from has changed), an error message is printed and EINVAL is returned.
+ *
+ * @param fname File name
+ * @param cgflags Code generator flags
+ * @param rpch Place to store pointer to loaded precompiled header
+ * @return EOK on success, ENOENT if file cannot be opened, EIO on read
+ *         error, EINVAL if header is not valid, ENOMEM if out of memory
+ */
+int pch_load(const char *fname, cgen_flags_t cgflags, pch_t **rpch)
+{
+	return pch_load_file(fname, false, cgflags, rpch);
+}
+
+/** Load precompiled header from file, accepting any code generator flags.
+ *
+ * Same as pch_load(), except that the header is not checked against
+ * code generator flags.
+ *
+ * @param fname File name
+ * @param rpch Place to store pointer to loaded precompiled header
+ * @return EOK on success, ENOENT if file cannot be opened, EIO on read
+ *         error, EINVAL if header is not valid, ENOMEM if out of memory
+ */
+int pch_load_any(const char *fname, pch_t **rpch)
+{
+	return pch_load_file(fname, true, cgf_none, rpch);
+}
+
+/** Determine if loaded precompiled header is still current.
+ *
+ * This allows keeping a precompiled header loaded (e.g. in the compile
+ * server) instead of loading it again for every compilation.
+ *
+ * @param pch Loaded precompiled header
+ * @param fname File name of the precompiled header to use
+ * @param cgflags Code generator flags
+ * @return @c true iff @a pch was loaded from @a fname with the same
+ *         code generator flags and neither the file nor any of the files
+ *         the header was built from has changed since
+ */
+bool pch_is_current(pch_t *pch, const char *fname, cgen_flags_t cgflags)
+{
+	pch_rd_t rd;
+	const char *path;
+	uint32_t ndeps;
+	uint32_t i;
+	bool valid;
+
+	if (pch->file.path == NULL || strcmp(pch->file.path, fname) != 0 ||
+	    pch->cgflags != cgflags)
+		return false;
+
+	if (!pch_dep_valid(&pch->file))
+		return false;
+
+	rd.data = pch->data;
+	rd.size = pch->size;
+	rd.pos = pch->deps_off;
+	rd.error = false;
+
+	ndeps = pch_rd_u32(&rd);
+	for (i = 0; i < ndeps; i++) {
+		pch_load_dep(&rd, &valid, &path);
+		if (rd.error || !valid)
+			return false;
+	}
+
+	return true;
+}
+
+/** Destroy precompiled header.
+ *
+ * @param pch Precompiled header or @c NULL
+ */
+void pch_destroy(pch_t *pch)
+{
+	link_t *link;
+	pch_dep_t *dep;
+
+	if (pch == NULL)
+		return;
+
+	link = list_first(&pch->deps);
+	while (link != NULL) {
+		dep = list_get_instance(link, pch_dep_t, ldeps);
+		list_remove(&dep->ldeps);
+		free(dep->path);
+		free(dep);
+		link = list_first(&pch->deps);
+	}
+
+	if (pch->hdr_path != NULL)
+		free(pch->hdr_path);
+	if (pch->file.path != NULL)
+		free(pch->file.path);
+	if (pch->ppwr.data != NULL)
+		free(pch->ppwr.data);
+	if (pch->cgwr.data != NULL)
+		free(pch->cgwr.data);
+	if (pch->data != NULL)
+		free(pch->data);
+	free(pch);
+}
+
+/** Get path name of the precompiled header's source header.
+ *
+ * @param pch Precompiled header
+ * @return Normalized path name
+ */
+const char *pch_hdr_path(pch_t *pch)
+{
+	return pch->hdr_path;
+}
+
+/** Get hash of precompiled header contents.
+ *
+ * @param pch Loaded precompiled header
+ * @return Hash of the precompiled header file
+ */
+uint32_t pch_hash(pch_t *pch)
+{
+	return pch->hash;
+}
+
+/** Add dependency to precompiled header.
+ *
+ * Records the current state of a file the header is built from
+ * (or the fact that it does not exist).
+ *
+ * @param pch Precompiled header
+ * @param path Path name
+ * @return EOK on success or an error code
+ */
+int pch_add_dep(pch_t *pch, const char *path)
+{
+	pch_dep_t *dep;
+	uint32_t size;
+	int rc;
+
+	dep = calloc(1, sizeof(pch_dep_t));
+	if (dep == NULL)
+		return ENOMEM;
+
+	dep->path = strdup(path);
+	if (dep->path == NULL) {
+		free(dep);
+		return ENOMEM;
+	}
+
+	rc = pch_file_info(path, &dep->exists, &dep->size, &dep->hash);
+	if (rc != EOK) {
+		free(dep->path);
+		free(dep);
+		return rc;
+	}
+
+	if (!dep->exists || !pch_file_stat(path, &dep->mtime, &size) ||
+	    size != dep->size)
+		dep->mtime = 0;
+
+	dep->pch = pch;
+	list_append(&dep->ldeps, &pch->deps);
+	return EOK;
+}
+
+/** Get writer for preprocessor state.
+ *
+ * @param pch Precompiled header
+ * @return Writer
+ */
+pch_wr_t *pch_pp_writer(pch_t *pch)
+{
+	return &pch->ppwr;
+}
+
+/** Get reader for preprocessor state of a loaded precompiled header.
+ *
+ * @param pch Precompiled header
+ * @param rd Reader to initialize
+ */
+void pch_pp_reader(pch_t *pch, pch_rd_t *rd)
+{
+	rd->data = pch->data + pch->pp_off;
+	rd->size = pch->pp_size;
+	rd->pos = 0;
+	rd->error = false;
+}
+
+/** Save precompiled header to file.
+ *
+ * @param pch Precompiled header
+ * @param f Output file
+ * @return EOK on success or an error code
+ */
+int pch_save(pch_t *pch, FILE *f)
+{
+	pch_wr_t wr;
+	link_t *link;
+	pch_dep_t *dep;
+	size_t nw;
+	int rc;
+
+	memset(&wr, 0, sizeof(wr));
+
+	pch_wr_u32(&wr, pch_file_sign);
+	pch_wr_u32(&wr, pch_file_major);
+	pch_wr_u32(&wr, pch_file_minor);
+	pch_wr_u32(&wr, (uint32_t)pch->cgflags);
+	pch_wr_str(&wr, pch->hdr_path);
+
+	pch_wr_u32(&wr, (uint32_t)list_count(&pch->deps));
+	link = list_first(&pch->deps);
+	while (link != NULL) {
+		dep = list_get_instance(link, pch_dep_t, ldeps);
+		pch_wr_str(&wr, dep->path);
+		pch_wr_u8(&wr, dep->exists ? 1 : 0);
+		pch_wr_u32(&wr, dep->size);
+		pch_wr_u32(&wr, dep->hash);
+		pch_wr_u64(&wr, dep->mtime);
+		link = list_next(link, &pch->deps);
+	}
+
+	pch_wr_u32(&wr, (uint32_t)pch->ppwr.size);
+	pch_wr_bytes(&wr, pch->ppwr.data, pch->ppwr.size);
+	pch_wr_u32(&wr, (uint32_t)pch->cgwr.size);
+	pch_wr_bytes(&wr, pch->cgwr.data, pch->cgwr.size);
+
+	if (wr.error || pch->ppwr.error || pch->cgwr.error) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	nw = fwrite(wr.data, 1, wr.size, f);
+	if (nw != wr.size) {
+		rc = EIO;
+		goto error;
+	}
+
+	free(wr.data);
+	return EOK;
+error:
+	if (wr.data != NULL)
+		free(wr.data);
+	return rc;
+}
+
+/** Find index of record being saved.
+ *
+ * @param save Code generator state saving
+ * @param record Record
+ * @return Index
+ */
+static uint32_t pch_cgsave_record_idx(pch_cgsave_t *save,
+    cgen_record_t *record)
+{
+	size_t i;
+
+	for (i = 0; i < save->nrecords; i++) {
+		if (save->records[i] == record)
+			return (uint32_t)i;
+	}
+
+	assert(false);
+	return 0;
+}
+
+/** Find index of enum being saved.
+ *
+ * @param save Code generator state saving
+ * @param cgenum Enum
+ * @return Index
+ */
+static uint32_t pch_cgsave_enum_idx(pch_cgsave_t *save, cgen_enum_t *cgenum)
+{
+	size_t i;
+
+	for (i = 0; i < save->nenums; i++) {
+		if (save->enums[i] == cgenum)
+			return (uint32_t)i;
+	}
+
+	assert(false);
+	return 0;
+}
+
+/** Find index of symbol being saved.
+ *
+ * @param save Code generator state saving
+ * @param symbol Symbol
+ * @return Index
+ */
+static uint32_t pch_cgsave_sym_idx(pch_cgsave_t *save, symbol_t *symbol)
+{
+	size_t i;
+
+	for (i = 0; i < save->nsyms; i++) {
+		if (save->syms[i] == symbol)
+			return (uint32_t)i;
+	}
+
+	assert(false);
+	return 0;
+}
+
+/** Save code generator type.
+ *
+ * @param save Code generator state saving
+ * @param cgtype Code generator type
+ */
+static void pch_cgsave_cgtype(pch_cgsave_t *save, cgtype_t *cgtype)
+{
+	cgtype_basic_t *basic;
+	cgtype_func_t *func;
+	cgtype_func_arg_t *arg;
+	cgtype_pointer_t *pointer;
+	cgtype_record_t *record;
+	cgtype_enum_t *cgenum;
+	cgtype_array_t *array;
+
+	pch_wr_u8(save->wr, (uint8_t)cgtype->ntype);
+	pch_wr_u8(save->wr, (uint8_t)cgtype->qual);
+
+	switch (cgtype->ntype) {
+	case cgn_basic:
+		basic = (cgtype_basic_t *)cgtype->ext;
+		pch_wr_u8(save->wr, (uint8_t)basic->elmtype);
+		break;
+	case cgn_func:
+		func = (cgtype_func_t *)cgtype->ext;
+		pch_cgsave_cgtype(save, func->rtype);
+		pch_wr_u8(save->wr, func->variadic ? 1 : 0);
+		pch_wr_u8(save->wr, (uint8_t)func->cconv);
+		pch_wr_u8(save->wr, func->may_ignore_return ? 1 : 0);
+		pch_wr_u32(save->wr, (uint32_t)list_count(&func->args));
+
+		arg = cgtype_func_first(func);
+		while (arg != NULL) {
+			pch_cgsave_cgtype(save, arg->atype);
+			arg = cgtype_func_next(arg);
+		}
+		break;
+	case cgn_pointer:
+		pointer = (cgtype_pointer_t *)cgtype->ext;
+		pch_cgsave_cgtype(save, pointer->tgtype);
+		break;
+	case cgn_record:
+		record = (cgtype_record_t *)cgtype->ext;
+		pch_wr_u32(save->wr, pch_cgsave_record_idx(save,
+		    record->record));
+		break;
+	case cgn_enum:
+		cgenum = (cgtype_enum_t *)cgtype->ext;
+		pch_wr_u32(save->wr, pch_cgsave_enum_idx(save,
+		    cgenum->cgenum));
+		break;
+	case cgn_array:
+		array = (cgtype_array_t *)cgtype->ext;
+		pch_cgsave_cgtype(save, array->etype);
+		pch_wr_u8(save->wr, array->itype != NULL ? 1 : 0);
+		if (array->itype != NULL)
+			pch_cgsave_cgtype(save, array->itype);
+		pch_wr_u8(save->wr, array->have_size ? 1 : 0);
+		pch_wr_u64(save->wr, array->asize);
+		break;
+	}
+}
+
+/** Save identifier token.
+ *
+ * @param save Code generator state saving
+ * @param tok Token
+ */
+static void pch_cgsave_tok(pch_cgsave_t *save, lexer_tok_t *tok)
+{
+	pch_wr_u32(save->wr, (uint32_t)tok->ttype);
+	pch_wr_str(save->wr, tok->text);
+	pch_wr_pos(save->wr, &tok->bpos);
+	pch_wr_pos(save->wr, &tok->epos);
+}
+
+/** Save record elements.
+ *
+ * Elements are saved in order. A bit field storage unit is saved
+ * after the last bit field element it holds, that is in the same
+ * order as the code generator creates it.
+ *
+ * @param save Code generator state saving
+ * @param record Record
+ */
+static void pch_cgsave_record_elems(pch_cgsave_t *save,
+    cgen_record_t *record)
+{
+	cgen_rec_elem_t *elem;
+	cgen_rec_elem_t *next;
+	uint32_t nitems;
+
+	nitems = 0;
+	elem = cgen_record_first_elem(record);
+	while (elem != NULL) {
+		next = cgen_record_next_elem(elem);
+		++nitems;
+		if (elem->stor->bitfield &&
+		    (next == NULL || next->stor != elem->stor))
+			++nitems;
+		elem = next;
+	}
+
+	pch_wr_u32(save->wr, nitems);
+
+	elem = cgen_record_first_elem(record);
+	while (elem != NULL) {
+		next = cgen_record_next_elem(elem);
+		if (!elem->stor->bitfield) {
+			pch_wr_u8(save->wr, pch_rei_plain);
+			pch_wr_str(save->wr, elem->ident);
+			pch_wr_str(save->wr, elem->stor->irident);
+			pch_cgsave_cgtype(save, elem->cgtype);
+		} else {
+			pch_wr_u8(save->wr, pch_rei_bitfield);
+			pch_wr_str(save->wr, elem->ident);
+			pch_wr_u8(save->wr, elem->width);
+			pch_wr_u8(save->wr, elem->bitpos);
+			pch_cgsave_cgtype(save, elem->cgtype);
+
+			if (next == NULL || next->stor != elem->stor) {
+				pch_wr_u8(save->wr, pch_rei_stor);
+				pch_wr_str(save->wr, elem->stor->irident);
+				pch_cgsave_cgtype(save, elem->stor->cgtype);
+			}
+		}
+
+		elem = next;
+	}
+}
+
+/** Save scope member.
+ *
+ * @param save Code generator state saving
+ * @param member Scope member
+ */
+static void pch_cgsave_member(pch_cgsave_t *save, scope_member_t *member)
+{
+	cgen_enum_elem_t *eelem;
+	uint32_t idx;
+
+	pch_wr_u8(save->wr, (uint8_t)member->mtype);
+	pch_wr_u8(save->wr, member->used ? 1 : 0);
+
+	switch (member->mtype) {
+	case sm_gsym:
+		pch_wr_u32(save->wr, pch_cgsave_sym_idx(save,
+		    member->m.gsym.symbol));
+		pch_cgsave_cgtype(save, member->cgtype);
+		break;
+	case sm_tdef:
+		pch_cgsave_tok(save, member->tident);
+		pch_cgsave_cgtype(save, member->cgtype);
+		break;
+	case sm_record:
+		pch_cgsave_tok(save, member->tident);
+		pch_wr_u8(save->wr, (uint8_t)member->m.record.srtype);
+		pch_wr_u32(save->wr, pch_cgsave_record_idx(save,
+		    member->m.record.record));
+		break;
+	case sm_enum:
+		pch_cgsave_tok(save, member->tident);
+		pch_wr_u32(save->wr, pch_cgsave_enum_idx(save,
+		    member->m.menum.cgenum));
+		break;
+	case sm_eelem:
+		pch_cgsave_tok(save, member->tident);
+		pch_wr_u32(save->wr, pch_cgsave_enum_idx(save,
+		    member->m.eelem.eelem->cgenum));
+
+		idx = 0;
+		eelem = cgen_enum_first(member->m.eelem.eelem->cgenum);
+		while (eelem != member->m.eelem.eelem) {
+			++idx;
+			eelem = cgen_enum_next(eelem);
+		}
+
+		pch_wr_u32(save->wr, idx);
+		pch_cgsave_cgtype(save, member->cgtype);
+		break;
+	case sm_arg:
+	case sm_lvar:
+		/* Cannot occur in module scope */
+		assert(false);
+		break;
+	}
+}
+
+/** Collect records, enums and symbols to save.
+ *
+ * Records with an IR definition come first, in the order of their
+ * IR definitions.
+ *
+ * @param save Code generator state saving
+ * @param cgen Code generator
+ * @param symbols Symbols
+ * @param irmod IR module
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int pch_cgsave_collect(pch_cgsave_t *save, cgen_t *cgen,
+    symbols_t *symbols, ir_module_t *irmod)
+{
+	cgen_record_t *record;
+	cgen_enum_t *cgenum;
+	symbol_t *symbol;
+	ir_decln_t *decln;
+	size_t n;
+
+	n = 0;
+	record = cgen_records_first(cgen->records);
+	while (record != NULL) {
+		++n;
+		record = cgen_records_next(record);
+	}
+
+	if (n > 0) {
+		save->records = calloc(n, sizeof(cgen_record_t *));
+		if (save->records == NULL)
+			return ENOMEM;
+	}
+
+	decln = ir_module_first(irmod);
+	while (decln != NULL) {
+		if (decln->dtype == ird_record) {
+			record = cgen_records_first(cgen->records);
+			while (record != NULL) {
+				if (record->irrecord == (ir_record_t *)decln->ext)
+					save->records[save->nrecords++] = record;
+				record = cgen_records_next(record);
+			}
+		}
+
+		decln = ir_module_next(decln);
+	}
+
+	record = cgen_records_first(cgen->records);
+	while (record != NULL) {
+		if (record->irrecord == NULL)
+			save->records[save->nrecords++] = record;
+		record = cgen_records_next(record);
+	}
+
+	assert(save->nrecords == n);
+
+	n = 0;
+	cgenum = cgen_enums_first(cgen->enums);
+	while (cgenum != NULL) {
+		++n;
+		cgenum = cgen_enums_next(cgenum);
+	}
+
+	if (n > 0) {
+		save->enums = calloc(n, sizeof(cgen_enum_t *));
+		if (save->enums == NULL)
+			return ENOMEM;
+	}
+
+	cgenum = cgen_enums_first(cgen->enums);
+	while (cgenum != NULL) {
+		save->enums[save->nenums++] = cgenum;
+		cgenum = cgen_enums_next(cgenum);
+	}
+
+	n = 0;
+	symbol = symbols_first(symbols);
+	while (symbol != NULL) {
+		++n;
+		symbol = symbols_next(symbol);
+	}
+
+	if (n > 0) {
+		save->syms = calloc(n, sizeof(symbol_t *));
+		if (save->syms == NULL)
+			return ENOMEM;
+	}
+
+	symbol = symbols_first(symbols);
+	while (symbol != NULL) {
+		save->syms[save->nsyms++] = symbol;
+		symbol = symbols_next(symbol);
+	}
+
+	return EOK;
+}
+
+/** Save code generator state to precompiled header.
+ *
+ * Only declarations can be precompiled. If the header contains
+ * any definitions of functions or variables, an error is reported.
+ *
+ * @param pch Precompiled header
+ * @param cgen Code generator that processed the header
+ * @param symbols Module symbols
+ * @param irmod IR module generated from the header
+ * @return EOK on success, EINVAL if the header cannot be precompiled,
+ *         ENOMEM if out of memory
+ */
+int pch_save_cgen(pch_t *pch, cgen_t *cgen, symbols_t *symbols,
+    ir_module_t *irmod)
+{
+	pch_cgsave_t save;
+	cgen_record_t *record;
+	cgen_enum_t *cgenum;
+	cgen_enum_elem_t *eelem;
+	symbol_t *symbol;
+	scope_member_t *member;
+	size_t i;
+	int rc;
+
+	memset(&save, 0, sizeof(save));
+	save.wr = &pch->cgwr;
+
+	symbol = symbols_first(symbols);
+	while (symbol != NULL) {
+		if (symbol->stype != st_type &&
+		    (symbol->flags & sf_defined) != sf_none) {
+			if (symbol->ident != NULL) {
+				(void)lexer_dprint_tok(&symbol->ident->tok,
+				    stderr);
+				(void)fprintf(stderr, ": Definition of '%s' "
+				    "cannot be precompiled.\n",
+				    symbol->ident->tok.text);
+			} else {
+				(void)fprintf(stderr, "Definitions cannot "
+				    "be precompiled.\n");
+			}
+
+			rc = EINVAL;
+			goto error;
+		}
+
+		symbol = symbols_next(symbol);
+	}
+
+	rc = pch_cgsave_collect(&save, cgen, symbols, irmod);
+	if (rc != EOK)
+		goto error;
+
+	pch_wr_u32(save.wr, cgen->anon_tag_cnt);
+	pch_wr_u32(save.wr, cgen->str_cnt);
+	pch_wr_u32(save.wr, cgen->callsign_cnt);
+
+	pch_wr_u32(save.wr, (uint32_t)save.nrecords);
+	for (i = 0; i < save.nrecords; i++) {
+		record = save.records[i];
+		pch_wr_u8(save.wr, (uint8_t)record->rtype);
+		pch_wr_u8(save.wr, record->packed ? 1 : 0);
+		pch_wr_optstr(save.wr, record->cident);
+		pch_wr_str(save.wr, record->irident);
+		pch_wr_u8(save.wr, record->irrecord != NULL ? 1 : 0);
+		pch_wr_u8(save.wr, record->declared ? 1 : 0);
+	}
+
+	pch_wr_u32(save.wr, (uint32_t)save.nenums);
+	for (i = 0; i < save.nenums; i++) {
+		cgenum = save.enums[i];
+		pch_wr_optstr(save.wr, cgenum->cident);
+		pch_wr_u8(save.wr, cgenum->defined ? 1 : 0);
+		pch_wr_u8(save.wr, cgenum->named ? 1 : 0);
+		pch_wr_u64(save.wr, (uint64_t)cgenum->next_value);
+		pch_wr_u32(save.wr, (uint32_t)list_count(&cgenum->elems));
+
+		eelem = cgen_enum_first(cgenum);
+		while (eelem != NULL) {
+			pch_wr_str(save.wr, eelem->ident);
+			pch_wr_u64(save.wr, (uint64_t)eelem->value);
+			eelem = cgen_enum_next(eelem);
+		}
+	}
+
+	for (i = 0; i < save.nrecords; i++)
+		pch_cgsave_record_elems(&save, save.records[i]);
+
+	pch_wr_u32(save.wr, (uint32_t)save.nsyms);
+	for (i = 0; i < save.nsyms; i++) {
+		symbol = save.syms[i];
+		pch_wr_u8(save.wr, symbol->ident != NULL ? 1 : 0);
+		if (symbol->ident != NULL)
+			pch_cgsave_tok(&save, &symbol->ident->tok);
+		pch_wr_str(save.wr, symbol->irident);
+		pch_wr_u8(save.wr, (uint8_t)symbol->stype);
+		pch_wr_u8(save.wr, (uint8_t)symbol->flags);
+		pch_wr_u8(save.wr, symbol->cgtype != NULL ? 1 : 0);
+		if (symbol->cgtype != NULL)
+			pch_cgsave_cgtype(&save, symbol->cgtype);
+	}
+
+	pch_wr_u32(save.wr, (uint32_t)list_count(&cgen->scope->members));
+	member = scope_first(cgen->scope);
+	while (member != NULL) {
+		pch_cgsave_member(&save, member);
+		member = scope_next(member);
+	}
+
+	if (save.wr->error) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	rc = EOK;
+error:
+	if (save.records != NULL)
+		free(save.records);
+	if (save.enums != NULL)
+		free(save.enums);
+	if (save.syms != NULL)
+		free(save.syms);
+	return rc;
+}
+
+/** Load code generator type.
+ *
+ * @param load Code generator state loading
+ * @param rcgtype Place to store pointer to new code generator type
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_cgtype(pch_cgload_t *load, cgtype_t **rcgtype)
+{
+	pch_rd_t *rd = &load->rd;
+	cgtype_t *cgtype = NULL;
+	cgtype_t *stype = NULL;
+	cgtype_t *itype = NULL;
+	cgtype_basic_t *basic;
+	cgtype_func_t *func;
+	cgtype_pointer_t *pointer;
+	cgtype_record_t *record;
+	cgtype_enum_t *cgenum;
+	cgtype_array_t *array;
+	uint8_t ntype;
+	uint8_t qual;
+	uint8_t elmtype;
+	uint32_t nargs;
+	uint32_t idx;
+	uint32_t i;
+	bool have_size;
+	uint64_t asize;
+	int rc;
+
+	ntype = pch_rd_u8(rd);
+	qual = pch_rd_u8(rd);
+	if (rd->error)
+		return EINVAL;
+
+	switch ((cgtype_ntype_t)ntype) {
+	case cgn_basic:
+		elmtype = pch_rd_u8(rd);
+		if (rd->error || elmtype > (uint8_t)cgelm_va_list)
+			return EINVAL;
+
+		rc = cgtype_basic_create((cgtype_elmtype_t)elmtype, &basic);
+		if (rc != EOK)
+			return rc;
+
+		cgtype = &basic->cgtype;
+		break;
+	case cgn_func:
+		rc = pch_cgload_cgtype(load, &stype);
+		if (rc != EOK)
+			return rc;
+
+		rc = cgtype_func_create(stype, &func);
+		if (rc != EOK) {
+			cgtype_destroy(stype);
+			return rc;
+		}
+
+		cgtype = &func->cgtype;
+		func->variadic = pch_rd_u8(rd) != 0;
+		func->cconv = (cgtype_cconv_t)pch_rd_u8(rd);
+		func->may_ignore_return = pch_rd_u8(rd) != 0;
+		if (func->cconv != cgcc_default && func->cconv != cgcc_usr) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		nargs = pch_rd_u32(rd);
+		for (i = 0; i < nargs; i++) {
+			rc = pch_cgload_cgtype(load, &stype);
+			if (rc != EOK)
+				goto error;
+
+			rc = cgtype_func_append_arg(func, stype);
+			if (rc != EOK) {
+				cgtype_destroy(stype);
+				goto error;
+			}
+		}
+		break;
+	case cgn_pointer:
+		rc = pch_cgload_cgtype(load, &stype);
+		if (rc != EOK)
+			return rc;
+
+		rc = cgtype_pointer_create(stype, &pointer);
+		if (rc != EOK) {
+			cgtype_destroy(stype);
+			return rc;
+		}
+
+		cgtype = &pointer->cgtype;
+		break;
+	case cgn_record:
+		idx = pch_rd_u32(rd);
+		if (rd->error || idx >= load->nrecords)
+			return EINVAL;
+
+		rc = cgtype_record_create(load->records[(size_t)idx], &record);
+		if (rc != EOK)
+			return rc;
+
+		cgtype = &record->cgtype;
+		break;
+	case cgn_enum:
+		idx = pch_rd_u32(rd);
+		if (rd->error || idx >= load->nenums)
+			return EINVAL;
+
+		rc = cgtype_enum_create(load->enums[(size_t)idx], &cgenum);
+		if (rc != EOK)
+			return rc;
+
+		cgtype = &cgenum->cgtype;
+		break;
+	case cgn_array:
+		rc = pch_cgload_cgtype(load, &stype);
+		if (rc != EOK)
+			return rc;
+
+		if (pch_rd_u8(rd) != 0) {
+			rc = pch_cgload_cgtype(load, &itype);
+			if (rc != EOK) {
+				cgtype_destroy(stype);
+				return rc;
+			}
+		}
+
+		have_size = pch_rd_u8(rd) != 0;
+		asize = pch_rd_u64(rd);
+
+		rc = cgtype_array_create(stype, itype, have_size, asize,
+		    &array);
+		if (rc != EOK) {
+			cgtype_destroy(stype);
+			cgtype_destroy(itype);
+			return rc;
+		}
+
+		cgtype = &array->cgtype;
+		break;
+	default:
+		return EINVAL;
+	}
+
+	if (rd->error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	cgtype->qual = (cgtype_qual_t)qual;
+	*rcgtype = cgtype;
+	return EOK;
+error:
+	cgtype_destroy(cgtype);
+	return rc;
+}
+
+/** Load identifier token.
+ *
+ * The token is allocated from the module arena.
+ *
+ * @param load Code generator state loading
+ * @param rtok Place to store pointer to new token
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_tok(pch_cgload_t *load, comp_tok_t **rtok)
+{
+	comp_module_t *module = load->module;
+	comp_tok_t *ctok;
+	uint32_t ttype;
+	const char *text;
+	char *itext;
+	size_t len;
+	int rc;
+
+	ctok = arena_zalloc(module->arena, sizeof(comp_tok_t));
+	if (ctok == NULL)
+		return ENOMEM;
+
+	ttype = pch_rd_u32(&load->rd);
+	text = pch_rd_str(&load->rd);
+	rc = pch_rd_pos(&load->rd, &ctok->tok.bpos);
+	if (rc != EOK)
+		return rc;
+
+	rc = pch_rd_pos(&load->rd, &ctok->tok.epos);
+	if (rc != EOK)
+		return rc;
+
+	if (load->rd.error || ttype >= (uint32_t)ltt_error)
+		return EINVAL;
+
+	ctok->tok.ttype = (lexer_toktype_t)ttype;
+	len = strlen(text);
+
+	if (ctok->tok.ttype == ltt_ident || lexer_is_resword(ctok->tok.ttype)) {
+		rc = strtab_intern(module->strtab, text, len, &itext);
+		if (rc != EOK)
+			return rc;
+	} else {
+		itext = arena_strndup(module->arena, text, len);
+		if (itext == NULL)
+			return ENOMEM;
+	}
+
+	ctok->mod = module;
+	ctok->tok.text = itext;
+	ctok->tok.text_size = len;
+	*rtok = ctok;
+	return EOK;
+}
+
+/** Check that a count read from precompiled header is plausible.
+ *
+ * Each item takes at least one byte, so there cannot be more items
+ * than there are remaining bytes.
+ *
+ * @param rd Reader
+ * @param n Count
+ * @return @c true iff count is plausible
+ */
+static bool pch_rd_count_valid(pch_rd_t *rd, uint32_t n)
+{
+	return !rd->error && n <= (uint32_t)(rd->size - rd->pos);
+}
+
+/** Load records (without their elements).
+ *
+ * @param load Code generator state loading
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_records(pch_cgload_t *load)
+{
+	pch_rd_t *rd = &load->rd;
+	cgen_record_t *record;
+	ir_record_t *irrecord;
+	ir_record_type_t irrtype;
+	const char *cident;
+	const char *irident;
+	uint32_t n;
+	uint32_t i;
+	uint8_t rtype;
+	bool packed;
+	bool has_ir;
+	bool declared;
+	int rc;
+
+	n = pch_rd_u32(rd);
+	if (!pch_rd_count_valid(rd, n))
+		return EINVAL;
+
+	if (n > 0) {
+		load->records = calloc((size_t)n, sizeof(cgen_record_t *));
+		if (load->records == NULL)
+			return ENOMEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		rtype = pch_rd_u8(rd);
+		packed = pch_rd_u8(rd) != 0;
+		cident = pch_rd_optstr(rd);
+		irident = pch_rd_str(rd);
+		has_ir = pch_rd_u8(rd) != 0;
+		declared = pch_rd_u8(rd) != 0;
+		if (rd->error || rtype > (uint8_t)cgr_union)
+			return EINVAL;
+
+		irrecord = NULL;
+		if (has_ir) {
+			if (rtype == (uint8_t)cgr_struct)
+				irrtype = irrt_struct;
+			else
+				irrtype = irrt_union;
+
+			rc = ir_record_create(irident, irrtype, &irrecord);
+			if (rc != EOK)
+				return rc;
+		}
+
+		rc = cgen_record_create(load->cgen->records,
+		    (cgen_rec_type_t)rtype, cident, packed, irident, irrecord,
+		    &record);
+		if (rc != EOK) {
+			ir_record_destroy(irrecord);
+			return rc;
+		}
+
+		record->declared = declared;
+		load->records[load->nrecords++] = record;
+	}
+
+	return EOK;
+}
+
+/** Load enums.
+ *
+ * @param load Code generator state loading
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_enums(pch_cgload_t *load)
+{
+	pch_rd_t *rd = &load->rd;
+	cgen_enum_t *cgenum;
+	const char *ident;
+	uint32_t n;
+	uint32_t nelems;
+	uint32_t i;
+	uint32_t j;
+	int64_t value;
+	int rc;
+
+	n = pch_rd_u32(rd);
+	if (!pch_rd_count_valid(rd, n))
+		return EINVAL;
+
+	if (n > 0) {
+		load->enums = calloc((size_t)n, sizeof(cgen_enum_t *));
+		if (load->enums == NULL)
+			return ENOMEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		ident = pch_rd_optstr(rd);
+		if (rd->error)
+			return EINVAL;
+
+		rc = cgen_enum_create(load->cgen->enums, ident, &cgenum);
+		if (rc != EOK)
+			return rc;
+
+		load->enums[load->nenums++] = cgenum;
+
+		cgenum->defined = pch_rd_u8(rd) != 0;
+		cgenum->named = pch_rd_u8(rd) != 0;
+		cgenum->next_value = (int64_t)pch_rd_u64(rd);
+
+		nelems = pch_rd_u32(rd);
+		if (!pch_rd_count_valid(rd, nelems))
+			return EINVAL;
+
+		for (j = 0; j < nelems; j++) {
+			ident = pch_rd_str(rd);
+			value = (int64_t)pch_rd_u64(rd);
+			if (rd->error)
+				return EINVAL;
+
+			rc = cgen_enum_append(cgenum, ident, value, NULL);
+			if (rc == EEXIST)
+				return EINVAL;
+			if (rc != EOK)
+				return rc;
+		}
+	}
+
+	return EOK;
+}
+
+/** Load record elements.
+ *
+ * @param load Code generator state loading
+ * @param record Record
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_record_elems(pch_cgload_t *load, cgen_record_t *record)
+{
+	pch_rd_t *rd = &load->rd;
+	cgen_rec_elem_t *elem;
+	cgen_rec_stor_t *stor;
+	cgtype_t *cgtype;
+	const char *ident;
+	const char *irident;
+	uint32_t nitems;
+	uint32_t i;
+	uint8_t kind;
+	uint8_t width;
+	uint8_t bitpos;
+	int rc;
+
+	nitems = pch_rd_u32(rd);
+	if (!pch_rd_count_valid(rd, nitems))
+		return EINVAL;
+
+	for (i = 0; i < nitems; i++) {
+		kind = pch_rd_u8(rd);
+		switch (kind) {
+		case pch_rei_plain:
+			ident = pch_rd_str(rd);
+			irident = pch_rd_str(rd);
+			rc = pch_cgload_cgtype(load, &cgtype);
+			if (rc != EOK)
+				return rc;
+
+			rc = cgen_record_append(record, ident, 0, 0, cgtype,
+			    irident);
+			cgtype_destroy(cgtype);
+			break;
+		case pch_rei_bitfield:
+			ident = pch_rd_str(rd);
+			width = pch_rd_u8(rd);
+			bitpos = pch_rd_u8(rd);
+			if (width == 0 || (unsigned)width + bitpos > pch_max_bits)
+				return EINVAL;
+
+			rc = pch_cgload_cgtype(load, &cgtype);
+			if (rc != EOK)
+				return rc;
+
+			rc = cgen_record_append(record, ident, width, bitpos,
+			    cgtype, NULL);
+			cgtype_destroy(cgtype);
+			break;
+		case pch_rei_stor:
+			irident = pch_rd_str(rd);
+			rc = pch_cgload_cgtype(load, &cgtype);
+			if (rc != EOK)
+				return rc;
+
+			rc = cgen_record_append_stor(record, cgtype, irident,
+			    &stor);
+			cgtype_destroy(cgtype);
+			if (rc != EOK)
+				break;
+
+			/* Patch all elements without storage unit to this one. */
+			elem = cgen_record_last_elem(record);
+			while (elem != NULL && elem->stor == NULL) {
+				elem->stor = stor;
+				list_prepend(&elem->lstor_elems, &stor->elems);
+				elem = cgen_record_prev_elem(elem);
+			}
+			break;
+		default:
+			return EINVAL;
+		}
+
+		if (rc == EEXIST)
+			return EINVAL;
+		if (rc != EOK)
+			return rc;
+	}
+
+	if (rd->error)
+		return EINVAL;
+
+	/* Every element must have a storage unit */
+	elem = cgen_record_last_elem(record);
+	if (elem != NULL && elem->stor == NULL)
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Load symbols.
+ *
+ * @param load Code generator state loading
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_syms(pch_cgload_t *load)
+{
+	pch_rd_t *rd = &load->rd;
+	symbol_t *symbol;
+	comp_tok_t *ident;
+	const char *irident;
+	uint32_t n;
+	uint32_t i;
+	uint8_t stype;
+	uint8_t flags;
+	int rc;
+
+	n = pch_rd_u32(rd);
+	if (!pch_rd_count_valid(rd, n))
+		return EINVAL;
+
+	if (n > 0) {
+		load->syms = calloc((size_t)n, sizeof(symbol_t *));
+		if (load->syms == NULL)
+			return ENOMEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		ident = NULL;
+		if (pch_rd_u8(rd) != 0) {
+			rc = pch_cgload_tok(load, &ident);
+			if (rc != EOK)
+				return rc;
+		}
+
+		irident = pch_rd_str(rd);
+		stype = pch_rd_u8(rd);
+		flags = pch_rd_u8(rd);
+		if (rd->error || stype > (uint8_t)st_type)
+			return EINVAL;
+
+		rc = symbols_insert(load->module->symbols,
+		    (symbol_type_t)stype, ident, irident, &symbol);
+		if (rc == EEXIST)
+			return EINVAL;
+		if (rc != EOK)
+			return rc;
+
+		load->syms[load->nsyms++] = symbol;
+		symbol->flags = (symbol_flags_t)flags;
+
+		if (pch_rd_u8(rd) != 0) {
+			rc = pch_cgload_cgtype(load, &symbol->cgtype);
+			if (rc != EOK)
+				return rc;
+		}
+	}
+
+	return EOK;
+}
+
+/** Load module scope member.
+ *
+ * @param load Code generator state loading
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int pch_cgload_member(pch_cgload_t *load)
+{
+	pch_rd_t *rd = &load->rd;
+	scope_t *scope = load->cgen->scope;
+	scope_member_t *member = NULL;
+	comp_tok_t *ident = NULL;
+	symbol_t *symbol;
+	cgtype_t *cgtype = NULL;
+	cgen_enum_elem_t *eelem;
+	uint8_t mtype;
+	uint8_t srtype;
+	uint32_t idx;
+	uint32_t eidx;
+	bool used;
+	int rc;
+
+	mtype = pch_rd_u8(rd);
+	used = pch_rd_u8(rd) != 0;
+	if (rd->error)
+		return EINVAL;
+
+	switch ((scope_member_type_t)mtype) {
+	case sm_gsym:
+		idx = pch_rd_u32(rd);
+		if (rd->error || idx >= load->nsyms)
+			return EINVAL;
+
+		symbol = load->syms[(size_t)idx];
+		if (symbol->ident == NULL)
+			return EINVAL;
+
+		rc = pch_cgload_cgtype(load, &cgtype);
+		if (rc != EOK)
+			return rc;
+
+		rc = scope_insert_gsym(scope, &symbol->ident->tok, cgtype,
+		    symbol);
+		cgtype_destroy(cgtype);
+		if (rc == EOK) {
+			member = scope_lookup_local(scope,
+			    symbol->ident->tok.text);
+		}
+		break;
+	case sm_tdef:
+		rc = pch_cgload_tok(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		rc = pch_cgload_cgtype(load, &cgtype);
+		if (rc != EOK)
+			return rc;
+
+		rc = scope_insert_tdef(scope, &ident->tok, cgtype);
+		cgtype_destroy(cgtype);
+		if (rc == EOK)
+			member = scope_lookup_local(scope, ident->tok.text);
+		break;
+	case sm_record:
+		rc = pch_cgload_tok(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		srtype = pch_rd_u8(rd);
+		idx = pch_rd_u32(rd);
+		if (rd->error || srtype > (uint8_t)sr_union || idx >= load->nrecords)
+			return EINVAL;
+
+		rc = scope_insert_record(scope, &ident->tok,
+		    (scope_rec_type_t)srtype, load->records[(size_t)idx], &member);
+		break;
+	case sm_enum:
+		rc = pch_cgload_tok(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		idx = pch_rd_u32(rd);
+		if (rd->error || idx >= load->nenums)
+			return EINVAL;
+
+		rc = scope_insert_enum(scope, &ident->tok, load->enums[(size_t)idx],
+		    &member);
+		break;
+	case sm_eelem:
+		rc = pch_cgload_tok(load, &ident);
+		if (rc != EOK)
+			return rc;
+
+		idx = pch_rd_u32(rd);
+		eidx = pch_rd_u32(rd);
+		if (rd->error || idx >= load->nenums)
+			return EINVAL;
+
+		eelem = cgen_enum_first(load->enums[(size_t)idx]);
+		while (eelem != NULL && eidx > 0) {
+			--eidx;
+			eelem = cgen_enum_next(eelem);
+		}
+
+		if (eelem == NULL)
+			return EINVAL;
+
+		rc = pch_cgload_cgtype(load, &cgtype);
+		if (rc != EOK)
+			return rc;
+
+		rc = scope_insert_eelem(scope, &ident->tok, eelem, cgtype,
+		    &member);
+		if (rc != EOK)
+			cgtype_destroy(cgtype);
+		break;
+	default:
+		return EINVAL;
+	}
+
+	if (rc == EEXIST)
+		return EINVAL;
+	if (rc != EOK)
+		return rc;
+
+	assert(member != NULL);
+	member->used = used;
+	return EOK;
+}
+
+/** Load code generator state from precompiled header.
+ *
+ * Restores records, enums, module symbols and module scope members
+ * saved in the precompiled header. Records that have a definition
+ * get an (empty) IR record, which is filled in and added to the IR
+ * module by the code generator.
+ *
+ * @param pch Precompiled header
+ * @param module Compiler module
+ * @param cgen Code generator (that has not processed anything yet)
+ * @return EOK on success, EINVAL if precompiled header is corrupted,
+ *         ENOMEM if out of memory
+ */
+int pch_load_cgen(pch_t *pch, comp_module_t *module, cgen_t *cgen)
+{
+	pch_cgload_t load;
+	uint32_t nmembers;
+	uint32_t i;
+	size_t j;
+	int rc;
+
+	memset(&load, 0, sizeof(load));
+	load.rd.data = pch->data + pch->cg_off;
+	load.rd.size = pch->cg_size;
+	load.module = module;
+	load.cgen = cgen;
+
+	cgen->anon_tag_cnt = (unsigned)pch_rd_u32(&load.rd);
+	cgen->str_cnt = (unsigned)pch_rd_u32(&load.rd);
+	cgen->callsign_cnt = (unsigned)pch_rd_u32(&load.rd);
+
+	rc = pch_cgload_records(&load);
+	if (rc != EOK)
+		goto error;
+
+	rc = pch_cgload_enums(&load);
+	if (rc != EOK)
+		goto error;
+
+	for (j = 0; j < load.nrecords; j++) {
+		rc = pch_cgload_record_elems(&load, load.records[j]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = pch_cgload_syms(&load);
+	if (rc != EOK)
+		goto error;
+
+	nmembers = pch_rd_u32(&load.rd);
+	if (!pch_rd_count_valid(&load.rd, nmembers)) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	for (i = 0; i < nmembers; i++) {
+		rc = pch_cgload_member(&load);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (load.rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (load.records != NULL)
+		free(load.records);
+	if (load.enums != NULL)
+		free(load.enums);
+	if (load.syms != NULL)
+		free(load.syms);
+	return EOK;
+error:
+	if (rc == EINVAL)
+		(void)fprintf(stderr, "Precompiled header is corrupted.\n");
+
+	/* IR records have not been added to any IR module yet */
+	for (j = 0; j < load.nrecords; j++) {
+		ir_record_destroy(load.records[j]->irrecord);
+		load.records[j]->irrecord = NULL;
+	}
+
+	if (load.records != NULL)
+		free(load.records);
+	if (load.enums != NULL)
+		free(load.enums);
+	if (load.syms != NULL)
+		free(load.syms);
+	return rc;
+}
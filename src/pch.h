@@ -0,0 +1,66 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Precompiled headers
+ */
+
+#ifndef PCH_H
+#define PCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <types/cgen.h>
+#include <types/comp.h>
+#include <types/ir.h>
+#include <types/pch.h>
+#include <types/src_pos.h>
+#include <types/symbols.h>
+
+extern int pch_create(const char *, cgen_flags_t, pch_t **);
+extern int pch_load(const char *, cgen_flags_t, pch_t **);
+extern int pch_load_any(const char *, pch_t **);
+extern bool pch_is_current(pch_t *, const char *, cgen_flags_t);
+extern void pch_destroy(pch_t *);
+extern const char *pch_hdr_path(pch_t *);
+extern uint32_t pch_hash(pch_t *);
+extern int pch_add_dep(pch_t *, const char *);
+extern int pch_save(pch_t *, FILE *);
+extern int pch_save_cgen(pch_t *, cgen_t *, symbols_t *, ir_module_t *);
+extern int pch_load_cgen(pch_t *, comp_module_t *, cgen_t *);
+extern pch_wr_t *pch_pp_writer(pch_t *);
+extern void pch_pp_reader(pch_t *, pch_rd_t *);
+extern void pch_wr_u8(pch_wr_t *, uint8_t);
+extern void pch_wr_u32(pch_wr_t *, uint32_t);
+extern void pch_wr_u64(pch_wr_t *, uint64_t);
+extern void pch_wr_str(pch_wr_t *, const char *);
+extern void pch_wr_optstr(pch_wr_t *, const char *);
+extern void pch_wr_pos(pch_wr_t *, src_pos_t *);
+extern uint8_t pch_rd_u8(pch_rd_t *);
+extern uint32_t pch_rd_u32(pch_rd_t *);
+extern uint64_t pch_rd_u64(pch_rd_t *);
+extern const char *pch_rd_str(pch_rd_t *);
+extern const char *pch_rd_optstr(pch_rd_t *);
+extern int pch_rd_pos(pch_rd_t *, src_pos_t *);
+
+#endif
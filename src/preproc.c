@@ -25,14 +25,17 @@
  */
 
 #include <adt/list.h>
+#include <arena.h>
 #include <assert.h>
 #include <charcls.h>
 #include <file_input.h>
 #include <lexer.h>
 #include <pathname.h>
+#include <pch.h>
 #include <preproc.h>
 #include <merrno.h>
 #include <src_pos.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -49,18 +52,73 @@ static preproc_condition_t *preproc_push_condition(preproc_t *,
     src_pos_t *, src_pos_t *, bool);
 static preproc_condition_t *preproc_top_condition(preproc_t *);
 static void preproc_pop_condition(preproc_t *);
-static preproc_macro_t *preproc_macro_first(preproc_t *);
-static void preproc_macro_remove(preproc_macro_t *);
 static preproc_macro_t *preproc_macro_find(preproc_t *, const char *);
+static void preproc_macro_destroy(preproc_macro_t *);
+static int preproc_predefine(preproc_t *, const char *);
 static int preproc_skip_to_end_of_line(preproc_t *);
 static int preproc_dump_to_end_of_line(preproc_t *, FILE *);
+static int preproc_expand(preproc_t *, list_t *, list_t *, bool);
 
 enum {
 	/** Size of preprocessor file name buffer. */
 	preproc_fname_buf_size = 512,
 
 	/** Size of macro name buffer. */
-	preproc_macro_name_buf_size = 128
+	preproc_macro_name_buf_size = 128,
+
+	/** Initial size of growable character buffers */
+	preproc_cbuf_init_size = 256
+};
+
+/** Punctuators (longer ones first so that the first match is the longest) */
+static const char *preproc_puncts[] = {
+	"%:%:", "...", "<<=", ">>=", "->", "++", "--", "<<", ">>", "<=",
+	">=", "==", "!=", "&&", "||", "*=", "/=", "%=", "+=", "-=", "&=",
+	"^=", "|=", "##", "<:", ":>", "<%", "%>", "%:", "[", "]", "(", ")",
+	"{", "}", ".", "&", "*", "+", "-", "~", "!", "/", "%", "<", ">",
+	"^", "|", "?", ":", ";", "=", ",", "#"
+};
+
+/** Predefined macros.
+ *
+ * The date and time of translation are not available (and would make
+ * the output depend on the time of compilation), so fixed values are
+ * supplied as the standard allows.
+ */
+static const char *preproc_predefs[] = {
+	"__STDC__ 1",
+	"__STDC_HOSTED__ 1",
+	"__STDC_VERSION__ 199901L",
+	"__DATE__ \"Jan  1 1970\"",
+	"__TIME__ \"00:00:00\"",
+	"__SYC__ 1"
+};
+
+/** Binary operators in preprocessor expressions */
+static struct {
+	/** Operator */
+	const char *op;
+	/** Precedence (higher binds tighter) */
+	int prec;
+} preproc_binops[] = {
+	{ "||", 1 },
+	{ "&&", 2 },
+	{ "|", 3 },
+	{ "^", 4 },
+	{ "&", 5 },
+	{ "==", 6 },
+	{ "!=", 6 },
+	{ "<", 7 },
+	{ ">", 7 },
+	{ "<=", 7 },
+	{ ">=", 7 },
+	{ "<<", 8 },
+	{ ">>", 8 },
+	{ "+", 9 },
+	{ "-", 9 },
+	{ "*", 10 },
+	{ "/", 10 },
+	{ "%", 10 }
 };
 
 /** Create preprocessor.
@@ -76,6 +134,8 @@ int preproc_create(const char *fname, lexer_input_ops_t *input_ops,
     void *input_arg, preproc_t **rpreproc)
 {
 	preproc_t *preproc = NULL;
+	preproc_macro_t *macro;
+	size_t i;
 	int rc;
 
 	preproc = calloc(1, sizeof(preproc_t));
@@ -86,13 +146,39 @@ int preproc_create(const char *fname, lexer_input_ops_t *input_ops,
 
 	list_initialize(&preproc->inputs);
 	list_initialize(&preproc->conditions);
-	list_initialize(&preproc->macros);
+	list_initialize(&preproc->incldirs);
+	for (i = 0; i < preproc_macro_buckets; i++)
+		list_initialize(&preproc->macros[i]);
+	for (i = 0; i < preproc_hdr_buckets; i++)
+		list_initialize(&preproc->hdrs[i]);
+
+	rc = arena_create(&preproc->marena);
+	if (rc != EOK)
+		goto error;
 
 	rc = preproc_push_input(preproc, fname, NULL, NULL, input_ops,
 	    input_arg);
 	if (rc != EOK)
 		goto error;
 
+	for (i = 0; i < sizeof(preproc_predefs) / sizeof(char *); i++) {
+		rc = preproc_predefine(preproc, preproc_predefs[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = preproc_predefine(preproc, "__FILE__");
+	if (rc != EOK)
+		goto error;
+	macro = preproc_macro_find(preproc, "__FILE__");
+	macro->builtin = pmb_file;
+
+	rc = preproc_predefine(preproc, "__LINE__");
+	if (rc != EOK)
+		goto error;
+	macro = preproc_macro_find(preproc, "__LINE__");
+	macro->builtin = pmb_line;
+
 	preproc->state = pps_line_begin;
 
 	*rpreproc = preproc;
@@ -110,10 +196,17 @@ void preproc_destroy(preproc_t *preproc)
 {
 	preproc_condition_t *condition;
 	preproc_macro_t *macro;
+	preproc_hdr_t *hdr;
+	preproc_incldir_t *incldir;
+	link_t *link;
+	size_t i;
 
 	if (preproc == NULL)
 		return;
 
+	while (preproc->cur != NULL)
+		preproc_pop_input(preproc);
+
 	condition = preproc_top_condition(preproc);
 	while (condition != NULL) {
 		preproc_pop_condition(preproc);
@@ -121,18 +214,48 @@ void preproc_destroy(preproc_t *preproc)
 		condition = preproc_top_condition(preproc);
 	}
 
-	while (preproc->cur != NULL)
-		preproc_pop_input(preproc);
+	for (i = 0; i < preproc_macro_buckets; i++) {
+		link = list_first(&preproc->macros[i]);
+		while (link != NULL) {
+			macro = list_get_instance(link, preproc_macro_t,
+			    lmacros);
+			preproc_macro_destroy(macro);
+			link = list_first(&preproc->macros[i]);
+		}
+	}
+
+	for (i = 0; i < preproc_hdr_buckets; i++) {
+		link = list_first(&preproc->hdrs[i]);
+		while (link != NULL) {
+			hdr = list_get_instance(link, preproc_hdr_t, lhdrs);
+			list_remove(&hdr->lhdrs);
+			free(hdr->path);
+			if (hdr->guard != NULL)
+				free(hdr->guard);
+			free(hdr);
+			link = list_first(&preproc->hdrs[i]);
+		}
+	}
 
-	macro = preproc_macro_first(preproc);
-	while (macro != NULL) {
-		preproc_macro_remove(macro);
-		macro = preproc_macro_first(preproc);
+	link = list_first(&preproc->incldirs);
+	while (link != NULL) {
+		incldir = list_get_instance(link, preproc_incldir_t, lincldirs);
+		list_remove(&incldir->lincldirs);
+		free(incldir->dir);
+		free(incldir);
+		link = list_first(&preproc->incldirs);
 	}
 
 	if (preproc->incldir != NULL)
 		free(preproc->incldir);
 
+	arena_destroy(preproc->tarena);
+	arena_destroy(preproc->marena);
+	free(preproc->obuf);
+	free(preproc->oposbuf);
+	free(preproc->lbuf);
+	free(preproc->lposbuf);
+	free(preproc->sbuf);
 	free(preproc);
 }
 
@@ -156,7 +279,37 @@ int preproc_set_incldir(preproc_t *preproc, const char *dir)
 	return EOK;
 }
 
+/** Add include directory.
+ *
+ * Include directories are searched in the order in which they were
+ * added, after the directory of the including file (for quoted includes)
+ * and before the directory for standard headers.
+ *
+ * @param preproc Preprocessor
+ * @param dir Directory
+ * @return EOK on success or an error code
+ */
+int preproc_add_incldir(preproc_t *preproc, const char *dir)
+{
+	preproc_incldir_t *incldir;
+
+	incldir = calloc(1, sizeof(preproc_incldir_t));
+	if (incldir == NULL)
+		return ENOMEM;
+
+	incldir->dir = strdup(dir);
+	if (incldir->dir == NULL) {
+		free(incldir);
+		return ENOMEM;
+	}
+
+	list_append(&incldir->lincldirs, &preproc->incldirs);
+	return EOK;
+}
+
 /** Return innermost preprocessor condition directive.
+ *
+ * Only conditions opened in the current input file are considered.
  *
  * @param preproc Preprocessor
  * @return Topmost condition or @c NULL if there are none
@@ -165,6 +318,10 @@ static preproc_condition_t *preproc_top_condition(preproc_t *preproc)
 {
 	link_t *link;
 
+	if (preproc->cur != NULL &&
+	    preproc->nconditions <= preproc->cur->nconditions)
+		return NULL;
+
 	link = list_last(&preproc->conditions);
 	if (link == NULL)
 		return NULL;
@@ -203,6 +360,7 @@ static int preproc_push_input(preproc_t *preproc, const char *fname, FILE *file,
 	input->finput = finput;
 	input->input_ops = input_ops;
 	input->input_arg = input_arg;
+	input->nconditions = preproc->nconditions;
 	list_append(&input->linputs, &preproc->inputs);
 
 	preproc->cur = input;
@@ -224,6 +382,8 @@ static void preproc_pop_input(preproc_t *preproc)
 		(void)fclose(preproc->cur->in_file);
 	if (preproc->cur->in_fname != NULL)
 		free(preproc->cur->in_fname);
+	if (preproc->cur->mi_guard != NULL)
+		free(preproc->cur->mi_guard);
 	free(preproc->cur);
 
 	link = list_last(&preproc->inputs);
@@ -257,6 +417,7 @@ static preproc_condition_t *preproc_push_condition(preproc_t *preproc,
 	condition->bpos = *bpos;
 	condition->epos = *epos;
 	condition->was_skipping = was_skipping;
+	++preproc->nconditions;
 	return condition;
 }
 
@@ -270,16 +431,50 @@ static void preproc_pop_condition(preproc_t *preproc)
 
 	condition = preproc_top_condition(preproc);
 	list_remove(&condition->lconditions);
+	--preproc->nconditions;
 	free(condition);
 }
 
-/** Add new preprocessor macro.
+/** Compute hash of a string.
+ *
+ * @param str String
+ * @return Hash value
+ */
+static unsigned long preproc_str_hash(const char *str)
+{
+	unsigned long h;
+
+	h = 2166136261UL;
+	while (*str != '\0') {
+		h ^= (unsigned char)*str;
+		h = (h * 16777619UL) & 0xffffffffUL;
+		++str;
+	}
+
+	return h;
+}
+
+/** Compute macro hash table bucket.
+ *
+ * @param name Macro name
+ * @return Bucket index
+ */
+static size_t preproc_macro_hash(const char *name)
+{
+	return (size_t)(preproc_str_hash(name) % preproc_macro_buckets);
+}
+
+/** Create preprocessor macro.
+ *
+ * The macro is not inserted into the macro table.
  *
  * @param preproc Preprocessor
  * @param name Macro name
+ * @param rmacro Place to store pointer to new macro
  * @return EOK on success or an error code.
  */
-static int preproc_macro_add(preproc_t *preproc, const char *name)
+static int preproc_macro_create(preproc_t *preproc, const char *name,
+    preproc_macro_t **rmacro)
 {
 	preproc_macro_t *macro;
 
@@ -294,40 +489,68 @@ static int preproc_macro_add(preproc_t *preproc, const char *name)
 	}
 
 	macro->preproc = preproc;
-	list_append(&macro->lmacros, &preproc->macros);
+	list_initialize(&macro->body);
+	*rmacro = macro;
 	return EOK;
 }
 
-/** Return fist preprocessor macro.
+/** Add parameter to preprocessor macro.
  *
- * @param preproc Preprocessor
- * @return First macro or @c NULL if there are none
+ * @param macro Macro
+ * @param name Parameter name
+ * @return EOK on success or an error code.
  */
-static preproc_macro_t *preproc_macro_first(preproc_t *preproc)
+static int preproc_macro_add_param(preproc_macro_t *macro, const char *name)
 {
-	link_t *link;
+	char **nparams;
+	char *dname;
 
-	link = list_first(&preproc->macros);
-	if (link == NULL)
-		return NULL;
+	dname = strdup(name);
+	if (dname == NULL)
+		return ENOMEM;
+
+	nparams = realloc(macro->params, (macro->nparams + 1) *
+	    sizeof(char *));
+	if (nparams == NULL) {
+		free(dname);
+		return ENOMEM;
+	}
 
-	return list_get_instance(link, preproc_macro_t, lmacros);
+	macro->params = nparams;
+	macro->params[macro->nparams++] = dname;
+	return EOK;
 }
 
-/** Return next preprocessor macro.
+/** Find macro parameter by name.
  *
- * @param cur Current macro
- * @return First macro or @c NULL if @a cur was the last.
+ * @param macro Macro
+ * @param name Parameter name
+ * @param ridx Place to store parameter index
+ * @return @c true if found
  */
-static preproc_macro_t *preproc_macro_next(preproc_macro_t *cur)
+static bool preproc_macro_find_param(preproc_macro_t *macro, const char *name,
+    size_t *ridx)
 {
-	link_t *link;
+	size_t i;
 
-	link = list_next(&cur->lmacros, &cur->preproc->macros);
-	if (link == NULL)
-		return NULL;
+	for (i = 0; i < macro->nparams; i++) {
+		if (strcmp(macro->params[i], name) == 0) {
+			*ridx = i;
+			return true;
+		}
+	}
+
+	return false;
+}
 
-	return list_get_instance(link, preproc_macro_t, lmacros);
+/** Insert preprocessor macro into macro table.
+ *
+ * @param macro Macro
+ */
+static void preproc_macro_insert(preproc_macro_t *macro)
+{
+	list_append(&macro->lmacros,
+	    &macro->preproc->macros[preproc_macro_hash(macro->name)]);
 }
 
 /** Find preprocessor macro by name.
@@ -338,26 +561,42 @@ static preproc_macro_t *preproc_macro_next(preproc_macro_t *cur)
  */
 static preproc_macro_t *preproc_macro_find(preproc_t *preproc, const char *name)
 {
+	list_t *bucket;
+	link_t *link;
 	preproc_macro_t *macro;
 
-	macro = preproc_macro_first(preproc);
-	while (macro != NULL) {
+	bucket = &preproc->macros[preproc_macro_hash(name)];
+	link = list_first(bucket);
+	while (link != NULL) {
+		macro = list_get_instance(link, preproc_macro_t, lmacros);
 		if (strcmp(macro->name, name) == 0)
 			return macro;
 
-		macro = preproc_macro_next(macro);
+		link = list_next(link, bucket);
 	}
 
 	return NULL;
 }
 
-/** Remove preprocessor macro.
+/** Destroy preprocessor macro.
+ *
+ * Removes the macro from the macro table, if it is there. The
+ * replacement list is allocated from @c preproc->marena and is freed
+ * together with the preprocessor.
  *
  * @param macro Preprocessor macro
  */
-static void preproc_macro_remove(preproc_macro_t *macro)
+static void preproc_macro_destroy(preproc_macro_t *macro)
 {
-	list_remove(&macro->lmacros);
+	size_t i;
+
+	if (link_used(&macro->lmacros))
+		list_remove(&macro->lmacros);
+
+	for (i = 0; i < macro->nparams; i++)
+		free(macro->params[i]);
+	if (macro->params != NULL)
+		free(macro->params);
 	free(macro->name);
 	free(macro);
 }
@@ -477,14 +716,42 @@ static void preproc_advance(preproc_t *preproc, size_t nchars)
 	}
 }
 
-/** Determine if output buffer has available space.
+/** Make sure a character buffer with positions has room for more.
  *
- * @param preproc Preprocessor
- * @return @c true iff output buffer has available space.
+ * @param buf Character buffer
+ * @param posbuf Position buffer or @c NULL if there is none
+ * @param size Allocated size (in characters)
+ * @param need Number of characters the buffers must be able to hold
+ * @return EOK on success, ENOMEM if out of memory
  */
-static bool preproc_out_buf_avail(preproc_t *preproc)
+static int preproc_cbuf_reserve(char **buf, src_pos_t **posbuf, size_t *size,
+    size_t need)
 {
-	return preproc->out_buf_used < preproc_out_buf_size;
+	char *nbuf;
+	src_pos_t *nposbuf;
+	size_t nsize;
+
+	if (need <= *size)
+		return EOK;
+
+	nsize = *size != 0 ? *size : preproc_cbuf_init_size;
+	while (nsize < need)
+		nsize *= 2;
+
+	nbuf = realloc(*buf, nsize);
+	if (nbuf == NULL)
+		return ENOMEM;
+	*buf = nbuf;
+
+	if (posbuf != NULL) {
+		nposbuf = realloc(*posbuf, nsize * sizeof(src_pos_t));
+		if (nposbuf == NULL)
+			return ENOMEM;
+		*posbuf = nposbuf;
+	}
+
+	*size = nsize;
+	return EOK;
 }
 
 /** Insert character to preprocessor output buffer.
@@ -494,16 +761,105 @@ static bool preproc_out_buf_avail(preproc_t *preproc)
  * @param pos Character source code position
  * @return EOK on success or an error code.
  */
-static void preproc_out_buf_insert(preproc_t *preproc, char c, src_pos_t *pos)
+static int preproc_out_insert(preproc_t *preproc, char c, src_pos_t *pos)
+{
+	int rc;
+
+	rc = preproc_cbuf_reserve(&preproc->obuf, &preproc->oposbuf,
+	    &preproc->obuf_size, preproc->obuf_used + 1);
+	if (rc != EOK)
+		return rc;
+
+	preproc->obuf[preproc->obuf_used] = c;
+	preproc->oposbuf[preproc->obuf_used] = *pos;
+	++preproc->obuf_used;
+	return EOK;
+}
+
+/** Insert character to preprocessor line buffer.
+ *
+ * The line buffer is kept null-terminated.
+ *
+ * @param preproc Preprocessor
+ * @param c Character
+ * @param pos Character source code position
+ * @return EOK on success or an error code.
+ */
+static int preproc_lbuf_insert(preproc_t *preproc, char c, src_pos_t *pos)
+{
+	int rc;
+
+	rc = preproc_cbuf_reserve(&preproc->lbuf, &preproc->lposbuf,
+	    &preproc->lbuf_size, preproc->lbuf_used + 2);
+	if (rc != EOK)
+		return rc;
+
+	preproc->lbuf[preproc->lbuf_used] = c;
+	preproc->lposbuf[preproc->lbuf_used] = *pos;
+	++preproc->lbuf_used;
+	preproc->lbuf[preproc->lbuf_used] = '\0';
+	return EOK;
+}
+
+/** Append character to preprocessor scratch buffer.
+ *
+ * The scratch buffer is kept null-terminated.
+ *
+ * @param preproc Preprocessor
+ * @param c Character
+ * @return EOK on success or an error code.
+ */
+static int preproc_sbuf_addc(preproc_t *preproc, char c)
+{
+	int rc;
+
+	rc = preproc_cbuf_reserve(&preproc->sbuf, NULL, &preproc->sbuf_size,
+	    preproc->sbuf_used + 2);
+	if (rc != EOK)
+		return rc;
+
+	preproc->sbuf[preproc->sbuf_used++] = c;
+	preproc->sbuf[preproc->sbuf_used] = '\0';
+	return EOK;
+}
+
+/** Append string to preprocessor scratch buffer.
+ *
+ * @param preproc Preprocessor
+ * @param str String
+ * @return EOK on success or an error code.
+ */
+static int preproc_sbuf_adds(preproc_t *preproc, const char *str)
+{
+	int rc;
+
+	while (*str != '\0') {
+		rc = preproc_sbuf_addc(preproc, *str);
+		if (rc != EOK)
+			return rc;
+		++str;
+	}
+
+	return EOK;
+}
+
+/** Clear preprocessor scratch buffer.
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success or an error code.
+ */
+static int preproc_sbuf_clear(preproc_t *preproc)
 {
-	if (preproc->out_buf_used == 0)
-		preproc->out_buf_pos = preproc->cur->pos;
+	int rc;
 
-	assert(preproc_out_buf_avail(preproc));
+	rc = preproc_cbuf_reserve(&preproc->sbuf, NULL, &preproc->sbuf_size,
+	    1);
+	if (rc != EOK)
+		return rc;
 
-	preproc->out_buf[preproc->out_buf_used] = c;
-	preproc->out_posbuf[preproc->out_buf_used] = *pos;
-	++preproc->out_buf_used;
+	preproc->sbuf_used = 0;
+	preproc->sbuf[0] = '\0';
+	return EOK;
 }
 
 /** Print source range for diagnostics.
@@ -530,15 +886,29 @@ static int preproc_dprint_range(src_pos_t *bpos, src_pos_t *epos, FILE *f)
 	return EOK;
 }
 
+/** Account for a diagnostic message and determine whether to print it.
+ *
+ * @param preproc Preprocessor
+ * @return @c true iff the message should be printed
+ */
+static bool preproc_msg(preproc_t *preproc)
+{
+	++preproc->ndiags;
+	return !preproc->quiet;
+}
+
 /** Print error expected <header-name> or "header-name".
  *
  * @param preproc Preprocessor
  */
 static void preproc_error_header_name(preproc_t *preproc)
 {
-	(void)preproc_dprint_range(&preproc->cur->pos, &preproc->cur->pos,
-	    stderr);
-	(void)fprintf(stderr, ": Expected <header-name> or \"header-name\".\n");
+	if (preproc_msg(preproc)) {
+		(void)preproc_dprint_range(&preproc->cur->pos,
+		    &preproc->cur->pos, stderr);
+		(void)fprintf(stderr,
+		    ": Expected <header-name> or \"header-name\".\n");
+	}
 }
 
 /** Print error expected macro name.
@@ -547,9 +917,11 @@ static void preproc_error_header_name(preproc_t *preproc)
  */
 static void preproc_error_macro_name(preproc_t *preproc)
 {
-	(void)preproc_dprint_range(&preproc->cur->pos, &preproc->cur->pos,
-	    stderr);
-	(void)fprintf(stderr, ": Expected macro name.\n");
+	if (preproc_msg(preproc)) {
+		(void)preproc_dprint_range(&preproc->cur->pos,
+		    &preproc->cur->pos, stderr);
+		(void)fprintf(stderr, ": Expected macro name.\n");
+	}
 }
 
 /** Print error expected condition.
@@ -558,9 +930,25 @@ static void preproc_error_macro_name(preproc_t *preproc)
  */
 static void preproc_error_condition(preproc_t *preproc)
 {
-	(void)preproc_dprint_range(&preproc->cur->pos, &preproc->cur->pos,
-	    stderr);
-	(void)fprintf(stderr, ": Expected condition.\n");
+	if (preproc_msg(preproc)) {
+		(void)preproc_dprint_range(&preproc->cur->pos,
+		    &preproc->cur->pos, stderr);
+		(void)fprintf(stderr, ": Expected condition.\n");
+	}
+}
+
+/** Print error message with position.
+ *
+ * @param pos Position
+ * @param msg Message
+ */
+static void preproc_error_at(preproc_t *preproc, src_pos_t *pos,
+    const char *msg)
+{
+	if (preproc_msg(preproc)) {
+		(void)preproc_dprint_range(pos, pos, stderr);
+		(void)fprintf(stderr, ": %s\n", msg);
+	}
 }
 
 /** Process whitespace.
@@ -602,10 +990,12 @@ static int preproc_process_ws_eol(preproc_t *preproc)
 	if (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
 		p = preproc_chars(preproc);
 		if (p[0] != '\n') {
-			(void)preproc_dprint_range(&preproc->cur->pos,
-			    &preproc->cur->pos, stderr);
-			(void)fprintf(stderr, ": Unexpected characters "
-			    "at end of line.\n");
+			if (preproc_msg(preproc)) {
+				(void)preproc_dprint_range(&preproc->cur->pos,
+				    &preproc->cur->pos, stderr);
+				(void)fprintf(stderr, ": Unexpected characters "
+				    "at end of line.\n");
+			}
 			return EINVAL;
 		}
 	}
@@ -617,95 +1007,2883 @@ static int preproc_process_ws_eol(preproc_t *preproc)
 	return EOK;
 }
 
-/** Process condition expression.
+/** Begin processing a line that needs preprocessing tokens.
+ *
+ * Tokens of the line are allocated from a token arena which is
+ * freed by preproc_tokens_end().
  *
  * @param preproc Preprocessor
  * @return EOK on success or an error code.
  */
-static int preproc_process_condition(preproc_t *preproc, bool *rresult)
+static int preproc_tokens_begin(preproc_t *preproc)
 {
-	char *p;
-
-	if (preproc_is_eof(preproc) || preproc_is_error(preproc))
-		return EINVAL;
-
-	p = preproc_chars(preproc);
-	if (p[0] == '0') {
-		preproc_advance(preproc, 1);
-		*rresult = false;
-		return EOK;
-	}
-
-	if (p[0] == '1') {
-		preproc_advance(preproc, 1);
-		*rresult = true;
-		return EOK;
-	}
+	assert(preproc->tarena == NULL);
+	return arena_create(&preproc->tarena);
+}
 
-	fprintf(stderr, "Invalid conditional expression.\n");
-	return EINVAL;
+/** Finish processing a line that needs preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ */
+static void preproc_tokens_end(preproc_t *preproc)
+{
+	arena_destroy(preproc->tarena);
+	preproc->tarena = NULL;
 }
 
+/** Determine if character is horizontal whitespace.
+ *
+ * @param c Character
+ * @return @c true iff @a c is a horizontal whitespace character
+ */
+static bool preproc_is_hws(char c)
+{
+	return c == ' ' || c == '\t' || c == '\f' || c == '\v' || c == '\r';
+}
 
-/** Process invalid directive and print diagnostics.
+/** Scan preprocessing token.
  *
- * @param preproc Preprocessor
- * @return EOK on success or an error code
+ * @param p Null-terminated string to scan
+ * @param rttype Place to store token type
+ * @param rlen Place to store token length
+ * @return @c true if the token is complete, @c false if it is
+ *         an unterminated comment
  */
-static int preproc_process_invalid_directive(preproc_t *preproc)
+static bool preproc_scan(const char *p, preproc_toktype_t *rttype,
+    size_t *rlen)
 {
-	src_pos_t spos;
-	char *p;
-	int rc;
+	size_t i;
+	size_t plen;
+	char delim;
 
-	if (preproc->skipping) {
-		rc = preproc_skip_to_end_of_line(preproc);
-		if (rc != EOK)
-			return rc;
+	if (p[0] == '\n') {
+		*rttype = ppt_newline;
+		*rlen = 1;
+		return true;
+	}
 
-		preproc->state = pps_line_begin;
-		return EOK;
+	if (preproc_is_hws(p[0]) || (p[0] == '\\' && p[1] == '\n')) {
+		i = 0;
+		while (true) {
+			if (preproc_is_hws(p[i]))
+				++i;
+			else if (p[i] == '\\' && p[i + 1] == '\n')
+				i += 2;
+			else
+				break;
+		}
+
+		*rttype = ppt_ws;
+		*rlen = i;
+		return true;
 	}
 
-	 spos = preproc->cur->pos;
-	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
-		p = preproc_chars(preproc);
-		if (!is_idcnt(p[0]))
-			break;
+	if (p[0] == '/' && p[1] == '*') {
+		i = 2;
+		while (p[i] != '\0' && (p[i] != '*' || p[i + 1] != '/'))
+			++i;
 
-		preproc_advance(preproc, 1);
+		*rttype = ppt_ws;
+		if (p[i] == '\0') {
+			*rlen = i;
+			return false;
+		}
+
+		*rlen = i + 2;
+		return true;
 	}
 
-	(void)preproc_dprint_range(&spos, &preproc->cur->pos, stderr);
-	(void)fprintf(stderr, ": Invalid preprocessor directive.\n");
+	if (p[0] == '/' && p[1] == '/') {
+		i = 2;
+		while (p[i] != '\0' && p[i] != '\n')
+			++i;
 
-	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
-		p = preproc_chars(preproc);
-		if (p[0] == '\n')
-			break;
+		*rttype = ppt_ws;
+		*rlen = i;
+		return true;
+	}
 
-		preproc_advance(preproc, 1);
+	i = 0;
+	if (p[0] == 'L' && (p[1] == '\'' || p[1] == '"'))
+		i = 1;
+
+	if (p[i] == '\'' || p[i] == '"') {
+		delim = p[i];
+		++i;
+		while (p[i] != '\0' && p[i] != '\n' && p[i] != delim) {
+			if (p[i] == '\\' && p[i + 1] != '\0')
+				i += 2;
+			else
+				++i;
+		}
+
+		if (p[i] == delim) {
+			*rttype = delim == '"' ? ppt_strlit : ppt_charlit;
+			*rlen = i + 1;
+			return true;
+		}
+
+		/* Unterminated literal, the lexer will complain */
+		*rttype = p[0] == 'L' ? ppt_ident : ppt_other;
+		*rlen = 1;
+		return true;
+	}
+
+	if (is_idbegin(p[0])) {
+		i = 1;
+		while (is_idcnt(p[i]))
+			++i;
+
+		*rttype = ppt_ident;
+		*rlen = i;
+		return true;
+	}
+
+	if (is_num(p[0]) || (p[0] == '.' && is_num(p[1]))) {
+		i = 1;
+		while (true) {
+			if ((p[i] == 'e' || p[i] == 'E' || p[i] == 'p' ||
+			    p[i] == 'P') && (p[i + 1] == '+' || p[i + 1] == '-'))
+				i += 2;
+			else if (is_idcnt(p[i]) || p[i] == '.')
+				++i;
+			else
+				break;
+		}
+
+		*rttype = ppt_number;
+		*rlen = i;
+		return true;
+	}
+
+	for (i = 0; i < sizeof(preproc_puncts) / sizeof(char *); i++) {
+		plen = strlen(preproc_puncts[i]);
+		if (strncmp(p, preproc_puncts[i], plen) == 0) {
+			*rttype = ppt_punct;
+			*rlen = plen;
+			return true;
+		}
+	}
+
+	*rttype = ppt_other;
+	*rlen = 1;
+	return true;
+}
+
+/** Create preprocessing token.
+ *
+ * @param arena Arena to allocate the token from
+ * @param ttype Token type
+ * @param text Token text (need not be null-terminated)
+ * @param len Length of token text
+ * @param bpos Position of the beginning of the token
+ * @param rtok Place to store pointer to new token
+ * @return EOK on success or an error code.
+ */
+static int preproc_tok_create(arena_t *arena, preproc_toktype_t ttype,
+    const char *text, size_t len, src_pos_t *bpos, preproc_tok_t **rtok)
+{
+	preproc_tok_t *tok;
+
+	tok = arena_zalloc(arena, sizeof(preproc_tok_t));
+	if (tok == NULL)
+		return ENOMEM;
+
+	tok->text = arena_strndup(arena, text, len);
+	if (tok->text == NULL)
+		return ENOMEM;
+
+	link_initialize(&tok->ltoks);
+	tok->ttype = ttype;
+	tok->bpos = *bpos;
+	*rtok = tok;
+	return EOK;
+}
+
+/** Copy preprocessing token.
+ *
+ * The copy is allocated from the token arena and shares the text
+ * with the original.
+ *
+ * @param preproc Preprocessor
+ * @param tok Token
+ * @param rtok Place to store pointer to the copy
+ * @return EOK on success or an error code.
+ */
+static int preproc_tok_copy(preproc_t *preproc, preproc_tok_t *tok,
+    preproc_tok_t **rtok)
+{
+	preproc_tok_t *ntok;
+
+	ntok = arena_alloc(preproc->tarena, sizeof(preproc_tok_t));
+	if (ntok == NULL)
+		return ENOMEM;
+
+	*ntok = *tok;
+	link_initialize(&ntok->ltoks);
+	*rtok = ntok;
+	return EOK;
+}
+
+/** Return first token in list.
+ *
+ * @param toks Token list
+ * @return First token or @c NULL if the list is empty
+ */
+static preproc_tok_t *preproc_tok_first(list_t *toks)
+{
+	link_t *link;
+
+	link = list_first(toks);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, preproc_tok_t, ltoks);
+}
+
+/** Return last token in list.
+ *
+ * @param toks Token list
+ * @return Last token or @c NULL if the list is empty
+ */
+static preproc_tok_t *preproc_tok_last(list_t *toks)
+{
+	link_t *link;
+
+	link = list_last(toks);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, preproc_tok_t, ltoks);
+}
+
+/** Return next token in list.
+ *
+ * @param tok Current token
+ * @param toks Token list
+ * @return Next token or @c NULL if @a tok is the last
+ */
+static preproc_tok_t *preproc_tok_next(preproc_tok_t *tok, list_t *toks)
+{
+	link_t *link;
+
+	link = list_next(&tok->ltoks, toks);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, preproc_tok_t, ltoks);
+}
+
+/** Return previous token in list.
+ *
+ * @param tok Current token
+ * @param toks Token list
+ * @return Previous token or @c NULL if @a tok is the first
+ */
+static preproc_tok_t *preproc_tok_prev(preproc_tok_t *tok, list_t *toks)
+{
+	link_t *link;
+
+	link = list_prev(&tok->ltoks, toks);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, preproc_tok_t, ltoks);
+}
+
+/** Determine if token is whitespace (including new line).
+ *
+ * @param tok Token
+ * @return @c true iff @a tok is whitespace
+ */
+static bool preproc_tok_is_ws(preproc_tok_t *tok)
+{
+	return tok->ttype == ppt_ws || tok->ttype == ppt_newline;
+}
+
+/** Determine if token is a particular punctuator.
+ *
+ * @param tok Token
+ * @param punct Punctuator text
+ * @return @c true iff @a tok is @a punct
+ */
+static bool preproc_tok_is_punct(preproc_tok_t *tok, const char *punct)
+{
+	return tok->ttype == ppt_punct && strcmp(tok->text, punct) == 0;
+}
+
+/** Skip whitespace tokens.
+ *
+ * @param tok Token or @c NULL
+ * @param toks Token list
+ * @return First non-whitespace token starting from @a tok or @c NULL
+ */
+static preproc_tok_t *preproc_tok_skip_ws(preproc_tok_t *tok, list_t *toks)
+{
+	while (tok != NULL && preproc_tok_is_ws(tok))
+		tok = preproc_tok_next(tok, toks);
+
+	return tok;
+}
+
+/** Move all tokens from one list to the end of another.
+ *
+ * @param src Source list
+ * @param dest Destination list
+ */
+static void preproc_toks_move(list_t *src, list_t *dest)
+{
+	preproc_tok_t *tok;
+
+	tok = preproc_tok_first(src);
+	while (tok != NULL) {
+		list_remove(&tok->ltoks);
+		list_append(&tok->ltoks, dest);
+		tok = preproc_tok_first(src);
+	}
+}
+
+/** Read the rest of the current line into the line buffer.
+ *
+ * Reading continues after a line splice (backslash-newline).
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success or an error code.
+ */
+static int preproc_read_line(preproc_t *preproc)
+{
+	char *p;
+	char c;
+	int rc;
+
+	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
+		p = preproc_chars(preproc);
+		c = p[0];
+
+		rc = preproc_lbuf_insert(preproc, c, &preproc->cur->pos);
+		if (rc != EOK)
+			return rc;
+
+		preproc_advance(preproc, 1);
+
+		if (c == '\n' && (preproc->lbuf_used < 2 ||
+		    preproc->lbuf[preproc->lbuf_used - 2] != '\\'))
+			break;
+	}
+
+	if (preproc_is_error(preproc))
+		return EIO;
+
+	return EOK;
+}
+
+/** Split line buffer into preprocessing tokens.
+ *
+ * If the line buffer ends within a block comment, more lines are
+ * read from the input.
+ *
+ * @param preproc Preprocessor
+ * @param toks Token list to append tokens to
+ * @param cont @c true to continue reading input in a block comment
+ * @return EOK on success or an error code.
+ */
+static int preproc_lex_lbuf(preproc_t *preproc, list_t *toks, bool cont)
+{
+	preproc_toktype_t ttype;
+	preproc_tok_t *tok;
+	size_t off;
+	size_t len;
+	size_t used;
+	int rc;
+
+	off = 0;
+	while (off < preproc->lbuf_used) {
+		if (!preproc_scan(preproc->lbuf + off, &ttype, &len) &&
+		    cont && !preproc_is_eof(preproc)) {
+			/* Block comment continues on the next line */
+			used = preproc->lbuf_used;
+			rc = preproc_read_line(preproc);
+			if (rc != EOK)
+				return rc;
+
+			if (preproc->lbuf_used > used)
+				continue;
+		}
+
+		rc = preproc_tok_create(preproc->tarena, ttype,
+		    preproc->lbuf + off, len, &preproc->lposbuf[off], &tok);
+		if (rc != EOK)
+			return rc;
+
+		list_append(&tok->ltoks, toks);
+		off += len;
+	}
+
+	return EOK;
+}
+
+/** Read the rest of the current line as preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ * @param toks Token list to append tokens to
+ * @return EOK on success or an error code.
+ */
+static int preproc_lex_line(preproc_t *preproc, list_t *toks)
+{
+	int rc;
+
+	preproc->lbuf_used = 0;
+	rc = preproc_read_line(preproc);
+	if (rc != EOK)
+		return rc;
+
+	return preproc_lex_lbuf(preproc, toks, true);
+}
+
+/** Split a string into preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ * @param str String
+ * @param toks Token list to append tokens to
+ * @return EOK on success or an error code.
+ */
+static int preproc_lex_str(preproc_t *preproc, const char *str, list_t *toks)
+{
+	src_pos_t pos;
+	int rc;
+
+	memset(&pos, 0, sizeof(pos));
+	preproc->lbuf_used = 0;
+	while (*str != '\0') {
+		rc = preproc_lbuf_insert(preproc, *str, &pos);
+		if (rc != EOK)
+			return rc;
+		++str;
+	}
+
+	return preproc_lex_lbuf(preproc, toks, false);
+}
+
+/** Read another text line for a macro invocation spanning lines.
+ *
+ * A function-like macro invocation can continue on the following
+ * lines, unless they are preprocessing directives.
+ *
+ * @param preproc Preprocessor
+ * @param toks Token list to append tokens to
+ * @param rgot Place to store @c true if a line was read
+ * @return EOK on success or an error code.
+ */
+static int preproc_more(preproc_t *preproc, list_t *toks, bool *rgot)
+{
+	char *p;
+	int rc;
+
+	*rgot = false;
+
+	/* Skip whitespace at beginning of line. */
+	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
+		p = preproc_chars(preproc);
+		if (p[0] != ' ' && p[0] != '\t')
+			break;
+
+		preproc_advance(preproc, 1);
+	}
+
+	if (preproc_is_error(preproc))
+		return EIO;
+
+	if (preproc_is_eof(preproc))
+		return EOK;
+
+	p = preproc_chars(preproc);
+	if (p[0] == '#')
+		return EOK;
+
+	rc = preproc_lex_line(preproc, toks);
+	if (rc != EOK)
+		return rc;
+
+	*rgot = true;
+	return EOK;
+}
+
+/** Determine if hide set contains a macro.
+ *
+ * @param hs Hide set
+ * @param name Macro name
+ * @return @c true iff @a name is in @a hs
+ */
+static bool preproc_hs_contains(preproc_hs_t *hs, const char *name)
+{
+	while (hs != NULL) {
+		if (strcmp(hs->name, name) == 0)
+			return true;
+		hs = hs->next;
+	}
+
+	return false;
+}
+
+/** Add macro to hide set.
+ *
+ * @param preproc Preprocessor
+ * @param hs Hide set
+ * @param name Macro name
+ * @param rhs Place to store the resulting hide set
+ * @return EOK on success or an error code.
+ */
+static int preproc_hs_add(preproc_t *preproc, preproc_hs_t *hs,
+    const char *name, preproc_hs_t **rhs)
+{
+	preproc_hs_t *nhs;
+
+	if (preproc_hs_contains(hs, name)) {
+		*rhs = hs;
+		return EOK;
+	}
+
+	nhs = arena_alloc(preproc->tarena, sizeof(preproc_hs_t));
+	if (nhs == NULL)
+		return ENOMEM;
+
+	nhs->name = name;
+	nhs->next = hs;
+	*rhs = nhs;
+	return EOK;
+}
+
+/** Compute union of two hide sets.
+ *
+ * @param preproc Preprocessor
+ * @param a First hide set
+ * @param b Second hide set
+ * @param rhs Place to store the resulting hide set
+ * @return EOK on success or an error code.
+ */
+static int preproc_hs_union(preproc_t *preproc, preproc_hs_t *a,
+    preproc_hs_t *b, preproc_hs_t **rhs)
+{
+	int rc;
+
+	while (a != NULL) {
+		rc = preproc_hs_add(preproc, b, a->name, &b);
+		if (rc != EOK)
+			return rc;
+		a = a->next;
+	}
+
+	*rhs = b;
+	return EOK;
+}
+
+/** Compute intersection of two hide sets.
+ *
+ * @param preproc Preprocessor
+ * @param a First hide set
+ * @param b Second hide set
+ * @param rhs Place to store the resulting hide set
+ * @return EOK on success or an error code.
+ */
+static int preproc_hs_intersect(preproc_t *preproc, preproc_hs_t *a,
+    preproc_hs_t *b, preproc_hs_t **rhs)
+{
+	preproc_hs_t *hs = NULL;
+	int rc;
+
+	while (a != NULL) {
+		if (preproc_hs_contains(b, a->name)) {
+			rc = preproc_hs_add(preproc, hs, a->name, &hs);
+			if (rc != EOK)
+				return rc;
+		}
+
+		a = a->next;
+	}
+
+	*rhs = hs;
+	return EOK;
+}
+
+/** Compare two macro definitions.
+ *
+ * @param a First macro
+ * @param b Second macro
+ * @return @c true iff the definitions are identical
+ */
+static bool preproc_macro_same(preproc_macro_t *a, preproc_macro_t *b)
+{
+	preproc_tok_t *ta;
+	preproc_tok_t *tb;
+	size_t i;
+
+	if (a->funlike != b->funlike || a->variadic != b->variadic ||
+	    a->nparams != b->nparams || a->builtin != b->builtin)
+		return false;
+
+	for (i = 0; i < a->nparams; i++) {
+		if (strcmp(a->params[i], b->params[i]) != 0)
+			return false;
+	}
+
+	ta = preproc_tok_first(&a->body);
+	tb = preproc_tok_first(&b->body);
+	while (ta != NULL && tb != NULL) {
+		if (ta->ttype != tb->ttype || strcmp(ta->text, tb->text) != 0)
+			return false;
+
+		ta = preproc_tok_next(ta, &a->body);
+		tb = preproc_tok_next(tb, &b->body);
+	}
+
+	return ta == NULL && tb == NULL;
+}
+
+/** Append token to macro replacement list.
+ *
+ * @param macro Macro
+ * @param tok Token (text and position are copied)
+ * @param ttype Token type to use
+ * @param rtok Place to store pointer to new token or @c NULL
+ * @return EOK on success or an error code.
+ */
+static int preproc_macro_append(preproc_macro_t *macro, preproc_tok_t *tok,
+    preproc_toktype_t ttype, preproc_tok_t **rtok)
+{
+	preproc_tok_t *ntok;
+	const char *text;
+	int rc;
+
+	/* Whitespace is collapsed to a single space */
+	text = ttype == ppt_ws ? " " : tok->text;
+
+	rc = preproc_tok_create(macro->preproc->marena, ttype, text,
+	    strlen(text), &tok->bpos, &ntok);
+	if (rc != EOK)
+		return rc;
+
+	list_append(&ntok->ltoks, &macro->body);
+	if (rtok != NULL)
+		*rtok = ntok;
+	return EOK;
+}
+
+/** Parse macro parameter list.
+ *
+ * @param macro Macro
+ * @param toks Tokens of the definition
+ * @param tok Opening parenthesis
+ * @param rtok Place to store the closing parenthesis
+ * @return EOK on success or an error code.
+ */
+static int preproc_define_params(preproc_macro_t *macro, list_t *toks,
+    preproc_tok_t *tok, preproc_tok_t **rtok)
+{
+	size_t idx;
+	int rc;
+
+	macro->funlike = true;
+
+	tok = preproc_tok_skip_ws(preproc_tok_next(tok, toks), toks);
+	if (tok != NULL && preproc_tok_is_punct(tok, ")")) {
+		*rtok = tok;
+		return EOK;
+	}
+
+	while (true) {
+		if (tok == NULL) {
+			preproc_error_at(macro->preproc,
+			    &macro->preproc->cur->pos,
+			    "Expected parameter name.");
+			return EINVAL;
+		}
+
+		if (preproc_tok_is_punct(tok, "...")) {
+			rc = preproc_macro_add_param(macro, "__VA_ARGS__");
+			if (rc != EOK)
+				return rc;
+
+			macro->variadic = true;
+			tok = preproc_tok_skip_ws(preproc_tok_next(tok, toks),
+			    toks);
+			if (tok == NULL || !preproc_tok_is_punct(tok, ")")) {
+				preproc_error_at(macro->preproc,
+				    tok != NULL ? &tok->bpos :
+				    &macro->preproc->cur->pos,
+				    "Expected ')' after '...'.");
+				return EINVAL;
+			}
+
+			*rtok = tok;
+			return EOK;
+		}
+
+		if (tok->ttype != ppt_ident) {
+			preproc_error_at(macro->preproc, &tok->bpos,
+			    "Expected parameter name.");
+			return EINVAL;
+		}
+
+		if (strcmp(tok->text, "__VA_ARGS__") == 0 ||
+		    preproc_macro_find_param(macro, tok->text, &idx)) {
+			if (preproc_msg(macro->preproc)) {
+				(void)preproc_dprint_range(&tok->bpos,
+				    &tok->bpos, stderr);
+				(void)fprintf(stderr,
+				    ": Invalid parameter name '%s'.\n",
+				    tok->text);
+			}
+			return EINVAL;
+		}
+
+		rc = preproc_macro_add_param(macro, tok->text);
+		if (rc != EOK)
+			return rc;
+
+		tok = preproc_tok_skip_ws(preproc_tok_next(tok, toks), toks);
+		if (tok != NULL && preproc_tok_is_punct(tok, ")")) {
+			*rtok = tok;
+			return EOK;
+		}
+
+		if (tok == NULL || !preproc_tok_is_punct(tok, ",")) {
+			preproc_error_at(macro->preproc, tok != NULL ?
+			    &tok->bpos : &macro->preproc->cur->pos,
+			    "Expected ',' or ')' in macro parameter list.");
+			return EINVAL;
+		}
+
+		tok = preproc_tok_skip_ws(preproc_tok_next(tok, toks), toks);
+	}
+}
+
+/** Parse macro replacement list.
+ *
+ * @param macro Macro
+ * @param toks Tokens of the definition
+ * @param tok First token of the replacement list or @c NULL
+ * @return EOK on success or an error code.
+ */
+static int preproc_define_body(preproc_macro_t *macro, list_t *toks,
+    preproc_tok_t *tok)
+{
+	preproc_tok_t *ntok;
+	preproc_tok_t *last;
+	size_t idx;
+	bool after_op = false;
+	int rc;
+
+	tok = preproc_tok_skip_ws(tok, toks);
+	while (tok != NULL && tok->ttype != ppt_newline) {
+		last = preproc_tok_last(&macro->body);
+
+		if (tok->ttype == ppt_ws) {
+			/* Drop whitespace after '#', '##' and repeated */
+			if (!after_op && last != NULL && last->ttype != ppt_ws) {
+				rc = preproc_macro_append(macro, tok, ppt_ws,
+				    NULL);
+				if (rc != EOK)
+					return rc;
+			}
+
+			tok = preproc_tok_next(tok, toks);
+			continue;
+		}
+
+		after_op = false;
+
+		if (preproc_tok_is_punct(tok, "##") ||
+		    preproc_tok_is_punct(tok, "%:%:")) {
+			/* Drop whitespace before '##' */
+			if (last != NULL && last->ttype == ppt_ws) {
+				list_remove(&last->ltoks);
+				last = preproc_tok_last(&macro->body);
+			}
+
+			if (last == NULL) {
+				preproc_error_at(macro->preproc, &tok->bpos,
+				    "'##' cannot appear at either end of a "
+				    "macro expansion.");
+				return EINVAL;
+			}
+
+			rc = preproc_macro_append(macro, tok, ppt_paste, NULL);
+			if (rc != EOK)
+				return rc;
+
+			after_op = true;
+		} else if (macro->funlike && (preproc_tok_is_punct(tok, "#") ||
+		    preproc_tok_is_punct(tok, "%:"))) {
+			ntok = preproc_tok_skip_ws(preproc_tok_next(tok, toks),
+			    toks);
+			if (ntok == NULL || ntok->ttype != ppt_ident ||
+			    !preproc_macro_find_param(macro, ntok->text,
+			    &idx)) {
+				preproc_error_at(macro->preproc, &tok->bpos,
+				    "'#' is not followed by a macro "
+				    "parameter.");
+				return EINVAL;
+			}
+
+			rc = preproc_macro_append(macro, tok, ppt_stringize,
+			    NULL);
+			if (rc != EOK)
+				return rc;
+
+			after_op = true;
+		} else if (tok->ttype == ppt_ident &&
+		    preproc_macro_find_param(macro, tok->text, &idx)) {
+			rc = preproc_macro_append(macro, tok, ppt_param,
+			    &ntok);
+			if (rc != EOK)
+				return rc;
+
+			ntok->pidx = idx;
+		} else {
+			if (tok->ttype == ppt_ident &&
+			    strcmp(tok->text, "__VA_ARGS__") == 0) {
+				preproc_error_at(macro->preproc, &tok->bpos,
+				    "__VA_ARGS__ can only appear in the "
+				    "expansion of a variadic macro.");
+				return EINVAL;
+			}
+
+			rc = preproc_macro_append(macro, tok, tok->ttype,
+			    NULL);
+			if (rc != EOK)
+				return rc;
+		}
+
+		tok = preproc_tok_next(tok, toks);
+	}
+
+	/* Drop trailing whitespace */
+	last = preproc_tok_last(&macro->body);
+	if (last != NULL && last->ttype == ppt_ws) {
+		list_remove(&last->ltoks);
+		last = preproc_tok_last(&macro->body);
+	}
+
+	if (last != NULL && last->ttype == ppt_paste) {
+		preproc_error_at(macro->preproc, &last->bpos,
+		    "'##' cannot appear at either end of a macro expansion.");
+		return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Define macro from preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ * @param toks Tokens following the 'define' keyword
+ * @return EOK on success or an error code.
+ */
+static int preproc_define_toks(preproc_t *preproc, list_t *toks)
+{
+	preproc_macro_t *macro = NULL;
+	preproc_macro_t *old;
+	preproc_tok_t *tok;
+	preproc_tok_t *ntok;
+	int rc;
+
+	tok = preproc_tok_skip_ws(preproc_tok_first(toks), toks);
+	if (tok == NULL || tok->ttype != ppt_ident) {
+		if (tok != NULL)
+			preproc_error_at(preproc, &tok->bpos,
+			    "Expected macro name.");
+		else
+			preproc_error_macro_name(preproc);
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (strcmp(tok->text, "defined") == 0) {
+		preproc_error_at(preproc, &tok->bpos,
+		    "'defined' cannot be used as a macro name.");
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = preproc_macro_create(preproc, tok->text, &macro);
+	if (rc != EOK)
+		goto error;
+
+	ntok = preproc_tok_next(tok, toks);
+	if (ntok != NULL && preproc_tok_is_punct(ntok, "(")) {
+		/* Function-like macro ('(' immediately follows the name) */
+		rc = preproc_define_params(macro, toks, ntok, &ntok);
+		if (rc != EOK)
+			goto error;
+
+		ntok = preproc_tok_next(ntok, toks);
+	}
+
+	rc = preproc_define_body(macro, toks, ntok);
+	if (rc != EOK)
+		goto error;
+
+	old = preproc_macro_find(preproc, macro->name);
+	if (old != NULL) {
+		if (!preproc_macro_same(old, macro)) {
+			if (preproc_msg(preproc)) {
+				(void)preproc_dprint_range(&tok->bpos,
+				    &tok->bpos, stderr);
+				(void)fprintf(stderr,
+				    ": Macro '%s' redefined.\n", macro->name);
+			}
+			rc = EINVAL;
+			goto error;
+		}
+
+		/* Identical redefinition */
+		preproc_macro_destroy(macro);
+		return EOK;
+	}
+
+	preproc_macro_insert(macro);
+	return EOK;
+error:
+	if (macro != NULL)
+		preproc_macro_destroy(macro);
+	return rc;
+}
+
+/** Define predefined macro.
+ *
+ * @param preproc Preprocessor
+ * @param def Definition in the form 'name replacement-list'
+ * @return EOK on success or an error code.
+ */
+static int preproc_predefine(preproc_t *preproc, const char *def)
+{
+	list_t toks;
+	int rc;
+
+	rc = preproc_tokens_begin(preproc);
+	if (rc != EOK)
+		return rc;
+
+	list_initialize(&toks);
+	rc = preproc_lex_str(preproc, def, &toks);
+	if (rc == EOK)
+		rc = preproc_define_toks(preproc, &toks);
+
+	preproc_tokens_end(preproc);
+	return rc;
+}
+
+/** Create string literal token with escaped contents of scratch buffer.
+ *
+ * @param preproc Preprocessor
+ * @param str Contents
+ * @param bpos Position
+ * @param rtok Place to store pointer to new token
+ * @return EOK on success or an error code.
+ */
+static int preproc_strlit_create(preproc_t *preproc, const char *str,
+    src_pos_t *bpos, preproc_tok_t **rtok)
+{
+	int rc;
+
+	rc = preproc_sbuf_clear(preproc);
+	if (rc != EOK)
+		return rc;
+
+	rc = preproc_sbuf_addc(preproc, '"');
+	if (rc != EOK)
+		return rc;
+
+	while (*str != '\0') {
+		if (*str == '"' || *str == '\\') {
+			rc = preproc_sbuf_addc(preproc, '\\');
+			if (rc != EOK)
+				return rc;
+		}
+
+		rc = preproc_sbuf_addc(preproc, *str);
+		if (rc != EOK)
+			return rc;
+		++str;
+	}
+
+	rc = preproc_sbuf_addc(preproc, '"');
+	if (rc != EOK)
+		return rc;
+
+	return preproc_tok_create(preproc->tarena, ppt_strlit, preproc->sbuf,
+	    preproc->sbuf_used, bpos, rtok);
+}
+
+/** Stringize macro argument.
+ *
+ * @param preproc Preprocessor
+ * @param arg Argument tokens
+ * @param bpos Position for the new token
+ * @param rtok Place to store pointer to new string literal token
+ * @return EOK on success or an error code.
+ */
+static int preproc_stringize(preproc_t *preproc, list_t *arg, src_pos_t *bpos,
+    preproc_tok_t **rtok)
+{
+	preproc_tok_t *tok;
+	bool space = false;
+	const char *cp;
+	int rc;
+
+	rc = preproc_sbuf_clear(preproc);
+	if (rc != EOK)
+		return rc;
+
+	rc = preproc_sbuf_addc(preproc, '"');
+	if (rc != EOK)
+		return rc;
+
+	tok = preproc_tok_first(arg);
+	while (tok != NULL) {
+		if (preproc_tok_is_ws(tok)) {
+			/* Whitespace sequence becomes a single space */
+			space = preproc->sbuf_used > 1;
+			tok = preproc_tok_next(tok, arg);
+			continue;
+		}
+
+		if (space) {
+			rc = preproc_sbuf_addc(preproc, ' ');
+			if (rc != EOK)
+				return rc;
+			space = false;
+		}
+
+		cp = tok->text;
+		while (*cp != '\0') {
+			if ((tok->ttype == ppt_strlit ||
+			    tok->ttype == ppt_charlit) &&
+			    (*cp == '"' || *cp == '\\')) {
+				rc = preproc_sbuf_addc(preproc, '\\');
+				if (rc != EOK)
+					return rc;
+			}
+
+			rc = preproc_sbuf_addc(preproc, *cp);
+			if (rc != EOK)
+				return rc;
+			++cp;
+		}
+
+		tok = preproc_tok_next(tok, arg);
+	}
+
+	rc = preproc_sbuf_addc(preproc, '"');
+	if (rc != EOK)
+		return rc;
+
+	return preproc_tok_create(preproc->tarena, ppt_strlit, preproc->sbuf,
+	    preproc->sbuf_used, bpos, rtok);
+}
+
+/** Paste two tokens together.
+ *
+ * @param preproc Preprocessor
+ * @param ltok Left operand
+ * @param rtok Right operand
+ * @param bpos Position for diagnostics and for the new token
+ * @param rres Place to store pointer to the resulting token
+ * @return EOK on success or an error code.
+ */
+static int preproc_paste(preproc_t *preproc, preproc_tok_t *ltok,
+    preproc_tok_t *rtok, src_pos_t *bpos, preproc_tok_t **rres)
+{
+	preproc_toktype_t ttype;
+	size_t len;
+	int rc;
+
+	if (ltok->ttype == ppt_placemarker) {
+		*rres = rtok;
+		return EOK;
+	}
+
+	if (rtok->ttype == ppt_placemarker) {
+		*rres = ltok;
+		return EOK;
+	}
+
+	rc = preproc_sbuf_clear(preproc);
+	if (rc != EOK)
+		return rc;
+
+	rc = preproc_sbuf_adds(preproc, ltok->text);
+	if (rc != EOK)
+		return rc;
+
+	rc = preproc_sbuf_adds(preproc, rtok->text);
+	if (rc != EOK)
+		return rc;
+
+	if (!preproc_scan(preproc->sbuf, &ttype, &len) ||
+	    len != preproc->sbuf_used || ttype == ppt_ws ||
+	    ttype == ppt_newline) {
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(bpos, bpos, stderr);
+			(void)fprintf(stderr,
+			    ": Pasting '%s' and '%s' does not give "
+			    "a valid preprocessing token.\n", ltok->text,
+			    rtok->text);
+		}
+		return EINVAL;
+	}
+
+	rc = preproc_tok_create(preproc->tarena, ttype, preproc->sbuf,
+	    preproc->sbuf_used, bpos, rres);
+	if (rc != EOK)
+		return rc;
+
+	(*rres)->hs = ltok->hs;
+	return EOK;
+}
+
+/** Perform token pasting in macro replacement.
+ *
+ * @param preproc Preprocessor
+ * @param toks Replacement tokens
+ * @param bpos Position of the macro invocation
+ * @return EOK on success or an error code.
+ */
+static int preproc_paste_all(preproc_t *preproc, list_t *toks,
+    src_pos_t *bpos)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *ltok;
+	preproc_tok_t *rtok;
+	preproc_tok_t *res;
+	int rc;
+
+	tok = preproc_tok_first(toks);
+	while (tok != NULL) {
+		if (tok->ttype != ppt_paste) {
+			tok = preproc_tok_next(tok, toks);
+			continue;
+		}
+
+		ltok = preproc_tok_prev(tok, toks);
+		rtok = preproc_tok_next(tok, toks);
+		assert(ltok != NULL);
+		assert(rtok != NULL);
+
+		rc = preproc_paste(preproc, ltok, rtok, bpos, &res);
+		if (rc != EOK)
+			return rc;
+
+		if (res != ltok && res != rtok)
+			list_insert_before(&res->ltoks, &ltok->ltoks);
+		if (res != ltok)
+			list_remove(&ltok->ltoks);
+		if (res != rtok)
+			list_remove(&rtok->ltoks);
+		list_remove(&tok->ltoks);
+
+		tok = res;
+	}
+
+	return EOK;
+}
+
+/** Append copy of macro argument to token list.
+ *
+ * @param preproc Preprocessor
+ * @param arg Argument tokens
+ * @param toks Destination token list
+ * @return EOK on success or an error code.
+ */
+static int preproc_arg_copy(preproc_t *preproc, list_t *arg, list_t *toks)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *ntok;
+	int rc;
+
+	tok = preproc_tok_first(arg);
+	while (tok != NULL) {
+		rc = preproc_tok_copy(preproc, tok, &ntok);
+		if (rc != EOK)
+			return rc;
+
+		list_append(&ntok->ltoks, toks);
+		tok = preproc_tok_next(tok, arg);
+	}
+
+	return EOK;
+}
+
+/** Substitute macro replacement list.
+ *
+ * @param preproc Preprocessor
+ * @param macro Macro
+ * @param args Arguments (array of token lists) or @c NULL
+ * @param mtok Macro name token of the invocation
+ * @param hs Hide set to add to the resulting tokens
+ * @param res Token list to append the resulting tokens to
+ * @return EOK on success or an error code.
+ */
+static int preproc_subst(preproc_t *preproc, preproc_macro_t *macro,
+    list_t *args, preproc_tok_t *mtok, preproc_hs_t *hs, list_t *res)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *ntok;
+	preproc_tok_t *prev;
+	preproc_tok_t *next;
+	list_t atoks;
+	list_t etoks;
+	int rc;
+
+	tok = preproc_tok_first(&macro->body);
+	while (tok != NULL) {
+		prev = preproc_tok_prev(tok, &macro->body);
+		next = preproc_tok_next(tok, &macro->body);
+
+		if (tok->ttype == ppt_stringize) {
+			assert(next != NULL && next->ttype == ppt_param);
+			rc = preproc_stringize(preproc, &args[next->pidx],
+			    &mtok->bpos, &ntok);
+			if (rc != EOK)
+				return rc;
+
+			list_append(&ntok->ltoks, res);
+			tok = preproc_tok_next(next, &macro->body);
+			continue;
+		}
+
+		if (tok->ttype == ppt_param) {
+			if ((prev != NULL && prev->ttype == ppt_paste) ||
+			    (next != NULL && next->ttype == ppt_paste)) {
+				/* Operand of '##' is not macro-expanded */
+				if (list_empty(&args[tok->pidx])) {
+					rc = preproc_tok_create(preproc->tarena,
+					    ppt_placemarker, "", 0,
+					    &mtok->bpos, &ntok);
+					if (rc != EOK)
+						return rc;
+
+					list_append(&ntok->ltoks, res);
+				} else {
+					rc = preproc_arg_copy(preproc,
+					    &args[tok->pidx], res);
+					if (rc != EOK)
+						return rc;
+				}
+			} else {
+				list_initialize(&atoks);
+				list_initialize(&etoks);
+				rc = preproc_arg_copy(preproc, &args[tok->pidx],
+				    &atoks);
+				if (rc != EOK)
+					return rc;
+
+				rc = preproc_expand(preproc, &atoks, &etoks,
+				    false);
+				if (rc != EOK)
+					return rc;
+
+				preproc_toks_move(&etoks, res);
+			}
+
+			tok = next;
+			continue;
+		}
+
+		rc = preproc_tok_copy(preproc, tok, &ntok);
+		if (rc != EOK)
+			return rc;
+
+		list_append(&ntok->ltoks, res);
+		tok = next;
+	}
+
+	rc = preproc_paste_all(preproc, res, &mtok->bpos);
+	if (rc != EOK)
+		return rc;
+
+	tok = preproc_tok_first(res);
+	while (tok != NULL) {
+		next = preproc_tok_next(tok, res);
+		if (tok->ttype == ppt_placemarker) {
+			list_remove(&tok->ltoks);
+		} else {
+			rc = preproc_hs_union(preproc, tok->hs, hs, &tok->hs);
+			if (rc != EOK)
+				return rc;
+		}
+
+		tok = next;
+	}
+
+	return EOK;
+}
+
+/** Expand built-in macro.
+ *
+ * @param preproc Preprocessor
+ * @param macro Macro
+ * @param mtok Macro name token
+ * @param res Token list to append the resulting token to
+ * @return EOK on success or an error code.
+ */
+static int preproc_builtin(preproc_t *preproc, preproc_macro_t *macro,
+    preproc_tok_t *mtok, list_t *res)
+{
+	preproc_tok_t *ntok;
+	char buf[16];
+	int rc;
+
+	switch (macro->builtin) {
+	case pmb_file:
+		rc = preproc_strlit_create(preproc,
+		    src_pos_fname(&mtok->bpos), &mtok->bpos, &ntok);
+		if (rc != EOK)
+			return rc;
+		break;
+	case pmb_line:
+		(void)snprintf(buf, sizeof(buf), "%lu",
+		    (unsigned long)mtok->bpos.line);
+		rc = preproc_tok_create(preproc->tarena, ppt_number, buf,
+		    strlen(buf), &mtok->bpos, &ntok);
+		if (rc != EOK)
+			return rc;
+		break;
+	default:
+		assert(false);
+		return EINVAL;
+	}
+
+	list_append(&ntok->ltoks, res);
+	return EOK;
+}
+
+/** Find opening parenthesis of a function-like macro invocation.
+ *
+ * @param preproc Preprocessor
+ * @param in Input tokens (following the macro name)
+ * @param more @c true to read more lines if needed
+ * @param rtok Place to store the parenthesis or @c NULL if the macro
+ *             name is not followed by one
+ * @return EOK on success or an error code.
+ */
+static int preproc_find_lparen(preproc_t *preproc, list_t *in, bool more,
+    preproc_tok_t **rtok)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *prev = NULL;
+	bool got;
+	int rc;
+
+	tok = preproc_tok_first(in);
+	while (true) {
+		if (tok == NULL) {
+			if (!more)
+				break;
+
+			rc = preproc_more(preproc, in, &got);
+			if (rc != EOK)
+				return rc;
+			if (!got)
+				break;
+
+			tok = prev != NULL ? preproc_tok_next(prev, in) :
+			    preproc_tok_first(in);
+			continue;
+		}
+
+		if (!preproc_tok_is_ws(tok))
+			break;
+
+		prev = tok;
+		tok = preproc_tok_next(tok, in);
+	}
+
+	if (tok != NULL && preproc_tok_is_punct(tok, "("))
+		*rtok = tok;
+	else
+		*rtok = NULL;
+
+	return EOK;
+}
+
+/** Strip leading and trailing whitespace from token list.
+ *
+ * @param toks Token list
+ */
+static void preproc_toks_strip(list_t *toks)
+{
+	preproc_tok_t *tok;
+
+	tok = preproc_tok_first(toks);
+	while (tok != NULL && preproc_tok_is_ws(tok)) {
+		list_remove(&tok->ltoks);
+		tok = preproc_tok_first(toks);
+	}
+
+	tok = preproc_tok_last(toks);
+	while (tok != NULL && preproc_tok_is_ws(tok)) {
+		list_remove(&tok->ltoks);
+		tok = preproc_tok_last(toks);
+	}
+}
+
+/** Collect arguments of function-like macro invocation.
+ *
+ * @param preproc Preprocessor
+ * @param macro Macro
+ * @param mtok Macro name token
+ * @param in Input tokens (following the opening parenthesis)
+ * @param more @c true to read more lines if needed
+ * @param rargs Place to store array of arguments
+ * @param rrparen Place to store closing parenthesis
+ * @return EOK on success or an error code.
+ */
+static int preproc_collect_args(preproc_t *preproc, preproc_macro_t *macro,
+    preproc_tok_t *mtok, list_t *in, bool more, list_t **rargs,
+    preproc_tok_t **rrparen)
+{
+	preproc_tok_t *tok;
+	list_t *args;
+	size_t nslots;
+	size_t nargs;
+	size_t i;
+	unsigned depth;
+	bool got;
+	int rc;
+
+	nslots = macro->nparams > 0 ? macro->nparams : 1;
+	args = arena_alloc(preproc->tarena, nslots * sizeof(list_t));
+	if (args == NULL)
+		return ENOMEM;
+
+	for (i = 0; i < nslots; i++)
+		list_initialize(&args[i]);
+
+	nargs = 1;
+	depth = 0;
+	while (true) {
+		tok = preproc_tok_first(in);
+		if (tok == NULL && more) {
+			rc = preproc_more(preproc, in, &got);
+			if (rc != EOK)
+				return rc;
+
+			if (got)
+				continue;
+		}
+
+		if (tok == NULL) {
+			if (preproc_msg(preproc)) {
+				(void)preproc_dprint_range(&mtok->bpos,
+				    &mtok->bpos, stderr);
+				(void)fprintf(stderr,
+				    ": Unterminated argument list "
+				    "invoking macro '%s'.\n", macro->name);
+			}
+			return EINVAL;
+		}
+
+		list_remove(&tok->ltoks);
+
+		if (preproc_tok_is_punct(tok, "(")) {
+			++depth;
+		} else if (preproc_tok_is_punct(tok, ")")) {
+			if (depth == 0)
+				break;
+			--depth;
+		} else if (preproc_tok_is_punct(tok, ",") && depth == 0 &&
+		    (!macro->variadic || nargs < macro->nparams)) {
+			++nargs;
+			continue;
+		}
+
+		if (nargs <= nslots)
+			list_append(&tok->ltoks, &args[nargs - 1]);
+	}
+
+	for (i = 0; i < nslots; i++)
+		preproc_toks_strip(&args[i]);
+
+	if (macro->nparams == 0 && nargs == 1 && list_empty(&args[0]))
+		nargs = 0;
+
+	/* Empty variable arguments */
+	if (macro->variadic && nargs + 1 == macro->nparams)
+		++nargs;
+
+	if (nargs != macro->nparams) {
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&mtok->bpos, &tok->bpos,
+			    stderr);
+			(void)fprintf(stderr,
+			    ": Macro '%s' passed %lu arguments, "
+			    "but takes %lu.\n", macro->name,
+			    (unsigned long)nargs,
+			    (unsigned long)macro->nparams);
+		}
+		return EINVAL;
+	}
+
+	*rargs = args;
+	*rrparen = tok;
+	return EOK;
+}
+
+/** Invoke macro.
+ *
+ * @param preproc Preprocessor
+ * @param macro Macro
+ * @param mtok Macro name token (removed from @a in)
+ * @param in Input tokens (following the macro name)
+ * @param more @c true to read more lines if needed
+ * @param rinvoked Place to store @c true if the macro was invoked
+ *                 (a function-like macro name not followed by '('
+ *                 is not an invocation)
+ * @return EOK on success or an error code.
+ */
+static int preproc_invoke(preproc_t *preproc, preproc_macro_t *macro,
+    preproc_tok_t *mtok, list_t *in, bool more, bool *rinvoked)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *lparen;
+	preproc_tok_t *rparen;
+	preproc_hs_t *hs;
+	list_t *args = NULL;
+	list_t res;
+	int rc;
+
+	list_initialize(&res);
+
+	if (macro->builtin != pmb_none) {
+		rc = preproc_builtin(preproc, macro, mtok, &res);
+		if (rc != EOK)
+			return rc;
+	} else if (!macro->funlike) {
+		rc = preproc_hs_add(preproc, mtok->hs, macro->name, &hs);
+		if (rc != EOK)
+			return rc;
+
+		rc = preproc_subst(preproc, macro, NULL, mtok, hs, &res);
+		if (rc != EOK)
+			return rc;
+	} else {
+		rc = preproc_find_lparen(preproc, in, more, &lparen);
+		if (rc != EOK)
+			return rc;
+
+		if (lparen == NULL) {
+			*rinvoked = false;
+			return EOK;
+		}
+
+		/* Remove tokens up to and including the parenthesis */
+		do {
+			tok = preproc_tok_first(in);
+			list_remove(&tok->ltoks);
+		} while (tok != lparen);
+
+		rc = preproc_collect_args(preproc, macro, mtok, in, more,
+		    &args, &rparen);
+		if (rc != EOK)
+			return rc;
+
+		rc = preproc_hs_intersect(preproc, mtok->hs, rparen->hs, &hs);
+		if (rc != EOK)
+			return rc;
+
+		rc = preproc_hs_add(preproc, hs, macro->name, &hs);
+		if (rc != EOK)
+			return rc;
+
+		rc = preproc_subst(preproc, macro, args, mtok, hs, &res);
+		if (rc != EOK)
+			return rc;
+	}
+
+	/* The expansion is positioned at the macro invocation */
+	tok = preproc_tok_first(&res);
+	while (tok != NULL) {
+		tok->expd = true;
+		tok->anchor = false;
+		tok->bpos = mtok->bpos;
+		tok = preproc_tok_next(tok, &res);
+	}
+
+	tok = preproc_tok_first(&res);
+	if (tok != NULL)
+		tok->anchor = true;
+
+	/* Rescan the expansion together with the rest of the input */
+	tok = preproc_tok_last(&res);
+	while (tok != NULL) {
+		list_remove(&tok->ltoks);
+		list_prepend(&tok->ltoks, in);
+		tok = preproc_tok_last(&res);
+	}
+
+	*rinvoked = true;
+	return EOK;
+}
+
+/** Macro-expand preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ * @param in Input tokens (consumed)
+ * @param out Token list to append the resulting tokens to
+ * @param more @c true to read more lines for function-like macro
+ *             invocations that continue beyond the end of @a in
+ * @return EOK on success or an error code.
+ */
+static int preproc_expand(preproc_t *preproc, list_t *in, list_t *out,
+    bool more)
+{
+	preproc_tok_t *tok;
+	preproc_macro_t *macro;
+	bool invoked;
+	int rc;
+
+	tok = preproc_tok_first(in);
+	while (tok != NULL) {
+		list_remove(&tok->ltoks);
+
+		if (tok->ttype == ppt_ident) {
+			macro = preproc_macro_find(preproc, tok->text);
+			if (macro != NULL &&
+			    !preproc_hs_contains(tok->hs, macro->name)) {
+				rc = preproc_invoke(preproc, macro, tok, in,
+				    more, &invoked);
+				if (rc != EOK)
+					return rc;
+
+				if (invoked) {
+					tok = preproc_tok_first(in);
+					continue;
+				}
+			}
+		}
+
+		list_append(&tok->ltoks, out);
+		tok = preproc_tok_first(in);
+	}
+
+	return EOK;
+}
+
+/** Determine if a space is needed between two adjacent tokens.
+ *
+ * When tokens produced by macro expansion are output next to each
+ * other, they must not merge into a different token.
+ *
+ * @param a Last character of the first token
+ * @param b First character of the second token
+ * @return @c true iff a space should be inserted
+ */
+static bool preproc_need_space(char a, char b)
+{
+	if ((is_idcnt(a) || a == '.') && (is_idcnt(b) || b == '.'))
+		return true;
+
+	if (a != '\0' && b != '\0' && strchr("+-*/%<>=!&|^#:", a) != NULL &&
+	    strchr("+-*/%<>=!&|^#:.", b) != NULL)
+		return true;
+
+	return false;
+}
+
+/** Output preprocessing tokens.
+ *
+ * @param preproc Preprocessor
+ * @param toks Tokens
+ * @return EOK on success or an error code.
+ */
+static int preproc_emit(preproc_t *preproc, list_t *toks)
+{
+	preproc_tok_t *tok;
+	src_pos_t cpos;
+	const char *cp;
+	char last = '\0';
+	bool last_expd = false;
+	int rc;
+
+	memset(&cpos, 0, sizeof(cpos));
+
+	tok = preproc_tok_first(toks);
+	while (tok != NULL) {
+		if (!tok->expd || tok->anchor)
+			cpos = tok->bpos;
+
+		cp = tok->text;
+		if (preproc_tok_is_ws(tok)) {
+			/* Whitespace in macro expansion becomes a space */
+			if (tok->expd)
+				cp = " ";
+			last = '\0';
+		} else {
+			if ((tok->expd || last_expd) &&
+			    preproc_need_space(last, cp[0])) {
+				rc = preproc_out_insert(preproc, ' ', &cpos);
+				if (rc != EOK)
+					return rc;
+				src_pos_fwd_char(&cpos, ' ');
+			}
+
+			last = cp[0] != '\0' ? cp[strlen(cp) - 1] : '\0';
+			last_expd = tok->expd;
+		}
+
+		while (*cp != '\0') {
+			rc = preproc_out_insert(preproc, *cp, &cpos);
+			if (rc != EOK)
+				return rc;
+
+			src_pos_fwd_char(&cpos, *cp);
+			++cp;
+		}
+
+		tok = preproc_tok_next(tok, toks);
+	}
+
+	return EOK;
+}
+
+/** Replace 'defined' operators in preprocessor expression.
+ *
+ * @param preproc Preprocessor
+ * @param toks Expression tokens
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_defined(preproc_t *preproc, list_t *toks)
+{
+	preproc_tok_t *tok;
+	preproc_tok_t *ntok;
+	preproc_tok_t *name;
+	preproc_tok_t *rparen = NULL;
+	preproc_tok_t *next;
+	const char *val;
+	int rc;
+
+	tok = preproc_tok_first(toks);
+	while (tok != NULL) {
+		if (tok->ttype != ppt_ident || strcmp(tok->text,
+		    "defined") != 0) {
+			tok = preproc_tok_next(tok, toks);
+			continue;
+		}
+
+		name = preproc_tok_skip_ws(preproc_tok_next(tok, toks), toks);
+		if (name != NULL && preproc_tok_is_punct(name, "(")) {
+			name = preproc_tok_skip_ws(preproc_tok_next(name,
+			    toks), toks);
+			rparen = name != NULL ? preproc_tok_skip_ws(
+			    preproc_tok_next(name, toks), toks) : NULL;
+			if (rparen == NULL || !preproc_tok_is_punct(rparen,
+			    ")")) {
+				preproc_error_at(preproc, &tok->bpos,
+				    "Missing ')' after 'defined'.");
+				return EINVAL;
+			}
+		} else {
+			rparen = name;
+		}
+
+		if (name == NULL || name->ttype != ppt_ident) {
+			preproc_error_at(preproc, &tok->bpos,
+			    "Operator 'defined' requires an identifier.");
+			return EINVAL;
+		}
+
+		val = preproc_macro_find(preproc, name->text) != NULL ?
+		    "1" : "0";
+		rc = preproc_tok_create(preproc->tarena, ppt_number, val, 1,
+		    &tok->bpos, &ntok);
+		if (rc != EOK)
+			return rc;
+
+		list_insert_before(&ntok->ltoks, &tok->ltoks);
+
+		/* Remove 'defined' through the name or parenthesis */
+		while (tok != rparen) {
+			next = preproc_tok_next(tok, toks);
+			list_remove(&tok->ltoks);
+			tok = next;
+		}
+
+		next = preproc_tok_next(rparen, toks);
+		list_remove(&rparen->ltoks);
+		tok = next;
+	}
+
+	return EOK;
+}
+
+/** Move to the next non-whitespace token in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ */
+static void preproc_expr_next(preproc_expr_t *expr)
+{
+	if (expr->tok != NULL) {
+		expr->pos = expr->tok->bpos;
+		expr->tok = preproc_tok_next(expr->tok, expr->toks);
+	}
+
+	expr->tok = preproc_tok_skip_ws(expr->tok, expr->toks);
+}
+
+/** Print error in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param msg Message
+ */
+static void preproc_expr_error(preproc_expr_t *expr, const char *msg)
+{
+	preproc_error_at(expr->preproc, expr->tok != NULL ?
+	    &expr->tok->bpos : &expr->pos, msg);
+}
+
+/** Evaluate integer constant in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param rval Place to store value
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_number(preproc_expr_t *expr, preproc_val_t *rval)
+{
+	const char *cp = expr->tok->text;
+	unsigned long v = 0;
+	unsigned base = 10;
+	unsigned digit;
+	unsigned nl = 0;
+	bool uns = false;
+
+	if (cp[0] == '0' && (cp[1] == 'x' || cp[1] == 'X')) {
+		base = 16;
+		cp += 2;
+		if (!is_hexdigit(*cp))
+			goto error;
+	} else if (cp[0] == '0') {
+		base = 8;
+	}
+
+	while (is_digit(*cp, (int)base)) {
+		if (base == 16)
+			digit = cc_hexdigit_val(*cp);
+		else
+			digit = cc_decdigit_val(*cp);
+		v = v * base + digit;
+		++cp;
+	}
+
+	while (*cp != '\0') {
+		if ((*cp == 'u' || *cp == 'U') && !uns)
+			uns = true;
+		else if ((*cp == 'l' || *cp == 'L') && nl < 2)
+			++nl;
+		else
+			goto error;
+		++cp;
+	}
+
+	/* Values that do not fit a signed long are unsigned */
+	if (v > (unsigned long)-1 / 2)
+		uns = true;
+
+	rval->v = v;
+	rval->uns = uns;
+	preproc_expr_next(expr);
+	return EOK;
+error:
+	preproc_expr_error(expr, "Invalid integer constant in preprocessor "
+	    "expression.");
+	return EINVAL;
+}
+
+/** Evaluate character constant in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param rval Place to store value
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_char(preproc_expr_t *expr, preproc_val_t *rval)
+{
+	const char *cp = expr->tok->text;
+	unsigned long v;
+
+	if (*cp == 'L')
+		++cp;
+	++cp;
+
+	if (*cp != '\\') {
+		v = (unsigned char)*cp;
+		++cp;
+	} else {
+		++cp;
+		switch (*cp) {
+		case 'a':
+			v = 7;
+			break;
+		case 'b':
+			v = 8;
+			break;
+		case 'f':
+			v = 12;
+			break;
+		case 'n':
+			v = 10;
+			break;
+		case 'r':
+			v = 13;
+			break;
+		case 't':
+			v = 9;
+			break;
+		case 'v':
+			v = 11;
+			break;
+		case 'x':
+			v = 0;
+			while (is_hexdigit(cp[1])) {
+				v = v * 16 + cc_hexdigit_val(cp[1]);
+				++cp;
+			}
+			break;
+		default:
+			if (is_octdigit(*cp)) {
+				v = 0;
+				while (is_octdigit(*cp)) {
+					v = v * 8 + cc_octdigit_val(*cp);
+					++cp;
+				}
+				--cp;
+			} else {
+				v = (unsigned char)*cp;
+			}
+			break;
+		}
+
+		++cp;
+	}
+
+	if (*cp != '\'') {
+		preproc_expr_error(expr, "Invalid character constant in "
+		    "preprocessor expression.");
+		return EINVAL;
+	}
+
+	rval->v = v;
+	rval->uns = false;
+	preproc_expr_next(expr);
+	return EOK;
+}
+
+static int preproc_expr_cond(preproc_expr_t *, bool, preproc_val_t *);
+
+/** Evaluate unary expression in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param eval @c false if the value is not needed (no errors then)
+ * @param rval Place to store value
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_unary(preproc_expr_t *expr, bool eval,
+    preproc_val_t *rval)
+{
+	preproc_tok_t *tok = expr->tok;
+	int rc;
+
+	if (tok == NULL) {
+		preproc_expr_error(expr, "Unexpected end of preprocessor "
+		    "expression.");
+		return EINVAL;
+	}
+
+	switch (tok->ttype) {
+	case ppt_number:
+		return preproc_expr_number(expr, rval);
+	case ppt_charlit:
+		return preproc_expr_char(expr, rval);
+	case ppt_ident:
+		/* Identifiers that are not macros evaluate to 0 */
+		rval->v = 0;
+		rval->uns = false;
+		preproc_expr_next(expr);
+		return EOK;
+	case ppt_punct:
+		break;
+	default:
+		goto error;
+	}
+
+	if (preproc_tok_is_punct(tok, "(")) {
+		preproc_expr_next(expr);
+		rc = preproc_expr_cond(expr, eval, rval);
+		if (rc != EOK)
+			return rc;
+
+		if (expr->tok == NULL || !preproc_tok_is_punct(expr->tok,
+		    ")")) {
+			preproc_expr_error(expr, "Expected ')' in "
+			    "preprocessor expression.");
+			return EINVAL;
+		}
+
+		preproc_expr_next(expr);
+		return EOK;
+	}
+
+	if (!preproc_tok_is_punct(tok, "+") && !preproc_tok_is_punct(tok,
+	    "-") && !preproc_tok_is_punct(tok, "~") &&
+	    !preproc_tok_is_punct(tok, "!"))
+		goto error;
+
+	preproc_expr_next(expr);
+	rc = preproc_expr_unary(expr, eval, rval);
+	if (rc != EOK)
+		return rc;
+
+	switch (tok->text[0]) {
+	case '-':
+		rval->v = 0 - rval->v;
+		break;
+	case '~':
+		rval->v = ~rval->v;
+		break;
+	case '!':
+		rval->v = rval->v == 0 ? 1 : 0;
+		rval->uns = false;
+		break;
+	default:
+		break;
+	}
+
+	return EOK;
+error:
+	preproc_expr_error(expr, "Invalid preprocessor expression.");
+	return EINVAL;
+}
+
+/** Apply binary operator in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param op Operator
+ * @param eval @c false if the value is not needed (no errors then)
+ * @param a Left operand
+ * @param b Right operand
+ * @param rval Place to store result
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_binop(preproc_expr_t *expr, const char *op,
+    bool eval, preproc_val_t *a, preproc_val_t *b, preproc_val_t *rval)
+{
+	bool uns;
+	bool t;
+	long sa;
+	long sb;
+	unsigned long v;
+
+	uns = a->uns || b->uns;
+	sa = (long)a->v;
+	sb = (long)b->v;
+
+	if (strcmp(op, "<<") == 0 || strcmp(op, ">>") == 0) {
+		/* Result has the type of the left operand */
+		uns = a->uns;
+		if (b->v >= sizeof(unsigned long) * 8) {
+			v = 0;
+			if (op[0] == '>' && !uns && sa < 0)
+				v = ~(unsigned long)0;
+		} else if (op[0] == '<') {
+			v = a->v << b->v;
+		} else if (uns || sa >= 0) {
+			v = a->v >> b->v;
+		} else {
+			v = ~(~a->v >> b->v);
+		}
+	} else if (strcmp(op, "*") == 0) {
+		v = a->v * b->v;
+	} else if (strcmp(op, "/") == 0 || strcmp(op, "%") == 0) {
+		if (b->v == 0) {
+			if (eval) {
+				preproc_error_at(expr->preproc, &expr->pos,
+				    "Division by zero in preprocessor "
+				    "expression.");
+				return EINVAL;
+			}
+
+			v = 0;
+		} else if (uns) {
+			v = op[0] == '/' ? a->v / b->v : a->v % b->v;
+		} else if (sb == -1) {
+			/* Avoid overflow */
+			v = op[0] == '/' ? 0 - a->v : 0;
+		} else {
+			v = (unsigned long)(op[0] == '/' ? sa / sb : sa % sb);
+		}
+	} else if (strcmp(op, "+") == 0) {
+		v = a->v + b->v;
+	} else if (strcmp(op, "-") == 0) {
+		v = a->v - b->v;
+	} else if (strcmp(op, "&") == 0) {
+		v = a->v & b->v;
+	} else if (strcmp(op, "^") == 0) {
+		v = a->v ^ b->v;
+	} else if (strcmp(op, "|") == 0) {
+		v = a->v | b->v;
+	} else {
+		/* Comparison and logical operators yield signed 0 or 1 */
+		if (strcmp(op, "&&") == 0)
+			t = a->v != 0 && b->v != 0;
+		else if (strcmp(op, "||") == 0)
+			t = a->v != 0 || b->v != 0;
+		else if (strcmp(op, "==") == 0)
+			t = a->v == b->v;
+		else if (strcmp(op, "!=") == 0)
+			t = a->v != b->v;
+		else if (strcmp(op, "<") == 0)
+			t = uns ? a->v < b->v : sa < sb;
+		else if (strcmp(op, ">") == 0)
+			t = uns ? a->v > b->v : sa > sb;
+		else if (strcmp(op, "<=") == 0)
+			t = uns ? a->v <= b->v : sa <= sb;
+		else
+			t = uns ? a->v >= b->v : sa >= sb;
+		v = t ? 1 : 0;
+		uns = false;
+	}
+
+	rval->v = v;
+	rval->uns = uns;
+	return EOK;
+}
+
+/** Get precedence of binary operator.
+ *
+ * @param tok Token or @c NULL
+ * @return Precedence or 0 if @a tok is not a binary operator
+ */
+static int preproc_binop_prec(preproc_tok_t *tok)
+{
+	size_t i;
+
+	if (tok == NULL || tok->ttype != ppt_punct)
+		return 0;
+
+	for (i = 0; i < sizeof(preproc_binops) / sizeof(preproc_binops[0]);
+	    i++) {
+		if (strcmp(tok->text, preproc_binops[i].op) == 0)
+			return preproc_binops[i].prec;
+	}
+
+	return 0;
+}
+
+/** Evaluate binary expression in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param minprec Minimum precedence of operators to consume
+ * @param eval @c false if the value is not needed (no errors then)
+ * @param rval Place to store value
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_binary(preproc_expr_t *expr, int minprec, bool eval,
+    preproc_val_t *rval)
+{
+	preproc_tok_t *optok;
+	preproc_val_t rhs;
+	bool reval;
+	int prec;
+	int rc;
+
+	rc = preproc_expr_unary(expr, eval, rval);
+	if (rc != EOK)
+		return rc;
+
+	while (true) {
+		optok = expr->tok;
+		prec = preproc_binop_prec(optok);
+		if (prec == 0 || prec < minprec)
+			break;
+
+		preproc_expr_next(expr);
+
+		/* Short-circuit evaluation */
+		reval = eval;
+		if (strcmp(optok->text, "&&") == 0 && rval->v == 0)
+			reval = false;
+		if (strcmp(optok->text, "||") == 0 && rval->v != 0)
+			reval = false;
+
+		rc = preproc_expr_binary(expr, prec + 1, reval, &rhs);
+		if (rc != EOK)
+			return rc;
+
+		rc = preproc_expr_binop(expr, optok->text, eval, rval, &rhs,
+		    rval);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Evaluate conditional expression in preprocessor expression.
+ *
+ * @param expr Expression evaluator
+ * @param eval @c false if the value is not needed (no errors then)
+ * @param rval Place to store value
+ * @return EOK on success or an error code.
+ */
+static int preproc_expr_cond(preproc_expr_t *expr, bool eval,
+    preproc_val_t *rval)
+{
+	preproc_val_t a;
+	preproc_val_t b;
+	bool cond;
+	int rc;
+
+	rc = preproc_expr_binary(expr, 1, eval, rval);
+	if (rc != EOK)
+		return rc;
+
+	if (expr->tok == NULL || !preproc_tok_is_punct(expr->tok, "?"))
+		return EOK;
+
+	cond = rval->v != 0;
+	preproc_expr_next(expr);
+
+	rc = preproc_expr_cond(expr, eval && cond, &a);
+	if (rc != EOK)
+		return rc;
+
+	if (expr->tok == NULL || !preproc_tok_is_punct(expr->tok, ":")) {
+		preproc_expr_error(expr, "Expected ':' in preprocessor "
+		    "expression.");
+		return EINVAL;
+	}
+
+	preproc_expr_next(expr);
+
+	rc = preproc_expr_cond(expr, eval && !cond, &b);
+	if (rc != EOK)
+		return rc;
+
+	if (cond)
+		*rval = a;
+	else
+		*rval = b;
+
+	rval->uns = a.uns || b.uns;
+	return EOK;
+}
+
+/** Process condition expression.
+ *
+ * Reads the rest of the line, evaluates the 'defined' operators,
+ * expands macros and evaluates the resulting integer constant
+ * expression.
+ *
+ * @param preproc Preprocessor
+ * @param rresult Place to store @c true iff the condition is true
+ * @return EOK on success or an error code.
+ */
+static int preproc_process_condition(preproc_t *preproc, bool *rresult)
+{
+	preproc_expr_t expr;
+	preproc_val_t val;
+	list_t toks;
+	list_t etoks;
+	src_pos_t pos;
+	int rc;
+
+	pos = preproc->cur->pos;
+
+	rc = preproc_tokens_begin(preproc);
+	if (rc != EOK)
+		return rc;
+
+	list_initialize(&toks);
+	list_initialize(&etoks);
+
+	rc = preproc_lex_line(preproc, &toks);
+	if (rc != EOK)
+		goto error;
+
+	rc = preproc_expr_defined(preproc, &toks);
+	if (rc != EOK)
+		goto error;
+
+	rc = preproc_expand(preproc, &toks, &etoks, false);
+	if (rc != EOK)
+		goto error;
+
+	expr.preproc = preproc;
+	expr.toks = &etoks;
+	expr.pos = pos;
+	expr.tok = preproc_tok_skip_ws(preproc_tok_first(&etoks), &etoks);
+
+	if (expr.tok == NULL) {
+		preproc_error_at(preproc, &pos, "Expected condition.");
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = preproc_expr_cond(&expr, true, &val);
+	if (rc != EOK)
+		goto error;
+
+	if (expr.tok != NULL) {
+		preproc_expr_error(&expr, "Invalid conditional expression.");
+		rc = EINVAL;
+		goto error;
+	}
+
+	preproc_tokens_end(preproc);
+	*rresult = val.v != 0;
+	return EOK;
+error:
+	preproc_tokens_end(preproc);
+	return rc;
+}
+
+/** Process invalid directive and print diagnostics.
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success or an error code
+ */
+static int preproc_process_invalid_directive(preproc_t *preproc)
+{
+	src_pos_t spos;
+	char *p;
+	int rc;
+
+	if (preproc->skipping) {
+		rc = preproc_skip_to_end_of_line(preproc);
+		if (rc != EOK)
+			return rc;
+
+		preproc->state = pps_line_begin;
+		return EOK;
+	}
+
+	 spos = preproc->cur->pos;
+	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
+		p = preproc_chars(preproc);
+		if (!is_idcnt(p[0]))
+			break;
+
+		preproc_advance(preproc, 1);
+	}
+
+	if (preproc_msg(preproc)) {
+		(void)preproc_dprint_range(&spos, &preproc->cur->pos, stderr);
+		(void)fprintf(stderr, ": Invalid preprocessor directive.\n");
+	}
+
+	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
+		p = preproc_chars(preproc);
+		if (p[0] == '\n')
+			break;
+
+		preproc_advance(preproc, 1);
 	}
 
 	if (preproc_is_error(preproc))
 		return EIO;
 
-	preproc->state = pps_line_begin;
-	return EOK;
+	preproc->state = pps_line_begin;
+	return EOK;
+}
+
+static int preproc_end_of_file_checks(preproc_t *preproc)
+{
+	preproc_condition_t *cond;
+
+	cond = preproc_top_condition(preproc);
+	if (cond != NULL) {
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&cond->bpos, &cond->epos,
+			    stderr);
+			(void)fprintf(stderr,
+			    ": Unterminated #if/#ifdef/#ifndef.\n");
+		}
+		return EINVAL;
+	}
+
+	return EOK;
+}
+
+/** Compute header cache bucket.
+ *
+ * @param path Normalized path name
+ * @return Bucket index
+ */
+static size_t preproc_hdr_hash(const char *path)
+{
+	return (size_t)(preproc_str_hash(path) % preproc_hdr_buckets);
+}
+
+/** Find header cache entry.
+ *
+ * @param preproc Preprocessor
+ * @param path Normalized path name
+ * @return Header cache entry or @c NULL if not found
+ */
+static preproc_hdr_t *preproc_hdr_find(preproc_t *preproc, const char *path)
+{
+	list_t *bucket;
+	link_t *link;
+	preproc_hdr_t *hdr;
+
+	bucket = &preproc->hdrs[preproc_hdr_hash(path)];
+	link = list_first(bucket);
+	while (link != NULL) {
+		hdr = list_get_instance(link, preproc_hdr_t, lhdrs);
+		if (strcmp(hdr->path, path) == 0)
+			return hdr;
+
+		link = list_next(link, bucket);
+	}
+
+	return NULL;
+}
+
+/** Create header cache entry.
+ *
+ * @param preproc Preprocessor
+ * @param path Normalized path name
+ * @param exists @c true if the file exists
+ * @param rhdr Place to store pointer to new header cache entry
+ * @return EOK on success or an error code
+ */
+static int preproc_hdr_create(preproc_t *preproc, const char *path,
+    bool exists, preproc_hdr_t **rhdr)
+{
+	preproc_hdr_t *hdr;
+
+	hdr = calloc(1, sizeof(preproc_hdr_t));
+	if (hdr == NULL)
+		return ENOMEM;
+
+	hdr->path = strdup(path);
+	if (hdr->path == NULL) {
+		free(hdr);
+		return ENOMEM;
+	}
+
+	hdr->exists = exists;
+	list_append(&hdr->lhdrs, &preproc->hdrs[preproc_hdr_hash(path)]);
+	*rhdr = hdr;
+	return EOK;
+}
+
+/** Determine if including header again can be skipped.
+ *
+ * @param preproc Preprocessor
+ * @param hdr Header cache entry
+ * @return @c true if the header contains #pragma once or it is wrapped
+ *         in an include guard whose macro is defined
+ */
+static bool preproc_hdr_skip(preproc_t *preproc, preproc_hdr_t *hdr)
+{
+	if (hdr->once)
+		return true;
+
+	return hdr->guard != NULL &&
+	    preproc_macro_find(preproc, hdr->guard) != NULL;
+}
+
+/** Note text line for the purpose of include guard detection.
+ *
+ * @param preproc Preprocessor
+ * @param toks Tokens of the line
+ */
+static void preproc_mi_text(preproc_t *preproc, list_t *toks)
+{
+	preproc_tok_t *tok;
+
+	if (preproc->cur->mi_state == pmi_inside ||
+	    preproc->cur->mi_state == pmi_none)
+		return;
+
+	tok = preproc_tok_skip_ws(preproc_tok_first(toks), toks);
+	if (tok != NULL)
+		preproc->cur->mi_state = pmi_none;
+}
+
+/** Note #elif or #else for the purpose of include guard detection.
+ *
+ * An include guard cannot have alternative groups.
+ *
+ * @param preproc Preprocessor
+ */
+static void preproc_mi_alt_group(preproc_t *preproc)
+{
+	if (preproc->cur->mi_state == pmi_inside &&
+	    preproc->nconditions == preproc->cur->mi_depth)
+		preproc->cur->mi_state = pmi_none;
+}
+
+/** Finish include guard detection at the end of an input file.
+ *
+ * If the file turned out to be wrapped in an include guard, remember
+ * the guard macro in the header cache.
+ *
+ * @param preproc Preprocessor
+ */
+static void preproc_mi_finish(preproc_t *preproc)
+{
+	preproc_input_t *input = preproc->cur;
+
+	if (input->hdr == NULL || input->mi_state != pmi_after)
+		return;
+
+	if (input->hdr->guard != NULL)
+		free(input->hdr->guard);
+	input->hdr->guard = input->mi_guard;
+	input->mi_guard = NULL;
+}
+
+/** Remove all macros except built-in ones.
+ *
+ * @param preproc Preprocessor
+ */
+static void preproc_macros_clear(preproc_t *preproc)
+{
+	preproc_macro_t *macro;
+	link_t *link;
+	link_t *next;
+	size_t i;
+
+	for (i = 0; i < preproc_macro_buckets; i++) {
+		link = list_first(&preproc->macros[i]);
+		while (link != NULL) {
+			next = list_next(link, &preproc->macros[i]);
+			macro = list_get_instance(link, preproc_macro_t,
+			    lmacros);
+			if (macro->builtin == pmb_none)
+				preproc_macro_destroy(macro);
+			link = next;
+		}
+	}
+}
+
+/** Load macro from precompiled header.
+ *
+ * @param preproc Preprocessor
+ * @param rd Reader
+ * @return EOK on success, EINVAL if data is invalid, ENOMEM if out
+ *         of memory
+ */
+static int preproc_pch_load_macro(preproc_t *preproc, pch_rd_t *rd)
+{
+	preproc_macro_t *macro = NULL;
+	preproc_tok_t *tok;
+	const char *text;
+	src_pos_t bpos;
+	uint32_t nparams;
+	uint32_t ntoks;
+	uint32_t pidx;
+	uint32_t i;
+	uint8_t ttype;
+	int rc;
+
+	text = pch_rd_str(rd);
+	if (rd->error)
+		return EINVAL;
+
+	rc = preproc_macro_create(preproc, text, &macro);
+	if (rc != EOK)
+		return rc;
+
+	macro->funlike = pch_rd_u8(rd) != 0;
+	macro->variadic = pch_rd_u8(rd) != 0;
+
+	nparams = pch_rd_u32(rd);
+	for (i = 0; i < nparams && !rd->error; i++) {
+		rc = preproc_macro_add_param(macro, pch_rd_str(rd));
+		if (rc != EOK)
+			goto error;
+	}
+
+	ntoks = pch_rd_u32(rd);
+	for (i = 0; i < ntoks && !rd->error; i++) {
+		ttype = pch_rd_u8(rd);
+		text = pch_rd_str(rd);
+		pidx = pch_rd_u32(rd);
+		rc = pch_rd_pos(rd, &bpos);
+		if (rc != EOK)
+			goto error;
+
+		if (ttype > (uint8_t)ppt_placemarker ||
+		    (ttype == (uint8_t)ppt_param && pidx >= macro->nparams)) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		rc = preproc_tok_create(preproc->marena,
+		    (preproc_toktype_t)ttype, text, strlen(text), &bpos, &tok);
+		if (rc != EOK)
+			goto error;
+
+		tok->pidx = (size_t)pidx;
+		list_append(&tok->ltoks, &macro->body);
+	}
+
+	if (rd->error || preproc_macro_find(preproc, macro->name) != NULL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	preproc_macro_insert(macro);
+	return EOK;
+error:
+	preproc_macro_destroy(macro);
+	return rc;
+}
+
+/** Load preprocessor state from precompiled header.
+ *
+ * Replaces all macro definitions with those that were in effect
+ * at the end of the precompiled header and updates the header cache.
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success, EINVAL if precompiled header is corrupted,
+ *         ENOMEM if out of memory
+ */
+static int preproc_pch_load(preproc_t *preproc)
+{
+	pch_rd_t rd;
+	preproc_hdr_t *hdr;
+	const char *path;
+	const char *guard;
+	uint32_t nmacros;
+	uint32_t nhdrs;
+	uint32_t i;
+	bool exists;
+	bool once;
+	int rc;
+
+	pch_pp_reader(preproc->pch, &rd);
+	preproc_macros_clear(preproc);
+
+	nmacros = pch_rd_u32(&rd);
+	for (i = 0; i < nmacros && !rd.error; i++) {
+		rc = preproc_pch_load_macro(preproc, &rd);
+		if (rc != EOK)
+			goto error;
+	}
+
+	nhdrs = pch_rd_u32(&rd);
+	for (i = 0; i < nhdrs && !rd.error; i++) {
+		path = pch_rd_str(&rd);
+		exists = pch_rd_u8(&rd) != 0;
+		once = pch_rd_u8(&rd) != 0;
+		guard = pch_rd_optstr(&rd);
+		if (rd.error)
+			break;
+
+		hdr = preproc_hdr_find(preproc, path);
+		if (hdr == NULL) {
+			rc = preproc_hdr_create(preproc, path, exists, &hdr);
+			if (rc != EOK)
+				goto error;
+		}
+
+		hdr->once = hdr->once || once;
+		if (guard != NULL) {
+			if (hdr->guard != NULL)
+				free(hdr->guard);
+			hdr->guard = strdup(guard);
+			if (hdr->guard == NULL) {
+				rc = ENOMEM;
+				goto error;
+			}
+		}
+	}
+
+	if (rd.error) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	return EOK;
+error:
+	if (rc == EINVAL && preproc_msg(preproc))
+		(void)fprintf(stderr, "Precompiled header is corrupted.\n");
+	return rc;
+}
+
+/** Prepare for generating a precompiled header.
+ *
+ * Enters the main input into the header cache so that its include
+ * guard or #pragma once gets recorded.
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success or an error code
+ */
+int preproc_pch_prepare(preproc_t *preproc)
+{
+	preproc_hdr_t *hdr;
+	char *path;
+	int rc;
+
+	assert(preproc->cur != NULL);
+	assert(preproc->cur->in_fname != NULL);
+
+	path = pathname_normalize(preproc->cur->in_fname);
+	if (path == NULL)
+		return ENOMEM;
+
+	hdr = preproc_hdr_find(preproc, path);
+	if (hdr == NULL) {
+		rc = preproc_hdr_create(preproc, path, true, &hdr);
+		if (rc != EOK) {
+			free(path);
+			return rc;
+		}
+	}
+
+	preproc->cur->hdr = hdr;
+	free(path);
+	return EOK;
+}
+
+/** Save preprocessor state into precompiled header.
+ *
+ * Saves all macro definitions (except built-in macros) and the header
+ * cache. Every header in the cache is recorded as a dependency
+ * of the precompiled header.
+ *
+ * @param preproc Preprocessor (that has processed its entire input)
+ * @param pch Precompiled header
+ * @return EOK on success or an error code
+ */
+int preproc_pch_save(preproc_t *preproc, pch_t *pch)
+{
+	pch_wr_t *wr = pch_pp_writer(pch);
+	preproc_macro_t *macro;
+	preproc_hdr_t *hdr;
+	preproc_tok_t *tok;
+	link_t *link;
+	uint32_t n;
+	size_t i;
+	size_t j;
+	int rc;
+
+	n = 0;
+	for (i = 0; i < preproc_macro_buckets; i++) {
+		link = list_first(&preproc->macros[i]);
+		while (link != NULL) {
+			macro = list_get_instance(link, preproc_macro_t,
+			    lmacros);
+			if (macro->builtin == pmb_none)
+				++n;
+			link = list_next(link, &preproc->macros[i]);
+		}
+	}
+
+	pch_wr_u32(wr, n);
+	for (i = 0; i < preproc_macro_buckets; i++) {
+		link = list_first(&preproc->macros[i]);
+		while (link != NULL) {
+			macro = list_get_instance(link, preproc_macro_t,
+			    lmacros);
+			link = list_next(link, &preproc->macros[i]);
+			if (macro->builtin != pmb_none)
+				continue;
+
+			pch_wr_str(wr, macro->name);
+			pch_wr_u8(wr, macro->funlike ? 1 : 0);
+			pch_wr_u8(wr, macro->variadic ? 1 : 0);
+			pch_wr_u32(wr, (uint32_t)macro->nparams);
+			for (j = 0; j < macro->nparams; j++)
+				pch_wr_str(wr, macro->params[j]);
+
+			pch_wr_u32(wr, (uint32_t)list_count(&macro->body));
+			tok = preproc_tok_first(&macro->body);
+			while (tok != NULL) {
+				pch_wr_u8(wr, (uint8_t)tok->ttype);
+				pch_wr_str(wr, tok->text);
+				pch_wr_u32(wr, (uint32_t)tok->pidx);
+				pch_wr_pos(wr, &tok->bpos);
+				tok = preproc_tok_next(tok, &macro->body);
+			}
+		}
+	}
+
+	n = 0;
+	for (i = 0; i < preproc_hdr_buckets; i++)
+		n += (uint32_t)list_count(&preproc->hdrs[i]);
+
+	pch_wr_u32(wr, n);
+	for (i = 0; i < preproc_hdr_buckets; i++) {
+		link = list_first(&preproc->hdrs[i]);
+		while (link != NULL) {
+			hdr = list_get_instance(link, preproc_hdr_t, lhdrs);
+			pch_wr_str(wr, hdr->path);
+			pch_wr_u8(wr, hdr->exists ? 1 : 0);
+			pch_wr_u8(wr, hdr->once ? 1 : 0);
+			pch_wr_optstr(wr, hdr->guard);
+
+			rc = pch_add_dep(pch, hdr->path);
+			if (rc != EOK)
+				return rc;
+
+			link = list_next(link, &preproc->hdrs[i]);
+		}
+	}
+
+	return wr->error ? ENOMEM : EOK;
+}
+
+/** Set precompiled header to use.
+ *
+ * The precompiled header is used if its source header is included
+ * by the very first directive of the main input.
+ *
+ * @param preproc Preprocessor
+ * @param pch Precompiled header
+ */
+void preproc_set_pch(preproc_t *preproc, pch_t *pch)
+{
+	preproc->pch = pch;
+	preproc->pch_pending = true;
 }
 
-static int preproc_end_of_file_checks(preproc_t *preproc)
+/** Determine if precompiled header has been used.
+ *
+ * @param preproc Preprocessor
+ * @return @c true iff the precompiled header was used instead
+ *         of processing its source header
+ */
+bool preproc_pch_used(preproc_t *preproc)
 {
-	preproc_condition_t *cond;
+	return preproc->pch_used;
+}
 
-	cond = preproc_top_condition(preproc);
-	if (cond != NULL) {
-		(void)preproc_dprint_range(&cond->bpos, &cond->epos, stderr);
-		(void)fprintf(stderr, ": Unterminated #if/#ifdef/#ifndef.\n");
-		return EINVAL;
-	}
+/** Set preprocessor quiet mode.
+ *
+ * In quiet mode diagnostic messages are not printed, only counted.
+ *
+ * @param preproc Preprocessor
+ * @param quiet @c true to suppress printing diagnostic messages
+ */
+void preproc_set_quiet(preproc_t *preproc, bool quiet)
+{
+	preproc->quiet = quiet;
+}
 
-	return EOK;
+/** Return number of diagnostic messages reported by preprocessor.
+ *
+ * This includes messages that were suppressed in quiet mode.
+ *
+ * @param preproc Preprocessor
+ * @return Number of diagnostic messages
+ */
+unsigned preproc_ndiags(preproc_t *preproc)
+{
+	return preproc->ndiags;
 }
 
 /** Look for an included file relative to the specified directory.
@@ -721,6 +3899,8 @@ static int preproc_include_from_dir(preproc_t *preproc, const char *dirname,
 	FILE *file = NULL;
 	file_input_t *finput = NULL;
 	char *hdrname = NULL;
+	char *path = NULL;
+	preproc_hdr_t *hdr;
 	int rc;
 
 	hdrname = pathname_compose(dirname, file_name);
@@ -729,12 +3909,60 @@ static int preproc_include_from_dir(preproc_t *preproc, const char *dirname,
 		goto error;
 	}
 
-	file = fopen(hdrname, "rt");
+	path = pathname_normalize(hdrname);
+	if (path == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Use precompiled header instead of processing the header? */
+	if (preproc->pch_pending &&
+	    strcmp(path, pch_hdr_path(preproc->pch)) == 0) {
+		preproc->pch_pending = false;
+		rc = preproc_pch_load(preproc);
+		if (rc != EOK)
+			goto error;
+
+		preproc->pch_used = true;
+		free(hdrname);
+		free(path);
+		return EOK;
+	}
+
+	hdr = preproc_hdr_find(preproc, path);
+	if (hdr != NULL) {
+		if (!hdr->exists) {
+			rc = ENOENT;
+			goto error;
+		}
+
+		/* Header would not produce anything. Do not reopen it. */
+		if (preproc_hdr_skip(preproc, hdr)) {
+			free(hdrname);
+			free(path);
+			return EOK;
+		}
+	}
+
+	file = fopen(path, "rt");
 	if (file == NULL) {
+		/* Remember that the file does not exist. */
+		if (hdr == NULL) {
+			rc = preproc_hdr_create(preproc, path, false, &hdr);
+			if (rc != EOK)
+				goto error;
+		}
+
 		rc = ENOENT;
 		goto error;
 	}
 
+	if (hdr == NULL) {
+		rc = preproc_hdr_create(preproc, path, true, &hdr);
+		if (rc != EOK)
+			goto error;
+	}
+
 	rc = file_input_create(file, file_name, &finput);
 	if (rc != EOK)
 		goto error;
@@ -744,11 +3972,15 @@ static int preproc_include_from_dir(preproc_t *preproc, const char *dirname,
 	if (rc != EOK)
 		goto error;
 
+	preproc->cur->hdr = hdr;
 	free(hdrname);
+	free(path);
 	return EOK;
 error:
 	if (hdrname != NULL)
 		free(hdrname);
+	if (path != NULL)
+		free(path);
 	if (finput != NULL)
 		file_input_destroy(finput);
 	if (file != NULL)
@@ -824,23 +4056,43 @@ static int preproc_include(preproc_t *preproc, preproc_include_type_t inctype,
 {
 	char *dirname = NULL;
 	const char *incldir;
+	preproc_incldir_t *idir;
+	link_t *link;
 	int rc;
 
-	/* For #include "header" look in the source C file's directory. */
+	/*
+	 * For #include "header" look in the including file's directory
+	 * first.
+	 */
 	if (inctype == pit_quoted) {
-		dirname = pathname_get_dirname(preproc->cur->in_fname);
+		if (preproc->cur->hdr != NULL) {
+			dirname = pathname_get_dirname(
+			    preproc->cur->hdr->path);
+		} else {
+			dirname = pathname_get_dirname(
+			    preproc->cur->in_fname);
+		}
 		if (dirname == NULL) {
 			rc = ENOMEM;
 			goto error;
 		}
 
 		rc = preproc_include_from_dir(preproc, dirname, file_name);
-		if (rc != EOK && rc != ENOENT)
-			goto error;
-
 		free(dirname);
 		dirname = NULL;
-		return EOK;
+		if (rc != ENOENT)
+			return rc;
+	}
+
+	/* Then look in the additional include directories. */
+	link = list_first(&preproc->incldirs);
+	while (link != NULL) {
+		idir = list_get_instance(link, preproc_incldir_t, lincldirs);
+		rc = preproc_include_from_dir(preproc, idir->dir, file_name);
+		if (rc != ENOENT)
+			return rc;
+
+		link = list_next(link, &preproc->incldirs);
 	}
 
 	if (preproc->incldir != NULL)
@@ -850,6 +4102,12 @@ static int preproc_include(preproc_t *preproc, preproc_include_type_t inctype,
 
 	/* Always look in the compiler's include directory list. */
 	rc = preproc_include_from_dir(preproc, incldir, file_name);
+	if (rc == ENOENT && preproc_msg(preproc)) {
+		(void)preproc_dprint_range(&preproc->cur->pos,
+		    &preproc->cur->pos, stderr);
+		(void)fprintf(stderr, ": Cannot find header '%s'.\n",
+		    file_name);
+	}
 	if (rc != EOK)
 		goto error;
 
@@ -890,7 +4148,8 @@ static int preproc_process_macro_name(preproc_t *preproc, char **rname)
 			break;
 
 		if (buf_pos >= preproc_macro_name_buf_size - 1) {
-			(void)fprintf(stderr, "Macro name too long.\n");
+			if (preproc_msg(preproc))
+				(void)fprintf(stderr, "Macro name too long.\n");
 			rc = EINVAL;
 			goto error;
 		}
@@ -919,7 +4178,7 @@ error:
  */
 static int preproc_process_define(preproc_t *preproc)
 {
-	char *macro_name = NULL;
+	list_t toks;
 	int rc;
 
 	preproc_advance(preproc, 6);
@@ -933,40 +4192,21 @@ static int preproc_process_define(preproc_t *preproc)
 		return EOK;
 	}
 
-	rc = preproc_process_ws(preproc);
-	if (rc != EOK)
-		goto error;
-
-	if (preproc_is_eof(preproc)) {
-		preproc_error_macro_name(preproc);
-		rc = EINVAL;
-		goto error;
-	}
-
-	if (preproc_is_error(preproc)) {
-		rc = EIO;
-		goto error;
-	}
-
-	rc = preproc_process_macro_name(preproc, &macro_name);
+	rc = preproc_tokens_begin(preproc);
 	if (rc != EOK)
-		goto error;
+		return rc;
 
-	rc = preproc_process_ws_eol(preproc);
-	if (rc != EOK)
-		goto error;
+	list_initialize(&toks);
+	rc = preproc_lex_line(preproc, &toks);
+	if (rc == EOK)
+		rc = preproc_define_toks(preproc, &toks);
 
-	rc = preproc_macro_add(preproc, macro_name);
+	preproc_tokens_end(preproc);
 	if (rc != EOK)
-		goto error;
+		return rc;
 
 	preproc->state = pps_line_begin;
-	free(macro_name);
 	return EOK;
-error:
-	if (macro_name != NULL)
-		free(macro_name);
-	return rc;
 }
 
 /** Process elif directive.
@@ -980,12 +4220,19 @@ static int preproc_process_elif(preproc_t *preproc)
 	preproc_condition_t *cond;
 	src_pos_t bpos;
 	bool cond_result = false;
+	bool was_skipping;
+	bool taken;
 	int rc;
 
 	bpos = preproc->cur->pos;
 	preproc_advance(preproc, 4);
 
-	if (preproc->skipping) {
+	/*
+	 * The condition is only evaluated if no previous group has been
+	 * taken (and we are not inside a skipped group).
+	 */
+	old_cond = preproc_top_condition(preproc);
+	if (old_cond != NULL && (old_cond->was_skipping || old_cond->taken)) {
 		rc = preproc_skip_to_end_of_line(preproc);
 		if (rc != EOK)
 			return rc;
@@ -1008,42 +4255,47 @@ static int preproc_process_elif(preproc_t *preproc)
 		rc = preproc_process_condition(preproc, &cond_result);
 		if (rc != EOK)
 			goto error;
-
-		rc = preproc_process_ws_eol(preproc);
-		if (rc != EOK)
-			goto error;
 	}
 
-	old_cond = preproc_top_condition(preproc);
 	if (old_cond == NULL) {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": Unmatched #elif.\n");
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr, ": Unmatched #elif.\n");
+		}
 		rc = EINVAL;
 		goto error;
 	}
 
 	if (old_cond->has_else) {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": #elif after #else for condition "
-		    "starting at ");
-		(void)preproc_dprint_range(&old_cond->bpos, &old_cond->epos,
-		    stderr);
-		(void)fprintf(stderr, ".\n");
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr,
+			    ": #elif after #else for condition "
+			    "starting at ");
+			(void)preproc_dprint_range(&old_cond->bpos,
+			    &old_cond->epos, stderr);
+			(void)fprintf(stderr, ".\n");
+		}
 		rc = EINVAL;
 		goto error;
 	}
 
+	was_skipping = old_cond->was_skipping;
+	taken = old_cond->taken;
 	preproc_pop_condition(preproc);
 
 	cond = preproc_push_condition(preproc, &bpos, &preproc->cur->pos,
-	    preproc->skipping);
+	    was_skipping);
 	if (cond == NULL) {
 		rc = ENOMEM;
 		goto error;
 	}
 
-	if (!preproc->skipping)
-		preproc->skipping = !cond_result;
+	cond->taken = taken || cond_result;
+	preproc->skipping = was_skipping || taken || !cond_result;
+	preproc_mi_alt_group(preproc);
 
 	preproc->state = pps_line_begin;
 	return EOK;
@@ -1078,18 +4330,25 @@ static int preproc_process_else(preproc_t *preproc)
 
 	cond = preproc_top_condition(preproc);
 	if (cond == NULL) {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": Unmatched #else.\n");
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr, ": Unmatched #else.\n");
+		}
 		rc = EINVAL;
 		goto error;
 	}
 
 	if (cond->has_else) {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": Second #else for condition "
-		    "starting at ");
-		(void)preproc_dprint_range(&cond->bpos, &cond->epos, stderr);
-		(void)fprintf(stderr, ".\n");
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr, ": Second #else for condition "
+			    "starting at ");
+			(void)preproc_dprint_range(&cond->bpos, &cond->epos,
+			    stderr);
+			(void)fprintf(stderr, ".\n");
+		}
 		rc = EINVAL;
 		goto error;
 	}
@@ -1098,7 +4357,9 @@ static int preproc_process_else(preproc_t *preproc)
 	cond->else_bpos = bpos;
 	cond->else_epos = preproc->cur->pos;
 
-	preproc->skipping = !preproc->skipping;
+	preproc->skipping = cond->was_skipping || cond->taken;
+	cond->taken = true;
+	preproc_mi_alt_group(preproc);
 	preproc->state = pps_line_begin;
 	return EOK;
 error:
@@ -1131,14 +4392,22 @@ static int preproc_process_endif(preproc_t *preproc)
 
 	cond = preproc_top_condition(preproc);
 	if (cond == NULL) {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": Unmatched #endif.\n");
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr, ": Unmatched #endif.\n");
+		}
 		rc = EINVAL;
 		goto error;
 	}
 
 	preproc->skipping = cond->was_skipping;
 	preproc_pop_condition(preproc);
+
+	if (preproc->cur->mi_state == pmi_inside &&
+	    preproc->nconditions < preproc->cur->mi_depth)
+		preproc->cur->mi_state = pmi_after;
+
 	preproc->state = pps_line_begin;
 	return EOK;
 error:
@@ -1163,10 +4432,12 @@ static int preproc_process_error(preproc_t *preproc)
 		if (rc != EOK)
 			return rc;
 	} else {
-		(void)preproc_dprint_range(&bpos, &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": #error");
-
-		(void)preproc_dump_to_end_of_line(preproc, stderr);
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&bpos, &preproc->cur->pos,
+			    stderr);
+			(void)fprintf(stderr, ": #error");
+			(void)preproc_dump_to_end_of_line(preproc, stderr);
+		}
 
 		rc = EINVAL;
 		goto error;
@@ -1228,10 +4499,6 @@ static int preproc_process_if(preproc_t *preproc)
 	if (rc != EOK)
 		goto error;
 
-	rc = preproc_process_ws_eol(preproc);
-	if (rc != EOK)
-		goto error;
-
 	cond = preproc_push_condition(preproc, &bpos, &preproc->cur->pos,
 	    preproc->skipping);
 	if (cond == NULL) {
@@ -1240,6 +4507,7 @@ static int preproc_process_if(preproc_t *preproc)
 	}
 
 	preproc->skipping = !cond_result;
+	cond->taken = cond_result;
 
 	preproc->state = pps_line_begin;
 	return EOK;
@@ -1312,6 +4580,7 @@ static int preproc_process_ifdef(preproc_t *preproc)
 	macro = preproc_macro_find(preproc, macro_name);
 	if (macro == NULL)
 		preproc->skipping = true;
+	cond->taken = macro != NULL;
 
 	free(macro_name);
 	preproc->state = pps_line_begin;
@@ -1325,9 +4594,10 @@ error:
 /** Process ifndef directive.
  *
  * @param preproc Preprocessor
+ * @param guard @c true if this directive might start an include guard
  * @return EOK on success or an error code.
  */
-static int preproc_process_ifndef(preproc_t *preproc)
+static int preproc_process_ifndef(preproc_t *preproc, bool guard)
 {
 	char *macro_name = NULL;
 	preproc_condition_t *cond;
@@ -1387,6 +4657,15 @@ static int preproc_process_ifndef(preproc_t *preproc)
 	macro = preproc_macro_find(preproc, macro_name);
 	if (macro != NULL)
 		preproc->skipping = true;
+	cond->taken = macro == NULL;
+
+	if (guard) {
+		/* Candidate include guard */
+		preproc->cur->mi_state = pmi_inside;
+		preproc->cur->mi_guard = macro_name;
+		preproc->cur->mi_depth = preproc->nconditions;
+		macro_name = NULL;
+	}
 
 	free(macro_name);
 	preproc->state = pps_line_begin;
@@ -1397,6 +4676,94 @@ error:
 	return rc;
 }
 
+/** Process include directive with macro-expanded header name.
+ *
+ * @param preproc Preprocessor
+ * @return EOK on success or an error code.
+ */
+static int preproc_process_include_macro(preproc_t *preproc)
+{
+	preproc_include_type_t inctype;
+	preproc_tok_t *tok;
+	list_t toks;
+	list_t etoks;
+	src_pos_t pos;
+	int rc;
+
+	pos = preproc->cur->pos;
+
+	rc = preproc_tokens_begin(preproc);
+	if (rc != EOK)
+		return rc;
+
+	list_initialize(&toks);
+	list_initialize(&etoks);
+
+	rc = preproc_lex_line(preproc, &toks);
+	if (rc != EOK)
+		goto error;
+
+	rc = preproc_expand(preproc, &toks, &etoks, false);
+	if (rc != EOK)
+		goto error;
+
+	rc = preproc_sbuf_clear(preproc);
+	if (rc != EOK)
+		goto error;
+
+	tok = preproc_tok_skip_ws(preproc_tok_first(&etoks), &etoks);
+	if (tok != NULL && tok->ttype == ppt_strlit && tok->text[0] == '"') {
+		inctype = pit_quoted;
+		rc = preproc_sbuf_adds(preproc, tok->text + 1);
+		if (rc != EOK)
+			goto error;
+
+		preproc->sbuf[--preproc->sbuf_used] = '\0';
+	} else if (tok != NULL && preproc_tok_is_punct(tok, "<")) {
+		inctype = pit_angled;
+		tok = preproc_tok_next(tok, &etoks);
+		while (tok != NULL && !preproc_tok_is_punct(tok, ">")) {
+			rc = preproc_sbuf_adds(preproc, preproc_tok_is_ws(tok) ?
+			    " " : tok->text);
+			if (rc != EOK)
+				goto error;
+
+			tok = preproc_tok_next(tok, &etoks);
+		}
+
+		if (tok == NULL) {
+			preproc_error_at(preproc, &pos,
+			    "Missing terminating '>' character.");
+			rc = EINVAL;
+			goto error;
+		}
+	} else {
+		preproc_error_at(preproc, &pos, "Expected <header-name> or "
+		    "\"header-name\".");
+		rc = EINVAL;
+		goto error;
+	}
+
+	tok = preproc_tok_skip_ws(preproc_tok_next(tok, &etoks), &etoks);
+	if (tok != NULL) {
+		preproc_error_at(preproc, &tok->bpos,
+		    "Unexpected characters at end of line.");
+		rc = EINVAL;
+		goto error;
+	}
+
+	rc = preproc_include(preproc, inctype, preproc->sbuf);
+	if (rc != EOK)
+		goto error;
+
+	preproc_tokens_end(preproc);
+	preproc->state = pps_line_begin;
+	return EOK;
+error:
+	preproc_tokens_end(preproc);
+	return rc;
+}
+
 /** Process include directive.
  *
  * @param preproc Preprocessor
@@ -1449,9 +4816,9 @@ static int preproc_process_include(preproc_t *preproc)
 		delim = '"';
 		break;
 	default:
-		preproc_error_header_name(preproc);
-		rc = EINVAL;
-		goto error;
+		/* Header name produced by macro expansion */
+		free(fname);
+		return preproc_process_include_macro(preproc);
 	}
 
 	buf_pos = 0;
@@ -1462,7 +4829,10 @@ static int preproc_process_include(preproc_t *preproc)
 			break;
 
 		if (buf_pos >= preproc_fname_buf_size - 1) {
-			(void)fprintf(stderr, "Include filename too long.\n");
+			if (preproc_msg(preproc)) {
+				(void)fprintf(stderr, "Include filename "
+				    "too long.\n");
+			}
 			rc = EINVAL;
 			goto error;
 		}
@@ -1477,10 +4847,12 @@ static int preproc_process_include(preproc_t *preproc)
 	}
 
 	if (p[0] != delim) {
-		(void)preproc_dprint_range(&preproc->cur->pos,
-		    &preproc->cur->pos, stderr);
-		(void)fprintf(stderr, ": Missing terminating '%c' "
-		    "character.\n", delim);
+		if (preproc_msg(preproc)) {
+			(void)preproc_dprint_range(&preproc->cur->pos,
+			    &preproc->cur->pos, stderr);
+			(void)fprintf(stderr, ": Missing terminating '%c' "
+			    "character.\n", delim);
+		}
 		rc = EINVAL;
 		goto error;
 	}
@@ -1505,17 +4877,44 @@ error:
 	return rc;
 }
 
+/** Determine if pragma in line buffer is #pragma once.
+ *
+ * @param preproc Preprocessor
+ * @return @c true if line buffer contains 'pragma once'
+ */
+static bool preproc_pragma_is_once(preproc_t *preproc)
+{
+	const char *lp = preproc->lbuf;
+	const char *end = preproc->lbuf + preproc->lbuf_used;
+
+	/* Skip 'pragma' */
+	lp += 6;
+	while (lp < end && (*lp == ' ' || *lp == '\t'))
+		++lp;
+
+	if (end - lp < 4 || strncmp(lp, "once", 4) != 0)
+		return false;
+	lp += 4;
+
+	while (lp < end && (*lp == ' ' || *lp == '\t'))
+		++lp;
+
+	return lp == end || *lp == '\n';
+}
+
 /** Process pragma directive.
+ *
+ * The pragma is passed on to the compiler without macro expansion.
  *
  * @param preproc Preprocessor
  * @return EOK on success or an error code.
  */
 static int preproc_process_pragma(preproc_t *preproc)
 {
+	src_pos_t pos;
+	size_t i;
 	int rc;
 
-	preproc_advance(preproc, 6);
-
 	if (preproc->skipping) {
 		rc = preproc_skip_to_end_of_line(preproc);
 		if (rc != EOK)
@@ -1525,8 +4924,32 @@ static int preproc_process_pragma(preproc_t *preproc)
 		return EOK;
 	}
 
-	preproc->state = pps_copy_pragma;
-	preproc->pragma_pos = 0;
+	pos = preproc->cur->pos;
+	preproc->lbuf_used = 0;
+	rc = preproc_read_line(preproc);
+	if (rc != EOK)
+		return rc;
+
+	if (preproc_pragma_is_once(preproc)) {
+		/* Handled by the preprocessor, not passed to the compiler */
+		if (preproc->cur->hdr != NULL)
+			preproc->cur->hdr->once = true;
+		preproc->state = pps_line_begin;
+		return EOK;
+	}
+
+	rc = preproc_out_insert(preproc, '#', &pos);
+	if (rc != EOK)
+		return rc;
+
+	for (i = 0; i < preproc->lbuf_used; i++) {
+		rc = preproc_out_insert(preproc, preproc->lbuf[i],
+		    &preproc->lposbuf[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
+	preproc->state = pps_line_begin;
 	return EOK;
 }
 
@@ -1576,9 +4999,8 @@ static int preproc_process_undef(preproc_t *preproc)
 		goto error;
 
 	macro = preproc_macro_find(preproc, macro_name);
-	if (macro != NULL) {
-		preproc_macro_remove(macro);
-	}
+	if (macro != NULL)
+		preproc_macro_destroy(macro);
 
 	free(macro_name);
 	preproc->state = pps_line_begin;
@@ -1597,6 +5019,7 @@ error:
 static int preproc_process_directive(preproc_t *preproc)
 {
 	char *p;
+	bool mi_start;
 	int rc;
 
 	/* Skip '#'. */
@@ -1607,6 +5030,23 @@ static int preproc_process_directive(preproc_t *preproc)
 	if (rc != EOK)
 		return rc;
 
+	/*
+	 * Only #ifndef at the very beginning of the file can start
+	 * an include guard. Any other directive outside of the guard
+	 * means the file is not wrapped in one.
+	 */
+	mi_start = preproc->cur->mi_state == pmi_start;
+	if (preproc->cur->mi_state != pmi_inside)
+		preproc->cur->mi_state = pmi_none;
+
+	/*
+	 * Precompiled header can only stand in for a header included
+	 * by the very first directive of the main input.
+	 */
+	if (!mi_start ||
+	    list_first(&preproc->inputs) != &preproc->cur->linputs)
+		preproc->pch_pending = false;
+
 	p = preproc_chars(preproc);
 
 	switch (p[0]) {
@@ -1644,7 +5084,7 @@ static int preproc_process_directive(preproc_t *preproc)
 		}
 		if (p[1] == 'f' && p[2] == 'n' && p[3] == 'd' &&
 		    p[4] == 'e' && p[5] == 'f' && !is_idcnt(p[6])) {
-			return preproc_process_ifndef(preproc);
+			return preproc_process_ifndef(preproc, mi_start);
 		}
 		if (p[1] == 'n' && p[2] == 'c' && p[3] == 'l' &&
 		    p[4] == 'u' && p[5] == 'd' && p[6] == 'e' &&
@@ -1715,14 +5155,17 @@ static int preproc_process_line_begin(preproc_t *preproc)
 }
 
 /** Process in text line state.
+ *
+ * The line is split into preprocessing tokens, macro-expanded
+ * and written to the output buffer.
  *
  * @param preproc Preprocessor
  * @return EOK on success or an error code.
  */
 static int preproc_process_text_line(preproc_t *preproc)
 {
-	char *p;
-	char c;
+	list_t toks;
+	list_t etoks;
 	int rc;
 
 	if (preproc->skipping) {
@@ -1734,53 +5177,33 @@ static int preproc_process_text_line(preproc_t *preproc)
 		return EOK;
 	}
 
-	while (!preproc_is_eof(preproc) && !preproc_is_error(preproc)) {
-		p = preproc_chars(preproc);
-		c = p[0];
-
-		preproc_out_buf_insert(preproc, c, &preproc->cur->pos);
-
-		preproc_advance(preproc, 1);
-		if (c == '\n') {
-			preproc->state = pps_line_begin;
-			break;
-		}
-
-		if (!preproc_out_buf_avail(preproc))
-			break;
-	}
-
-	if (preproc_is_error(preproc))
-		return EIO;
-
-	return EOK;
-}
+	rc = preproc_tokens_begin(preproc);
+	if (rc != EOK)
+		return rc;
 
-/** Process in copy pragma state.
- *
- * @param preproc Preprocessor
- * @return EOK on success or an error code.
- */
-static int preproc_process_copy_pragma(preproc_t *preproc)
-{
-	const char *pragma = "#pragma";
+	list_initialize(&toks);
+	list_initialize(&etoks);
 
-	assert(!preproc->skipping);
+	rc = preproc_lex_line(preproc, &toks);
+	if (rc != EOK)
+		goto error;
 
-	while (preproc->pragma_pos < 7) {
-		preproc_out_buf_insert(preproc, pragma[preproc->pragma_pos],
-		    &preproc->cur->pos);
-		++preproc->pragma_pos;
+	preproc_mi_text(preproc, &toks);
 
-		if (!preproc_out_buf_avail(preproc))
-			break;
-	}
+	rc = preproc_expand(preproc, &toks, &etoks, true);
+	if (rc != EOK)
+		goto error;
 
-	if (preproc->pragma_pos >= 7) {
-		preproc->state = pps_text_line;
-	}
+	rc = preproc_emit(preproc, &etoks);
+	if (rc != EOK)
+		goto error;
 
+	preproc_tokens_end(preproc);
+	preproc->state = pps_line_begin;
 	return EOK;
+error:
+	preproc_tokens_end(preproc);
+	return rc;
 }
 
 /** Process some input.
@@ -1797,14 +5220,15 @@ static int preproc_process(preproc_t *preproc)
 		return preproc_process_line_begin(preproc);
 	case pps_text_line:
 		return preproc_process_text_line(preproc);
-	case pps_copy_pragma:
-		return preproc_process_copy_pragma(preproc);
 	}
 
 	return EINVAL;
 }
 
 /** Lexer input from preprocessor.
+ *
+ * Each chunk of characters returned has contiguous source positions,
+ * so that the lexer can track positions of macro expansions.
  *
  * @param arg Argument (preproc_t *)
  * @param buf Character buffer
@@ -1817,17 +5241,22 @@ static int preproc_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
     src_pos_t *bpos)
 {
 	preproc_t *preproc = (preproc_t *)arg;
+	src_pos_t pos;
 	size_t nbytes;
 	int rc;
 
-	while (preproc->out_buf_used == 0 && preproc->cur != NULL &&
-	    !preproc_is_error(preproc)) {
+	while (preproc->obuf_rpos == preproc->obuf_used &&
+	    preproc->cur != NULL && !preproc_is_error(preproc)) {
+		preproc->obuf_rpos = 0;
+		preproc->obuf_used = 0;
+
 		/* Reached end of file. */
 		if (preproc_is_eof(preproc)) {
 			rc = preproc_end_of_file_checks(preproc);
 			if (rc != EOK)
 				return rc;
 
+			preproc_mi_finish(preproc);
 			preproc_pop_input(preproc);
 			if (preproc->cur == NULL)
 				break;
@@ -1841,21 +5270,29 @@ static int preproc_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 	if (preproc->cur != NULL && preproc_is_error(preproc))
 		return EIO;
 
-	if (bsize < preproc->out_buf_used)
-		nbytes = bsize;
-	else
-		nbytes = preproc->out_buf_used;
+	nbytes = 0;
+	if (preproc->obuf_rpos < preproc->obuf_used) {
+		pos = preproc->oposbuf[preproc->obuf_rpos];
+		*bpos = pos;
 
-	memcpy(buf, preproc->out_buf, nbytes);
-	preproc->out_buf_used -= nbytes;
+		while (nbytes < bsize &&
+		    preproc->obuf_rpos + nbytes < preproc->obuf_used) {
+			if (!src_pos_same(&pos,
+			    &preproc->oposbuf[preproc->obuf_rpos + nbytes]))
+				break;
 
-	*bpos = preproc->out_posbuf[0];
-	*nread = nbytes;
+			src_pos_fwd_char(&pos,
+			    preproc->obuf[preproc->obuf_rpos + nbytes]);
+			++nbytes;
+		}
 
-	memcpy(preproc->out_buf, preproc->out_buf + nbytes,
-	    preproc->out_buf_used);
-	memcpy(preproc->out_posbuf, preproc->out_posbuf + nbytes,
-	    preproc->out_buf_used * sizeof(src_pos_t));
+		memcpy(buf, preproc->obuf + preproc->obuf_rpos, nbytes);
+		preproc->obuf_rpos += nbytes;
+		preproc->opos = pos;
+	} else {
+		*bpos = preproc->opos;
+	}
 
+	*nread = nbytes;
 	return EOK;
 }
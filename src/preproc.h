@@ -27,7 +27,9 @@
 #ifndef PREPROC_H
 #define PREPROC_H
 
+#include <stdbool.h>
 #include <types/lexer.h>
+#include <types/pch.h>
 #include <types/preproc.h>
 
 extern lexer_input_ops_t lexer_preproc_input;
@@ -36,5 +38,12 @@ extern int preproc_create(const char *, lexer_input_ops_t *, void *,
     preproc_t **);
 extern void preproc_destroy(preproc_t *);
 extern int preproc_set_incldir(preproc_t *, const char *);
+extern int preproc_add_incldir(preproc_t *, const char *);
+extern int preproc_pch_prepare(preproc_t *);
+extern int preproc_pch_save(preproc_t *, pch_t *);
+extern void preproc_set_pch(preproc_t *, pch_t *);
+extern bool preproc_pch_used(preproc_t *);
+extern void preproc_set_quiet(preproc_t *, bool);
+extern unsigned preproc_ndiags(preproc_t *);
 
 #endif
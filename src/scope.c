@@ -30,6 +30,25 @@
 #include <stdlib.h>
 #include <string.h>
 
+/** Compute hash of an identifier.
+ *
+ * @param ident Identifier
+ * @return Hash (32-bit FNV-1a)
+ */
+static unsigned long scope_hash(const char *ident)
+{
+	unsigned long h;
+
+	h = 2166136261UL;
+	while (*ident != '\0') {
+		h ^= (unsigned char)*ident;
+		h = (h * 16777619UL) & 0xffffffffUL;
+		++ident;
+	}
+
+	return h;
+}
+
 /** Create new identifier scope.
  *
  * @param parent Parent scope
@@ -44,6 +63,13 @@ int scope_create(scope_t *parent, scope_t **rscope)
 	if (scope == NULL)
 		return ENOMEM;
 
+	scope->buckets = calloc(scope_init_buckets, sizeof(scope_member_t *));
+	if (scope->buckets == NULL) {
+		free(scope);
+		return ENOMEM;
+	}
+
+	scope->nbuckets = scope_init_buckets;
 	scope->parent = parent;
 	list_initialize(&scope->members);
 	*rscope = scope;
@@ -87,9 +113,78 @@ void scope_destroy(scope_t *scope)
 		member = scope_first(scope);
 	}
 
+	free(scope->buckets);
 	free(scope);
 }
 
+/** Double the number of hash buckets in a scope.
+ *
+ * @param scope Scope
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int scope_grow(scope_t *scope)
+{
+	scope_member_t **nbuckets;
+	scope_member_t *member;
+	scope_member_t *next;
+	size_t nb;
+	size_t i;
+	size_t j;
+
+	nb = scope->nbuckets * 2;
+	if (nb / 2 != scope->nbuckets)
+		return ENOMEM;
+
+	nbuckets = calloc(nb, sizeof(scope_member_t *));
+	if (nbuckets == NULL)
+		return ENOMEM;
+
+	for (i = 0; i < scope->nbuckets; i++) {
+		member = scope->buckets[i];
+		while (member != NULL) {
+			next = member->hnext;
+			j = (size_t)(member->hash & (nb - 1));
+			member->hnext = nbuckets[j];
+			nbuckets[j] = member;
+			member = next;
+		}
+	}
+
+	free(scope->buckets);
+	scope->buckets = nbuckets;
+	scope->nbuckets = nb;
+	return EOK;
+}
+
+/** Add new member to scope.
+ *
+ * Append the member to the list of members (preserving declaration
+ * order) and enter it into the hash table.
+ *
+ * @param scope Scope
+ * @param member New member
+ */
+static void scope_add_member(scope_t *scope, scope_member_t *member)
+{
+	size_t b;
+
+	member->scope = scope;
+	member->hash = scope_hash(member->tident->text);
+	list_append(&member->lmembers, &scope->members);
+
+	/*
+	 * If we fail to grow the table, we just keep using the current one
+	 * with a higher load factor.
+	 */
+	if (scope->nmembers >= scope->nbuckets)
+		(void)scope_grow(scope);
+
+	b = (size_t)(member->hash & (scope->nbuckets - 1));
+	member->hnext = scope->buckets[b];
+	scope->buckets[b] = member;
+	++scope->nmembers;
+}
+
 /** Insert global symbol to identifier scope.
  *
  * @param scope Scope
@@ -125,9 +220,8 @@ int scope_insert_gsym(scope_t *scope, lexer_tok_t *tident, cgtype_t *cgtype,
 	member->tident = tident;
 	member->cgtype = dtype;
 	member->mtype = sm_gsym;
-	member->scope = scope;
 	member->m.gsym.symbol = symbol;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 	return EOK;
 }
 
@@ -175,8 +269,7 @@ int scope_insert_arg(scope_t *scope, lexer_tok_t *tident, cgtype_t *cgtype,
 	member->cgtype = dtype;
 	member->mtype = sm_arg;
 	member->m.arg.vident = dvident;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 	return EOK;
 }
 
@@ -227,8 +320,7 @@ int scope_insert_lvar(scope_t *scope, lexer_tok_t *tident, cgtype_t *cgtype,
 	member->mtype = sm_lvar;
 	member->m.lvar.vident = dvident;
 	member->m.lvar.lval_array_arg = lvalue_array_arg;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 	return EOK;
 }
 
@@ -265,8 +357,7 @@ int scope_insert_tdef(scope_t *scope, lexer_tok_t *tident, cgtype_t *cgtype)
 	member->tident = tident;
 	member->cgtype = dtype;
 	member->mtype = sm_tdef;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 	return EOK;
 }
 
@@ -309,8 +400,7 @@ int scope_insert_record(scope_t *scope, lexer_tok_t *tident,
 	member->mtype = sm_record;
 	member->m.record.srtype = srtype;
 	member->m.record.record = record;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 
 	if (rmember != NULL)
 		*rmember = member;
@@ -354,8 +444,7 @@ int scope_insert_enum(scope_t *scope, lexer_tok_t *tident,
 	member->cgtype = &etype->cgtype;
 	member->mtype = sm_enum;
 	member->m.menum.cgenum = cgenum;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 
 	if (rmember != NULL)
 		*rmember = member;
@@ -392,8 +481,7 @@ int scope_insert_eelem(scope_t *scope, lexer_tok_t *tident,
 	member->cgtype = etype;
 	member->mtype = sm_eelem;
 	member->m.eelem.eelem = eelem;
-	member->scope = scope;
-	list_append(&member->lmembers, &scope->members);
+	scope_add_member(scope, member);
 
 	if (rmember != NULL)
 		*rmember = member;
@@ -441,14 +529,17 @@ scope_member_t *scope_next(scope_member_t *cur)
 scope_member_t *scope_lookup_local(scope_t *scope, const char *ident)
 {
 	scope_member_t *member;
+	unsigned long hash;
 
-	member = scope_first(scope);
+	hash = scope_hash(ident);
+	member = scope->buckets[hash & (scope->nbuckets - 1)];
 	while (member != NULL) {
-		if (strcmp(member->tident->text, ident) == 0 &&
+		if (member->hash == hash &&
+		    strcmp(member->tident->text, ident) == 0 &&
 		    member->mtype != sm_record && member->mtype != sm_enum)
 			return member;
 
-		member = scope_next(member);
+		member = member->hnext;
 	}
 
 	return NULL;
@@ -463,15 +554,18 @@ scope_member_t *scope_lookup_local(scope_t *scope, const char *ident)
 scope_member_t *scope_lookup_tag_local(scope_t *scope, const char *ident)
 {
 	scope_member_t *member;
+	unsigned long hash;
 
-	member = scope_first(scope);
+	hash = scope_hash(ident);
+	member = scope->buckets[hash & (scope->nbuckets - 1)];
 	while (member != NULL) {
-		if (strcmp(member->tident->text, ident) == 0 &&
+		if (member->hash == hash &&
+		    strcmp(member->tident->text, ident) == 0 &&
 		    (member->mtype == sm_record ||
 		    member->mtype == sm_enum))
 			return member;
 
-		member = scope_next(member);
+		member = member->hnext;
 	}
 
 	return NULL;
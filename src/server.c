@@ -0,0 +1,981 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Compile server
+ *
+ * The server listens on a local (UNIX domain) socket. A client sends
+ * a request consisting of its current working directory and command-line
+ * arguments. The server replies with the output produced while processing
+ * the request (a sequence of standard output / standard error output
+ * messages) followed by the exit status.
+ *
+ * All integers are sent as 32-bit big-endian numbers. A string is sent
+ * as its length followed by the characters (without terminating null).
+ * A request is: cwd, argc, argv[0] ... argv[argc - 1]. A reply message
+ * is a type byte (server_msg_xxx), data length and data.
+ *
+ * Sockets are only available when the host provides them
+ * (HAVE_UNIX_SOCKETS is defined). Otherwise server_supported() returns
+ * @c false and all other functions fail with ENOTSUP.
+ */
+
+#include <merrno.h>
+#include <server.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_UNIX_SOCKETS
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/** Determine if compile server is supported.
+ *
+ * @return @c true iff compile server can be used
+ */
+bool server_supported(void)
+{
+#ifdef HAVE_UNIX_SOCKETS
+	return true;
+#else
+	return false;
+#endif
+}
+
+#ifdef HAVE_UNIX_SOCKETS
+
+/** Write data to socket.
+ *
+ * @param fd Socket
+ * @param data Data
+ * @param size Size of data in bytes
+ * @return EOK on success, EIO on error
+ */
+static int server_send(int fd, const void *data, size_t size)
+{
+	const char *dp = (const char *)data;
+	ssize_t nw;
+
+	while (size > 0) {
+		/* Do not get killed by SIGPIPE if peer went away */
+		nw = send(fd, dp, size, MSG_NOSIGNAL);
+		if (nw < 0 && errno == EINTR)
+			continue;
+		if (nw <= 0)
+			return EIO;
+
+		dp += nw;
+		size -= (size_t)nw;
+	}
+
+	return EOK;
+}
+
+/** Read data from socket.
+ *
+ * @param fd Socket
+ * @param data Buffer
+ * @param size Number of bytes to read
+ * @return EOK on success, EIO on error or premature end of data
+ */
+static int server_recv(int fd, void *data, size_t size)
+{
+	char *dp = (char *)data;
+	ssize_t nr;
+
+	while (size > 0) {
+		nr = read(fd, dp, size);
+		if (nr < 0 && errno == EINTR)
+			continue;
+		if (nr <= 0)
+			return EIO;
+
+		dp += nr;
+		size -= (size_t)nr;
+	}
+
+	return EOK;
+}
+
+/** Write 32-bit integer to socket.
+ *
+ * @param fd Socket
+ * @param val Value
+ * @return EOK on success, EIO on error
+ */
+static int server_send_u32(int fd, uint32_t val)
+{
+	uint8_t buf[4];
+
+	buf[0] = (val >> 24) & 0xff;
+	buf[1] = (val >> 16) & 0xff;
+	buf[2] = (val >> 8) & 0xff;
+	buf[3] = val & 0xff;
+
+	return server_send(fd, buf, sizeof(buf));
+}
+
+/** Read 32-bit integer from socket.
+ *
+ * @param fd Socket
+ * @param rval Place to store value
+ * @return EOK on success, EIO on error
+ */
+static int server_recv_u32(int fd, uint32_t *rval)
+{
+	uint8_t buf[4];
+	int rc;
+
+	rc = server_recv(fd, buf, sizeof(buf));
+	if (rc != EOK)
+		return rc;
+
+	*rval = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+	    ((uint32_t)buf[2] << 8) | buf[3];
+	return EOK;
+}
+
+/** Write string to socket.
+ *
+ * @param fd Socket
+ * @param str String
+ * @return EOK on success, EIO on error
+ */
+static int server_send_str(int fd, const char *str)
+{
+	size_t len;
+	int rc;
+
+	len = strlen(str);
+	rc = server_send_u32(fd, (uint32_t)len);
+	if (rc != EOK)
+		return rc;
+
+	return server_send(fd, str, len);
+}
+
+/** Read string from socket.
+ *
+ * @param fd Socket
+ * @param rstr Place to store pointer to newly allocated string
+ * @return EOK on success, EIO on error or invalid data, ENOMEM if out
+ *         of memory
+ */
+static int server_recv_str(int fd, char **rstr)
+{
+	uint32_t len;
+	char *str;
+	int rc;
+
+	rc = server_recv_u32(fd, &len);
+	if (rc != EOK)
+		return rc;
+
+	if (len > server_max_str)
+		return EIO;
+
+	str = malloc(len + 1);
+	if (str == NULL)
+		return ENOMEM;
+
+	rc = server_recv(fd, str, len);
+	if (rc != EOK) {
+		free(str);
+		return rc;
+	}
+
+	str[len] = '\0';
+	*rstr = str;
+	return EOK;
+}
+
+/** Write reply message to socket.
+ *
+ * @param fd Socket
+ * @param mtype Message type (server_msg_xxx)
+ * @param data Message data
+ * @param size Size of message data in bytes
+ * @return EOK on success, EIO on error
+ */
+static int server_send_msg(int fd, char mtype, const void *data, size_t size)
+{
+	int rc;
+
+	rc = server_send(fd, &mtype, 1);
+	if (rc != EOK)
+		return rc;
+
+	rc = server_send_u32(fd, (uint32_t)size);
+	if (rc != EOK)
+		return rc;
+
+	return server_send(fd, data, size);
+}
+
+/** Fill in socket address.
+ *
+ * @param path Socket path
+ * @param addr Socket address to fill in
+ * @return EOK on success, EINVAL if path is too long
+ */
+static int server_sockaddr(const char *path, struct sockaddr_un *addr)
+{
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+
+	if (strlen(path) >= sizeof(addr->sun_path)) {
+		(void)fprintf(stderr, "Socket path '%s' is too long.\n", path);
+		return EINVAL;
+	}
+
+	strncpy(addr->sun_path, path, sizeof(addr->sun_path) - 1);
+	return EOK;
+}
+
+/** Create compile server.
+ *
+ * A stale socket left over from a previous server at @a path
+ * is removed. The socket is only accessible by the current user.
+ *
+ * @param path Socket path
+ * @param rserver Place to store pointer to new server
+ * @return EOK on success, ENOMEM if out of memory, EEXIST if @a path
+ *         exists and is not a socket, EIO if socket cannot be created
+ */
+int server_create(const char *path, server_t **rserver)
+{
+	server_t *server = NULL;
+	struct sockaddr_un addr;
+	struct stat st;
+	mode_t omask;
+	int rv;
+	int rc;
+
+	rc = server_sockaddr(path, &addr);
+	if (rc != EOK)
+		return rc;
+
+	if (stat(path, &st) == 0) {
+		if (!S_ISSOCK(st.st_mode)) {
+			(void)fprintf(stderr, "'%s' exists and is not "
+			    "a socket.\n", path);
+			return EEXIST;
+		}
+
+		(void)remove(path);
+	}
+
+	server = calloc(1, sizeof(server_t));
+	if (server == NULL)
+		return ENOMEM;
+
+	server->fd = -1;
+	server->path = strdup(path);
+	if (server->path == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	server->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server->fd < 0) {
+		(void)fprintf(stderr, "Cannot create socket.\n");
+		rc = EIO;
+		goto error;
+	}
+
+	/* Do not let other users connect (and run compiles as us) */
+	omask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+	rv = bind(server->fd, (struct sockaddr *)&addr, sizeof(addr));
+	(void)umask(omask);
+
+	if (rv < 0) {
+		(void)fprintf(stderr, "Cannot bind socket '%s'.\n", path);
+		rc = EIO;
+		goto error;
+	}
+
+	if (listen(server->fd, 8) < 0) {
+		(void)fprintf(stderr, "Cannot listen on socket '%s'.\n", path);
+		(void)remove(path);
+		rc = EIO;
+		goto error;
+	}
+
+	*rserver = server;
+	return EOK;
+error:
+	if (server->fd >= 0)
+		(void)close(server->fd);
+	if (server->path != NULL)
+		free(server->path);
+	free(server);
+	return rc;
+}
+
+/** Destroy compile server.
+ *
+ * @param server Compile server or @c NULL
+ */
+void server_destroy(server_t *server)
+{
+	if (server == NULL)
+		return;
+
+	(void)close(server->fd);
+	(void)remove(server->path);
+	free(server->path);
+	free(server);
+}
+
+/** Detach from compile server in connection handler process.
+ *
+ * The listening socket is closed in the calling process only, so that
+ * the server keeps running. The socket file is not removed.
+ *
+ * @param server Compile server
+ */
+void server_detach(server_t *server)
+{
+	(void)close(server->fd);
+	free(server->path);
+	free(server);
+}
+
+/** Destroy compile server request.
+ *
+ * @param req Request or @c NULL
+ */
+void server_req_destroy(server_req_t *req)
+{
+	int i;
+
+	if (req == NULL)
+		return;
+
+	if (req->fd >= 0)
+		(void)close(req->fd);
+	if (req->cwd != NULL)
+		free(req->cwd);
+	if (req->argv != NULL) {
+		for (i = 0; i < req->argc; i++) {
+			if (req->argv[i] != NULL)
+				free(req->argv[i]);
+		}
+
+		free(req->argv);
+	}
+
+	free(req);
+}
+
+/** Read request from connection.
+ *
+ * Fails if the client does not send the request within
+ * server_recv_timeout seconds.
+ *
+ * @param req Request returned by server_accept()
+ * @return EOK on success, EIO on error or invalid request, ENOMEM
+ *         if out of memory
+ */
+int server_req_read(server_req_t *req)
+{
+	uint32_t argc;
+	int i;
+	int rc;
+
+	rc = server_recv_str(req->fd, &req->cwd);
+	if (rc != EOK)
+		return rc;
+
+	rc = server_recv_u32(req->fd, &argc);
+	if (rc != EOK)
+		return rc;
+
+	if (argc < 1 || argc > server_max_args)
+		return EIO;
+
+	/* Extra entry for the terminating null pointer */
+	req->argv = calloc(argc + 1, sizeof(char *));
+	if (req->argv == NULL)
+		return ENOMEM;
+
+	req->argc = (int)argc;
+	for (i = 0; i < req->argc; i++) {
+		rc = server_recv_str(req->fd, &req->argv[i]);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Accept compile server request.
+ *
+ * Waits for a client to connect. The request itself is not read here
+ * so that a client which does not send anything cannot hold up
+ * the server. It should be read with server_req_read(), typically
+ * in a separate process.
+ *
+ * @param server Compile server
+ * @param rreq Place to store pointer to new request
+ * @return EOK on success, ENOMEM if out of memory, EIO on error
+ */
+int server_accept(server_t *server, server_req_t **rreq)
+{
+	server_req_t *req;
+	struct timeval tv;
+
+	while (true) {
+		req = calloc(1, sizeof(server_req_t));
+		if (req == NULL)
+			return ENOMEM;
+
+		req->fd = accept(server->fd, NULL, NULL);
+		if (req->fd >= 0)
+			break;
+
+		server_req_destroy(req);
+		if (errno != EINTR && errno != ECONNABORTED)
+			return EIO;
+	}
+
+	/* Do not wait forever for a stalled client */
+	tv.tv_sec = server_recv_timeout;
+	tv.tv_usec = 0;
+	(void)setsockopt(req->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+	*rreq = req;
+	return EOK;
+}
+
+/** Send contents of a file as a sequence of reply messages.
+ *
+ * @param fd Socket
+ * @param mtype Message type
+ * @param f File
+ * @return EOK on success, EIO on error
+ */
+static int server_send_file(int fd, char mtype, FILE *f)
+{
+	char buf[4096];
+	size_t nr;
+	int rc;
+
+	if (fseek(f, 0, SEEK_SET) < 0)
+		return EIO;
+
+	do {
+		nr = fread(buf, 1, sizeof(buf), f);
+		if (nr > 0) {
+			rc = server_send_msg(fd, mtype, buf, nr);
+			if (rc != EOK)
+				return rc;
+		}
+	} while (nr == sizeof(buf));
+
+	if (ferror(f))
+		return EIO;
+
+	return EOK;
+}
+
+/** Reply to compile server request.
+ *
+ * @param req Request
+ * @param outf File containing standard output of the request
+ * @param errf File containing standard error output of the request
+ * @param status Exit status
+ * @return EOK on success, EIO on error
+ */
+static int server_req_reply(server_req_t *req, FILE *outf, FILE *errf,
+    int status)
+{
+	uint8_t bstatus;
+	int rc;
+
+	rc = server_send_file(req->fd, server_msg_out, outf);
+	if (rc != EOK)
+		return rc;
+
+	rc = server_send_file(req->fd, server_msg_err, errf);
+	if (rc != EOK)
+		return rc;
+
+	bstatus = (uint8_t)status;
+	return server_send_msg(req->fd, server_msg_exit, &bstatus, 1);
+}
+
+/** Run compile server request and reply.
+ *
+ * Standard output and standard error output produced by @a fn are
+ * captured and sent to the client, followed by the return value
+ * of @a fn as the exit status. The calling process's standard output
+ * and standard error output remain redirected, so this should be
+ * called in a process that handles just this request.
+ *
+ * @param req Request
+ * @param fn Function processing the request, returns exit status
+ * @param arg Argument to @a fn
+ * @return EOK on success, EIO on error
+ */
+int server_req_run(server_req_t *req, server_req_fn_t fn, void *arg)
+{
+	FILE *outf = NULL;
+	FILE *errf = NULL;
+	int status;
+	int rc;
+
+	outf = tmpfile();
+	errf = tmpfile();
+	if (outf == NULL || errf == NULL) {
+		rc = EIO;
+		goto error;
+	}
+
+	(void)fflush(stdout);
+	(void)fflush(stderr);
+
+	if (dup2(fileno(outf), STDOUT_FILENO) < 0 ||
+	    dup2(fileno(errf), STDERR_FILENO) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	status = fn(arg);
+
+	(void)fflush(stdout);
+	(void)fflush(stderr);
+
+	rc = server_req_reply(req, outf, errf, status);
+	if (rc != EOK)
+		goto error;
+
+	(void)fclose(outf);
+	(void)fclose(errf);
+	return EOK;
+error:
+	if (outf != NULL)
+		(void)fclose(outf);
+	if (errf != NULL)
+		(void)fclose(errf);
+	return rc;
+}
+
+/** Change to working directory of client.
+ *
+ * @param req Request
+ * @return EOK on success, ENOENT if directory cannot be entered
+ */
+int server_req_chdir(server_req_t *req)
+{
+	if (chdir(req->cwd) < 0) {
+		(void)fprintf(stderr, "Cannot change to directory '%s'.\n",
+		    req->cwd);
+		return ENOENT;
+	}
+
+	return EOK;
+}
+
+/** Get current working directory.
+ *
+ * @param rcwd Place to store pointer to newly allocated string
+ * @return EOK on success, ENOMEM if out of memory, EIO on error
+ */
+static int server_getcwd(char **rcwd)
+{
+	char *buf;
+	size_t size;
+
+	size = 256;
+	while (true) {
+		buf = malloc(size);
+		if (buf == NULL)
+			return ENOMEM;
+
+		if (getcwd(buf, size) != NULL)
+			break;
+
+		free(buf);
+		if (errno != ERANGE)
+			return EIO;
+		size *= 2;
+	}
+
+	*rcwd = buf;
+	return EOK;
+}
+
+/** Run request on compile server as a client.
+ *
+ * Sends the request, copies output sent by the server to standard
+ * output and standard error output and returns the exit status.
+ *
+ * @param path Socket path
+ * @param argc Number of arguments
+ * @param argv Arguments (argv[0] is the program name)
+ * @param rstatus Place to store exit status
+ * @return EOK on success, EIO on communication error, ENOMEM if out
+ *         of memory
+ */
+int server_client_run(const char *path, int argc, char *argv[], int *rstatus)
+{
+	struct sockaddr_un addr;
+	char *cwd = NULL;
+	char buf[4096];
+	FILE *outf;
+	uint32_t size;
+	uint32_t n;
+	char mtype;
+	int fd = -1;
+	int i;
+	int rc;
+
+	rc = server_sockaddr(path, &addr);
+	if (rc != EOK)
+		return rc;
+
+	rc = server_getcwd(&cwd);
+	if (rc != EOK)
+		goto error;
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		(void)fprintf(stderr, "Cannot connect to server at '%s'.\n",
+		    path);
+		rc = EIO;
+		goto error;
+	}
+
+	rc = server_send_str(fd, cwd);
+	if (rc != EOK)
+		goto error;
+
+	rc = server_send_u32(fd, (uint32_t)argc);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < argc; i++) {
+		rc = server_send_str(fd, argv[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	while (true) {
+		rc = server_recv(fd, &mtype, 1);
+		if (rc != EOK)
+			goto error;
+
+		rc = server_recv_u32(fd, &size);
+		if (rc != EOK)
+			goto error;
+
+		if (mtype == server_msg_exit) {
+			if (size != 1) {
+				rc = EIO;
+				goto error;
+			}
+
+			rc = server_recv(fd, buf, 1);
+			if (rc != EOK)
+				goto error;
+
+			*rstatus = (uint8_t)buf[0];
+			break;
+		}
+
+		if (mtype == server_msg_out) {
+			outf = stdout;
+		} else if (mtype == server_msg_err) {
+			outf = stderr;
+		} else {
+			rc = EIO;
+			goto error;
+		}
+
+		while (size > 0) {
+			n = size < sizeof(buf) ? size : sizeof(buf);
+			rc = server_recv(fd, buf, n);
+			if (rc != EOK)
+				goto error;
+
+			if (fwrite(buf, 1, n, outf) != n) {
+				rc = EIO;
+				goto error;
+			}
+
+			size -= n;
+		}
+	}
+
+	(void)close(fd);
+	free(cwd);
+	return EOK;
+error:
+	if (fd >= 0)
+		(void)close(fd);
+	if (cwd != NULL)
+		free(cwd);
+	return rc;
+}
+
+/** Check file state.
+ *
+ * @param watch Watched file
+ * @param rexists Place to store @c true iff file exists
+ * @param rmtime Place to store modification time
+ * @param rsize Place to store file size
+ */
+static void server_watch_stat(server_watch_t *watch, bool *rexists,
+    unsigned long *rmtime, unsigned long *rsize)
+{
+	struct stat st;
+
+	if (stat(watch->fname, &st) != 0) {
+		*rexists = false;
+		*rmtime = 0;
+		*rsize = 0;
+		return;
+	}
+
+	*rexists = true;
+	*rmtime = (unsigned long)st.st_mtime;
+	*rsize = (unsigned long)st.st_size;
+}
+
+/** Start watching file for changes.
+ *
+ * @param fname File name
+ * @param rwatch Place to store pointer to new watched file
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int server_watch_create(const char *fname, server_watch_t **rwatch)
+{
+	server_watch_t *watch;
+
+	watch = calloc(1, sizeof(server_watch_t));
+	if (watch == NULL)
+		return ENOMEM;
+
+	watch->fname = strdup(fname);
+	if (watch->fname == NULL) {
+		free(watch);
+		return ENOMEM;
+	}
+
+	server_watch_stat(watch, &watch->exists, &watch->mtime, &watch->size);
+	*rwatch = watch;
+	return EOK;
+}
+
+/** Stop watching file.
+ *
+ * @param watch Watched file or @c NULL
+ */
+void server_watch_destroy(server_watch_t *watch)
+{
+	if (watch == NULL)
+		return;
+
+	free(watch->fname);
+	free(watch);
+}
+
+/** Determine if watched file changed since last check.
+ *
+ * @param watch Watched file
+ * @return @c true iff file was created, removed or modified
+ */
+bool server_watch_changed(server_watch_t *watch)
+{
+	bool exists;
+	unsigned long mtime;
+	unsigned long size;
+	bool changed;
+
+	server_watch_stat(watch, &exists, &mtime, &size);
+	changed = exists != watch->exists || mtime != watch->mtime ||
+	    size != watch->size;
+
+	watch->exists = exists;
+	watch->mtime = mtime;
+	watch->size = size;
+	return changed;
+}
+
+#else
+
+/** Create compile server.
+ *
+ * @param path Socket path
+ * @param rserver Place to store pointer to new server
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_create(const char *path, server_t **rserver)
+{
+	(void)path;
+	(void)rserver;
+	return ENOTSUP;
+}
+
+/** Destroy compile server.
+ *
+ * @param server Compile server or @c NULL
+ */
+void server_destroy(server_t *server)
+{
+	(void)server;
+}
+
+/** Detach from compile server in connection handler process.
+ *
+ * @param server Compile server
+ */
+void server_detach(server_t *server)
+{
+	(void)server;
+}
+
+/** Accept compile server request.
+ *
+ * @param server Compile server
+ * @param rreq Place to store pointer to new request
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_accept(server_t *server, server_req_t **rreq)
+{
+	(void)server;
+	(void)rreq;
+	return ENOTSUP;
+}
+
+/** Read request from connection.
+ *
+ * @param req Request
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_req_read(server_req_t *req)
+{
+	(void)req;
+	return ENOTSUP;
+}
+
+/** Run compile server request and reply.
+ *
+ * @param req Request
+ * @param fn Function processing the request
+ * @param arg Argument to @a fn
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_req_run(server_req_t *req, server_req_fn_t fn, void *arg)
+{
+	(void)req;
+	(void)fn;
+	(void)arg;
+	return ENOTSUP;
+}
+
+/** Destroy compile server request.
+ *
+ * @param req Request or @c NULL
+ */
+void server_req_destroy(server_req_t *req)
+{
+	(void)req;
+}
+
+/** Change to working directory of client.
+ *
+ * @param req Request
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_req_chdir(server_req_t *req)
+{
+	(void)req;
+	return ENOTSUP;
+}
+
+/** Run request on compile server as a client.
+ *
+ * @param path Socket path
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @param rstatus Place to store exit status
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_client_run(const char *path, int argc, char *argv[], int *rstatus)
+{
+	(void)path;
+	(void)argc;
+	(void)argv;
+	(void)rstatus;
+	return ENOTSUP;
+}
+
+/** Start watching file for changes.
+ *
+ * @param fname File name
+ * @param rwatch Place to store pointer to new watched file
+ * @return ENOTSUP (compile server is not supported)
+ */
+int server_watch_create(const char *fname, server_watch_t **rwatch)
+{
+	(void)fname;
+	(void)rwatch;
+	return ENOTSUP;
+}
+
+/** Stop watching file.
+ *
+ * @param watch Watched file or @c NULL
+ */
+void server_watch_destroy(server_watch_t *watch)
+{
+	(void)watch;
+}
+
+/** Determine if watched file changed since last check.
+ *
+ * @param watch Watched file
+ * @return @c false (compile server is not supported)
+ */
+bool server_watch_changed(server_watch_t *watch)
+{
+	(void)watch;
+	return false;
+}
+
+#endif
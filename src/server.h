@@ -0,0 +1,48 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Compile server
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <types/server.h>
+
+extern bool server_supported(void);
+extern int server_create(const char *, server_t **);
+extern void server_destroy(server_t *);
+extern void server_detach(server_t *);
+extern int server_accept(server_t *, server_req_t **);
+extern int server_req_read(server_req_t *);
+extern int server_req_chdir(server_req_t *);
+extern int server_req_run(server_req_t *, server_req_fn_t, void *);
+extern void server_req_destroy(server_req_t *);
+extern int server_client_run(const char *, int, char *[], int *);
+extern int server_watch_create(const char *, server_watch_t **);
+extern void server_watch_destroy(server_watch_t *);
+extern bool server_watch_changed(server_watch_t *);
+
+#endif
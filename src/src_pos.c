@@ -26,12 +26,115 @@
 
 #include <merrno.h>
 #include <src_pos.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 enum {
 	tab_width = 8
 };
 
+/** Table of interned source file names.
+ *
+ * Source positions refer to files by ID, so that a position is small
+ * and cheap to copy. File names are interned here for the lifetime
+ * of the program (or until src_pos_cleanup() is called).
+ */
+static src_file_tab_t src_files;
+
+/** Intern source file name.
+ *
+ * @param fname File name
+ * @param rid Place to store file ID (0 if @a fname is empty)
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int src_file_intern(const char *fname, src_file_id_t *rid)
+{
+	src_file_id_t id;
+	src_file_id_t nalloc;
+	char **nfnames;
+	char *dup;
+
+	if (fname[0] == '\0') {
+		*rid = 0;
+		return EOK;
+	}
+
+	/* Most positions are set for the same file over and over */
+	if (src_files.last != 0 &&
+	    strcmp(src_files.fnames[(size_t)src_files.last], fname) == 0) {
+		*rid = src_files.last;
+		return EOK;
+	}
+
+	for (id = 1; id < src_files.nfiles; id++) {
+		if (strcmp(src_files.fnames[(size_t)id], fname) == 0) {
+			src_files.last = id;
+			*rid = id;
+			return EOK;
+		}
+	}
+
+	/* Entry 0 is reserved for no file */
+	if (src_files.nfiles == 0)
+		src_files.nfiles = 1;
+
+	if (src_files.nfiles >= src_files.alloc) {
+		nalloc = src_files.alloc != 0 ? 2 * src_files.alloc : 16;
+		nfnames = realloc(src_files.fnames,
+		    (size_t)nalloc * sizeof(char *));
+		if (nfnames == NULL)
+			return ENOMEM;
+
+		src_files.fnames = nfnames;
+		src_files.alloc = nalloc;
+	}
+
+	dup = strdup(fname);
+	if (dup == NULL)
+		return ENOMEM;
+
+	id = src_files.nfiles++;
+	src_files.fnames[(size_t)id] = dup;
+	src_files.last = id;
+	*rid = id;
+	return EOK;
+}
+
+/** Get file name of source position.
+ *
+ * @param pos Source position
+ * @return File name (empty string if position has no file)
+ */
+const char *src_pos_fname(src_pos_t *pos)
+{
+	if (pos->file == 0 || pos->file >= src_files.nfiles)
+		return "";
+
+	return src_files.fnames[(size_t)pos->file];
+}
+
+/** Free table of interned source file names.
+ *
+ * Any existing source positions lose their file names.
+ */
+void src_pos_cleanup(void)
+{
+	src_file_id_t id;
+
+	for (id = 1; id < src_files.nfiles; id++)
+		free(src_files.fnames[(size_t)id]);
+
+	if (src_files.fnames != NULL)
+		free(src_files.fnames);
+
+	src_files.fnames = NULL;
+	src_files.nfiles = 0;
+	src_files.alloc = 0;
+	src_files.last = 0;
+}
+
 /** Print position range.
  *
  * @param bpos Position of the beginning of range
@@ -42,17 +145,21 @@ enum {
  */
 int src_pos_print_range(src_pos_t *bpos, src_pos_t *epos, FILE *f)
 {
+	const char *fname = src_pos_fname(bpos);
+
 	if (bpos->line == epos->line && bpos->col == epos->col) {
-		if (fprintf(f, "%s:%zu:%zu", bpos->file, bpos->line,
-		    bpos->col) < 0)
+		if (fprintf(f, "%s:%lu:%lu", fname, (unsigned long)bpos->line,
+		    (unsigned long)bpos->col) < 0)
 			return EIO;
 	} else if (bpos->line == epos->line) {
-		if (fprintf(f, "%s:%zu:%zu-%zu", bpos->file, bpos->line,
-		    bpos->col, epos->col) < 0)
+		if (fprintf(f, "%s:%lu:%lu-%lu", fname,
+		    (unsigned long)bpos->line, (unsigned long)bpos->col,
+		    (unsigned long)epos->col) < 0)
 			return EIO;
 	} else {
-		if (fprintf(f, "%s:%zu:%zu-%zu:%zu", bpos->file, bpos->line,
-		    bpos->col, epos->line, epos->col) < 0)
+		if (fprintf(f, "%s:%lu:%lu-%lu:%lu", fname,
+		    (unsigned long)bpos->line, (unsigned long)bpos->col,
+		    (unsigned long)epos->line, (unsigned long)epos->col) < 0)
 			return EIO;
 	}
 
@@ -60,17 +167,29 @@ int src_pos_print_range(src_pos_t *bpos, src_pos_t *epos, FILE *f)
 }
 
 /** Set source position.
+ *
+ * The file name is interned, i.e. it need not remain valid after
+ * the call.
  *
  * @param pos Position structure to initialize
  * @param fname File name
  * @param line Line number (starting from 1)
  * @param col Column number (starting from 1)
+ * @return EOK on success, ENOMEM if out of memory
  */
-void src_pos_set(src_pos_t *pos, const char *fname, size_t line, size_t col)
+int src_pos_set(src_pos_t *pos, const char *fname, size_t line, size_t col)
 {
-	(void)snprintf(pos->file, src_pos_fname_max, "%s", fname);
-	pos->line = line;
-	pos->col = col;
+	src_file_id_t id;
+	int rc;
+
+	rc = src_file_intern(fname, &id);
+	if (rc != EOK)
+		return rc;
+
+	pos->file = id;
+	pos->line = (uint32_t)line;
+	pos->col = (uint32_t)col;
+	return EOK;
 }
 
 /** Move position one character forward based on character.
@@ -93,3 +212,14 @@ void src_pos_fwd_char(src_pos_t *pos, char c)
 		++pos->col;
 	}
 }
+
+/** Determine if two source positions are the same.
+ *
+ * @param a First position
+ * @param b Second position
+ * @return @c true iff @a a and @a b are the same position
+ */
+bool src_pos_same(src_pos_t *a, src_pos_t *b)
+{
+	return a->file == b->file && a->line == b->line && a->col == b->col;
+}
@@ -27,12 +27,16 @@
 #ifndef SRC_POS_H
 #define SRC_POS_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <types/src_pos.h>
 
 extern int src_pos_print_range(src_pos_t *, src_pos_t *, FILE *);
 extern void src_pos_fwd_char(src_pos_t *, char);
-extern void src_pos_set(src_pos_t *, const char *, size_t, size_t);
+extern bool src_pos_same(src_pos_t *, src_pos_t *);
+extern int src_pos_set(src_pos_t *, const char *, size_t, size_t);
+extern const char *src_pos_fname(src_pos_t *);
+extern void src_pos_cleanup(void);
 
 #endif
@@ -32,9 +32,11 @@
 #include <str_input.h>
 
 static int str_lexer_read(void *, char *, size_t, size_t *, src_pos_t *);
+static int str_lexer_whole(void *, const char **, size_t *, src_pos_t *);
 
 lexer_input_ops_t lexer_str_input = {
-	.read = str_lexer_read
+	.read = str_lexer_read,
+	.whole = str_lexer_whole
 };
 
 /** Lexer input form a string constant. */
@@ -60,10 +62,25 @@ static int str_lexer_read(void *arg, char *buf, size_t bsize, size_t *nread,
 	return EOK;
 }
 
-void str_input_init(str_input_t *sinput, const char *s)
+/** Lexer input from a string constant as a single buffer.
+ *
+ * The string itself is used as the buffer (no copy is made).
+ */
+static int str_lexer_whole(void *arg, const char **rbuf, size_t *rsize,
+    src_pos_t *rbpos)
+{
+	str_input_t *sinput = (str_input_t *)arg;
+
+	*rbuf = &sinput->str[sinput->pos];
+	*rsize = strlen(&sinput->str[sinput->pos]);
+	*rbpos = sinput->cpos;
+	return EOK;
+}
+
+int str_input_init(str_input_t *sinput, const char *s)
 {
 	sinput->str = s;
 	sinput->pos = 0;
 
-	src_pos_set(&sinput->cpos, "none", 1, 1);
+	return src_pos_set(&sinput->cpos, "none", 1, 1);
 }
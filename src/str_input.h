@@ -32,6 +32,6 @@
 
 extern lexer_input_ops_t lexer_str_input;
 
-extern void str_input_init(str_input_t *, const char *);
+extern int str_input_init(str_input_t *, const char *);
 
 #endif
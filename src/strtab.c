@@ -0,0 +1,194 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * String table
+ *
+ * Interns strings (such as identifier and keyword token texts) so that
+ * each distinct string is stored only once.
+ */
+
+#include <arena.h>
+#include <merrno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strtab.h>
+
+/** Compute hash of a string.
+ *
+ * @param str String
+ * @param len Length of string
+ * @return Hash (32-bit FNV-1a)
+ */
+static unsigned long strtab_hash(const char *str, size_t len)
+{
+	unsigned long h;
+	size_t i;
+
+	h = 2166136261UL;
+	for (i = 0; i < len; i++) {
+		h ^= (unsigned char)str[i];
+		h = (h * 16777619UL) & 0xffffffffUL;
+	}
+
+	return h;
+}
+
+/** Create string table.
+ *
+ * @param arena Arena to allocate strings from
+ * @param rstrtab Place to store pointer to new string table
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int strtab_create(arena_t *arena, strtab_t **rstrtab)
+{
+	strtab_t *strtab;
+
+	strtab = calloc(1, sizeof(strtab_t));
+	if (strtab == NULL)
+		return ENOMEM;
+
+	strtab->buckets = calloc(strtab_init_buckets,
+	    sizeof(strtab_entry_t *));
+	if (strtab->buckets == NULL) {
+		free(strtab);
+		return ENOMEM;
+	}
+
+	strtab->arena = arena;
+	strtab->nbuckets = strtab_init_buckets;
+	*rstrtab = strtab;
+	return EOK;
+}
+
+/** Destroy string table.
+ *
+ * The strings themselves remain valid until the arena is destroyed.
+ *
+ * @param strtab String table or @c NULL
+ */
+void strtab_destroy(strtab_t *strtab)
+{
+	if (strtab == NULL)
+		return;
+
+	free(strtab->buckets);
+	free(strtab);
+}
+
+/** Double the number of hash buckets.
+ *
+ * @param strtab String table
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int strtab_grow(strtab_t *strtab)
+{
+	strtab_entry_t **nbuckets;
+	strtab_entry_t *entry;
+	strtab_entry_t *next;
+	size_t nb;
+	size_t i;
+	size_t j;
+
+	nb = strtab->nbuckets * 2;
+	if (nb / 2 != strtab->nbuckets)
+		return ENOMEM;
+
+	nbuckets = calloc(nb, sizeof(strtab_entry_t *));
+	if (nbuckets == NULL)
+		return ENOMEM;
+
+	for (i = 0; i < strtab->nbuckets; i++) {
+		entry = strtab->buckets[i];
+		while (entry != NULL) {
+			next = entry->next;
+			j = entry->hash & (nb - 1);
+			entry->next = nbuckets[j];
+			nbuckets[j] = entry;
+			entry = next;
+		}
+	}
+
+	free(strtab->buckets);
+	strtab->buckets = nbuckets;
+	strtab->nbuckets = nb;
+	return EOK;
+}
+
+/** Intern string.
+ *
+ * Returns the single stored copy of the string, adding it to the table
+ * if it is not there yet. The returned string must not be modified.
+ *
+ * @param strtab String table
+ * @param str String (need not be null-terminated, must not contain
+ *            null characters)
+ * @param len Length of string
+ * @param rstr Place to store pointer to interned null-terminated string
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int strtab_intern(strtab_t *strtab, const char *str, size_t len,
+    char **rstr)
+{
+	strtab_entry_t *entry;
+	unsigned long hash;
+	size_t b;
+	int rc;
+
+	hash = strtab_hash(str, len);
+	b = hash & (strtab->nbuckets - 1);
+
+	entry = strtab->buckets[b];
+	while (entry != NULL) {
+		if (entry->hash == hash && entry->len == len &&
+		    strncmp(entry->str, str, len) == 0) {
+			*rstr = entry->str;
+			return EOK;
+		}
+
+		entry = entry->next;
+	}
+
+	if (strtab->nentries >= strtab->nbuckets) {
+		/* Keep chains short. Growing is optional. */
+		rc = strtab_grow(strtab);
+		if (rc == EOK)
+			b = hash & (strtab->nbuckets - 1);
+	}
+
+	entry = arena_alloc(strtab->arena, sizeof(strtab_entry_t));
+	if (entry == NULL)
+		return ENOMEM;
+
+	entry->str = arena_strndup(strtab->arena, str, len);
+	if (entry->str == NULL)
+		return ENOMEM;
+
+	entry->hash = hash;
+	entry->len = len;
+	entry->next = strtab->buckets[b];
+	strtab->buckets[b] = entry;
+	++strtab->nentries;
+
+	*rstr = entry->str;
+	return EOK;
+}
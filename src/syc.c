@@ -25,50 +25,97 @@
  */
 
 #include <comp.h>
+#include <diag.h>
 #include <file_input.h>
+#include <jobs.h>
 #include <lexer.h>
 #include <merrno.h>
 #include <object/linker.h>
+#include <object/section.h>
 #include <parser.h>
 #include <pathname.h>
+#include <server.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <test/adt/hmap.h>
 #include <test/cgen.h>
 #include <test/cgtype.h>
 #include <test/comp.h>
 #include <test/ir.h>
+#include <test/irbin.h>
+#include <test/pch.h>
 #include <test/scope.h>
 #include <test/irlexer.h>
 #include <test/z80/isel.h>
 #include <test/z80/ralloc.h>
 #include <test/z80/z80ic.h>
 
+enum {
+	/** Maximum number of parallel jobs */
+	max_jobs = 64
+};
+
+/** File to compile */
+typedef struct {
+	/** Compiler */
+	comp_t *comp;
+	/** Input file name */
+	const char *fname;
+	/** Compiler flags */
+	comp_flags_t flags;
+	/** Code generator flags */
+	cgen_flags_t cgflags;
+	/** @c true iff module should be placed in a memory bank */
+	bool banked;
+	/** Memory bank number (if @c banked is @c true) */
+	unsigned bank;
+	/** Job compiling the file or @c NULL if compiled directly */
+	job_t *job;
+} compile_job_t;
+
 static void print_syntax(void)
 {
 	(void)printf("C compiler / static checker\n");
 	(void)printf("syntax:\n"
 	    "\tsyc [options] <file>... Compile / check the specified file(s)\n"
 	    "\tsyc --test Run internal unit tests\n"
+	    "\tsyc --server=<path> [--pch=<fname>] Run compile server on "
+	    "socket <path>\n"
+	    "\tsyc --client=<path> [options] <file>... Compile using "
+	    "compile server\n"
 	    "compiler options:\n"
 	    "\t--dump-ast Dump internal abstract syntax tree\n"
 	    "\t--dump-toks Dump tokenized source file\n"
 	    "\t--dump-ir Dump intermediate representation\n"
 	    "\t--dump-vric Dump instruction code with virtual registers\n"
 	    "\t--dump-obj Dump binary object\n"
+	    "\t--irb-gen Generate binary IR, stop after IR generation\n"
 	    "\t--no-comp Do not compile, stop after preprocessing stage\n"
 	    "\t--no-emit Do not emit binary object, stop after compile stage\n"
 	    "\t--no-link Do not link, stop after binary object emission\n"
 	    "\t--no-tape Do not make a tape image, stop after link stage\n"
 	    "\t--no-stdlib Do not implicitly link with standard libraries\n"
 	    "\t--out=<fname> Output file name\n"
+	    "\t-j <n> Compile up to <n> files in parallel\n"
+	    "\t-I <dir> Look for included headers in <dir>\n"
+	    "\t--cache-dir=<dir> Reuse compiled objects cached in <dir>\n"
+	    "\t--pch-gen Generate precompiled header from header file\n"
+	    "\t--pch=<fname> Use precompiled header <fname>\n"
+	    "\t--diag-format=<fmt> Report diagnostics as text (default), "
+	    "jsonl or sarif\n"
 	    "code generation options:\n"
 	    "\t--lvalue-args Make function arguments writable/addressable\n"
 	    "\t--int-promotion Enable integer promotion\n"
 	    "linker options:\n"
 	    "\t--no-link-range-error Disable link error if binary is "
-	    "too large\n");
+	    "too large\n"
+	    "\t--link-script=<fname> Place sections according to linker "
+	    "script\n"
+	    "file placement options (apply to files that follow):\n"
+	    "\t--bank=<n> Place code and data in 128K memory bank <n>\n"
+	    "\t--no-bank Place code and data in common memory (default)\n");
 }
 
 /** Replace filename extension with a different one.
@@ -168,7 +215,15 @@ static int construct_outfname(const char *infname, comp_flags_t flags,
 {
 	int rc;
 
-	if ((flags & compf_no_emit) != compf_none) {
+	if ((flags & compf_pch_gen) != compf_none) {
+		rc = ext_replace(infname, "pch", routfname);
+		if (rc != EOK)
+			goto error;
+	} else if ((flags & compf_irb_gen) != compf_none) {
+		rc = ext_replace(infname, "irb", routfname);
+		if (rc != EOK)
+			goto error;
+	} else if ((flags & compf_no_emit) != compf_none) {
 		rc = ext_replace(infname, "asm", routfname);
 		if (rc != EOK)
 			goto error;
@@ -191,17 +246,69 @@ error:
 	return rc;
 }
 
+/** Determine if compiled objects can be taken from compilation cache.
+ *
+ * This is not possible if we need to dump any intermediate results.
+ *
+ * @param flags Compiler flags
+ * @return @c true iff compilation cache can be used
+ */
+static bool compile_can_cache(comp_flags_t flags)
+{
+	return (flags & (compf_no_comp | compf_no_emit | compf_dump_ast |
+	    compf_dump_toks | compf_dump_ir | compf_dump_vric |
+	    compf_pch_gen | compf_irb_gen)) == compf_none;
+}
+
+/** Look up compiled module in compilation cache.
+ *
+ * @param module Compiler module
+ * @param fname Input file name
+ * @return EOK on success (whether or not the module was found)
+ *         or an error code
+ */
+static int cache_lookup_file(comp_module_t *module, const char *fname)
+{
+	file_input_t *finput = NULL;
+	FILE *f;
+	int rc;
+
+	if (module->comp->cache == NULL)
+		return EOK;
+
+	/* The cache key is computed using a separate input */
+	f = fopen(fname, "rt");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
+		return ENOENT;
+	}
+
+	rc = file_input_create(f, fname, &finput);
+	if (rc != EOK) {
+		(void)fprintf(stderr, "Cannot create file input.\n");
+		(void)fclose(f);
+		return rc;
+	}
+
+	rc = comp_module_cache_lookup(module, &lexer_file_input, finput);
+	file_input_destroy(finput);
+	(void)fclose(f);
+	return rc;
+}
+
 /** Compile one input file.
  *
  * @param comp Compiler
  * @param fname Input file name
  * @param flags Compiler flags
  * @param cfglags Code generator flags
+ * @param banked @c true iff module should be placed in a memory bank
+ * @param bank Memory bank number (if @a banked is @c true)
  *
  * @return EOK on succcess or an error code
  */
 static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
-    cgen_flags_t cgflags)
+    cgen_flags_t cgflags, bool banked, unsigned bank)
 {
 	int rc;
 	int rv;
@@ -233,6 +340,9 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 		mtype = cmt_chdr;
 	} else if (strcmp(ext, ".ir") == 0 || strcmp(ext, ".IR") == 0) {
 		mtype = cmt_ir;
+	} else if (strcmp(ext, ".irb") == 0 || strcmp(ext, ".IRB") == 0) {
+		mtype = cmt_irb;
+		inf_binary = true;
 	} else if (strcmp(ext, ".asm") == 0 || strcmp(ext, ".ASM") == 0) {
 		mtype = cmt_ic;
 	} else if (strcmp(ext, ".obj") == 0 || strcmp(ext, ".OBJ") == 0) {
@@ -244,6 +354,13 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 		goto error;
 	}
 
+	if ((flags & compf_pch_gen) != compf_none && mtype != cmt_chdr) {
+		(void)fprintf(stderr, "Precompiled header can only be "
+		    "generated from a header file.\n");
+		rc = EINVAL;
+		goto error;
+	}
+
 	f = fopen(fname, inf_binary ? "rb" : "rt");
 	if (f == NULL) {
 		(void)fprintf(stderr, "Cannot open '%s'.\n", fname);
@@ -256,7 +373,9 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 		goto error;
 
 	if ((flags & compf_no_link) != compf_none ||
-	    (flags & compf_no_emit) != compf_none) {
+	    (flags & compf_no_emit) != compf_none ||
+	    (flags & compf_pch_gen) != compf_none ||
+	    (flags & compf_irb_gen) != compf_none) {
 		if (strcmp(fname, outfname) == 0) {
 			(void)fprintf(stderr, "Error: Input and output file "
 			    "names are identical.\n");
@@ -282,6 +401,10 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 		rc = comp_module_create_from_obj(comp, fname, &module);
 		if (rc != EOK)
 			goto error;
+	} else if (mtype == cmt_irb) {
+		rc = comp_module_create_from_irb(comp, fname, &module);
+		if (rc != EOK)
+			goto error;
 	} else {
 		rc = comp_module_create(comp, &lexer_file_input, finput, mtype,
 		    fname, &module);
@@ -289,8 +412,27 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 			goto error;
 	}
 
+	if (banked) {
+		rc = comp_module_set_bank(module, bank);
+		if (rc != EOK)
+			goto error;
+	}
+
 	comp->cgflags = cgflags;
 
+	if (compile_can_cache(flags)) {
+		rc = cache_lookup_file(module, fname);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if ((flags & compf_pch_gen) != compf_none) {
+		rc = comp_module_make_pch(module, outf);
+		if (rc != EOK)
+			goto error;
+		goto done;
+	}
+
 	if ((flags & compf_no_comp) != compf_none) {
 		/* Dump preprocessed source. */
 		rc = comp_module_dump_preproc(module, stdout);
@@ -329,6 +471,13 @@ static int compile_file(comp_t *comp, const char *fname, comp_flags_t flags,
 			goto error;
 	}
 
+	if ((flags & compf_irb_gen) != compf_none) {
+		rc = comp_module_save_irb(module, outf);
+		if (rc != EOK)
+			goto error;
+		goto done;
+	}
+
 	if ((flags & compf_dump_vric) != compf_none) {
 		rc = comp_module_dump_vric(module, stdout);
 		if (rc != EOK)
@@ -391,6 +540,257 @@ error:
 	return rc;
 }
 
+/** Determine if compiled modules will be linked.
+ *
+ * @param flags Compiler flags
+ * @return @c true iff modules will be linked into a binary
+ */
+static bool compile_will_link(comp_flags_t flags)
+{
+	return (flags & (compf_no_comp | compf_no_emit | compf_no_link |
+	    compf_pch_gen | compf_irb_gen)) == compf_none;
+}
+
+/** Determine if file is a binary object file (based on its extension).
+ *
+ * @param fname File name
+ * @return @c true iff file has the extension of a binary object file
+ */
+static bool is_obj_file(const char *fname)
+{
+	char *ext;
+
+	ext = strrchr(fname, '.');
+	if (ext == NULL)
+		return false;
+
+	return strcmp(ext, ".obj") == 0 || strcmp(ext, ".OBJ") == 0;
+}
+
+/** Compile one input file as a parallel job.
+ *
+ * This is executed in a separate process with its own copy of
+ * the compiler. If the modules are going to be linked, the resulting
+ * binary object is written to @a dataf, from where it is loaded by
+ * the parent.
+ *
+ * @param arg Compile job (compile_job_t *)
+ * @param dataf File for passing the binary object to the parent
+ * @return EOK on succcess or an error code
+ */
+static int compile_job(void *arg, FILE *dataf)
+{
+	compile_job_t *cjob = (compile_job_t *)arg;
+	comp_module_t *module;
+	comp_module_t *next;
+	int rc;
+
+	rc = compile_file(cjob->comp, cjob->fname, cjob->flags, cjob->cgflags,
+	    cjob->banked, cjob->bank);
+	if (rc != EOK)
+		return rc;
+
+	if (!compile_will_link(cjob->flags))
+		return EOK;
+
+	/* The newly compiled module is the last one */
+	module = comp_module_first(cjob->comp);
+	next = comp_module_next(module);
+	while (next != NULL) {
+		module = next;
+		next = comp_module_next(module);
+	}
+
+	return comp_module_emit(module, dataf);
+}
+
+/** Compile input files sequentially.
+ *
+ * @param cjobs Array of files to compile
+ * @param nfiles Number of entries in @a cjobs
+ * @return EOK on succcess or an error code
+ */
+static int compile_files(compile_job_t *cjobs, int nfiles)
+{
+	int i;
+	int rc;
+
+	for (i = 0; i < nfiles; i++) {
+		rc = compile_file(cjobs[i].comp, cjobs[i].fname,
+		    cjobs[i].flags, cjobs[i].cgflags, cjobs[i].banked,
+		    cjobs[i].bank);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Compile input files in parallel.
+ *
+ * Each source file is compiled by a separate job, with up to @a njobs
+ * jobs running simultaneously. Once all jobs have finished, their
+ * output is replayed in command-line order (so that diagnostics
+ * are deterministic) and the resulting binary objects are added
+ * to the compiler in the same order. Binary object files on the command
+ * line are loaded directly.
+ *
+ * @param comp Compiler (with no modules yet)
+ * @param cjobs Array of files to compile
+ * @param nfiles Number of entries in @a cjobs
+ * @param njobs Maximum number of jobs running simultaneously
+ * @return EOK on succcess or an error code
+ */
+static int compile_files_parallel(comp_t *comp, compile_job_t *cjobs,
+    int nfiles, unsigned njobs)
+{
+	jobs_t *jobs = NULL;
+	comp_module_t *module;
+	int i;
+	int rc;
+
+	rc = jobs_create(njobs, &jobs);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < nfiles; i++) {
+		if (is_obj_file(cjobs[i].fname))
+			continue;
+
+		rc = jobs_add(jobs, compile_job, &cjobs[i], &cjobs[i].job);
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Error creating compile job.\n");
+			goto error;
+		}
+	}
+
+	rc = jobs_run(jobs);
+	if (rc != EOK) {
+		/* Replay what has finished, then fail at the first failed job */
+		(void)fprintf(stderr, "Error running compile jobs.\n");
+	}
+
+	for (i = 0; i < nfiles; i++) {
+		if (cjobs[i].job == NULL) {
+			rc = compile_file(comp, cjobs[i].fname, cjobs[i].flags,
+			    cjobs[i].cgflags, cjobs[i].banked, cjobs[i].bank);
+			if (rc != EOK)
+				goto error;
+			continue;
+		}
+
+		if (!job_is_done(cjobs[i].job)) {
+			/* Jobs stopped early, this one never ran */
+			(void)fprintf(stderr, "File '%s' was not compiled.\n",
+			    cjobs[i].fname);
+			rc = EIO;
+			goto error;
+		}
+
+		rc = job_replay(cjobs[i].job);
+		if (rc != EOK)
+			goto error;
+
+		rc = job_get_rc(cjobs[i].job);
+		if (rc != EOK)
+			goto error;
+
+		if (!compile_will_link(cjobs[i].flags))
+			continue;
+
+		rc = comp_module_create_from_objf(comp,
+		    job_get_data(cjobs[i].job), cjobs[i].fname, &module);
+		if (rc != EOK)
+			goto error;
+
+		if (cjobs[i].banked) {
+			rc = comp_module_set_bank(module, cjobs[i].bank);
+			if (rc != EOK)
+				goto error;
+		}
+	}
+
+	jobs_destroy(jobs);
+	return EOK;
+error:
+	jobs_destroy(jobs);
+	return rc;
+}
+
+/** Save contents of memory banks into raw binary files.
+ *
+ * Contents of bank N is saved into a file named after @a outfname,
+ * with extension replaced by "bank<N>.bin".
+ *
+ * @param comp Compiler
+ * @param outfname Output file name
+ *
+ * @return EOK on succcess or an error code
+ */
+static int save_banks(comp_t *comp, const char *outfname)
+{
+	FILE *bankf = NULL;
+	char *bankext = NULL;
+	char *bankfname = NULL;
+	unsigned bank;
+	int rc;
+	int rv;
+
+	for (bank = 0; bank < obj_bank_count; bank++) {
+		if (!comp_has_bank(comp, bank))
+			continue;
+
+		rv = asprintf(&bankext, "bank%u.bin", bank);
+		if (rv < 0) {
+			bankext = NULL;
+			rc = ENOMEM;
+			goto error;
+		}
+
+		rc = ext_replace(outfname, bankext, &bankfname);
+		if (rc != EOK)
+			goto error;
+
+		bankf = fopen(bankfname, "wb");
+		if (bankf == NULL) {
+			(void)fprintf(stderr, "Cannot open '%s'.\n",
+			    bankfname);
+			rc = EIO;
+			goto error;
+		}
+
+		rc = comp_save_bank(comp, bank, bankf);
+		if (rc != EOK)
+			goto error;
+
+		if (fclose(bankf) < 0) {
+			bankf = NULL;
+			(void)fprintf(stderr, "Error writing to '%s'.\n",
+			    bankfname);
+			rc = EIO;
+			goto error;
+		}
+
+		bankf = NULL;
+		free(bankfname);
+		bankfname = NULL;
+		free(bankext);
+		bankext = NULL;
+	}
+
+	return EOK;
+error:
+	if (bankf != NULL)
+		(void)fclose(bankf);
+	if (bankfname != NULL) {
+		(void)remove(bankfname);
+		free(bankfname);
+	}
+	if (bankext != NULL)
+		free(bankext);
+	return rc;
+}
+
 /** Link modules into a single binary.
  *
  * @param comp Compiler
@@ -418,6 +818,10 @@ static int link_binary(comp_t *comp, const char *outfn, comp_flags_t flags)
 		return EOK;
 	if ((flags & compf_no_link) != compf_none)
 		return EOK;
+	if ((flags & compf_pch_gen) != compf_none)
+		return EOK;
+	if ((flags & compf_irb_gen) != compf_none)
+		return EOK;
 
 	if (outfn == NULL) {
 		module = comp_module_first(comp);
@@ -453,6 +857,12 @@ static int link_binary(comp_t *comp, const char *outfn, comp_flags_t flags)
 	if (rc != EOK)
 		goto error;
 
+	if ((flags & compf_no_tape) != compf_none) {
+		rc = save_banks(comp, outfname);
+		if (rc != EOK)
+			goto error;
+	}
+
 	rc = ext_replace(outfname, "map", &mapfname);
 	if (rc != EOK)
 		goto error;
@@ -537,19 +947,121 @@ error:
 	return rc;
 }
 
+/** Parse memory bank number.
+ *
+ * Banks 5 and 2 are permanently mapped at 0x4000 and 0x8000,
+ * respectively, and thus cannot be used for banked code.
+ *
+ * @param str String containing bank number
+ * @param rbank Place to store bank number
+ * @return EOK on success, EINVAL if @a str is not a valid bank number
+ */
+static int parse_bank(const char *str, unsigned *rbank)
+{
+	unsigned long bank;
+	char *endptr;
+
+	bank = strtoul(str, &endptr, 10);
+	if (*str == '\0' || *endptr != '\0' || bank >= obj_bank_count) {
+		(void)fprintf(stderr, "Invalid bank number '%s'.\n", str);
+		return EINVAL;
+	}
+
+	if (bank == 2 || bank == 5) {
+		(void)fprintf(stderr, "Bank %lu is not pageable.\n", bank);
+		return EINVAL;
+	}
+
+	*rbank = (unsigned)bank;
+	return EOK;
+}
+
+/** Parse number of parallel jobs.
+ *
+ * @param str String containing number of jobs
+ * @param rnjobs Place to store number of jobs
+ * @return EOK on success, EINVAL if @a str is not a valid number of jobs
+ */
+static int parse_jobs(const char *str, unsigned *rnjobs)
+{
+	unsigned long njobs;
+	char *endptr;
+
+	njobs = strtoul(str, &endptr, 10);
+	if (*str == '\0' || *endptr != '\0' || njobs < 1 ||
+	    njobs > max_jobs) {
+		(void)fprintf(stderr, "Invalid number of jobs '%s'.\n", str);
+		return EINVAL;
+	}
+
+	*rnjobs = (unsigned)njobs;
+	return EOK;
+}
+
 #include <pathname.h>
 
-int main(int argc, char *argv[])
+/** Set compiler identity from the compiler executable.
+ *
+ * @param comp Compiler
+ * @param progname Program name (argv[0])
+ * @param execdir Directory from which the executable was run or @c NULL
+ * @return EOK on success, ENOENT if executable was not found,
+ *         ENOMEM if out of memory or an error code
+ */
+static int set_comp_ident(comp_t *comp, const char *progname,
+    const char *execdir)
+{
+	char *exename;
+	int rc;
+
+	if (pathname_is_basic(progname)) {
+		if (execdir == NULL)
+			return ENOENT;
+		exename = pathname_compose(execdir, progname);
+	} else {
+		exename = strdup(progname);
+	}
+
+	if (exename == NULL)
+		return ENOMEM;
+
+	rc = comp_set_ident(comp, exename);
+	free(exename);
+	return rc;
+}
+
+/** Run compiler with command-line arguments.
+ *
+ * @param tcomp Compiler to use or @c NULL to create a new one
+ *              (the caller retains ownership of @a tcomp)
+ * @param argc Number of arguments
+ * @param argv Arguments
+ * @return Exit status (0 on success, 1 on failure)
+ */
+static int syc_run(comp_t *tcomp, int argc, char *argv[])
 {
 	int rc;
 	int rv;
 	int i;
+	int j;
+	int nopts;
 	comp_flags_t flags = compf_none;
 	cgen_flags_t cgflags = cgf_none;
 	obj_linker_flags_t lflags = lf_none;
 	comp_t *comp = NULL;
 	const char *outfname = NULL;
+	const char *lscriptfname = NULL;
+	const char *cachedir = NULL;
+	const char *pchfname = NULL;
+	const char *dfname;
+	diag_fmt_t dfmt = dfmt_text;
+	diag_t *diag = NULL;
 	char *execdir;
+	bool banked = false;
+	unsigned bank = 0;
+	unsigned njobs = 1;
+	compile_job_t *cjobs = NULL;
+	int nfiles;
 
 	if (argc < 2) {
 		print_syntax();
@@ -573,16 +1085,31 @@ int main(int argc, char *argv[])
 		if (rc != EOK || rv < 0)
 			return 1;
 
+		rc = test_hmap();
+		rv = printf("test_hmap -> %d\n", rc);
+		if (rc != EOK || rv < 0)
+			return 1;
+
 		rc = test_ir();
 		rv = printf("test_ir -> %d\n", rc);
 		if (rc != EOK || rv < 0)
 			return 1;
 
+		rc = test_irbin();
+		rv = printf("test_irbin -> %d\n", rc);
+		if (rc != EOK || rv < 0)
+			return 1;
+
 		rc = test_ir_lexer();
 		rv = printf("test_ir -> %d\n", rc);
 		if (rc != EOK || rv < 0)
 			return 1;
 
+		rc = test_pch();
+		rv = printf("test_pch -> %d\n", rc);
+		if (rc != EOK || rv < 0)
+			return 1;
+
 		rc = test_scope();
 		rv = printf("test_scope -> %d\n", rc);
 		if (rc != EOK || rv < 0)
@@ -626,6 +1153,9 @@ int main(int argc, char *argv[])
 		} else if (strcmp(argv[i], "--dump-obj") == 0) {
 			++i;
 			flags |= compf_dump_obj;
+		} else if (strcmp(argv[i], "--irb-gen") == 0) {
+			++i;
+			flags |= compf_irb_gen;
 		} else if (strcmp(argv[i], "--no-comp") == 0) {
 			++i;
 			flags |= compf_no_comp;
@@ -653,9 +1183,62 @@ int main(int argc, char *argv[])
 		} else if (strncmp(argv[i], "--out=", strlen("--out=")) == 0) {
 			outfname = argv[i] + strlen("--out=");
 			++i;
+		} else if (strcmp(argv[i], "-j") == 0) {
+			if (argc <= i + 1) {
+				(void)fprintf(stderr, "Argument missing.\n");
+				return 1;
+			}
+
+			rc = parse_jobs(argv[i + 1], &njobs);
+			if (rc != EOK)
+				return 1;
+			i += 2;
+		} else if (strncmp(argv[i], "-j", strlen("-j")) == 0) {
+			rc = parse_jobs(argv[i] + strlen("-j"), &njobs);
+			if (rc != EOK)
+				return 1;
+			++i;
+		} else if (strcmp(argv[i], "-I") == 0) {
+			/* Include directories are added once compiler exists */
+			if (argc <= i + 1) {
+				(void)fprintf(stderr, "Argument missing.\n");
+				return 1;
+			}
+
+			i += 2;
+		} else if (strncmp(argv[i], "-I", strlen("-I")) == 0) {
+			++i;
+		} else if (strncmp(argv[i], "--cache-dir=",
+		    strlen("--cache-dir=")) == 0) {
+			cachedir = argv[i] + strlen("--cache-dir=");
+			++i;
+		} else if (strncmp(argv[i], "--diag-format=",
+		    strlen("--diag-format=")) == 0) {
+			dfname = argv[i] + strlen("--diag-format=");
+			rc = diag_fmt_parse(dfname, &dfmt);
+			if (rc != EOK) {
+				(void)fprintf(stderr, "Invalid diagnostic "
+				    "format '%s'.\n", dfname);
+				return 1;
+			}
+			++i;
+		} else if (strcmp(argv[i], "--pch-gen") == 0) {
+			++i;
+			flags |= compf_pch_gen;
+		} else if (strncmp(argv[i], "--pch=", strlen("--pch=")) == 0) {
+			pchfname = argv[i] + strlen("--pch=");
+			++i;
 		} else if (strcmp(argv[i], "--no-link-range-error") == 0) {
 			++i;
 			lflags |= lf_no_range_error;
+		} else if (strncmp(argv[i], "--link-script=",
+		    strlen("--link-script=")) == 0) {
+			lscriptfname = argv[i] + strlen("--link-script=");
+			++i;
+		} else if (strncmp(argv[i], "--bank=", strlen("--bank=")) == 0 ||
+		    strcmp(argv[i], "--no-bank") == 0) {
+			/* File placement options are processed with the files */
+			break;
 		} else if (strcmp(argv[i], "-") == 0) {
 			++i;
 			break;
@@ -670,33 +1253,403 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
-	execdir = pathname_get_execdir(argv[0], getenv("PATH"));
+	nopts = i;
 
-	rc = comp_create(execdir, &comp);
+	if (pchfname != NULL && (flags & compf_pch_gen) != compf_none) {
+		(void)fprintf(stderr, "Cannot use precompiled header while "
+		    "generating one.\n");
+		return 1;
+	}
+
+	rc = diag_create(dfmt, "syc", stderr, &diag);
 	if (rc != EOK) {
-		free(execdir);
-		(void)fprintf(stderr, "Failed creating compiler.\n");
+		(void)fprintf(stderr, "Out of memory.\n");
 		return 1;
 	}
 
-	free(execdir);
-	comp->lflags = lflags;
+	diag_set_sev_prefix(diag, true);
 
-	while (i < argc) {
-		rc = compile_file(comp, argv[i++], flags, cgflags);
+	if (tcomp != NULL) {
+		comp = tcomp;
+	} else {
+		execdir = pathname_get_execdir(argv[0], getenv("PATH"));
+
+		rc = comp_create(execdir, &comp);
 		if (rc != EOK) {
-			comp_destroy(comp);
+			free(execdir);
+			diag_destroy(diag);
+			(void)fprintf(stderr, "Failed creating compiler.\n");
 			return 1;
 		}
+
+		/* Without compiler identity the cache is not used */
+		(void)set_comp_ident(comp, argv[0], execdir);
+		free(execdir);
+	}
+
+	comp->lflags = lflags;
+	comp->diag = diag;
+
+	if (cachedir != NULL) {
+		rc = comp_set_cache_dir(comp, cachedir);
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Out of memory.\n");
+			goto error;
+		}
+
+		if (!comp->have_ident) {
+			(void)fprintf(stderr, "Warning: Cannot determine "
+			    "compiler identity, not using compilation "
+			    "cache.\n");
+		}
+	}
+
+	/* Add include directories in the order in which they were given */
+	j = 1;
+	while (j < nopts) {
+		rc = EOK;
+		if (strcmp(argv[j], "-I") == 0) {
+			rc = comp_add_incldir(comp, argv[j + 1]);
+			++j;
+		} else if (strncmp(argv[j], "-I", strlen("-I")) == 0) {
+			rc = comp_add_incldir(comp, argv[j] + strlen("-I"));
+		} else if (strcmp(argv[j], "-j") == 0) {
+			/* Skip argument to -j */
+			++j;
+		}
+
+		if (rc != EOK) {
+			(void)fprintf(stderr, "Out of memory.\n");
+			goto error;
+		}
+
+		++j;
+	}
+
+	if (lscriptfname != NULL) {
+		rc = comp_load_lscript(comp, lscriptfname);
+		if (rc != EOK)
+			goto error;
+	}
+
+	if (pchfname != NULL) {
+		/* Precompiled header is validated against code gen. flags */
+		comp->cgflags = cgflags;
+		rc = comp_set_pch(comp, pchfname);
+		if (rc == EINVAL) {
+			(void)fprintf(stderr, "Warning: Ignoring precompiled "
+			    "header '%s'.\n", pchfname);
+		} else if (rc != EOK) {
+			goto error;
+		}
+	} else {
+		/* Do not use header preloaded by compile server */
+		(void)comp_set_pch(comp, NULL);
+	}
+
+	cjobs = calloc((size_t)(argc - i), sizeof(compile_job_t));
+	if (cjobs == NULL) {
+		(void)fprintf(stderr, "Out of memory.\n");
+		goto error;
+	}
+
+	nfiles = 0;
+	while (i < argc) {
+		if (strncmp(argv[i], "--bank=", strlen("--bank=")) == 0) {
+			rc = parse_bank(argv[i] + strlen("--bank="), &bank);
+			if (rc != EOK)
+				goto error;
+
+			banked = true;
+			++i;
+			continue;
+		} else if (strcmp(argv[i], "--no-bank") == 0) {
+			banked = false;
+			++i;
+			continue;
+		}
+
+		cjobs[nfiles].comp = comp;
+		cjobs[nfiles].fname = argv[i++];
+		cjobs[nfiles].flags = flags;
+		cjobs[nfiles].cgflags = cgflags;
+		cjobs[nfiles].banked = banked;
+		cjobs[nfiles].bank = bank;
+		++nfiles;
+	}
+
+	/*
+	 * A SARIF log is a single JSON document that cannot be assembled
+	 * from the output of independent jobs.
+	 */
+	if (dfmt == dfmt_sarif)
+		njobs = 1;
+
+	if (njobs > 1 && !jobs_supported()) {
+		(void)fprintf(stderr, "Warning: Parallel compilation is not "
+		    "supported, compiling sequentially.\n");
+		njobs = 1;
 	}
 
+	if (njobs > 1 && nfiles > 1)
+		rc = compile_files_parallel(comp, cjobs, nfiles, njobs);
+	else
+		rc = compile_files(cjobs, nfiles);
+	if (rc != EOK)
+		goto error;
+
 	rc = link_binary(comp, outfname, flags);
-	if (rc != EOK) {
+	if (rc != EOK)
+		goto error;
+
+	free(cjobs);
+	comp->diag = NULL;
+	if (tcomp == NULL)
+		comp_destroy(comp);
+
+	rc = diag_finish(diag);
+	diag_destroy(diag);
+	if (rc != EOK)
+		return 1;
+
+	return 0;
+error:
+	if (cjobs != NULL)
+		free(cjobs);
+	comp->diag = NULL;
+	if (tcomp == NULL)
 		comp_destroy(comp);
+	(void)diag_finish(diag);
+	diag_destroy(diag);
+	return 1;
+}
+
+/** Compile server request being processed */
+typedef struct {
+	/** Compile server */
+	server_t *server;
+	/** Compiler to use */
+	comp_t *comp;
+	/** Request */
+	server_req_t *req;
+} server_job_t;
+
+/** Process compile server request.
+ *
+ * This is executed in the connection handler process with its own copy
+ * of the compiler.
+ *
+ * @param arg Server job (server_job_t *)
+ * @return Exit status
+ */
+static int server_job(void *arg)
+{
+	server_job_t *sjob = (server_job_t *)arg;
+	int rc;
+
+	rc = server_req_chdir(sjob->req);
+	if (rc != EOK)
+		return 1;
+
+	return syc_run(sjob->comp, sjob->req->argc, sjob->req->argv);
+}
+
+/** Handle compile server connection.
+ *
+ * This is executed in a separate process for each connection, so that
+ * a slow or stalled client does not hold up the server and the server's
+ * compiler is left intact. Reads the request, processes it and sends
+ * back the reply.
+ *
+ * @param arg Server job (server_job_t *)
+ * @param dataf Not used
+ * @return Exit status
+ */
+static int server_conn(void *arg, FILE *dataf)
+{
+	server_job_t *sjob = (server_job_t *)arg;
+	int rc;
+
+	(void)dataf;
+
+	/* Only the server accepts connections */
+	server_detach(sjob->server);
+	sjob->server = NULL;
+
+	rc = server_req_read(sjob->req);
+	if (rc != EOK)
+		return 1;
+
+	rc = server_req_run(sjob->req, server_job, sjob);
+	if (rc != EOK)
+		return 1;
+
+	return 0;
+}
+
+/** Run compile server.
+ *
+ * The server keeps the standard library (and optionally a precompiled
+ * header) preloaded and processes requests from clients until it is
+ * terminated. If the standard library or precompiled header file changes,
+ * it is loaded again. Each connection is handled in its own process,
+ * so the server can accept new connections while earlier requests are
+ * still being received or processed.
+ *
+ * @param progname Program name (argv[0])
+ * @param path Socket path
+ * @param pchfname Precompiled header file name or @c NULL
+ * @return Exit status
+ */
+static int syc_server(const char *progname, const char *path,
+    const char *pchfname)
+{
+	server_t *server = NULL;
+	server_req_t *req = NULL;
+	server_watch_t *watch = NULL;
+	server_watch_t *pchwatch = NULL;
+	server_job_t sjob;
+	comp_t *comp = NULL;
+	char *execdir;
+	char *libname = NULL;
+	int rc;
+
+	if (!server_supported() || !jobs_supported()) {
+		(void)fprintf(stderr, "Compile server is not supported.\n");
+		return 1;
+	}
+
+	execdir = pathname_get_execdir(progname, getenv("PATH"));
+
+	rc = comp_create(execdir, &comp);
+	if (rc != EOK) {
+		free(execdir);
+		(void)fprintf(stderr, "Failed creating compiler.\n");
 		return 1;
 	}
 
+	/* Without compiler identity the cache is not used */
+	(void)set_comp_ident(comp, progname, execdir);
+	free(execdir);
+
+	rc = comp_get_stdlib_fname(comp, &libname);
+	if (rc == EOK) {
+		rc = server_watch_create(libname, &watch);
+		if (rc != EOK)
+			goto error;
+
+		/* If this fails, the library is loaded by each request */
+		(void)comp_preload_stdlib(comp);
+	}
+
+	if (pchfname != NULL) {
+		rc = server_watch_create(pchfname, &pchwatch);
+		if (rc != EOK)
+			goto error;
+
+		/* If this fails, the header is loaded by each request */
+		(void)comp_preload_pch(comp, pchfname);
+	}
+
+	rc = server_create(path, &server);
+	if (rc != EOK)
+		goto error;
+
+	(void)printf("Listening on '%s'.\n", path);
+	(void)fflush(stdout);
+
+	while (true) {
+		rc = server_accept(server, &req);
+		if (rc != EOK)
+			goto error;
+
+		/* Collect handlers of connections that have been closed */
+		jobs_reap();
+
+		if (watch != NULL && server_watch_changed(watch)) {
+			(void)printf("'%s' changed, reloading.\n", libname);
+			(void)fflush(stdout);
+			(void)comp_preload_stdlib(comp);
+		}
+
+		if (pchwatch != NULL && server_watch_changed(pchwatch)) {
+			(void)printf("'%s' changed, reloading.\n", pchfname);
+			(void)fflush(stdout);
+			(void)comp_preload_pch(comp, pchfname);
+		}
+
+		/* Failure only affects this client */
+		sjob.server = server;
+		sjob.comp = comp;
+		sjob.req = req;
+		(void)jobs_spawn(server_conn, &sjob);
+
+		server_req_destroy(req);
+		req = NULL;
+	}
+
+	/* NOTREACHED */
+error:
+	server_req_destroy(req);
+	server_destroy(server);
+	server_watch_destroy(watch);
+	server_watch_destroy(pchwatch);
+	if (libname != NULL)
+		free(libname);
 	comp_destroy(comp);
+	return 1;
+}
 
-	return 0;
+/** Run compiler as a client of compile server.
+ *
+ * @param path Socket path
+ * @param argc Number of arguments
+ * @param argv Arguments (with the client option removed)
+ * @return Exit status
+ */
+static int syc_client(const char *path, int argc, char *argv[])
+{
+	int status;
+	int rc;
+
+	rc = server_client_run(path, argc, argv, &status);
+	if (rc != EOK) {
+		if (rc == ENOTSUP) {
+			(void)fprintf(stderr, "Compile server is not "
+			    "supported.\n");
+		} else {
+			(void)fprintf(stderr, "Error communicating with "
+			    "compile server.\n");
+		}
+		return 1;
+	}
+
+	return status;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path;
+
+	if (argc == 2 && strncmp(argv[1], "--server=",
+	    strlen("--server=")) == 0)
+		return syc_server(argv[0], argv[1] + strlen("--server="), NULL);
+
+	if (argc == 3 && strncmp(argv[1], "--server=",
+	    strlen("--server=")) == 0 && strncmp(argv[2], "--pch=",
+	    strlen("--pch=")) == 0) {
+		return syc_server(argv[0], argv[1] + strlen("--server="),
+		    argv[2] + strlen("--pch="));
+	}
+
+	if (argc >= 2 && strncmp(argv[1], "--client=",
+	    strlen("--client=")) == 0) {
+		path = argv[1] + strlen("--client=");
+
+		/* Pass the remaining arguments to the server */
+		argv[1] = argv[0];
+		return syc_client(path, argc - 1, argv + 1);
+	}
+
+	return syc_run(NULL, argc, argv);
 }
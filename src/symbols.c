@@ -27,6 +27,7 @@
  * Symbols correspond to identifiers in the global scope.
  */
 
+#include <adt/hmap.h>
 #include <cgtype.h>
 #include <merrno.h>
 #include <stdlib.h>
@@ -47,6 +48,7 @@ int symbols_create(symbols_t **rsymbols)
 		return ENOMEM;
 
 	list_initialize(&symbols->syms);
+	hmap_initialize(&symbols->byname, hmk_str);
 	*rsymbols = symbols;
 	return EOK;
 }
@@ -71,6 +73,7 @@ void symbols_destroy(symbols_t *symbols)
 		symbol = symbols_first(symbols);
 	}
 
+	hmap_fini(&symbols->byname);
 	free(symbols);
 }
 
@@ -89,6 +92,7 @@ int symbols_insert(symbols_t *symbols, symbol_type_t stype, comp_tok_t *tok,
     const char *irident, symbol_t **rsymbol)
 {
 	symbol_t *symbol;
+	int rc;
 
 	if (tok != NULL) {
 		symbol = symbols_lookup(symbols, tok->tok.text);
@@ -110,6 +114,15 @@ int symbols_insert(symbols_t *symbols, symbol_type_t stype, comp_tok_t *tok,
 		return ENOMEM;
 	}
 
+	if (tok != NULL) {
+		rc = hmap_insert_str(&symbols->byname, tok->tok.text, symbol);
+		if (rc != EOK) {
+			free(symbol->irident);
+			free(symbol);
+			return ENOMEM;
+		}
+	}
+
 	symbol->symbols = symbols;
 	list_append(&symbol->lsyms, &symbols->syms);
 	if (rsymbol != NULL)
@@ -157,16 +170,5 @@ symbol_t *symbols_next(symbol_t *cur)
  */
 symbol_t *symbols_lookup(symbols_t *symbols, const char *ident)
 {
-	symbol_t *symbol;
-
-	symbol = symbols_first(symbols);
-	while (symbol != NULL) {
-		if (symbol->ident != NULL &&
-		    strcmp(symbol->ident->tok.text, ident) == 0)
-			return symbol;
-
-		symbol = symbols_next(symbol);
-	}
-
-	return NULL;
+	return (symbol_t *)hmap_find_str(&symbols->byname, ident);
 }
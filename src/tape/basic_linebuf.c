@@ -54,7 +54,7 @@ void basic_linebuf_finish(basic_linebuf_t *linebuf)
 
 	llen = linebuf->len - 4;
 	linebuf->buf[2] = llen & 0xff;
-	linebuf->buf[3] = llen >> 16;
+	linebuf->buf[3] = llen >> 8;
 }
 
 /** Set line number.
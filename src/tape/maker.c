@@ -26,12 +26,14 @@
 
 #include <byteorder.h>
 #include <merrno.h>
+#include <stdbool.h>
 #include <object/object.h>
 #include <object/section.h>
 #include <string.h>
 #include <tape/basic_linebuf.h>
 #include <tape/maker.h>
 #include <tape/tape.h>
+#include <types/object/banksw.h>
 #include <types/tape/basic.h>
 #include <types/tape/romblock.h>
 
@@ -91,16 +93,67 @@ error:
 	return rc;
 }
 
+/** Append statements paging in a memory bank to BASIC line.
+ *
+ * @param linebuf BASIC line buffer
+ * @param bank Bank number
+ */
+static void tape_make_page_in(basic_linebuf_t *linebuf, unsigned bank)
+{
+	/* POKE <bankm>,<16+bank> */
+	basic_linebuf_append_u8(linebuf, btt_poke);
+	basic_linebuf_append_intlit(linebuf, obj_banksw_bankm);
+	basic_linebuf_append_u8(linebuf, ',');
+	basic_linebuf_append_intlit(linebuf, 16 + bank);
+
+	/* : */
+	basic_linebuf_append_u8(linebuf, ':');
+
+	/* OUT <port>,<16+bank> */
+	basic_linebuf_append_u8(linebuf, btt_out);
+	basic_linebuf_append_intlit(linebuf, obj_banksw_port);
+	basic_linebuf_append_u8(linebuf, ',');
+	basic_linebuf_append_intlit(linebuf, 16 + bank);
+
+	/* : */
+	basic_linebuf_append_u8(linebuf, ':');
+}
+
+/** Append statement loading a code block to BASIC line.
+ *
+ * @param linebuf BASIC line buffer
+ */
+static void tape_make_load_code(basic_linebuf_t *linebuf)
+{
+	/* LOAD ""CODE */
+	basic_linebuf_append_u8(linebuf, btt_load);
+	basic_linebuf_append_u8(linebuf, '"');
+	basic_linebuf_append_u8(linebuf, '"');
+	basic_linebuf_append_u8(linebuf, btt_code);
+
+	/* : */
+	basic_linebuf_append_u8(linebuf, ':');
+}
+
 /** Make a program loader.
+ *
+ * The loader loads one code block for each section in common memory,
+ * followed by one code block for each memory bank used by @a object.
  *
  * @param name Program file name
  * @param org Address where the code is loaded to and executed from
+ * @param object Linked executable object
  * @param tape Tape where the loader should be appended
  *
  * @return EOK on success or an error code
  */
-static int tape_make_loader(const char *name, uint16_t org, tape_t *tape)
+static int tape_make_loader(const char *name, uint16_t org,
+    obj_object_t *object, tape_t *tape)
 {
+	obj_section_t *section;
+	bool banked = false;
+	unsigned bank;
+	uint16_t base;
 	basic_linebuf_t linebuf;
 	tape_block_t *block;
 	uint8_t parity;
@@ -113,21 +166,39 @@ static int tape_make_loader(const char *name, uint16_t org, tape_t *tape)
 	/* Line number */
 	basic_linebuf_set_lineno(&linebuf, 10);
 
-	/* CLEAR <org> */
+	/* Code can be placed below the entry point */
+	base = (uint16_t)obj_object_get_bin_base(object);
+	if (base == 0 || base > org)
+		base = org;
+
+	/* CLEAR <base> */
 	basic_linebuf_append_u8(&linebuf, btt_clear);
-	basic_linebuf_append_intlit(&linebuf, org);
+	basic_linebuf_append_intlit(&linebuf, base);
 
 	/* : */
 	basic_linebuf_append_u8(&linebuf, ':');
 
-	/* LOAD ""CODE */
-	basic_linebuf_append_u8(&linebuf, btt_load);
-	basic_linebuf_append_u8(&linebuf, '"');
-	basic_linebuf_append_u8(&linebuf, '"');
-	basic_linebuf_append_u8(&linebuf, btt_code);
+	/* One code block for each section in common memory */
+	section = obj_section_first(object);
+	while (section != NULL) {
+		if (!obj_section_get_bank(section, &bank))
+			tape_make_load_code(&linebuf);
 
-	/* : */
-	basic_linebuf_append_u8(&linebuf, ':');
+		section = obj_section_next(section);
+	}
+
+	for (bank = 0; bank < obj_bank_count; bank++) {
+		if (!obj_object_has_bank(object, bank))
+			continue;
+
+		tape_make_page_in(&linebuf, bank);
+		tape_make_load_code(&linebuf);
+		banked = true;
+	}
+
+	/* Page bank 0 back in */
+	if (banked)
+		tape_make_page_in(&linebuf, 0);
 
 	/* RANDOMIZE USR <org> */
 	basic_linebuf_append_u8(&linebuf, btt_randomize);
@@ -162,6 +233,48 @@ error:
 	return rc;
 }
 
+/** Make code block from section.
+ *
+ * @param section Section
+ * @param tape Tape where the code block should be appended
+ * @return EOK on success or an error code
+ */
+static int tape_make_code(obj_section_t *section, tape_t *tape)
+{
+	tape_block_t *block;
+	uint16_t i;
+	uint8_t b;
+	uint8_t parity;
+	int rc;
+
+	if (section->len >= 0x7ffe)
+		return EINVAL;
+
+	/* header block */
+	rc = tape_make_header(ftype_bytes, section->name,
+	    (uint16_t)section->len, (uint16_t)section->base_addr,
+	    32768u, tape);
+	if (rc != EOK)
+		return rc;
+
+	/* data block */
+	rc = tape_block_append(tape, (uint16_t)(section->len + 2),
+	    &block);
+	if (rc != EOK)
+		return rc;
+
+	block->data[0] = bflag_data;
+	parity = block->data[0];
+	for (i = 0; i < (uint16_t)section->len; i++) {
+		b = section->data[i];
+		parity ^= b;
+		block->data[1 + i] = b;
+	}
+
+	block->data[1 + (size_t)section->len] = parity;
+	return EOK;
+}
+
 /** Make tape image from linked executable.
  *
  * @param object Linked executable object
@@ -174,53 +287,45 @@ int tape_make_from_object(obj_object_t *object, const char *name,
 {
 	obj_section_t *section;
 	tape_t *tape = NULL;
-	tape_block_t *block;
-	uint16_t i;
-	uint8_t b;
-	uint8_t parity;
+	unsigned bank;
+	unsigned sbank;
 	int rc;
 
 	rc = tape_create(&tape);
 	if (rc != EOK)
 		goto error;
 
-	rc = tape_make_loader(name, 0x8000u /* org */, tape);
+	rc = tape_make_loader(name, 0x8000u /* org */, object, tape);
 	if (rc != EOK)
 		goto error;
 
+	/* Common memory */
 	section = obj_section_first(object);
 	while (section != NULL) {
-		if (section->len >= 0x7ffe) {
-			rc = EINVAL;
-			goto error;
-		}
-
-		/* header block */
-		rc = tape_make_header(ftype_bytes, section->name,
-		    (uint16_t)section->len, 0x8000u /* org */,
-		    32768u, tape);
-		if (rc != EOK)
-			goto error;
-
-		/* data block */
-		rc = tape_block_append(tape, (uint16_t)(section->len + 2),
-		    &block);
-		if (rc != EOK)
-			goto error;
-
-		block->data[0] = bflag_data;
-		parity = block->data[0];
-		for (i = 0; i < (uint16_t)section->len; i++) {
-			b = section->data[i];
-			parity ^= b;
-			block->data[1 + i] = b;
+		if (!obj_section_get_bank(section, &sbank)) {
+			rc = tape_make_code(section, tape);
+			if (rc != EOK)
+				goto error;
 		}
 
-		block->data[1 + (size_t)section->len] = parity;
-
 		section = obj_section_next(section);
 	}
 
+	/* Memory banks, in the order in which the loader expects them */
+	for (bank = 0; bank < obj_bank_count; bank++) {
+		section = obj_section_first(object);
+		while (section != NULL) {
+			if (obj_section_get_bank(section, &sbank) &&
+			    sbank == bank) {
+				rc = tape_make_code(section, tape);
+				if (rc != EOK)
+					goto error;
+			}
+
+			section = obj_section_next(section);
+		}
+	}
+
 	*rtape = tape;
 	return EOK;
 error:
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test hash map
+ */
+
+#include <adt/hmap.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <test/adt/hmap.h>
+
+enum {
+	/** Number of entries for tests with many entries */
+	test_hmap_many = 200
+};
+
+/** Keys for test_hmap_str_many() */
+static char test_hmap_keys[test_hmap_many][8];
+/** Values for tests with many entries */
+static int test_hmap_vals[test_hmap_many];
+
+/** Test inserting, finding and removing entries with string keys.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_hmap_str(void)
+{
+	hmap_t hmap;
+	int a;
+	int b;
+	int rc;
+
+	hmap_initialize(&hmap, hmk_str);
+
+	if (hmap_find_str(&hmap, "a") != NULL)
+		goto error;
+
+	rc = hmap_insert_str(&hmap, "a", &a);
+	if (rc != EOK)
+		goto error;
+
+	rc = hmap_insert_str(&hmap, "b", &b);
+	if (rc != EOK)
+		goto error;
+
+	/* Existing entry is kept */
+	rc = hmap_insert_str(&hmap, "a", &b);
+	if (rc != EEXIST)
+		goto error;
+
+	if ((int *)hmap_find_str(&hmap, "a") != &a)
+		goto error;
+	if ((int *)hmap_find_str(&hmap, "b") != &b)
+		goto error;
+	if (hmap_find_str(&hmap, "c") != NULL)
+		goto error;
+	if (hmap_count(&hmap) != 2)
+		goto error;
+
+	hmap_remove_str(&hmap, "a");
+	hmap_remove_str(&hmap, "c");
+
+	if (hmap_find_str(&hmap, "a") != NULL)
+		goto error;
+	if ((int *)hmap_find_str(&hmap, "b") != &b)
+		goto error;
+	if (hmap_count(&hmap) != 1)
+		goto error;
+
+	hmap_fini(&hmap);
+	return EOK;
+error:
+	hmap_fini(&hmap);
+	return EINVAL;
+}
+
+/** Test hash map with many string keys.
+ *
+ * Enough entries are inserted to force the map to grow several times.
+ * Every other entry is then removed.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_hmap_str_many(void)
+{
+	hmap_t hmap;
+	int i;
+	int rc;
+
+	hmap_initialize(&hmap, hmk_str);
+
+	for (i = 0; i < test_hmap_many; i++) {
+		(void)snprintf(test_hmap_keys[i], sizeof(test_hmap_keys[i]),
+		    "k%d", i);
+		rc = hmap_insert_str(&hmap, test_hmap_keys[i],
+		    &test_hmap_vals[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	for (i = 0; i < test_hmap_many; i += 2)
+		hmap_remove_str(&hmap, test_hmap_keys[i]);
+
+	for (i = 0; i < test_hmap_many; i++) {
+		if (i % 2 == 0) {
+			if (hmap_find_str(&hmap, test_hmap_keys[i]) != NULL)
+				goto error;
+		} else {
+			if ((int *)hmap_find_str(&hmap, test_hmap_keys[i]) !=
+			    &test_hmap_vals[i])
+				goto error;
+		}
+	}
+
+	if (hmap_count(&hmap) != test_hmap_many / 2)
+		goto error;
+
+	hmap_fini(&hmap);
+	return EOK;
+error:
+	hmap_fini(&hmap);
+	return EINVAL;
+}
+
+/** Test hash map with integer keys.
+ *
+ * Keys are multiples of a power of two (which should not all fall
+ * into the same slot) and include negative numbers.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_hmap_int(void)
+{
+	hmap_t hmap;
+	int64_t key;
+	int i;
+	int rc;
+
+	hmap_initialize(&hmap, hmk_int);
+
+	if (hmap_find_int(&hmap, 0) != NULL)
+		goto error;
+
+	for (i = 0; i < test_hmap_many; i++) {
+		key = ((int64_t)i - test_hmap_many / 2) * 256;
+		rc = hmap_insert_int(&hmap, key, &test_hmap_vals[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	rc = hmap_insert_int(&hmap, 0, &test_hmap_vals[0]);
+	if (rc != EEXIST)
+		goto error;
+
+	for (i = 0; i < test_hmap_many; i += 3) {
+		key = ((int64_t)i - test_hmap_many / 2) * 256;
+		hmap_remove_int(&hmap, key);
+	}
+
+	for (i = 0; i < test_hmap_many; i++) {
+		key = ((int64_t)i - test_hmap_many / 2) * 256;
+		if (i % 3 == 0) {
+			if (hmap_find_int(&hmap, key) != NULL)
+				goto error;
+		} else {
+			if ((int *)hmap_find_int(&hmap, key) !=
+			    &test_hmap_vals[i])
+				goto error;
+		}
+	}
+
+	if (hmap_find_int(&hmap, 1) != NULL)
+		goto error;
+
+	hmap_fini(&hmap);
+	return EOK;
+error:
+	hmap_fini(&hmap);
+	return EINVAL;
+}
+
+/** Run hash map tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_hmap(void)
+{
+	int rc;
+
+	rc = test_hmap_str();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_hmap_str_many();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_hmap_int();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test memory arena
+ */
+
+#include <arena.h>
+#include <merrno.h>
+#include <stddef.h>
+#include <string.h>
+#include <test/arena.h>
+
+/** Test allocating blocks from arena.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_arena_alloc(void)
+{
+	arena_t *arena = NULL;
+	char *p;
+	char *q;
+	char *big;
+	unsigned i;
+	int rc;
+
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		return rc;
+
+	p = arena_zalloc(arena, 3);
+	if (p == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	if (p[0] != 0 || p[1] != 0 || p[2] != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Blocks are aligned */
+	q = arena_alloc(arena, 1);
+	if (q == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	if ((size_t)(q - p) % sizeof(void *) != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Fill several chunks */
+	for (i = 0; i < 200; i++) {
+		p = arena_alloc(arena, 100);
+		if (p == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		memset(p, 'x', 100);
+	}
+
+	/* Block larger than a chunk */
+	big = arena_alloc(arena, 10000);
+	if (big == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	memset(big, 'y', 10000);
+
+	arena_destroy(arena);
+	return EOK;
+error:
+	arena_destroy(arena);
+	return rc;
+}
+
+/** Test duplicating strings into arena.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_arena_strdup(void)
+{
+	arena_t *arena = NULL;
+	char *s;
+	char *t;
+	int rc;
+
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		return rc;
+
+	s = arena_strdup(arena, "hello");
+	t = arena_strndup(arena, "world!", 5);
+	if (s == NULL || t == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	if (strcmp(s, "hello") != 0 || strcmp(t, "world") != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	arena_destroy(arena);
+	return EOK;
+error:
+	arena_destroy(arena);
+	return rc;
+}
+
+/** Test releasing arena to a mark.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_arena_mark(void)
+{
+	arena_t *arena = NULL;
+	arena_mark_t mark;
+	arena_mark_t mark2;
+	char *p;
+	char *q;
+	unsigned i;
+	int rc;
+
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		return rc;
+
+	/* Mark an empty arena */
+	arena_mark(arena, &mark);
+
+	p = arena_strdup(arena, "keep");
+	if (p == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	arena_release(arena, &mark);
+
+	p = arena_strdup(arena, "keep");
+	if (p == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Nested marks, spanning several chunks */
+	arena_mark(arena, &mark);
+	for (i = 0; i < 100; i++) {
+		if (arena_alloc(arena, 100) == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+	}
+
+	arena_mark(arena, &mark2);
+	for (i = 0; i < 100; i++) {
+		if (arena_alloc(arena, 100) == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+	}
+
+	if (arena_alloc(arena, 60000U) == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	arena_release(arena, &mark2);
+	arena_release(arena, &mark);
+
+	/* Block allocated before the mark is intact */
+	if (strcmp(p, "keep") != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Memory after the mark is reused */
+	q = arena_strdup(arena, "again");
+	if (q == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	if (q < p || q - p > 16 || strcmp(p, "keep") != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	arena_destroy(arena);
+	return EOK;
+error:
+	arena_destroy(arena);
+	return rc;
+}
+
+/** Run memory arena tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_arena(void)
+{
+	int rc;
+
+	rc = test_arena_alloc();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_arena_strdup();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_arena_mark();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
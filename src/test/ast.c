@@ -24,6 +24,7 @@
  * Test AST
  */
 
+#include <arena.h>
 #include <ast.h>
 #include <merrno.h>
 #include <stdio.h>
@@ -204,6 +205,68 @@ static int test_ast_return(void)
 	return EOK;
 }
 
+/** Test allocating AST module from an arena.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_ast_arena(void)
+{
+	ast_module_t *module;
+	ast_gdecln_t *gdecln;
+	ast_dspecs_t *dspecs;
+	ast_idlist_t *idlist;
+	ast_eint_t *eint;
+	arena_t *arena;
+	arena_t *oarena;
+	arena_mark_t mark;
+	int rc;
+
+	rc = ast_module_create(&module);
+	if (rc != EOK)
+		return rc;
+
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		return rc;
+
+	module->arena = arena;
+	oarena = ast_set_arena(arena);
+
+	rc = ast_dspecs_create(&dspecs);
+	if (rc != EOK)
+		return rc;
+
+	rc = ast_idlist_create(&idlist);
+	if (rc != EOK)
+		return rc;
+
+	rc = ast_gdecln_create(dspecs, idlist, NULL, NULL, &gdecln);
+	if (rc != EOK)
+		return rc;
+
+	if (gdecln->node.arena != arena || dspecs->node.arena != arena)
+		return EINVAL;
+
+	ast_module_append(module, &gdecln->node);
+
+	/* Discard a node by releasing the arena */
+	arena_mark(arena, &mark);
+
+	rc = ast_eint_create(&eint);
+	if (rc != EOK)
+		return rc;
+
+	/* Does nothing for an arena node */
+	ast_tree_destroy(&eint->node);
+	arena_release(arena, &mark);
+
+	(void)ast_set_arena(oarena);
+
+	/* Frees the arena with all nodes */
+	ast_tree_destroy(&module->node);
+	return EOK;
+}
+
 /** Run AST tests.
  *
  * @return EOK on success or non-zero error code
@@ -232,5 +295,9 @@ int test_ast(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_ast_arena();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
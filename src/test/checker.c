@@ -28,10 +28,38 @@
 #include <merrno.h>
 #include <src_pos.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <str_input.h>
 #include <string.h>
 #include <test/checker.h>
 
+enum {
+	/** Smallest number of entries in benchmark tables */
+	test_checker_bench_min = 1000,
+	/** Largest number of entries in benchmark tables */
+	test_checker_bench_max = 16000,
+	/** Maximum size of one generated table entry */
+	test_checker_entry_size = 48
+};
+
+/** Shape of a generated benchmark source file */
+typedef enum {
+	/** Initializer table with all entries on one line */
+	tcs_long_line,
+	/** Initializer table with a comment before each entry */
+	tcs_comments,
+	/** Function with a long block of statements */
+	tcs_block
+} test_checker_shape_t;
+
+/** Names of benchmark source file shapes */
+static const char *test_checker_shape_name[] = {
+	[tcs_long_line] = "Long line",
+	[tcs_comments] = "Commented table",
+	[tcs_block] = "Long block"
+};
+
 static const char *str_hello =
     "int main(void) {\nreturn 0; return 0; return 0; return 0;\n"
     "return 0;\nreturn 0;\nreturn 0 ; return 0;\n"
@@ -51,7 +79,9 @@ static int test_check_string(const char *str)
 
 	checker_cfg_init(&cfg);
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg, &checker);
 	if (rc != EOK)
@@ -66,6 +96,156 @@ static int test_check_string(const char *str)
 	return EOK;
 }
 
+/** Generate benchmark source file.
+ *
+ * @param shape Shape of the source file
+ * @param n Number of entries
+ * @param rstr Place to store pointer to newly allocated source code
+ * @return EOK on success or ENOMEM if out of memory
+ */
+static int test_checker_gen(test_checker_shape_t shape, int n, char **rstr)
+{
+	char *str;
+	size_t size;
+	size_t len;
+	int i;
+
+	size = (size_t)(n + 2) * test_checker_entry_size;
+	str = malloc(size);
+	if (str == NULL)
+		return ENOMEM;
+
+	len = 0;
+	if (shape == tcs_block) {
+		len += (size_t)snprintf(str + len, size - len,
+		    "int f(int *a)\n{\n");
+	} else {
+		len += (size_t)snprintf(str + len, size - len,
+		    "int tbl[] = {\n\t");
+	}
+
+	for (i = 0; i < n; i++) {
+		switch (shape) {
+		case tcs_long_line:
+			len += (size_t)snprintf(str + len, size - len,
+			    "%d, ", i);
+			break;
+		case tcs_comments:
+			len += (size_t)snprintf(str + len, size - len,
+			    "/* Entry %d */\n\t%d,\n\t", i, i);
+			break;
+		case tcs_block:
+			len += (size_t)snprintf(str + len, size - len,
+			    "\ta[%d] = a[%d] + %d;\n", i, i, i);
+			break;
+		}
+	}
+
+	if (shape == tcs_block) {
+		(void)snprintf(str + len, size - len, "\treturn 0;\n}\n");
+	} else {
+		(void)snprintf(str + len, size - len, "%d\n};\n", n);
+	}
+
+	*rstr = str;
+	return EOK;
+}
+
+/** Check benchmark source file and count steps made by checker.
+ *
+ * @param shape Shape of the source file
+ * @param n Number of entries
+ * @param rsteps Place to store number of steps made by checker
+ * @return EOK on success or non-zero error code
+ */
+static int test_checker_steps(test_checker_shape_t shape, int n,
+    unsigned long *rsteps)
+{
+	checker_t *checker;
+	str_input_t sinput;
+	checker_cfg_t cfg;
+	char *str;
+	int rc;
+
+	rc = test_checker_gen(shape, n, &str);
+	if (rc != EOK)
+		return rc;
+
+	checker_cfg_init(&cfg);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK) {
+		free(str);
+		return rc;
+	}
+
+	rc = checker_create(&lexer_str_input, &sinput, cmod_c, &cfg,
+	    &checker);
+	if (rc != EOK) {
+		free(str);
+		return rc;
+	}
+
+	rc = checker_run(checker, false);
+	if (rc != EOK) {
+		checker_destroy(checker);
+		free(str);
+		return rc;
+	}
+
+	/* The generated source should not have any issues */
+	if (checker_get_nissues(checker) != 0) {
+		checker_destroy(checker);
+		free(str);
+		return EINVAL;
+	}
+
+	*rsteps = checker_get_nsteps(checker);
+	checker_destroy(checker);
+	free(str);
+	return EOK;
+}
+
+/** Benchmark checker on large synthetic source files.
+ *
+ * The work done by the checker (number of steps traversing the token
+ * list) must grow linearly with the size of the source file, even with
+ * huge initializer tables or very long lines.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_checker_bench(void)
+{
+	test_checker_shape_t shape;
+	unsigned long steps;
+	unsigned long prev_steps;
+	int n;
+	int rc;
+	int rv;
+
+	for (shape = tcs_long_line; shape <= tcs_block; shape++) {
+		prev_steps = 0;
+		for (n = test_checker_bench_min; n <= test_checker_bench_max;
+		    n *= 2) {
+			rc = test_checker_steps(shape, n, &steps);
+			if (rc != EOK)
+				return rc;
+
+			rv = printf("%s, %d entries: %lu steps\n",
+			    test_checker_shape_name[shape], n, steps);
+			if (rv < 0)
+				return EIO;
+
+			/* Doubling the size may at most triple the work */
+			if (prev_steps != 0 && steps > 3 * prev_steps)
+				return EINVAL;
+
+			prev_steps = steps;
+		}
+	}
+
+	return EOK;
+}
+
 /** Run checker tests.
  *
  * @return EOK on success or non-zero error code
@@ -78,5 +258,9 @@ int test_checker(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_checker_bench();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
@@ -47,7 +47,9 @@ static int test_comp_string(const char *str)
 	comp_module_t *module;
 	str_input_t sinput;
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = comp_create(NULL, &comp);
 	if (rc != EOK)
@@ -368,11 +368,11 @@ static int test_ir_instr(void)
 	instr->itype = iri_add;
 	instr->width = 8;
 
-	rc = ir_oper_var_create("%2", &dest);
+	rc = ir_oper_temp_create(2, &dest);
 	if (rc != EOK)
 		return rc;
 
-	rc = ir_oper_var_create("%1", &op1);
+	rc = ir_oper_temp_create(1, &op1);
 	if (rc != EOK)
 		return rc;
 
@@ -403,7 +403,7 @@ static int test_ir_oper(void)
 	int rc;
 	int rv;
 
-	rc = ir_oper_var_create("%1", &var);
+	rc = ir_oper_temp_create(1, &var);
 	if (rc != EOK)
 		return rc;
 
@@ -455,19 +455,19 @@ static int test_ir_oper_list(void)
 
 	assert(list != NULL);
 
-	rc = ir_oper_var_create("%1", &v1);
+	rc = ir_oper_temp_create(1, &v1);
 	if (rc != EOK)
 		return rc;
 
 	assert(v1 != NULL);
 
-	rc = ir_oper_var_create("%2", &v2);
+	rc = ir_oper_temp_create(2, &v2);
 	if (rc != EOK)
 		return rc;
 
 	assert(v2 != NULL);
 
-	rc = ir_oper_var_create("%3", &v3);
+	rc = ir_oper_temp_create(3, &v3);
 	if (rc != EOK)
 		return rc;
 
@@ -489,6 +489,64 @@ static int test_ir_oper_list(void)
 	return EOK;
 }
 
+/** Test numbered temporary names.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_ir_temp(void)
+{
+	ir_oper_var_t *var = NULL;
+	char buf[ir_temp_name_size];
+	unsigned tempno;
+	int rc;
+
+	rc = ir_temp_parse("%0", &tempno);
+	if (rc != EOK || tempno != 0)
+		return EINVAL;
+
+	rc = ir_temp_parse("%42", &tempno);
+	if (rc != EOK || tempno != 42)
+		return EINVAL;
+
+	/* Named variables, leading zeroes and garbage are not temporaries */
+	if (ir_temp_parse("%foo", &tempno) == EOK)
+		return EINVAL;
+	if (ir_temp_parse("%1@foo", &tempno) == EOK)
+		return EINVAL;
+	if (ir_temp_parse("%01", &tempno) == EOK)
+		return EINVAL;
+	if (ir_temp_parse("%", &tempno) == EOK)
+		return EINVAL;
+	if (ir_temp_parse("@1", &tempno) == EOK)
+		return EINVAL;
+	if (ir_temp_parse("%99999999999999999999", &tempno) == EOK)
+		return EINVAL;
+
+	rc = ir_oper_temp_create(42, &var);
+	if (rc != EOK)
+		return rc;
+
+	if (var->varname != NULL || var->tempno != 42 ||
+	    strcmp(ir_oper_var_name(var, buf), "%42") != 0) {
+		ir_oper_destroy(&var->oper);
+		return EINVAL;
+	}
+
+	ir_oper_destroy(&var->oper);
+
+	rc = ir_oper_var_create("%foo", &var);
+	if (rc != EOK)
+		return rc;
+
+	if (strcmp(ir_oper_var_name(var, buf), "%foo") != 0) {
+		ir_oper_destroy(&var->oper);
+		return EINVAL;
+	}
+
+	ir_oper_destroy(&var->oper);
+	return EOK;
+}
+
 /** Run IR tests.
  *
  * @return EOK on success or non-zero error code
@@ -529,5 +587,9 @@ int test_ir(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_ir_temp();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
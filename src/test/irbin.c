@@ -0,0 +1,461 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Binary IR unit tests
+ */
+
+#include <ir.h>
+#include <irbin.h>
+#include <merrno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/irbin.h>
+
+/** Append instruction to labeled block.
+ *
+ * @param lblock Labeled block
+ * @param label Label or @c NULL
+ * @param itype Instruction type
+ * @param dest Destination operand or @c NULL
+ * @param op1 First operand or @c NULL
+ * @param op2 Second operand or @c NULL
+ * @return EOK on success, ENOMEM if out of memory (the operands are
+ *         destroyed in any case)
+ */
+static int test_irbin_instr(ir_lblock_t *lblock, const char *label,
+    ir_instr_type_t itype, ir_oper_t *dest, ir_oper_t *op1, ir_oper_t *op2)
+{
+	ir_instr_t *instr;
+	int rc;
+
+	rc = ir_instr_create(&instr);
+	if (rc != EOK) {
+		ir_oper_destroy(dest);
+		ir_oper_destroy(op1);
+		ir_oper_destroy(op2);
+		return rc;
+	}
+
+	instr->itype = itype;
+	instr->width = 16;
+	instr->dest = dest;
+	instr->op1 = op1;
+	instr->op2 = op2;
+
+	rc = ir_lblock_append(lblock, label, instr);
+	if (rc != EOK) {
+		ir_instr_destroy(instr);
+		return rc;
+	}
+
+	return EOK;
+}
+
+/** Create IR module containing all kinds of declarations and operands.
+ *
+ * @param rmodule Place to store pointer to new module
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int test_irbin_module(ir_module_t **rmodule)
+{
+	ir_module_t *module = NULL;
+	ir_record_t *record;
+	ir_var_t *var;
+	ir_dblock_t *dblock = NULL;
+	ir_dentry_t *dentry;
+	ir_proc_t *proc;
+	ir_proc_arg_t *arg;
+	ir_proc_attr_t *attr;
+	ir_lvar_t *lvar;
+	ir_lblock_t *lblock = NULL;
+	ir_texpr_t *texpr = NULL;
+	ir_texpr_t *etexpr;
+	ir_oper_var_t *v1;
+	ir_oper_var_t *v2;
+	ir_oper_imm_t *imm;
+	ir_oper_list_t *list;
+	int rc;
+
+	rc = ir_module_create(&module);
+	if (rc != EOK)
+		goto error;
+
+	/* struct @@s { @a: int.16; @b: @@s[3]; } */
+	rc = ir_record_create("@@s", irrt_struct, &record);
+	if (rc != EOK)
+		goto error;
+
+	ir_module_append(module, &record->decln);
+
+	rc = ir_texpr_int_create(16, &texpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_record_append(record, "@a", texpr, NULL);
+	if (rc != EOK)
+		goto error;
+
+	ir_texpr_destroy(texpr);
+	texpr = NULL;
+
+	rc = ir_texpr_ident_create("@@s", &etexpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_texpr_array_create(3, etexpr, &texpr);
+	if (rc != EOK) {
+		ir_texpr_destroy(etexpr);
+		goto error;
+	}
+
+	rc = ir_record_append(record, "@b", texpr, NULL);
+	if (rc != EOK)
+		goto error;
+
+	ir_texpr_destroy(texpr);
+	texpr = NULL;
+
+	/* Global variable with integer and pointer data */
+	rc = ir_dblock_create(&dblock);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_dentry_create_int(16, -12345, &dentry);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_dblock_append(dblock, dentry);
+	if (rc != EOK) {
+		ir_dentry_destroy(dentry);
+		goto error;
+	}
+
+	rc = ir_dentry_create_ptr(16, "@ext", 2, &dentry);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_dblock_append(dblock, dentry);
+	if (rc != EOK) {
+		ir_dentry_destroy(dentry);
+		goto error;
+	}
+
+	rc = ir_texpr_ptr_create(16, &texpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_var_create("@var", texpr, irl_global, dblock, &var);
+	if (rc != EOK)
+		goto error;
+
+	texpr = NULL;
+	dblock = NULL;
+	ir_module_append(module, &var->decln);
+
+	/* Extern variable without data */
+	rc = ir_texpr_int_create(8, &texpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_var_create("@ext", texpr, irl_extern, NULL, &var);
+	if (rc != EOK)
+		goto error;
+
+	texpr = NULL;
+	ir_module_append(module, &var->decln);
+
+	/* Extern procedure declaration */
+	rc = ir_proc_create("@eproc", irl_extern, NULL, &proc);
+	if (rc != EOK)
+		goto error;
+
+	ir_module_append(module, &proc->decln);
+
+	/* Procedure definition */
+	rc = ir_lblock_create(&lblock);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_oper_temp_create(2, &v1);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_oper_var_create("%i", &v2);
+	if (rc != EOK) {
+		ir_oper_destroy(&v1->oper);
+		goto error;
+	}
+
+	rc = ir_oper_imm_create(-0x123456789ll, &imm);
+	if (rc != EOK) {
+		ir_oper_destroy(&v1->oper);
+		ir_oper_destroy(&v2->oper);
+		goto error;
+	}
+
+	rc = test_irbin_instr(lblock, "%l0", iri_add, &v1->oper, &v2->oper,
+	    &imm->oper);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_oper_list_create(&list);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_oper_temp_create(2, &v1);
+	if (rc != EOK) {
+		ir_oper_destroy(&list->oper);
+		goto error;
+	}
+
+	ir_oper_list_append(list, &v1->oper);
+
+	rc = ir_oper_var_create("@eproc", &v2);
+	if (rc != EOK) {
+		ir_oper_destroy(&list->oper);
+		goto error;
+	}
+
+	rc = test_irbin_instr(lblock, NULL, iri_call, NULL, &v2->oper,
+	    &list->oper);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_lblock_append(lblock, "%end", NULL);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_proc_create("@proc", irl_global, lblock, &proc);
+	if (rc != EOK)
+		goto error;
+
+	lblock = NULL;
+	ir_module_append(module, &proc->decln);
+	proc->variadic = true;
+
+	rc = ir_texpr_va_list_create(&proc->rtype);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_texpr_int_create(16, &texpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_proc_arg_create("%0", texpr, &arg);
+	if (rc != EOK)
+		goto error;
+
+	texpr = NULL;
+	ir_proc_append_arg(proc, arg);
+
+	rc = ir_proc_attr_create("usr", &attr);
+	if (rc != EOK)
+		goto error;
+
+	ir_proc_append_attr(proc, attr);
+
+	rc = ir_texpr_int_create(32, &texpr);
+	if (rc != EOK)
+		goto error;
+
+	rc = ir_lvar_create("%i", texpr, &lvar);
+	if (rc != EOK)
+		goto error;
+
+	texpr = NULL;
+	ir_proc_append_lvar(proc, lvar);
+
+	*rmodule = module;
+	return EOK;
+error:
+	ir_texpr_destroy(texpr);
+	ir_dblock_destroy(dblock);
+	ir_lblock_destroy(lblock);
+	ir_module_destroy(module);
+	return rc;
+}
+
+/** Test saving and loading back binary IR.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_irbin_save_load(void)
+{
+	ir_module_t *module = NULL;
+	ir_module_t *lmodule = NULL;
+	ir_decln_t *decln;
+	ir_proc_t *proc;
+	uint8_t *data = NULL;
+	uint8_t *ldata = NULL;
+	size_t size;
+	size_t lsize;
+	int rc;
+
+	rc = test_irbin_module(&module);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_save_buf(module, &data, &size);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_load_buf(data, size, &lmodule);
+	if (rc != EOK)
+		goto error;
+
+	/* Saving the loaded module must produce identical data */
+	rc = irbin_save_buf(lmodule, &ldata, &lsize);
+	if (rc != EOK)
+		goto error;
+
+	rc = EINVAL;
+	if (lsize != size || memcmp(data, ldata, size) != 0)
+		goto error;
+
+	decln = ir_module_first(lmodule);
+	if (decln == NULL || decln->dtype != ird_record)
+		goto error;
+
+	decln = ir_module_next(ir_module_next(ir_module_next(decln)));
+	if (decln == NULL || decln->dtype != ird_proc)
+		goto error;
+
+	decln = ir_module_next(decln);
+	if (decln == NULL || decln->dtype != ird_proc ||
+	    ir_module_next(decln) != NULL)
+		goto error;
+
+	proc = (ir_proc_t *)decln->ext;
+	if (strcmp(proc->ident, "@proc") != 0 || !proc->variadic ||
+	    proc->linkage != irl_global || proc->lblock == NULL ||
+	    proc->rtype == NULL || proc->rtype->tetype != irt_va_list)
+		goto error;
+
+	free(data);
+	free(ldata);
+	ir_module_destroy(module);
+	ir_module_destroy(lmodule);
+	return EOK;
+error:
+	if (data != NULL)
+		free(data);
+	if (ldata != NULL)
+		free(ldata);
+	ir_module_destroy(module);
+	ir_module_destroy(lmodule);
+	return rc;
+}
+
+/** Test loading truncated or otherwise damaged binary IR.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_irbin_load_bad(void)
+{
+	ir_module_t *module = NULL;
+	ir_module_t *lmodule = NULL;
+	uint8_t *data = NULL;
+	uint8_t *ldata = NULL;
+	size_t size;
+	size_t i;
+	int rc;
+
+	rc = test_irbin_module(&module);
+	if (rc != EOK)
+		goto error;
+
+	rc = irbin_save_buf(module, &data, &size);
+	if (rc != EOK)
+		goto error;
+
+	ldata = malloc(size + 1);
+	if (ldata == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Every proper prefix of the data must be rejected */
+	for (i = 0; i < size; i++) {
+		memcpy(ldata, data, i);
+		rc = irbin_load_buf(ldata, i, &lmodule);
+		if (rc != EINVAL) {
+			if (rc == EOK)
+				ir_module_destroy(lmodule);
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	/* Trailing data must be rejected */
+	memcpy(ldata, data, size);
+	ldata[size] = 0;
+	rc = irbin_load_buf(ldata, size + 1, &lmodule);
+	if (rc != EINVAL) {
+		if (rc == EOK)
+			ir_module_destroy(lmodule);
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Wrong signature must be rejected */
+	ldata[0] ^= 0xff;
+	rc = irbin_load_buf(ldata, size, &lmodule);
+	if (rc != EINVAL) {
+		if (rc == EOK)
+			ir_module_destroy(lmodule);
+		rc = EINVAL;
+		goto error;
+	}
+
+	free(data);
+	free(ldata);
+	ir_module_destroy(module);
+	return EOK;
+error:
+	if (data != NULL)
+		free(data);
+	if (ldata != NULL)
+		free(ldata);
+	ir_module_destroy(module);
+	return rc;
+}
+
+/** Run binary IR tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_irbin(void)
+{
+	int rc;
+
+	rc = test_irbin_save_load();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_irbin_load_bad();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
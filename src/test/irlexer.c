@@ -54,7 +54,9 @@ static int test_ir_lex_string(const char *str)
 	bool done;
 	ir_lexer_tok_t tok;
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = ir_lexer_create(&lexer_str_input, &sinput, &lexer);
 	if (rc != EOK)
@@ -84,7 +86,9 @@ static int test_ir_lex_string(const char *str)
 	if (rv < 0)
 		return EIO;
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = ir_lexer_create(&lexer_str_input, &sinput, &lexer);
 	if (rc != EOK)
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test keyword table
+ */
+
+#include <kwtab.h>
+#include <merrno.h>
+#include <string.h>
+#include <test/kwtab.h>
+
+/** Test keyword table entry */
+typedef struct {
+	/** Keyword */
+	const char *kw;
+	/** Value */
+	int value;
+} test_kw_t;
+
+/** Test keywords */
+static const test_kw_t test_kw_entries[] = {
+	{ "adc", 1 },
+	{ "add", 2 },
+	{ "and", 3 },
+	{ "call", 4 },
+	{ "cp", 5 },
+	{ "cpd", 6 },
+	{ "cpdr", 7 },
+	{ "do", 8 },
+	{ "double", 9 },
+	{ "ld", 10 },
+	{ "ldir", 11 },
+	{ "while", 12 }
+};
+
+/** Test keyword table */
+static kwtab_t test_kwtab_tab = {
+	.entries = test_kw_entries,
+	.nentries = sizeof(test_kw_entries) / sizeof(test_kw_t),
+	.esize = sizeof(test_kw_t)
+};
+
+/** Test looking up keywords.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_kwtab_lookup(void)
+{
+	const test_kw_t *e;
+	const test_kw_t *kw;
+	size_t i;
+
+	if (kwtab_maxlen(&test_kwtab_tab) != 6)
+		return EINVAL;
+
+	for (i = 0; i < test_kwtab_tab.nentries; i++) {
+		e = &test_kw_entries[i];
+		kw = kwtab_lookup(&test_kwtab_tab, e->kw, strlen(e->kw));
+		if (kw != e)
+			return EINVAL;
+	}
+
+	/* Prefix of a longer string */
+	kw = kwtab_lookup(&test_kwtab_tab, "double", 2);
+	if (kw == NULL || kw->value != 8)
+		return EINVAL;
+
+	/* Not keywords */
+	if (kwtab_lookup(&test_kwtab_tab, "dou", 3) != NULL)
+		return EINVAL;
+	if (kwtab_lookup(&test_kwtab_tab, "cpdrx", 5) != NULL)
+		return EINVAL;
+	if (kwtab_lookup(&test_kwtab_tab, "foo", 3) != NULL)
+		return EINVAL;
+	if (kwtab_lookup(&test_kwtab_tab, "", 0) != NULL)
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Run keyword table tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_kwtab(void)
+{
+	int rc;
+
+	rc = test_kwtab_lookup();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
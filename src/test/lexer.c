@@ -54,7 +54,9 @@ static int test_lex_string(const char *str)
 	bool done;
 	lexer_tok_t tok;
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = lexer_create(&lexer_str_input, &sinput, &lexer);
 	if (rc != EOK)
@@ -82,7 +84,9 @@ static int test_lex_string(const char *str)
 	if (rv < 0)
 		return EIO;
 
-	str_input_init(&sinput, str);
+	rc = str_input_init(&sinput, str);
+	if (rc != EOK)
+		return rc;
 
 	rc = lexer_create(&lexer_str_input, &sinput, &lexer);
 	if (rc != EOK)
@@ -0,0 +1,328 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test C style checker library
+ */
+
+#include <checker.h>
+#include <libccheck.h>
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <test/libccheck.h>
+
+/** Source code with two issues in the second function */
+static const char *test_libccheck_src =
+    "int a(void)\n"
+    "{\n"
+    "\treturn 1;\n"
+    "}\n"
+    "\n"
+    "int b(void)\n"
+    "{\n"
+    "  return 2;\n"
+    "}\n"
+    "\n"
+    "/* Third function */\n"
+    "int c(void)\n"
+    "{\n"
+    "\treturn 3 ;\n"
+    "}\n";
+
+/** Create document and check source code.
+ *
+ * @param text Source code
+ * @param rdoc Place to store pointer to new document
+ * @return EOK on success or non-zero error code
+ */
+static int test_libccheck_doc(const char *text, libccheck_doc_t **rdoc)
+{
+	checker_cfg_t cfg;
+	libccheck_doc_t *doc;
+	int rc;
+
+	checker_cfg_init(&cfg);
+
+	rc = libccheck_doc_create(cmod_c, &cfg, &doc);
+	if (rc != EOK)
+		return rc;
+
+	rc = libccheck_doc_set_text(doc, text, strlen(text));
+	if (rc != EOK) {
+		libccheck_doc_destroy(doc);
+		return rc;
+	}
+
+	*rdoc = doc;
+	return EOK;
+}
+
+/** Compare diagnostics of two documents.
+ *
+ * @param a First document
+ * @param b Second document
+ * @return EOK if the diagnostics are the same, EINVAL otherwise
+ */
+static int test_libccheck_cmp(libccheck_doc_t *a, libccheck_doc_t *b)
+{
+	libccheck_diag_t *da;
+	libccheck_diag_t *db;
+
+	da = libccheck_diag_first(a);
+	db = libccheck_diag_first(b);
+	while (da != NULL && db != NULL) {
+		if (da->bpos.line != db->bpos.line ||
+		    da->bpos.col != db->bpos.col ||
+		    da->epos.line != db->epos.line ||
+		    da->epos.col != db->epos.col ||
+		    strcmp(da->msg, db->msg) != 0)
+			return EINVAL;
+
+		da = libccheck_diag_next(da);
+		db = libccheck_diag_next(db);
+	}
+
+	if (da != NULL || db != NULL)
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Test checking a document.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_libccheck_check(void)
+{
+	libccheck_doc_t *doc;
+	libccheck_diag_t *diag;
+	int i;
+	int rc;
+
+	rc = test_libccheck_doc(test_libccheck_src, &doc);
+	if (rc != EOK)
+		return rc;
+
+	/* Three issues with indentation at line 8 */
+	diag = libccheck_diag_first(doc);
+	for (i = 0; i < 3; i++) {
+		if (diag == NULL || diag->bpos.line != 8 ||
+		    diag->bpos.col != 3 || strcmp(diag->check, "fmt") != 0 ||
+		    !diag->fixable) {
+			rc = EINVAL;
+			goto error;
+		}
+
+		diag = libccheck_diag_next(diag);
+	}
+
+	/* Whitespace before semicolon at line 14 (tab is 8 columns) */
+	if (diag == NULL || diag->bpos.line != 14 || diag->bpos.col != 17) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	if (libccheck_diag_next(diag) != NULL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	libccheck_doc_destroy(doc);
+	return EOK;
+error:
+	libccheck_doc_destroy(doc);
+	return rc;
+}
+
+/** Find string in document text.
+ *
+ * @param doc Document
+ * @param str String to find
+ * @return Offset of the first occurrence of @a str (which must exist)
+ */
+static size_t test_libccheck_find(libccheck_doc_t *doc, const char *str)
+{
+	size_t len;
+	size_t i;
+
+	len = strlen(str);
+	i = 0;
+	while (strncmp(doc->text + i, str, len) != 0)
+		++i;
+
+	return i;
+}
+
+/** Apply edit and compare diagnostics with checking the entire text.
+ *
+ * @param doc Document
+ * @param boff Offset of the beginning of the replaced range
+ * @param eoff Offset of the end of the replaced range
+ * @param text Replacement text
+ * @param maxlines Maximum number of lines that should be checked
+ * @return EOK on success or non-zero error code
+ */
+static int test_libccheck_edit_check(libccheck_doc_t *doc, size_t boff,
+    size_t eoff, const char *text, uint32_t maxlines)
+{
+	libccheck_doc_t *fdoc;
+	int rc;
+
+	rc = libccheck_doc_edit(doc, boff, eoff, text, strlen(text));
+	if (rc != EOK)
+		return rc;
+
+	if (doc->nclines > maxlines)
+		return EINVAL;
+
+	rc = test_libccheck_doc(doc->text, &fdoc);
+	if (rc != EOK)
+		return rc;
+
+	rc = test_libccheck_cmp(doc, fdoc);
+	libccheck_doc_destroy(fdoc);
+	return rc;
+}
+
+/** Test re-checking a document after edits.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_libccheck_edit(void)
+{
+	libccheck_doc_t *doc;
+	size_t off;
+	int rc;
+
+	rc = test_libccheck_doc(test_libccheck_src, &doc);
+	if (rc != EOK)
+		return rc;
+
+	/* Fix indentation in the second function */
+	off = test_libccheck_find(doc, "  return 2;");
+	rc = test_libccheck_edit_check(doc, off, off + 2, "\t", 5);
+	if (rc != EOK)
+		goto error;
+
+	/* Insert lines with an issue into the first function */
+	off = test_libccheck_find(doc, "\treturn 1;");
+	rc = test_libccheck_edit_check(doc, off, off, "\tint x;\n\tx = 1 ;\n",
+	    6);
+	if (rc != EOK)
+		goto error;
+
+	/* Remove the comment and the second function */
+	off = test_libccheck_find(doc, "int b");
+	rc = test_libccheck_edit_check(doc, off,
+	    test_libccheck_find(doc, "int c"), "", 10);
+	if (rc != EOK)
+		goto error;
+
+	/*
+	 * Comment added after a function belongs to the following one,
+	 * which thus needs to be checked as well
+	 */
+	off = test_libccheck_find(doc, "}\n");
+	rc = test_libccheck_edit_check(doc, off + 1, off + 1, "\n/* Next */",
+	    100);
+	if (rc != EOK)
+		goto error;
+
+	/* Stray brace cannot be parsed */
+	rc = libccheck_doc_edit(doc, 0, 0, "}", 1);
+	if (rc != EINVAL || libccheck_diag_first(doc) != NULL) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Undo */
+	rc = test_libccheck_edit_check(doc, 0, 1, "", 100);
+	if (rc != EOK)
+		goto error;
+
+	libccheck_doc_destroy(doc);
+	return EOK;
+error:
+	libccheck_doc_destroy(doc);
+	return rc;
+}
+
+/** Test getting fixes.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_libccheck_fixes(void)
+{
+	libccheck_doc_t *doc;
+	libccheck_fix_t *fixes = NULL;
+	size_t nfixes = 0;
+	int rc;
+
+	rc = test_libccheck_doc(test_libccheck_src, &doc);
+	if (rc != EOK)
+		return rc;
+
+	rc = libccheck_doc_fixes(doc, &fixes, &nfixes);
+	if (rc != EOK)
+		goto error;
+
+	if (nfixes != 2 || fixes[0].line != 8 || fixes[0].nlines != 1 ||
+	    strcmp(fixes[0].text, "\treturn 2;\n") != 0 ||
+	    fixes[1].line != 14 || fixes[1].nlines != 1 ||
+	    strcmp(fixes[1].text, "\treturn 3;\n") != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	libccheck_fixes_destroy(fixes, nfixes);
+	libccheck_doc_destroy(doc);
+	return EOK;
+error:
+	libccheck_fixes_destroy(fixes, nfixes);
+	libccheck_doc_destroy(doc);
+	return rc;
+}
+
+/** Run C style checker library tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_libccheck(void)
+{
+	int rc;
+
+	rc = test_libccheck_check();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_libccheck_edit();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_libccheck_fixes();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -27,11 +27,14 @@
 #include <ast.h>
 #include <merrno.h>
 #include <parser.h>
+#include <stdio.h>
 #include <test/parser.h>
 
 static void parser_test_read_tok(void *, void *, unsigned, bool, lexer_tok_t *);
 static void *parser_test_next_tok(void *, void *);
 static void *parser_test_tok_data(void *, void *);
+static void parser_test_nest_read_tok(void *, void *, unsigned, bool,
+    lexer_tok_t *);
 
 static parser_input_ops_t parser_test_input = {
 	.read_tok = parser_test_read_tok,
@@ -39,6 +42,27 @@ static parser_input_ops_t parser_test_input = {
 	.tok_data = parser_test_tok_data
 };
 
+static parser_input_ops_t parser_test_nest_input = {
+	.read_tok = parser_test_nest_read_tok,
+	.next_tok = parser_test_next_tok,
+	.tok_data = parser_test_tok_data
+};
+
+enum {
+	/** Maximum nesting depth for the nesting benchmark */
+	parser_test_nest_max = 64,
+	/** Maximum number of tokens for the nesting benchmark */
+	parser_test_nest_toks = 5 * parser_test_nest_max + 16
+};
+
+/** Give up after reading this many tokens in the nesting benchmark */
+#define PARSER_TEST_NEST_BUDGET 1000000UL
+
+/** Tokens for the nesting benchmark */
+static lexer_toktype_t nest_toks[parser_test_nest_toks];
+/** Number of tokens read by the parser in the nesting benchmark */
+static unsigned long nest_reads;
+
 lexer_toktype_t toks[] = {
 	ltt_int,
 	ltt_space,
@@ -57,6 +81,106 @@ lexer_toktype_t toks[] = {
 	ltt_eof
 };
 
+/** Parse pathologically nested expression.
+ *
+ * Parse a function returning (a[(a[(a[ ... 1 ])])]) nested to @a depth
+ * levels. Each parenthesized expression could also start a cast or
+ * a compound literal (with @c a being a type), which is only ruled out
+ * after parsing everything that follows. Without memoization the parser
+ * would try three alternatives at each level, taking exponential time.
+ *
+ * @param depth Nesting depth
+ * @param rreads Place to store number of tokens read by the parser
+ * @return EOK on success or non-zero error code
+ */
+static int test_parser_nest(int depth, unsigned long *rreads)
+{
+	parser_t *parser;
+	ast_module_t *module;
+	size_t i;
+	int d;
+	int rc;
+
+	i = 0;
+	nest_toks[i++] = ltt_int;
+	nest_toks[i++] = ltt_ident;
+	nest_toks[i++] = ltt_lparen;
+	nest_toks[i++] = ltt_void;
+	nest_toks[i++] = ltt_rparen;
+	nest_toks[i++] = ltt_lbrace;
+	nest_toks[i++] = ltt_return;
+
+	for (d = 0; d < depth; d++) {
+		nest_toks[i++] = ltt_lparen;
+		nest_toks[i++] = ltt_ident;
+		nest_toks[i++] = ltt_lbracket;
+	}
+
+	nest_toks[i++] = ltt_number;
+
+	for (d = 0; d < depth; d++) {
+		nest_toks[i++] = ltt_rbracket;
+		nest_toks[i++] = ltt_rparen;
+	}
+
+	nest_toks[i++] = ltt_scolon;
+	nest_toks[i++] = ltt_rbrace;
+	nest_toks[i++] = ltt_eof;
+
+	nest_reads = 0;
+
+	rc = parser_create(&parser_test_nest_input, NULL, (void *)0, 0, false,
+	    &parser);
+	if (rc != EOK)
+		return rc;
+
+	parser->silent = true;
+
+	rc = parser_process_module(parser, &module);
+	parser_destroy(parser);
+	if (rc != EOK)
+		return rc;
+
+	ast_tree_destroy(&module->node);
+	*rreads = nest_reads;
+	return EOK;
+}
+
+/** Benchmark parsing deeply nested expressions.
+ *
+ * Make sure the amount of work grows polynomially with nesting depth.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_parser_nest_bench(void)
+{
+	unsigned long reads;
+	unsigned long prev_reads;
+	int depth;
+	int rc;
+	int rv;
+
+	prev_reads = 0;
+	for (depth = 8; depth <= parser_test_nest_max; depth *= 2) {
+		rc = test_parser_nest(depth, &reads);
+		if (rc != EOK)
+			return rc;
+
+		rv = printf("Nesting depth %d: %lu tokens read\n", depth,
+		    reads);
+		if (rv < 0)
+			return EIO;
+
+		/* Doubling the depth must not more than octuple the work */
+		if (prev_reads != 0 && reads > 8 * prev_reads)
+			return EINVAL;
+
+		prev_reads = reads;
+	}
+
+	return EOK;
+}
+
 /** Run parser tests.
  *
  * @return EOK on success or non-zero error code
@@ -88,6 +212,10 @@ int test_parser(void)
 	ast_tree_destroy(&module->node);
 	parser_destroy(parser);
 
+	rc = test_parser_nest_bench();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
 
@@ -120,3 +248,27 @@ static void *parser_test_tok_data(void *apinput, void *tok)
 	(void) apinput;
 	return tok;
 }
+
+/** Parser input for the nesting benchmark.
+ *
+ * After the token budget is exhausted, only end of file is returned,
+ * so that the test fails quickly instead of taking forever.
+ */
+static void parser_test_nest_read_tok(void *apinput, void *atok,
+    unsigned indlvl, bool seccont, lexer_tok_t *tok)
+{
+	size_t idx = (size_t)atok;
+	(void) apinput;
+	(void) indlvl;
+	(void) seccont;
+
+	++nest_reads;
+	if (nest_reads > PARSER_TEST_NEST_BUDGET ||
+	    idx >= parser_test_nest_toks)
+		tok->ttype = ltt_eof;
+	else
+		tok->ttype = nest_toks[idx];
+	tok->text = tok->ttype == ltt_ident ? "a" : "1";
+	tok->bpos.col = idx;
+	tok->epos.col = idx;
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Precompiled header unit tests
+ */
+
+#include <merrno.h>
+#include <pch.h>
+#include <src_pos.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/pch.h>
+
+/** String whose length exceeds remaining data */
+static uint8_t str_toolong[7] = { 5, 0, 0, 0, 'a', 'b', '\0' };
+
+/** String that is not terminated */
+static uint8_t str_noterm[7] = { 2, 0, 0, 0, 'a', 'b', 'c' };
+
+/** Test writing and reading back values.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_pch_wr_rd(void)
+{
+	pch_wr_t wr;
+	pch_rd_t rd;
+	src_pos_t pos;
+	const char *str;
+
+	memset(&wr, 0, sizeof(wr));
+	if (src_pos_set(&pos, "file.h", 12, 34) != EOK)
+		return ENOMEM;
+
+	pch_wr_u8(&wr, 0xab);
+	pch_wr_u32(&wr, 0x12345678ul);
+	pch_wr_u64(&wr, 0x123456789abcdef0ull);
+	pch_wr_str(&wr, "hello");
+	pch_wr_optstr(&wr, NULL);
+	pch_wr_optstr(&wr, "");
+	pch_wr_pos(&wr, &pos);
+	if (wr.error)
+		goto error;
+
+	memset(&rd, 0, sizeof(rd));
+	rd.data = wr.data;
+	rd.size = wr.size;
+
+	if (pch_rd_u8(&rd) != 0xab)
+		goto error;
+	if (pch_rd_u32(&rd) != 0x12345678ul)
+		goto error;
+	if (pch_rd_u64(&rd) != 0x123456789abcdef0ull)
+		goto error;
+
+	str = pch_rd_str(&rd);
+	if (strcmp(str, "hello") != 0)
+		goto error;
+
+	if (pch_rd_optstr(&rd) != NULL)
+		goto error;
+
+	str = pch_rd_optstr(&rd);
+	if (str == NULL || str[0] != '\0')
+		goto error;
+
+	if (pch_rd_pos(&rd, &pos) != EOK)
+		goto error;
+	if (strcmp(src_pos_fname(&pos), "file.h") != 0 || pos.line != 12 ||
+	    pos.col != 34)
+		goto error;
+
+	if (rd.error || rd.pos != rd.size)
+		goto error;
+
+	/* Reading past the end is an error */
+	if (pch_rd_u32(&rd) != 0 || !rd.error)
+		goto error;
+
+	free(wr.data);
+	return EOK;
+error:
+	free(wr.data);
+	return EINVAL;
+}
+
+/** Test reading invalid strings.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_pch_rd_bad_str(void)
+{
+	pch_rd_t rd;
+
+	memset(&rd, 0, sizeof(rd));
+	rd.data = str_toolong;
+	rd.size = sizeof(str_toolong);
+	if (strcmp(pch_rd_str(&rd), "") != 0 || !rd.error)
+		return EINVAL;
+
+	memset(&rd, 0, sizeof(rd));
+	rd.data = str_noterm;
+	rd.size = sizeof(str_noterm);
+	if (strcmp(pch_rd_str(&rd), "") != 0 || !rd.error)
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Test that precompiled header's source path is normalized.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_pch_hdr_path(void)
+{
+	pch_t *pch;
+	int rc;
+
+	rc = pch_create("./src//pch.h", cgf_none, &pch);
+	if (rc != EOK)
+		return rc;
+
+	if (strcmp(pch_hdr_path(pch), "src/pch.h") != 0) {
+		pch_destroy(pch);
+		return EINVAL;
+	}
+
+	pch_destroy(pch);
+	return EOK;
+}
+
+/** Run precompiled header tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_pch(void)
+{
+	int rc;
+
+	rc = test_pch_wr_rd();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_pch_rd_bad_str();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_pch_hdr_path();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -25,6 +25,7 @@
  */
 
 #include <scope.h>
+#include <stdio.h>
 #include <string.h>
 #include <merrno.h>
 #include <test/scope.h>
@@ -356,6 +357,98 @@ error:
 	return EINVAL;
 }
 
+enum {
+	/** Number of members for test_scope_lookup_many() */
+	test_scope_many = 100
+};
+
+/** Identifier tokens for test_scope_lookup_many() */
+static lexer_tok_t test_scope_toks[test_scope_many];
+/** Identifier texts for test_scope_lookup_many() */
+static char test_scope_idents[test_scope_many][8];
+
+/** Test lookup and iteration in a scope with many members.
+ *
+ * Enough members are inserted to force the hash table to grow.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_scope_lookup_many(void)
+{
+	int rc;
+	scope_t *scope = NULL;
+	scope_member_t *member;
+	lexer_tok_t tok;
+	int i;
+
+	rc = scope_create(NULL, &scope);
+	if (rc != EOK)
+		goto error;
+
+	for (i = 0; i < test_scope_many; i++) {
+		(void)snprintf(test_scope_idents[i],
+		    sizeof(test_scope_idents[i]), "v%d", i);
+		test_scope_toks[i].text = test_scope_idents[i];
+
+		rc = scope_insert_lvar(scope, &test_scope_toks[i], NULL, false,
+		    test_scope_idents[i]);
+		if (rc != EOK)
+			goto error;
+	}
+
+	/* Tag namespace is separate from ordinary identifiers */
+	tok.text = "v0";
+	rc = scope_insert_record(scope, &tok, sr_struct, NULL, NULL);
+	if (rc != EOK)
+		goto error;
+
+	rc = scope_insert_lvar(scope, &tok, NULL, false, "%v0");
+	if (rc != EEXIST)
+		goto error;
+
+	member = scope_lookup_tag_local(scope, "v0");
+	if (member == NULL || member->mtype != sm_record)
+		goto error;
+
+	member = scope_lookup_tag_local(scope, "v1");
+	if (member != NULL)
+		goto error;
+
+	for (i = 0; i < test_scope_many; i++) {
+		member = scope_lookup_local(scope, test_scope_idents[i]);
+		if (member == NULL)
+			goto error;
+		if (member->tident != &test_scope_toks[i])
+			goto error;
+	}
+
+	member = scope_lookup_local(scope, "v100");
+	if (member != NULL)
+		goto error;
+
+	/* Iteration follows insertion order */
+	member = scope_first(scope);
+	for (i = 0; i < test_scope_many; i++) {
+		if (member == NULL || member->tident != &test_scope_toks[i])
+			goto error;
+		member = scope_next(member);
+	}
+
+	if (member == NULL || member->tident != &tok)
+		goto error;
+
+	member = scope_next(member);
+	if (member != NULL)
+		goto error;
+
+	scope_destroy(scope);
+	return EOK;
+error:
+	if (scope != NULL)
+		scope_destroy(scope);
+	return EINVAL;
+}
+
 /** Run identifier scope tests.
  *
  * @return EOK on success or non-zero error code
@@ -392,5 +485,9 @@ int test_scope(void)
 	if (rc != EOK)
 		return rc;
 
+	rc = test_scope_lookup_many();
+	if (rc != EOK)
+		return rc;
+
 	return EOK;
 }
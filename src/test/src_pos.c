@@ -0,0 +1,139 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test source code position
+ */
+
+#include <merrno.h>
+#include <src_pos.h>
+#include <stdio.h>
+#include <string.h>
+#include <test/src_pos.h>
+
+/** Test interning of source file names.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_src_pos_intern(void)
+{
+	src_pos_t a;
+	src_pos_t b;
+	src_pos_t c;
+	src_pos_t d;
+	char fname[16];
+	int rc;
+
+	rc = src_pos_set(&a, "a.c", 1, 1);
+	if (rc != EOK)
+		return rc;
+
+	rc = src_pos_set(&b, "b.h", 1, 1);
+	if (rc != EOK)
+		return rc;
+
+	/* File name does not need to stay valid */
+	(void)snprintf(fname, sizeof(fname), "%s", "a.c");
+	rc = src_pos_set(&c, fname, 10, 2);
+	if (rc != EOK)
+		return rc;
+
+	fname[0] = 'x';
+
+	rc = src_pos_set(&d, "", 1, 1);
+	if (rc != EOK)
+		return rc;
+
+	if (a.file != c.file || a.file == b.file)
+		return EINVAL;
+
+	if (strcmp(src_pos_fname(&a), "a.c") != 0 ||
+	    strcmp(src_pos_fname(&b), "b.h") != 0 ||
+	    strcmp(src_pos_fname(&c), "a.c") != 0 ||
+	    strcmp(src_pos_fname(&d), "") != 0)
+		return EINVAL;
+
+	rc = src_pos_set(&d, "a.c", 10, 2);
+	if (rc != EOK)
+		return rc;
+
+	if (!src_pos_same(&c, &d) || src_pos_same(&a, &c) ||
+	    src_pos_same(&a, &b))
+		return EINVAL;
+
+	return EOK;
+}
+
+/** Test advancing and printing source position.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_src_pos_fwd(void)
+{
+	src_pos_t bpos;
+	src_pos_t epos;
+	const char *str = "ab\n\tc";
+	const char *cp;
+	int rc;
+	int rv;
+
+	rc = src_pos_set(&bpos, "file.c", 1, 1);
+	if (rc != EOK)
+		return rc;
+
+	epos = bpos;
+
+	for (cp = str; *cp != '\0'; cp++)
+		src_pos_fwd_char(&epos, *cp);
+
+	if (epos.line != 2 || epos.col != 10)
+		return EINVAL;
+
+	rc = src_pos_print_range(&bpos, &epos, stdout);
+	if (rc != EOK)
+		return rc;
+
+	rv = putchar('\n');
+	if (rv < 0)
+		return EIO;
+
+	return EOK;
+}
+
+/** Run source code position tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_src_pos(void)
+{
+	int rc;
+
+	rc = test_src_pos_intern();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_src_pos_fwd();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test string table
+ */
+
+#include <arena.h>
+#include <merrno.h>
+#include <stdio.h>
+#include <string.h>
+#include <strtab.h>
+#include <test/strtab.h>
+
+/** Test interning strings.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_strtab_intern(void)
+{
+	arena_t *arena = NULL;
+	strtab_t *strtab = NULL;
+	char *a;
+	char *b;
+	char *c;
+	char *s1;
+	char *s2;
+	char name[16];
+	unsigned i;
+	int rc;
+
+	rc = arena_create(&arena);
+	if (rc != EOK)
+		goto error;
+
+	rc = strtab_create(arena, &strtab);
+	if (rc != EOK)
+		goto error;
+
+	rc = strtab_intern(strtab, "foo", 3, &a);
+	if (rc != EOK)
+		goto error;
+
+	/* Need not be null-terminated */
+	rc = strtab_intern(strtab, "foobar", 3, &b);
+	if (rc != EOK)
+		goto error;
+
+	rc = strtab_intern(strtab, "foobar", 6, &c);
+	if (rc != EOK)
+		goto error;
+
+	if (a != b || a == c || strcmp(a, "foo") != 0 ||
+	    strcmp(c, "foobar") != 0) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	/* Enough strings to make the table grow */
+	for (i = 0; i < 1000; i++) {
+		(void)snprintf(name, sizeof(name), "id%u", i);
+		rc = strtab_intern(strtab, name, strlen(name), &s1);
+		if (rc != EOK)
+			goto error;
+	}
+
+	for (i = 0; i < 1000; i++) {
+		(void)snprintf(name, sizeof(name), "id%u", i);
+		rc = strtab_intern(strtab, name, strlen(name), &s1);
+		if (rc != EOK)
+			goto error;
+
+		rc = strtab_intern(strtab, s1, strlen(s1), &s2);
+		if (rc != EOK)
+			goto error;
+
+		if (s1 != s2 || strcmp(s1, name) != 0) {
+			rc = EINVAL;
+			goto error;
+		}
+	}
+
+	rc = strtab_intern(strtab, "foo", 3, &b);
+	if (rc != EOK)
+		goto error;
+
+	if (a != b) {
+		rc = EINVAL;
+		goto error;
+	}
+
+	strtab_destroy(strtab);
+	arena_destroy(arena);
+	return EOK;
+error:
+	strtab_destroy(strtab);
+	arena_destroy(arena);
+	return rc;
+}
+
+/** Run string table tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_strtab(void)
+{
+	int rc;
+
+	rc = test_strtab_intern();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
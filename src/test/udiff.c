@@ -0,0 +1,192 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test unified diff
+ */
+
+#include <merrno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <test/udiff.h>
+#include <udiff.h>
+
+enum {
+	/** Size of buffer for diff output */
+	test_udiff_buf_size = 512
+};
+
+/** Compare diff of two texts with expected output.
+ *
+ * @param atext Old text
+ * @param btext New text
+ * @param expected Expected diff
+ * @return EOK if the diff matches or non-zero error code
+ */
+static int test_udiff_check(const char *atext, const char *btext,
+    const char *expected)
+{
+	FILE *f;
+	char buf[test_udiff_buf_size];
+	size_t nread;
+	int rc;
+
+	f = tmpfile();
+	if (f == NULL)
+		return EIO;
+
+	rc = udiff_print("a", atext, strlen(atext), "b", btext,
+	    strlen(btext), f);
+	if (rc != EOK)
+		goto error;
+
+	if (fseek(f, 0, SEEK_SET) < 0) {
+		rc = EIO;
+		goto error;
+	}
+
+	nread = fread(buf, 1, sizeof(buf) - 1, f);
+	buf[nread] = '\0';
+
+	if (strcmp(buf, expected) != 0) {
+		(void)fprintf(stderr, "Expected:\n%sGot:\n%s", expected, buf);
+		rc = EINVAL;
+		goto error;
+	}
+
+	(void)fclose(f);
+	return EOK;
+error:
+	(void)fclose(f);
+	return rc;
+}
+
+/** Test diff of identical texts.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_udiff_same(void)
+{
+	int rc;
+
+	rc = test_udiff_check("", "", "");
+	if (rc != EOK)
+		return rc;
+
+	return test_udiff_check("a\nb\n", "a\nb\n", "");
+}
+
+/** Test diff of texts with a single changed line.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_udiff_change(void)
+{
+	return test_udiff_check("1\n2\n3\n4\n5\n6\n7\n8\n9\n",
+	    "1\n2\n3\n4\nfive\n6\n7\n8\n9\n",
+	    "--- a\n+++ b\n"
+	    "@@ -2,7 +2,7 @@\n"
+	    " 2\n 3\n 4\n-5\n+five\n 6\n 7\n 8\n");
+}
+
+/** Test that distant changes produce separate hunks.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_udiff_hunks(void)
+{
+	int rc;
+
+	/* Insertion at the beginning, deletion at the end */
+	rc = test_udiff_check("1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n",
+	    "0\n1\n2\n3\n4\n5\n6\n7\n8\n9\n",
+	    "--- a\n+++ b\n"
+	    "@@ -1,3 +1,4 @@\n"
+	    "+0\n 1\n 2\n 3\n"
+	    "@@ -7,4 +8,3 @@\n"
+	    " 7\n 8\n 9\n-10\n");
+	if (rc != EOK)
+		return rc;
+
+	/* Changes close to each other are merged into one hunk */
+	return test_udiff_check("1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n",
+	    "1\nb\n3\n4\n5\n6\n7\n8\nc\n10\n",
+	    "--- a\n+++ b\n"
+	    "@@ -1,10 +1,10 @@\n"
+	    " 1\n-2\n+b\n 3\n 4\n 5\n 6\n 7\n 8\n-9\n+c\n 10\n");
+}
+
+/** Test diff of texts not ending with a newline.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_udiff_noeol(void)
+{
+	return test_udiff_check("a\nb", "a\nb\n",
+	    "--- a\n+++ b\n"
+	    "@@ -1,2 +1,2 @@\n"
+	    " a\n-b\n\\ No newline at end of file\n+b\n");
+}
+
+/** Test diff of texts differing in many lines.
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int test_udiff_interleaved(void)
+{
+	return test_udiff_check("a\nb\nc\nd\n", "b\nx\nd\ny\n",
+	    "--- a\n+++ b\n"
+	    "@@ -1,4 +1,4 @@\n"
+	    "-a\n b\n-c\n+x\n d\n+y\n");
+}
+
+/** Run unified diff tests.
+ *
+ * @return EOK on success or non-zero error code
+ */
+int test_udiff(void)
+{
+	int rc;
+
+	rc = test_udiff_same();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_udiff_change();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_udiff_hunks();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_udiff_noeol();
+	if (rc != EOK)
+		return rc;
+
+	rc = test_udiff_interleaved();
+	if (rc != EOK)
+		return rc;
+
+	return EOK;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Hash map
+ */
+
+#ifndef TYPES_ADT_HMAP_H
+#define TYPES_ADT_HMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum {
+	/** Number of slots allocated on first insertion (power of two) */
+	hmap_init_slots = 8
+};
+
+/** Hash map key type */
+typedef enum {
+	/** String key */
+	hmk_str,
+	/** Integer key */
+	hmk_int
+} hmap_key_type_t;
+
+/** Hash map slot */
+typedef struct {
+	/** String key (for hmk_str) */
+	const char *skey;
+	/** Integer key (for hmk_int) */
+	int64_t ikey;
+	/** Hash of the key */
+	unsigned long hash;
+	/** Value or @c NULL if the slot is empty */
+	void *value;
+} hmap_slot_t;
+
+/** Hash map.
+ *
+ * Open-addressing hash map with linear probing. The map does not own
+ * string keys or values, it only stores the pointers.
+ */
+typedef struct {
+	/** Key type */
+	hmap_key_type_t ktype;
+	/** Slots or @c NULL if none have been allocated yet */
+	hmap_slot_t *slots;
+	/** Number of slots (zero or power of two) */
+	size_t nslots;
+	/** Number of entries */
+	size_t nentries;
+} hmap_t;
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Memory arena
+ */
+
+#ifndef TYPES_ARENA_H
+#define TYPES_ARENA_H
+
+#include <stddef.h>
+
+/** Memory arena chunk */
+typedef struct arena_chunk {
+	/** Next (older) chunk */
+	struct arena_chunk *next;
+	/** Size of data area in bytes */
+	size_t size;
+	/** Number of used bytes in data area */
+	size_t used;
+	/** Pointer to data area */
+	char *data;
+} arena_chunk_t;
+
+/** Memory arena.
+ *
+ * Blocks are allocated from large chunks and are only freed all at once
+ * when the arena is destroyed.
+ */
+typedef struct {
+	/** Current (newest) chunk or @c NULL */
+	arena_chunk_t *chunk;
+	/** Data size of the next chunk to allocate */
+	size_t next_size;
+} arena_t;
+
+/** Arena mark (allocation state that can be returned to) */
+typedef struct {
+	/** Current chunk at the time of marking or @c NULL */
+	arena_chunk_t *chunk;
+	/** Number of used bytes in the chunk at the time of marking */
+	size_t used;
+} arena_mark_t;
+
+#endif
@@ -28,6 +28,7 @@
 #define TYPES_AST_H
 
 #include <adt/list.h>
+#include <types/arena.h>
 
 typedef struct ast_block ast_block_t;
 
@@ -315,6 +316,8 @@ typedef struct ast_node {
 	link_t llist;
 	/** Node type */
 	ast_node_type_t ntype;
+	/** Arena the node is allocated from or @c NULL */
+	arena_t *arena;
 } ast_node_t;
 
 /** Qualifier type */
@@ -572,6 +575,8 @@ typedef struct {
 	ast_tok_t trparen;
 	/** Separating ',' token (except for the last element) */
 	ast_tok_t tcomma;
+	/** Arena the attribute is allocated from or @c NULL */
+	arena_t *arena;
 } ast_aspec_attr_t;
 
 /** Attribute parameter */
@@ -1209,6 +1214,8 @@ typedef struct {
 	bool have_comma;
 	/** Comma (optional for the last element) */
 	ast_tok_t tcomma;
+	/** Arena the element is allocated from or @c NULL */
+	arena_t *arena;
 } ast_cinit_elem_t;
 
 /** Compound initializer accessor */
@@ -1759,6 +1766,8 @@ typedef struct {
 	ast_node_t node;
 	/** Declarations */
 	list_t decls; /* of ast_node_t */
+	/** Arena owning all nodes of the module or @c NULL */
+	arena_t *arena;
 } ast_module_t;
 
 #endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Compilation cache
+ */
+
+#ifndef TYPES_CACHE_H
+#define TYPES_CACHE_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+enum {
+	/** Number of characters in cache entry name */
+	cache_name_len = 16
+};
+
+/** Function writing cached data to a stream.
+ *
+ * Returns EOK on success or an error code.
+ */
+typedef int (*cache_write_fn_t)(void *, FILE *);
+
+/** Compilation cache */
+typedef struct {
+	/** Cache directory */
+	char *dir;
+} cache_t;
+
+/** Compilation cache key */
+typedef struct {
+	/** Key data */
+	char *data;
+	/** Size of key data in bytes */
+	size_t size;
+	/** Allocated size of key data buffer */
+	size_t alloc;
+} cache_key_t;
+
+#endif
@@ -29,8 +29,11 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <types/ast.h>
 #include <types/cgtype.h>
+#include <types/diag.h>
+#include <types/lexer.h>
 
 /** Type used internally by code generator to represent sizes of C types. */
 typedef unsigned cgsize_t;
@@ -87,6 +90,14 @@ typedef struct {
 	ast_module_t *astmod;
 	/** Flags */
 	cgen_flags_t flags;
+	/** Diagnostics sink or @c NULL to print to standard error */
+	diag_t *diag;
+	/** File for rendering diagnostic messages */
+	FILE *msgf;
+	/** Token the diagnostic message being rendered refers to */
+	lexer_tok_t *msgtok;
+	/** Severity of the diagnostic message being rendered */
+	diag_sev_t msgsev;
 } cgen_t;
 
 /** Code generator for expression */
@@ -218,18 +229,29 @@ typedef enum {
 	cgen_ref
 } cgen_valtype_t;
 
+/** Code generator variable reference.
+ *
+ * Refers either to a named IR variable or to a numbered temporary.
+ */
+typedef struct {
+	/** Variable name or @c NULL if numbered temporary */
+	const char *varname;
+	/** Temporary number (only if @c varname is @c NULL) */
+	unsigned tempno;
+} cgen_vref_t;
+
 /** Code generator expression result.
  *
  * Describes where and how the result of an expression was stored during code
  * generation for that expression.
  */
 typedef struct {
-	/** Name of variable containing the result */
-	const char *varname;
+	/** Variable containing the result */
+	cgen_vref_t vref;
 
 	/** Value type.
 	 *
-	 * For rvalue, the variable @c varname contains the actual value,
+	 * For rvalue, the variable @c vref contains the actual value,
 	 * for lvalue it contains the address of a memory location.
 	 */
 	cgen_valtype_t valtype;
@@ -28,6 +28,7 @@
 #define TYPES_CGENUM_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -57,6 +58,10 @@ typedef struct cgen_enum {
 	int64_t next_value;
 	/** Enum elements (of cgen_enum_elem_t) */
 	list_t elems;
+	/** Enum elements indexed by identifier */
+	hmap_t elem_byname; /* of cgen_enum_elem_t */
+	/** First enum element with each value, indexed by value */
+	hmap_t elem_byval; /* of cgen_enum_elem_t */
 	/** @c true iff enum is defined */
 	bool defined;
 	/** @c true iff enum has a tag, typedef or instance */
@@ -67,6 +72,8 @@ typedef struct cgen_enum {
 typedef struct cgen_enums {
 	/** Enum definitions (of cgen_enum_t) */
 	list_t enums;
+	/** Named enum definitions indexed by C identifier */
+	hmap_t byname; /* of cgen_enum_t */
 } cgen_enums_t;
 
 #endif
@@ -28,6 +28,7 @@
 #define TYPES_CGREC_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 #include <stdbool.h>
 
 /** Record type */
@@ -104,6 +105,8 @@ typedef struct cgen_record {
 typedef struct cgen_records {
 	/** Record definitions (of cgen_record_t) */
 	list_t records;
+	/** Named record definitions indexed by C identifier */
+	hmap_t byname; /* of cgen_record_t */
 } cgen_records_t;
 
 #endif
@@ -29,11 +29,14 @@
 
 #include <adt/list.h>
 #include <stdbool.h>
+#include <types/arena.h>
 #include <types/ast.h>
+#include <types/diag.h>
 #include <types/lexer.h>
+#include <types/strtab.h>
 
 /** Checker token */
-typedef struct {
+typedef struct checker_tok {
 	/** Containing checker module */
 	struct checker_module *mod;
 	/** Link in list of tokens */
@@ -52,6 +55,17 @@ typedef struct {
 	bool seccont;
 	/** Secondary continuation flag assigned by checker */
 	bool pseccont;
+	/*
+	 * Line metadata, valid only while the module's @c lvalid is true
+	 */
+	/** First token on the same line */
+	struct checker_tok *lhead;
+	/** Preceding newline token or @c NULL */
+	struct checker_tok *lprevnl;
+	/** No non-whitespace token precedes this token on the same line */
+	bool lfirst;
+	/** Line contains a non-whitespace token (only valid in @c lhead) */
+	bool lnonws;
 } checker_tok_t;
 
 /** Checker module type */
@@ -68,8 +82,20 @@ typedef struct checker_module {
 	struct checker *checker;
 	/** Tokens */
 	list_t toks; /* of checker_tok_t */
+	/** Arena holding tokens and their text */
+	arena_t *arena;
+	/** Table of interned identifier and keyword texts */
+	strtab_t *strtab;
 	/** Module AST */
 	ast_module_t *ast;
+	/** Line metadata of tokens is valid (no tokens added or removed) */
+	bool lvalid;
+	/** First token of the line being lexed */
+	struct checker_tok *lhead;
+	/** Last newline token lexed */
+	struct checker_tok *lastnl;
+	/** Number of steps made traversing the token list */
+	unsigned long nsteps;
 } checker_module_t;
 
 /** Checker configuration */
@@ -116,6 +142,20 @@ typedef struct checker {
 	checker_mtype_t mtype;
 	/** Checker configuration */
 	checker_cfg_t *cfg;
+	/** Number of reported issues */
+	unsigned long nissues;
+	/** Number of edits made to the source code when fixing issues */
+	unsigned long nedits;
+	/** Diagnostics sink to which issues are reported */
+	diag_t *diag;
+	/** Default diagnostics sink (text to standard output) */
+	diag_t *tdiag;
+	/** Source code starts at the beginning of the file */
+	bool atbof;
+	/** Source code ends at the end of the file */
+	bool ateof;
+	/** Do not print parser error messages */
+	bool silent;
 } checker_t;
 
 /** Checker parser input */
@@ -132,7 +172,9 @@ typedef enum {
 	/** Dump internal AST */
 	cf_dump_ast = 0x2,
 	/** Dump tokenized source file */
-	cf_dump_toks = 0x4
+	cf_dump_toks = 0x4,
+	/** Print fixes as a unified diff instead of applying them */
+	cf_diff = 0x8
 } checker_flags_t;
 
 /** Allow or disallow null statement */
@@ -29,14 +29,21 @@
 
 #include <adt/list.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <types/arena.h>
 #include <types/ast.h>
+#include <types/cache.h>
 #include <types/cgen.h>
+#include <types/diag.h>
 #include <types/ir.h>
 #include <types/irlexer.h>
 #include <types/lexer.h>
 #include <types/object/linker.h>
+#include <types/object/lscript.h>
 #include <types/object/object.h>
+#include <types/pch.h>
 #include <types/preproc.h>
+#include <types/strtab.h>
 #include <types/symbols.h>
 #include <types/tape/tape.h>
 #include <types/z80/iclexer.h>
@@ -60,6 +67,8 @@ typedef enum {
 	cmt_chdr,
 	/** IR file */
 	cmt_ir,
+	/** Binary IR file */
+	cmt_irb,
 	/** IC (.s) file */
 	cmt_ic,
 	/** OBJ file */
@@ -86,6 +95,10 @@ typedef struct comp_module {
 	z80ic_lexer_t *ic_lexer;
 	/** Tokens */
 	list_t toks; /* of comp_tok_t */
+	/** Arena holding tokens and their text */
+	arena_t *arena;
+	/** Table of interned identifier and keyword texts */
+	strtab_t *strtab;
 	/** Module was lexed. */
 	bool lexed;
 	/** Module AST */
@@ -100,22 +113,54 @@ typedef struct comp_module {
 	z80ic_module_t *ic;
 	/** Module binary object */
 	obj_object_t *object;
+	/** @c true iff module should be placed in a memory bank */
+	bool banked;
+	/** Memory bank number (if @c banked is @c true) */
+	unsigned bank;
+	/** Number of warnings produced by code generator */
+	int warnings;
+	/** Compilation cache key (if object should be cached) or @c NULL */
+	cache_key_t *cache_key;
 } comp_module_t;
 
+/** Compiler include directory */
+typedef struct {
+	/** Link to @c comp->incldirs */
+	link_t lincldirs;
+	/** Directory path name */
+	char *dir;
+} comp_incldir_t;
+
 /** Compiler */
 typedef struct comp {
 	/** Base directory from which compiler files are located. */
 	char *base_dir;
 	/** Modules (comp_module_t) */
 	list_t mods;
+	/** Additional include directories (comp_incldir_t) */
+	list_t incldirs;
 	/** Code generator flags */
 	cgen_flags_t cgflags;
 	/** Linker flags */
 	obj_linker_flags_t lflags;
+	/** Linker script or @c NULL */
+	obj_lscript_t *lscript;
+	/** Compilation cache or @c NULL */
+	cache_t *cache;
+	/** Diagnostics sink or @c NULL to print to standard error */
+	diag_t *diag;
+	/** @c true iff compiler identity is known */
+	bool have_ident;
+	/** Compiler identity (hash of compiler executable) */
+	uint32_t ident;
+	/** Preloaded standard library object or @c NULL */
+	obj_object_t *stdlib;
 	/** Linked object */
 	obj_object_t *linked_object;
 	/** Tape image */
 	tape_t *tape;
+	/** Precompiled header or @c NULL */
+	pch_t *pch;
 } comp_t;
 
 /** Compiler parser input */
@@ -160,7 +205,11 @@ typedef enum {
 	/** Do not make a tape image */
 	compf_no_tape = 0x100,
 	/** Do not implicitly link with standard libraries */
-	compf_no_stdlib = 0x200
+	compf_no_stdlib = 0x200,
+	/** Generate precompiled header */
+	compf_pch_gen = 0x400,
+	/** Generate binary IR */
+	compf_irb_gen = 0x800
 } comp_flags_t;
 
 #endif
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Diagnostics sink
+ */
+
+#ifndef TYPES_DIAG_H
+#define TYPES_DIAG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <types/lexer.h>
+#include <types/src_pos.h>
+
+/** Diagnostic output format */
+typedef enum {
+	/** Human-readable text */
+	dfmt_text,
+	/** JSON Lines (one JSON object per diagnostic) */
+	dfmt_jsonl,
+	/** SARIF 2.1.0 log */
+	dfmt_sarif,
+	/** Pass diagnostics to a callback function */
+	dfmt_cb
+} diag_fmt_t;
+
+/** Diagnostic severity */
+typedef enum {
+	dsev_warning,
+	dsev_error
+} diag_sev_t;
+
+/** Fix-it edit.
+ *
+ * Replaces a range of whole lines of the source file with new text.
+ * With @c nlines equal to zero the text is inserted before @c line.
+ */
+typedef struct {
+	/** First line to replace (starting from 1) */
+	unsigned long line;
+	/** Number of lines to replace */
+	unsigned long nlines;
+	/** Replacement text (not NUL-terminated) */
+	const char *text;
+	/** Size of replacement text in bytes */
+	size_t size;
+} diag_fix_t;
+
+/** Diagnostic */
+typedef struct {
+	/** Severity */
+	diag_sev_t sev;
+	/** Check identifier */
+	const char *check;
+	/** Token where the issue is */
+	lexer_tok_t *tok;
+	/** Beginning of the source range */
+	src_pos_t bpos;
+	/** End of the source range (inclusive) */
+	src_pos_t epos;
+	/** @c true if the issue can be fixed automatically */
+	bool fixable;
+	/** Fix-it edits or @c NULL if not known */
+	diag_fix_t *fixes;
+	/** Number of fix-it edits */
+	size_t nfixes;
+	/** Message */
+	const char *msg;
+} diag_entry_t;
+
+/** Diagnostic callback function.
+ *
+ * @param arg Callback argument
+ * @param entry Diagnostic (valid only for the duration of the call)
+ * @return EOK on success or an error code
+ */
+typedef int (*diag_report_cb_t)(void *, diag_entry_t *);
+
+/** Diagnostics sink */
+typedef struct {
+	/** Output format */
+	diag_fmt_t fmt;
+	/** Prefix warnings with 'Warning: ' in text format */
+	bool sev_prefix;
+	/** Tool name */
+	char *tool;
+	/** Output stream */
+	FILE *f;
+	/** Callback function (with @c dfmt_cb) */
+	diag_report_cb_t cb;
+	/** Callback argument */
+	void *cb_arg;
+	/** Number of reported diagnostics */
+	unsigned long nentries;
+	/** @c true if the SARIF log header has been written */
+	bool started;
+} diag_t;
+
+#endif
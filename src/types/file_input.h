@@ -36,6 +36,8 @@ typedef struct {
 	FILE *f;
 	/** Current source position */
 	src_pos_t cpos;
+	/** Whole file contents (if read using the whole op) or @c NULL */
+	char *data;
 } file_input_t;
 
 #endif
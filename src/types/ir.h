@@ -32,7 +32,9 @@
 
 enum {
 	/** Maximum acceptable value for width */
-	ir_max_width = 64
+	ir_max_width = 64,
+	/** Size of buffer for name of numbered temporary (%N) */
+	ir_temp_name_size = 12
 };
 
 /** IR instruction type */
@@ -177,12 +179,18 @@ typedef struct ir_oper_list {
 	list_t list;
 } ir_oper_list_t;
 
-/** IR variable reference operand */
+/** IR variable reference operand.
+ *
+ * Numbered temporaries (which are named %0, %1, ... in textual IR,
+ * including procedure arguments) are identified only by their number.
+ */
 typedef struct {
 	/** Base object */
 	ir_oper_t oper;
-	/** Variable name */
+	/** Variable name or @c NULL if variable is a numbered temporary */
 	char *varname;
+	/** Temporary number (only if @c varname is @c NULL) */
+	unsigned tempno;
 } ir_oper_var_t;
 
 /** IR instruction */
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Binary IR format
+ */
+
+#ifndef TYPES_IRBIN_H
+#define TYPES_IRBIN_H
+
+#include <adt/list.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <types/adt/hmap.h>
+
+enum {
+	/** Binary IR file signature 'SyIR' */
+	irbin_file_sign = 0x52497953ul,
+	irbin_file_major = 1,
+	irbin_file_minor = 0
+};
+
+/** Binary IR data writer */
+typedef struct {
+	/** Data buffer */
+	uint8_t *data;
+	/** Number of used bytes in @c data */
+	size_t size;
+	/** Allocated size of @c data */
+	size_t alloc;
+	/** @c true iff we ran out of memory */
+	bool error;
+} irbin_wr_t;
+
+/** Binary IR data reader */
+typedef struct {
+	/** Data */
+	const uint8_t *data;
+	/** Size of data in bytes */
+	size_t size;
+	/** Read position */
+	size_t pos;
+	/** @c true iff data was truncated or malformed */
+	bool error;
+} irbin_rd_t;
+
+/** String table entry used while saving binary IR */
+typedef struct {
+	/** Link to @c irbin_save_t.strs */
+	link_t lstrs;
+	/** String (owned by the IR module being saved) */
+	const char *str;
+	/** Index in string table */
+	uint32_t idx;
+} irbin_str_t;
+
+/** Saving IR module in binary format */
+typedef struct {
+	/** Writer for module contents (without string table) */
+	irbin_wr_t wr;
+	/** String table entries in index order (of irbin_str_t) */
+	list_t strs;
+	/** String table entries indexed by string */
+	hmap_t bystr;
+	/** Number of strings in string table */
+	uint32_t nstrs;
+} irbin_save_t;
+
+/** Loading IR module from binary format */
+typedef struct {
+	/** Reader */
+	irbin_rd_t rd;
+	/** String table (strings point into the data being read) */
+	const char **strs;
+	/** Number of strings in string table */
+	size_t nstrs;
+	/** Current nesting depth of type expressions and operands */
+	unsigned depth;
+} irbin_load_t;
+
+#endif
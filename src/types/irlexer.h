@@ -120,6 +120,14 @@ typedef enum {
 	itt_error
 } ir_lexer_toktype_t;
 
+/** Keyword table entry */
+typedef struct {
+	/** Keyword (must be the first member) */
+	const char *kw;
+	/** Token type */
+	ir_lexer_toktype_t ttype;
+} ir_lexer_kw_t;
+
 #define itt_resword_first itt_add
 #define itt_resword_last itt_write
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Parallel jobs
+ */
+
+#ifndef TYPES_JOBS_H
+#define TYPES_JOBS_H
+
+#include <adt/list.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/** Job function.
+ *
+ * Called with job argument and a file that can be used to pass
+ * binary data from the job back to the caller. Returns EOK on
+ * success or an error code.
+ */
+typedef int (*job_fn_t)(void *, FILE *);
+
+/** Job */
+typedef struct {
+	/** Containing job set */
+	struct jobs *jobs;
+	/** Link to @c jobs->jobs */
+	link_t ljobs;
+	/** Job function */
+	job_fn_t fn;
+	/** Argument to job function */
+	void *arg;
+	/** Captured standard output */
+	FILE *outf;
+	/** Captured standard error output */
+	FILE *errf;
+	/** Data passed from the job to the caller */
+	FILE *dataf;
+	/** ID of process executing the job */
+	int pid;
+	/** @c true iff job has been started */
+	bool started;
+	/** @c true iff job has finished */
+	bool done;
+	/** Return code of job function */
+	int rc;
+} job_t;
+
+/** Set of jobs */
+typedef struct jobs {
+	/** Jobs (job_t) */
+	list_t jobs;
+	/** Maximum number of jobs running simultaneously */
+	unsigned maxjobs;
+	/** Number of jobs currently running */
+	unsigned running;
+	/** Capture standard error output together with standard output */
+	bool merge_out;
+} jobs_t;
+
+#endif
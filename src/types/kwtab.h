@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Keyword table
+ */
+
+#ifndef TYPES_KWTAB_H
+#define TYPES_KWTAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+enum {
+	/** Maximum number of hash slots (and entries) */
+	kwtab_max_slots = 256,
+	/** Maximum number of first-level hash buckets */
+	kwtab_max_buckets = 128
+};
+
+/** Keyword table.
+ *
+ * The entries are a constant array of structures whose first member
+ * is the keyword (const char *). The perfect hash (a displacement for
+ * each first-level bucket) is computed on first use.
+ */
+typedef struct {
+	/** Entries */
+	const void *entries;
+	/** Number of entries */
+	size_t nentries;
+	/** Size of one entry in bytes */
+	size_t esize;
+	/** @c true iff the hash has been computed */
+	bool ready;
+	/** @c true iff a perfect hash was found (otherwise linear search) */
+	bool perfect;
+	/** Length of the longest keyword */
+	size_t maxlen;
+	/** Number of slots (power of two) */
+	size_t nslots;
+	/** Number of first-level buckets (power of two) */
+	size_t nbuckets;
+	/** Displacement (hash seed) for each bucket */
+	unsigned short disp[kwtab_max_buckets];
+	/** Entry index plus one for each slot, zero if slot is empty */
+	unsigned short slot[kwtab_max_slots];
+} kwtab_t;
+
+#endif
@@ -28,12 +28,15 @@
 #define TYPES_LABELS_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 #include <types/lexer.h>
 
 /** Labels */
 typedef struct labels {
 	/** List of labels */
 	list_t labels; /* of label_t */
+	/** Labels indexed by identifier */
+	hmap_t byname; /* of label_t */
 } labels_t;
 
 /** Label */
@@ -29,12 +29,16 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <types/arena.h>
 #include <types/linput.h>
 #include <types/src_pos.h>
+#include <types/strtab.h>
 
 enum {
 	lexer_buf_size = 32,
-	lexer_buf_low_watermark = 16
+	lexer_buf_low_watermark = 16,
+	/** Size of buffer for a character formatted by lexer_sprint_char() */
+	lexer_dchar_size = 12
 };
 
 /** Token type */
@@ -159,6 +163,14 @@ typedef enum {
 	ltt_error
 } lexer_toktype_t;
 
+/** Keyword table entry */
+typedef struct {
+	/** Keyword (must be the first member) */
+	const char *kw;
+	/** Token type */
+	lexer_toktype_t ttype;
+} lexer_kw_t;
+
 #define ltt_resword_first ltt_attribute
 #define ltt_resword_last ltt_while
 
@@ -199,6 +211,18 @@ typedef struct {
 	src_pos_t buf_bpos;
 	/** Current position */
 	src_pos_t pos;
+	/** @c true iff we tried to get the whole input as one buffer */
+	bool whole_checked;
+	/** @c true iff reading from the whole input buffer */
+	bool whole;
+	/** Whole input buffer (owned by the input) */
+	const char *wbuf;
+	/** Number of characters in whole input buffer */
+	size_t wsize;
+	/** Read position in whole input buffer */
+	size_t wpos;
+	/** Source position of character at @c wpos */
+	src_pos_t wcpos;
 	/** EOF hit in input */
 	bool in_eof;
 	/** Error hit in input */
@@ -209,6 +233,20 @@ typedef struct {
 	void *input_arg;
 	/** State */
 	lexer_state_t state;
+	/** Arena for token text or @c NULL to allocate it from the heap */
+	arena_t *arena;
+	/** String table for identifier and keyword text or @c NULL */
+	strtab_t *strtab;
+	/** @c true iff the token being lexed has text */
+	bool ttext;
+	/** Start of token text in whole input buffer */
+	const char *wtext;
+	/** Token text buffer (unless reading from whole input buffer) */
+	char *tbuf;
+	/** Allocated size of @c tbuf */
+	size_t tbuf_size;
+	/** Size of text of the token being lexed */
+	size_t tsize;
 } lexer_t;
 
 #endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * C style checker library
+ */
+
+#ifndef TYPES_LIBCCHECK_H
+#define TYPES_LIBCCHECK_H
+
+#include <adt/list.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <types/checker.h>
+#include <types/diag.h>
+#include <types/src_pos.h>
+
+/** Diagnostic */
+typedef struct {
+	/** Containing document */
+	struct libccheck_doc *doc;
+	/** Link to list of diagnostics */
+	link_t ldiags;
+	/** Severity */
+	diag_sev_t sev;
+	/** Check identifier */
+	char *check;
+	/** Message */
+	char *msg;
+	/** @c true if the issue can be fixed automatically */
+	bool fixable;
+	/** Beginning of the source range */
+	src_pos_t bpos;
+	/** End of the source range (inclusive) */
+	src_pos_t epos;
+} libccheck_diag_t;
+
+/** Fix (replacement of a range of lines) */
+typedef struct {
+	/** First line to replace (starting from 1) */
+	uint32_t line;
+	/** Number of lines to replace (zero to insert before @c line) */
+	uint32_t nlines;
+	/** Replacement text */
+	char *text;
+	/** Size of replacement text in bytes */
+	size_t size;
+} libccheck_fix_t;
+
+/** Checked document.
+ *
+ * The document is divided into chunks of whole lines, each containing
+ * one top-level declaration (preceded by any empty lines, comments or
+ * preprocessor directives since the previous declaration). The last
+ * chunk extends to the end of the document.
+ */
+typedef struct libccheck_doc {
+	/** Module type */
+	checker_mtype_t mtype;
+	/** Checker configuration */
+	checker_cfg_t cfg;
+	/** Text (null-terminated) */
+	char *text;
+	/** Size of text in bytes */
+	size_t size;
+	/** Last line of each chunk */
+	uint32_t *cend;
+	/** Number of chunks */
+	size_t nchunks;
+	/** Diagnostics in order of position */
+	list_t diags; /* of libccheck_diag_t */
+	/** Chunks and diagnostics are valid (text was parsed) */
+	bool valid;
+	/** Number of lines checked by the last update */
+	uint32_t nclines;
+} libccheck_doc_t;
+
+#endif
@@ -32,7 +32,10 @@
 
 /** Lexer input ops */
 typedef struct {
+	/** Read characters into buffer */
 	int (*read)(void *, char *, size_t, size_t *, src_pos_t *);
+	/** Get all remaining input in one null-terminated buffer or @c NULL */
+	int (*whole)(void *, const char **, size_t *, src_pos_t *);
 } lexer_input_ops_t;
 
 #endif
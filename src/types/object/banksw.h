@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Bank switching trampolines
+ */
+
+#ifndef TYPES_OBJECT_BANKSW_H
+#define TYPES_OBJECT_BANKSW_H
+
+#include <adt/list.h>
+#include <types/object/object.h>
+#include <types/object/section.h>
+#include <types/object/symbol.h>
+
+enum {
+	/** Maximum nesting depth of cross-bank calls */
+	obj_banksw_depth = 32,
+	/** Size of one trampoline stub in bytes */
+	obj_banksw_stub_size = 17,
+	/** 128K paging control port */
+	obj_banksw_port = 0x7ffd,
+	/** Address of BANKM system variable (last value written to port) */
+	obj_banksw_bankm = 0x5b5c
+};
+
+/** Bank switching trampoline stub */
+typedef struct {
+	/** Containing bank switching trampolines */
+	struct obj_banksw *banksw;
+	/** Link to @c banksw->stubs */
+	link_t lstubs;
+	/** Target symbol */
+	obj_symbol_t *target;
+	/** Bank containing target symbol */
+	unsigned bank;
+	/** Stub symbol */
+	obj_symbol_t *symbol;
+} obj_banksw_stub_t;
+
+/** Bank switching trampolines */
+typedef struct obj_banksw {
+	/** Object containing the trampolines */
+	obj_object_t *object;
+	/** Section containing the trampolines */
+	obj_section_t *section;
+	/** Symbol marking the switching routine */
+	obj_symbol_t *call_sym;
+	/** Stubs (obj_banksw_stub_t) */
+	list_t stubs;
+	/** Number of stubs */
+	unsigned nstubs;
+} obj_banksw_t;
+
+#endif
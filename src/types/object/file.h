@@ -31,7 +31,7 @@ enum {
 	/** Object file signature 'ObjS' */
 	obj_file_sign = 0x536a624ful,
 	obj_file_major = 1,
-	obj_file_minor = 0
+	obj_file_minor = 1
 };
 
 enum {
@@ -83,8 +83,10 @@ typedef struct {
 	uint32_t section_idx;
 	/** Symbol binding */
 	uint8_t binding;
+	/** Symbol kind (since version 1.1) */
+	uint8_t kind;
 	/* Padding */
-	uint8_t pad0[3];
+	uint8_t pad0[2];
 	/** Symbol offset within section */
 	uint32_t offset;
 	/** Symbol size */
@@ -28,7 +28,9 @@
 #define TYPES_OBJECT_LINKER_H
 
 #include <adt/list.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <types/object/lscript.h>
 #include <types/object/object.h>
 
 /** Object linker flags */
@@ -47,6 +49,10 @@ typedef struct {
 	link_t lsources;
 	/** Source object */
 	obj_object_t *object;
+	/** @c true iff source should be placed in a memory bank */
+	bool banked;
+	/** Memory bank number (if @c banked is @c true) */
+	unsigned bank;
 } obj_linker_src_t;
 
 /** Object linker */
@@ -57,6 +63,8 @@ typedef struct obj_linker {
 	list_t sources;
 	/** Address where the output object should start. */
 	uint32_t org;
+	/** Linker script or @c NULL */
+	obj_lscript_t *lscript;
 	/** Destination object */
 	obj_object_t *dest;
 } obj_linker_t;
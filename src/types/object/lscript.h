@@ -0,0 +1,97 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Linker script
+ */
+
+#ifndef TYPES_OBJECT_LSCRIPT_H
+#define TYPES_OBJECT_LSCRIPT_H
+
+#include <adt/list.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** Linker script memory region */
+typedef struct {
+	/** Containing linker script */
+	struct obj_lscript *lscript;
+	/** Link to @c lscript->regions */
+	link_t lregions;
+	/** Region name */
+	char *name;
+	/** Start address */
+	uint32_t start;
+	/** End address (inclusive) */
+	uint32_t end;
+	/** Byte used to fill alignment gaps */
+	uint8_t fill;
+} obj_lscript_region_t;
+
+/** Linker script placement rule */
+typedef struct {
+	/** Containing linker script */
+	struct obj_lscript *lscript;
+	/** Link to @c lscript->rules */
+	link_t lrules;
+	/** Section name pattern */
+	char *spattern;
+	/** Module name pattern */
+	char *mpattern;
+	/** Destination region */
+	obj_lscript_region_t *region;
+	/** Alignment of section start address (power of two) */
+	uint32_t align;
+} obj_lscript_rule_t;
+
+/** Linker script */
+typedef struct obj_lscript {
+	/** Memory regions (obj_lscript_region_t) */
+	list_t regions;
+	/** Placement rules (obj_lscript_rule_t) */
+	list_t rules;
+} obj_lscript_t;
+
+enum {
+	/** Maximum length of linker script line */
+	obj_lscript_line_max = 256,
+	/** Maximum number of words on linker script line */
+	obj_lscript_words_max = 16
+};
+
+/** Linker script parser */
+typedef struct {
+	/** Input file */
+	FILE *f;
+	/** File name (for error messages) */
+	const char *fname;
+	/** Current line number */
+	unsigned line;
+	/** Current line */
+	char buf[obj_lscript_line_max];
+	/** Words on current line */
+	char *words[obj_lscript_words_max];
+	/** Number of words on current line */
+	unsigned nwords;
+} obj_lscript_parser_t;
+
+#endif
@@ -30,6 +30,15 @@
 #include <adt/list.h>
 #include <stdint.h>
 
+enum {
+	/** Number of memory banks */
+	obj_bank_count = 8,
+	/** Start address of the paged memory window */
+	obj_bank_base = 0xc000u,
+	/** Size of memory bank */
+	obj_bank_size = 0x4000
+};
+
 /** Object section */
 typedef struct obj_section {
 	/** Containing object */
@@ -38,6 +38,15 @@ typedef enum {
 	objb_local
 } obj_symbol_binding_t;
 
+typedef enum {
+	/** Symbol kind is not known */
+	objk_unknown,
+	/** Symbol refers to code (function or label) */
+	objk_code,
+	/** Symbol refers to data (variable) */
+	objk_data
+} obj_symbol_kind_t;
+
 /** Object symbol */
 typedef struct obj_symbol {
 	/** Containing object */
@@ -50,6 +59,8 @@ typedef struct obj_symbol {
 	struct obj_section *section;
 	/** Symbol binding */
 	obj_symbol_binding_t binding;
+	/** Symbol kind */
+	obj_symbol_kind_t kind;
 	/** Symbol offset within section */
 	uint32_t offset;
 	/** Symbol size */
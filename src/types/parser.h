@@ -27,6 +27,8 @@
 #ifndef TYPES_PARSER_H
 #define TYPES_PARSER_H
 
+#include <types/adt/hmap.h>
+#include <types/arena.h>
 #include <types/lexer.h>
 
 struct parser;
@@ -69,6 +71,43 @@ typedef struct {
 	bool (*ident_is_type)(void *, const char *);
 } parser_cb_t;
 
+/** Productions that are parsed speculatively and memoized */
+typedef enum {
+	/** Cast expression */
+	pmp_ecast,
+	/** Compound literal */
+	pmp_ecliteral,
+	/** Parenthesized expression */
+	pmp_eparexpr,
+	/** Concatenation expression */
+	pmp_econcat,
+	/** Number of memoized productions */
+	pmp_limit
+} parser_memo_prod_t;
+
+/** Memoized failure to parse a production at a given token */
+typedef struct {
+	/** Error code */
+	int rc;
+} parser_memo_entry_t;
+
+/** Parser memo.
+ *
+ * Records which speculatively parsed productions failed at which
+ * tokens, so that when backtracking brings us to the same token again,
+ * the production is not parsed again just to fail once more.
+ *
+ * The memo is only kept while parsing one expression. Identifiers
+ * cannot change meaning (e.g. become type names) within an expression,
+ * so the recorded outcomes remain valid.
+ */
+typedef struct parser_memo {
+	/** Arena for entries or @c NULL if not created yet */
+	arena_t *arena;
+	/** Entries for each production indexed by token */
+	hmap_t entries[pmp_limit]; /* of parser_memo_entry_t */
+} parser_memo_t;
+
 /** Parser */
 typedef struct parser {
 	/** Input ops */
@@ -87,6 +126,10 @@ typedef struct parser {
 	unsigned indlvl;
 	/** Currently in secondary continuation? */
 	bool seccont;
+	/** Memo shared with sub-parsers or @c NULL */
+	parser_memo_t *memo;
+	/** Arena for AST nodes shared with sub-parsers or @c NULL */
+	arena_t *arena;
 } parser_t;
 
 #endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef TYPES_PCH_H
+#define TYPES_PCH_H
+
+#include <adt/list.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <types/cgen.h>
+
+enum {
+	/** Precompiled header signature 'PchS' */
+	pch_file_sign = 0x53686350ul,
+	pch_file_major = 1,
+	pch_file_minor = 0
+};
+
+/** Precompiled header data writer */
+typedef struct {
+	/** Data buffer */
+	uint8_t *data;
+	/** Number of used bytes in @c data */
+	size_t size;
+	/** Allocated size of @c data */
+	size_t alloc;
+	/** @c true iff we ran out of memory */
+	bool error;
+} pch_wr_t;
+
+/** Precompiled header data reader */
+typedef struct {
+	/** Data */
+	uint8_t *data;
+	/** Size of data in bytes */
+	size_t size;
+	/** Read position */
+	size_t pos;
+	/** @c true iff data was truncated or malformed */
+	bool error;
+} pch_rd_t;
+
+/** Precompiled header dependency (file the header was built from) */
+typedef struct {
+	/** Containing precompiled header */
+	struct pch *pch;
+	/** Link to @c pch->deps */
+	link_t ldeps;
+	/** Path name */
+	char *path;
+	/** @c true iff the file existed */
+	bool exists;
+	/** File size */
+	uint32_t size;
+	/** Hash of file contents */
+	uint32_t hash;
+	/** Modification time or zero if not known */
+	uint64_t mtime;
+} pch_dep_t;
+
+/** Precompiled header */
+typedef struct pch {
+	/** Normalized path name of the header */
+	char *hdr_path;
+	/** Code generator flags the header was compiled with */
+	cgen_flags_t cgflags;
+	/** Dependencies (of pch_dep_t) */
+	list_t deps;
+	/** Preprocessor state being written */
+	pch_wr_t ppwr;
+	/** Code generator state being written */
+	pch_wr_t cgwr;
+	/** Loaded file contents or @c NULL */
+	uint8_t *data;
+	/** Size of loaded file contents */
+	size_t size;
+	/** Hash of loaded file contents */
+	uint32_t hash;
+	/** File the header was loaded from (path is @c NULL if not loaded) */
+	pch_dep_t file;
+	/** Offset of dependency list in @c data */
+	size_t deps_off;
+	/** Offset of preprocessor state in @c data */
+	size_t pp_off;
+	/** Size of preprocessor state */
+	size_t pp_size;
+	/** Offset of code generator state in @c data */
+	size_t cg_off;
+	/** Size of code generator state */
+	size_t cg_size;
+} pch_t;
+
+/** Saving code generator state to precompiled header */
+typedef struct {
+	/** Writer */
+	pch_wr_t *wr;
+	/** Records in the order they are saved */
+	struct cgen_record **records;
+	/** Number of entries in @c records */
+	size_t nrecords;
+	/** Enums in the order they are saved */
+	struct cgen_enum **enums;
+	/** Number of entries in @c enums */
+	size_t nenums;
+	/** Symbols in the order they are saved */
+	struct symbol **syms;
+	/** Number of entries in @c syms */
+	size_t nsyms;
+} pch_cgsave_t;
+
+/** Loading code generator state from precompiled header */
+typedef struct {
+	/** Reader */
+	pch_rd_t rd;
+	/** Compiler module (owns the identifier tokens) */
+	struct comp_module *module;
+	/** Code generator */
+	cgen_t *cgen;
+	/** Loaded records */
+	struct cgen_record **records;
+	/** Number of entries in @c records */
+	size_t nrecords;
+	/** Loaded enums */
+	struct cgen_enum **enums;
+	/** Number of entries in @c enums */
+	size_t nenums;
+	/** Loaded symbols */
+	struct symbol **syms;
+	/** Number of entries in @c syms */
+	size_t nsyms;
+} pch_cgload_t;
+
+#endif
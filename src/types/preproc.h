@@ -28,29 +28,71 @@
 #define TYPES_PREPROC_H
 
 #include <adt/list.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <types/arena.h>
 #include <types/file_input.h>
 #include <types/linput.h>
+#include <types/pch.h>
 #include <types/preproc.h>
 #include <types/src_pos.h>
 
 enum {
 	preproc_buf_size = 32,
 	preproc_buf_low_watermark = 16,
-	preproc_out_buf_size = 32
+	/** Number of buckets in the macro hash table (power of two) */
+	preproc_macro_buckets = 64,
+	/** Number of buckets in the header cache (power of two) */
+	preproc_hdr_buckets = 32
 };
 
 struct preproc_input;
 
+/** Header cache entry.
+ *
+ * Remembers the result of looking up a header file and whether
+ * the header can be skipped when it is included again.
+ */
+typedef struct {
+	/** Link to @c preproc->hdrs */
+	link_t lhdrs;
+	/** Normalized path name */
+	char *path;
+	/** @c true if the file exists (could be opened) */
+	bool exists;
+	/** Header contains #pragma once */
+	bool once;
+	/** Include guard macro name or @c NULL if not known */
+	char *guard;
+} preproc_hdr_t;
+
+/** Include directory */
+typedef struct {
+	/** Link to @c preproc->incldirs */
+	link_t lincldirs;
+	/** Directory path name */
+	char *dir;
+} preproc_incldir_t;
+
+/** Multiple-include optimization state of an input file */
+typedef enum {
+	/** Nothing but whitespace and comments seen so far */
+	pmi_start,
+	/** Inside the #ifndef group that might be an include guard */
+	pmi_inside,
+	/** After the #endif matching the candidate include guard */
+	pmi_after,
+	/** File is not wrapped in an include guard */
+	pmi_none
+} preproc_mi_state_t;
+
 /** C preprocessor state */
 typedef enum {
 	/** At beginning of line (or after whitespace) */
 	pps_line_begin,
 	/** Inside a line of text */
-	pps_text_line,
-	/** Copying a pragma directive */
-	pps_copy_pragma
+	pps_text_line
 } preproc_state_t;
 
 /** C preprocessor */
@@ -66,21 +108,57 @@ typedef struct preproc {
 	/** Position of beginning of input buffer */
 	src_pos_t buf_bpos;
 	/** Output buffer */
-	char out_buf[preproc_out_buf_size];
+	char *obuf;
 	/** Output position buffer */
-	src_pos_t out_posbuf[preproc_out_buf_size];
-	/** Number of used bytes in out_buf */
-	size_t out_buf_used;
-	/** Position of beginning of output buffer */
-	src_pos_t out_buf_pos;
-	/** Position while copying '#pragma' */
-	uint8_t pragma_pos;
+	src_pos_t *oposbuf;
+	/** Allocated size of obuf and oposbuf (in characters) */
+	size_t obuf_size;
+	/** Number of used characters in obuf */
+	size_t obuf_used;
+	/** Read position in obuf */
+	size_t obuf_rpos;
+	/** Position following the last character read from obuf */
+	src_pos_t opos;
+	/** Line buffer */
+	char *lbuf;
+	/** Line position buffer */
+	src_pos_t *lposbuf;
+	/** Allocated size of lbuf and lposbuf (in characters) */
+	size_t lbuf_size;
+	/** Number of used characters in lbuf */
+	size_t lbuf_used;
+	/** Scratch buffer for composing token text */
+	char *sbuf;
+	/** Allocated size of sbuf */
+	size_t sbuf_size;
+	/** Number of used characters in sbuf */
+	size_t sbuf_used;
+	/** Arena for tokens of the line being processed or @c NULL */
+	arena_t *tarena;
+	/** Arena for macro replacement lists */
+	arena_t *marena;
 	/** Directory for standard includes. */
 	char *incldir;
+	/** Additional include directories (preproc_incldir_t) */
+	list_t incldirs;
 	/** Condition stack (list of preproc_condition_t) */
 	list_t conditions;
-	/** Preprocessor macros (list of preproc_macro_t) */
-	list_t macros;
+	/** Number of entries in the condition stack */
+	size_t nconditions;
+	/** Macro hash table (lists of preproc_macro_t) */
+	list_t macros[preproc_macro_buckets];
+	/** Header cache (lists of preproc_hdr_t) */
+	list_t hdrs[preproc_hdr_buckets];
+	/** Precompiled header or @c NULL */
+	pch_t *pch;
+	/** Precompiled header can still be used */
+	bool pch_pending;
+	/** Precompiled header has been used */
+	bool pch_used;
+	/** Do not print diagnostic messages */
+	bool quiet;
+	/** Number of diagnostic messages reported */
+	unsigned ndiags;
 } preproc_t;
 
 /** C preprocessor input stack entry */
@@ -113,6 +191,16 @@ typedef struct preproc_input {
 	size_t buf_used;
 	/** Current position */
 	src_pos_t pos;
+	/** Depth of the condition stack when the input was entered */
+	size_t nconditions;
+	/** Header cache entry or @c NULL if not included from a file */
+	preproc_hdr_t *hdr;
+	/** Multiple-include optimization state */
+	preproc_mi_state_t mi_state;
+	/** Candidate include guard macro name or @c NULL */
+	char *mi_guard;
+	/** Depth of the condition stack inside the candidate guard */
+	size_t mi_depth;
 } preproc_input_t;
 
 /** C preprocessor condition stack entry */
@@ -133,8 +221,80 @@ typedef struct {
 	src_pos_t else_epos;
 	/** Preprocessor was skipping before entering this condition. */
 	bool was_skipping;
+	/** One of the groups of this condition has already been taken. */
+	bool taken;
 } preproc_condition_t;
 
+/** Preprocessing token type */
+typedef enum {
+	/** Identifier */
+	ppt_ident,
+	/** Preprocessing number */
+	ppt_number,
+	/** Character constant */
+	ppt_charlit,
+	/** String literal */
+	ppt_strlit,
+	/** Punctuator */
+	ppt_punct,
+	/** Other character */
+	ppt_other,
+	/** Whitespace, comment or line splice */
+	ppt_ws,
+	/** New line */
+	ppt_newline,
+	/** Macro parameter (in replacement list) */
+	ppt_param,
+	/** Stringizing operator '#' (in replacement list) */
+	ppt_stringize,
+	/** Token pasting operator '##' (in replacement list) */
+	ppt_paste,
+	/** Placemarker (empty argument operand of '##') */
+	ppt_placemarker
+} preproc_toktype_t;
+
+/** Hide set entry.
+ *
+ * A hide set is an immutable singly-linked list of names of macros
+ * that must not be expanded again. The empty set is @c NULL.
+ */
+typedef struct preproc_hs {
+	/** Next entry */
+	struct preproc_hs *next;
+	/** Macro name */
+	const char *name;
+} preproc_hs_t;
+
+/** Preprocessing token */
+typedef struct {
+	/** Link to token list */
+	link_t ltoks;
+	/** Token type */
+	preproc_toktype_t ttype;
+	/** Token text */
+	char *text;
+	/** Parameter index (for ppt_param) */
+	size_t pidx;
+	/** Position of the beginning of the token */
+	src_pos_t bpos;
+	/** Token is a result of macro expansion */
+	bool expd;
+	/** First token of a macro expansion (@c bpos is the invocation) */
+	bool anchor;
+	/** Hide set */
+	preproc_hs_t *hs;
+} preproc_tok_t;
+
+/** Built-in macro type */
+typedef enum {
+	/** Ordinary macro */
+	pmb_none,
+	/** __FILE__ */
+	pmb_file,
+	/** __LINE__ */
+	pmb_line
+} preproc_builtin_t;
+
 /** C preprocessor macro */
 typedef struct {
 	/** Containing preprocessor */
@@ -143,8 +303,40 @@ typedef struct {
 	link_t lmacros;
 	/** Macro name */
 	char *name;
+	/** Built-in macro type */
+	preproc_builtin_t builtin;
+	/** Function-like macro */
+	bool funlike;
+	/** Variadic macro (last parameter is __VA_ARGS__) */
+	bool variadic;
+	/** Number of parameters */
+	size_t nparams;
+	/** Parameter names */
+	char **params;
+	/** Replacement list (list of preproc_tok_t) */
+	list_t body;
 } preproc_macro_t;
 
+/** Value of preprocessor expression */
+typedef struct {
+	/** Value (two's complement if signed) */
+	unsigned long v;
+	/** Value is unsigned */
+	bool uns;
+} preproc_val_t;
+
+/** Preprocessor expression evaluator */
+typedef struct {
+	/** Preprocessor */
+	struct preproc *preproc;
+	/** Token list */
+	list_t *toks;
+	/** Current token or @c NULL at the end */
+	preproc_tok_t *tok;
+	/** Position for diagnostics */
+	src_pos_t pos;
+} preproc_expr_t;
+
 /** Include type (angle brackets or quotes) */
 typedef enum {
 	/** Include with angled brackets */
@@ -29,14 +29,26 @@
 
 #include <adt/list.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <types/lexer.h>
 
+enum {
+	/** Initial number of hash buckets in a scope (power of two) */
+	scope_init_buckets = 8
+};
+
 /** Scope */
 typedef struct scope {
 	/** Parent scope or @c NULL */
 	struct scope *parent;
 	/** Scope members */
 	list_t members; /* of scope_member_t */
+	/** Member hash buckets (chained via scope_member_t.hnext) */
+	struct scope_member **buckets;
+	/** Number of hash buckets (power of two) */
+	size_t nbuckets;
+	/** Number of members */
+	size_t nmembers;
 } scope_t;
 
 /** Scope member type */
@@ -111,6 +123,10 @@ typedef struct scope_member {
 	scope_t *scope;
 	/** Link to scope_t.members */
 	link_t lmembers;
+	/** Next member in the same hash bucket */
+	struct scope_member *hnext;
+	/** Hash of the identifier */
+	unsigned long hash;
 	/** Identifier token */
 	lexer_tok_t *tident;
 	/** Code generator type */
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Compile server
+ */
+
+#ifndef TYPES_SERVER_H
+#define TYPES_SERVER_H
+
+#include <stdbool.h>
+
+enum {
+	/** Reply message: standard output data */
+	server_msg_out = 'o',
+	/** Reply message: standard error output data */
+	server_msg_err = 'e',
+	/** Reply message: exit status */
+	server_msg_exit = 'x',
+	/** Maximum number of arguments in request */
+	server_max_args = 1024,
+	/** Maximum size of string in request */
+	server_max_str = 4096,
+	/** Time limit for receiving data from client (seconds) */
+	server_recv_timeout = 10
+};
+
+/** Compile server */
+typedef struct {
+	/** Listening socket */
+	int fd;
+	/** Socket path */
+	char *path;
+} server_t;
+
+/** Compile server request */
+typedef struct {
+	/** Connection socket */
+	int fd;
+	/** Current working directory of client */
+	char *cwd;
+	/** Number of arguments */
+	int argc;
+	/** Arguments (argv[0] is the client program name) */
+	char **argv;
+} server_req_t;
+
+/** Function processing compile server request (returns exit status) */
+typedef int (*server_req_fn_t)(void *);
+
+/** Watched file */
+typedef struct {
+	/** File name */
+	char *fname;
+	/** @c true iff file existed when last checked */
+	bool exists;
+	/** Modification time when last checked */
+	unsigned long mtime;
+	/** File size when last checked */
+	unsigned long size;
+} server_watch_t;
+
+#endif
@@ -27,17 +27,34 @@
 #ifndef TYPES_SRC_POS_H
 #define TYPES_SRC_POS_H
 
-#include <stddef.h>
+#include <stdint.h>
 
-enum {
-	src_pos_fname_max = 128
-};
+/** Source file ID (index into the table of interned file names).
+ *
+ * ID 0 stands for no file (empty file name).
+ */
+typedef uint32_t src_file_id_t;
 
 /** Source code position */
 typedef struct {
-	char file[src_pos_fname_max];
-	size_t line;
-	size_t col;
+	/** Source file */
+	src_file_id_t file;
+	/** Line number (starting from 1) */
+	uint32_t line;
+	/** Column number (starting from 1) */
+	uint32_t col;
 } src_pos_t;
 
+/** Table of interned source file names */
+typedef struct {
+	/** File names, indexed by file ID */
+	char **fnames;
+	/** Number of entries in @c fnames */
+	src_file_id_t nfiles;
+	/** Number of allocated entries in @c fnames */
+	src_file_id_t alloc;
+	/** Most recently interned file ID */
+	src_file_id_t last;
+} src_file_tab_t;
+
 #endif
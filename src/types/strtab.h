@@ -0,0 +1,67 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * String table
+ */
+
+#ifndef TYPES_STRTAB_H
+#define TYPES_STRTAB_H
+
+#include <stddef.h>
+#include <types/arena.h>
+
+enum {
+	/** Initial number of hash buckets */
+	strtab_init_buckets = 256
+};
+
+/** String table entry */
+typedef struct strtab_entry {
+	/** Next entry in the same hash bucket */
+	struct strtab_entry *next;
+	/** Hash of the string */
+	unsigned long hash;
+	/** Length of the string */
+	size_t len;
+	/** String (null-terminated) */
+	char *str;
+} strtab_entry_t;
+
+/** String table.
+ *
+ * Each distinct string is stored only once. Strings and entries
+ * are allocated from an arena and are valid until the arena is
+ * destroyed.
+ */
+typedef struct {
+	/** Arena to allocate strings from */
+	arena_t *arena;
+	/** Hash buckets */
+	strtab_entry_t **buckets;
+	/** Number of hash buckets (power of two) */
+	size_t nbuckets;
+	/** Number of entries */
+	size_t nentries;
+} strtab_t;
+
+#endif
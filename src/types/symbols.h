@@ -28,11 +28,14 @@
 #define TYPES_SYMBOLS_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 
 /** Symbols */
 typedef struct symbols {
 	/** Symbols */
 	list_t syms; /* of symbol_t */
+	/** Named symbols indexed by identifier */
+	hmap_t byname; /* of symbol_t */
 } symbols_t;
 
 /** Symbol type */
@@ -30,7 +30,7 @@
 #include <stdint.h>
 
 enum {
-	basic_line_max = 128
+	basic_line_max = 512
 };
 
 typedef struct {
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Unified diff
+ */
+
+#ifndef TYPES_UDIFF_H
+#define TYPES_UDIFF_H
+
+#include <stddef.h>
+
+enum {
+	/** Number of unchanged context lines around each hunk */
+	udiff_context = 3,
+	/** Maximum edit distance searched for a minimal diff */
+	udiff_max_dist = 1024
+};
+
+/** Line of text */
+typedef struct {
+	/** Beginning of the line */
+	const char *text;
+	/** Length of the line including the terminating newline, if any */
+	size_t len;
+} udiff_line_t;
+
+/** Text split into lines */
+typedef struct {
+	/** Lines */
+	udiff_line_t *lines;
+	/** Number of lines */
+	size_t nlines;
+	/** Per-line flag: line is not common to both texts */
+	char *changed;
+} udiff_text_t;
+
+/** Change block (a range of lines replaced with other lines) */
+typedef struct {
+	/** Index of first old line replaced (starting from zero) */
+	size_t aline;
+	/** Number of old lines replaced (zero for insertion) */
+	size_t alines;
+	/** Offset of the replacement text in the new text */
+	size_t boff;
+	/** Size of the replacement text in bytes */
+	size_t bsize;
+} udiff_edit_t;
+
+#endif
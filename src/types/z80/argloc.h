@@ -28,6 +28,7 @@
 #define TYPES_Z80_ARGLOC_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 #include <stdbool.h>
 #include <types/z80/z80ic.h>
 
@@ -41,6 +42,8 @@ typedef struct {
 	bool variadic;
 	/** Entries (of z80_argloc_entry_t) */
 	list_t entries;
+	/** Entries indexed by argument identifier */
+	hmap_t byname; /* of z80_argloc_entry_t */
 	/** Number of bytes used on the stack */
 	unsigned stack_used;
 	/** Bit mask of used upper halves of 16-bit registers */
@@ -166,6 +166,14 @@ typedef enum {
 	ztt_error
 } z80ic_lexer_toktype_t;
 
+/** Keyword table entry */
+typedef struct {
+	/** Keyword (must be the first member) */
+	const char *kw;
+	/** Token type */
+	z80ic_lexer_toktype_t ttype;
+} z80ic_lexer_kw_t;
+
 #define ztt_resword_first ztt_add
 #define ztt_resword_last ztt_xor
 
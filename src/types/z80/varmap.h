@@ -28,23 +28,32 @@
 #define TYPES_Z80_VARMAP_H
 
 #include <adt/list.h>
+#include <types/adt/hmap.h>
 
 /** Z80 IR local variable to VR map */
 typedef struct {
 	/** Entries (of z80_varmap_entry_t) */
 	list_t entries;
+	/** Entries indexed by variable identifier */
+	hmap_t byname; /* of z80_varmap_entry_t */
+	/** Entries of numbered temporaries indexed by temporary number */
+	struct z80_varmap_entry **bytemp;
+	/** Number of slots in @c bytemp */
+	unsigned ntemps;
 	/** Next free virtual register */
 	unsigned next_vr;
 } z80_varmap_t;
 
 /** Z80 IR local variable to VR map entry */
-typedef struct {
+typedef struct z80_varmap_entry {
 	/** Containing variable map */
 	z80_varmap_t *varmap;
 	/** Link to @c varmap->entries */
 	link_t lentries;
-	/** Variable identifier */
+	/** Variable identifier or @c NULL for numbered temporary */
 	char *ident;
+	/** Temporary number (only if @c ident is @c NULL) */
+	unsigned tempno;
 	/** First used virtual register */
 	unsigned vr0;
 	/** Number of used virtual registers */
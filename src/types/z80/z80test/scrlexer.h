@@ -68,6 +68,7 @@ typedef enum {
 	stt_call,
 	stt_dword,
 	stt_ld,
+	stt_ldbank,
 	stt_ldbin,
 	stt_mapfile,
 	stt_pop,
@@ -75,6 +76,7 @@ typedef enum {
 	stt_ptr,
 	stt_push,
 	stt_qword,
+	stt_stack,
 	stt_verify,
 	stt_word,
 
@@ -88,6 +90,14 @@ typedef enum {
 	stt_error
 } scr_lexer_toktype_t;
 
+/** Keyword table entry */
+typedef struct {
+	/** Keyword (must be the first member) */
+	const char *kw;
+	/** Token type */
+	scr_lexer_toktype_t ttype;
+} scr_lexer_kw_t;
+
 #define stt_resword_first stt_call
 #define stt_resword_last stt_print
 
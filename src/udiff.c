@@ -0,0 +1,555 @@
+/*
+ * Copyright 2026 Jiri Svoboda
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Unified diff
+ *
+ * Compares two texts line by line and prints the differences in
+ * the unified diff format, which can be applied using patch(1).
+ *
+ * Lines common to the beginning and end of both texts are skipped,
+ * the rest is compared using the O(ND) algorithm by E. W. Myers. If the
+ * texts differ too much, the differing part is reported as a single
+ * change instead of searching for a minimal diff.
+ *
+ * The differences can also be returned as a list of change blocks,
+ * which can be used to present fixes in an editor.
+ */
+
+#include <merrno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <udiff.h>
+#include <types/udiff.h>
+
+/** Split text into lines.
+ *
+ * @param text Text
+ * @param size Size of text in bytes
+ * @param t Text structure to initialize
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int udiff_text_init(const char *text, size_t size, udiff_text_t *t)
+{
+	size_t nlines;
+	size_t i;
+	size_t lbeg;
+
+	nlines = 0;
+	for (i = 0; i < size; i++) {
+		if (text[i] == '\n')
+			++nlines;
+	}
+
+	/* Last line not terminated by a newline */
+	if (size > 0 && text[size - 1] != '\n')
+		++nlines;
+
+	t->lines = calloc(nlines + 1, sizeof(udiff_line_t));
+	if (t->lines == NULL)
+		return ENOMEM;
+
+	t->changed = calloc(nlines + 1, sizeof(char));
+	if (t->changed == NULL) {
+		free(t->lines);
+		return ENOMEM;
+	}
+
+	t->nlines = 0;
+	lbeg = 0;
+	for (i = 0; i < size; i++) {
+		if (text[i] == '\n' || i + 1 == size) {
+			t->lines[t->nlines].text = text + lbeg;
+			t->lines[t->nlines].len = i + 1 - lbeg;
+			++t->nlines;
+			lbeg = i + 1;
+		}
+	}
+
+	return EOK;
+}
+
+/** Free text structure.
+ *
+ * @param t Text structure
+ */
+static void udiff_text_fini(udiff_text_t *t)
+{
+	free(t->lines);
+	free(t->changed);
+}
+
+/** Determine if two lines are equal.
+ *
+ * @param a First line
+ * @param b Second line
+ * @return @c true iff the lines are equal
+ */
+static bool udiff_line_eq(udiff_line_t *a, udiff_line_t *b)
+{
+	return a->len == b->len && memcmp(a->text, b->text, a->len) == 0;
+}
+
+/** Find lines that are not common to both texts.
+ *
+ * Sets the @c changed flag of every line of @a a that is deleted and
+ * every line of @a b that is inserted by the (minimal) edit script.
+ * Lines without the flag form the longest common subsequence.
+ *
+ * @param a Old text
+ * @param b New text
+ * @return EOK on success, ENOMEM if out of memory
+ */
+static int udiff_compare(udiff_text_t *a, udiff_text_t *b)
+{
+	size_t pre;
+	size_t suf;
+	int n, m;
+	int maxd;
+	int d, k;
+	int x, y;
+	int px, py, pk;
+	int mx, my;
+	int off;
+	int *v = NULL;
+	int **trace = NULL;
+	int *pv;
+	bool found;
+	int rc;
+
+	/* Skip common prefix and suffix */
+	pre = 0;
+	while (pre < a->nlines && pre < b->nlines &&
+	    udiff_line_eq(&a->lines[pre], &b->lines[pre]))
+		++pre;
+
+	suf = 0;
+	while (suf < a->nlines - pre && suf < b->nlines - pre &&
+	    udiff_line_eq(&a->lines[a->nlines - 1 - suf],
+	    &b->lines[b->nlines - 1 - suf]))
+		++suf;
+
+	n = (int)(a->nlines - pre - suf);
+	m = (int)(b->nlines - pre - suf);
+
+	if (a->nlines - pre - suf + b->nlines - pre - suf > udiff_max_dist)
+		maxd = udiff_max_dist;
+	else
+		maxd = n + m;
+
+	off = maxd + 1;
+	v = calloc((size_t)(2 * maxd + 3), sizeof(int));
+	if (v == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	trace = calloc((size_t)(maxd + 1), sizeof(int *));
+	if (trace == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Find length of the shortest edit script */
+	found = false;
+	for (d = 0; d <= maxd; d++) {
+		for (k = -d; k <= d; k += 2) {
+			if (k == -d || (k != d && v[off + k - 1] <
+			    v[off + k + 1]))
+				x = v[off + k + 1];
+			else
+				x = v[off + k - 1] + 1;
+			y = x - k;
+
+			while (x < n && y < m &&
+			    udiff_line_eq(&a->lines[pre + x],
+			    &b->lines[pre + y])) {
+				++x;
+				++y;
+			}
+
+			v[off + k] = x;
+			if (x >= n && y >= m) {
+				found = true;
+				break;
+			}
+		}
+
+		if (found)
+			break;
+
+		/* Remember furthest reaching paths for backtracking */
+		trace[d] = calloc((size_t)(2 * d + 1), sizeof(int));
+		if (trace[d] == NULL) {
+			rc = ENOMEM;
+			goto error;
+		}
+
+		memcpy(trace[d], &v[off - d],
+		    (size_t)(2 * d + 1) * sizeof(int));
+	}
+
+	if (!found) {
+		/* Too many differences, replace everything in between */
+		for (x = 0; x < n; x++)
+			a->changed[pre + x] = 1;
+		for (y = 0; y < m; y++)
+			b->changed[pre + y] = 1;
+	} else {
+		/* Walk the shortest edit script backwards */
+		x = n;
+		y = m;
+		for (; d > 0; d--) {
+			pv = trace[d - 1];
+			k = x - y;
+			if (k == -d || (k != d && pv[k - 1 + d - 1] <
+			    pv[k + 1 + d - 1]))
+				pk = k + 1;
+			else
+				pk = k - 1;
+
+			px = pv[pk + d - 1];
+			py = px - pk;
+
+			/* Point reached by the insertion or deletion */
+			if (pk == k + 1) {
+				mx = px;
+				my = py + 1;
+			} else {
+				mx = px + 1;
+				my = py;
+			}
+
+			/* Skip the snake of common lines */
+			while (x > mx && y > my) {
+				--x;
+				--y;
+			}
+
+			if (pk == k + 1)
+				b->changed[pre + py] = 1;
+			else
+				a->changed[pre + px] = 1;
+
+			x = px;
+			y = py;
+		}
+	}
+
+	for (d = 0; d <= maxd; d++)
+		free(trace[d]);
+	free(trace);
+	free(v);
+	return EOK;
+error:
+	if (trace != NULL) {
+		for (d = 0; d <= maxd; d++)
+			free(trace[d]);
+		free(trace);
+	}
+	free(v);
+	return rc;
+}
+
+/** Print unified diff hunk range.
+ *
+ * @param start Index of the first line of the hunk
+ * @param len Number of lines in the hunk
+ * @param f Output file
+ */
+static void udiff_print_range(size_t start, size_t len, FILE *f)
+{
+	if (len == 1)
+		(void)fprintf(f, "%lu", (unsigned long)start + 1);
+	else if (len == 0)
+		(void)fprintf(f, "%lu,0", (unsigned long)start);
+	else
+		(void)fprintf(f, "%lu,%lu", (unsigned long)start + 1,
+		    (unsigned long)len);
+}
+
+/** Print line of a hunk.
+ *
+ * @param prefix Line prefix (' ', '-' or '+')
+ * @param line Line
+ * @param f Output file
+ */
+static void udiff_print_line(char prefix, udiff_line_t *line, FILE *f)
+{
+	(void)fputc(prefix, f);
+	(void)fwrite(line->text, 1, line->len, f);
+	if (line->len == 0 || line->text[line->len - 1] != '\n')
+		(void)fputs("\n\\ No newline at end of file\n", f);
+}
+
+/** Print hunks of the diff.
+ *
+ * @param a Old text
+ * @param b New text
+ * @param ops Edit script (one of ' ', '-', '+' per line)
+ * @param nops Number of operations in the edit script
+ * @param f Output file
+ */
+static void udiff_print_hunks(udiff_text_t *a, udiff_text_t *b,
+    const char *ops, size_t nops, FILE *f)
+{
+	size_t p, q;
+	size_t hs, he;
+	size_t lc;
+	size_t ia, ib;
+	size_t al, bl;
+
+	ia = 0;
+	ib = 0;
+	p = 0;
+	while (p < nops) {
+		if (ops[p] == ' ') {
+			++p;
+			++ia;
+			++ib;
+			continue;
+		}
+
+		/* First change in the hunk */
+		lc = p;
+
+		/* Hunk starts with up to udiff_context lines of context */
+		hs = p >= udiff_context ? p - udiff_context : 0;
+		while (p > hs) {
+			--p;
+			--ia;
+			--ib;
+		}
+
+		/* Merge changes separated by little enough context */
+		for (q = lc; q < nops; q++) {
+			if (ops[q] != ' ')
+				lc = q;
+			else if (q - lc > 2 * udiff_context)
+				break;
+		}
+
+		he = lc + 1 + udiff_context;
+		if (he > nops)
+			he = nops;
+
+		al = 0;
+		bl = 0;
+		for (q = hs; q < he; q++) {
+			if (ops[q] != '+')
+				++al;
+			if (ops[q] != '-')
+				++bl;
+		}
+
+		(void)fputs("@@ -", f);
+		udiff_print_range(ia, al, f);
+		(void)fputs(" +", f);
+		udiff_print_range(ib, bl, f);
+		(void)fputs(" @@\n", f);
+
+		for (; p < he; p++) {
+			switch (ops[p]) {
+			case '-':
+				udiff_print_line('-', &a->lines[ia++], f);
+				break;
+			case '+':
+				udiff_print_line('+', &b->lines[ib++], f);
+				break;
+			default:
+				udiff_print_line(' ', &a->lines[ia++], f);
+				++ib;
+				break;
+			}
+		}
+	}
+}
+
+/** Print unified diff of two texts.
+ *
+ * Nothing is printed if the texts are identical.
+ *
+ * @param aname Name of old file (printed in the diff header)
+ * @param atext Old text
+ * @param asize Size of old text in bytes
+ * @param bname Name of new file (printed in the diff header)
+ * @param btext New text
+ * @param bsize Size of new text in bytes
+ * @param f Output file
+ * @return EOK on success, ENOMEM if out of memory, EIO on output error
+ */
+int udiff_print(const char *aname, const char *atext, size_t asize,
+    const char *bname, const char *btext, size_t bsize, FILE *f)
+{
+	udiff_text_t a;
+	udiff_text_t b;
+	char *ops = NULL;
+	size_t nops;
+	size_t ia, ib;
+	bool changed;
+	int rc;
+
+	rc = udiff_text_init(atext, asize, &a);
+	if (rc != EOK)
+		return rc;
+
+	rc = udiff_text_init(btext, bsize, &b);
+	if (rc != EOK) {
+		udiff_text_fini(&a);
+		return rc;
+	}
+
+	rc = udiff_compare(&a, &b);
+	if (rc != EOK)
+		goto error;
+
+	ops = calloc(a.nlines + b.nlines + 1, sizeof(char));
+	if (ops == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	/* Convert change flags to an edit script */
+	nops = 0;
+	ia = 0;
+	ib = 0;
+	changed = false;
+	while (ia < a.nlines || ib < b.nlines) {
+		if (ia < a.nlines && a.changed[ia] != 0) {
+			ops[nops++] = '-';
+			++ia;
+			changed = true;
+		} else if (ib < b.nlines && b.changed[ib] != 0) {
+			ops[nops++] = '+';
+			++ib;
+			changed = true;
+		} else {
+			ops[nops++] = ' ';
+			++ia;
+			++ib;
+		}
+	}
+
+	if (changed) {
+		(void)fprintf(f, "--- %s\n+++ %s\n", aname, bname);
+		udiff_print_hunks(&a, &b, ops, nops, f);
+	}
+
+	if (ferror(f) != 0)
+		rc = EIO;
+
+	free(ops);
+	udiff_text_fini(&a);
+	udiff_text_fini(&b);
+	return rc;
+error:
+	free(ops);
+	udiff_text_fini(&a);
+	udiff_text_fini(&b);
+	return rc;
+}
+
+/** Compute change blocks transforming one text into another.
+ *
+ * @param atext Old text
+ * @param asize Size of old text in bytes
+ * @param btext New text
+ * @param bsize Size of new text in bytes
+ * @param redits Place to store pointer to array of change blocks
+ *        in order of position (to be freed by the caller)
+ * @param rnedits Place to store number of change blocks
+ * @return EOK on success, ENOMEM if out of memory
+ */
+int udiff_edits(const char *atext, size_t asize, const char *btext,
+    size_t bsize, udiff_edit_t **redits, size_t *rnedits)
+{
+	udiff_text_t a;
+	udiff_text_t b;
+	udiff_edit_t *edits = NULL;
+	size_t nedits;
+	size_t ia, ib;
+	size_t sa, sb;
+	int rc;
+
+	rc = udiff_text_init(atext, asize, &a);
+	if (rc != EOK)
+		return rc;
+
+	rc = udiff_text_init(btext, bsize, &b);
+	if (rc != EOK) {
+		udiff_text_fini(&a);
+		return rc;
+	}
+
+	rc = udiff_compare(&a, &b);
+	if (rc != EOK)
+		goto error;
+
+	/* There cannot be more blocks than common lines plus one */
+	edits = calloc(a.nlines + 1, sizeof(udiff_edit_t));
+	if (edits == NULL) {
+		rc = ENOMEM;
+		goto error;
+	}
+
+	nedits = 0;
+	ia = 0;
+	ib = 0;
+	while (ia < a.nlines || ib < b.nlines) {
+		if ((ia >= a.nlines || a.changed[ia] == 0) &&
+		    (ib >= b.nlines || b.changed[ib] == 0)) {
+			/* Common line */
+			++ia;
+			++ib;
+			continue;
+		}
+
+		sa = ia;
+		sb = ib;
+		while (ia < a.nlines && a.changed[ia] != 0)
+			++ia;
+		while (ib < b.nlines && b.changed[ib] != 0)
+			++ib;
+
+		edits[nedits].aline = sa;
+		edits[nedits].alines = ia - sa;
+		edits[nedits].boff = sb < b.nlines ?
+		    (size_t)(b.lines[sb].text - btext) : bsize;
+		edits[nedits].bsize = ib < b.nlines ?
+		    (size_t)(b.lines[ib].text - btext) - edits[nedits].boff :
+		    bsize - edits[nedits].boff;
+		++nedits;
+	}
+
+	udiff_text_fini(&a);
+	udiff_text_fini(&b);
+	*redits = edits;
+	*rnedits = nedits;
+	return EOK;
+error:
+	free(edits);
+	udiff_text_fini(&a);
+	udiff_text_fini(&b);
+	return rc;
+}
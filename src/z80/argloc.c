@@ -62,6 +62,7 @@
  * available pair from HL, DE, BC (only the lower half is used).
  */
 
+#include <adt/hmap.h>
 #include <assert.h>
 #include <merrno.h>
 #include <stdlib.h>
@@ -104,6 +105,7 @@ int z80_argloc_create(bool variadic, z80_argloc_t **rargloc)
 		return ENOMEM;
 
 	list_initialize(&argloc->entries);
+	hmap_initialize(&argloc->byname, hmk_str);
 	argloc->variadic = variadic;
 
 	*rargloc = argloc;
@@ -121,6 +123,9 @@ void z80_argloc_destroy(z80_argloc_t *argloc)
 	if (argloc == NULL)
 		return;
 
+	/* No need to maintain the index while destroying everything */
+	hmap_fini(&argloc->byname);
+
 	entry = z80_argloc_first(argloc);
 	while (entry != NULL) {
 		z80_argloc_entry_destroy(entry);
@@ -333,6 +338,14 @@ int z80_argloc_alloc(z80_argloc_t *argloc, const char *ident, unsigned bytes,
 		return ENOMEM;
 	}
 
+	/* If the identifier is already present, the first entry is found */
+	rc = hmap_insert_str(&argloc->byname, entry->ident, entry);
+	if (rc == ENOMEM) {
+		free(entry->ident);
+		free(entry);
+		return ENOMEM;
+	}
+
 	/* Allocate registers */
 
 	rem_bytes = bytes;
@@ -402,17 +415,12 @@ int z80_argloc_find(z80_argloc_t *argloc, const char *ident,
 {
 	z80_argloc_entry_t *entry;
 
-	entry = z80_argloc_first(argloc);
-	while (entry != NULL) {
-		if (strcmp(entry->ident, ident) == 0) {
-			*rentry = entry;
-			return EOK;
-		}
-
-		entry = z80_argloc_next(entry);
-	}
+	entry = (z80_argloc_entry_t *)hmap_find_str(&argloc->byname, ident);
+	if (entry == NULL)
+		return ENOENT;
 
-	return ENOENT;
+	*rentry = entry;
+	return EOK;
 }
 
 /** Destroy argument locations entry.
@@ -421,6 +429,10 @@ int z80_argloc_find(z80_argloc_t *argloc, const char *ident,
  */
 void z80_argloc_entry_destroy(z80_argloc_entry_t *entry)
 {
+	if ((z80_argloc_entry_t *)hmap_find_str(&entry->argloc->byname,
+	    entry->ident) == entry)
+		hmap_remove_str(&entry->argloc->byname, entry->ident);
+
 	free(entry->ident);
 	list_remove(&entry->lentries);
 	free(entry);
@@ -438,7 +438,7 @@ static int z80_emit_var(z80_emit_t *emit, z80ic_var_t *var)
 
 	size = emit->section->len - offset;
 	rc = obj_symbol_create(emit->object, var->ident, emit->section,
-	    objb_local, offset, size, &symbol);
+	    objb_local, objk_data, offset, size, &symbol);
 	if (rc != EOK)
 		return rc;
 
@@ -3441,8 +3441,8 @@ static int z80_emit_proc(z80_emit_t *emit, z80ic_proc_t *proc)
 	while (entry != NULL) {
 		if (entry->label != NULL) {
 			rc = obj_symbol_create(emit->object, entry->label,
-			    emit->section, objb_local, emit->section->len, 0,
-			    &symbol);
+			    emit->section, objb_local, objk_code,
+			    emit->section->len, 0, &symbol);
 			if (rc != EOK)
 				goto error;
 		}
@@ -3458,7 +3458,7 @@ static int z80_emit_proc(z80_emit_t *emit, z80ic_proc_t *proc)
 
 	size = emit->section->len - offset;
 	rc = obj_symbol_create(emit->object, proc->ident, emit->section,
-	    objb_local, offset, size, &symbol);
+	    objb_local, objk_code, offset, size, &symbol);
 	if (rc != EOK)
 		goto error;
 
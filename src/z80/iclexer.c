@@ -28,6 +28,7 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <kwtab.h>
 #include <merrno.h>
 #include <src_pos.h>
 #include <stdbool.h>
@@ -36,6 +37,119 @@
 #include <string.h>
 #include <z80/iclexer.h>
 
+/** Keywords */
+static const z80ic_lexer_kw_t z80ic_lexer_kw_entries[] = {
+	{ "A", ztt_A },
+	{ "AF", ztt_AF },
+	{ "B", ztt_B },
+	{ "BC", ztt_BC },
+	{ "C", ztt_C },
+	{ "D", ztt_D },
+	{ "DE", ztt_DE },
+	{ "E", ztt_E },
+	{ "F", ztt_F },
+	{ "H", ztt_H },
+	{ "HL", ztt_HL },
+	{ "I", ztt_I },
+	{ "IX", ztt_IX },
+	{ "IY", ztt_IY },
+	{ "L", ztt_L },
+	{ "M", ztt_M },
+	{ "NC", ztt_NC },
+	{ "NZ", ztt_NZ },
+	{ "P", ztt_P },
+	{ "PE", ztt_PE },
+	{ "PO", ztt_PO },
+	{ "R", ztt_R },
+	{ "SP", ztt_SP },
+	{ "Z", ztt_Z },
+	{ "adc", ztt_adc },
+	{ "add", ztt_add },
+	{ "and", ztt_and },
+	{ "begin", ztt_begin },
+	{ "bit", ztt_bit },
+	{ "call", ztt_call },
+	{ "ccf", ztt_ccf },
+	{ "cp", ztt_cp },
+	{ "cpd", ztt_cpd },
+	{ "cpdr", ztt_cpdr },
+	{ "cpi", ztt_cpi },
+	{ "cpir", ztt_cpir },
+	{ "cpl", ztt_cpl },
+	{ "daa", ztt_daa },
+	{ "dec", ztt_dec },
+	{ "defb", ztt_defb },
+	{ "defdw", ztt_defdw },
+	{ "defqw", ztt_defqw },
+	{ "defw", ztt_defw },
+	{ "di", ztt_di },
+	{ "djnz", ztt_djnz },
+	{ "ei", ztt_ei },
+	{ "end", ztt_end },
+	{ "ex", ztt_ex },
+	{ "extern", ztt_extern },
+	{ "exx", ztt_exx },
+	{ "global", ztt_global },
+	{ "halt", ztt_halt },
+	{ "im", ztt_im },
+	{ "in", ztt_in },
+	{ "inc", ztt_inc },
+	{ "ind", ztt_ind },
+	{ "indr", ztt_indr },
+	{ "ini", ztt_ini },
+	{ "inir", ztt_inir },
+	{ "jp", ztt_jp },
+	{ "jr", ztt_jr },
+	{ "ld", ztt_ld },
+	{ "ldd", ztt_ldd },
+	{ "lddr", ztt_lddr },
+	{ "ldi", ztt_ldi },
+	{ "ldir", ztt_ldir },
+	{ "lvar", ztt_lvar },
+	{ "neg", ztt_neg },
+	{ "nop", ztt_nop },
+	{ "or", ztt_or },
+	{ "otdr", ztt_otdr },
+	{ "otir", ztt_otir },
+	{ "out", ztt_out },
+	{ "outd", ztt_outd },
+	{ "outi", ztt_outi },
+	{ "pop", ztt_pop },
+	{ "proc", ztt_proc },
+	{ "push", ztt_push },
+	{ "res", ztt_res },
+	{ "ret", ztt_ret },
+	{ "reti", ztt_reti },
+	{ "retn", ztt_retn },
+	{ "rl", ztt_rl },
+	{ "rla", ztt_rla },
+	{ "rlc", ztt_rlc },
+	{ "rlca", ztt_rlca },
+	{ "rld", ztt_rld },
+	{ "rr", ztt_rr },
+	{ "rra", ztt_rra },
+	{ "rrc", ztt_rrc },
+	{ "rrca", ztt_rrca },
+	{ "rrd", ztt_rrd },
+	{ "rst", ztt_rst },
+	{ "sbc", ztt_sbc },
+	{ "scf", ztt_scf },
+	{ "set", ztt_set },
+	{ "sla", ztt_sla },
+	{ "sra", ztt_sra },
+	{ "srl", ztt_srl },
+	{ "sub", ztt_sub },
+	{ "var", ztt_var },
+	{ "xor", ztt_xor }
+};
+
+/** Keyword table */
+static kwtab_t z80ic_lexer_kwtab = {
+	.entries = z80ic_lexer_kw_entries,
+	.nentries = sizeof(z80ic_lexer_kw_entries) / sizeof(z80ic_lexer_kw_t),
+	.esize = sizeof(z80ic_lexer_kw_t)
+};
+
 /** Create lexer.
  *
  * @param ops Input ops
@@ -592,6 +706,38 @@ static int z80ic_lexer_error(z80ic_lexer_t *lexer, z80ic_lexer_tok_t *tok)
 	return EOK;
 }
 
+/** Lex word.
+ *
+ * Words that are not keywords are invalid.
+ *
+ * @param lexer Lexer
+ * @param tok Output token
+ *
+ * @return EOK on success or non-zero error code
+ */
+static int z80ic_lexer_word(z80ic_lexer_t *lexer, z80ic_lexer_tok_t *tok)
+{
+	const char *p;
+	size_t maxlen;
+	size_t len;
+	const z80ic_lexer_kw_t *kw;
+
+	maxlen = kwtab_maxlen(&z80ic_lexer_kwtab);
+	assert(maxlen < z80ic_lexer_buf_low_watermark);
+
+	/* Determine word length (only up to longest keyword length + 1) */
+	p = z80ic_lexer_chars(lexer);
+	len = 1;
+	while (len <= maxlen && is_idcnt(p[len]))
+		++len;
+
+	kw = kwtab_lookup(&z80ic_lexer_kwtab, p, len);
+	if (kw != NULL)
+		return z80ic_lexer_keyword(lexer, kw->ttype, len, tok);
+
+	return z80ic_lexer_invalid(lexer, tok);
+}
+
 /** Lex next token in.
  *
  * @param lexer Lexer
@@ -651,373 +797,10 @@ int z80ic_lexer_get_tok(z80ic_lexer_t *lexer, z80ic_lexer_tok_t *tok)
 	case 'A':
 		if (p[1] == 'F' && p[2] == '\'')
 			return z80ic_lexer_keyword(lexer, ztt_AF_, 3, tok);
-		if (p[1] == 'F' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_AF, 2, tok);
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_A, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'B':
-		if (p[1] == 'C' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_BC, 2, tok);
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_B, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'C':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_C, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'D':
-		if (p[1] == 'E' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_DE, 2, tok);
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_D, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'E':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_E, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'F':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_F, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'H':
-		if (p[1] == 'L' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_HL, 2, tok);
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_H, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'I':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_I, 1, tok);
-		if (p[1] == 'X' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_IX, 2, tok);
-		if (p[1] == 'Y' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_IY, 2, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'L':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_L, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'M':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_M, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'N':
-		if (p[1] == 'C' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_NC, 2, tok);
-		if (p[1] == 'Z' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_NZ, 2, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'P':
-		if (p[1] == 'E' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_PE, 2, tok);
-		if (p[1] == 'O' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_PO, 2, tok);
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_P, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'R':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_R, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'S':
-		if (p[1] == 'P' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_SP, 2, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'Z':
-		if (!is_idcnt(p[1]))
-			return z80ic_lexer_keyword(lexer, ztt_Z, 1, tok);
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'a':
-		if (p[1] == 'd' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_adc, 3, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_add, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_and, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'b':
-		if (p[1] == 'e' && p[2] == 'g' && p[3] == 'i' &&
-		    p[4] == 'n' && !is_idcnt(p[5])) {
-			return z80ic_lexer_keyword(lexer, ztt_begin, 5, tok);
-		}
-		if (p[1] == 'i' && p[2] == 't' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_bit, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'c':
-		if (p[1] == 'a' && p[2] == 'l' && p[3] == 'l' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_call, 4, tok);
-		}
-		if (p[1] == 'c' && p[2] == 'f' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ccf, 3, tok);
-		}
-		if (p[1] == 'p' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_cp, 2, tok);
-		if (p[1] == 'p' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_cpd, 3, tok);
-		}
-		if (p[1] == 'p' && p[2] == 'd' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_cpdr, 4, tok);
-		}
-		if (p[1] == 'p' && p[2] == 'i' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_cpi, 3, tok);
-		}
-		if (p[1] == 'p' && p[2] == 'i' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_cpir, 4, tok);
-		}
-		if (p[1] == 'p' && p[2] == 'l' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_cpl, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'd':
-		if (p[1] == 'a' && p[2] == 'a' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_daa, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_dec, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'f' && p[3] == 'b' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_defb, 4, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'f' && p[3] == 'w' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_defw, 4, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'f' && p[3] == 'd' &&
-		    p[4] == 'w' && !is_idcnt(p[5])) {
-			return z80ic_lexer_keyword(lexer, ztt_defdw, 5, tok);
-		}
-		if (p[1] == 'e' && p[2] == 'f' && p[3] == 'q' &&
-		    p[4] == 'w' && !is_idcnt(p[5])) {
-			return z80ic_lexer_keyword(lexer, ztt_defqw, 5, tok);
-		}
-		if (p[1] == 'i' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_di, 2, tok);
-		if (p[1] == 'j' && p[2] == 'n' && p[3] == 'z' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_djnz, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'e':
-		if (p[1] == 'i' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_ei, 2, tok);
-		if (p[1] == 'n' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_end, 3, tok);
-		}
-		if (p[1] == 'x' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_ex, 2, tok);
-		if (p[1] == 'x' && p[2] == 'x' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_exx, 3, tok);
-		}
-		if (p[1] == 'x' && p[2] == 't' && p[3] == 'e' &&
-		    p[4] == 'r' && p[5] == 'n' && !is_idcnt(p[6])) {
-			return z80ic_lexer_keyword(lexer, ztt_extern, 6, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'g':
-		if (p[1] == 'l' && p[2] == 'o' && p[3] == 'b' &&
-		    p[4] == 'a' && p[5] == 'l' && !is_idcnt(p[6])) {
-			return z80ic_lexer_keyword(lexer, ztt_global, 6, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'h':
-		if (p[1] == 'a' && p[2] == 'l' && p[3] == 't' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_halt, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'i':
-		if (p[1] == 'm' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_im, 2, tok);
-		if (p[1] == 'n' && !is_idcnt(p[2]))
-			return z80ic_lexer_keyword(lexer, ztt_in, 2, tok);
-		if (p[1] == 'n' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_inc, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ind, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'd' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_indr, 4, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'i' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ini, 3, tok);
-		}
-		if (p[1] == 'n' && p[2] == 'i' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_inir, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'j':
-		if (p[1] == 'p' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_jp, 2, tok);
-		}
-		if (p[1] == 'r' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_jr, 2, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'l':
-		if (p[1] == 'd' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_ld, 2, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ldd, 3, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'd' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_lddr, 4, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'i' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ldi, 3, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'i' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_ldir, 4, tok);
-		}
-		if (p[1] == 'v' && p[2] == 'a' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_lvar, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'n':
-		if (p[1] == 'e' && p[2] == 'g' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_neg, 3, tok);
-		}
-		if (p[1] == 'o' && p[2] == 'p' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_nop, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'o':
-		if (p[1] == 'r' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_or, 2, tok);
-		}
-		if (p[1] == 't' && p[2] == 'd' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_otdr, 4, tok);
-		}
-		if (p[1] == 't' && p[2] == 'i' && p[3] == 'r' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_otir, 4, tok);
-		}
-		if (p[1] == 'u' && p[2] == 't' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_out, 3, tok);
-		}
-		if (p[1] == 'u' && p[2] == 't' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_outd, 4, tok);
-		}
-		if (p[1] == 'u' && p[2] == 't' && p[3] == 'i' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_outi, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'p':
-		if (p[1] == 'o' && p[2] == 'p' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_pop, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'o' && p[3] == 'c' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_proc, 4, tok);
-		}
-		if (p[1] == 'u' && p[2] == 's' && p[3] == 'h' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_push, 4, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'r':
-		if (p[1] == 'e' && p[2] == 's' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_res, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_ret, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && p[3] == 'i' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_reti, 4, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && p[3] == 'n' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_retn, 4, tok);
-		}
-		if (p[1] == 'l' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_rl, 2, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'a' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rla, 3, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rlc, 3, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rld, 3, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'c' && p[3] == 'a' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_rlca, 4, tok);
-		}
-		if (p[1] == 'r' && !is_idcnt(p[2])) {
-			return z80ic_lexer_keyword(lexer, ztt_rr, 2, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'a' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rra, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rrc, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'c' && p[3] == 'a' &&
-		    !is_idcnt(p[4])) {
-			return z80ic_lexer_keyword(lexer, ztt_rrca, 4, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'd' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rrd, 3, tok);
-		}
-		if (p[1] == 's' && p[2] == 't' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_rst, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 's':
-		if (p[1] == 'b' && p[2] == 'c' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_sbc, 3, tok);
-		}
-		if (p[1] == 'c' && p[2] == 'f' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_scf, 3, tok);
-		}
-		if (p[1] == 'e' && p[2] == 't' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_set, 3, tok);
-		}
-		if (p[1] == 'l' && p[2] == 'a' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_sla, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'a' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_sra, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'l' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_srl, 3, tok);
-		}
-		if (p[1] == 'u' && p[2] == 'b' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_sub, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'v':
-		if (p[1] == 'a' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_var, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
-	case 'x':
-		if (p[1] == 'o' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return z80ic_lexer_keyword(lexer, ztt_xor, 3, tok);
-		}
-		return z80ic_lexer_invalid(lexer, tok);
+		return z80ic_lexer_word(lexer, tok);
 	default:
+		if (is_alpha(p[0]))
+			return z80ic_lexer_word(lexer, tok);
 		if (is_num(p[0]))
 			return z80ic_lexer_number(lexer, tok);
 		if (!is_print(p[0]))
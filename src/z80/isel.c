@@ -130,23 +130,22 @@ static int z80_isel_mangle_lvar_ident(const char *proc,
 	return EOK;
 }
 
-/** Determine if variable is a virtual register.
+/** Find variable map entry for variable operand.
  *
- * @param varname Variable name
- * @return @c true iff variable is a virtual register
+ * @param isproc Instruction selector for procedure
+ * @param opvar Variable operand
+ * @param rentry Place to store pointer to variable map entry
+ * @return EOK on success, ENOENT if not found
  */
-static bool z80_isel_is_vreg(const char *varname)
+static int z80_isel_varmap_find(z80_isel_proc_t *isproc, ir_oper_var_t *opvar,
+    z80_varmap_entry_t **rentry)
 {
-	char *endptr;
-
-	if (varname[0] != '%')
-		return false;
-
-	(void) strtoul(&varname[1], &endptr, 10);
-	if (*endptr != '\0')
-		return false;
+	if (opvar->varname == NULL) {
+		return z80_varmap_find_temp(isproc->varmap, opvar->tempno,
+		    rentry);
+	}
 
-	return true;
+	return z80_varmap_find(isproc->varmap, opvar->varname, rentry);
 }
 
 /** Get virtual register number from variable name.
@@ -165,7 +164,7 @@ static unsigned z80_isel_get_vregno(z80_isel_proc_t *isproc, ir_oper_t *oper)
 	assert(oper->optype == iro_var);
 	opvar = (ir_oper_var_t *) oper->ext;
 
-	rc = z80_varmap_find(isproc->varmap, opvar->varname, &entry);
+	rc = z80_isel_varmap_find(isproc, opvar, &entry);
 	assert(rc == EOK);
 
 	return entry->vr0;
@@ -422,6 +421,9 @@ static int z80_isel_call_rsize(z80_isel_proc_t *isproc, ir_instr_t *instr,
 
 	op1 = (ir_oper_var_t *) instr->op1->ext;
 
+	if (op1->varname == NULL)
+		return ENOENT;
+
 	irmod = isproc->irproc->decln.module;
 	rc = ir_module_find(irmod, op1->varname, &decln);
 	if (rc != EOK)
@@ -466,7 +468,7 @@ static int z80_isel_scan_instr_def_vars(z80_isel_proc_t *isproc,
 
 	if (instr->dest != NULL && instr->dest->optype == iro_var) {
 		opvar = (ir_oper_var_t *) instr->dest->ext;
-		if (z80_isel_is_vreg(opvar->varname)) {
+		if (opvar->varname == NULL) {
 			/* Determine destination variable size */
 			switch (instr->itype) {
 			case iri_eq:
@@ -497,11 +499,11 @@ static int z80_isel_scan_instr_def_vars(z80_isel_proc_t *isproc,
 				break;
 			}
 
-			rc = z80_varmap_find(isproc->varmap, opvar->varname,
-			    &entry);
+			rc = z80_varmap_find_temp(isproc->varmap,
+			    opvar->tempno, &entry);
 			if (rc == ENOENT) {
-				rc = z80_varmap_insert(isproc->varmap,
-				    opvar->varname, bytes);
+				rc = z80_varmap_insert_temp(isproc->varmap,
+				    opvar->tempno, bytes);
 				if (rc != EOK)
 					return rc;
 			}
@@ -523,6 +525,7 @@ static int z80_isel_proc_create_varmap(z80_isel_proc_t *isproc,
 	ir_proc_arg_t *arg;
 	ir_lblock_entry_t *entry;
 	size_t bytes;
+	unsigned tempno;
 	int rc;
 
 	if (irproc->rtype != NULL) {
@@ -545,7 +548,13 @@ static int z80_isel_proc_create_varmap(z80_isel_proc_t *isproc,
 		if (rc != EOK)
 			return rc;
 
-		rc = z80_varmap_insert(isproc->varmap, arg->ident, bytes);
+		if (ir_temp_parse(arg->ident, &tempno) == EOK) {
+			rc = z80_varmap_insert_temp(isproc->varmap, tempno,
+			    bytes);
+		} else {
+			rc = z80_varmap_insert(isproc->varmap, arg->ident,
+			    bytes);
+		}
 		if (rc != EOK)
 			return rc;
 
@@ -4276,9 +4285,12 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 	z80_argloc_entry_t *entry;
 	z80_varmap_entry_t *vmentry;
 	ir_oper_var_t *op1;
+	char op1buf[ir_temp_name_size];
+	const char *op1name;
 	ir_oper_list_t *op2;
 	ir_oper_t *arg;
 	ir_oper_var_t *argvar;
+	char argbuf[ir_temp_name_size];
 	ir_decln_t *pdecln;
 	ir_proc_t *proc;
 	ir_proc_arg_t *parg;
@@ -4309,22 +4321,30 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 
 	op1 = (ir_oper_var_t *) irinstr->op1->ext;
 	op2 = (ir_oper_list_t *) irinstr->op2->ext;
+	op1name = ir_oper_var_name(op1, op1buf);
 
 	if (irinstr->itype == iri_call) {
-		rc = z80_isel_mangle_global_ident(op1->varname, &varident);
+		if (op1->varname == NULL) {
+			(void)fprintf(stderr, "Call to undefined procedure "
+			    "'%s'.\n", op1name);
+			rc = EINVAL;
+			goto error;
+		}
+
+		rc = z80_isel_mangle_global_ident(op1name, &varident);
 		if (rc != EOK)
 			goto error;
 
-		rc = ir_module_find(isproc->isel->irmodule, op1->varname, &pdecln);
+		rc = ir_module_find(isproc->isel->irmodule, op1name, &pdecln);
 		if (rc != EOK) {
 			(void)fprintf(stderr, "Call to undefined procedure "
-			    "'%s'.\n", op1->varname);
+			    "'%s'.\n", op1name);
 			goto error;
 		}
 
 		if (pdecln->dtype != ird_proc) {
 			(void)fprintf(stderr, "Calling object '%s' which "
-			    "is not a procedure.\n", op1->varname);
+			    "is not a procedure.\n", op1name);
 			rc = EINVAL;
 			goto error;
 		}
@@ -4344,7 +4364,7 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		if (pdecln->dtype != ird_proc ||
 		    ((ir_proc_t *)pdecln->ext)->linkage != irl_callsign) {
 			(void)fprintf(stderr, "Object '%s' is not a call "
-			    "signature.\n", op1->varname);
+			    "signature.\n", op1name);
 			rc = EINVAL;
 			goto error;
 		}
@@ -4388,12 +4408,12 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		if (parg == NULL && !proc->variadic) {
 			/* Too many arguments */
 			(void)fprintf(stderr, "Too many arguments to procedure "
-			    "'%s'.\n", op1->varname);
+			    "'%s'.\n", op1name);
 			rc = EINVAL;
 			goto error;
 		}
 
-		rc = z80_varmap_find(isproc->varmap, argvar->varname, &vmentry);
+		rc = z80_isel_varmap_find(isproc, argvar, &vmentry);
 		assert(rc == EOK);
 
 		if (parg != NULL) {
@@ -4412,11 +4432,11 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 			if (bits != vmentry->bytes * 8) {
 				(void)fprintf(stderr, "Calling object '%s' "
 				    "which is not a procedure.\n",
-				    op1->varname);
+				    op1name);
 				(void)fprintf(stderr, "Function '%s' argument "
 				    "%u: Actual parameter size (%u) does not "
 				    "match formal paramater size (%u).\n",
-				    op1->varname, argidx, vmentry->bytes,
+				    op1name, argidx, vmentry->bytes,
 				    bits / 8);
 				goto error;
 			}
@@ -4435,7 +4455,7 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		}
 
 		/** Allocate argument location */
-		rc = z80_argloc_alloc(argloc, argvar->varname,
+		rc = z80_argloc_alloc(argloc, ir_oper_var_name(argvar, argbuf),
 		    (bits + 7) / 8, &entry);
 		if (rc != EOK)
 			goto error;
@@ -4450,7 +4470,7 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 	if (parg != NULL) {
 		/* Too few arguments */
 		(void)fprintf(stderr, "Too few arguments to procedure "
-		    "'%s'.\n", op1->varname);
+		    "'%s'.\n", op1name);
 		rc = EINVAL;
 		goto error;
 	}
@@ -4468,7 +4488,7 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		argvr = z80_isel_get_vregno(isproc, arg);
 
 		rc = z80_isel_call_set_arg_stack(isproc, argloc, argvr,
-		    argvar->varname, lblock);
+		    ir_oper_var_name(argvar, argbuf), lblock);
 		if (rc != EOK)
 			goto error;
 
@@ -4514,7 +4534,7 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		argvr = z80_isel_get_vregno(isproc, arg);
 
 		rc = z80_isel_call_set_arg_reg(isproc, argloc, argvr,
-		    argvar->varname, lblock);
+		    ir_oper_var_name(argvar, argbuf), lblock);
 		if (rc != EOK)
 			goto error;
 
@@ -4618,7 +4638,8 @@ static int z80_isel_call(z80_isel_proc_t *isproc, const char *label,
 		argvar = (ir_oper_var_t *) arg->ext;
 
 		/** Find argument location */
-		rc = z80_argloc_find(argloc, argvar->varname, &entry);
+		rc = z80_argloc_find(argloc, ir_oper_var_name(argvar, argbuf),
+		    &entry);
 		assert(rc == EOK);
 		if (rc != EOK)
 			return rc;
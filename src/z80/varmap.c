@@ -24,9 +24,11 @@
  * Z80 IR local variable to VR map
  *
  * Maps local variable names in an IR procedure to virtual registers
- * in a Z80 VR IC procedure.
+ * in a Z80 VR IC procedure. Numbered temporaries are looked up
+ * by number in a directly indexed table.
  */
 
+#include <adt/hmap.h>
 #include <assert.h>
 #include <merrno.h>
 #include <stdlib.h>
@@ -47,6 +49,7 @@ int z80_varmap_create(z80_varmap_t **rvarmap)
 		return ENOMEM;
 
 	list_initialize(&varmap->entries);
+	hmap_initialize(&varmap->byname, hmk_str);
 
 	*rvarmap = varmap;
 	return EOK;
@@ -63,15 +66,43 @@ void z80_varmap_destroy(z80_varmap_t *varmap)
 	if (varmap == NULL)
 		return;
 
+	/* No need to maintain the index while destroying everything */
+	hmap_fini(&varmap->byname);
+
 	entry = z80_varmap_first(varmap);
 	while (entry != NULL) {
 		z80_varmap_entry_destroy(entry);
 		entry = z80_varmap_first(varmap);
 	}
 
+	free(varmap->bytemp);
 	free(varmap);
 }
 
+/** Allocate virtual registers to new variable map entry and add it to map.
+ *
+ * @param varmap Variable map
+ * @param entry New variable map entry
+ * @param bytes Variable size in bytes
+ */
+static void z80_varmap_entry_alloc_vrs(z80_varmap_t *varmap,
+    z80_varmap_entry_t *entry, unsigned bytes)
+{
+	unsigned vrn;
+
+	/* Compute number of used virtual registers */
+	vrn = bytes > 1 ? bytes / 2 : 1;
+
+	/* Allocate next vrn virtual registers to the variable */
+	entry->vr0 = varmap->next_vr;
+	entry->vrn = vrn;
+	entry->bytes = bytes;
+	varmap->next_vr += vrn;
+
+	list_append(&entry->lentries, &varmap->entries);
+	entry->varmap = varmap;
+}
+
 /** Insert variable into variable map.
  *
  * @param varmap Variable map
@@ -82,10 +113,7 @@ void z80_varmap_destroy(z80_varmap_t *varmap)
 int z80_varmap_insert(z80_varmap_t *varmap, const char *ident, unsigned bytes)
 {
 	z80_varmap_entry_t *entry;
-	unsigned vrn;
-
-	/* Compute number of used virtual registers */
-	vrn = bytes > 1 ? bytes / 2 : 1;
+	int rc;
 
 	entry = calloc(1, sizeof(z80_varmap_entry_t));
 	if (entry == NULL)
@@ -97,15 +125,63 @@ int z80_varmap_insert(z80_varmap_t *varmap, const char *ident, unsigned bytes)
 		return ENOMEM;
 	}
 
-	/* Allocate next vrn virtual registers to the variable */
-	entry->vr0 = varmap->next_vr;
-	entry->vrn = vrn;
-	entry->bytes = bytes;
-	varmap->next_vr += vrn;
+	/* If the identifier is already present, the first entry is found */
+	rc = hmap_insert_str(&varmap->byname, entry->ident, entry);
+	if (rc == ENOMEM) {
+		free(entry->ident);
+		free(entry);
+		return ENOMEM;
+	}
 
-	list_append(&entry->lentries, &varmap->entries);
-	entry->varmap = varmap;
+	z80_varmap_entry_alloc_vrs(varmap, entry, bytes);
+	return EOK;
+}
 
+/** Insert numbered temporary into variable map.
+ *
+ * @param varmap Variable map
+ * @param tempno Temporary number
+ * @param bytes Variable size in bytes
+ * @return EOK on success or an error code
+ */
+int z80_varmap_insert_temp(z80_varmap_t *varmap, unsigned tempno,
+    unsigned bytes)
+{
+	z80_varmap_entry_t *entry;
+	z80_varmap_entry_t **nbytemp;
+	unsigned nslots;
+	unsigned i;
+
+	if (tempno >= varmap->ntemps) {
+		/* Grow the table geometrically */
+		nslots = varmap->ntemps > 0 ? varmap->ntemps * 2 : 16;
+		if (nslots <= tempno)
+			nslots = tempno + 1;
+
+		nbytemp = realloc(varmap->bytemp,
+		    (size_t)nslots * sizeof(z80_varmap_entry_t *));
+		if (nbytemp == NULL)
+			return ENOMEM;
+
+		for (i = varmap->ntemps; i < nslots; i++)
+			nbytemp[i] = NULL;
+
+		varmap->bytemp = nbytemp;
+		varmap->ntemps = nslots;
+	}
+
+	entry = calloc(1, sizeof(z80_varmap_entry_t));
+	if (entry == NULL)
+		return ENOMEM;
+
+	entry->ident = NULL;
+	entry->tempno = tempno;
+
+	/* If the temporary is already present, the first entry is found */
+	if (varmap->bytemp[tempno] == NULL)
+		varmap->bytemp[tempno] = entry;
+
+	z80_varmap_entry_alloc_vrs(varmap, entry, bytes);
 	return EOK;
 }
 
@@ -121,21 +197,47 @@ int z80_varmap_find(z80_varmap_t *varmap, const char *ident,
 {
 	z80_varmap_entry_t *entry;
 
-	entry = z80_varmap_first(varmap);
-	while (entry != NULL) {
-		if (strcmp(entry->ident, ident) == 0) {
-			*rentry = entry;
-			return EOK;
-		}
+	entry = (z80_varmap_entry_t *)hmap_find_str(&varmap->byname, ident);
+	if (entry == NULL)
+		return ENOENT;
 
-		entry = z80_varmap_next(entry);
-	}
+	*rentry = entry;
+	return EOK;
+}
 
-	return ENOENT;
+/** Find variable map entry for numbered temporary.
+ *
+ * @param varmap Variable map
+ * @param tempno Temporary number
+ * @param rentry Place to store pointer to variable map entry
+ * @return EOK on success, ENOENT if not found
+ */
+int z80_varmap_find_temp(z80_varmap_t *varmap, unsigned tempno,
+    z80_varmap_entry_t **rentry)
+{
+	if (tempno >= varmap->ntemps || varmap->bytemp[tempno] == NULL)
+		return ENOENT;
+
+	*rentry = varmap->bytemp[tempno];
+	return EOK;
 }
 
+/** Destroy variable map entry.
+ *
+ * @param entry Variable map entry
+ */
 void z80_varmap_entry_destroy(z80_varmap_entry_t *entry)
 {
+	z80_varmap_t *varmap = entry->varmap;
+
+	if (entry->ident == NULL) {
+		if (varmap->bytemp[entry->tempno] == entry)
+			varmap->bytemp[entry->tempno] = NULL;
+	} else if ((z80_varmap_entry_t *)hmap_find_str(&varmap->byname,
+	    entry->ident) == entry) {
+		hmap_remove_str(&varmap->byname, entry->ident);
+	}
+
 	free(entry->ident);
 	list_remove(&entry->lentries);
 	free(entry);
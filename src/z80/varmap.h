@@ -32,7 +32,10 @@
 extern int z80_varmap_create(z80_varmap_t **);
 extern void z80_varmap_destroy(z80_varmap_t *);
 extern int z80_varmap_insert(z80_varmap_t *, const char *, unsigned);
+extern int z80_varmap_insert_temp(z80_varmap_t *, unsigned, unsigned);
 extern int z80_varmap_find(z80_varmap_t *, const char *, z80_varmap_entry_t **);
+extern int z80_varmap_find_temp(z80_varmap_t *, unsigned,
+    z80_varmap_entry_t **);
 extern void z80_varmap_entry_destroy(z80_varmap_entry_t *);
 extern z80_varmap_entry_t *z80_varmap_first(z80_varmap_t *);
 extern z80_varmap_entry_t *z80_varmap_next(z80_varmap_entry_t *);
@@ -32,9 +32,47 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "kwtab.h"
 #include "src_pos.h"
 #include "scrlexer.h"
 
+/** Keywords */
+static const scr_lexer_kw_t scr_lexer_kw_entries[] = {
+	{ "A", stt_A },
+	{ "AF", stt_AF },
+	{ "B", stt_B },
+	{ "BC", stt_BC },
+	{ "C", stt_C },
+	{ "D", stt_D },
+	{ "DE", stt_DE },
+	{ "E", stt_E },
+	{ "H", stt_H },
+	{ "HL", stt_HL },
+	{ "L", stt_L },
+	{ "byte", stt_byte },
+	{ "call", stt_call },
+	{ "dword", stt_dword },
+	{ "ld", stt_ld },
+	{ "ldbank", stt_ldbank },
+	{ "ldbin", stt_ldbin },
+	{ "mapfile", stt_mapfile },
+	{ "pop", stt_pop },
+	{ "print", stt_print },
+	{ "ptr", stt_ptr },
+	{ "push", stt_push },
+	{ "qword", stt_qword },
+	{ "stack", stt_stack },
+	{ "verify", stt_verify },
+	{ "word", stt_word }
+};
+
+/** Keyword table */
+static kwtab_t scr_lexer_kwtab = {
+	.entries = scr_lexer_kw_entries,
+	.nentries = sizeof(scr_lexer_kw_entries) / sizeof(scr_lexer_kw_t),
+	.esize = sizeof(scr_lexer_kw_t)
+};
+
 /** Create lexer.
  *
  * @param ops Input ops
@@ -648,6 +686,38 @@ static int scr_lexer_error(scr_lexer_t *lexer, scr_lexer_tok_t *tok)
 	return 0;
 }
 
+/** Lex word.
+ *
+ * Words that are not keywords are invalid.
+ *
+ * @param lexer Lexer
+ * @param tok Output token
+ *
+ * @return Zero on sucess or non-zero error code
+ */
+static int scr_lexer_word(scr_lexer_t *lexer, scr_lexer_tok_t *tok)
+{
+	const char *p;
+	size_t maxlen;
+	size_t len;
+	const scr_lexer_kw_t *kw;
+
+	maxlen = kwtab_maxlen(&scr_lexer_kwtab);
+	assert(maxlen < scr_lexer_buf_low_watermark);
+
+	/* Determine word length (only up to longest keyword length + 1) */
+	p = scr_lexer_chars(lexer);
+	len = 1;
+	while (len <= maxlen && is_idcnt(p[len]))
+		++len;
+
+	kw = kwtab_lookup(&scr_lexer_kwtab, p, len);
+	if (kw != NULL)
+		return scr_lexer_keyword(lexer, kw->ttype, len, tok);
+
+	return scr_lexer_invalid(lexer, tok);
+}
+
 /** Lex next token in.
  *
  * @param lexer Lexer
@@ -704,126 +774,13 @@ int scr_lexer_get_tok(scr_lexer_t *lexer, scr_lexer_tok_t *tok)
 		return scr_lexer_onechar(lexer, stt_scolon, tok);
 	case '@':
 		return scr_lexer_ident(lexer, tok);
-	case 'A':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_A, 1, tok);
-		}
-		if (p[1] == 'F' && !is_idcnt(p[2])) {
-			return scr_lexer_keyword(lexer, stt_AF, 2, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'B':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_B, 1, tok);
-		}
-		if (p[1] == 'C' && !is_idcnt(p[2])) {
-			return scr_lexer_keyword(lexer, stt_BC, 2, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'C':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_C, 1, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'D':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_D, 1, tok);
-		}
-		if (p[1] == 'E' && !is_idcnt(p[2])) {
-			return scr_lexer_keyword(lexer, stt_DE, 2, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'E':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_E, 1, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'H':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_H, 1, tok);
-		}
-		if (p[1] == 'L' && !is_idcnt(p[2])) {
-			return scr_lexer_keyword(lexer, stt_HL, 2, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'L':
-		if (!is_idcnt(p[1])) {
-			return scr_lexer_keyword(lexer, stt_L, 1, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'b':
-		if (p[1] == 'y' && p[2] == 't' && p[3] == 'e' &&
-		    !is_idcnt(p[4])) {
-			return scr_lexer_keyword(lexer, stt_byte, 4, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'c':
-		if (p[1] == 'a' && p[2] == 'l' && p[3] == 'l' &&
-		    !is_idcnt(p[4])) {
-			return scr_lexer_keyword(lexer, stt_call, 4, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'd':
-		if (p[1] == 'w' && p[2] == 'o' && p[3] == 'r' &&
-		    p[4] == 'd' && !is_idcnt(p[5])) {
-			return scr_lexer_keyword(lexer, stt_dword, 5, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'l':
-		if (p[1] == 'd' && !is_idcnt(p[2])) {
-			return scr_lexer_keyword(lexer, stt_ld, 2, tok);
-		}
-		if (p[1] == 'd' && p[2] == 'b' && p[3] == 'i' &&
-		    p[4] == 'n' && !is_idcnt(p[5])) {
-			return scr_lexer_keyword(lexer, stt_ldbin, 5, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'm':
-		if (p[1] == 'a' && p[2] == 'p' && p[3] == 'f' &&
-		    p[4] == 'i' && p[5] == 'l' && p[6] == 'e' &&
-		    !is_idcnt(p[7])) {
-			return scr_lexer_keyword(lexer, stt_mapfile, 7, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'p':
-		if (p[1] == 'o' && p[2] == 'p' && !is_idcnt(p[3])) {
-			return scr_lexer_keyword(lexer, stt_pop, 3, tok);
-		}
-		if (p[1] == 'r' && p[2] == 'i' && p[3] == 'n' &&
-		    p[4] == 't' && !is_idcnt(p[5])) {
-			return scr_lexer_keyword(lexer, stt_print, 5, tok);
-		}
-		if (p[1] == 't' && p[2] == 'r' && !is_idcnt(p[3])) {
-			return scr_lexer_keyword(lexer, stt_ptr, 3, tok);
-		}
-		if (p[1] == 'u' && p[2] == 's' && p[3] == 'h' &&
-		    !is_idcnt(p[4])) {
-			return scr_lexer_keyword(lexer, stt_push, 4, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'q':
-		if (p[1] == 'w' && p[2] == 'o' && p[3] == 'r' &&
-		    p[4] == 'd' && !is_idcnt(p[5])) {
-			return scr_lexer_keyword(lexer, stt_qword, 5, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'v':
-		if (p[1] == 'e' && p[2] == 'r' && p[3] == 'i' &&
-		    p[4] == 'f' && p[5] == 'y' && !is_idcnt(p[6])) {
-			return scr_lexer_keyword(lexer, stt_verify, 6, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
-	case 'w':
-		if (p[1] == 'o' && p[2] == 'r' && p[3] == 'd' &&
-		    !is_idcnt(p[4])) {
-			return scr_lexer_keyword(lexer, stt_word, 4, tok);
-		}
-		return scr_lexer_invalid(lexer, tok);
 	case '{':
 		return scr_lexer_onechar(lexer, stt_lbrace, tok);
 	case '}':
 		return scr_lexer_onechar(lexer, stt_rbrace, tok);
 	default:
+		if (is_alpha(p[0]))
+			return scr_lexer_word(lexer, tok);
 		if (is_num(p[0]))
 			return scr_lexer_number(lexer, tok);
 		if (!is_print(p[0]))
@@ -938,6 +895,8 @@ const char *scr_lexer_str_ttype(scr_lexer_toktype_t ttype)
 		return "'dword'";
 	case stt_ld:
 		return "'ld'";
+	case stt_ldbank:
+		return "'ldbank'";
 	case stt_ldbin:
 		return "'ldbin'";
 	case stt_mapfile:
@@ -952,6 +911,8 @@ const char *scr_lexer_str_ttype(scr_lexer_toktype_t ttype)
 		return "'push'";
 	case stt_qword:
 		return "'qword'";
+	case stt_stack:
+		return "'stack'";
 	case stt_verify:
 		return "'verify'";
 	case stt_word:
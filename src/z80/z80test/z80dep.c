@@ -57,9 +57,11 @@ uint8_t z80_in8(uint16_t a)
 
 void z80_out8(uint16_t addr, uint8_t val)
 {
-	(void) addr;
-	(void) val;
 	++pout_cnt;
+
+	/* 128K paging port (0x7ffd, partially decoded) */
+	if ((addr & 0x8002u) == 0)
+		mem_page(val & 0x07);
 }
 
 uint8_t z80_snoop8(void)
@@ -50,10 +50,22 @@ enum {
 	mem_size = 0x10000l,
 	max_cycles = 1000000l,
 	stack_base = 0xfff0u,
-	ret_addr = 0x1234
+	ret_addr = 0x1234,
+	/** Start of the 128K paging window */
+	bank_base = 0xc000u,
+	/** Size of one memory bank */
+	bank_size = 0x4000u,
+	/** Number of memory banks */
+	bank_count = 8
 };
 
 uint8_t *mem;
+/** Contents of banks that are not currently paged in */
+static uint8_t *banks;
+/** Bank currently paged in at bank_base */
+static unsigned cur_bank;
+/** Top of stack (SP value with nothing pushed) */
+static uint16_t stack_top = stack_base;
 uint32_t instr_cnt;
 
 uint32_t ifetch_cnt;
@@ -90,6 +102,55 @@ static int binary_load(const char *fname, uint16_t org)
 	return 0;
 }
 
+/** Page in memory bank.
+ *
+ * Emulates ZX Spectrum 128K paging. Contents of the paging window are
+ * saved to the bank that was paged in before and replaced with contents
+ * of the new bank.
+ *
+ * @param bank Memory bank number
+ */
+void mem_page(unsigned bank)
+{
+	if (bank == cur_bank)
+		return;
+
+	memcpy(banks + cur_bank * bank_size, mem + bank_base, bank_size);
+	memcpy(mem + bank_base, banks + bank * bank_size, bank_size);
+	cur_bank = bank;
+}
+
+static int bank_load(const char *fname, unsigned bank)
+{
+	FILE *f;
+	size_t nr;
+	uint8_t *dest;
+
+	f = fopen(fname, "rb");
+	if (f == NULL) {
+		(void)fprintf(stderr, "Error opening '%s'.\n", fname);
+		return -1;
+	}
+
+	if (bank == cur_bank)
+		dest = mem + bank_base;
+	else
+		dest = banks + bank * bank_size;
+
+	nr = fread(dest, 1, bank_size, f);
+	if (nr == 0) {
+		(void)fprintf(stderr, "Error reading '%s'.\n", fname);
+		(void)fclose(f);
+		return -1;
+	}
+
+	if (!quiet)
+		(void)printf("Read %zu bytes of code into bank %u.\n", nr, bank);
+
+	(void)fclose(f);
+	return 0;
+}
+
 static int mapfile_load(const char *fname)
 {
 	int rc;
@@ -780,6 +841,52 @@ static int script_do_ldbin(script_t *script)
 	return 0;
 }
 
+static int script_do_ldbank(script_t *script)
+{
+	scr_lexer_tok_t tok;
+	char *fname;
+	int64_t nval;
+	int rc;
+
+	script_skip(script);
+
+	script_read_next_tok(script, &tok);
+	rc = scr_lexer_string_text(&tok, &fname);
+	if (rc != 0) {
+		(void)fprintf(stderr, "Error: ");
+		(void)script_dprint_next_tok(script, stderr);
+		(void)fprintf(stderr, " is not a valid string literal.\n");
+		return rc;
+	}
+
+	script_skip(script);
+
+	rc = script_match(script, stt_comma);
+	if (rc != 0) {
+		free(fname);
+		return rc;
+	}
+
+	script_read_next_tok(script, &tok);
+	rc = scr_lexer_number_val(&tok, &nval);
+	if (rc != 0 || nval < 0 || nval >= bank_count) {
+		(void)fprintf(stderr, "Error: ");
+		(void)script_dprint_next_tok(script, stderr);
+		(void)fprintf(stderr, " is not a valid bank number.\n");
+		free(fname);
+		return EINVAL;
+	}
+
+	script_skip(script);
+
+	rc = bank_load(fname, (unsigned)nval);
+	free(fname);
+	if (rc < 0)
+		return 1;
+
+	return 0;
+}
+
 static int script_do_mapfile(script_t *script)
 {
 	scr_lexer_tok_t tok;
@@ -812,7 +919,7 @@ static int script_do_pop(script_t *script)
 	script_skip(script);
 
 	cpus.SP += 2;
-	if (cpus.SP > stack_base) {
+	if (cpus.SP > stack_top) {
 		(void)printf("Error: Stack underflow.\n");
 		return ERANGE;
 	}
@@ -856,6 +963,22 @@ static int script_do_push(script_t *script)
 	return rc;
 }
 
+static int script_do_stack(script_t *script)
+{
+	uint64_t eval;
+	int rc;
+
+	script_skip(script);
+
+	rc = script_eval_expr(script, &eval);
+	if (rc != 0)
+		return EINVAL;
+
+	stack_top = (uint16_t)eval;
+	cpus.SP = stack_top;
+	return 0;
+}
+
 static int script_do_verify(script_t *script)
 {
 	regmem_t rm;
@@ -906,6 +1029,9 @@ static int script_process_cmd(script_t *script)
 	case stt_ld:
 		rc = script_do_ld(script);
 		break;
+	case stt_ldbank:
+		rc = script_do_ldbank(script);
+		break;
 	case stt_ldbin:
 		rc = script_do_ldbin(script);
 		break;
@@ -921,6 +1047,9 @@ static int script_process_cmd(script_t *script)
 	case stt_push:
 		rc = script_do_push(script);
 		break;
+	case stt_stack:
+		rc = script_do_stack(script);
+		break;
 	case stt_verify:
 		rc = script_do_verify(script);
 		break;
@@ -1020,6 +1149,12 @@ int main(int argc, char *argv[])
 		return 1;
 	}
 
+	banks = calloc((size_t)bank_count * bank_size, 1);
+	if (banks == NULL) {
+		(void)fprintf(stderr, "Out of memory.\n");
+		return 1;
+	}
+
 	rc = symbols_create(&symbols);
 	if (rc != 0) {
 		(void)fprintf(stderr, "Out of memory.\n");
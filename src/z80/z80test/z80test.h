@@ -40,4 +40,6 @@ extern uint32_t dwrite_cnt;
 extern uint32_t pin_cnt;
 extern uint32_t pout_cnt;
 
+extern void mem_page(unsigned);
+
 #endif
@@ -0,0 +1,8 @@
+/*
+ * A backslash at the end of a C source line should be reported
+ */
+int main(void)
+{
+	printf("Hello ");
+	printf("world!\n");
+}
@@ -0,0 +1,5 @@
+/*
+ * Blank line at beginning of file.
+ */
+
+int x;
@@ -0,0 +1,11 @@
+/*
+ * Unexpected indentation on blank line
+ */
+
+int main(void)
+{
+	int x;
+
+	x = 1;
+	return x;
+}
@@ -0,0 +1,15 @@
+/*
+ * Do loop
+ */
+
+int main(void)
+{
+	int i;
+
+	i = 0;
+
+	/* The body of a do loop must be a braced block */
+	do
+		++i;
+	while (i < 10);
+}
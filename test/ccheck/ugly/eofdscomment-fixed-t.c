@@ -0,0 +1,5 @@
+/*
+ * Double-slash comment at the end of file not followed by a newline.
+ * Make sure we properly terminate the loop in lexer_dscomment()
+ */
+//
@@ -0,0 +1,5 @@
+/*
+ * Preprocessor line ending in a backslash, not followed by a newline at
+ * the end of file. Make sure we properly terminate the loop in lexer_preproc()
+ */
+#define FOO \
@@ -0,0 +1,5 @@
+/*
+ * Preprocessor line not followed by a newline at the end of file.
+ * Make sure we properly terminate lexer_preproc()
+ */
+#define FOO
@@ -0,0 +1,21 @@
+typedef int my_int;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void foo(void);
+extern void bar(void);
+
+#ifdef __cplusplus
+}
+
+extern "C" {
+#endif
+
+extern void foo(void);
+extern void bar(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,5 @@
+int main(void)
+{
+	/* Should remove both spaces inside the parentheses */
+	asm ("nop\n");
+}
@@ -0,0 +1,17 @@
+/*
+ * Header file storage class issues
+ */
+
+/* Non-static function defined in a header */
+int foo(void)
+{
+	return 0;
+}
+
+/* Non-static macro-based definition of function in a header */
+BAR(foo)
+{
+}
+
+/* Non-extern variable declard in a header */
+int x;
@@ -0,0 +1,11 @@
+/*
+ * Invalid characters in different contexts
+ */
+
+/* Backspace in string literal */
+char *s = "";
+/* Backspace in character literal */
+int c = '';
+
+/* Backspace in comment */
+// Backspace in double-slash comment
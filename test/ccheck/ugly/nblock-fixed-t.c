@@ -0,0 +1,17 @@
+/*
+ * Report gratuitous nested block.
+ */
+
+int main(int argc)
+{
+	switch (argc) {
+	case 0:
+		{
+			return 1;
+		}
+	}
+
+	int x = 1;
+	{
+	}
+}
@@ -0,0 +1,11 @@
+/*
+ * Empty declarations are not allowed.
+ */
+
+/* Empty top-level declaration */
+;
+
+typedef struct {
+	/* Empty struct member declaration */
+	;
+} foo_t;
@@ -0,0 +1,7 @@
+/*
+ * Three consecutive blank lines.
+ */
+
+int x;
+
+int y;
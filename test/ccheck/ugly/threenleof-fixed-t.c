@@ -0,0 +1,5 @@
+/*
+ * Three newlines at end of file.
+ */
+
+int x;
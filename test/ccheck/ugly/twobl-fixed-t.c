@@ -0,0 +1,7 @@
+/*
+ * Two consecutive blank lines.
+ */
+
+int x;
+
+int y;
@@ -0,0 +1,5 @@
+/*
+ * Two newlines at end of file.
+ */
+
+int x;
@@ -0,0 +1,5 @@
+/*
+ * Cross-bank data access test. This module is placed in a memory bank.
+ */
+
+int g = 5;
@@ -0,0 +1,11 @@
+/*
+ * Cross-bank data access test. This module is placed in common memory
+ * and reads a variable located in a memory bank, which is an error.
+ */
+
+extern int g;
+
+int getg(void)
+{
+	return g;
+}
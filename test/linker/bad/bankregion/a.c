@@ -0,0 +1,8 @@
+/*
+ * Banked region test. This module is placed in a memory bank.
+ */
+
+int a(void)
+{
+	return 1;
+}
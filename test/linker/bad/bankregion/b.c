@@ -0,0 +1,9 @@
+/*
+ * Banked region test. This module is placed in a memory region that
+ * extends into paged memory, which is an error when banks are in use.
+ */
+
+int b(void)
+{
+	return 2;
+}
@@ -0,0 +1,12 @@
+/*
+ * Banked code test. This module is placed in a memory bank.
+ */
+
+static int i = 1;
+
+int c(int x);
+
+int a(int x, int y)
+{
+	return c(x) + y + i;
+}
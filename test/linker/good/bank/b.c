@@ -0,0 +1,19 @@
+/*
+ * Banked code test. This module is placed in common memory and calls
+ * into a memory bank through a trampoline.
+ */
+
+int a(int x, int y);
+
+int res;
+
+int c(int x)
+{
+	return x * 2;
+}
+
+void run(void)
+{
+	/* This should be 2 * 10 + 20 + 1 = 41 */
+	res = a(10, 20);
+}
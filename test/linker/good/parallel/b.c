@@ -0,0 +1,12 @@
+/*
+ * Parallel compilation test. Modules are compiled by separate jobs
+ * and must be linked in command-line order. The local symbol 'i'
+ * is defined in every module.
+ */
+
+static int i = 2;
+
+int b(void)
+{
+	return i;
+}
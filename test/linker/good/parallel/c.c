@@ -0,0 +1,24 @@
+/*
+ * Parallel compilation test. Modules are compiled by separate jobs
+ * and must be linked in command-line order. The local symbol 'i'
+ * is defined in every module.
+ */
+
+static int i = 3;
+
+int a(void);
+int b(void);
+
+int resa;
+int resb;
+int resc;
+
+void run(void)
+{
+	/* This should be 1 */
+	resa = a();
+	/* This should be 2 */
+	resb = b();
+	/* This should be 3 */
+	resc = i;
+}
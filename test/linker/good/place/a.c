@@ -0,0 +1,17 @@
+/*
+ * Placement test. This module is placed at the default address.
+ */
+
+int b(void);
+int c(void);
+
+int resb;
+int resc;
+
+void run(void)
+{
+	/* This should be 2 */
+	resb = b();
+	/* This should be 3 */
+	resc = c();
+}
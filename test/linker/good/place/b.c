@@ -0,0 +1,11 @@
+/*
+ * Placement test. This module is placed in a separate memory region
+ * by the linker script.
+ */
+
+static int i = 2;
+
+int b(void)
+{
+	return i;
+}
@@ -0,0 +1,11 @@
+/*
+ * Placement test. This module is placed in a separate memory region
+ * by the linker script, aligned to a 256-byte boundary.
+ */
+
+static int i = 3;
+
+int c(void)
+{
+	return i;
+}
@@ -0,0 +1,7 @@
+/*
+ * Wrong number of macro arguments.
+ */
+
+#define ADD(a, b) ((a) + (b))
+
+int x = ADD(1);
@@ -0,0 +1,7 @@
+/*
+ * Incompatible macro redefinition.
+ */
+
+#define A 1
+#define A 1
+#define A 2
@@ -0,0 +1,8 @@
+/*
+ * Compilation cache test. This file compiles without warnings.
+ */
+
+int sub(int a, int b)
+{
+	return a - b;
+}
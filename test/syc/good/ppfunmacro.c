@@ -0,0 +1,34 @@
+/*
+ * Function-like macros, stringizing, token pasting and variadic macros
+ */
+
+#define SQ(x) ((x) * (x))
+#define ADD(a, b) ((a) + (b))
+#define CAT(a, b) a ## b
+#define XCAT(a, b) CAT(a, b)
+#define STR(x) #x
+#define FIRST(a, ...) a
+#define SUM3(...) add3(__VA_ARGS__)
+
+int a;
+int b;
+int c;
+int d;
+int v12;
+char s;
+
+int add3(int x, int y, int z)
+{
+	return x + y + z;
+}
+
+void ppfunmacro(void)
+{
+	a = SQ(ADD(1,
+	    2));
+	CAT(v, 12) = XCAT(0x, 10);
+	b = FIRST(5, 6, 7);
+	c = SUM3(1, 2, 3);
+	d = sizeof(STR(hello));
+	s = STR(ab)[1];
+}
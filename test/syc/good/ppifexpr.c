@@ -0,0 +1,30 @@
+/*
+ * #if / #elif with non-trivial expressions
+ */
+
+#define VERSION 3
+#define F(x) ((x) + 1)
+
+int a;
+int b;
+
+void ppifexpr(void)
+{
+#if defined(VERSION) && VERSION * 2 == 6 && F(1) == 2
+	a = 1;
+#else
+	a = 2;
+#endif
+
+#if VERSION < 2
+	b = 1;
+#elif !defined VERSION || -1 > 0
+	b = 2;
+#elif (VERSION ? 0x10 : 0) >> 4
+	b = 3;
+#elif 1
+	b = 4;
+#else
+	b = 5;
+#endif
+}
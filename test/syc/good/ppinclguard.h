@@ -0,0 +1,12 @@
+/*
+ * Header included by ppinclonce.c, protected by an include guard
+ */
+
+#ifndef PPINCLGUARD_H
+#define PPINCLGUARD_H
+
+struct guarded {
+	int b;
+};
+
+#endif
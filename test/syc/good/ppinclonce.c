@@ -0,0 +1,17 @@
+/*
+ * Including the same header multiple times
+ */
+
+#include "ppinclonce.h"
+#include "ppinclguard.h"
+#include "ppinclonce.h"
+#include "./ppinclguard.h"
+
+struct once o;
+struct guarded g;
+
+void ppinclonce(void)
+{
+	o.a = 1;
+	g.b = 2;
+}
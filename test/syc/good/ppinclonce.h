@@ -0,0 +1,9 @@
+/*
+ * Header included by ppinclonce.c, protected by #pragma once
+ */
+
+#pragma once
+
+struct once {
+	int a;
+};
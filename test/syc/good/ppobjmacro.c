@@ -0,0 +1,19 @@
+/*
+ * Object-like macros
+ */
+
+#define ONE 1
+#define TWO (ONE + ONE)
+#define EMPTY
+#define SELF SELF
+
+int a;
+int b;
+int SELF;
+
+void ppobjmacro(void)
+{
+	a = TWO * 3 EMPTY;
+	b = __LINE__;
+	SELF = __STDC__;
+}
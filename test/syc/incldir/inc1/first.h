@@ -0,0 +1,2 @@
+#include "sibling.h"
+#define FIRST 1
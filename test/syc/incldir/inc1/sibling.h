@@ -0,0 +1 @@
+#define SIBLING 3
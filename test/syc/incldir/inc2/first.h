@@ -0,0 +1 @@
+#define FIRST 10
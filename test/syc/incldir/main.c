@@ -0,0 +1,7 @@
+#include "first.h"
+#include <second.h>
+
+int main(void)
+{
+	return FIRST + SECOND + SIBLING;
+}
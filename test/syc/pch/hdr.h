@@ -0,0 +1,43 @@
+/*
+ * Header that is compiled into a precompiled header.
+ */
+
+#ifndef HDR_H
+#define HDR_H
+
+#include <stddef.h>
+
+#define SQUARE(x) ((x) * (x))
+#define LIMIT 10
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+typedef struct point {
+	int x;
+	int y;
+	unsigned visible : 1;
+	unsigned color : 3;
+} point_t;
+
+struct line {
+	point_t p[2];
+	struct line *next;
+};
+
+enum shape {
+	sh_none,
+	sh_line = 5,
+	sh_rect
+};
+
+union value {
+	int i;
+	char c[2];
+};
+
+typedef int (*point_fn_t)(point_t *);
+
+extern int point_dist(point_t *, point_t *);
+extern struct line *lines;
+extern enum shape cur_shape;
+
+#endif
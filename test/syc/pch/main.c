@@ -0,0 +1,36 @@
+/*
+ * Module using a precompiled header.
+ */
+
+#include "hdr.h"
+#include "hdr.h"
+
+struct line *lines;
+enum shape cur_shape;
+
+int point_dist(point_t *a, point_t *b)
+{
+	return MAX(SQUARE(a->x - b->x), SQUARE(a->y - b->y));
+}
+
+int main(void)
+{
+	point_t p;
+	struct line l;
+	union value v;
+	point_fn_t fn;
+
+	p.x = LIMIT;
+	p.y = 2;
+	p.color = 5;
+	l.p[0] = p;
+	l.p[1] = p;
+	l.next = NULL;
+	lines = &l;
+	cur_shape = sh_rect;
+	v.i = point_dist(&l.p[0], &l.p[1]) + (int)cur_shape;
+	fn = NULL;
+	if (fn != NULL)
+		return fn(&p);
+	return v.i;
+}
@@ -0,0 +1,8 @@
+/*
+ * Compile server test. This file contains an error.
+ */
+
+int f(void)
+{
+	return x;
+}
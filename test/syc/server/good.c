@@ -0,0 +1,8 @@
+/*
+ * Compile server test. This file compiles without errors.
+ */
+
+int add(int a, int b)
+{
+	return a + b;
+}
@@ -0,0 +1,17 @@
+/*
+ * Compile server test. Header that is compiled into a precompiled header.
+ */
+
+#ifndef HDR_H
+#define HDR_H
+
+#define TWICE(x) ((x) + (x))
+
+typedef struct {
+	int a;
+	int b;
+} pair_t;
+
+extern int pair_sum(pair_t *);
+
+#endif
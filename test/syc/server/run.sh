@@ -0,0 +1,149 @@
+#!/bin/bash
+#
+# Copyright 2026 Jiri Svoboda
+#
+# Permission is hereby granted, free of charge, to any person obtaining
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+#
+
+#
+# Compile server functional test
+#
+# Usage: run.sh <syc> <syc-flags>...
+#
+# Starts a compile server with a preloaded precompiled header, compiles
+# files in this directory both directly and through the server and compares
+# the results. Also checks that the socket is private and that a client
+# that sends nothing or sends a malformed request does not hold up or stop
+# the server. Prints a transcript to standard output.
+#
+
+syc="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+shift
+flags="$@"
+
+cd "$(dirname "$0")"
+
+sock="$(mktemp -u /tmp/syc-test-XXXXXX)"
+spid=""
+# Time limit for a client compile (seconds)
+ctimeout=10
+
+cleanup()
+{
+	if [ -n "$spid" ]; then
+		kill "$spid" 2>/dev/null
+		wait "$spid" 2>/dev/null
+	fi
+	rm -f "$sock" *-direct.* *-client.* hdr.pch
+}
+
+trap cleanup EXIT
+
+# Send raw data to the server (Perl string escapes allowed), then hold
+# the connection open for the specified number of seconds.
+raw_send()
+{
+	perl -MIO::Socket::UNIX -e '
+	    my $s = IO::Socket::UNIX->new(Peer => $ARGV[0]) or exit 1;
+	    print $s eval "\"$ARGV[1]\"";
+	    sleep $ARGV[2];' "$sock" "$1" "$2"
+}
+
+# Compile file directly and through the server and compare results.
+compare()
+{
+	local name="$1"
+	local obj="${name%.c}.obj"
+
+	rm -f "$obj"
+	"$syc" $flags "$name" >"$name-direct.out" 2>"$name-direct.err"
+	echo $? >"$name-direct.st"
+	[ -f "$obj" ] && mv "$obj" "$obj-direct.obj"
+
+	timeout $ctimeout "$syc" --client="$sock" $flags "$name" \
+	    >"$name-client.out" 2>"$name-client.err"
+	echo $? >"$name-client.st"
+	[ -f "$obj" ] && mv "$obj" "$obj-client.obj"
+
+	echo "$name: exit status $(cat "$name-client.st")"
+	cat "$name-client.err"
+	for f in out err st; do
+		cmp -s "$name-direct.$f" "$name-client.$f" ||
+		    echo "$name: $f differs"
+	done
+
+	if [ -f "$obj-direct.obj" ] || [ -f "$obj-client.obj" ]; then
+		cmp -s "$obj-direct.obj" "$obj-client.obj" ||
+		    echo "$name: object differs"
+	fi
+}
+
+if ! "$syc" $flags --pch-gen hdr.h; then
+	echo "Cannot generate precompiled header."
+	exit 1
+fi
+
+"$syc" --server="$sock" --pch=hdr.pch >/dev/null &
+spid=$!
+
+for i in $(seq 50); do
+	[ -S "$sock" ] && break
+	sleep 0.1
+done
+
+if ! [ -S "$sock" ]; then
+	echo "Server did not start."
+	exit 1
+fi
+
+echo "socket mode: $(stat -c %a "$sock")"
+
+compare good.c
+compare bad.c
+compare missing.c
+
+oflags="$flags"
+flags="$flags --pch=hdr.pch"
+compare usepch.c
+flags="$oflags"
+
+# A client that connects and sends nothing must not block others
+raw_send "" 20 &
+rpid=$!
+sleep 0.5
+echo "stalled client:"
+ctimeout=5
+compare good.c
+ctimeout=10
+kill $rpid 2>/dev/null
+wait $rpid 2>/dev/null
+
+# Malformed requests must not stop the server
+raw_send "\x00\x00\x00\x01/\x00\x00\x00\x00" 0
+raw_send "\xff\xff\xff\xff" 0
+raw_send "garbage" 0
+echo "after malformed requests:"
+compare good.c
+
+if ! kill -0 "$spid" 2>/dev/null; then
+	echo "Server terminated."
+	exit 1
+fi
+
+exit 0
@@ -0,0 +1,10 @@
+/*
+ * Compile server test. This file uses a precompiled header.
+ */
+
+#include "hdr.h"
+
+int pair_sum(pair_t *p)
+{
+	return TWICE(p->a) + p->b;
+}
@@ -0,0 +1,245 @@
+
+GLOBAL _main
+
+; proc _main
+._main
+; lvar
+.v_main_x equ 0x0
+.v_main_y equ 0x2
+.v_main_z equ 0x4
+.e_main__end equ 0x6
+; begin
+	push IX
+	ld IX, 65464
+	add IX, SP
+	ld SP, IX
+	ld IX, 72
+	add IX, SP
+	ld HL, v_main_z
+	add HL, SP
+	ld (IX-2), L
+	ld (IX-1), H
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-4), L
+	ld (IX-3), H
+	ld L, (IX-4)
+	ld H, (IX-3)
+	ld A, (HL)
+	ld (IX-6), A
+	inc HL
+	ld A, (HL)
+	ld (IX-5), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-8), L
+	ld (IX-7), H
+	ld L, (IX-8)
+	ld H, (IX-7)
+	ld A, (HL)
+	ld (IX-10), A
+	inc HL
+	ld A, (HL)
+	ld (IX-9), A
+	ld A, (IX-6)
+	and (IX-10)
+	ld (IX-12), A
+	ld A, (IX-5)
+	and (IX-9)
+	ld (IX-11), A
+	ld L, (IX-2)
+	ld H, (IX-1)
+	ld A, (IX-12)
+	ld (HL), A
+	inc HL
+	ld A, (IX-11)
+	ld (HL), A
+	ld HL, v_main_z
+	add HL, SP
+	ld (IX-14), L
+	ld (IX-13), H
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-16), L
+	ld (IX-15), H
+	ld L, (IX-16)
+	ld H, (IX-15)
+	ld A, (HL)
+	ld (IX-18), A
+	inc HL
+	ld A, (HL)
+	ld (IX-17), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-20), L
+	ld (IX-19), H
+	ld L, (IX-20)
+	ld H, (IX-19)
+	ld A, (HL)
+	ld (IX-22), A
+	inc HL
+	ld A, (HL)
+	ld (IX-21), A
+	ld A, (IX-18)
+	xor (IX-22)
+	ld (IX-24), A
+	ld A, (IX-17)
+	xor (IX-21)
+	ld (IX-23), A
+	ld L, (IX-14)
+	ld H, (IX-13)
+	ld A, (IX-24)
+	ld (HL), A
+	inc HL
+	ld A, (IX-23)
+	ld (HL), A
+	ld HL, v_main_z
+	add HL, SP
+	ld (IX-26), L
+	ld (IX-25), H
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-28), L
+	ld (IX-27), H
+	ld L, (IX-28)
+	ld H, (IX-27)
+	ld A, (HL)
+	ld (IX-30), A
+	inc HL
+	ld A, (HL)
+	ld (IX-29), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-32), L
+	ld (IX-31), H
+	ld L, (IX-32)
+	ld H, (IX-31)
+	ld A, (HL)
+	ld (IX-34), A
+	inc HL
+	ld A, (HL)
+	ld (IX-33), A
+	ld A, (IX-30)
+	or (IX-34)
+	ld (IX-36), A
+	ld A, (IX-29)
+	or (IX-33)
+	ld (IX-35), A
+	ld L, (IX-26)
+	ld H, (IX-25)
+	ld A, (IX-36)
+	ld (HL), A
+	inc HL
+	ld A, (IX-35)
+	ld (HL), A
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-38), L
+	ld (IX-37), H
+	ld L, (IX-38)
+	ld H, (IX-37)
+	ld A, (HL)
+	ld (IX-40), A
+	inc HL
+	ld A, (HL)
+	ld (IX-39), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-42), L
+	ld (IX-41), H
+	ld L, (IX-42)
+	ld H, (IX-41)
+	ld A, (HL)
+	ld (IX-44), A
+	inc HL
+	ld A, (HL)
+	ld (IX-43), A
+	ld A, (IX-40)
+	and (IX-44)
+	ld (IX-46), A
+	ld A, (IX-39)
+	and (IX-43)
+	ld (IX-45), A
+	ld L, (IX-38)
+	ld H, (IX-37)
+	ld A, (IX-46)
+	ld (HL), A
+	inc HL
+	ld A, (IX-45)
+	ld (HL), A
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-48), L
+	ld (IX-47), H
+	ld L, (IX-48)
+	ld H, (IX-47)
+	ld A, (HL)
+	ld (IX-50), A
+	inc HL
+	ld A, (HL)
+	ld (IX-49), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-52), L
+	ld (IX-51), H
+	ld L, (IX-52)
+	ld H, (IX-51)
+	ld A, (HL)
+	ld (IX-54), A
+	inc HL
+	ld A, (HL)
+	ld (IX-53), A
+	ld A, (IX-50)
+	xor (IX-54)
+	ld (IX-56), A
+	ld A, (IX-49)
+	xor (IX-53)
+	ld (IX-55), A
+	ld L, (IX-48)
+	ld H, (IX-47)
+	ld A, (IX-56)
+	ld (HL), A
+	inc HL
+	ld A, (IX-55)
+	ld (HL), A
+	ld HL, v_main_x
+	add HL, SP
+	ld (IX-58), L
+	ld (IX-57), H
+	ld L, (IX-58)
+	ld H, (IX-57)
+	ld A, (HL)
+	ld (IX-60), A
+	inc HL
+	ld A, (HL)
+	ld (IX-59), A
+	ld HL, v_main_y
+	add HL, SP
+	ld (IX-62), L
+	ld (IX-61), H
+	ld L, (IX-62)
+	ld H, (IX-61)
+	ld A, (HL)
+	ld (IX-64), A
+	inc HL
+	ld A, (HL)
+	ld (IX-63), A
+	ld A, (IX-60)
+	or (IX-64)
+	ld (IX-66), A
+	ld A, (IX-59)
+	or (IX-63)
+	ld (IX-65), A
+	ld L, (IX-58)
+	ld H, (IX-57)
+	ld A, (IX-66)
+	ld (HL), A
+	inc HL
+	ld A, (IX-65)
+	ld (HL), A
+	ld SP, IX
+	pop IX
+	ret
+
+; end proc _main
+
@@ -0,0 +1,21 @@
+/*
+ * Type qualifiers of parameters must be kept when a function definition
+ * follows its prototype.
+ */
+
+int foo(const int *);
+int bar(const int **, const int *);
+
+int foo(const int *cip)
+{
+	int *ip;
+
+	ip = cip;		// ^int <- ^const int			DISC
+	return *ip;
+}
+
+int bar(const int **cipp, const int *cip)
+{
+	*cipp = cip;		// ^const int <- ^const int		OK
+	return 0;
+}